@@ -25,3 +25,12 @@ void düğüm_çocuk_ekle(Arena *a, Düğüm *ebeveyn, Düğüm *cocuk) {
     }
     ebeveyn->çocuklar[ebeveyn->çocuk_sayısı++] = cocuk;
 }
+
+int satirici_ipucu(const char *dekorator) {
+    if (!dekorator) return 0;
+    if (strcmp(dekorator, "sat\xc4\xb1ri\xc3\xa7i") == 0 ||
+        strcmp(dekorator, "satirici") == 0) return 1;
+    if (strcmp(dekorator, "sat\xc4\xb1ri\xc3\xa7i_de\xc4\x9fil") == 0 ||
+        strcmp(dekorator, "satirici_degil") == 0) return -1;
+    return 0;
+}
@@ -77,6 +77,20 @@ typedef enum {
     DÜĞÜM_STATİK_ERİŞİM, /* SinifAdi.statik_uye erişimi */
 } DüğümTürü;
 
+/* paralel her...için indirgeme işlemleri (_tr_paralel_her ile aynı kodlar) */
+typedef enum {
+    İNDİRGEME_TOPLA,
+    İNDİRGEME_EN_KÜÇÜK,
+    İNDİRGEME_EN_BÜYÜK,
+} İndirgemeİşlemi;
+
+/* paralel her...için gövdesinin paylaşılan dizilere yazması (anlam.c belirler) */
+typedef enum {
+    PARALEL_PAYLASIM_YOK,     /* paylaşılan diziye yazılmıyor: paralel */
+    PARALEL_PAYLASIM_ELEMAN,  /* yalnız d[eleman] yazılıyor: elemanlar ayrıksa paralel */
+    PARALEL_PAYLASIM_SIRALI,  /* ayrıklık kanıtlanamıyor: sırayla çalışır */
+} ParalelPaylasim;
+
 typedef struct Düğüm {
     DüğümTürü tur;
     int satir;
@@ -145,6 +159,11 @@ typedef struct Düğüm {
 
         struct {
             char *isim;       /* döngü değişkeni */
+            int   paralel;    /* paralel her...için */
+            char *indirgeme_isim[4];   /* ile topla(t), en_küçük(m), ... */
+            int   indirgeme_islem[4];  /* İNDİRGEME_* */
+            int   indirgeme_sayisi;
+            int   paylasim;   /* PARALEL_PAYLASIM_* */
         } dongu;
 
         struct {
@@ -190,4 +209,9 @@ Düğüm *düğüm_oluştur(Arena *a, DüğümTürü tur, int satir, int sutun);
 /* Çocuk ekleme */
 void düğüm_çocuk_ekle(Arena *a, Düğüm *ebeveyn, Düğüm *cocuk);
 
+/* Satır içi açma ipucu dekoratörü: @satıriçi 1, @satıriçi_değil -1,
+ * diğerleri 0. İpuçları çağrılacak bir işlev değildir, backend'ler
+ * sarmalayıcı üretmez. */
+int satirici_ipucu(const char *dekorator);
+
 #endif
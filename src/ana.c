@@ -358,6 +358,9 @@ static void kullanim_goster(void) {
     fprintf(stderr, "  --s\xc4\xb1na        Test modunda derle (test bloklar\xc4\xb1n\xc4\xb1 \xc3\xa7al\xc4\xb1\xc5\x9ft\xc4\xb1r)\n");
     fprintf(stderr, "  --etkile\xc5\x9fimli Etkile\xc5\x9fimli REPL modunu ba\xc5\x9flat\n");
     fprintf(stderr, "  --backend=vm   Bytecode VM backend (taşınabilir .trbc dosyası üret)\n");
+    fprintf(stderr, "  --vm-opt-rapor Bytecode optimizasyonu öncesi/sonrası komut sayıları\n");
+    fprintf(stderr, "  --kuyruk-rapor Kuyruk çağrısına çevrilemeyen döndür çağrılarını nedeniyle listele\n");
+    fprintf(stderr, "  --vektor-rapor Sabit adımlı döngülerin SIMD'e çevrilip çevrilmediğini listele\n");
 #ifdef LLVM_BACKEND_MEVCUT
     fprintf(stderr, "  --backend=llvm LLVM IR backend kullan (çoklu platform desteği)\n");
     fprintf(stderr, "  --emit-llvm   LLVM IR dosyası (.ll) üret\n");
@@ -753,6 +756,9 @@ int main(int argc, char **argv) {
 
     /* VM backend seçeneği */
     int vm_backend = 0;           /* --backend=vm */
+    int vm_opt_rapor = 0;         /* --vm-opt-rapor */
+    int kuyruk_rapor = 0;         /* --kuyruk-rapor */
+    int vektor_rapor = 0;         /* --vektor-rapor */
 
     /* LLVM backend seçenekleri */
     int llvm_backend = 0;         /* --backend=llvm */
@@ -790,6 +796,12 @@ int main(int argc, char **argv) {
             if (i + 1 < argc) hedef = argv[++i];
         } else if (strcmp(argv[i], "--backend=vm") == 0 || strcmp(argv[i], "-backend=vm") == 0) {
             vm_backend = 1;
+        } else if (strcmp(argv[i], "--vm-opt-rapor") == 0) {
+            vm_opt_rapor = 1;
+        } else if (strcmp(argv[i], "--kuyruk-rapor") == 0) {
+            kuyruk_rapor = 1;
+        } else if (strcmp(argv[i], "--vektor-rapor") == 0) {
+            vektor_rapor = 1;
         } else if (strcmp(argv[i], "--backend=llvm") == 0 || strcmp(argv[i], "-backend=llvm") == 0) {
 #ifdef LLVM_BACKEND_MEVCUT
             llvm_backend = 1;
@@ -998,7 +1010,7 @@ int main(int argc, char **argv) {
 
     /* 3.5. Optimizasyon gecisi (-O bayragi) */
     if (optimize_modu) {
-        optimize_et(program);
+        optimize_et(program, &arena);
     }
 
 #ifdef LLVM_BACKEND_MEVCUT
@@ -1332,6 +1344,9 @@ int main(int argc, char **argv) {
         }
         metin_baslat(&vm_uretici.cikti);
         metin_ekle(&vm_uretici.cikti, vm_cikti);
+        vm_uretici.vm_opt_rapor = vm_opt_rapor;
+        vm_uretici.kuyruk_rapor = kuyruk_rapor;
+        vm_uretici.kaynak_dosya = kaynak_dosya;
 
         kod_uret_vm(&vm_uretici, program, &arena);
 
@@ -1392,6 +1407,8 @@ int main(int argc, char **argv) {
     üretici.test_modu = test_modu;
     üretici.profil_modu = profil_modu;
     üretici.harita_modu = harita_modu;
+    üretici.kuyruk_rapor = kuyruk_rapor;
+    üretici.vektor_rapor = vektor_rapor;
 
     /* Monomorphization: Generic özelleştirmeleri kod üreticiye aktar */
     üretici.generic_ozellestirilmisler = ac.ozellestirilmisler;
@@ -5,6 +5,7 @@
 #include <stdio.h>
 
 static TipTürü dugum_analiz(AnlamÇözümleyici *ac, Düğüm *d);
+static void paralel_dizi_okuma(AnlamÇözümleyici *ac, Düğüm *d);
 
 /* Kapsam zincirinde en yakın sembol ismini bul (Levenshtein mesafe) */
 static const char *yakin_sembol_bul(Kapsam *k, const char *isim, int esik) {
@@ -562,6 +563,7 @@ static TipTürü ifade_analiz(AnlamÇözümleyici *ac, Düğüm *d) {
             d->sonuç_tipi = TİP_METİN;
             return TİP_METİN;
         }
+        if (ac->paralel_dongu && d->çocuk_sayısı > 1) paralel_dizi_okuma(ac, d);
         d->sonuç_tipi = TİP_TAM;
         return TİP_TAM;
 
@@ -642,6 +644,137 @@ static TipTürü ifade_analiz(AnlamÇözümleyici *ac, Düğüm *d) {
     }
 }
 
+/* ---- paralel her...için denetimleri ---- */
+
+static void paralel_hata(Düğüm *d, const char *bicim, const char *isim) {
+    char hata_mesaj[256];
+    int n = snprintf(hata_mesaj, sizeof(hata_mesaj), "paralel d\xc3\xb6ng\xc3\xbc: ");
+    snprintf(hata_mesaj + n, sizeof(hata_mesaj) - n, bicim, isim ? isim : "");
+    hata_bildir(HATA_SINIR_AŞIMI, d->satir, d->sutun, hata_mesaj);
+}
+
+/* İsim paralel döngü gövdesinde (ya da döngü değişkeni olarak) mı tanımlı? */
+static int paralel_yerel_mi(AnlamÇözümleyici *ac, const char *isim) {
+    return sembol_ara_sinirli(ac->kapsam, ac->paralel_kapsam, isim) != NULL;
+}
+
+static int paralel_indirgeme_mi(AnlamÇözümleyici *ac, const char *isim) {
+    Düğüm *p = ac->paralel_dongu;
+    for (int i = 0; i < p->veri.dongu.indirgeme_sayisi; i++) {
+        if (strcmp(p->veri.dongu.indirgeme_isim[i], isim) == 0) return 1;
+    }
+    return 0;
+}
+
+/* Yinelemeler arasında paylaşılan değişkene doğrudan atama */
+static void paralel_yazma_denetle(AnlamÇözümleyici *ac, Düğüm *d, const char *isim) {
+    if (!ac->paralel_dongu || !isim) return;
+    if (paralel_yerel_mi(ac, isim) || paralel_indirgeme_mi(ac, isim)) return;
+    if (!sembol_ara(ac->kapsam, isim)) return;
+    paralel_hata(d, "d\xc4\xb1\xc5\x9f de\xc4\x9fi\xc5\x9fken '%s' "
+                 "yinelemeler aras\xc4\xb1nda payla\xc5\x9f\xc4\xb1l\xc4\xb1r; "
+                 "indirgeme olarak bildirin (ile topla(...))", isim);
+}
+
+/* İsim paralel döngünün kendi değişkeni mi (gövdede gölgelenmemiş)? */
+static int paralel_dongu_degiskeni_mi(AnlamÇözümleyici *ac, const char *isim) {
+    const char *dongu_isim = ac->paralel_dongu->veri.dongu.isim;
+    if (!isim || !dongu_isim || strcmp(isim, dongu_isim) != 0) return 0;
+    return sembol_ara(ac->kapsam, isim) ==
+           sembol_ara_sinirli(ac->paralel_kapsam, ac->paralel_kapsam, isim);
+}
+
+static int paralel_eleman_indeksi_mi(AnlamÇözümleyici *ac, Düğüm *indeks) {
+    return indeks && indeks->tur == DÜĞÜM_TANIMLAYICI &&
+           paralel_dongu_degiskeni_mi(ac, indeks->veri.tanimlayici.isim);
+}
+
+/* d[i], d[i][j], d.alan[i]: erişilen dizinin kök değişkeni (yoksa NULL) */
+static const char *paralel_dizi_koku(Düğüm *d) {
+    while (d && (d->tur == DÜĞÜM_DİZİ_ERİŞİM || d->tur == DÜĞÜM_ERİŞİM) &&
+           d->çocuk_sayısı > 0)
+        d = d->çocuklar[0];
+    if (!d || d->tur != DÜĞÜM_TANIMLAYICI) return NULL;
+    return d->veri.tanimlayici.isim;
+}
+
+static void paralel_paylasim_isaretle(Düğüm *dongu, int paylasim) {
+    if (dongu->veri.dongu.paylasim < paylasim) dongu->veri.dongu.paylasim = paylasim;
+}
+
+static void paralel_erisim_kaydet(AnlamÇözümleyici *ac, int yazma, const char *isim) {
+    const char **liste = yazma ? ac->paralel_yazilan : ac->paralel_okunan;
+    int *sayi = yazma ? &ac->paralel_yazilan_sayisi : &ac->paralel_okunan_sayisi;
+    if (*sayi >= MAKS_PARALEL_ERISIM) {
+        paralel_paylasim_isaretle(ac->paralel_dongu, PARALEL_PAYLASIM_SIRALI);
+        return;
+    }
+    liste[(*sayi)++] = isim;
+}
+
+/* Paylaşılan diziye yazma: yalnız d[eleman] = ... paralel kalabilir (elemanların
+ * ayrıklığını _tr_paralel_her_eleman denetler); başka her indeks iki
+ * yinelemede aynı yuvayı gösterebilir, döngü sırayla çalışır. */
+static void paralel_dizi_yazma(AnlamÇözümleyici *ac, Düğüm *d) {
+    Düğüm *dizi = d->çocuklar[0];
+    const char *kok = paralel_dizi_koku(dizi);
+    if (kok && paralel_yerel_mi(ac, kok)) return;
+    if (dizi->tur == DÜĞÜM_TANIMLAYICI && dizi->sonuç_tipi == TİP_DİZİ &&
+        paralel_eleman_indeksi_mi(ac, d->çocuklar[1])) {
+        paralel_paylasim_isaretle(ac->paralel_dongu, PARALEL_PAYLASIM_ELEMAN);
+        paralel_erisim_kaydet(ac, 1, kok);
+    } else {
+        paralel_paylasim_isaretle(ac->paralel_dongu, PARALEL_PAYLASIM_SIRALI);
+    }
+}
+
+/* Paylaşılan diziyi döngü elemanı dışında bir indeksle okuma */
+static void paralel_dizi_okuma(AnlamÇözümleyici *ac, Düğüm *d) {
+    if (paralel_eleman_indeksi_mi(ac, d->çocuklar[1])) return;
+    const char *kok = paralel_dizi_koku(d->çocuklar[0]);
+    if (kok && !paralel_yerel_mi(ac, kok)) paralel_erisim_kaydet(ac, 0, kok);
+}
+
+/* Döngü sonu: d[eleman] yazılan bir dizi başka indeksle de okunduysa bir
+ * yinelemenin yazdığını diğeri okuyabilir */
+static void paralel_erisim_sonucla(AnlamÇözümleyici *ac, Düğüm *dongu,
+                                   int yazilan_bas, int okunan_bas) {
+    for (int i = yazilan_bas; i < ac->paralel_yazilan_sayisi; i++) {
+        for (int j = okunan_bas; j < ac->paralel_okunan_sayisi; j++) {
+            if (strcmp(ac->paralel_yazilan[i], ac->paralel_okunan[j]) == 0) {
+                paralel_paylasim_isaretle(dongu, PARALEL_PAYLASIM_SIRALI);
+                return;
+            }
+        }
+    }
+}
+
+/* Etiketli kır/devam paralel döngünün dışına çıkıyor mu? */
+static int paralel_etiket_disarida(AnlamÇözümleyici *ac, const char *etiket) {
+    for (int i = ac->paralel_derinlik; i < ac->dongu_derinligi; i++) {
+        if (ac->dongu_degiskenleri[i] && strcmp(ac->dongu_degiskenleri[i], etiket) == 0)
+            return 0;
+    }
+    return 1;
+}
+
+static void paralel_dongu_analiz(AnlamÇözümleyici *ac, Düğüm *d) {
+    if (d->çocuk_sayısı > 2) {
+        paralel_hata(d, "'yoksa' blo\xc4\x9fu kullan\xc4\xb1lamaz", NULL);
+    }
+    for (int i = 0; i < d->veri.dongu.indirgeme_sayisi; i++) {
+        const char *isim = d->veri.dongu.indirgeme_isim[i];
+        Sembol *s = sembol_ara(ac->kapsam, isim);
+        if (!s) {
+            hata_bildir(HATA_TANIMSIZ_DEĞİŞKEN, d->satir, d->sutun, isim);
+        } else if (s->tip != TİP_TAM) {
+            paralel_hata(d, "indirgeme de\xc4\x9fi\xc5\x9fkeni '%s' tam olmal\xc4\xb1", isim);
+        } else if (s->sabit_mi) {
+            hata_bildir(HATA_SABİT_ATAMA, d->satir, d->sutun, isim);
+        }
+    }
+}
+
 static void blok_analiz(AnlamÇözümleyici *ac, Düğüm *blok) {
     if (!blok) return;
     for (int i = 0; i < blok->çocuk_sayısı; i++) {
@@ -1038,6 +1171,8 @@ static TipTürü dugum_analiz(AnlamÇözümleyici *ac, Düğüm *d) {
     case DÜĞÜM_DÖNDÜR:
         if (!ac->islev_icinde) {
             hata_bildir(HATA_İŞLEV_DIŞI_DÖNDÜR, d->satir, d->sutun);
+        } else if (ac->paralel_dongu) {
+            paralel_hata(d, "'d\xc3\xb6nd\xc3\xbcr' kullan\xc4\xb1lamaz", NULL);
         }
         if (d->çocuk_sayısı > 0) ifade_analiz(ac, d->çocuklar[0]);
         return TİP_BOŞLUK;
@@ -1063,6 +1198,13 @@ static TipTürü dugum_analiz(AnlamÇözümleyici *ac, Düğüm *d) {
                 hata_bildir(HATA_SINIR_AŞIMI, d->satir, d->sutun, hata_mesaj);
             }
         }
+        if (ac->paralel_dongu &&
+            (d->veri.tanimlayici.isim
+                 ? (paralel_etiket_disarida(ac, d->veri.tanimlayici.isim) ||
+                    strcmp(d->veri.tanimlayici.isim, ac->paralel_dongu->veri.dongu.isim) == 0)
+                 : ac->dongu_icinde == ac->paralel_dongu_seviye)) {
+            paralel_hata(d, "'k\xc4\xb1r' kullan\xc4\xb1lamaz", NULL);
+        }
         return TİP_BOŞLUK;
 
     case DÜĞÜM_DEVAM:
@@ -1085,6 +1227,11 @@ static TipTürü dugum_analiz(AnlamÇözümleyici *ac, Düğüm *d) {
                 hata_bildir(HATA_SINIR_AŞIMI, d->satir, d->sutun, hata_mesaj);
             }
         }
+        if (ac->paralel_dongu && d->veri.tanimlayici.isim &&
+            paralel_etiket_disarida(ac, d->veri.tanimlayici.isim)) {
+            paralel_hata(d, "'devam' d\xc3\xb6ng\xc3\xbc d\xc4\xb1\xc5\x9f\xc4\xb1na "
+                         "\xc3\xa7\xc4\xb1kamaz", NULL);
+        }
         return TİP_BOŞLUK;
 
     case DÜĞÜM_ATAMA: {
@@ -1099,6 +1246,10 @@ static TipTürü dugum_analiz(AnlamÇözümleyici *ac, Düğüm *d) {
             hata_bildir(HATA_SABİT_ATAMA, d->satir, d->sutun,
                         d->veri.tanimlayici.isim);
         }
+        paralel_yazma_denetle(ac, d, d->veri.tanimlayici.isim);
+        /* Döngü elemanı değişirse d[eleman] yazmaları ayrık kalmaz */
+        if (ac->paralel_dongu && paralel_dongu_degiskeni_mi(ac, d->veri.tanimlayici.isim))
+            paralel_paylasim_isaretle(ac->paralel_dongu, PARALEL_PAYLASIM_SIRALI);
         if (d->çocuk_sayısı > 0) ifade_analiz(ac, d->çocuklar[0]);
         return TİP_BOŞLUK;
     }
@@ -1108,6 +1259,7 @@ static TipTürü dugum_analiz(AnlamÇözümleyici *ac, Düğüm *d) {
         for (int i = 0; i < d->çocuk_sayısı; i++) {
             ifade_analiz(ac, d->çocuklar[i]);
         }
+        if (ac->paralel_dongu && d->çocuk_sayısı > 1) paralel_dizi_yazma(ac, d);
         return TİP_BOŞLUK;
 
     case DÜĞÜM_ERİŞİM_ATAMA:
@@ -1115,6 +1267,12 @@ static TipTürü dugum_analiz(AnlamÇözümleyici *ac, Düğüm *d) {
         for (int i = 0; i < d->çocuk_sayısı; i++) {
             ifade_analiz(ac, d->çocuklar[i]);
         }
+        if (ac->paralel_dongu && d->çocuk_sayısı > 0 &&
+            d->çocuklar[0]->tur == DÜĞÜM_TANIMLAYICI &&
+            !paralel_yerel_mi(ac, d->çocuklar[0]->veri.tanimlayici.isim)) {
+            paralel_hata(d, "payla\xc5\x9f\xc4\xb1lan '%s' nesnesinin alan\xc4\xb1na yaz\xc4\xb1l\xc4\xb1yor",
+                         d->çocuklar[0]->veri.tanimlayici.isim);
+        }
         return TİP_BOŞLUK;
 
     case DÜĞÜM_İFADE_BİLDİRİMİ:
@@ -1165,11 +1323,25 @@ static TipTürü dugum_analiz(AnlamÇözümleyici *ac, Düğüm *d) {
         /* çocuklar[0]=dizi, çocuklar[1]=gövde, çocuklar[2]=yoksa (opsiyonel) */
         ac->dongu_icinde++;
         if (d->çocuk_sayısı > 0) ifade_analiz(ac, d->çocuklar[0]);
+        if (d->veri.dongu.paralel) paralel_dongu_analiz(ac, d);
         /* Yeni kapsam: döngü değişkenini ekle */
         Kapsam *onceki = ac->kapsam;
         ac->kapsam = kapsam_oluştur(ac->arena, onceki);
+        Düğüm *onceki_paralel = ac->paralel_dongu;
+        Kapsam *onceki_paralel_kapsam = ac->paralel_kapsam;
+        int onceki_paralel_seviye = ac->paralel_dongu_seviye;
+        int onceki_paralel_derinlik = ac->paralel_derinlik;
+        int yazilan_bas = ac->paralel_yazilan_sayisi;
+        int okunan_bas = ac->paralel_okunan_sayisi;
+        if (d->veri.dongu.paralel) {
+            ac->paralel_dongu = d;
+            ac->paralel_kapsam = ac->kapsam;
+            ac->paralel_dongu_seviye = ac->dongu_icinde;
+            ac->paralel_derinlik = ac->dongu_derinligi;
+        }
         if (d->veri.dongu.isim) {
-            sembol_ekle(ac->arena, ac->kapsam, d->veri.dongu.isim, TİP_TAM);
+            Sembol *ds = sembol_ekle(ac->arena, ac->kapsam, d->veri.dongu.isim, TİP_TAM);
+            if (ds) ds->baslangic_var = 1;
             if (ac->dongu_derinligi < MAKS_DONGU_DERINLIK) {
                 ac->dongu_degiskenleri[ac->dongu_derinligi++] = d->veri.dongu.isim;
             }
@@ -1179,6 +1351,21 @@ static TipTürü dugum_analiz(AnlamÇözümleyici *ac, Düğüm *d) {
         if (d->veri.dongu.isim && ac->dongu_derinligi > 0) {
             ac->dongu_derinligi--;
         }
+        if (d->veri.dongu.paralel) {
+            paralel_erisim_sonucla(ac, d, yazilan_bas, okunan_bas);
+            /* İç döngünün paylaşılan yazmaları dış döngünün yinelemeleri
+             * arasında da paylaşılabilir */
+            if (onceki_paralel && d->veri.dongu.paylasim != PARALEL_PAYLASIM_YOK)
+                paralel_paylasim_isaretle(onceki_paralel, PARALEL_PAYLASIM_SIRALI);
+            if (!onceki_paralel) {
+                ac->paralel_yazilan_sayisi = yazilan_bas;
+                ac->paralel_okunan_sayisi = okunan_bas;
+            }
+        }
+        ac->paralel_dongu = onceki_paralel;
+        ac->paralel_kapsam = onceki_paralel_kapsam;
+        ac->paralel_dongu_seviye = onceki_paralel_seviye;
+        ac->paralel_derinlik = onceki_paralel_derinlik;
         ac->kapsam = onceki;
         ac->dongu_icinde--;
         return TİP_BOŞLUK;
@@ -1200,6 +1387,9 @@ static TipTürü dugum_analiz(AnlamÇözümleyici *ac, Düğüm *d) {
     }
 
     case DÜĞÜM_FIRLAT:
+        if (ac->paralel_dongu) {
+            paralel_hata(d, "'f\xc4\xb1rlat' kullan\xc4\xb1lamaz (istisna d\xc3\xb6ng\xc3\xbc d\xc4\xb1\xc5\x9f\xc4\xb1na ta\xc5\x9f\xc4\xb1namaz)", NULL);
+        }
         if (d->çocuk_sayısı > 0) ifade_analiz(ac, d->çocuklar[0]);
         return TİP_BOŞLUK;
 
@@ -1211,6 +1401,7 @@ static TipTürü dugum_analiz(AnlamÇözümleyici *ac, Düğüm *d) {
         }
         if (d->veri.tanimlayici.isim) {
             Sembol *ws = sembol_ara(ac->kapsam, d->veri.tanimlayici.isim);
+            if (ws) paralel_yazma_denetle(ac, d, d->veri.tanimlayici.isim);
             if (!ws) {
                 ws = sembol_ekle(ac->arena, ac->kapsam, d->veri.tanimlayici.isim, tip);
                 ws->baslangic_var = 1;
@@ -1227,6 +1418,7 @@ static TipTürü dugum_analiz(AnlamÇözümleyici *ac, Düğüm *d) {
         }
         for (int i = 0; i < d->çocuk_sayısı - 1; i++) {
             if (d->çocuklar[i]->tur == DÜĞÜM_TANIMLAYICI) {
+                paralel_yazma_denetle(ac, d, d->çocuklar[i]->veri.tanimlayici.isim);
                 sembol_ekle(ac->arena, ac->kapsam, d->çocuklar[i]->veri.tanimlayici.isim, TİP_TAM);
             }
         }
@@ -1242,6 +1434,10 @@ static TipTürü dugum_analiz(AnlamÇözümleyici *ac, Düğüm *d) {
         return TİP_BOŞLUK;
 
     case DÜĞÜM_LAMBDA: {
+        /* Lambda ayrı bir işlevdir ve yakaladıklarının kopyasını taşır;
+         * gövdesi paralel döngü kısıtlarına tabi değildir */
+        Düğüm *onceki_paralel = ac->paralel_dongu;
+        ac->paralel_dongu = NULL;
         TipTürü donus = d->veri.islev.dönüş_tipi ?
             tip_adı_çevir(d->veri.islev.dönüş_tipi) : TİP_BOŞLUK;
         Sembol *fn_sem = sembol_ekle(ac->arena, ac->kapsam, d->veri.islev.isim, donus);
@@ -1265,6 +1461,7 @@ static TipTürü dugum_analiz(AnlamÇözümleyici *ac, Düğüm *d) {
         if (d->çocuk_sayısı > 1) blok_analiz(ac, d->çocuklar[1]);
         ac->islev_icinde--;
         ac->kapsam = onceki;
+        ac->paralel_dongu = onceki_paralel;
         return TİP_İŞLEV;
     }
 
@@ -1339,6 +1536,9 @@ static TipTürü dugum_analiz(AnlamÇözümleyici *ac, Düğüm *d) {
 
     case DÜĞÜM_ÜRET:
         /* üreteç yield */
+        if (ac->paralel_dongu) {
+            paralel_hata(d, "'\xc3\xbcret' kullan\xc4\xb1lamaz", NULL);
+        }
         if (d->çocuk_sayısı > 0) ifade_analiz(ac, d->çocuklar[0]);
         return TİP_BOŞLUK;
 
@@ -1352,7 +1552,12 @@ int anlam_çözümle(AnlamÇözümleyici *ac, Düğüm *program, Arena *arena, c
     ac->kapsam = kapsam_oluştur(arena, NULL);
     ac->islev_icinde = 0;
     ac->dongu_icinde = 0;
+    ac->dongu_derinligi = 0;
     ac->mevcut_sinif = NULL;
+    ac->paralel_dongu = NULL;
+    ac->paralel_kapsam = NULL;
+    ac->paralel_yazilan_sayisi = 0;
+    ac->paralel_okunan_sayisi = 0;
 
     /* Monomorphization başlatma */
     ac->generic_islevler = NULL;
@@ -28,6 +28,20 @@ typedef struct {
     char   *dongu_degiskenleri[MAKS_DONGU_DERINLIK];
     int     dongu_derinligi;
 
+    /* paralel her...için gövdesi: bu kapsamın dışına yazmak paylaşımlıdır */
+    Düğüm  *paralel_dongu;
+    Kapsam *paralel_kapsam;
+    int     paralel_dongu_seviye;   /* döngünün dongu_icinde değeri */
+    int     paralel_derinlik;       /* döngünün dongu_degiskenleri konumu */
+
+    /* Gövdede döngü elemanı dışında bir indeksle erişilen paylaşılan
+     * diziler: yazılan bir dizi böyle okunuyorsa döngü sırayla çalışır */
+    #define MAKS_PARALEL_ERISIM 32
+    const char *paralel_yazilan[MAKS_PARALEL_ERISIM];
+    const char *paralel_okunan[MAKS_PARALEL_ERISIM];
+    int     paralel_yazilan_sayisi;
+    int     paralel_okunan_sayisi;
+
     /* Monomorphization için */
     Düğüm **generic_islevler;          /* Generic fonksiyon AST'leri */
     int     generic_islev_sayisi;
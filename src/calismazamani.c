@@ -14,6 +14,7 @@
 #include <sys/mman.h>
 #include <unistd.h>
 #include <stdint.h>
+#include <pthread.h>
 
 /* Metin donusu: 16 byte struct -> rax=ptr, rdx=len (System V ABI) */
 typedef struct { char *ptr; long long len; } TrMetin;
@@ -38,38 +39,913 @@ typedef struct {
 #define NESNE_TIP_KUME    4
 #define NESNE_TIP_KAPANIS 5
 
-/* Kapanış ortam işaretçisi (closure environment) */
-long long *_tr_kapanis_ortam = NULL;
+/* tip alani: [0..7] tip, [8..15] bayraklar, [24..63] dizi kullanilan uzunlugu + 1 */
+#define NESNE_TIP_MASKE           0xffLL
+#define NESNE_BAYRAK_PAYLASILMIS  (1LL << 8)   /* baska is parcacigina yayinlandi */
+#define NESNE_BAYRAK_REFLI        (1LL << 12)  /* sayilmis referans tutar */
+#define NESNE_BAYRAK_ORTAK        (1LL << 13)  /* dizi birden cok degiskende, yerinde buyumez */
+
+/* ---- Boyut Sinifli Slab Ayirici ----
+ *
+ * Kucuk nesneler (header dahil SLAB_MAKS_BOYUT'a kadar) boyut siniflarina
+ * yuvarlanir. Her sinifin kendi SLAB_PARCA_BOYUT'luk, o boyuta hizali mmap
+ * parcalari vardir; parca basinda SlabParca bilgisi ve parcanin referans bit
+ * haritasi, ardindan esit boyutlu dilimler gelir. Serbest birakilan dilimler
+ * sinifin serbest listesine geri doner; parcalar isletim sistemine iade
+ * edilmez. Buyuk nesneler kendi hizali eslemelerini alir: basta sinif -1 olan
+ * bir SlabParca ile bit haritasi, ardindan NesneBaslik gelir.
+ *
+ * Her is parcaciginin sinif basina kendi onbellegi vardir; ayirma ve birakma
+ * cogunlukla kilitsizdir. Genel listeye yalnizca SLAB_PARTI'lik toplu
+ * doldurma/bosaltma icin (kilit altinda) gidilir.
+ *
+ * NesneBaslik.boyut her zaman gercek ayrilan boyutu (yuvarlanmis) tutar,
+ * boylece serbest birakma yolu sinifi header'dan bulur. Serbest dilimlerin
+ * tip alani NESNE_TIP_SERBEST'tir.
+ */
+
+#define SLAB_PARCA_BOYUT  (256 * 1024)
+#define SLAB_PARCA_BILGI  64
+#define SLAB_PARCA_KELIME (SLAB_PARCA_BOYUT / 8 / 64)   /* kelime basina bir bit */
+#define SLAB_PARCA_BASLIK (SLAB_PARCA_BILGI + SLAB_PARCA_KELIME * 8)
+#define SLAB_PARCA_SIHIR  0x54524b534c414231LL  /* "TRKSLAB1" */
+#define SLAB_MAKS_BOYUT   4096
+#define SLAB_SINIF_SAYISI 16
+#define SLAB_PARTI        32
+
+#define NESNE_TIP_SERBEST (-1LL)
+
+static const long long slab_sinif_boyut[SLAB_SINIF_SAYISI] = {
+    32, 48, 64, 80, 96, 128, 160, 192, 256, 384, 512, 768,
+    1024, 1536, 2048, 4096
+};
+
+typedef struct SlabDilim { struct SlabDilim *sonraki; } SlabDilim;
+
+typedef struct {
+    long long sihir;
+    long long sinif;    /* buyuk nesnede -1 */
+    long long ters;     /* ceil(2^40 / dilim boyutu): bolmesiz dilim sinamasi */
+    long long baslik;   /* buyuk nesnede NesneBaslik'in ofseti */
+    long long kelime;   /* bit haritasinin 64 bitlik kelime sayisi */
+} SlabParca;
+
+/* Parca ya da buyuk esleme basindan itibaren her kelimeye bir bit */
+#define REF_BITLER(taban) ((uint64_t *)((char *)(taban) + SLAB_PARCA_BILGI))
+
+/* Genel (paylasilan) durum: slab_kilit altinda */
+static SlabDilim *slab_serbest[SLAB_SINIF_SAYISI];
+static char *slab_parca_imlec[SLAB_SINIF_SAYISI];
+static char *slab_parca_son[SLAB_SINIF_SAYISI];
+static volatile int slab_kilit = 0;
+
+/* Is parcacigi yerel onbellek */
+typedef struct {
+    SlabDilim *liste[SLAB_SINIF_SAYISI];
+    int sayi[SLAB_SINIF_SAYISI];
+    int kayitli;
+} SlabOnbellek;
+
+static _Thread_local SlabOnbellek slab_yerel;
+static pthread_key_t slab_anahtar;
+static pthread_once_t slab_anahtar_bir = PTHREAD_ONCE_INIT;
+
+static inline void slab_kilitle(void) {
+    while (__atomic_test_and_set(&slab_kilit, __ATOMIC_ACQUIRE)) { }
+}
+
+static inline void slab_kilit_birak(void) {
+    __atomic_clear(&slab_kilit, __ATOMIC_RELEASE);
+}
+
+static inline int slab_sinif_bul(long long toplam) {
+    for (int i = 0; i < SLAB_SINIF_SAYISI; i++) {
+        if (toplam <= slab_sinif_boyut[i]) return i;
+    }
+    return -1;
+}
+
+/* ---- Bolge Haritasi ----
+ * Dongu toplayicinin ve referans yazimlarinin bir kelimenin yonetilen
+ * nesne olup olmadigini kilitsiz anlayabilmesi icin her SLAB_PARCA_BOYUT'luk
+ * bolgenin sahibi (slab parcasi ya da buyuk nesne eslemesinin basi) iki
+ * duzeyli bir tabloda tutulur. Yazimlar slab_kilit altinda yapilir ve
+ * release ile yayinlanir; okumalar kilit almaz. Buyuk nesneler de
+ * SLAB_PARCA_BOYUT'a hizali eslendiginden bir bolgenin tek sahibi vardir;
+ * buyuk nesne icin yalnizca NesneBaslik'in dustugu bolge kaydedilir. */
+
+#define BOLGE_KAYMA      18                      /* log2(SLAB_PARCA_BOYUT) */
+#define BOLGE_YAPRAK_BIT 15
+#define BOLGE_UST_BIT    (48 - BOLGE_KAYMA - BOLGE_YAPRAK_BIT)
+
+static uintptr_t *bolge_ust[1 << BOLGE_UST_BIT];
+
+static inline uintptr_t bolge_bul(uintptr_t a) {
+    if (a >> 48) return 0;
+    uintptr_t *yaprak = __atomic_load_n(&bolge_ust[a >> (BOLGE_KAYMA + BOLGE_YAPRAK_BIT)],
+                                        __ATOMIC_ACQUIRE);
+    if (!yaprak) return 0;
+    return __atomic_load_n(&yaprak[(a >> BOLGE_KAYMA) & ((1 << BOLGE_YAPRAK_BIT) - 1)],
+                           __ATOMIC_ACQUIRE);
+}
+
+/* Kilit altinda cagrilir: a'nin bolgesinin sahibini ata (0 kaydi siler) */
+static int bolge_ata(uintptr_t a, uintptr_t sahip) {
+    uintptr_t **ust = &bolge_ust[a >> (BOLGE_KAYMA + BOLGE_YAPRAK_BIT)];
+    uintptr_t *yaprak = *ust;
+    if (!yaprak) {
+        if (!sahip) return 1;
+        yaprak = (uintptr_t *)mmap(NULL, sizeof(uintptr_t) << BOLGE_YAPRAK_BIT,
+                                   PROT_READ | PROT_WRITE,
+                                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (yaprak == MAP_FAILED) return 0;
+        __atomic_store_n(ust, yaprak, __ATOMIC_RELEASE);
+    }
+    __atomic_store_n(&yaprak[(a >> BOLGE_KAYMA) & ((1 << BOLGE_YAPRAK_BIT) - 1)],
+                     sahip, __ATOMIC_RELEASE);
+    return 1;
+}
+
+/* SLAB_PARCA_BOYUT'a hizali, uzunluk baytlik esleme al */
+static char *hizali_esle(size_t uzunluk) {
+    char *ham = (char *)mmap(NULL, uzunluk + SLAB_PARCA_BOYUT, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ham == MAP_FAILED) return NULL;
+    char *bas = (char *)(((uintptr_t)ham + SLAB_PARCA_BOYUT - 1) &
+                         ~(uintptr_t)(SLAB_PARCA_BOYUT - 1));
+    if (bas > ham) munmap(ham, (size_t)(bas - ham));
+    char *ham_son = ham + uzunluk + SLAB_PARCA_BOYUT;
+    if (ham_son > bas + uzunluk) munmap(bas + uzunluk, (size_t)(ham_son - (bas + uzunluk)));
+    return bas;
+}
+
+/* Kilit altinda cagrilir: sinifin parcasindan yeni dilim kes,
+ * gerekirse SLAB_PARCA_BOYUT'a hizali yeni parca al */
+static void *slab_parcadan_kes(int sinif) {
+    long long boyut = slab_sinif_boyut[sinif];
+    if (slab_parca_imlec[sinif] == NULL ||
+        slab_parca_son[sinif] - slab_parca_imlec[sinif] < boyut) {
+        char *parca = hizali_esle(SLAB_PARCA_BOYUT);
+        if (!parca) return NULL;
+        SlabParca *p = (SlabParca *)parca;
+        p->sihir = SLAB_PARCA_SIHIR;
+        p->sinif = sinif;
+        p->ters = ((1LL << 40) + boyut - 1) / boyut;
+        p->kelime = SLAB_PARCA_KELIME;
+        if (!bolge_ata((uintptr_t)parca, (uintptr_t)parca)) {
+            munmap(parca, SLAB_PARCA_BOYUT);
+            return NULL;
+        }
+        slab_parca_imlec[sinif] = parca + SLAB_PARCA_BASLIK;
+        slab_parca_son[sinif] = parca + SLAB_PARCA_BOYUT;
+    }
+    void *d = slab_parca_imlec[sinif];
+    slab_parca_imlec[sinif] += boyut;
+    ((NesneBaslik *)d)->tip = NESNE_TIP_SERBEST;
+    return d;
+}
+
+/* Yerel onbellegin bir sinifindan n dilimi genel listeye tasi */
+static void slab_yerel_bosalt(SlabOnbellek *ob, int sinif, int n) {
+    if (n <= 0 || !ob->liste[sinif]) return;
+    SlabDilim *bas = ob->liste[sinif];
+    SlabDilim *son = bas;
+    int k = 1;
+    while (k < n && son->sonraki) { son = son->sonraki; k++; }
+    ob->liste[sinif] = son->sonraki;
+    ob->sayi[sinif] -= k;
+    slab_kilitle();
+    son->sonraki = slab_serbest[sinif];
+    slab_serbest[sinif] = bas;
+    slab_kilit_birak();
+}
+
+/* Is parcacigi sonlaninca onbellegi genel listeye iade et */
+static void slab_yerel_yikici(void *arg) {
+    SlabOnbellek *ob = (SlabOnbellek *)arg;
+    for (int i = 0; i < SLAB_SINIF_SAYISI; i++) {
+        slab_yerel_bosalt(ob, i, ob->sayi[i]);
+    }
+}
+
+static void slab_anahtar_olustur(void) {
+    pthread_key_create(&slab_anahtar, slab_yerel_yikici);
+}
+
+static void slab_yerel_kaydet(SlabOnbellek *ob) {
+    pthread_once(&slab_anahtar_bir, slab_anahtar_olustur);
+    pthread_setspecific(slab_anahtar, ob);
+    ob->kayitli = 1;
+}
+
+/* Genel listeden (ya da yeni parcadan) SLAB_PARTI dilim al */
+static void slab_yerel_doldur(SlabOnbellek *ob, int sinif) {
+    if (!ob->kayitli) slab_yerel_kaydet(ob);
+    slab_kilitle();
+    for (int i = 0; i < SLAB_PARTI; i++) {
+        SlabDilim *d = slab_serbest[sinif];
+        if (d) {
+            slab_serbest[sinif] = d->sonraki;
+        } else {
+            d = (SlabDilim *)slab_parcadan_kes(sinif);
+            if (!d) break;
+        }
+        d->sonraki = ob->liste[sinif];
+        ob->liste[sinif] = d;
+        ob->sayi[sinif]++;
+    }
+    slab_kilit_birak();
+}
+
+static void *slab_ayir(int sinif) {
+    SlabOnbellek *ob = &slab_yerel;
+    if (!ob->liste[sinif]) {
+        slab_yerel_doldur(ob, sinif);
+        if (!ob->liste[sinif]) return NULL;
+    }
+    SlabDilim *d = ob->liste[sinif];
+    ob->liste[sinif] = d->sonraki;
+    ob->sayi[sinif]--;
+    return d;
+}
+
+static void slab_birak(void *p, int sinif) {
+    SlabOnbellek *ob = &slab_yerel;
+    /* Yalnizca birakan is parcacigi da cikista onbellegini iade etmeli */
+    if (!ob->kayitli) slab_yerel_kaydet(ob);
+    SlabDilim *d = (SlabDilim *)p;
+    ((NesneBaslik *)p)->tip = NESNE_TIP_SERBEST;
+    d->sonraki = ob->liste[sinif];
+    ob->liste[sinif] = d;
+    ob->sayi[sinif]++;
+    /* Baska is parcacigindan gelen nesneler birikmesin */
+    if (ob->sayi[sinif] > 2 * SLAB_PARTI) {
+        slab_yerel_bosalt(ob, sinif, SLAB_PARTI);
+    }
+}
+
+/* Buyuk nesne eslemesi: SlabParca, bit haritasi, NesneBaslik, yuk. Bit
+ * haritasi eslemenin yaklasik iki katini kapsar; yerinde buyutme bu sinira
+ * kadar yapilir. Sayfa artigi kapasiteye katilir. */
+static NesneBaslik *buyuk_ayir(long long toplam) {
+    long long sayfa = sysconf(_SC_PAGESIZE);
+    long long kelime = (toplam + sayfa + 255) / 256;
+    long long baslik = (SLAB_PARCA_BILGI + kelime * 8 + 63) & ~63LL;
+    long long uzunluk = (baslik + toplam + sayfa - 1) & ~(sayfa - 1);
+    char *taban = hizali_esle((size_t)uzunluk);
+    if (!taban) return NULL;
+    SlabParca *p = (SlabParca *)taban;
+    p->sihir = SLAB_PARCA_SIHIR;
+    p->sinif = -1;
+    p->baslik = baslik;
+    p->kelime = kelime;
+    NesneBaslik *b = (NesneBaslik *)(taban + baslik);
+    b->boyut = uzunluk - baslik;
+    slab_kilitle();
+    int tamam = bolge_ata((uintptr_t)b, (uintptr_t)taban);
+    slab_kilit_birak();
+    if (!tamam) {
+        munmap(taban, (size_t)uzunluk);
+        return NULL;
+    }
+    return b;
+}
 
 /* Yonetilen nesne olustur: header + kullanici alani */
 void *_tr_nesne_olustur(long long tip, long long boyut) {
     long long toplam = boyut + NESNE_BASLIK_BOYUT;
-    void *raw = mmap(NULL, (size_t)toplam, PROT_READ | PROT_WRITE,
-                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
-    if (raw == MAP_FAILED) return NULL;
+    void *raw;
+    int sinif = slab_sinif_bul(toplam);
+    if (sinif >= 0) {
+        raw = slab_ayir(sinif);
+        if (!raw) return NULL;
+        toplam = slab_sinif_boyut[sinif];
+        /* Birakilan dilim eski icerigini tasir: yapicida verilmeyen sinif
+         * alanlari ve dizi kapasite artigi, mmap'li buyuk nesnelerde oldugu
+         * gibi sifir baslamalidir */
+        memset((char *)raw + NESNE_BASLIK_BOYUT, 0, (size_t)(toplam - NESNE_BASLIK_BOYUT));
+    } else {
+        /* mmap sayfalari zaten sifirdir */
+        raw = buyuk_ayir(toplam);
+        if (!raw) return NULL;
+        toplam = ((NesneBaslik *)raw)->boyut;
+    }
     NesneBaslik *b = (NesneBaslik *)raw;
     b->ref_sayisi = 1;
     b->tip = tip;
     b->boyut = toplam;
-    memset((char *)raw + NESNE_BASLIK_BOYUT, 0, (size_t)boyut);
     return (char *)raw + NESNE_BASLIK_BOYUT;
 }
 
+/* Deger canli bir yonetilen nesnenin yuk adresi mi? Kilit almaz: parcalar
+ * hic iade edilmez, bolge kaydi ve parca bilgisi yayinlanmadan once yazilir.
+ * Bulunursa *taban nesnenin parca (ya da buyuk esleme) basidir. */
+static inline NesneBaslik *nesne_bul(long long deger, uintptr_t *taban) {
+    uintptr_t a = (uintptr_t)deger;
+    if (a < 4096 || (a & 7) != 0) return NULL;
+    uintptr_t hdr = a - NESNE_BASLIK_BOYUT;
+    uintptr_t t = bolge_bul(hdr);
+    if (!t) return NULL;
+    const SlabParca *p = (const SlabParca *)t;
+    NesneBaslik *b = (NesneBaslik *)hdr;
+    if (p->sinif >= 0) {
+        uintptr_t boyut = (uintptr_t)slab_sinif_boyut[p->sinif];
+        uintptr_t ofs = hdr - t;
+        if (ofs < SLAB_PARCA_BASLIK || ofs + boyut > SLAB_PARCA_BOYUT) return NULL;
+        ofs -= SLAB_PARCA_BASLIK;
+        /* Henuz kesilmemis dilimler sifirdir: boyut alani eslesmez */
+        if (((ofs * (uintptr_t)p->ters) >> 40) * boyut != ofs ||
+            (uintptr_t)b->boyut != boyut) return NULL;
+    } else if (hdr != t + (uintptr_t)p->baslik) {
+        return NULL;
+    }
+    /* Sayac kontrol edilmez: toplama sirasinda denemeli olarak sifira inebilir */
+    if (b->tip == NESNE_TIP_SERBEST) return NULL;
+    *taban = t;
+    return b;
+}
+
+static inline NesneBaslik *nesne_dogrula(long long deger) {
+    uintptr_t taban;
+    return nesne_bul(deger, &taban);
+}
+
+/* ---- Referans Bit Haritalari ----
+ * Toplayici yalnizca derleyicinin referans yazimi olarak urettigi yuvalari
+ * izler. _tr_ref_yaz her yazimda yuvanin bitini yeni deger yonetilen bir
+ * nesneyse (ve sayaci artirildiysa) 1, degilse 0 yapar; isaretli her yuva
+ * tam olarak bir sayilmis referanstir. Tam sayilar ya da baska yollarla
+ * (modul islevleri, literaller) yazilan degerler hic gezilmez: bunlarin
+ * tuttugu nesneler en kotu ihtimalle sizar, erken birakilmaz.
+ *
+ * Bitler nesnenin kendi parcasinda (buyuk nesnede eslemenin basinda),
+ * tabana gore kelime basina bir bit olarak durur; yan tablo ve kilit
+ * yoktur. Ayni parcadaki dilimler farkli is parcaciklarinin olabilecegi
+ * icin bit degisiklikleri atomiktir. Biti isaretli her nesnenin tip
+ * alaninda NESNE_BAYRAK_REFLI bulunur; bayraksiz nesneler gezilmez ve
+ * birakilirken bitlerine bakilmaz. */
+
+typedef void (*NesneZiyaretFn)(long long deger, void *bag);
+typedef void (*NesneGezFn)(void *nesne, NesneZiyaretFn ziyaret, void *bag);
+typedef void (*NesneSonlandirFn)(void *nesne);
+
+/* Nesnenin yuk kelimelerinin taban'a gore bit araligi */
+static inline void ref_aralik(NesneBaslik *b, uintptr_t taban,
+                              uintptr_t *bas, uintptr_t *son) {
+    *bas = ((uintptr_t)b + NESNE_BASLIK_BOYUT - taban) >> 3;
+    *son = ((uintptr_t)b + (uintptr_t)b->boyut - taban) >> 3;
+}
+
+static void ref_bitleri_temizle(NesneBaslik *b, uintptr_t taban) {
+    uint64_t *bitler = REF_BITLER(taban);
+    uintptr_t bas, son;
+    ref_aralik(b, taban, &bas, &son);
+    while (bas < son) {
+        uintptr_t ust = ((bas >> 6) + 1) << 6;
+        if (ust > son) ust = son;
+        uint64_t maske = ust - bas == 64 ? ~0ULL : ((1ULL << (ust - bas)) - 1) << (bas & 63);
+        uint64_t *k = &bitler[bas >> 6];
+        if (__atomic_load_n(k, __ATOMIC_RELAXED) & maske)
+            __atomic_fetch_and(k, ~maske, __ATOMIC_RELAXED);
+        bas = ust;
+    }
+}
+
+/* Isaretli yuvalari gez */
+static void ref_bitleri_gez(NesneBaslik *b, NesneZiyaretFn ziyaret, void *bag) {
+    if (!(b->tip & NESNE_BAYRAK_REFLI)) return;
+    uintptr_t taban = bolge_bul((uintptr_t)b);
+    if (!taban) return;
+    const uint64_t *bitler = REF_BITLER(taban);
+    const long long *kelimeler = (const long long *)taban;
+    uintptr_t bas, son;
+    ref_aralik(b, taban, &bas, &son);
+    for (uintptr_t w = bas >> 6; (w << 6) < son; w++) {
+        uint64_t x = __atomic_load_n(&bitler[w], __ATOMIC_RELAXED);
+        if ((w << 6) < bas) x &= ~0ULL << (bas & 63);
+        if (((w + 1) << 6) > son) x &= (1ULL << (son & 63)) - 1;
+        while (x) {
+            uintptr_t i = (w << 6) + (uintptr_t)__builtin_ctzll(x);
+            x &= x - 1;
+            ziyaret(kelimeler[i], bag);
+        }
+    }
+}
+
+/* ---- Tip Tanimlayicilari ----
+ * Toplayici bir nesnenin cocuklarini tipinin gezicisiyle bulur. Dizi, sinif
+ * ve kapanis yuvalari derleyicinin referans yazimlariyla isaretlenir ve bit
+ * haritasindan gezilir. Sozluk ve kume tablolari nesnenin disinda
+ * durdugundan modulleri kendi gezicilerini kaydeder; bunlar da yalnizca
+ * _tr_ref_tut ile sayilmis degerleri ziyaret eder; dis tablolarini da
+ * nesne birakilirken sonlandiricilari serbest birakir. */
+
+#define NESNE_TIP_SAYISI 16
+
+static void isaretli_gez(void *nesne, NesneZiyaretFn ziyaret, void *bag) {
+    ref_bitleri_gez(NESNE_BASLIK(nesne), ziyaret, bag);
+}
+
+typedef struct {
+    NesneGezFn gez;
+    NesneSonlandirFn sonlandir;
+} NesneTipTanim;
+
+static NesneTipTanim nesne_tipleri[NESNE_TIP_SAYISI] = {
+    [NESNE_TIP_DIZI]    = { isaretli_gez, NULL },
+    [NESNE_TIP_SINIF]   = { isaretli_gez, NULL },
+    [NESNE_TIP_KAPANIS] = { isaretli_gez, NULL },
+};
+
+void _tr_nesne_tip_kaydet(long long tip, NesneGezFn gez, NesneSonlandirFn sonlandir) {
+    if (tip < 0 || tip >= NESNE_TIP_SAYISI) return;
+    nesne_tipleri[tip].gez = gez;
+    nesne_tipleri[tip].sonlandir = sonlandir;
+}
+
+static void nesne_serbest_birak(NesneBaslik *b) {
+    long long tip = b->tip & NESNE_TIP_MASKE;
+    if (tip < NESNE_TIP_SAYISI && nesne_tipleri[tip].sonlandir)
+        nesne_tipleri[tip].sonlandir((char *)b + NESNE_BASLIK_BOYUT);
+    if (b->boyut <= SLAB_MAKS_BOYUT) {
+        if (b->tip & NESNE_BAYRAK_REFLI)
+            ref_bitleri_temizle(b, (uintptr_t)b & ~(uintptr_t)(SLAB_PARCA_BOYUT - 1));
+        slab_birak(b, slab_sinif_bul(b->boyut));
+    } else {
+        uintptr_t taban = bolge_bul((uintptr_t)b);
+        size_t uzunluk = (size_t)(((SlabParca *)taban)->baslik + b->boyut);
+        slab_kilitle();
+        bolge_ata((uintptr_t)b, 0);
+        slab_kilit_birak();
+        munmap((void *)taban, uzunluk);
+    }
+}
+
+/* Nesneyi tasimadan buyutmeye calis (yalnizca buyuk/mmap nesneler icin,
+ * mremap ile). Basarida 1 doner; adres degismedigi icin eski gorunumler
+ * gecerli kalir. Slab nesneleri zaten sinif boyutunda ayrildigindan, bit
+ * haritasinin kapsamini asan buyutmeler de yer degistirmeli oldugundan 0
+ * doner. */
+int _tr_nesne_yerinde_buyut(void *ptr, long long yeni_boyut) {
+    if (!ptr) return 0;
+    NesneBaslik *b = NESNE_BASLIK(ptr);
+    long long toplam = yeni_boyut + NESNE_BASLIK_BOYUT;
+    if (toplam <= b->boyut) return 1;
+    if (b->boyut <= SLAB_MAKS_BOYUT) return 0;
+    SlabParca *p = (SlabParca *)bolge_bul((uintptr_t)b);
+    long long sayfa = sysconf(_SC_PAGESIZE);
+    long long uzunluk = (p->baslik + toplam + sayfa - 1) & ~(sayfa - 1);
+    if (uzunluk > p->kelime * 64 * 8) return 0;
+    if (mremap(p, (size_t)(p->baslik + b->boyut), (size_t)uzunluk, 0) == MAP_FAILED) return 0;
+    b->boyut = uzunluk - p->baslik;
+    return 1;
+}
+
+/* ---- Dongu Toplayici (deneme silme, Bacon-Rajan) ----
+ *
+ * Referans sayisi sifira dusmeden azalan ve sayilmis referans tutan her
+ * nesne olasi kok olarak is parcacigi yerel tampona girer (MOR). Tampon esige ulasinca
+ * toplama calisir: kokler ve ulasilabilir alt cizge denemeli olarak
+ * azaltilir (GRI), sayisi sifirda kalanlar BEYAZ'dir ve serbest birakilir,
+ * disaridan tutulanlar ise SIYAH'a geri dondurulur.
+ *
+ * Paylasilmis (baska is parcacigina yayinlanmis) nesneler disaridan
+ * tutuluyor kabul edilir: ne kok olur ne de gezilir.
+ *
+ * Sinir: yerel degiskenler sayilmis referans degildir. Nesne olusturulurken
+ * gelen ilk sayac yerel sahipliktir ve yalnizca nesne_bırak ile birakilir;
+ * degisken kapsamdan cikinca dusurulmez. Bu yuzden bir dongu ancak uyeleri
+ * nesne_bırak ile birakildiktan sonra toplanabilir, birakilmamis dongu
+ * kapsam bitse de sizar ve çöp_topla() onu gormez (bkz. testler/test_cop.tr).
+ *
+ * Ayarlar: TR_COP=0 toplayiciyi kapatir, TR_COP_ESIK=N kok esigini belirler.
+ */
+
+#define NESNE_RENK_KAYMA   9
+#define NESNE_RENK_MASKE   (3LL << NESNE_RENK_KAYMA)
+#define NESNE_BAYRAK_TAMPONDA (1LL << 11)
+
+enum { RENK_SIYAH = 0, RENK_GRI = 1, RENK_BEYAZ = 2, RENK_MOR = 3 };
+
+#define COP_VARSAYILAN_ESIK 10000
+
+static inline int nesne_renk(NesneBaslik *b) {
+    return (int)((b->tip & NESNE_RENK_MASKE) >> NESNE_RENK_KAYMA);
+}
+
+static inline void nesne_renk_ata(NesneBaslik *b, int renk) {
+    b->tip = (b->tip & ~NESNE_RENK_MASKE) | ((long long)renk << NESNE_RENK_KAYMA);
+}
+
+typedef struct {
+    NesneBaslik **ogeler;
+    long long sayi;
+    long long kapasite;
+} NesneYigin;
+
+static int yigin_it(NesneYigin *y, NesneBaslik *b) {
+    if (y->sayi >= y->kapasite) {
+        long long yeni = y->kapasite ? y->kapasite * 2 : 64;
+        NesneBaslik **p = (NesneBaslik **)realloc(y->ogeler, (size_t)yeni * sizeof(*p));
+        if (!p) return 0;
+        y->ogeler = p;
+        y->kapasite = yeni;
+    }
+    y->ogeler[y->sayi++] = b;
+    return 1;
+}
+
+static int cop_ayar_okundu = 0;
+static int cop_etkin = 1;
+static long long cop_esik = COP_VARSAYILAN_ESIK;
+
+/* Istatistikler (tum is parcaciklari icin toplam) */
+static long long cop_calisma_sayisi = 0;
+static long long cop_toplanan = 0;
+static long long cop_toplam_ns = 0;
+static long long cop_maks_ns = 0;
+static long long cop_son_ns = 0;
+
+static _Thread_local NesneYigin cop_kokler;
+static _Thread_local int cop_calisiyor = 0;
+
+static void cop_ayar_oku(void) {
+    const char *e = getenv("TR_COP");
+    if (e && e[0] == '0') cop_etkin = 0;
+    const char *s = getenv("TR_COP_ESIK");
+    if (s) {
+        long long n = atoll(s);
+        if (n > 0) cop_esik = n;
+    }
+    cop_ayar_okundu = 1;
+}
+
+long long _tr_cop_topla(void);
+static void nesne_yok_et(NesneBaslik *b);
+
+/* Gezinti sirasinda tip basina yapilacak is */
+typedef struct {
+    NesneYigin *yigin;
+    int islem;
+} CopBag;
+
+enum { COP_AZALT, COP_ARTIR, COP_TARA, COP_BEYAZ_TOPLA, COP_SERBEST };
+
+static void cop_ziyaret(long long deger, void *arg) {
+    CopBag *bag = (CopBag *)arg;
+    NesneBaslik *c = nesne_dogrula(deger);
+    if (!c) return;
+    if (c->tip & NESNE_BAYRAK_PAYLASILMIS) {
+        if (bag->islem == COP_SERBEST &&
+            __atomic_sub_fetch(&c->ref_sayisi, 1, __ATOMIC_ACQ_REL) <= 0) {
+            yigin_it(bag->yigin, c);
+        }
+        return;
+    }
+    switch (bag->islem) {
+    case COP_AZALT:         /* MarkGray */
+        c->ref_sayisi--;
+        if (nesne_renk(c) != RENK_GRI) {
+            nesne_renk_ata(c, RENK_GRI);
+            yigin_it(bag->yigin, c);
+        }
+        break;
+    case COP_ARTIR:         /* ScanBlack */
+        c->ref_sayisi++;
+        if (nesne_renk(c) != RENK_SIYAH) {
+            nesne_renk_ata(c, RENK_SIYAH);
+            yigin_it(bag->yigin, c);
+        }
+        break;
+    case COP_TARA:          /* Scan */
+        if (nesne_renk(c) == RENK_GRI) yigin_it(bag->yigin, c);
+        break;
+    case COP_BEYAZ_TOPLA:   /* CollectWhite */
+        if (nesne_renk(c) == RENK_BEYAZ && !(c->tip & NESNE_BAYRAK_TAMPONDA)) {
+            nesne_renk_ata(c, RENK_SIYAH);
+            yigin_it(bag->yigin, c);
+        }
+        break;
+    case COP_SERBEST:       /* Release: cocuklarin sayacini dusur */
+        if (--c->ref_sayisi <= 0) yigin_it(bag->yigin, c);
+        break;
+    }
+}
+
+static void cocuklari_gez(NesneBaslik *b, CopBag *bag) {
+    long long tip = b->tip & NESNE_TIP_MASKE;
+    if (!(b->tip & NESNE_BAYRAK_REFLI) || tip >= NESNE_TIP_SAYISI || !nesne_tipleri[tip].gez) return;
+    nesne_tipleri[tip].gez((char *)b + NESNE_BASLIK_BOYUT, cop_ziyaret, bag);
+}
+
+/* Sayaci sifira dusen nesneyi ve yalnizca onun tuttugu nesneleri birak */
+static void nesne_yok_et(NesneBaslik *b) {
+    NesneYigin y = {0};
+    CopBag bag = { &y, COP_SERBEST };
+    yigin_it(&y, b);
+    while (y.sayi > 0) {
+        NesneBaslik *x = y.ogeler[--y.sayi];
+        cocuklari_gez(x, &bag);
+        nesne_renk_ata(x, RENK_SIYAH);
+        /* Tampondaki nesneyi toplayici bosaltir */
+        if (!(x->tip & NESNE_BAYRAK_TAMPONDA)) nesne_serbest_birak(x);
+    }
+    free(y.ogeler);
+}
+
+static void olasi_kok(NesneBaslik *b) {
+    if (!cop_ayar_okundu) cop_ayar_oku();
+    /* Isaretli referansi olmayan nesne donguye katilamaz */
+    if (!cop_etkin || cop_calisiyor || !(b->tip & NESNE_BAYRAK_REFLI)) return;
+    if (nesne_renk(b) != RENK_MOR) {
+        nesne_renk_ata(b, RENK_MOR);
+        if (!(b->tip & NESNE_BAYRAK_TAMPONDA)) {
+            if (!yigin_it(&cop_kokler, b)) return;
+            b->tip |= NESNE_BAYRAK_TAMPONDA;
+            if (cop_kokler.sayi >= cop_esik) _tr_cop_topla();
+        }
+    }
+}
+
+static void cop_gri_isaretle(NesneBaslik *kok, NesneYigin *y) {
+    CopBag bag = { y, COP_AZALT };
+    nesne_renk_ata(kok, RENK_GRI);
+    yigin_it(y, kok);
+    while (y->sayi > 0) cocuklari_gez(y->ogeler[--y->sayi], &bag);
+}
+
+static void cop_siyah_tara(NesneBaslik *kok, NesneYigin *y) {
+    CopBag bag = { y, COP_ARTIR };
+    nesne_renk_ata(kok, RENK_SIYAH);
+    long long taban = y->sayi;
+    yigin_it(y, kok);
+    while (y->sayi > taban) cocuklari_gez(y->ogeler[--y->sayi], &bag);
+}
+
+static void cop_tara(NesneBaslik *kok, NesneYigin *y) {
+    CopBag bag = { y, COP_TARA };
+    yigin_it(y, kok);
+    while (y->sayi > 0) {
+        NesneBaslik *x = y->ogeler[--y->sayi];
+        if (nesne_renk(x) != RENK_GRI) continue;
+        if (x->ref_sayisi > 0) {
+            cop_siyah_tara(x, y);
+        } else {
+            nesne_renk_ata(x, RENK_BEYAZ);
+            cocuklari_gez(x, &bag);
+        }
+    }
+}
+
+static void cop_beyaz_topla(NesneBaslik *kok, NesneYigin *y, NesneYigin *cop) {
+    CopBag bag = { y, COP_BEYAZ_TOPLA };
+    if (nesne_renk(kok) != RENK_BEYAZ || (kok->tip & NESNE_BAYRAK_TAMPONDA)) return;
+    nesne_renk_ata(kok, RENK_SIYAH);
+    yigin_it(y, kok);
+    while (y->sayi > 0) {
+        NesneBaslik *x = y->ogeler[--y->sayi];
+        cocuklari_gez(x, &bag);
+        yigin_it(cop, x);
+    }
+}
+
+/* çöp_topla() -> tam: tampondaki olasi kokleri tara, toplanan nesne sayisini dondur */
+long long _tr_cop_topla(void) {
+    if (cop_calisiyor || cop_kokler.sayi == 0) return 0;
+    cop_calisiyor = 1;
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    NesneYigin y = {0}, cop = {0};
+    long long n = 0;
+
+    /* MarkRoots */
+    for (long long i = 0; i < cop_kokler.sayi; i++) {
+        NesneBaslik *b = cop_kokler.ogeler[i];
+        if (nesne_renk(b) == RENK_MOR && b->ref_sayisi > 0) {
+            cop_gri_isaretle(b, &y);
+            cop_kokler.ogeler[n++] = b;
+        } else {
+            b->tip &= ~NESNE_BAYRAK_TAMPONDA;
+            if (nesne_renk(b) == RENK_SIYAH && b->ref_sayisi <= 0) {
+                nesne_serbest_birak(b);
+            }
+        }
+    }
+    cop_kokler.sayi = n;
+
+    /* ScanRoots */
+    for (long long i = 0; i < cop_kokler.sayi; i++) {
+        cop_tara(cop_kokler.ogeler[i], &y);
+    }
+
+    /* CollectRoots */
+    for (long long i = 0; i < cop_kokler.sayi; i++) {
+        NesneBaslik *b = cop_kokler.ogeler[i];
+        b->tip &= ~NESNE_BAYRAK_TAMPONDA;
+        cop_beyaz_topla(b, &y, &cop);
+    }
+    cop_kokler.sayi = 0;
+
+    /* Gezinti bitti: beyazlari simdi birak */
+    for (long long i = 0; i < cop.sayi; i++) {
+        nesne_serbest_birak(cop.ogeler[i]);
+    }
+    long long toplanan = cop.sayi;
+    free(y.ogeler);
+    free(cop.ogeler);
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    long long ns = (t1.tv_sec - t0.tv_sec) * 1000000000LL + (t1.tv_nsec - t0.tv_nsec);
+    __atomic_fetch_add(&cop_calisma_sayisi, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&cop_toplanan, toplanan, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&cop_toplam_ns, ns, __ATOMIC_RELAXED);
+    __atomic_store_n(&cop_son_ns, ns, __ATOMIC_RELAXED);
+    long long maks = __atomic_load_n(&cop_maks_ns, __ATOMIC_RELAXED);
+    while (ns > maks &&
+           !__atomic_compare_exchange_n(&cop_maks_ns, &maks, ns, 0,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) { }
+    cop_calisiyor = 0;
+    return toplanan;
+}
+
+/* çöp_ayarla(etkin: tam, eşik: tam): eşik <= 0 ise mevcut eşik korunur */
+void _tr_cop_ayarla(long long etkin, long long esik) {
+    if (!cop_ayar_okundu) cop_ayar_oku();
+    cop_etkin = etkin != 0;
+    if (esik > 0) cop_esik = esik;
+    if (!cop_etkin) _tr_cop_topla();
+}
+
+/* çöp_rapor(): toplayici istatistiklerini stderr'e yaz */
+void _tr_cop_rapor(void) {
+    double toplam_ms = (double)cop_toplam_ns / 1000000.0;
+    double ort_us = cop_calisma_sayisi > 0 ?
+        (double)cop_toplam_ns / (double)cop_calisma_sayisi / 1000.0 : 0.0;
+    fprintf(stderr, "\n=== D\xc3\xb6ng\xc3\xbc Toplay\xc4\xb1" "c\xc4\xb1 ===\n");
+    fprintf(stderr, "Durum:        %s (e\xc5\x9fik %lld)\n",
+            cop_etkin ? "etkin" : "kapal\xc4\xb1", cop_esik);
+    fprintf(stderr, "\xc3\x87" "al\xc4\xb1\xc5\x9fma:      %lld\n", cop_calisma_sayisi);
+    fprintf(stderr, "Toplanan:     %lld nesne\n", cop_toplanan);
+    fprintf(stderr, "Toplam durma: %.3f ms\n", toplam_ms);
+    fprintf(stderr, "Ort. durma:   %.3f us\n", ort_us);
+    fprintf(stderr, "Maks. durma:  %.3f us\n", (double)cop_maks_ns / 1000.0);
+    fprintf(stderr, "Son durma:    %.3f us\n", (double)cop_son_ns / 1000.0);
+    fprintf(stderr, "=====================\n");
+}
+
+/* Nesneyi baska is parcacigina yayinla: bundan sonra sayac atomik guncellenir.
+ * Yayinlayan is parcacigi nesneyi devretmeden once cagirmalidir. Yonetilen
+ * nesne olmayan degerlere (tam sayilar, rodata, malloc bloklari) dokunulmaz. */
+void _tr_nesne_paylas(void *ptr) {
+    NesneBaslik *b = nesne_dogrula((long long)ptr);
+    if (!b) return;
+    __atomic_fetch_or(&b->tip, NESNE_BAYRAK_PAYLASILMIS, __ATOMIC_RELEASE);
+}
+
+/* Dizi degiskeni baska bir degiskene ya da alana atandi: tampon artik
+ * ekle ile yerinde buyutulmez (bkz. dizi_cz.c). Yonetilen dizi olmayan
+ * degerlere dokunulmaz. */
+void _tr_dizi_ortakla(void *ptr) {
+    NesneBaslik *b = nesne_dogrula((long long)ptr);
+    if (b && (b->tip & NESNE_TIP_MASKE) == NESNE_TIP_DIZI && !(b->tip & NESNE_BAYRAK_ORTAK))
+        __atomic_fetch_or(&b->tip, NESNE_BAYRAK_ORTAK, __ATOMIC_RELAXED);
+}
+
 /* Referans artir */
 void _tr_ref_artir(void *ptr) {
     if (!ptr) return;
-    NESNE_BASLIK(ptr)->ref_sayisi++;
+    NesneBaslik *b = NESNE_BASLIK(ptr);
+    if (b->tip & NESNE_BAYRAK_PAYLASILMIS) {
+        __atomic_fetch_add(&b->ref_sayisi, 1, __ATOMIC_RELAXED);
+    } else {
+        b->ref_sayisi++;
+        nesne_renk_ata(b, RENK_SIYAH);
+    }
 }
 
-/* Referans azalt, 0'a duserse serbest birak */
+/* Referans azalt, 0'a duserse serbest birak; aksi halde olasi dongu koku */
 void _tr_ref_azalt(void *ptr) {
     if (!ptr) return;
     NesneBaslik *b = NESNE_BASLIK(ptr);
-    if (--b->ref_sayisi <= 0) {
-        munmap(b, (size_t)b->boyut);
+    if (b->tip & NESNE_BAYRAK_PAYLASILMIS) {
+        if (__atomic_sub_fetch(&b->ref_sayisi, 1, __ATOMIC_ACQ_REL) <= 0) {
+            nesne_yok_et(b);
+        }
+    } else if (--b->ref_sayisi <= 0) {
+        nesne_yok_et(b);
+    } else {
+        olasi_kok(b);
     }
 }
 
+/* Nesnenin 'indeks'inci kelimesine referans olabilecek bir deger yaz.
+ * Derleyici referans tipli alan ve dizi eleman atamalarinda cagirir:
+ * yeni deger yonetilen nesneyse sayaci artar ve yuva isaretlenir, eski
+ * degerin yuvasi isaretliyse sayaci azalir. Hedef yonetilen nesne degilse
+ * (rodata, dilim gorunumu) duz yazimdir. */
+void _tr_ref_yaz(void *nesne, long long indeks, long long deger) {
+    long long *yuva = (long long *)nesne + indeks;
+    uintptr_t taban;
+    NesneBaslik *b = nesne_bul((long long)nesne, &taban);
+    if (!b) {
+        *yuva = deger;
+        return;
+    }
+    uintptr_t i = ((uintptr_t)yuva - taban) >> 3;
+    uint64_t *k = &REF_BITLER(taban)[i >> 6];
+    uint64_t bit = 1ULL << (i & 63);
+    int eski_ref = (__atomic_load_n(k, __ATOMIC_RELAXED) & bit) != 0;
+    long long eski = *yuva;
+    /* Ayni sayilmis referansi yeniden yazmak sayaclari degistirmez */
+    if (eski_ref && eski == deger) return;
+    int ref = nesne_dogrula(deger) != NULL;
+    if (ref) _tr_ref_artir((void *)deger);
+    *yuva = deger;
+    if (ref && !eski_ref) {
+        if (!(b->tip & NESNE_BAYRAK_REFLI))
+            __atomic_fetch_or(&b->tip, NESNE_BAYRAK_REFLI, __ATOMIC_RELAXED);
+        __atomic_fetch_or(k, bit, __ATOMIC_RELAXED);
+    } else if (!ref && eski_ref) {
+        __atomic_fetch_and(k, ~bit, __ATOMIC_RELAXED);
+    }
+    if (eski_ref) _tr_ref_azalt((void *)eski);
+}
+
+/* Yuvalari yerinde yer degistiren islevler (sirala) icin: bitleri sil.
+ * Isaretli yuvalarin sayaclari dusurulmez; tuttuklari nesneler toplayici
+ * icin disaridan tutulmus sayilir (sizar, erken birakilmaz). */
+void _tr_ref_izleme_birak(void *nesne) {
+    uintptr_t taban;
+    NesneBaslik *b = nesne_bul((long long)nesne, &taban);
+    if (!b || !(b->tip & NESNE_BAYRAK_REFLI)) return;
+    ref_bitleri_temizle(b, taban);
+    __atomic_fetch_and(&b->tip, ~NESNE_BAYRAK_REFLI, __ATOMIC_RELAXED);
+}
+
+/* Modul tablolari (sozluk, kume) icin: deger yonetilen bir nesneyse
+ * sayacini artir, kabi isaretle ve 1 dondur. Kap bu degeri birakirken
+ * _tr_ref_azalt cagirmali, gezicisi yalnizca bu degerleri ziyaret etmelidir. */
+int _tr_ref_tut(void *kap, long long deger) {
+    NesneBaslik *b = nesne_dogrula((long long)kap);
+    if (!b || !nesne_dogrula(deger)) return 0;
+    _tr_ref_artir((void *)deger);
+    if (!(b->tip & NESNE_BAYRAK_REFLI))
+        __atomic_fetch_or(&b->tip, NESNE_BAYRAK_REFLI, __ATOMIC_RELAXED);
+    return 1;
+}
+
+/* nesne_bırak(x): yerel sahipligi birak. Sayac sifira inerse nesne ve
+ * yalnizca onun tuttuklari birakilir, aksi halde olasi dongu kokudur.
+ * Yonetilen nesne olmayan degerler yok sayilir. */
+void _tr_nesne_birak(long long deger) {
+    if (nesne_dogrula(deger)) _tr_ref_azalt((void *)deger);
+}
+
+/* ---- Kapanis cagrilari ----
+ * Derlenen kod kapanisi r10'da bekler (bkz. uretici.c dolayli cagri).
+ * C'den cagri icin kopruler: rdi = kapanis, ardindan argumanlar. Kapanis
+ * r10'a ve bildirilen argumanlardan sonraki yazmaca konur, koda atlanir. */
+#if defined(__x86_64__)
+__asm__(
+    "    .text\n"
+    "    .globl  _tr_kapanis_cagir0\n"
+    "    .type   _tr_kapanis_cagir0, @function\n"
+    "_tr_kapanis_cagir0:\n"
+    "    movq    %rdi, %r10\n"
+    "    jmp     *(%r10)\n"
+    "    .size   _tr_kapanis_cagir0, .-_tr_kapanis_cagir0\n"
+    "    .globl  _tr_kapanis_cagir1\n"
+    "    .type   _tr_kapanis_cagir1, @function\n"
+    "_tr_kapanis_cagir1:\n"
+    "    movq    %rdi, %r10\n"
+    "    movq    %rsi, %rdi\n"
+    "    movq    %r10, %rsi\n"
+    "    jmp     *(%r10)\n"
+    "    .size   _tr_kapanis_cagir1, .-_tr_kapanis_cagir1\n"
+    "    .globl  _tr_kapanis_cagir2\n"
+    "    .type   _tr_kapanis_cagir2, @function\n"
+    "_tr_kapanis_cagir2:\n"
+    "    movq    %rdi, %r10\n"
+    "    movq    %rsi, %rdi\n"
+    "    movq    %rdx, %rsi\n"
+    "    movq    %r10, %rdx\n"
+    "    jmp     *(%r10)\n"
+    "    .size   _tr_kapanis_cagir2, .-_tr_kapanis_cagir2\n");
+#else
+long long _tr_kapanis_cagir0(const long long *k) {
+    return ((long long (*)(const long long *))k[0])(k);
+}
+
+long long _tr_kapanis_cagir1(const long long *k, long long a) {
+    return ((long long (*)(long long, const long long *))k[0])(a, k);
+}
+
+long long _tr_kapanis_cagir2(const long long *k, long long a, long long b) {
+    return ((long long (*)(long long, long long, const long long *))k[0])(a, b, k);
+}
+#endif
+
 /* ---- I/O ---- */
 
 /* Satirdan oku */
@@ -323,86 +1199,172 @@ void _tr_dizi_sinir_hatasi(void) {
     exit(1);
 }
 
-/* ========== İstisna İşleme (LLVM backend) ========== */
+/* ========== İstisna İşleme (tablo tabanlı) ==========
+ *
+ * dene bloğu çalışma zamanında hiçbir şey kaydetmez. Üretilen kod her
+ * işlev için .eh_frame (CFI) ve dene aralıklarını iniş pistlerine eşleyen
+ * bir LSDA (.gcc_except_table) yayar; LLVM arka ucu aynı tabloları invoke /
+ * landingpad ile üretir. fırlat bir istisna nesnesi ayırıp
+ * _Unwind_RaiseException'ı çağırır, yığın çözücü aşağıdaki kişilik
+ * işlevini (_tr_kisilik) her çerçeve için sorar. Yakalanan değer iş
+ * parçacığına özeldir.
+ */
 
-#include <setjmp.h>
+#include <unwind.h>
 
-#define ISTISNA_MAKS_DERINLIK 32
+/* "TONYUKUK": yalnız kendi istisnalarımızı yakalarız */
+#define TR_ISTISNA_SINIFI 0x544f4e59554b554bULL
 
 typedef struct {
-    jmp_buf buf;
+    struct _Unwind_Exception baslik;
     long long deger;
     long long deger_len;
     long long tip;
-} TrIstisnaCerceve;
+} TrIstisna;
 
-static TrIstisnaCerceve _istisna_yigin[ISTISNA_MAKS_DERINLIK];
-static int _istisna_derinlik = 0;
+/* İniş pistinin okuduğu yakalanan istisna: [deger, deger_len, tip] */
+static _Thread_local long long _tr_yakalanan[3];
 
-/* dene bloğu başlangıcı: 0=normal, 1=istisna yakalandı */
-int _tr_dene_baslat(void) {
-    if (_istisna_derinlik >= ISTISNA_MAKS_DERINLIK) return -1;
-    TrIstisnaCerceve *c = &_istisna_yigin[_istisna_derinlik++];
-    c->deger = 0;
-    c->tip = 0;
-    return setjmp(c->buf);
+static void istisna_temizle(_Unwind_Reason_Code neden, struct _Unwind_Exception *e) {
+    (void)neden;
+    free(e);
 }
 
-/* dene bloğu normal tamamlandı */
-void _tr_dene_bitir(void) {
-    if (_istisna_derinlik > 0) _istisna_derinlik--;
+/* Tipli istisna fırlat; yakalayan yoksa hatayı yazıp çık */
+void _tr_firlat_tipli(long long deger, long long deger_len, long long tip) {
+    TrIstisna *e = (TrIstisna *)calloc(1, sizeof(TrIstisna));
+    if (e) {
+        e->baslik.exception_class = TR_ISTISNA_SINIFI;
+        e->baslik.exception_cleanup = istisna_temizle;
+        e->deger = deger;
+        e->deger_len = deger_len;
+        e->tip = tip;
+        _Unwind_RaiseException(&e->baslik);
+        free(e);
+    }
+    /* Çalışma zamanı hataları (tip > 0) kendi iletisini taşır */
+    if (tip > 0 && deger && deger_len > 0) {
+        fwrite((const char *)deger, 1, (size_t)deger_len, stderr);
+        if (((const char *)deger)[deger_len - 1] != '\n') fputc('\n', stderr);
+    } else {
+        fprintf(stderr, "Hata: Yakalanmam\xc4\xb1\xc5\x9f istisna!\n");
+    }
+    exit(1);
 }
 
 /* İstisna fırlat */
 void _tr_firlat_deger(long long deger) {
-    if (_istisna_derinlik > 0) {
-        _istisna_derinlik--;
-        TrIstisnaCerceve *c = &_istisna_yigin[_istisna_derinlik];
-        c->deger = deger;
-        c->deger_len = 0;
-        c->tip = 0;
-        longjmp(c->buf, 1);
-    } else {
-        fprintf(stderr, "Hata: Yakalanmam\xc4\xb1\xc5\x9f istisna!\n");
-        exit(1);
-    }
+    _tr_firlat_tipli(deger, 0, 0);
 }
 
-/* Tipli istisna fırlat */
-void _tr_firlat_tipli(long long deger, long long deger_len, long long tip) {
-    if (_istisna_derinlik > 0) {
-        _istisna_derinlik--;
-        TrIstisnaCerceve *c = &_istisna_yigin[_istisna_derinlik];
-        c->deger = deger;
-        c->deger_len = deger_len;
-        c->tip = tip;
-        longjmp(c->buf, 1);
-    } else {
-        fprintf(stderr, "Hata: Yakalanmam\xc4\xb1\xc5\x9f istisna!\n");
-        exit(1);
-    }
+/* İniş pisti: istisna nesnesini bırak, değerlerini iş parçacığına özel
+ * alana taşı. Dönen işaretçi [deger, deger_len, tip] dizisidir. */
+long long *_tr_istisna_yakala(void *nesne) {
+    TrIstisna *e = (TrIstisna *)nesne;
+    _tr_yakalanan[0] = e->deger;
+    _tr_yakalanan[1] = e->deger_len;
+    _tr_yakalanan[2] = e->tip;
+    _Unwind_DeleteException(&e->baslik);
+    return _tr_yakalanan;
 }
 
 /* Yakalanan istisna değeri */
 long long _tr_istisna_deger(void) {
-    if (_istisna_derinlik >= 0 && _istisna_derinlik < ISTISNA_MAKS_DERINLIK) {
-        return _istisna_yigin[_istisna_derinlik].deger;
-    }
-    return 0;
+    return _tr_yakalanan[0];
 }
 
 /* Yakalanan istisna tip kodu */
 long long _tr_istisna_tip(void) {
-    if (_istisna_derinlik >= 0 && _istisna_derinlik < ISTISNA_MAKS_DERINLIK) {
-        return _istisna_yigin[_istisna_derinlik].tip;
-    }
-    return 0;
+    return _tr_yakalanan[2];
 }
 
 /* Yakalanan istisna metin uzunluğu */
 long long _tr_istisna_deger_len(void) {
-    if (_istisna_derinlik >= 0 && _istisna_derinlik < ISTISNA_MAKS_DERINLIK) {
-        return _istisna_yigin[_istisna_derinlik].deger_len;
+    return _tr_yakalanan[1];
+}
+
+/* LSDA değer kodlamaları (DW_EH_PE_*) */
+#define EH_PE_OMIT     0xff
+#define EH_PE_ULEB128  0x01
+#define EH_PE_UDATA2   0x02
+#define EH_PE_UDATA4   0x03
+#define EH_PE_UDATA8   0x04
+#define EH_PE_SDATA2   0x0a
+#define EH_PE_SDATA4   0x0b
+#define EH_PE_SDATA8   0x0c
+
+static uintptr_t lsda_uleb(const unsigned char **p) {
+    uintptr_t sonuc = 0;
+    int kayma = 0;
+    unsigned char b;
+    do {
+        b = *(*p)++;
+        sonuc |= (uintptr_t)(b & 0x7f) << kayma;
+        kayma += 7;
+    } while (b & 0x80);
+    return sonuc;
+}
+
+/* Çağrı noktası tablosundaki bir değer (yalnız biçim, uygulama bitleri yok) */
+static uintptr_t lsda_oku(const unsigned char **p, unsigned char kodlama) {
+    uintptr_t v = 0;
+    switch (kodlama & 0x0f) {
+    case EH_PE_ULEB128: return lsda_uleb(p);
+    case EH_PE_UDATA2: { uint16_t x; memcpy(&x, *p, 2); *p += 2; return x; }
+    case EH_PE_SDATA2: { int16_t x;  memcpy(&x, *p, 2); *p += 2; return (uintptr_t)(intptr_t)x; }
+    case EH_PE_UDATA4: { uint32_t x; memcpy(&x, *p, 4); *p += 4; return x; }
+    case EH_PE_SDATA4: { int32_t x;  memcpy(&x, *p, 4); *p += 4; return (uintptr_t)(intptr_t)x; }
+    case EH_PE_UDATA8:
+    case EH_PE_SDATA8:
+    default:           memcpy(&v, *p, 8); *p += 8; return v;
+    }
+}
+
+/*
+ * Kişilik işlevi. dene her istisnayı yakalar (tip ayrımı iniş pistinde
+ * yapılır), bu yüzden eylemi sıfırdan farklı bir çağrı noktası işleyicidir;
+ * eylemsiz pistler temizliktir. Pist rax'ta istisna nesnesini alır.
+ */
+_Unwind_Reason_Code _tr_kisilik(int surum, _Unwind_Action eylemler,
+                                _Unwind_Exception_Class sinif,
+                                struct _Unwind_Exception *nesne,
+                                struct _Unwind_Context *baglam) {
+    if (surum != 1 || sinif != TR_ISTISNA_SINIFI) return _URC_CONTINUE_UNWIND;
+
+    const unsigned char *p = (const unsigned char *)_Unwind_GetLanguageSpecificData(baglam);
+    if (!p) return _URC_CONTINUE_UNWIND;
+
+    uintptr_t islev = _Unwind_GetRegionStart(baglam);
+    int ip_once = 0;
+    uintptr_t ip = _Unwind_GetIPInfo(baglam, &ip_once);
+    if (!ip_once) ip--;   /* dönüş adresi çağrının sonrasını gösterir */
+
+    uintptr_t pist_tabani = islev;
+    unsigned char kodlama = *p++;
+    if (kodlama != EH_PE_OMIT) pist_tabani = lsda_oku(&p, kodlama);
+    kodlama = *p++;
+    if (kodlama != EH_PE_OMIT) lsda_uleb(&p);   /* tip tablosu kullanılmaz */
+    kodlama = *p++;
+    uintptr_t tablo_boyut = lsda_uleb(&p);
+    const unsigned char *tablo_son = p + tablo_boyut;
+
+    while (p < tablo_son) {
+        uintptr_t bas = lsda_oku(&p, kodlama);
+        uintptr_t uzunluk = lsda_oku(&p, kodlama);
+        uintptr_t pist = lsda_oku(&p, kodlama);
+        uintptr_t eylem = lsda_uleb(&p);
+        if (ip < islev + bas) break;   /* tablo sıralı */
+        if (ip >= islev + bas + uzunluk) continue;
+        if (pist == 0) return _URC_CONTINUE_UNWIND;
+
+        if (eylemler & _UA_SEARCH_PHASE)
+            return eylem ? _URC_HANDLER_FOUND : _URC_CONTINUE_UNWIND;
+        if (eylem && !(eylemler & _UA_HANDLER_FRAME)) return _URC_CONTINUE_UNWIND;
+
+        _Unwind_SetGR(baglam, __builtin_eh_return_data_regno(0), (uintptr_t)nesne);
+        _Unwind_SetGR(baglam, __builtin_eh_return_data_regno(1), eylem);
+        _Unwind_SetIP(baglam, pist_tabani + pist);
+        return _URC_INSTALL_CONTEXT;
     }
-    return 0;
+    return _URC_CONTINUE_UNWIND;
 }
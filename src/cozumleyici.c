@@ -1388,10 +1388,45 @@ static Düğüm *esle_cozumle(Cozumleyici *c) {
     return d;
 }
 
-/* her...için döngüsü çözümleme */
-static Düğüm *her_icin_cozumle(Cozumleyici *c) {
+/* paralel her...için: ile topla(t), en_küçük(m), en_büyük(M) */
+static void indirgeme_cozumle(Cozumleyici *c, Düğüm *d) {
+    ilerle(c);  /* ile */
+    do {
+        Sözcük *islem = bekle(c, TOK_TANIMLAYICI);
+        if (!islem) return;
+        char *islem_adi = sozcuk_metni(c, islem);
+        int kod;
+        if (strcmp(islem_adi, "topla") == 0) {
+            kod = İNDİRGEME_TOPLA;
+        } else if (strcmp(islem_adi, "en_küçük") == 0 || strcmp(islem_adi, "en_kucuk") == 0) {
+            kod = İNDİRGEME_EN_KÜÇÜK;
+        } else if (strcmp(islem_adi, "en_büyük") == 0 || strcmp(islem_adi, "en_buyuk") == 0) {
+            kod = İNDİRGEME_EN_BÜYÜK;
+        } else {
+            hata_bildir(HATA_SÖZDİZİMİ, islem->satir, islem->sutun,
+                        "indirgeme 'topla', 'en_küçük' veya 'en_büyük' olmalı");
+            kod = İNDİRGEME_TOPLA;
+        }
+        bekle(c, TOK_PAREN_AC);
+        Sözcük *degisken = bekle(c, TOK_TANIMLAYICI);
+        bekle(c, TOK_PAREN_KAPA);
+        if (!degisken) return;
+        if (d->veri.dongu.indirgeme_sayisi >= 4) {
+            hata_bildir(HATA_SINIR_AŞIMI, islem->satir, islem->sutun,
+                        "paralel döngüde en fazla 4 indirgeme olabilir");
+            continue;
+        }
+        int n = d->veri.dongu.indirgeme_sayisi++;
+        d->veri.dongu.indirgeme_isim[n] = sozcuk_metni(c, degisken);
+        d->veri.dongu.indirgeme_islem[n] = kod;
+    } while (esle_ve_ilerle(c, TOK_VİRGÜL));
+}
+
+/* her...için döngüsü çözümleme; paralel: önünde 'paralel' vardı */
+static Düğüm *her_icin_cozumle(Cozumleyici *c, int paralel) {
     Sözcük *s = ilerle(c);  /* her */
     Düğüm *d = düğüm_oluştur(c->arena, DÜĞÜM_HER_İÇİN, s->satir, s->sutun);
+    d->veri.dongu.paralel = paralel;
 
     /* Döngü değişkeni */
     Sözcük *değişken = bekle(c, TOK_TANIMLAYICI);
@@ -1404,6 +1439,8 @@ static Düğüm *her_icin_cozumle(Cozumleyici *c) {
     Düğüm *dizi = boru_ifade(c);
     düğüm_çocuk_ekle(c->arena, d, dizi);  /* çocuklar[0] = dizi ifadesi */
 
+    if (paralel && kontrol(c, TOK_ILE)) indirgeme_cozumle(c, d);
+
     bekle(c, TOK_İSE);
     yeni_satir_atla(c);
 
@@ -1702,7 +1739,12 @@ static Düğüm *bildirim_cozumle(Cozumleyici *c) {
     if (s->tur == TOK_DÖNGÜ) return dongu_cozumle(c);
     if (s->tur == TOK_İKEN) return iken_cozumle(c);
     if (s->tur == TOK_EŞLE) return esle_cozumle(c);
-    if (s->tur == TOK_HER) return her_icin_cozumle(c);
+    if (s->tur == TOK_HER) return her_icin_cozumle(c, 0);
+    if (s->tur == TOK_TANIMLAYICI && peek(c, 1)->tur == TOK_HER &&
+        s->uzunluk == 7 && strncmp(s->başlangıç, "paralel", 7) == 0) {
+        ilerle(c);  /* paralel */
+        return her_icin_cozumle(c, 1);
+    }
 
     /* Bağlam yöneticisi: ile ifade olarak d ise ... son */
     if (s->tur == TOK_ILE) {
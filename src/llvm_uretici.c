@@ -178,6 +178,7 @@ LLVMÜretici *llvm_üretici_oluştur(
     u->dongu_devam = NULL;
     u->dongu_derinligi = 0;
     memset(u->dongu_yigini, 0, sizeof(u->dongu_yigini));
+    u->dene_pisti = NULL;
 
     /* Etiket sayacı */
     u->etiket_sayaci = 0;
@@ -459,22 +460,19 @@ void llvm_runtime_tanimla(LLVMÜretici *u) {
 
     /* ==== İstisna İşleme runtime fonksiyonları ==== */
 
-    /* _tr_dene_baslat() -> i32 (0=normal, 1=istisna) */
+    /* _tr_kisilik: tablo tabanlı istisnaların kişilik işlevi */
     {
         LLVMTypeRef i32_tip = LLVMInt32TypeInContext(u->baglam);
-        LLVMTypeRef ft = LLVMFunctionType(i32_tip, NULL, 0, 0);
-        LLVMValueRef fn = LLVMAddFunction(u->modul, "_tr_dene_baslat", ft);
-        /* setjmp wrapper: returns_twice attribute gerekli */
-        unsigned kind = LLVMGetEnumAttributeKindForName("returns_twice", 13);
-        LLVMAttributeRef attr = LLVMCreateEnumAttribute(u->baglam, kind, 0);
-        LLVMAddAttributeAtIndex(fn, LLVMAttributeFunctionIndex, attr);
-        llvm_sembol_ekle(u, "_tr_dene_baslat", fn, ft, 0, 1);
+        LLVMTypeRef ft = LLVMFunctionType(i32_tip, NULL, 0, 1);
+        LLVMValueRef fn = LLVMAddFunction(u->modul, "_tr_kisilik", ft);
+        llvm_sembol_ekle(u, "_tr_kisilik", fn, ft, 0, 1);
     }
-    /* _tr_dene_bitir() -> void */
+    /* _tr_istisna_yakala(nesne: i8*) -> i64* [deger, deger_len, tip] */
     {
-        LLVMTypeRef ft = LLVMFunctionType(void_tip, NULL, 0, 0);
-        LLVMValueRef fn = LLVMAddFunction(u->modul, "_tr_dene_bitir", ft);
-        llvm_sembol_ekle(u, "_tr_dene_bitir", fn, ft, 0, 1);
+        LLVMTypeRef pt[] = { LLVMPointerType(LLVMInt8TypeInContext(u->baglam), 0) };
+        LLVMTypeRef ft = LLVMFunctionType(LLVMPointerType(i64, 0), pt, 1, 0);
+        LLVMValueRef fn = LLVMAddFunction(u->modul, "_tr_istisna_yakala", ft);
+        llvm_sembol_ekle(u, "_tr_istisna_yakala", fn, ft, 0, 1);
     }
     /* _tr_firlat_deger(deger: i64) -> void */
     {
@@ -487,12 +485,6 @@ void llvm_runtime_tanimla(LLVMÜretici *u) {
         LLVMAddAttributeAtIndex(fn, LLVMAttributeFunctionIndex, attr);
         llvm_sembol_ekle(u, "_tr_firlat_deger", fn, ft, 0, 1);
     }
-    /* _tr_istisna_deger() -> i64 */
-    {
-        LLVMTypeRef ft = LLVMFunctionType(i64, NULL, 0, 0);
-        LLVMValueRef fn = LLVMAddFunction(u->modul, "_tr_istisna_deger", ft);
-        llvm_sembol_ekle(u, "_tr_istisna_deger", fn, ft, 0, 1);
-    }
     /* _tr_firlat_tipli(deger: i64, deger_len: i64, tip: i64) -> void */
     {
         LLVMTypeRef pt[] = { i64, i64, i64 };
@@ -503,18 +495,6 @@ void llvm_runtime_tanimla(LLVMÜretici *u) {
         LLVMAddAttributeAtIndex(fn, LLVMAttributeFunctionIndex, attr2);
         llvm_sembol_ekle(u, "_tr_firlat_tipli", fn, ft, 0, 1);
     }
-    /* _tr_istisna_tip() -> i64 */
-    {
-        LLVMTypeRef ft = LLVMFunctionType(i64, NULL, 0, 0);
-        LLVMValueRef fn = LLVMAddFunction(u->modul, "_tr_istisna_tip", ft);
-        llvm_sembol_ekle(u, "_tr_istisna_tip", fn, ft, 0, 1);
-    }
-    /* _tr_istisna_deger_len() -> i64 */
-    {
-        LLVMTypeRef ft = LLVMFunctionType(i64, NULL, 0, 0);
-        LLVMValueRef fn = LLVMAddFunction(u->modul, "_tr_istisna_deger_len", ft);
-        llvm_sembol_ekle(u, "_tr_istisna_deger_len", fn, ft, 0, 1);
-    }
 
     /* ==== Sözlük runtime fonksiyonları ==== */
 
@@ -572,13 +552,6 @@ void llvm_runtime_tanimla(LLVMÜretici *u) {
         llvm_sembol_ekle(u, "_tr_dogrula_esit_metin", fn, ft, 0, 1);
     }
 
-    /* ==== Kapanış (closure) global değişkeni ==== */
-    /* _tr_kapanis_ortam: extern i64* (calismazamani.c'de tanımlı) */
-    {
-        LLVMTypeRef i64_ptr = LLVMPointerType(i64, 0);
-        LLVMValueRef ortam_global = LLVMAddGlobal(u->modul, i64_ptr, "_tr_kapanis_ortam");
-        LLVMSetLinkage(ortam_global, LLVMExternalLinkage);
-    }
 }
 
 /*
@@ -841,6 +814,23 @@ LLVMSınıfBilgisi *llvm_sinif_bilgisi_bul(LLVMÜretici *u, const char *isim) {
     return NULL;
 }
 
+/*
+ * llvm_cagri_kur - Çağrı üret; dene gövdesinde invoke olur ve istisna
+ * u->dene_pisti iniş pistine açılır (tablo tabanlı, normal yol ücretsiz)
+ */
+static LLVMValueRef llvm_cagri_kur(LLVMÜretici *u, LLVMTypeRef ft, LLVMValueRef fn,
+                                   LLVMValueRef *args, unsigned n, const char *isim) {
+    if (!u->dene_pisti) {
+        return LLVMBuildCall2(u->olusturucu, ft, fn, args, n, isim);
+    }
+    LLVMBasicBlockRef devam = LLVMAppendBasicBlockInContext(
+        u->baglam, u->mevcut_islev, "cagri_devam");
+    LLVMValueRef v = LLVMBuildInvoke2(u->olusturucu, ft, fn, args, n,
+        devam, u->dene_pisti, isim);
+    LLVMPositionBuilderAtEnd(u->olusturucu, devam);
+    return v;
+}
+
 /* ═══════════════════════════════════════════════════════════════════════════
  *  BÖLÜM 4: İŞLEV ÜRETİMİ
  * ═══════════════════════════════════════════════════════════════════════════ */
@@ -855,7 +845,7 @@ void llvm_işlev_üret(LLVMÜretici *u, Düğüm *dugum) {
     if (!dugum || dugum->tur != DÜĞÜM_İŞLEV) return;
 
     char *isim = dugum->veri.islev.isim;
-    char *dekorator = dugum->veri.islev.dekorator;
+    char *dekorator = satirici_ipucu(dugum->veri.islev.dekorator) ? NULL : dugum->veri.islev.dekorator;
     char *donus_tipi_adi = dugum->veri.islev.dönüş_tipi;
 
     /* Dekoratör: orijinal fonksiyonu __dekoratsiz_<isim> olarak üret */
@@ -963,6 +953,8 @@ void llvm_işlev_üret(LLVMÜretici *u, Düğüm *dugum) {
 
     /* Mevcut işlevi kaydet */
     u->mevcut_islev = islev;
+    LLVMBasicBlockRef onceki_pist = u->dene_pisti;
+    u->dene_pisti = NULL;
 
     /* Yeni kapsam */
     llvm_kapsam_gir(u);
@@ -1044,14 +1036,14 @@ void llvm_işlev_üret(LLVMÜretici *u, Düğüm *dugum) {
                 w_args[a] = LLVMGetParam(wrapper, a);
             }
         }
-        LLVMValueRef ic_sonuc = LLVMBuildCall2(u->olusturucu, islev_tipi,
+        LLVMValueRef ic_sonuc = llvm_cagri_kur(u, islev_tipi,
             islev, w_args, arg_sayisi, "ic_sonuc");
 
         /* Sonucu dekoratör fonksiyonuna geçir */
         LLVMSembolGirişi *deko_fn = llvm_sembol_bul(u, dekorator);
         if (deko_fn) {
             LLVMValueRef deko_args[] = { ic_sonuc };
-            LLVMValueRef deko_sonuc = LLVMBuildCall2(u->olusturucu, deko_fn->tip,
+            LLVMValueRef deko_sonuc = llvm_cagri_kur(u, deko_fn->tip,
                 deko_fn->deger, deko_args, 1, "deko_sonuc");
             LLVMBuildRet(u->olusturucu, deko_sonuc);
         } else {
@@ -1064,6 +1056,7 @@ void llvm_işlev_üret(LLVMÜretici *u, Düğüm *dugum) {
     }
 
     u->mevcut_islev = NULL;
+    u->dene_pisti = onceki_pist;
 }
 
 /* ---- Varsayılan parametre AST bilgisi (işlev adı → parametreler) ---- */
@@ -1143,6 +1136,69 @@ static void llvm_kapanis_yakala_topla(Düğüm *d, char **param_isimleri, int pa
     }
 }
 
+/*
+ * llvm_statik_kapanis - Adlı işlev ya da yakalamasız lambda için sabit
+ * [kod, 0] kapanışı; işlev değerleri kapanış işaretçisi (i64) olarak taşınır.
+ */
+static LLVMValueRef llvm_statik_kapanis(LLVMÜretici *u, LLVMValueRef fn) {
+    LLVMTypeRef i64 = LLVMInt64TypeInContext(u->baglam);
+    char isim[256];
+    snprintf(isim, sizeof(isim), "_tr_kp_%s", LLVMGetValueName(fn));
+    LLVMValueRef g = LLVMGetNamedGlobal(u->modul, isim);
+    if (!g) {
+        LLVMTypeRef dizi_t = LLVMArrayType(i64, 2);
+        LLVMValueRef alanlar[] = { LLVMConstPtrToInt(fn, i64), LLVMConstInt(i64, 0, 0) };
+        g = LLVMAddGlobal(u->modul, dizi_t, isim);
+        LLVMSetInitializer(g, LLVMConstArray(i64, alanlar, 2));
+        LLVMSetGlobalConstant(g, 1);
+        LLVMSetLinkage(g, LLVMPrivateLinkage);
+        LLVMSetAlignment(g, 8);
+    }
+    return LLVMConstPtrToInt(g, i64);
+}
+
+/*
+ * llvm_kapanis_cagir - Kapanış üzerinden çağrı: kod kapanışın ilk
+ * kelimesindedir, kapanış son argüman (ortam) olarak geçer.
+ */
+static LLVMValueRef llvm_kapanis_cagir(LLVMÜretici *u, LLVMValueRef kapanis,
+                                       LLVMValueRef *args, int arg_say) {
+    LLVMTypeRef i64 = LLVMInt64TypeInContext(u->baglam);
+    LLVMTypeRef param_t[33];
+    LLVMValueRef tum_args[33];
+    for (int i = 0; i < arg_say; i++) {
+        param_t[i] = i64;
+        tum_args[i] = args[i];
+    }
+    param_t[arg_say] = i64;
+    tum_args[arg_say] = kapanis;
+    LLVMTypeRef fn_tip = LLVMFunctionType(i64, param_t, arg_say + 1, 0);
+
+    LLVMValueRef k_ptr = LLVMBuildIntToPtr(u->olusturucu, kapanis,
+        LLVMPointerType(i64, 0), "kapanis");
+    LLVMValueRef kod = LLVMBuildLoad2(u->olusturucu, i64, k_ptr, "kapanis_kod");
+    LLVMValueRef fn_ptr = LLVMBuildIntToPtr(u->olusturucu, kod,
+        LLVMPointerType(fn_tip, 0), "fn_ptr");
+    return llvm_cagri_kur(u, fn_tip, fn_ptr,
+        tum_args, arg_say + 1, "dolayli_cagri");
+}
+
+/*
+ * llvm_kapanis_deger - İşlev argümanını (eşlem, iş_oluştur...) kapanış
+ * işaretçisi olarak üret
+ */
+static LLVMValueRef llvm_kapanis_deger(LLVMÜretici *u, Düğüm *d) {
+    if (d->tur == DÜĞÜM_TANIMLAYICI && !llvm_sembol_bul(u, d->veri.tanimlayici.isim)) {
+        LLVMValueRef fn = LLVMGetNamedFunction(u->modul, d->veri.tanimlayici.isim);
+        if (fn) return llvm_statik_kapanis(u, fn);
+    }
+    LLVMValueRef v = llvm_ifade_uret(u, d);
+    if (!v) return NULL;
+    if (LLVMGetTypeKind(LLVMTypeOf(v)) == LLVMPointerTypeKind)
+        v = LLVMBuildPtrToInt(u->olusturucu, v, LLVMInt64TypeInContext(u->baglam), "kapanis");
+    return v;
+}
+
 /* ═══════════════════════════════════════════════════════════════════════════
  *  BÖLÜM 5: İFADE ÜRETİMİ
  * ═══════════════════════════════════════════════════════════════════════════ */
@@ -1196,9 +1252,9 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
             }
 
             if (sembol->global_mi) {
-                /* Fonksiyon ise direkt döndür, global değişken ise load */
+                /* İşlev ise statik kapanışı, global değişken ise değeri */
                 if (LLVMIsAFunction(sembol->deger)) {
-                    return sembol->deger;
+                    return llvm_statik_kapanis(u, sembol->deger);
                 } else {
                     return LLVMBuildLoad2(u->olusturucu, sembol->tip,
                                           sembol->deger, isim);
@@ -1318,7 +1374,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                         LLVMValueRef args[] = { sol, sag };
                         LLVMTypeRef donus_tip = LLVMGetReturnType(metot_fn->tip);
                         const char *cagri_adi = (LLVMGetTypeKind(donus_tip) == LLVMVoidTypeKind) ? "" : "op_sonuc";
-                        return LLVMBuildCall2(u->olusturucu, metot_fn->tip,
+                        return llvm_cagri_kur(u, metot_fn->tip,
                                              metot_fn->deger, args, 2, cagri_adi);
                     }
                 }
@@ -1335,7 +1391,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                             LLVMValueRef ptr2 = LLVMBuildExtractValue(u->olusturucu, sag, 0, "sag_ptr");
                             LLVMValueRef len2 = LLVMBuildExtractValue(u->olusturucu, sag, 1, "sag_len");
                             LLVMValueRef args[] = { ptr1, len1, ptr2, len2 };
-                            return LLVMBuildCall2(u->olusturucu, fn->tip,
+                            return llvm_cagri_kur(u, fn->tip,
                                                  fn->deger, args, 4, "birlestir");
                         }
                     }
@@ -1381,7 +1437,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                             LLVMValueRef hata_uzunluk = LLVMConstInt(i64_t, hata_len, 0);
                             LLVMValueRef tip_kodu = LLVMConstInt(i64_t, 5, 0); /* BolmeHatasi=5 */
                             LLVMValueRef firlat_args[] = { hata_ptr, hata_uzunluk, tip_kodu };
-                            LLVMBuildCall2(u->olusturucu, firlat_tipli->tip,
+                            llvm_cagri_kur(u, firlat_tipli->tip,
                                 firlat_tipli->deger, firlat_args, 3, "");
                         }
                         LLVMBuildUnreachable(u->olusturucu);
@@ -1411,7 +1467,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                         LLVMValueRef hata_uzunluk = LLVMConstInt(i64_t, hata_len, 0);
                         LLVMValueRef tip_kodu = LLVMConstInt(i64_t, 5, 0);
                         LLVMValueRef firlat_args[] = { hata_ptr, hata_uzunluk, tip_kodu };
-                        LLVMBuildCall2(u->olusturucu, firlat_tipli->tip,
+                        llvm_cagri_kur(u, firlat_tipli->tip,
                             firlat_tipli->deger, firlat_args, 3, "");
                     }
                     LLVMBuildUnreachable(u->olusturucu);
@@ -1460,7 +1516,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                             LLVMValueRef ptr1 = LLVMBuildExtractValue(u->olusturucu, sol, 0, "cmp_ptr1");
                             LLVMValueRef ptr2 = LLVMBuildExtractValue(u->olusturucu, sag, 0, "cmp_ptr2");
                             LLVMValueRef args[] = { ptr1, ptr2 };
-                            LLVMValueRef cmp = LLVMBuildCall2(u->olusturucu, fn->tip,
+                            LLVMValueRef cmp = llvm_cagri_kur(u, fn->tip,
                                                               fn->deger, args, 2, "strcmp_sonuc");
                             return LLVMBuildICmp(u->olusturucu, LLVMIntEQ, cmp,
                                 LLVMConstInt(LLVMInt32TypeInContext(u->baglam), 0, 0), "esit");
@@ -1481,7 +1537,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                             LLVMValueRef ptr1 = LLVMBuildExtractValue(u->olusturucu, sol, 0, "cmp_ptr1");
                             LLVMValueRef ptr2 = LLVMBuildExtractValue(u->olusturucu, sag, 0, "cmp_ptr2");
                             LLVMValueRef args[] = { ptr1, ptr2 };
-                            LLVMValueRef cmp = LLVMBuildCall2(u->olusturucu, fn->tip,
+                            LLVMValueRef cmp = llvm_cagri_kur(u, fn->tip,
                                                               fn->deger, args, 2, "strcmp_sonuc");
                             return LLVMBuildICmp(u->olusturucu, LLVMIntNE, cmp,
                                 LLVMConstInt(LLVMInt32TypeInContext(u->baglam), 0, 0), "esit_degil");
@@ -1533,6 +1589,11 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                     return LLVMBuildNeg(u->olusturucu, operand, "negatif");
 
                 case TOK_DEĞİL:
+                    /* Modül işlevlerinin mantık sonucu i64 gelir: 0/1 */
+                    if (LLVMGetTypeKind(LLVMTypeOf(operand)) == LLVMIntegerTypeKind &&
+                        LLVMGetIntTypeWidth(LLVMTypeOf(operand)) > 1)
+                        return LLVMBuildICmp(u->olusturucu, LLVMIntEQ, operand,
+                                             LLVMConstInt(LLVMTypeOf(operand), 0, 0), "degil");
                     return LLVMBuildNot(u->olusturucu, operand, "degil");
 
                 case TOK_BİT_DEĞİL:
@@ -1565,7 +1626,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                                     LLVMValueRef ext = LLVMBuildZExt(u->olusturucu, arg,
                                         LLVMInt64TypeInContext(u->baglam), "mantik_ext");
                                     LLVMValueRef args[] = { ext };
-                                    return LLVMBuildCall2(u->olusturucu, fn->tip,
+                                    return llvm_cagri_kur(u, fn->tip,
                                                          fn->deger, args, 1, "");
                                 }
                             } else {
@@ -1578,7 +1639,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                                             LLVMInt64TypeInContext(u->baglam), "tam_ext");
                                     }
                                     LLVMValueRef args[] = { tam_arg };
-                                    return LLVMBuildCall2(u->olusturucu, fn->tip,
+                                    return llvm_cagri_kur(u, fn->tip,
                                                          fn->deger, args, 1, "");
                                 }
                             }
@@ -1587,7 +1648,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                             LLVMSembolGirişi *fn = llvm_sembol_bul(u, "_yazdir_ondalik");
                             if (fn) {
                                 LLVMValueRef args[] = { arg };
-                                return LLVMBuildCall2(u->olusturucu, fn->tip,
+                                return llvm_cagri_kur(u, fn->tip,
                                                      fn->deger, args, 1, "");
                             }
                         } else if (tip_turu == LLVMStructTypeKind) {
@@ -1599,7 +1660,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                                 LLVMValueRef len = LLVMBuildExtractValue(
                                     u->olusturucu, arg, 1, "metin_len");
                                 LLVMValueRef args[] = { ptr, len };
-                                return LLVMBuildCall2(u->olusturucu, fn->tip,
+                                return llvm_cagri_kur(u, fn->tip,
                                                      fn->deger, args, 2, "");
                             }
                         } else if (tip_turu == LLVMPointerTypeKind) {
@@ -1607,7 +1668,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                             LLVMSembolGirişi *fn = llvm_sembol_bul(u, "puts");
                             if (fn) {
                                 LLVMValueRef args[] = { arg };
-                                return LLVMBuildCall2(u->olusturucu, fn->tip,
+                                return llvm_cagri_kur(u, fn->tip,
                                                      fn->deger, args, 1, "");
                             }
                         }
@@ -1647,7 +1708,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
 
                             LLVMValueRef satir_val = LLVMConstInt(i64_tip, (unsigned long long)dugum->satir, 0);
                             LLVMValueRef args[] = { kosul64, isim_ptr_val, isim_len_val, satir_val };
-                            LLVMBuildCall2(u->olusturucu, fn->tip, fn->deger, args, 4, "");
+                            llvm_cagri_kur(u, fn->tip, fn->deger, args, 4, "");
                         }
                     }
                 }
@@ -1686,7 +1747,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
 
                             LLVMValueRef satir_val = LLVMConstInt(i64_tip, (unsigned long long)dugum->satir, 0);
                             LLVMValueRef args[] = { beklenen, gercek, isim_ptr_val, isim_len_val, satir_val };
-                            LLVMBuildCall2(u->olusturucu, fn->tip, fn->deger, args, 5, "");
+                            llvm_cagri_kur(u, fn->tip, fn->deger, args, 5, "");
                         }
                     }
                 }
@@ -1721,7 +1782,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
 
                             LLVMValueRef satir_val = LLVMConstInt(i64_tip, (unsigned long long)dugum->satir, 0);
                             LLVMValueRef args[] = { kosul64, isim_ptr_val, isim_len_val, satir_val };
-                            LLVMBuildCall2(u->olusturucu, fn->tip, fn->deger, args, 4, "");
+                            llvm_cagri_kur(u, fn->tip, fn->deger, args, 4, "");
                         }
                     }
                 }
@@ -1739,7 +1800,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                         LLVMValueRef ptr = LLVMBuildExtractValue(u->olusturucu, arg, 0, "m_ptr");
                         LLVMValueRef len = LLVMBuildExtractValue(u->olusturucu, arg, 1, "m_len");
                         LLVMValueRef args[] = { ptr, len };
-                        return LLVMBuildCall2(u->olusturucu, fn->tip, fn->deger, args, 2, "karakter_say");
+                        return llvm_cagri_kur(u, fn->tip, fn->deger, args, 2, "karakter_say");
                     }
                 }
                 /* Dizi uzunluk: struct ikinci alanı */
@@ -1770,7 +1831,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                         LLVMValueRef n_ptr = LLVMBuildExtractValue(u->olusturucu, needle, 0, "n_ptr");
                         LLVMValueRef n_len = LLVMBuildExtractValue(u->olusturucu, needle, 1, "n_len");
                         LLVMValueRef args[] = { h_ptr, h_len, n_ptr, n_len };
-                        return LLVMBuildCall2(u->olusturucu, fn->tip, fn->deger, args, 4, "bul_sonuc");
+                        return llvm_cagri_kur(u, fn->tip, fn->deger, args, 4, "bul_sonuc");
                     }
                 }
             }
@@ -1787,7 +1848,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                         LLVMValueRef ptr = LLVMBuildExtractValue(u->olusturucu, metin_val, 0, "k_ptr");
                         LLVMValueRef len = LLVMBuildExtractValue(u->olusturucu, metin_val, 1, "k_len");
                         LLVMValueRef args[] = { ptr, len, bas, uzn };
-                        return LLVMBuildCall2(u->olusturucu, fn->tip, fn->deger, args, 4, "kes_sonuc");
+                        return llvm_cagri_kur(u, fn->tip, fn->deger, args, 4, "kes_sonuc");
                     }
                 }
             }
@@ -1801,31 +1862,19 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                 if (dizi_val && LLVMGetTypeKind(LLVMTypeOf(dizi_val)) == LLVMStructTypeKind) {
                     LLVMValueRef dizi_ptr = LLVMBuildExtractValue(u->olusturucu, dizi_val, 0, "d_ptr");
                     LLVMValueRef dizi_cnt = LLVMBuildExtractValue(u->olusturucu, dizi_val, 1, "d_cnt");
-                    /* Fonksiyon pointer: isim ise leaq, değilse ifade üret */
-                    LLVMValueRef fn_ptr = NULL;
-                    if (dugum->çocuklar[1]->tur == DÜĞÜM_TANIMLAYICI) {
-                        char *fn_isim = dugum->çocuklar[1]->veri.tanimlayici.isim;
-                        LLVMValueRef fn_val = LLVMGetNamedFunction(u->modul, fn_isim);
-                        if (fn_val) fn_ptr = fn_val;
-                    }
-                    if (!fn_ptr) fn_ptr = llvm_ifade_uret(u, dugum->çocuklar[1]);
-                    if (fn_ptr) {
-                        /* _tr_esle(ptr, count, fn_ptr) -> {i64*, i64} */
+                    LLVMValueRef kapanis = llvm_kapanis_deger(u, dugum->çocuklar[1]);
+                    if (kapanis) {
+                        /* _tr_esle(ptr, count, kapanış) -> {i64*, i64} */
                         LLVMTypeRef i64_t = LLVMInt64TypeInContext(u->baglam);
                         LLVMTypeRef i64p_t = LLVMPointerType(i64_t, 0);
-                        LLVMTypeRef fn_cb_t = LLVMPointerType(LLVMFunctionType(i64_t, &i64_t, 1, 0), 0);
                         LLVMTypeRef diz_t = llvm_dizi_tipi_al(u);
-                        LLVMTypeRef p_tipleri[] = { i64p_t, i64_t, fn_cb_t };
+                        LLVMTypeRef p_tipleri[] = { i64p_t, i64_t, i64p_t };
                         LLVMTypeRef esle_fn_tip = LLVMFunctionType(diz_t, p_tipleri, 3, 0);
                         LLVMValueRef esle_fn = LLVMGetNamedFunction(u->modul, "_tr_esle");
                         if (!esle_fn) esle_fn = LLVMAddFunction(u->modul, "_tr_esle", esle_fn_tip);
-                        LLVMValueRef fn_cast;
-                        if (LLVMGetTypeKind(LLVMTypeOf(fn_ptr)) == LLVMIntegerTypeKind)
-                            fn_cast = LLVMBuildIntToPtr(u->olusturucu, fn_ptr, fn_cb_t, "fn_cast");
-                        else
-                            fn_cast = LLVMBuildBitCast(u->olusturucu, fn_ptr, fn_cb_t, "fn_cast");
-                        LLVMValueRef args[] = { dizi_ptr, dizi_cnt, fn_cast };
-                        return LLVMBuildCall2(u->olusturucu, esle_fn_tip, esle_fn, args, 3, "esle_sonuc");
+                        LLVMValueRef k_ptr = LLVMBuildIntToPtr(u->olusturucu, kapanis, i64p_t, "kapanis");
+                        LLVMValueRef args[] = { dizi_ptr, dizi_cnt, k_ptr };
+                        return llvm_cagri_kur(u, esle_fn_tip, esle_fn, args, 3, "esle_sonuc");
                     }
                 }
             }
@@ -1837,29 +1886,18 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                 if (dizi_val && LLVMGetTypeKind(LLVMTypeOf(dizi_val)) == LLVMStructTypeKind) {
                     LLVMValueRef dizi_ptr = LLVMBuildExtractValue(u->olusturucu, dizi_val, 0, "d_ptr");
                     LLVMValueRef dizi_cnt = LLVMBuildExtractValue(u->olusturucu, dizi_val, 1, "d_cnt");
-                    LLVMValueRef fn_ptr = NULL;
-                    if (dugum->çocuklar[1]->tur == DÜĞÜM_TANIMLAYICI) {
-                        char *fn_isim = dugum->çocuklar[1]->veri.tanimlayici.isim;
-                        LLVMValueRef fn_val = LLVMGetNamedFunction(u->modul, fn_isim);
-                        if (fn_val) fn_ptr = fn_val;
-                    }
-                    if (!fn_ptr) fn_ptr = llvm_ifade_uret(u, dugum->çocuklar[1]);
-                    if (fn_ptr) {
+                    LLVMValueRef kapanis = llvm_kapanis_deger(u, dugum->çocuklar[1]);
+                    if (kapanis) {
                         LLVMTypeRef i64_t = LLVMInt64TypeInContext(u->baglam);
                         LLVMTypeRef i64p_t = LLVMPointerType(i64_t, 0);
-                        LLVMTypeRef fn_cb_t = LLVMPointerType(LLVMFunctionType(i64_t, &i64_t, 1, 0), 0);
                         LLVMTypeRef diz_t = llvm_dizi_tipi_al(u);
-                        LLVMTypeRef p_tipleri[] = { i64p_t, i64_t, fn_cb_t };
+                        LLVMTypeRef p_tipleri[] = { i64p_t, i64_t, i64p_t };
                         LLVMTypeRef filtre_fn_tip = LLVMFunctionType(diz_t, p_tipleri, 3, 0);
                         LLVMValueRef filtre_fn = LLVMGetNamedFunction(u->modul, "_tr_filtre");
                         if (!filtre_fn) filtre_fn = LLVMAddFunction(u->modul, "_tr_filtre", filtre_fn_tip);
-                        LLVMValueRef fn_cast;
-                        if (LLVMGetTypeKind(LLVMTypeOf(fn_ptr)) == LLVMIntegerTypeKind)
-                            fn_cast = LLVMBuildIntToPtr(u->olusturucu, fn_ptr, fn_cb_t, "fn_cast");
-                        else
-                            fn_cast = LLVMBuildBitCast(u->olusturucu, fn_ptr, fn_cb_t, "fn_cast");
-                        LLVMValueRef args[] = { dizi_ptr, dizi_cnt, fn_cast };
-                        return LLVMBuildCall2(u->olusturucu, filtre_fn_tip, filtre_fn, args, 3, "filtre_sonuc");
+                        LLVMValueRef k_ptr = LLVMBuildIntToPtr(u->olusturucu, kapanis, i64p_t, "kapanis");
+                        LLVMValueRef args[] = { dizi_ptr, dizi_cnt, k_ptr };
+                        return llvm_cagri_kur(u, filtre_fn_tip, filtre_fn, args, 3, "filtre_sonuc");
                     }
                 }
             }
@@ -1872,29 +1910,17 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                 if (dizi_val && baslangic && LLVMGetTypeKind(LLVMTypeOf(dizi_val)) == LLVMStructTypeKind) {
                     LLVMValueRef dizi_ptr = LLVMBuildExtractValue(u->olusturucu, dizi_val, 0, "d_ptr");
                     LLVMValueRef dizi_cnt = LLVMBuildExtractValue(u->olusturucu, dizi_val, 1, "d_cnt");
-                    LLVMValueRef fn_ptr = NULL;
-                    if (dugum->çocuklar[2]->tur == DÜĞÜM_TANIMLAYICI) {
-                        char *fn_isim = dugum->çocuklar[2]->veri.tanimlayici.isim;
-                        LLVMValueRef fn_val = LLVMGetNamedFunction(u->modul, fn_isim);
-                        if (fn_val) fn_ptr = fn_val;
-                    }
-                    if (!fn_ptr) fn_ptr = llvm_ifade_uret(u, dugum->çocuklar[2]);
-                    if (fn_ptr) {
+                    LLVMValueRef kapanis = llvm_kapanis_deger(u, dugum->çocuklar[2]);
+                    if (kapanis) {
                         LLVMTypeRef i64_t = LLVMInt64TypeInContext(u->baglam);
                         LLVMTypeRef i64p_t = LLVMPointerType(i64_t, 0);
-                        LLVMTypeRef i64_pair[] = { i64_t, i64_t };
-                        LLVMTypeRef fn_cb_t = LLVMPointerType(LLVMFunctionType(i64_t, i64_pair, 2, 0), 0);
-                        LLVMTypeRef p_tipleri[] = { i64p_t, i64_t, i64_t, fn_cb_t };
+                        LLVMTypeRef p_tipleri[] = { i64p_t, i64_t, i64_t, i64p_t };
                         LLVMTypeRef indirge_fn_tip = LLVMFunctionType(i64_t, p_tipleri, 4, 0);
                         LLVMValueRef indirge_fn = LLVMGetNamedFunction(u->modul, "_tr_indirge");
                         if (!indirge_fn) indirge_fn = LLVMAddFunction(u->modul, "_tr_indirge", indirge_fn_tip);
-                        LLVMValueRef fn_cast;
-                        if (LLVMGetTypeKind(LLVMTypeOf(fn_ptr)) == LLVMIntegerTypeKind)
-                            fn_cast = LLVMBuildIntToPtr(u->olusturucu, fn_ptr, fn_cb_t, "fn_cast");
-                        else
-                            fn_cast = LLVMBuildBitCast(u->olusturucu, fn_ptr, fn_cb_t, "fn_cast");
-                        LLVMValueRef args[] = { dizi_ptr, dizi_cnt, baslangic, fn_cast };
-                        return LLVMBuildCall2(u->olusturucu, indirge_fn_tip, indirge_fn, args, 4, "indirge_sonuc");
+                        LLVMValueRef k_ptr = LLVMBuildIntToPtr(u->olusturucu, kapanis, i64p_t, "kapanis");
+                        LLVMValueRef args[] = { dizi_ptr, dizi_cnt, baslangic, k_ptr };
+                        return llvm_cagri_kur(u, indirge_fn_tip, indirge_fn, args, 4, "indirge_sonuc");
                     }
                 }
             }
@@ -1905,29 +1931,17 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                 if (dizi_val && LLVMGetTypeKind(LLVMTypeOf(dizi_val)) == LLVMStructTypeKind) {
                     LLVMValueRef dizi_ptr = LLVMBuildExtractValue(u->olusturucu, dizi_val, 0, "d_ptr");
                     LLVMValueRef dizi_cnt = LLVMBuildExtractValue(u->olusturucu, dizi_val, 1, "d_cnt");
-                    LLVMValueRef fn_ptr = NULL;
-                    if (dugum->çocuklar[1]->tur == DÜĞÜM_TANIMLAYICI) {
-                        char *fn_isim = dugum->çocuklar[1]->veri.tanimlayici.isim;
-                        LLVMValueRef fn_val = LLVMGetNamedFunction(u->modul, fn_isim);
-                        if (fn_val) fn_ptr = fn_val;
-                    }
-                    if (!fn_ptr) fn_ptr = llvm_ifade_uret(u, dugum->çocuklar[1]);
-                    if (fn_ptr) {
+                    LLVMValueRef kapanis = llvm_kapanis_deger(u, dugum->çocuklar[1]);
+                    if (kapanis) {
                         LLVMTypeRef i64_t = LLVMInt64TypeInContext(u->baglam);
                         LLVMTypeRef i64p_t = LLVMPointerType(i64_t, 0);
-                        LLVMTypeRef fn_cb_t = LLVMPointerType(LLVMFunctionType(i64_t, &i64_t, 1, 0), 0);
-                        LLVMTypeRef p_tipleri[] = { i64p_t, i64_t, fn_cb_t };
+                        LLVMTypeRef p_tipleri[] = { i64p_t, i64_t, i64p_t };
                         LLVMTypeRef hb_fn_tip = LLVMFunctionType(i64_t, p_tipleri, 3, 0);
                         LLVMValueRef hb_fn = LLVMGetNamedFunction(u->modul, "_tr_her_biri");
                         if (!hb_fn) hb_fn = LLVMAddFunction(u->modul, "_tr_her_biri", hb_fn_tip);
-                        /* fn_ptr i64 ise IntToPtr, pointer ise BitCast */
-                        LLVMValueRef fn_cast;
-                        if (LLVMGetTypeKind(LLVMTypeOf(fn_ptr)) == LLVMIntegerTypeKind)
-                            fn_cast = LLVMBuildIntToPtr(u->olusturucu, fn_ptr, fn_cb_t, "fn_cast");
-                        else
-                            fn_cast = LLVMBuildBitCast(u->olusturucu, fn_ptr, fn_cb_t, "fn_cast");
-                        LLVMValueRef args[] = { dizi_ptr, dizi_cnt, fn_cast };
-                        return LLVMBuildCall2(u->olusturucu, hb_fn_tip, hb_fn, args, 3, "hb_sonuc");
+                        LLVMValueRef k_ptr = LLVMBuildIntToPtr(u->olusturucu, kapanis, i64p_t, "kapanis");
+                        LLVMValueRef args[] = { dizi_ptr, dizi_cnt, k_ptr };
+                        return llvm_cagri_kur(u, hb_fn_tip, hb_fn, args, 3, "hb_sonuc");
                     }
                 }
             }
@@ -1948,7 +1962,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                             LLVMSembolGirişi *fn = llvm_sembol_bul(u, "_tr_utf8_karakter_say");
                             if (fn) {
                                 LLVMValueRef args[] = { ptr, len };
-                                return LLVMBuildCall2(u->olusturucu, fn->tip, fn->deger, args, 2, "karakter_say");
+                                return llvm_cagri_kur(u, fn->tip, fn->deger, args, 2, "karakter_say");
                             }
                         }
                         /* m.byte_uzunluk() */
@@ -1960,7 +1974,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                             LLVMSembolGirişi *fn = llvm_sembol_bul(u, "_tr_utf8_tersle");
                             if (fn) {
                                 LLVMValueRef args[] = { ptr, len };
-                                return LLVMBuildCall2(u->olusturucu, fn->tip, fn->deger, args, 2, "tersle_sonuc");
+                                return llvm_cagri_kur(u, fn->tip, fn->deger, args, 2, "tersle_sonuc");
                             }
                         }
                     }
@@ -1992,7 +2006,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
 
                     LLVMTypeRef donus_tip = LLVMGetReturnType(metot_fn->tip);
                     const char *cagri_adi = (LLVMGetTypeKind(donus_tip) == LLVMVoidTypeKind) ? "" : "metot_sonuc";
-                    return LLVMBuildCall2(u->olusturucu, metot_fn->tip, metot_fn->deger,
+                    return llvm_cagri_kur(u, metot_fn->tip, metot_fn->deger,
                                          args, dugum->çocuk_sayısı, cagri_adi);
                 } else {
                     fprintf(stderr, "Hata: Tanımsız metot: %s\n", isim);
@@ -2053,32 +2067,19 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                 }
             }
 
-            /* Dolaylı çağrı kontrolü: fn->deger fonksiyon değilse pointer'dan çağır */
+            /* Dolaylı çağrı: fn->deger işlev değilse kapanış tutan değişkendir */
             if (!LLVMIsAFunction(fn->deger)) {
                 LLVMTypeRef i64 = LLVMInt64TypeInContext(u->baglam);
-                LLVMValueRef fn_ptr_val = LLVMBuildLoad2(u->olusturucu, i64,
-                    fn->deger, "fn_ptr_yukle");
+                LLVMValueRef kapanis = LLVMBuildLoad2(u->olusturucu, i64,
+                    fn->deger, "kapanis_yukle");
 
-                /* Fonksiyon tipini argümanlardan oluştur */
                 int arg_say = dugum->çocuk_sayısı < 32 ? dugum->çocuk_sayısı : 32;
-                LLVMTypeRef param_t[32];
-                for (int i = 0; i < arg_say; i++) param_t[i] = i64;
-                LLVMTypeRef fn_tip = LLVMFunctionType(i64, param_t, arg_say, 0);
-                LLVMTypeRef fn_ptr_tip = LLVMPointerType(fn_tip, 0);
-
-                /* i64 → fonksiyon pointer'ına dönüştür */
-                LLVMValueRef fn_ptr = LLVMBuildIntToPtr(u->olusturucu,
-                    fn_ptr_val, fn_ptr_tip, "fn_ptr");
-
-                /* Argümanları üret */
                 LLVMValueRef args[32];
                 for (int i = 0; i < arg_say; i++) {
                     args[i] = llvm_ifade_uret(u, dugum->çocuklar[i]);
                     if (!args[i]) args[i] = LLVMConstInt(i64, 0, 0);
                 }
-
-                return LLVMBuildCall2(u->olusturucu, fn_tip, fn_ptr,
-                    args, arg_say, "dolayli_cagri");
+                return llvm_kapanis_cagir(u, kapanis, args, arg_say);
             }
 
             /* Fonksiyonun parametre tiplerini al */
@@ -2171,7 +2172,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
             /* Void fonksiyonlar için isim boş olmalı */
             LLVMTypeRef donus_tip = LLVMGetReturnType(fn->tip);
             const char *cagri_adi = (LLVMGetTypeKind(donus_tip) == LLVMVoidTypeKind) ? "" : "cagri_sonuc";
-            return LLVMBuildCall2(u->olusturucu, fn->tip, fn->deger,
+            return llvm_cagri_kur(u, fn->tip, fn->deger,
                                  genisletilmis_args, gen_idx, cagri_adi);
         }
 
@@ -2196,7 +2197,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                         indeks = LLVMBuildSExt(u->olusturucu, indeks, i64_tip, "idx_ext");
                     }
                     LLVMValueRef args[] = { ptr, len, indeks };
-                    return LLVMBuildCall2(u->olusturucu, fn->tip, fn->deger, args, 3, "karakter");
+                    return llvm_cagri_kur(u, fn->tip, fn->deger, args, 3, "karakter");
                 }
             }
 
@@ -2238,7 +2239,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                 }
                 LLVMTypeRef void_t2 = LLVMVoidTypeInContext(u->baglam);
                 LLVMTypeRef sinir_ft = LLVMFunctionType(void_t2, NULL, 0, 0);
-                LLVMBuildCall2(u->olusturucu, sinir_ft, sinir_fn, NULL, 0, "");
+                llvm_cagri_kur(u, sinir_ft, sinir_fn, NULL, 0, "");
                 LLVMBuildUnreachable(u->olusturucu);
 
                 LLVMPositionBuilderAtEnd(u->olusturucu, devam_bb);
@@ -2279,7 +2280,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                             LLVMValueRef ptr = LLVMBuildExtractValue(u->olusturucu, kaynak, 0, "d_ptr");
                             LLVMValueRef len = LLVMBuildExtractValue(u->olusturucu, kaynak, 1, "d_len");
                             LLVMValueRef args[] = { ptr, len, bas, son };
-                            return LLVMBuildCall2(u->olusturucu, fn->tip, fn->deger, args, 4, "dilim");
+                            return llvm_cagri_kur(u, fn->tip, fn->deger, args, 4, "dilim");
                         }
                     } else {
                         /* Dizi dilimi */
@@ -2299,7 +2300,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                             LLVMValueRef ptr = LLVMBuildExtractValue(u->olusturucu, kaynak, 0, "d_ptr");
                             LLVMValueRef len = LLVMBuildExtractValue(u->olusturucu, kaynak, 1, "d_len");
                             LLVMValueRef args[] = { ptr, len, bas, son };
-                            return LLVMBuildCall2(u->olusturucu, fn->tip, fn->deger, args, 4, "dizi_dilim");
+                            return llvm_cagri_kur(u, fn->tip, fn->deger, args, 4, "dizi_dilim");
                         }
                     }
                 }
@@ -2349,7 +2350,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                         LLVMValueRef args[] = { nesne };
                         LLVMTypeRef donus_tip = LLVMGetReturnType(getter_fn->tip);
                         const char *cagri_adi = (LLVMGetTypeKind(donus_tip) == LLVMVoidTypeKind) ? "" : "getter_sonuc";
-                        return LLVMBuildCall2(u->olusturucu, getter_fn->tip,
+                        return llvm_cagri_kur(u, getter_fn->tip,
                                              getter_fn->deger, args, 1, cagri_adi);
                     }
                     s_it = s_it->sonraki;
@@ -2402,7 +2403,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
             if (!malloc_fn) return NULL;
 
             LLVMValueRef malloc_args[] = { boyut };
-            LLVMValueRef raw_ptr = LLVMBuildCall2(u->olusturucu, malloc_fn->tip,
+            LLVMValueRef raw_ptr = llvm_cagri_kur(u, malloc_fn->tip,
                                                    malloc_fn->deger, malloc_args, 1, "dizi_raw");
             LLVMValueRef dizi_ptr = LLVMBuildBitCast(u->olusturucu, raw_ptr,
                 LLVMPointerType(eleman_tip, 0), "dizi_ptr");
@@ -2448,7 +2449,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
             /* _tr_sozluk_yeni() çağır */
             LLVMSembolGirişi *yeni_fn = llvm_sembol_bul(u, "_tr_sozluk_yeni");
             if (!yeni_fn) return NULL;
-            LLVMValueRef sozluk = LLVMBuildCall2(u->olusturucu, yeni_fn->tip,
+            LLVMValueRef sozluk = llvm_cagri_kur(u, yeni_fn->tip,
                 yeni_fn->deger, NULL, 0, "sozluk_yeni");
 
             /* Her çift için _tr_sozluk_ekle çağır */
@@ -2462,7 +2463,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                     LLVMValueRef aptr = LLVMBuildExtractValue(u->olusturucu, anahtar, 0, "a_ptr");
                     LLVMValueRef alen = LLVMBuildExtractValue(u->olusturucu, anahtar, 1, "a_len");
                     LLVMValueRef args[] = { sozluk, aptr, alen, deger };
-                    sozluk = LLVMBuildCall2(u->olusturucu, ekle_fn->tip,
+                    sozluk = llvm_cagri_kur(u, ekle_fn->tip,
                         ekle_fn->deger, args, 4, "sozluk_ekle");
                 }
             }
@@ -2482,7 +2483,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
             LLVMValueRef aptr = LLVMBuildExtractValue(u->olusturucu, anahtar, 0, "s_ptr");
             LLVMValueRef alen = LLVMBuildExtractValue(u->olusturucu, anahtar, 1, "s_len");
             LLVMValueRef args[] = { sozluk, aptr, alen };
-            return LLVMBuildCall2(u->olusturucu, oku_fn->tip,
+            return llvm_cagri_kur(u, oku_fn->tip,
                 oku_fn->deger, args, 3, "sozluk_oku");
         }
 
@@ -2581,16 +2582,21 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
             if (dugum->çocuklar[1]->tur == DÜĞÜM_TANIMLAYICI) {
                 char *fn_isim = dugum->çocuklar[1]->veri.tanimlayici.isim;
                 LLVMSembolGirişi *fn = llvm_sembol_bul(u, fn_isim);
+                if (fn && !LLVMIsAFunction(fn->deger)) {
+                    LLVMValueRef kapanis = LLVMBuildLoad2(u->olusturucu,
+                        LLVMInt64TypeInContext(u->baglam), fn->deger, "kapanis_yukle");
+                    return llvm_kapanis_cagir(u, kapanis, &arg, 1);
+                }
                 if (fn) {
                     LLVMValueRef args[] = { arg };
-                    return LLVMBuildCall2(u->olusturucu, fn->tip, fn->deger, args, 1, "boru_sonuc");
+                    return llvm_cagri_kur(u, fn->tip, fn->deger, args, 1, "boru_sonuc");
                 }
                 /* Doğrudan fonksiyon adı ile dene */
                 LLVMValueRef fn_ref = LLVMGetNamedFunction(u->modul, fn_isim);
                 if (fn_ref) {
                     LLVMTypeRef fn_tip = LLVMGlobalGetValueType(fn_ref);
                     LLVMValueRef args[] = { arg };
-                    return LLVMBuildCall2(u->olusturucu, fn_tip, fn_ref, args, 1, "boru_sonuc");
+                    return llvm_cagri_kur(u, fn_tip, fn_ref, args, 1, "boru_sonuc");
                 }
             }
             return NULL;
@@ -2766,7 +2772,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                 kume_fn = LLVMAddFunction(u->modul, "_tr_kume_yeni", ft);
             }
             LLVMTypeRef kume_yeni_ft = LLVMFunctionType(i64, NULL, 0, 0);
-            LLVMValueRef kume = LLVMBuildCall2(u->olusturucu,
+            LLVMValueRef kume = llvm_cagri_kur(u,
                 kume_yeni_ft, kume_fn, NULL, 0, "kume");
 
             /* Her eleman için _tr_kume_ekle(kume, deger) */
@@ -2786,7 +2792,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                         LLVMGetIntTypeWidth(LLVMTypeOf(deger)) != 64)
                         deger = LLVMBuildZExt(u->olusturucu, deger, i64, "kume_ext");
                     LLVMValueRef args[] = { kume, deger };
-                    LLVMBuildCall2(u->olusturucu, ekle_ft, ekle_fn, args, 2, "");
+                    llvm_cagri_kur(u, ekle_ft, ekle_fn, args, 2, "");
                 }
             }
             return kume;
@@ -2816,7 +2822,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
             boyut = LLVMBuildSelect(u->olusturucu, min_cmp,
                 LLVMConstInt(i64, 8, 0), boyut, "lu_boyut_min");
             LLVMValueRef nesne_args[] = { LLVMConstInt(i64, 1, 0), boyut };
-            LLVMValueRef sonuc_raw = LLVMBuildCall2(u->olusturucu,
+            LLVMValueRef sonuc_raw = llvm_cagri_kur(u,
                 nesne_ft, nesne_fn, nesne_args, 2, "lu_sonuc");
             LLVMValueRef sonuc_ptr = LLVMBuildBitCast(u->olusturucu, sonuc_raw,
                 LLVMPointerType(i64, 0), "lu_sonuc_ptr");
@@ -2932,7 +2938,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
             if (!sozluk_fn) {
                 sozluk_fn = LLVMAddFunction(u->modul, "_tr_sozluk_yeni", sozluk_ft);
             }
-            LLVMValueRef sozluk = LLVMBuildCall2(u->olusturucu,
+            LLVMValueRef sozluk = llvm_cagri_kur(u,
                 sozluk_ft, sozluk_fn, NULL, 0, "su_sozluk");
 
             /* Alloca: kaynak index */
@@ -3013,7 +3019,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                 ekle_fn = LLVMAddFunction(u->modul, "_tr_sozluk_ekle", ekle_ft);
             }
             LLVMValueRef ekle_args[] = { sozluk, anahtar_ptr_v, anahtar_len, deger };
-            LLVMBuildCall2(u->olusturucu, ekle_ft, ekle_fn, ekle_args, 4, "su_ekle");
+            llvm_cagri_kur(u, ekle_ft, ekle_fn, ekle_args, 4, "su_ekle");
             LLVMBuildBr(u->olusturucu, atla);
 
             /* Atla: idx++ */
@@ -3077,7 +3083,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                         fn_ptr, LLVMConstInt(i64, arg_sayisi, 0),
                         arg_vals[0], arg_vals[1], arg_vals[2], arg_vals[3]
                     };
-                    LLVMValueRef handle = LLVMBuildCall2(u->olusturucu,
+                    LLVMValueRef handle = llvm_cagri_kur(u,
                         olustur_ft, olustur_fn, olustur_args, 6, "bekle_handle");
 
                     /* _tr_async_bekle(handle) */
@@ -3090,7 +3096,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                     LLVMTypeRef bekle_pt[] = { i64 };
                     LLVMTypeRef bekle_ft = LLVMFunctionType(i64, bekle_pt, 1, 0);
                     LLVMValueRef bekle_args[] = { handle };
-                    return LLVMBuildCall2(u->olusturucu,
+                    return llvm_cagri_kur(u,
                         bekle_ft, bekle_fn, bekle_args, 1, "bekle_sonuc");
                 } else {
                     /* Fallback: ifadeyi doğrudan çalıştır */
@@ -3107,7 +3113,8 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
             return LLVMConstInt(LLVMInt64TypeInContext(u->baglam), 0, 0);
 
         case DÜĞÜM_LAMBDA: {
-            /* Lambda (anonim işlev): fonksiyonu üret, adresi i64 olarak döndür */
+            /* Lambda (anonim işlev): fonksiyonu üret, kapanış işaretçisini i64
+             * olarak döndür. Kapanış son parametre (ortam) olarak gelir. */
             char *lambda_isim = dugum->veri.islev.isim;
             char *donus_tipi_adi = dugum->veri.islev.dönüş_tipi;
             LLVMTypeRef i64 = LLVMInt64TypeInContext(u->baglam);
@@ -3166,9 +3173,13 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                 dönüş_tipi = LLVMVoidTypeInContext(u->baglam);
             }
 
-            /* LLVM fonksiyonu oluştur */
+            /* LLVM fonksiyonu oluştur: bildirilen parametreler + ortam */
+            LLVMTypeRef *tum_param_tipleri = (LLVMTypeRef *)arena_ayir(
+                u->arena, sizeof(LLVMTypeRef) * (param_sayisi + 1));
+            for (int i = 0; i < param_sayisi; i++) tum_param_tipleri[i] = param_tipleri[i];
+            tum_param_tipleri[param_sayisi] = i64;
             LLVMTypeRef islev_tipi = LLVMFunctionType(
-                dönüş_tipi, param_tipleri, param_sayisi, 0);
+                dönüş_tipi, tum_param_tipleri, param_sayisi + 1, 0);
             LLVMValueRef lambda_fn = LLVMAddFunction(u->modul, lambda_isim, islev_tipi);
             LLVMSetLinkage(lambda_fn, LLVMPrivateLinkage);
 
@@ -3181,16 +3192,17 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                 u->baglam, lambda_fn, "giris");
             LLVMPositionBuilderAtEnd(u->olusturucu, giris_blok);
             u->mevcut_islev = lambda_fn;
+            LLVMBasicBlockRef onceki_pist = u->dene_pisti;
+            u->dene_pisti = NULL;
 
             /* Yeni kapsam */
             llvm_kapsam_gir(u);
 
             /* Yakalanan değişkenleri ortamdan yükle */
             if (yak_sayisi > 0) {
-                LLVMValueRef ortam_global = LLVMGetNamedGlobal(u->modul, "_tr_kapanis_ortam");
                 LLVMTypeRef i64_ptr = LLVMPointerType(i64, 0);
-                LLVMValueRef ortam_ptr = LLVMBuildLoad2(u->olusturucu,
-                    i64_ptr, ortam_global, "ortam");
+                LLVMValueRef ortam_ptr = LLVMBuildIntToPtr(u->olusturucu,
+                    LLVMGetParam(lambda_fn, param_sayisi), i64_ptr, "ortam");
 
                 for (int ci = 0; ci < yak_sayisi; ci++) {
                     LLVMValueRef idx = LLVMConstInt(i64, ci + 2, 0);
@@ -3237,9 +3249,10 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
 
             /* Eski durumu geri yükle */
             u->mevcut_islev = onceki_islev;
+            u->dene_pisti = onceki_pist;
             LLVMPositionBuilderAtEnd(u->olusturucu, onceki_blok);
 
-            /* Kapanış nesnesi oluştur veya sadece adres döndür */
+            /* Kapanış nesnesi oluştur */
             if (yak_sayisi > 0) {
                 /* _tr_nesne_olustur(5, (yak_sayisi+2)*8) */
                 LLVMValueRef nesne_fn = LLVMGetNamedFunction(u->modul, "_tr_nesne_olustur");
@@ -3249,7 +3262,7 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                     LLVMConstInt(i64, 5, 0),  /* NESNE_TIP_KAPANIS */
                     LLVMConstInt(i64, (yak_sayisi + 2) * 8, 0)
                 };
-                LLVMValueRef ortam = LLVMBuildCall2(u->olusturucu,
+                LLVMValueRef ortam = llvm_cagri_kur(u,
                     nesne_ft, nesne_fn, nesne_args, 2, "kapanis_ortam");
 
                 /* i8* → i64* */
@@ -3279,15 +3292,10 @@ LLVMValueRef llvm_ifade_uret(LLVMÜretici *u, Düğüm *dugum) {
                     LLVMBuildStore(u->olusturucu, yakalanan_degerler[ci], slot);
                 }
 
-                /* Global _tr_kapanis_ortam'a kaydet */
-                LLVMValueRef ortam_global = LLVMGetNamedGlobal(u->modul, "_tr_kapanis_ortam");
-                LLVMBuildStore(u->olusturucu, ortam_i64, ortam_global);
-
-                /* fn_ptr döndür (i64) */
-                return fn_as_i64;
+                return LLVMBuildPtrToInt(u->olusturucu, ortam_i64, i64, "kapanis");
             } else {
-                /* Yakalama yok: sadece fonksiyon adresi */
-                return LLVMBuildPtrToInt(u->olusturucu, lambda_fn, i64, "lambda_ptr");
+                /* Yakalama yok: statik kapanış */
+                return llvm_statik_kapanis(u, lambda_fn);
             }
         }
 
@@ -3373,6 +3381,205 @@ LLVMValueRef llvm_metin_sabiti_oluştur(LLVMÜretici *u, const char *metin) {
  *  BÖLÜM 6: DEYİM ÜRETİMİ
  * ═══════════════════════════════════════════════════════════════════════════ */
 
+/*
+ * paralel her...için: gövde i64 _tr_paralel_govde_N(ortam, bas, son, kismi)
+ * olarak ayrı işleve çıkarılır, _tr_paralel_her parçaları iş havuzunda
+ * çalıştırır. ortam[0] dizi işaretçisi, ortam[1..] yakalanan yerellerin
+ * adresleridir (çağrı süresince çağıranın çerçevesi canlıdır). İndirgeme
+ * değişkenleri gövdede yereldir ve parçanın kismi[] değerinden başlar.
+ */
+static void llvm_paralel_yakala_topla(LLVMÜretici *u, Düğüm *d, Düğüm *dongu,
+                                      char **isimler, int *sayac) {
+    if (!d) return;
+    if (d->tur == DÜĞÜM_TANIMLAYICI && d->veri.tanimlayici.isim) {
+        const char *isim = d->veri.tanimlayici.isim;
+        LLVMSembolGirişi *s = llvm_sembol_bul(u, isim);
+        int indirgeme = 0;
+        for (int i = 0; i < dongu->veri.dongu.indirgeme_sayisi; i++) {
+            if (strcmp(dongu->veri.dongu.indirgeme_isim[i], isim) == 0) indirgeme = 1;
+        }
+        if (s && !s->global_mi && !indirgeme && strcmp(isim, dongu->veri.dongu.isim) != 0) {
+            int var = 0;
+            for (int j = 0; j < *sayac; j++) {
+                if (strcmp(isimler[j], isim) == 0) { var = 1; break; }
+            }
+            if (!var && *sayac < 64) isimler[(*sayac)++] = (char *)isim;
+        }
+    }
+    for (int i = 0; i < d->çocuk_sayısı; i++) {
+        llvm_paralel_yakala_topla(u, d->çocuklar[i], dongu, isimler, sayac);
+    }
+}
+
+static void llvm_paralel_her_uret(LLVMÜretici *u, Düğüm *dugum) {
+    LLVMTypeRef i64 = LLVMInt64TypeInContext(u->baglam);
+    LLVMTypeRef i64_ptr = LLVMPointerType(i64, 0);
+    int ind_sayisi = dugum->veri.dongu.indirgeme_sayisi;
+
+    LLVMValueRef dizi_val = llvm_ifade_uret(u, dugum->çocuklar[0]);
+    if (!dizi_val) return;
+    LLVMValueRef dizi_ptr = LLVMBuildExtractValue(u->olusturucu, dizi_val, 0, "par_ptr");
+    LLVMValueRef dizi_say = LLVMBuildExtractValue(u->olusturucu, dizi_val, 1, "par_say");
+
+    char *yak_isimler[64];
+    int yak_sayisi = 0;
+    llvm_paralel_yakala_topla(u, dugum->çocuklar[1], dugum, yak_isimler, &yak_sayisi);
+    LLVMSembolGirişi *yakalanan[64];
+    for (int i = 0; i < yak_sayisi; i++) yakalanan[i] = llvm_sembol_bul(u, yak_isimler[i]);
+
+    /* Ortam, indirgeme ve işlem dizileri çağıranın çerçevesinde */
+    LLVMValueRef ortam = LLVMBuildArrayAlloca(u->olusturucu, i64,
+        LLVMConstInt(i64, 1 + yak_sayisi, 0), "par_ortam");
+    LLVMValueRef sifir = LLVMConstInt(i64, 0, 0);
+    LLVMBuildStore(u->olusturucu,
+        LLVMBuildPtrToInt(u->olusturucu, dizi_ptr, i64, "par_dizi"),
+        LLVMBuildGEP2(u->olusturucu, i64, ortam, &sifir, 1, "ortam_0"));
+    for (int i = 0; i < yak_sayisi; i++) {
+        LLVMValueRef idx = LLVMConstInt(i64, 1 + i, 0);
+        LLVMBuildStore(u->olusturucu,
+            LLVMBuildPtrToInt(u->olusturucu, yakalanan[i]->deger, i64, "yak_adres"),
+            LLVMBuildGEP2(u->olusturucu, i64, ortam, &idx, 1, "ortam_k"));
+    }
+    LLVMValueRef ind_dizi = LLVMBuildArrayAlloca(u->olusturucu, i64,
+        LLVMConstInt(i64, ind_sayisi ? ind_sayisi : 1, 0), "par_ind");
+    LLVMValueRef islem_dizi = LLVMBuildArrayAlloca(u->olusturucu, i64,
+        LLVMConstInt(i64, ind_sayisi ? ind_sayisi : 1, 0), "par_islem");
+    LLVMSembolGirişi *ind_dis[4];
+    for (int i = 0; i < ind_sayisi; i++) {
+        LLVMValueRef idx = LLVMConstInt(i64, i, 0);
+        ind_dis[i] = llvm_sembol_bul(u, dugum->veri.dongu.indirgeme_isim[i]);
+        LLVMValueRef baslangic = ind_dis[i]
+            ? LLVMBuildLoad2(u->olusturucu, ind_dis[i]->tip, ind_dis[i]->deger, "ind_bas")
+            : sifir;
+        LLVMBuildStore(u->olusturucu, baslangic,
+            LLVMBuildGEP2(u->olusturucu, i64, ind_dizi, &idx, 1, "ind_k"));
+        LLVMBuildStore(u->olusturucu,
+            LLVMConstInt(i64, dugum->veri.dongu.indirgeme_islem[i], 0),
+            LLVMBuildGEP2(u->olusturucu, i64, islem_dizi, &idx, 1, "islem_k"));
+    }
+
+    /* Gövde işlevi */
+    char govde_isim[64];
+    snprintf(govde_isim, sizeof(govde_isim), "_tr_paralel_govde_%d", u->etiket_sayaci++);
+    LLVMTypeRef govde_param[] = { i64, i64, i64, i64 };
+    LLVMTypeRef govde_tipi = LLVMFunctionType(i64, govde_param, 4, 0);
+    LLVMValueRef govde = LLVMAddFunction(u->modul, govde_isim, govde_tipi);
+    LLVMSetLinkage(govde, LLVMPrivateLinkage);
+
+    LLVMValueRef onceki_islev = u->mevcut_islev;
+    LLVMBasicBlockRef onceki_blok = LLVMGetInsertBlock(u->olusturucu);
+    LLVMBasicBlockRef onceki_cikis = u->dongu_cikis;
+    LLVMBasicBlockRef onceki_devam = u->dongu_devam;
+    u->mevcut_islev = govde;
+    LLVMBasicBlockRef onceki_pist = u->dene_pisti;
+    u->dene_pisti = NULL;
+    LLVMPositionBuilderAtEnd(u->olusturucu,
+        LLVMAppendBasicBlockInContext(u->baglam, govde, "giris"));
+    llvm_kapsam_gir(u);
+
+    LLVMValueRef g_ortam = LLVMBuildIntToPtr(u->olusturucu, LLVMGetParam(govde, 0), i64_ptr, "ortam");
+    LLVMValueRef g_kismi = LLVMBuildIntToPtr(u->olusturucu, LLVMGetParam(govde, 3), i64_ptr, "kismi");
+    for (int i = 0; i < yak_sayisi; i++) {
+        LLVMValueRef idx = LLVMConstInt(i64, 1 + i, 0);
+        LLVMValueRef adres = LLVMBuildLoad2(u->olusturucu, i64,
+            LLVMBuildGEP2(u->olusturucu, i64, g_ortam, &idx, 1, "ortam_k"), "yak_adres");
+        LLVMValueRef p = LLVMBuildIntToPtr(u->olusturucu, adres,
+            LLVMPointerType(yakalanan[i]->tip, 0), yak_isimler[i]);
+        llvm_sembol_ekle(u, yak_isimler[i], p, yakalanan[i]->tip, 0, 0);
+        u->sembol_tablosu->girisler->metin_dizisi = yakalanan[i]->metin_dizisi;
+    }
+    LLVMValueRef ind_yerel[4];
+    for (int i = 0; i < ind_sayisi; i++) {
+        LLVMValueRef idx = LLVMConstInt(i64, i, 0);
+        ind_yerel[i] = LLVMBuildAlloca(u->olusturucu, i64, dugum->veri.dongu.indirgeme_isim[i]);
+        LLVMBuildStore(u->olusturucu,
+            LLVMBuildLoad2(u->olusturucu, i64,
+                LLVMBuildGEP2(u->olusturucu, i64, g_kismi, &idx, 1, "kismi_k"), "kismi"),
+            ind_yerel[i]);
+        llvm_sembol_ekle(u, dugum->veri.dongu.indirgeme_isim[i], ind_yerel[i], i64, 0, 0);
+    }
+    LLVMValueRef g_dizi = LLVMBuildIntToPtr(u->olusturucu,
+        LLVMBuildLoad2(u->olusturucu, i64, g_ortam, "dizi"), i64_ptr, "dizi_ptr");
+    LLVMValueRef idx_alloca = LLVMBuildAlloca(u->olusturucu, i64, "par_idx");
+    LLVMBuildStore(u->olusturucu, LLVMGetParam(govde, 1), idx_alloca);
+    LLVMValueRef eleman_alloca = LLVMBuildAlloca(u->olusturucu, i64, dugum->veri.dongu.isim);
+    llvm_sembol_ekle(u, dugum->veri.dongu.isim, eleman_alloca, i64, 0, 0);
+
+    LLVMBasicBlockRef kosul_blok = LLVMAppendBasicBlockInContext(u->baglam, govde, "par_kosul");
+    LLVMBasicBlockRef govde_blok = LLVMAppendBasicBlockInContext(u->baglam, govde, "par_govde");
+    LLVMBasicBlockRef artir_blok = LLVMAppendBasicBlockInContext(u->baglam, govde, "par_artir");
+    LLVMBasicBlockRef son_blok = LLVMAppendBasicBlockInContext(u->baglam, govde, "par_son");
+    LLVMBuildBr(u->olusturucu, kosul_blok);
+
+    LLVMPositionBuilderAtEnd(u->olusturucu, kosul_blok);
+    LLVMValueRef idx_val = LLVMBuildLoad2(u->olusturucu, i64, idx_alloca, "idx");
+    LLVMBuildCondBr(u->olusturucu,
+        LLVMBuildICmp(u->olusturucu, LLVMIntSLT, idx_val, LLVMGetParam(govde, 2), "par_cmp"),
+        govde_blok, son_blok);
+
+    LLVMPositionBuilderAtEnd(u->olusturucu, govde_blok);
+    u->dongu_cikis = son_blok;
+    u->dongu_devam = artir_blok;
+    LLVMValueRef idx2 = LLVMBuildLoad2(u->olusturucu, i64, idx_alloca, "idx2");
+    LLVMBuildStore(u->olusturucu,
+        LLVMBuildLoad2(u->olusturucu, i64,
+            LLVMBuildGEP2(u->olusturucu, i64, g_dizi, &idx2, 1, "elem_ptr"), "eleman"),
+        eleman_alloca);
+    llvm_blok_uret(u, dugum->çocuklar[1]);
+    if (!LLVMGetBasicBlockTerminator(LLVMGetInsertBlock(u->olusturucu))) {
+        LLVMBuildBr(u->olusturucu, artir_blok);
+    }
+
+    LLVMPositionBuilderAtEnd(u->olusturucu, artir_blok);
+    LLVMValueRef idx3 = LLVMBuildLoad2(u->olusturucu, i64, idx_alloca, "idx3");
+    LLVMBuildStore(u->olusturucu,
+        LLVMBuildAdd(u->olusturucu, idx3, LLVMConstInt(i64, 1, 0), "idx_art"), idx_alloca);
+    LLVMBuildBr(u->olusturucu, kosul_blok);
+
+    LLVMPositionBuilderAtEnd(u->olusturucu, son_blok);
+    for (int i = 0; i < ind_sayisi; i++) {
+        LLVMValueRef idx = LLVMConstInt(i64, i, 0);
+        LLVMBuildStore(u->olusturucu,
+            LLVMBuildLoad2(u->olusturucu, i64, ind_yerel[i], "ind_son"),
+            LLVMBuildGEP2(u->olusturucu, i64, g_kismi, &idx, 1, "kismi_k"));
+    }
+    LLVMBuildRet(u->olusturucu, sifir);
+
+    llvm_kapsam_cik(u);
+    u->mevcut_islev = onceki_islev;
+    u->dene_pisti = onceki_pist;
+    u->dongu_cikis = onceki_cikis;
+    u->dongu_devam = onceki_devam;
+    LLVMPositionBuilderAtEnd(u->olusturucu, onceki_blok);
+
+    /* _tr_paralel_her(govde, ortam, sayi, indirgeme, islemler, indirgeme_sayisi);
+     * paylaşılan dizi yazmaları ayrık değilse _eleman/_sirali girişi */
+    const char *her_isim =
+        dugum->veri.dongu.paylasim == PARALEL_PAYLASIM_ELEMAN ? "_tr_paralel_her_eleman" :
+        dugum->veri.dongu.paylasim == PARALEL_PAYLASIM_SIRALI ? "_tr_paralel_her_sirali" :
+        "_tr_paralel_her";
+    LLVMTypeRef her_param[] = { i64, i64, i64, i64_ptr, i64_ptr, i64 };
+    LLVMTypeRef her_tipi = LLVMFunctionType(LLVMVoidTypeInContext(u->baglam), her_param, 6, 0);
+    LLVMValueRef her_fn = LLVMGetNamedFunction(u->modul, her_isim);
+    if (!her_fn) her_fn = LLVMAddFunction(u->modul, her_isim, her_tipi);
+    LLVMValueRef her_args[] = {
+        LLVMBuildPtrToInt(u->olusturucu, govde, i64, "govde"),
+        LLVMBuildPtrToInt(u->olusturucu, ortam, i64, "ortam"),
+        dizi_say, ind_dizi, islem_dizi,
+        LLVMConstInt(i64, ind_sayisi, 0)
+    };
+    llvm_cagri_kur(u, her_tipi, her_fn, her_args, 6, "");
+
+    for (int i = 0; i < ind_sayisi; i++) {
+        if (!ind_dis[i]) continue;
+        LLVMValueRef idx = LLVMConstInt(i64, i, 0);
+        LLVMBuildStore(u->olusturucu,
+            LLVMBuildLoad2(u->olusturucu, i64,
+                LLVMBuildGEP2(u->olusturucu, i64, ind_dizi, &idx, 1, "ind_k"), "ind_sonuc"),
+            ind_dis[i]->deger);
+    }
+}
+
 /*
  * llvm_deyim_uret - Deyim üret
  */
@@ -3842,7 +4049,7 @@ void llvm_deyim_uret(LLVMÜretici *u, Düğüm *dugum) {
                     if (setter_fn) {
                         /* Setter bulundu: setter(bu, deger) çağır */
                         LLVMValueRef args[] = { nesne, deger };
-                        LLVMBuildCall2(u->olusturucu, setter_fn->tip,
+                        llvm_cagri_kur(u, setter_fn->tip,
                                       setter_fn->deger, args, 2, "");
                         break;
                     }
@@ -3894,6 +4101,10 @@ void llvm_deyim_uret(LLVMÜretici *u, Düğüm *dugum) {
         case DÜĞÜM_HER_İÇİN: {
             /* her eleman için dizi ise ... son */
             if (dugum->çocuk_sayısı < 2) break;
+            if (dugum->veri.dongu.paralel) {
+                llvm_paralel_her_uret(u, dugum);
+                break;
+            }
 
             LLVMTypeRef i64 = LLVMInt64TypeInContext(u->baglam);
 
@@ -4051,15 +4262,15 @@ void llvm_deyim_uret(LLVMÜretici *u, Düğüm *dugum) {
         }
 
         case DÜĞÜM_DENE_YAKALA: {
-            /* dene ... yakala [Tip] [degisken] ... [sonunda ...] son */
-            LLVMSembolGirişi *dene_fn = llvm_sembol_bul(u, "_tr_dene_baslat");
-            LLVMSembolGirişi *bitir_fn = llvm_sembol_bul(u, "_tr_dene_bitir");
-            LLVMSembolGirişi *tip_fn = llvm_sembol_bul(u, "_tr_istisna_tip");
-            LLVMSembolGirişi *deger_fn = llvm_sembol_bul(u, "_tr_istisna_deger");
-            LLVMSembolGirişi *deger_len_fn = llvm_sembol_bul(u, "_tr_istisna_deger_len");
-            if (!dene_fn || !bitir_fn || !tip_fn || !deger_fn || !deger_len_fn) break;
+            /* dene ... yakala [Tip] [degisken] ... [sonunda ...] son
+             * Tablo tabanlı: gövdedeki çağrılar invoke olur, istisna iniş
+             * pistine gelir; normal yolda hiçbir kayıt yapılmaz. */
+            LLVMSembolGirişi *kisilik_fn = llvm_sembol_bul(u, "_tr_kisilik");
+            LLVMSembolGirişi *yakala_fn = llvm_sembol_bul(u, "_tr_istisna_yakala");
+            if (!kisilik_fn || !yakala_fn) break;
 
             LLVMTypeRef i64_tip = LLVMInt64TypeInContext(u->baglam);
+            LLVMTypeRef i8p_tip = LLVMPointerType(LLVMInt8TypeInContext(u->baglam), 0);
 
             /* sonunda bloğu var mı? */
             int sonunda_var = (dugum->veri.tanimlayici.tip &&
@@ -4067,48 +4278,51 @@ void llvm_deyim_uret(LLVMÜretici *u, Düğüm *dugum) {
             int yakala_son = sonunda_var ? dugum->çocuk_sayısı - 1 : dugum->çocuk_sayısı;
             int sonunda_idx = sonunda_var ? dugum->çocuk_sayısı - 1 : -1;
 
-            /* _tr_dene_baslat() → 0=normal, 1=istisna */
-            LLVMValueRef sonuc = LLVMBuildCall2(u->olusturucu, dene_fn->tip,
-                dene_fn->deger, NULL, 0, "dene_sonuc");
-            unsigned kind = LLVMGetEnumAttributeKindForName("returns_twice", 13);
-            LLVMAttributeRef attr = LLVMCreateEnumAttribute(u->baglam, kind, 0);
-            LLVMAddCallSiteAttribute(sonuc, LLVMAttributeFunctionIndex, attr);
-
-            LLVMValueRef cmp = LLVMBuildICmp(u->olusturucu, LLVMIntEQ, sonuc,
-                LLVMConstInt(LLVMInt32TypeInContext(u->baglam), 0, 0), "dene_cmp");
-
             LLVMBasicBlockRef dene_blok = LLVMAppendBasicBlockInContext(
                 u->baglam, u->mevcut_islev, "dene_govde");
-            LLVMBasicBlockRef yakala_dispatch = LLVMAppendBasicBlockInContext(
-                u->baglam, u->mevcut_islev, "yakala_dispatch");
+            LLVMBasicBlockRef pist_blok = LLVMAppendBasicBlockInContext(
+                u->baglam, u->mevcut_islev, "dene_pisti");
             LLVMBasicBlockRef sonunda_blok = LLVMAppendBasicBlockInContext(
                 u->baglam, u->mevcut_islev, "sonunda_blok");
             LLVMBasicBlockRef son_blok = LLVMAppendBasicBlockInContext(
                 u->baglam, u->mevcut_islev, "dene_son");
 
-            LLVMBuildCondBr(u->olusturucu, cmp, dene_blok, yakala_dispatch);
+            LLVMSetPersonalityFn(u->mevcut_islev, kisilik_fn->deger);
+            LLVMBuildBr(u->olusturucu, dene_blok);
 
             /* === Dene gövdesi === */
             LLVMPositionBuilderAtEnd(u->olusturucu, dene_blok);
+            LLVMBasicBlockRef onceki_pist = u->dene_pisti;
+            u->dene_pisti = pist_blok;
             if (dugum->çocuk_sayısı > 0) {
                 llvm_blok_uret(u, dugum->çocuklar[0]);
             }
+            u->dene_pisti = onceki_pist;
             if (!LLVMGetBasicBlockTerminator(LLVMGetInsertBlock(u->olusturucu))) {
-                LLVMBuildCall2(u->olusturucu, bitir_fn->tip,
-                    bitir_fn->deger, NULL, 0, "");
                 LLVMBuildBr(u->olusturucu, sonunda_blok);
             }
 
-            /* === Yakala dispatch === */
-            LLVMPositionBuilderAtEnd(u->olusturucu, yakala_dispatch);
-
-            /* İstisna bilgilerini al */
-            LLVMValueRef ist_tip = LLVMBuildCall2(u->olusturucu, tip_fn->tip,
-                tip_fn->deger, NULL, 0, "ist_tip");
-            LLVMValueRef ist_deger = LLVMBuildCall2(u->olusturucu, deger_fn->tip,
-                deger_fn->deger, NULL, 0, "ist_deger");
-            LLVMValueRef ist_len = LLVMBuildCall2(u->olusturucu, deger_len_fn->tip,
-                deger_len_fn->deger, NULL, 0, "ist_len");
+            /* === İniş pisti: hepsini yakala, tip seçimi aşağıda === */
+            LLVMPositionBuilderAtEnd(u->olusturucu, pist_blok);
+            LLVMTypeRef pist_alanlar[] = { i8p_tip, LLVMInt32TypeInContext(u->baglam) };
+            LLVMTypeRef pist_tip = LLVMStructTypeInContext(u->baglam, pist_alanlar, 2, 0);
+            LLVMValueRef pist = LLVMBuildLandingPad(u->olusturucu, pist_tip,
+                kisilik_fn->deger, 1, "istisna");
+            LLVMAddClause(pist, LLVMConstNull(i8p_tip));
+            LLVMValueRef nesne = LLVMBuildExtractValue(u->olusturucu, pist, 0, "istisna_nesne");
+            LLVMValueRef bilgi = LLVMBuildCall2(u->olusturucu, yakala_fn->tip,
+                yakala_fn->deger, &nesne, 1, "istisna_bilgi");
+
+            /* [deger, deger_len, tip] */
+            LLVMValueRef alan[3];
+            for (int k = 0; k < 3; k++) {
+                LLVMValueRef idx = LLVMConstInt(i64_tip, k, 0);
+                LLVMValueRef p = LLVMBuildGEP2(u->olusturucu, i64_tip, bilgi, &idx, 1, "ist_alan");
+                alan[k] = LLVMBuildLoad2(u->olusturucu, i64_tip, p, "ist");
+            }
+            LLVMValueRef ist_deger = alan[0];
+            LLVMValueRef ist_len = alan[1];
+            LLVMValueRef ist_tip = alan[2];
 
             /* Çoklu yakala dispatch zinciri */
             for (int i = 1; i < yakala_son; i++) {
@@ -4221,7 +4435,7 @@ void llvm_deyim_uret(LLVMÜretici *u, Düğüm *dugum) {
             }
             LLVMValueRef tip = LLVMConstInt(i64_tip, 0, 0);  /* genel hata */
             LLVMValueRef args[] = { deger_ptr, deger_len, tip };
-            LLVMBuildCall2(u->olusturucu, firlat_fn->tip,
+            llvm_cagri_kur(u, firlat_fn->tip,
                 firlat_fn->deger, args, 3, "");
             LLVMBuildUnreachable(u->olusturucu);
             /* Unreachable sonrası yeni blok lazım (LLVM gereksinimi) */
@@ -4531,6 +4745,8 @@ void llvm_sınıf_üret(LLVMÜretici *u, Düğüm *dugum) {
         LLVMBasicBlockRef giris = LLVMAppendBasicBlockInContext(u->baglam, yapici_fn, "giris");
         LLVMValueRef onceki_islev = u->mevcut_islev;
         u->mevcut_islev = yapici_fn;
+        LLVMBasicBlockRef onceki_pist = u->dene_pisti;
+        u->dene_pisti = NULL;
         LLVMPositionBuilderAtEnd(u->olusturucu, giris);
 
         /* malloc ile nesne oluştur */
@@ -4541,7 +4757,7 @@ void llvm_sınıf_üret(LLVMÜretici *u, Düğüm *dugum) {
         LLVMSembolGirişi *malloc_fn = llvm_sembol_bul(u, "malloc");
         if (malloc_fn) {
             LLVMValueRef malloc_args[] = { boyut_val };
-            LLVMValueRef raw_ptr = LLVMBuildCall2(u->olusturucu, malloc_fn->tip,
+            LLVMValueRef raw_ptr = llvm_cagri_kur(u, malloc_fn->tip,
                                                    malloc_fn->deger, malloc_args, 1, "raw_ptr");
             LLVMValueRef nesne_ptr = LLVMBuildBitCast(u->olusturucu, raw_ptr,
                                                        sinif_ptr_tipi, "nesne_ptr");
@@ -4563,6 +4779,7 @@ void llvm_sınıf_üret(LLVMÜretici *u, Düğüm *dugum) {
         }
 
         u->mevcut_islev = onceki_islev;
+        u->dene_pisti = onceki_pist;
     }
 
     /* Mevcut sınıf adını kaydet */
@@ -4848,6 +5065,7 @@ void llvm_program_üret(LLVMÜretici *u, Düğüm *program) {
             LLVMPositionBuilderAtEnd(u->olusturucu, giris);
 
             u->mevcut_islev = test_fn;
+            u->dene_pisti = NULL;
             llvm_kapsam_gir(u);
 
             /* Test ismini global string olarak oluştur */
@@ -4888,6 +5106,7 @@ void llvm_program_üret(LLVMÜretici *u, Düğüm *program) {
         LLVMPositionBuilderAtEnd(u->olusturucu, giris);
 
         u->mevcut_islev = main_fn;
+        u->dene_pisti = NULL;
         llvm_kapsam_gir(u);
 
         /* Üst düzey deyimleri işle */
@@ -4906,13 +5125,13 @@ void llvm_program_üret(LLVMÜretici *u, Düğüm *program) {
             LLVMTypeRef void_tip = LLVMVoidTypeInContext(u->baglam);
             LLVMTypeRef test_fn_tip = LLVMFunctionType(void_tip, NULL, 0, 0);
             for (int t = 0; t < test_toplam; t++) {
-                LLVMBuildCall2(u->olusturucu, test_fn_tip,
+                llvm_cagri_kur(u, test_fn_tip,
                     test_fonksiyonlar[t], NULL, 0, "");
             }
             /* _tr_test_rapor() çağır */
             LLVMSembolGirişi *rapor_fn = llvm_sembol_bul(u, "_tr_test_rapor");
             if (rapor_fn) {
-                LLVMBuildCall2(u->olusturucu, rapor_fn->tip,
+                llvm_cagri_kur(u, rapor_fn->tip,
                     rapor_fn->deger, NULL, 0, "");
             }
         }
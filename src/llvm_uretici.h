@@ -119,6 +119,9 @@ typedef struct {
     } dongu_yigini[LLVM_MAKS_DONGU];
     int dongu_derinligi;
 
+    /* dene gövdesindeki çağrılar bu iniş pistine açılır (NULL: dene dışı) */
+    LLVMBasicBlockRef dene_pisti;
+
     /* Etiket sayacı */
     int etiket_sayaci;
 
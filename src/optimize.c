@@ -1,144 +1,1096 @@
 #include "optimize.h"
 #include "sozcuk.h"
+#include "tablo.h"
+#include <stdio.h>
 #include <string.h>
 
+/* Tüm backend'ler aynı (anlam çözümlemesinden geçmiş) ağacı tüketir; bu
+ * dosyadaki geçişler o ağaç üzerinde çalışır, böylece x86, ELF, ARM64,
+ * WASM, VM ve gömülü hedefler aynı optimizasyonları alır. Geçiş yöneticisi
+ * geçişleri hiçbiri değişiklik yapmayana kadar sırayla tekrarlar. */
+
+#define OPT_MAKS_TUR 8
+
+/* ---- Yardımcılar ---- */
+
+static int tam_sabit(Düğüm *d, int64_t *v) {
+    if (!d || d->tur != DÜĞÜM_TAM_SAYI) return 0;
+    *v = d->veri.tam_deger;
+    return 1;
+}
+
+static int mantik_sabit(Düğüm *d, int *v) {
+    if (!d || d->tur != DÜĞÜM_MANTIK_DEĞERİ) return 0;
+    *v = d->veri.mantık_değer ? 1 : 0;
+    return 1;
+}
+
+static void tam_yap(Düğüm *d, int64_t v) {
+    d->tur = DÜĞÜM_TAM_SAYI;
+    d->veri.tam_deger = v;
+    d->çocuk_sayısı = 0;
+    d->sonuç_tipi = TİP_TAM;
+}
+
+static void mantik_yap(Düğüm *d, int v) {
+    d->tur = DÜĞÜM_MANTIK_DEĞERİ;
+    d->veri.mantık_değer = v ? 1 : 0;
+    d->çocuk_sayısı = 0;
+    d->sonuç_tipi = TİP_MANTIK;
+}
+
+/* Bloktan i. çocuğu çıkar */
+static void cocuk_cikar(Düğüm *d, int i) {
+    for (int j = i + 1; j < d->çocuk_sayısı; j++) {
+        d->çocuklar[j - 1] = d->çocuklar[j];
+    }
+    d->çocuk_sayısı--;
+}
+
 /* ---- Sabit Katlama (Constant Folding) ---- */
 
-/* İkili işlem düğümünü sabit katlama ile optimize et.
- * Her iki çocuk DÜĞÜM_TAM_SAYI ise sonucu hesapla ve düğümü dönüştür. */
-static void sabit_katla(Düğüm *d) {
-    if (d->tur != DÜĞÜM_İKİLİ_İŞLEM) return;
-    if (d->çocuk_sayısı < 2) return;
+/* İkili/tekli işlemleri ve koşulu sabit üçlüleri yerinde hesapla.
+ * Tam sayı taşması C'de tanımsız olduğundan işaretsiz aritmetik kullanılır
+ * (üretilen makine kodunun ikiye tümleyen davranışıyla aynı sonuç). */
+static int sabit_katla(Düğüm *d) {
+    if (d->tur == DÜĞÜM_TEKLİ_İŞLEM && d->çocuk_sayısı >= 1) {
+        int64_t a;
+        int b;
+        SözcükTürü op = d->veri.islem.islem;
+        if (tam_sabit(d->çocuklar[0], &a)) {
+            if (op == TOK_EKSI) { tam_yap(d, (int64_t)(0 - (uint64_t)a)); return 1; }
+            if (op == TOK_BİT_DEĞİL) { tam_yap(d, ~a); return 1; }
+        } else if (mantik_sabit(d->çocuklar[0], &b) && op == TOK_DEĞİL) {
+            mantik_yap(d, !b);
+            return 1;
+        }
+        return 0;
+    }
+
+    if (d->tur == DÜĞÜM_ÜÇLÜ && d->çocuk_sayısı == 3) {
+        int k;
+        if (!mantik_sabit(d->çocuklar[0], &k)) return 0;
+        Düğüm *secilen = d->çocuklar[k ? 1 : 2];
+        int satir = d->satir, sutun = d->sutun;
+        *d = *secilen;
+        d->satir = satir;
+        d->sutun = sutun;
+        return 1;
+    }
+
+    if (d->tur != DÜĞÜM_İKİLİ_İŞLEM) return 0;
+    if (d->çocuk_sayısı < 2) return 0;
 
     Düğüm *sol = d->çocuklar[0];
     Düğüm *sag = d->çocuklar[1];
+    SözcükTürü op = d->veri.islem.islem;
 
-    if (sol->tur != DÜĞÜM_TAM_SAYI || sag->tur != DÜĞÜM_TAM_SAYI) return;
+    int x, y;
+    if (mantik_sabit(sol, &x) && mantik_sabit(sag, &y)) {
+        switch (op) {
+        case TOK_VE:          mantik_yap(d, x && y); return 1;
+        case TOK_VEYA:        mantik_yap(d, x || y); return 1;
+        case TOK_EŞİT_EŞİT:   mantik_yap(d, x == y); return 1;
+        case TOK_EŞİT_DEĞİL:  mantik_yap(d, x != y); return 1;
+        default:              return 0;
+        }
+    }
 
-    int64_t a = sol->veri.tam_deger;
-    int64_t b = sag->veri.tam_deger;
-    int64_t sonuç = 0;
-    int hesaplandi = 1;
+    int64_t a, b;
+    if (!tam_sabit(sol, &a) || !tam_sabit(sag, &b)) return 0;
+    uint64_t ua = (uint64_t)a, ub = (uint64_t)b;
 
-    switch (d->veri.islem.islem) {
-    case TOK_ARTI:   sonuç = a + b; break;
-    case TOK_EKSI:   sonuç = a - b; break;
-    case TOK_ÇARPIM: sonuç = a * b; break;
+    switch (op) {
+    case TOK_ARTI:   tam_yap(d, (int64_t)(ua + ub)); return 1;
+    case TOK_EKSI:   tam_yap(d, (int64_t)(ua - ub)); return 1;
+    case TOK_ÇARPIM: tam_yap(d, (int64_t)(ua * ub)); return 1;
     case TOK_BÖLME:
-        if (b == 0) { hesaplandi = 0; break; }
-        sonuç = a / b;
-        break;
+        /* Sıfıra bölme çalışma zamanı hatası olarak kalmalı */
+        if (b == 0 || (a == INT64_MIN && b == -1)) return 0;
+        tam_yap(d, a / b);
+        return 1;
     case TOK_YÜZDE:
-        if (b == 0) { hesaplandi = 0; break; }
-        sonuç = a % b;
-        break;
+        if (b == 0 || (a == INT64_MIN && b == -1)) return 0;
+        tam_yap(d, a % b);
+        return 1;
+    case TOK_BİT_VE:     tam_yap(d, a & b); return 1;
+    case TOK_BİT_VEYA:   tam_yap(d, a | b); return 1;
+    case TOK_BİT_XOR:    tam_yap(d, a ^ b); return 1;
+    case TOK_SOL_KAYDIR:
+        if (b < 0 || b > 63) return 0;
+        tam_yap(d, (int64_t)(ua << b));
+        return 1;
+    case TOK_SAĞ_KAYDIR:
+        /* Üretici shrq (mantıksal kaydırma) kullanır */
+        if (b < 0 || b > 63) return 0;
+        tam_yap(d, (int64_t)(ua >> b));
+        return 1;
+    case TOK_EŞİT_EŞİT:  mantik_yap(d, a == b); return 1;
+    case TOK_EŞİT_DEĞİL: mantik_yap(d, a != b); return 1;
+    case TOK_KÜÇÜK:      mantik_yap(d, a < b);  return 1;
+    case TOK_BÜYÜK:      mantik_yap(d, a > b);  return 1;
+    case TOK_KÜÇÜK_EŞİT: mantik_yap(d, a <= b); return 1;
+    case TOK_BÜYÜK_EŞİT: mantik_yap(d, a >= b); return 1;
     default:
-        hesaplandi = 0;
-        break;
-    }
-
-    if (hesaplandi) {
-        /* Düğümü DÜĞÜM_TAM_SAYI'ya dönüştür */
-        d->tur = DÜĞÜM_TAM_SAYI;
-        d->veri.tam_deger = sonuç;
-        d->çocuk_sayısı = 0;
+        return 0;
     }
 }
 
 /* ---- Güç Azaltma (Strength Reduction) ---- */
 
-/* x * 2 -> x << 1, x * 4 -> x << 2, x / 2 -> x >> 1
- * İkili işlem düğümünü yerinde dönüştürür. */
-static void guc_azalt(Düğüm *d) {
-    if (d->tur != DÜĞÜM_İKİLİ_İŞLEM) return;
-    if (d->çocuk_sayısı < 2) return;
+/* x * 2 -> x + x, 2 * x -> x + x
+ * Aynı alt düğüm iki kez değerlendirileceği için yalnızca yan etkisiz
+ * (tanımlayıcı) operandlarda uygulanır. */
+static int guc_azalt(Düğüm *d) {
+    if (d->tur != DÜĞÜM_İKİLİ_İŞLEM) return 0;
+    if (d->çocuk_sayısı < 2) return 0;
+    if (d->veri.islem.islem != TOK_ÇARPIM) return 0;
 
     Düğüm *sol = d->çocuklar[0];
     Düğüm *sag = d->çocuklar[1];
-    SözcükTürü op = d->veri.islem.islem;
+    int64_t v;
 
-    /* x * 2 -> x << 1 */
-    if (op == TOK_ÇARPIM && sag->tur == DÜĞÜM_TAM_SAYI) {
-        int64_t val = sag->veri.tam_deger;
-        if (val == 2) {
-            /* Sağ çocuğu 1 yap, işlemi kaydırma simüle et:
-             * AST'de doğrudan kaydırma düğümü yok, bu yüzden
-             * çarpma/bölme ile 2'nin kuvvetlerini katlama yaparız.
-             * Sabit katlama ile aynı mantık: x * 2 = x + x
-             * Ama daha iyi: DÜĞÜM_İKİLİ_İŞLEM olarak bırak,
-             * sağ tarafı 1 yap, işlemi shift olarak işaretle.
-             * Sorun: lexer'da shift token yok.
-             * Alternatif: x * 2 -> x + x (kopyala)
-             * En temiz: sabitten faydalanıp katlama yap.
-             * Burada sağ tarafı 1 yapıp NOT shift,
-             * assembly'de çarpma yerine shl kullanılmasını sağlayamayız.
-             * O yüzden pratik güç azaltma: sabitin 2'nin kuvveti olup olmadığını
-             * işaretle, üretici bunu okusun.
-             * Basit yaklaşım: x * 2 -> x + x */
-
-            /* x + x: sol düğümü kopyalamak yerine, 2'nin kuvveti çarpımları
-             * sabit katlama ile zaten optimize olur. Assembly üreticide
-             * bu bilgiyi kullanmak daha doğru.
-             * Pragmatik çözüm: Sabit katlama yerine bırak, sadece
-             * sağ taraf 1 olan çarpımları optimize et. */
-            /* Basitçe: sag=2 ise sol+sol yap */
-            d->veri.islem.islem = TOK_ARTI;
-            d->çocuklar[1] = d->çocuklar[0]; /* x + x */
-            return;
-        }
-    }
-
-    /* 2 * x -> x + x */
-    if (op == TOK_ÇARPIM && sol->tur == DÜĞÜM_TAM_SAYI && sol->veri.tam_deger == 2) {
+    if (tam_sabit(sag, &v) && v == 2 && sol->tur == DÜĞÜM_TANIMLAYICI) {
         d->veri.islem.islem = TOK_ARTI;
-        d->çocuklar[0] = d->çocuklar[1]; /* x + x */
-        return;
+        d->çocuklar[1] = sol;
+        return 1;
     }
+    if (tam_sabit(sol, &v) && v == 2 && sag->tur == DÜĞÜM_TANIMLAYICI) {
+        d->veri.islem.islem = TOK_ARTI;
+        d->çocuklar[0] = sag;
+        return 1;
+    }
+    return 0;
+}
 
-    /* x / 2 -> sağ kaydırma simülasyonu: bu mevcut AST'de temiz yapılamaz,
-     * bırakıyoruz. Üretici seviyesinde yapılmalı. */
-    (void)sol;
+/* ---- Dal Budama ----
+ * Koşulu sabit olan eğer/yoksa eğer kollarını ve hiç çalışmayan iken
+ * döngülerini kaldırır. eğer düğümü: [koşul, blok, (koşul, blok)*, yoksa?] */
+static int eger_buda(Düğüm *d) {
+    int degisti = 0;
+    int i = 0;
+    while (i + 1 < d->çocuk_sayısı && d->çocuklar[i]->tur != DÜĞÜM_BLOK) {
+        int k;
+        if (!mantik_sabit(d->çocuklar[i], &k)) {
+            i += 2;
+            continue;
+        }
+        if (k) {
+            /* Her zaman doğru: sonraki kollar erişilemez */
+            if (d->çocuk_sayısı > i + 2) {
+                d->çocuk_sayısı = i + 2;
+                degisti = 1;
+            }
+            break;
+        }
+        /* Her zaman yanlış: (koşul, blok) çiftini çıkar */
+        if (i == 0 && d->çocuk_sayısı == 3 && d->çocuklar[2]->tur == DÜĞÜM_BLOK) {
+            /* Geriye yalnızca yoksa bloğu kalıyor: koşulu doğru yap */
+            mantik_yap(d->çocuklar[0], 1);
+            d->çocuklar[1] = d->çocuklar[2];
+            d->çocuk_sayısı = 2;
+            return 1;
+        }
+        cocuk_cikar(d, i);
+        cocuk_cikar(d, i);
+        degisti = 1;
+    }
+    return degisti;
+}
+
+static int dal_buda(Düğüm *d) {
+    int degisti = 0;
+    if (d->tur == DÜĞÜM_EĞER) degisti |= eger_buda(d);
+
+    if (d->tur != DÜĞÜM_BLOK && d->tur != DÜĞÜM_PROGRAM) return degisti;
+    for (int i = 0; i < d->çocuk_sayısı; i++) {
+        Düğüm *c = d->çocuklar[i];
+        int k;
+        int bos_eger = c->tur == DÜĞÜM_EĞER &&
+                       (c->çocuk_sayısı == 0 || c->çocuklar[0]->tur == DÜĞÜM_BLOK);
+        int olu_iken = c->tur == DÜĞÜM_İKEN && c->çocuk_sayısı <= 2 &&
+                       mantik_sabit(c->çocuklar[0], &k) && !k;
+        if (bos_eger || olu_iken) {
+            cocuk_cikar(d, i);
+            i--;
+            degisti = 1;
+        }
+    }
+    return degisti;
 }
 
 /* ---- Ölü Kod Eleme (Dead Code Elimination) ---- */
 
-/* Bir blok içinde DÜĞÜM_DÖNDÜR'dan sonraki ifadeleri kaldır */
-static void olu_kod_ele(Düğüm *d) {
-    if (!d) return;
+/* Bir blok içinde döndür/kır/devam/fırlat'tan sonraki ifadeleri kaldır */
+static int olu_kod_ele(Düğüm *d) {
+    if (d->tur != DÜĞÜM_BLOK && d->tur != DÜĞÜM_PROGRAM) return 0;
+    for (int i = 0; i < d->çocuk_sayısı; i++) {
+        DüğümTürü t = d->çocuklar[i]->tur;
+        if (t == DÜĞÜM_DÖNDÜR || t == DÜĞÜM_KIR ||
+            t == DÜĞÜM_DEVAM || t == DÜĞÜM_FIRLAT) {
+            if (d->çocuk_sayısı > i + 1) {
+                d->çocuk_sayısı = i + 1;
+                return 1;
+            }
+            return 0;
+        }
+    }
+    return 0;
+}
+
+/* ---- Sabit Yayılımı (Constant Propagation) ----
+ * İşlev gövdesinde bir kez, sabit değerle tanımlanıp hiç yeniden
+ * atanmayan tam/mantık yerelin okumaları, tanımın kapsamı içinde değerin
+ * kendisiyle değiştirilir. Aynı ismi bağlayan başka bir yapı (parametre,
+ * döngü değişkeni, yakala değişkeni, yapı bozma hedefi...) varsa yerel
+ * aday olmaz. */
 
-    /* Blok düğümlerinde DONDUR sonrası kodu kaldır */
-    if (d->tur == DÜĞÜM_BLOK || d->tur == DÜĞÜM_PROGRAM) {
+/* Düğümün bağladığı/yazdığı isim (yoksa NULL) */
+static const char *baglanan_isim(Düğüm *d) {
+    switch (d->tur) {
+    case DÜĞÜM_DEĞİŞKEN:
+        return d->veri.değişken.isim;
+    case DÜĞÜM_DÖNGÜ:
+    case DÜĞÜM_HER_İÇİN:
+    case DÜĞÜM_LİSTE_ÜRETİMİ:
+    case DÜĞÜM_SÖZLÜK_ÜRETİMİ:
+        return d->veri.dongu.isim;
+    case DÜĞÜM_ATAMA:
+    case DÜĞÜM_WALRUS:
+    case DÜĞÜM_İLE_İSE:
+    case DÜĞÜM_BLOK:      /* yakala bloğu hata değişkeni */
+        return d->veri.tanimlayici.isim;
+    default:
+        return NULL;
+    }
+}
+
+/* İsmi bağlayan/yazan düğüm sayısı */
+static int baglama_say(Düğüm *d, const char *isim) {
+    if (!d) return 0;
+    int n = 0;
+    const char *b = baglanan_isim(d);
+    if (b && strcmp(b, isim) == 0) n++;
+    if (d->tur == DÜĞÜM_PAKET_AÇ) {
         for (int i = 0; i < d->çocuk_sayısı; i++) {
-            if (d->çocuklar[i]->tur == DÜĞÜM_DÖNDÜR) {
-                /* Bu düğümden sonraki tüm çocukları kaldır */
-                d->çocuk_sayısı = i + 1;
-                break;
+            Düğüm *h = d->çocuklar[i];
+            if (h->tur != DÜĞÜM_TANIMLAYICI || !h->veri.tanimlayici.isim) continue;
+            const char *hi = h->veri.tanimlayici.isim;
+            if (strncmp(hi, "...", 3) == 0) hi += 3;
+            if (strcmp(hi, isim) == 0) n++;
+        }
+    }
+    for (int i = 0; i < d->çocuk_sayısı; i++) {
+        n += baglama_say(d->çocuklar[i], isim);
+    }
+    return n;
+}
+
+static int sabit_yerlestir(Düğüm *d, const char *isim, Düğüm *deger) {
+    if (!d) return 0;
+    if (d->tur == DÜĞÜM_TANIMLAYICI && d->veri.tanimlayici.isim &&
+        strcmp(d->veri.tanimlayici.isim, isim) == 0) {
+        int satir = d->satir, sutun = d->sutun;
+        *d = *deger;
+        d->satir = satir;
+        d->sutun = sutun;
+        return 1;
+    }
+    /* Yapı bozma hedefleri okuma değildir */
+    if (d->tur == DÜĞÜM_PAKET_AÇ) return 0;
+    int n = 0;
+    for (int i = 0; i < d->çocuk_sayısı; i++) {
+        n += sabit_yerlestir(d->çocuklar[i], isim, deger);
+    }
+    return n;
+}
+
+/* govde: işlevin tamamı (bağlama sayımı için), d: taranan alt ağaç */
+static int sabit_yay_blok(Düğüm *govde, Düğüm *d) {
+    if (!d) return 0;
+    int degisti = 0;
+    if (d->tur == DÜĞÜM_BLOK) {
+        for (int i = 0; i < d->çocuk_sayısı; i++) {
+            Düğüm *c = d->çocuklar[i];
+            if (c->tur != DÜĞÜM_DEĞİŞKEN || c->veri.değişken.genel ||
+                !c->veri.değişken.isim || c->çocuk_sayısı != 1) continue;
+            Düğüm *ilk = c->çocuklar[0];
+            TipTürü t = tip_adı_çevir(c->veri.değişken.tip);
+            if (!((t == TİP_TAM && ilk->tur == DÜĞÜM_TAM_SAYI) ||
+                  (t == TİP_MANTIK && ilk->tur == DÜĞÜM_MANTIK_DEĞERİ))) continue;
+            if (baglama_say(govde, c->veri.değişken.isim) != 1) continue;
+            /* Tanımdan sonraki kardeşler = tanımın kapsamı */
+            for (int j = i + 1; j < d->çocuk_sayısı; j++) {
+                degisti |= sabit_yerlestir(d->çocuklar[j], c->veri.değişken.isim, ilk) > 0;
             }
         }
     }
+    for (int i = 0; i < d->çocuk_sayısı; i++) {
+        degisti |= sabit_yay_blok(govde, d->çocuklar[i]);
+    }
+    return degisti;
+}
+
+static int gecis_sabit_yay(Düğüm *d) {
+    if (!d) return 0;
+    /* Program düzeyindeki değişkenler genel: işlevler onları değiştirebilir */
+    if (d->tur == DÜĞÜM_İŞLEV) return sabit_yay_blok(d, d);
+    int degisti = 0;
+    for (int i = 0; i < d->çocuk_sayısı; i++) {
+        Düğüm *c = d->çocuklar[i];
+        if (c->tur == DÜĞÜM_İŞLEV || c->tur == DÜĞÜM_SINIF || c->tur == DÜĞÜM_BLOK ||
+            c->tur == DÜĞÜM_PROGRAM) {
+            degisti |= gecis_sabit_yay(c);
+        }
+    }
+    return degisti;
+}
+
+/* ---- Satır İçi Açma (Inlining) ----
+ * Gövdesi tek bir `döndür ifade` olan üst düzey işlevlere yapılan
+ * çağrılar, parametreler argümanlarla değiştirilmiş ifadenin kopyasıyla
+ * yer değiştirir; ardından sabit katlama açılan ifadeyi sadeleştirir.
+ * Metotlar (x.m(...)) ve al_<alan> okuyucuları (x.alan) da açılır: metot
+ * çağrısı alıcının bildirildiği sınıfa statik bağlandığından sınıf, alıcı
+ * değişkenin bildiriminden (bu için içinde bulunulan sınıftan) bulunur ve
+ * metot ebeveyn zincirinde aranır. Gövde bu.alan ile sınıfın tam/mantık
+ * alanlarını okuyabilir (tek başına döndürülen alan metin de olabilir);
+ * bu, alıcıyla değiştirilir.
+ * Maliyet: ifadenin düğüm sayısı. @satıriçi sınırı kaldırır,
+ * @satıriçi_değil açmayı yasaklar. Tek ifadelik gövdede dene/fırlat
+ * olamaz; lambda, atama ve kendini çağırma aday olmayı engeller, karşılıklı
+ * özyineleme açılmakta olan işlevler yığınıyla kesilir. Argümanlar yan
+ * etkisiz olmalıdır (açılan ifade onları farklı sırada ya da hiç
+ * değerlendirmeyebilir); basit olmayan argüman en çok bir kez kullanılır. */
+
+#define SATIRICI_MALIYET   16
+#define SATIRICI_DERINLIK  4
+#define SATIRICI_MAKS_PARAM 6
+
+#define SATIRICI_MAKS_KALITIM 16
+
+typedef struct {
+    Düğüm *program;
+    Arena *arena;
+    const char *yigin[SATIRICI_DERINLIK];  /* açılmakta olan işlevler */
+    int derinlik;
+    Düğüm *islev;           /* yürünen işlev/metot (üst düzeyde NULL) */
+    Düğüm *sinif;           /* yürünen metodun sınıfı */
+    Düğüm *aday_sinif;      /* aday gövdesi bu sınıfın metodu */
+} Satirici;
+
+static int satirici_tip_uygun(TipTürü t) {
+    return t == TİP_TAM || t == TİP_ONDALIK || t == TİP_MANTIK || t == TİP_METİN;
+}
+
+static Düğüm *dugum_kopyala(Arena *a, Düğüm *d) {
+    Düğüm *k = düğüm_oluştur(a, d->tur, d->satir, d->sutun);
+    *k = *d;
+    k->çocuklar = NULL;
+    k->çocuk_sayısı = 0;
+    k->çocuk_kapasite = 0;
+    for (int i = 0; i < d->çocuk_sayısı; i++) {
+        düğüm_çocuk_ekle(a, k, dugum_kopyala(a, d->çocuklar[i]));
+    }
+    return k;
+}
+
+static int dugum_say(Düğüm *d) {
+    int n = 1;
+    for (int i = 0; i < d->çocuk_sayısı; i++) n += dugum_say(d->çocuklar[i]);
+    return n;
+}
+
+static int param_indeksi(Düğüm *params, const char *isim) {
+    for (int i = 0; i < params->çocuk_sayısı; i++) {
+        if (strcmp(params->çocuklar[i]->veri.değişken.isim, isim) == 0) return i;
+    }
+    return -1;
+}
+
+static int kullanim_say(Düğüm *d, const char *isim) {
+    int n = d->tur == DÜĞÜM_TANIMLAYICI && d->veri.tanimlayici.isim &&
+            strcmp(d->veri.tanimlayici.isim, isim) == 0;
+    for (int i = 0; i < d->çocuk_sayısı; i++) n += kullanim_say(d->çocuklar[i], isim);
+    return n;
+}
+
+/* Üst düzey dışında (metot, iç işlev) bu isimde işlev var mı? */
+static int ic_islev_var(Düğüm *d, const char *isim, int ust_duzey) {
+    if (d->tur == DÜĞÜM_İŞLEV && !ust_duzey && d->veri.islev.isim &&
+        strcmp(d->veri.islev.isim, isim) == 0) return 1;
+    for (int i = 0; i < d->çocuk_sayısı; i++) {
+        if (ic_islev_var(d->çocuklar[i], isim, d->tur == DÜĞÜM_PROGRAM)) return 1;
+    }
+    return 0;
+}
+
+static int genel_degisken_mi(Düğüm *d, const char *isim) {
+    if (d->tur == DÜĞÜM_DEĞİŞKEN && d->veri.değişken.genel && d->veri.değişken.isim &&
+        strcmp(d->veri.değişken.isim, isim) == 0) return 1;
+    for (int i = 0; i < d->çocuk_sayısı; i++) {
+        if (genel_degisken_mi(d->çocuklar[i], isim)) return 1;
+    }
+    return 0;
+}
+
+/* İsim her yerde aynı üst düzey işlevi mi gösteriyor? (gölgelenmemiş) */
+static int islev_ismi_tekil(Satirici *s, const char *isim) {
+    return baglama_say(s->program, isim) == 0 && !ic_islev_var(s->program, isim, 0);
+}
+
+static Düğüm *ust_islev_bul(Satirici *s, const char *isim) {
+    Düğüm *bulunan = NULL;
+    for (int i = 0; i < s->program->çocuk_sayısı; i++) {
+        Düğüm *c = s->program->çocuklar[i];
+        const char *ci = c->tur == DÜĞÜM_İŞLEV ? c->veri.islev.isim :
+                         c->tur == DÜĞÜM_SINIF ? c->veri.sinif.isim : NULL;
+        if (!ci || strcmp(ci, isim) != 0) continue;
+        if (bulunan || c->tur != DÜĞÜM_İŞLEV) return NULL;
+        bulunan = c;
+    }
+    return bulunan;
+}
+
+static Düğüm *sinif_dugumu(Satirici *s, const char *isim) {
+    if (!isim) return NULL;
+    for (int i = 0; i < s->program->çocuk_sayısı; i++) {
+        Düğüm *c = s->program->çocuklar[i];
+        if (c->tur == DÜĞÜM_SINIF && c->veri.sinif.isim &&
+            strcmp(c->veri.sinif.isim, isim) == 0)
+            return c->veri.sinif.tip_parametre ? NULL : c;
+    }
+    return NULL;
+}
+
+/* Sınıfta ya da ebeveynlerinde bu türden üyeyi bul (ilk bulunan: en alttaki) */
+static Düğüm *sinif_uyesi(Satirici *s, Düğüm *sinif, const char *isim, DüğümTürü tur) {
+    for (int k = 0; sinif && k < SATIRICI_MAKS_KALITIM; k++) {
+        for (int i = 0; i < sinif->çocuk_sayısı; i++) {
+            Düğüm *c = sinif->çocuklar[i];
+            const char *ci = c->tur == DÜĞÜM_İŞLEV ? c->veri.islev.isim :
+                             c->tur == DÜĞÜM_DEĞİŞKEN ? c->veri.değişken.isim : NULL;
+            if (c->tur == tur && ci && strcmp(ci, isim) == 0) return c;
+        }
+        sinif = sinif_dugumu(s, sinif->veri.sinif.ebeveyn);
+    }
+    return NULL;
+}
+
+static int sinif_uyesi_kendi(Düğüm *sinif, Düğüm *uye) {
+    for (int i = 0; i < sinif->çocuk_sayısı; i++) {
+        if (sinif->çocuklar[i] == uye) return 1;
+    }
+    return 0;
+}
+
+/* Gövdede okunabilen alan: bu.alan, statik olmayan, tipi uygun */
+static TipTürü bu_alan_tipi(Satirici *s, Düğüm *d) {
+    if (!s->aday_sinif || d->tur != DÜĞÜM_ERİŞİM || d->çocuk_sayısı != 1 ||
+        !d->veri.tanimlayici.isim) return TİP_BİLİNMİYOR;
+    Düğüm *n = d->çocuklar[0];
+    if (n->tur != DÜĞÜM_TANIMLAYICI || !n->veri.tanimlayici.isim ||
+        strcmp(n->veri.tanimlayici.isim, "bu") != 0) return TİP_BİLİNMİYOR;
+    Düğüm *alan = sinif_uyesi(s, s->aday_sinif, d->veri.tanimlayici.isim, DÜĞÜM_DEĞİŞKEN);
+    if (!alan || alan->veri.değişken.statik || !alan->veri.değişken.tip) return TİP_BİLİNMİYOR;
+    return tip_adı_çevir(alan->veri.değişken.tip);
+}
+
+/* Bölgedeki isim bildirimlerinin ortak tipi; iç işlev/sınıflara inilmez.
+ * Döngü değişkeni gibi başka bir bağlama varsa çelişki (*tip = ""). */
+static void bildirim_tipi(Düğüm *d, const char *isim, const char **tip, int kok) {
+    if (!kok && (d->tur == DÜĞÜM_İŞLEV || d->tur == DÜĞÜM_SINIF)) return;
+    const char *b = baglanan_isim(d);
+    if (b && strcmp(b, isim) == 0 && d->tur != DÜĞÜM_ATAMA) {
+        const char *t = d->tur == DÜĞÜM_DEĞİŞKEN ? d->veri.değişken.tip : NULL;
+        if (!t || (*tip && strcmp(*tip, t) != 0)) *tip = "";
+        else *tip = t;
+    }
+    if (d->tur == DÜĞÜM_PAKET_AÇ && baglama_say(d, isim) > 0) *tip = "";
+    for (int i = 0; i < d->çocuk_sayısı; i++) bildirim_tipi(d->çocuklar[i], isim, tip, 0);
+}
+
+/* Alıcı değişkenin sınıfı: önce yürünen işlevde, yoksa üst düzeyde */
+static Düğüm *alici_sinifi(Satirici *s, Düğüm *alici) {
+    if (alici->tur != DÜĞÜM_TANIMLAYICI || !alici->veri.tanimlayici.isim) return NULL;
+    const char *isim = alici->veri.tanimlayici.isim;
+    if (strcmp(isim, "bu") == 0) return s->islev ? s->sinif : NULL;
+    const char *tip = NULL;
+    if (s->islev) bildirim_tipi(s->islev, isim, &tip, 1);
+    if (!tip) bildirim_tipi(s->program, isim, &tip, 1);
+    return tip ? sinif_dugumu(s, tip) : NULL;
+}
+
+/* Gövde ifadesi açılabilir mi? Tanımlayıcılar yalnızca parametre olabilir */
+static int govde_uygun(Satirici *s, Düğüm *d, Düğüm *params, const char *kendi,
+                       int *cagri_var) {
+    switch (d->tur) {
+    case DÜĞÜM_TAM_SAYI:
+    case DÜĞÜM_ONDALIK_SAYI:
+    case DÜĞÜM_METİN_DEĞERİ:
+    case DÜĞÜM_MANTIK_DEĞERİ:
+        return 1;
+    case DÜĞÜM_TANIMLAYICI:
+        return d->veri.tanimlayici.isim &&
+               param_indeksi(params, d->veri.tanimlayici.isim) >= 0;
+    case DÜĞÜM_ERİŞİM: {
+        TipTürü t = bu_alan_tipi(s, d);
+        return t == TİP_TAM || t == TİP_MANTIK;
+    }
+    case DÜĞÜM_İKİLİ_İŞLEM:
+    case DÜĞÜM_TEKLİ_İŞLEM:
+    case DÜĞÜM_ÜÇLÜ:
+        break;
+    case DÜĞÜM_ÇAĞRI: {
+        const char *isim = d->veri.tanimlayici.isim;
+        if (!isim || d->veri.tanimlayici.cagri_tip_parametre) return 0;
+        *cagri_var = 1;
+        if (d->veri.tanimlayici.tip) {
+            /* Yalnızca metin parametresi üzerinde yerleşik metotlar */
+            if (strcmp(d->veri.tanimlayici.tip, "metot") != 0 || d->çocuk_sayısı == 0 ||
+                d->çocuklar[0]->sonuç_tipi != TİP_METİN) return 0;
+        } else if (strcmp(isim, kendi) == 0 || !islev_ismi_tekil(s, isim)) {
+            return 0;
+        }
+        break;
+    }
+    default:
+        return 0;
+    }
+    for (int i = 0; i < d->çocuk_sayısı; i++) {
+        if (!govde_uygun(s, d->çocuklar[i], params, kendi, cagri_var)) return 0;
+    }
+    return 1;
+}
+
+/* İşlev aday ise döndürdüğü ifadeyi ver */
+static Düğüm *satirici_aday(Satirici *s, Düğüm *fn, int *cagri_var) {
+    int ipucu = satirici_ipucu(fn->veri.islev.dekorator);
+    if (fn->veri.islev.dekorator && ipucu <= 0) return NULL;
+    int zorla = ipucu > 0;
+    if (fn->veri.islev.tip_parametre || fn->veri.islev.eszamansiz ||
+        fn->veri.islev.variadic || fn->veri.islev.soyut || fn->veri.islev.statik) return NULL;
+    if (!fn->veri.islev.dönüş_tipi ||
+        !satirici_tip_uygun(tip_adı_çevir(fn->veri.islev.dönüş_tipi))) return NULL;
+    if (fn->çocuk_sayısı < 2) return NULL;
+    Düğüm *params = fn->çocuklar[0], *govde = fn->çocuklar[1];
+    if (params->çocuk_sayısı > SATIRICI_MAKS_PARAM) return NULL;
+    for (int i = 0; i < params->çocuk_sayısı; i++) {
+        Düğüm *p = params->çocuklar[i];
+        if (!p->veri.değişken.isim || !p->veri.değişken.tip ||
+            !satirici_tip_uygun(tip_adı_çevir(p->veri.değişken.tip))) return NULL;
+    }
+    if (govde->tur != DÜĞÜM_BLOK || govde->çocuk_sayısı != 1) return NULL;
+    Düğüm *don = govde->çocuklar[0];
+    if (don->tur != DÜĞÜM_DÖNDÜR || don->çocuk_sayısı != 1) return NULL;
+    Düğüm *ifade = don->çocuklar[0];
+    TipTürü donus = tip_adı_çevir(fn->veri.islev.dönüş_tipi);
+    /* Tek başına döndürülen alan: tipi alanın bildiriminden */
+    TipTürü alan = bu_alan_tipi(s, ifade);
+    if (alan != TİP_BİLİNMİYOR) return alan == donus && alan != TİP_ONDALIK ? ifade : NULL;
+    /* Alan okuyan işlemler analizde tiplenmez; alanlar tam/mantık olduğundan
+     * tam sonuçlu gövde kabul edilir, tip açılınca verilir */
+    if (ifade->sonuç_tipi != (int)donus &&
+        !(s->aday_sinif && donus == TİP_TAM && ifade->sonuç_tipi == TİP_BİLİNMİYOR))
+        return NULL;
+    if (!zorla && dugum_say(ifade) > SATIRICI_MALIYET) return NULL;
+    *cagri_var = 0;
+    if (!govde_uygun(s, ifade, params, fn->veri.islev.isim, cagri_var)) return NULL;
+    return ifade;
+}
+
+/* Yan etkisiz, hata fırlatmayan argüman (bölme ve indeksleme hariç) */
+static int saf_arguman(Düğüm *d) {
+    switch (d->tur) {
+    case DÜĞÜM_TAM_SAYI:
+    case DÜĞÜM_ONDALIK_SAYI:
+    case DÜĞÜM_METİN_DEĞERİ:
+    case DÜĞÜM_MANTIK_DEĞERİ:
+    case DÜĞÜM_TANIMLAYICI:
+        return 1;
+    case DÜĞÜM_İKİLİ_İŞLEM:
+        if (d->veri.islem.islem == TOK_BÖLME || d->veri.islem.islem == TOK_YÜZDE) return 0;
+        break;
+    case DÜĞÜM_TEKLİ_İŞLEM:
+    case DÜĞÜM_ÜÇLÜ:
+        break;
+    default:
+        return 0;
+    }
+    for (int i = 0; i < d->çocuk_sayısı; i++) {
+        if (!saf_arguman(d->çocuklar[i])) return 0;
+    }
+    return 1;
+}
+
+static void parametre_yerlestir(Arena *a, Düğüm *d, Düğüm *params, Düğüm **args,
+                                Düğüm *alici) {
+    if (d->tur == DÜĞÜM_TANIMLAYICI) {
+        int i = param_indeksi(params, d->veri.tanimlayici.isim);
+        Düğüm *k = dugum_kopyala(a, i >= 0 ? args[i] : alici);
+        k->satir = d->satir;
+        k->sutun = d->sutun;
+        *d = *k;
+        return;
+    }
+    for (int i = 0; i < d->çocuk_sayısı; i++) {
+        parametre_yerlestir(a, d->çocuklar[i], params, args, alici);
+    }
+}
+
+static int satirici_yuru(Satirici *s, Düğüm *d);
+
+/* fn'nin gövdesini d'nin yerine aç. Metotta sinif fn'nin bulunduğu sınıf,
+ * alici bu'nun yerine geçen değişkendir. */
+static int govde_ac(Satirici *s, Düğüm *d, Düğüm *fn, Düğüm *sinif, Düğüm *alici,
+                    Düğüm **args, int arg_sayisi) {
+    const char *isim = fn->veri.islev.isim;
+    if (s->derinlik >= SATIRICI_DERINLIK) return 0;
+    for (int i = 0; i < s->derinlik; i++) {
+        if (strcmp(s->yigin[i], isim) == 0) return 0;
+    }
+    int cagri_var;
+    s->aday_sinif = sinif;
+    Düğüm *ifade = satirici_aday(s, fn, &cagri_var);
+    s->aday_sinif = NULL;
+    if (!ifade) return 0;
+    TipTürü donus = tip_adı_çevir(fn->veri.islev.dönüş_tipi);
+    Düğüm *params = fn->çocuklar[0];
+    if (arg_sayisi != params->çocuk_sayısı) return 0;
+    /* Okuyucu erişimi (x.alan) ve bu.m() analizde tiplenmeyebilir; o
+     * durumda yalnızca tam/mantık */
+    if (d->sonuç_tipi != (int)donus &&
+        !((d->tur == DÜĞÜM_ERİŞİM || d->sonuç_tipi == TİP_BİLİNMİYOR) &&
+          (donus == TİP_TAM || donus == TİP_MANTIK))) return 0;
+    if (alici && cagri_var && genel_degisken_mi(s->program, alici->veri.tanimlayici.isim))
+        return 0;
+
+    for (int i = 0; i < arg_sayisi; i++) {
+        Düğüm *arg = args[i];
+        Düğüm *p = params->çocuklar[i];
+        if (arg->sonuç_tipi != (int)tip_adı_çevir(p->veri.değişken.tip)) return 0;
+        if (!saf_arguman(arg)) return 0;
+        int kullanim = kullanim_say(ifade, p->veri.değişken.isim);
+        if (arg->tur == DÜĞÜM_TANIMLAYICI) {
+            /* Gövdedeki çağrılar genel değişkeni değiştirebilir */
+            if (cagri_var && genel_degisken_mi(s->program, arg->veri.tanimlayici.isim))
+                return 0;
+        } else if (arg->çocuk_sayısı > 0 && kullanim > 1) {
+            return 0;
+        }
+    }
+
+    Düğüm *yeni = dugum_kopyala(s->arena, ifade);
+    parametre_yerlestir(s->arena, yeni, params, args, alici);
+    yeni->satir = d->satir;
+    yeni->sutun = d->sutun;
+    if (yeni->tur == DÜĞÜM_ERİŞİM || yeni->sonuç_tipi == TİP_BİLİNMİYOR) yeni->sonuç_tipi = donus;
+    *d = *yeni;
+
+    /* Açılan ifadedeki çağrılar */
+    s->yigin[s->derinlik++] = isim;
+    satirici_yuru(s, d);
+    s->derinlik--;
+    return 1;
+}
+
+/* Çağrıyı açabiliyorsa d'yi yerinde açılmış ifadeye çevir */
+static int cagri_ac(Satirici *s, Düğüm *d) {
+    const char *isim = d->veri.tanimlayici.isim;
+    if (d->tur != DÜĞÜM_ÇAĞRI || !isim || d->veri.tanimlayici.cagri_tip_parametre) return 0;
+    if (d->veri.tanimlayici.tip) {
+        /* Metot: x.m(args), alıcı ilk çocuk */
+        if (strcmp(d->veri.tanimlayici.tip, "metot") != 0 || d->çocuk_sayısı == 0) return 0;
+        Düğüm *alici = d->çocuklar[0];
+        Düğüm *sinif = alici_sinifi(s, alici);
+        Düğüm *fn = sinif ? sinif_uyesi(s, sinif, isim, DÜĞÜM_İŞLEV) : NULL;
+        if (!fn) return 0;
+        Düğüm *sahip = sinif;
+        while (sahip && !sinif_uyesi_kendi(sahip, fn)) sahip = sinif_dugumu(s, sahip->veri.sinif.ebeveyn);
+        return sahip && govde_ac(s, d, fn, sahip, alici, d->çocuklar + 1, d->çocuk_sayısı - 1);
+    }
+    Düğüm *fn = ust_islev_bul(s, isim);
+    if (!fn || !islev_ismi_tekil(s, isim)) return 0;
+    return govde_ac(s, d, fn, NULL, NULL, d->çocuklar, d->çocuk_sayısı);
+}
+
+/* Okuyucu: alanı olmayan x.alan, x'in sınıfındaki al_alan metodunu çağırır */
+static int okuyucu_ac(Satirici *s, Düğüm *d) {
+    if (d->çocuk_sayısı != 1 || !d->veri.tanimlayici.isim) return 0;
+    Düğüm *alici = d->çocuklar[0];
+    Düğüm *sinif = alici_sinifi(s, alici);
+    if (!sinif || sinif_uyesi(s, sinif, d->veri.tanimlayici.isim, DÜĞÜM_DEĞİŞKEN)) return 0;
+    char okuyucu[256];
+    snprintf(okuyucu, sizeof(okuyucu), "al_%s", d->veri.tanimlayici.isim);
+    Düğüm *fn = sinif_uyesi(s, sinif, okuyucu, DÜĞÜM_İŞLEV);
+    if (!fn) return 0;
+    Düğüm *sahip = sinif;
+    while (sahip && !sinif_uyesi_kendi(sahip, fn)) sahip = sinif_dugumu(s, sahip->veri.sinif.ebeveyn);
+    return sahip && govde_ac(s, d, fn, sahip, alici, NULL, 0);
+}
+
+static int satirici_yuru(Satirici *s, Düğüm *d) {
+    if (!d) return 0;
+    /* Generic gövdeler özelleştirilirken yeniden tiplenir */
+    if (d->tur == DÜĞÜM_İŞLEV && d->veri.islev.tip_parametre) return 0;
+    if (d->tur == DÜĞÜM_SINIF && d->veri.sinif.tip_parametre) return 0;
+    Düğüm *islev = s->islev, *sinif = s->sinif;
+    if (d->tur == DÜĞÜM_SINIF) s->sinif = d;
+    if (d->tur == DÜĞÜM_İŞLEV) {
+        /* İşlev içindeki işlevde bu yoktur */
+        if (islev) s->sinif = NULL;
+        s->islev = d;
+    }
+    int degisti = 0;
+    for (int i = 0; i < d->çocuk_sayısı; i++) {
+        degisti |= satirici_yuru(s, d->çocuklar[i]);
+    }
+    s->islev = islev;
+    s->sinif = sinif;
+    if (d->tur == DÜĞÜM_ÇAĞRI) degisti |= cagri_ac(s, d);
+    else if (d->tur == DÜĞÜM_ERİŞİM) degisti |= okuyucu_ac(s, d);
+    return degisti;
+}
+
+static int gecis_satirici(Düğüm *program, Arena *arena) {
+    Satirici s;
+    memset(&s, 0, sizeof(s));
+    s.program = program;
+    s.arena = arena;
+    return satirici_yuru(&s, program);
+}
+
+/* ---- Değer Numaralama (GVN) ve Döngüden Çıkarma (LICM) ----
+ * Ağaçta geçici değer yoktur: ikisi de paylaşılan değeri işlev gövdesine
+ * eklenen bir `tam` yerelde tutar (gvn.N / licm.N; nokta kullanıcı
+ * isimlerinde olamaz). Aday ifade yan etkisiz ve hata fırlatmaz: tam
+ * sabitler, görünür tam yereller/parametreler ve + - * & | ^ << >> ile
+ * tekli - ~ (bölme sıfırda hata verir, karşılaştırma mantık döndürür).
+ * Yapısal olarak eşit iki aday, işlenenleri arada yazılmadıkça aynı
+ * değeri verir. Erken hesaplamak güvenlidir; en kötü durumda kullanılmayan
+ * bir değer hesaplanır. Yakalanan değerler kapanışa kopyalandığından
+ * çağrılar yerelleri değiştiremez; üst düzey (genel) kod ele alınmaz. */
+
+#define DN_MAKS_GORUNUR 256
+
+typedef struct {
+    Arena *arena;
+    Düğüm *islev;
+    const char *gorunur[DN_MAKS_GORUNUR];  /* kapsamdaki tam yereller */
+    int gorunur_sayisi;
+} DegerNo;
+
+static void dn_gorunur_ekle(DegerNo *n, const char *isim) {
+    if (isim && n->gorunur_sayisi < DN_MAKS_GORUNUR) n->gorunur[n->gorunur_sayisi++] = isim;
+}
+
+static int dn_gorunur_mu(DegerNo *n, const char *isim) {
+    for (int i = n->gorunur_sayisi - 1; i >= 0; i--) {
+        if (strcmp(n->gorunur[i], isim) == 0) return 1;
+    }
+    return 0;
+}
+
+static int dn_islem_uygun(SözcükTürü op) {
+    switch (op) {
+    case TOK_ARTI: case TOK_EKSI: case TOK_ÇARPIM:
+    case TOK_BİT_VE: case TOK_BİT_VEYA: case TOK_BİT_XOR:
+    case TOK_SOL_KAYDIR: case TOK_SAĞ_KAYDIR:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+/* Aday ifadenin parçası olabilir mi? (işlem içermesi ayrıca aranır) */
+static int dn_saf(DegerNo *n, Düğüm *d) {
+    switch (d->tur) {
+    case DÜĞÜM_TAM_SAYI:
+        return 1;
+    case DÜĞÜM_TANIMLAYICI:
+        return d->veri.tanimlayici.isim && dn_gorunur_mu(n, d->veri.tanimlayici.isim);
+    case DÜĞÜM_İKİLİ_İŞLEM:
+        if (d->çocuk_sayısı != 2 || d->sonuç_tipi != TİP_TAM ||
+            !dn_islem_uygun(d->veri.islem.islem)) return 0;
+        return dn_saf(n, d->çocuklar[0]) && dn_saf(n, d->çocuklar[1]);
+    case DÜĞÜM_TEKLİ_İŞLEM:
+        if (d->çocuk_sayısı != 1 || d->sonuç_tipi != TİP_TAM ||
+            (d->veri.islem.islem != TOK_EKSI && d->veri.islem.islem != TOK_BİT_DEĞİL)) return 0;
+        return dn_saf(n, d->çocuklar[0]);
+    default:
+        return 0;
+    }
+}
+
+static int dn_tanimlayici_var(Düğüm *d) {
+    if (d->tur == DÜĞÜM_TANIMLAYICI) return 1;
+    for (int i = 0; i < d->çocuk_sayısı; i++) {
+        if (dn_tanimlayici_var(d->çocuklar[i])) return 1;
+    }
+    return 0;
+}
+
+/* Tümü sabit olan ifadeyi katlama halleder */
+static int dn_aday(DegerNo *n, Düğüm *d) {
+    return (d->tur == DÜĞÜM_İKİLİ_İŞLEM || d->tur == DÜĞÜM_TEKLİ_İŞLEM) &&
+           dn_saf(n, d) && dn_tanimlayici_var(d);
+}
+
+/* Değer numarası eşitliği: yapısal, değişmeli işlemlerde sıra önemsiz */
+static int dn_esit(Düğüm *a, Düğüm *b) {
+    if (a->tur != b->tur || a->çocuk_sayısı != b->çocuk_sayısı) return 0;
+    switch (a->tur) {
+    case DÜĞÜM_TAM_SAYI:
+        return a->veri.tam_deger == b->veri.tam_deger;
+    case DÜĞÜM_TANIMLAYICI:
+        return strcmp(a->veri.tanimlayici.isim, b->veri.tanimlayici.isim) == 0;
+    case DÜĞÜM_TEKLİ_İŞLEM:
+        return a->veri.islem.islem == b->veri.islem.islem &&
+               dn_esit(a->çocuklar[0], b->çocuklar[0]);
+    case DÜĞÜM_İKİLİ_İŞLEM: {
+        SözcükTürü op = a->veri.islem.islem;
+        if (op != b->veri.islem.islem) return 0;
+        if (dn_esit(a->çocuklar[0], b->çocuklar[0]) && dn_esit(a->çocuklar[1], b->çocuklar[1]))
+            return 1;
+        return op != TOK_EKSI && op != TOK_SOL_KAYDIR && op != TOK_SAĞ_KAYDIR &&
+               dn_esit(a->çocuklar[0], b->çocuklar[1]) && dn_esit(a->çocuklar[1], b->çocuklar[0]);
+    }
+    default:
+        return 0;
+    }
+}
+
+/* Kapanış, iç işlev ve sınıf gövdeleri ayrı kapsamdır: içlerine girilmez */
+static int dn_ayri_kapsam(Düğüm *d) {
+    return d->tur == DÜĞÜM_LAMBDA || d->tur == DÜĞÜM_İŞLEV || d->tur == DÜĞÜM_SINIF;
+}
+
+static int dn_say(Düğüm *d, Düğüm *ifade) {
+    if (dn_ayri_kapsam(d)) return 0;
+    if (dn_esit(d, ifade)) return 1;
+    int k = 0;
+    for (int i = 0; i < d->çocuk_sayısı; i++) k += dn_say(d->çocuklar[i], ifade);
+    return k;
+}
+
+static void dn_degistir(Düğüm *d, Düğüm *ifade, const char *isim) {
+    if (dn_ayri_kapsam(d)) return;
+    if (dn_esit(d, ifade)) {
+        d->tur = DÜĞÜM_TANIMLAYICI;
+        memset(&d->veri, 0, sizeof(d->veri));
+        d->veri.tanimlayici.isim = (char *)isim;
+        d->çocuk_sayısı = 0;
+        d->sonuç_tipi = TİP_TAM;
+        return;
+    }
+    for (int i = 0; i < d->çocuk_sayısı; i++) dn_degistir(d->çocuklar[i], ifade, isim);
+}
+
+/* İfadenin tanımlayıcılarından biri d içinde bağlanıyor/yazılıyor mu? */
+static int dn_yaziliyor(Düğüm *d, Düğüm *ifade) {
+    if (ifade->tur == DÜĞÜM_TANIMLAYICI) return baglama_say(d, ifade->veri.tanimlayici.isim) > 0;
+    for (int i = 0; i < ifade->çocuk_sayısı; i++) {
+        if (dn_yaziliyor(d, ifade->çocuklar[i])) return 1;
+    }
+    return 0;
+}
+
+/* blok'un i. çocuğundan önce `tam <onek>.N = ifade` ekle, ismi döndür */
+static const char *dn_gecici_ekle(DegerNo *n, Düğüm *blok, int i, const char *onek,
+                                  Düğüm *ifade) {
+    char isim[32];
+    int no = 0;
+    do {
+        snprintf(isim, sizeof(isim), "%s.%d", onek, no++);
+    } while (baglama_say(n->islev, isim) > 0);
+    Düğüm *t = düğüm_oluştur(n->arena, DÜĞÜM_DEĞİŞKEN, ifade->satir, ifade->sutun);
+    t->veri.değişken.isim = arena_strdup(n->arena, isim);
+    t->veri.değişken.tip = arena_strdup(n->arena, "tam");
+    t->sonuç_tipi = TİP_TAM;
+    düğüm_çocuk_ekle(n->arena, t, dugum_kopyala(n->arena, ifade));
+    düğüm_çocuk_ekle(n->arena, blok, t);
+    for (int j = blok->çocuk_sayısı - 1; j > i; j--) blok->çocuklar[j] = blok->çocuklar[j - 1];
+    blok->çocuklar[i] = t;
+    dn_gorunur_ekle(n, t->veri.değişken.isim);
+    return t->veri.değişken.isim;
+}
+
+/* GVN: blok'un i. bildirimindeki adaylar, işlenenleri yazılana kadarki
+ * kardeşlerde yeniden geçiyorsa bir kez hesaplanır. Büyük ifade önce
+ * denenir; paylaşılmıyorsa alt ifadelerine inilir. */
+static int dn_gvn_ifade(DegerNo *n, Düğüm *blok, int *i, Düğüm *d) {
+    if (dn_ayri_kapsam(d)) return 0;
+    if (dn_aday(n, d) && !dn_yaziliyor(blok->çocuklar[*i], d)) {
+        int son = *i + 1;
+        while (son < blok->çocuk_sayısı && !dn_yaziliyor(blok->çocuklar[son], d)) son++;
+        int k = 0;
+        for (int j = *i; j < son; j++) k += dn_say(blok->çocuklar[j], d);
+        if (k >= 2) {
+            Düğüm *ifade = dugum_kopyala(n->arena, d);
+            const char *isim = dn_gecici_ekle(n, blok, *i, "gvn", ifade);
+            (*i)++;
+            son++;
+            for (int j = *i; j < son; j++) dn_degistir(blok->çocuklar[j], ifade, isim);
+            return 1;
+        }
+    }
+    int degisti = 0;
+    for (int c = 0; c < d->çocuk_sayısı; c++) {
+        /* İç bloklar kendi bildirim listeleriyle ayrıca işlenir */
+        if (d->çocuklar[c]->tur == DÜĞÜM_BLOK) continue;
+        degisti |= dn_gvn_ifade(n, blok, i, d->çocuklar[c]);
+    }
+    return degisti;
+}
+
+/* LICM: döngüde yazılmayan tanımlayıcılardan oluşan adaylar döngüden
+ * önce bir kez hesaplanır (döngü değişkeni döngü düğümünce bağlanır). */
+static int dn_licm_ifade(DegerNo *n, Düğüm *blok, int *i, Düğüm *dongu, Düğüm *d) {
+    if (dn_ayri_kapsam(d)) return 0;
+    if (dn_aday(n, d) && !dn_yaziliyor(dongu, d)) {
+        Düğüm *ifade = dugum_kopyala(n->arena, d);
+        const char *isim = dn_gecici_ekle(n, blok, *i, "licm", ifade);
+        (*i)++;
+        dn_degistir(dongu, ifade, isim);
+        return 1;
+    }
+    int degisti = 0;
+    for (int c = 0; c < d->çocuk_sayısı; c++) {
+        degisti |= dn_licm_ifade(n, blok, i, dongu, d->çocuklar[c]);
+    }
+    return degisti;
 }
 
-/* ---- Özyinelemeli AST Yürüyüşü ---- */
+static int dn_licm_dongu(DegerNo *n, Düğüm *blok, int *i) {
+    Düğüm *d = blok->çocuklar[*i];
+    int degisti = 0;
+    switch (d->tur) {
+    case DÜĞÜM_İKEN:
+        /* [koşul, gövde, yoksa?]: yoksa bir kez çalışır */
+        for (int c = 0; c < 2 && c < d->çocuk_sayısı; c++)
+            degisti |= dn_licm_ifade(n, blok, i, d, d->çocuklar[c]);
+        break;
+    case DÜĞÜM_DÖNGÜ:
+    case DÜĞÜM_HER_İÇİN:
+        /* Sınırlar/dizi bir kez hesaplanır: yalnızca gövde */
+        if (d->çocuk_sayısı > 0)
+            degisti |= dn_licm_ifade(n, blok, i, d, d->çocuklar[d->çocuk_sayısı - 1]);
+        break;
+    default:
+        break;
+    }
+    return degisti;
+}
+
+static int dn_blok(DegerNo *n, Düğüm *blok, int licm);
+
+/* Bildirimin iç bloklarını işle; döngü değişkeni gövdede görünür */
+static int dn_ic_bloklar(DegerNo *n, Düğüm *d, int licm) {
+    if (dn_ayri_kapsam(d)) return 0;
+    if (d->tur == DÜĞÜM_BLOK) return dn_blok(n, d, licm);
+    int onceki = n->gorunur_sayisi;
+    if (d->tur == DÜĞÜM_DÖNGÜ) dn_gorunur_ekle(n, d->veri.dongu.isim);
+    int degisti = 0;
+    for (int i = 0; i < d->çocuk_sayısı; i++) degisti |= dn_ic_bloklar(n, d->çocuklar[i], licm);
+    n->gorunur_sayisi = onceki;
+    return degisti;
+}
 
-static void optimize_dugum(Düğüm *d) {
-    if (!d) return;
+static int dn_blok(DegerNo *n, Düğüm *blok, int licm) {
+    int onceki = n->gorunur_sayisi;
+    int degisti = 0;
+    for (int i = 0; i < blok->çocuk_sayısı; i++) {
+        if (licm) degisti |= dn_licm_dongu(n, blok, &i);
+        else degisti |= dn_gvn_ifade(n, blok, &i, blok->çocuklar[i]);
+        Düğüm *c = blok->çocuklar[i];
+        degisti |= dn_ic_bloklar(n, c, licm);
+        /* Tanım kendi ilk değerinden sonra görünür */
+        if (c->tur == DÜĞÜM_DEĞİŞKEN && !c->veri.değişken.genel &&
+            tip_adı_çevir(c->veri.değişken.tip) == TİP_TAM) {
+            dn_gorunur_ekle(n, c->veri.değişken.isim);
+        }
+    }
+    n->gorunur_sayisi = onceki;
+    return degisti;
+}
 
-    /* Önce çocukları optimize et (alt-yukarı) */
+static int dn_yuru(Arena *arena, Düğüm *d, int licm) {
+    if (!d) return 0;
+    /* Generic gövdeler özelleştirilirken yeniden tiplenir */
+    if (d->tur == DÜĞÜM_İŞLEV && d->veri.islev.tip_parametre) return 0;
+    if (d->tur == DÜĞÜM_SINIF && d->veri.sinif.tip_parametre) return 0;
+    int degisti = 0;
+    if (d->tur == DÜĞÜM_İŞLEV && d->çocuk_sayısı > 1 && d->çocuklar[1]->tur == DÜĞÜM_BLOK) {
+        DegerNo n;
+        memset(&n, 0, sizeof(n));
+        n.arena = arena;
+        n.islev = d;
+        Düğüm *params = d->çocuklar[0];
+        for (int i = 0; i < params->çocuk_sayısı; i++) {
+            Düğüm *p = params->çocuklar[i];
+            if (tip_adı_çevir(p->veri.değişken.tip) == TİP_TAM) dn_gorunur_ekle(&n, p->veri.değişken.isim);
+        }
+        degisti |= dn_blok(&n, d->çocuklar[1], licm);
+    }
+    /* İç işlevler ve metotlar kendi gövdeleriyle */
     for (int i = 0; i < d->çocuk_sayısı; i++) {
-        optimize_dugum(d->çocuklar[i]);
+        Düğüm *c = d->çocuklar[i];
+        if (c->tur == DÜĞÜM_LAMBDA) continue;
+        degisti |= dn_yuru(arena, c, licm);
     }
+    return degisti;
+}
+
+static int gecis_gvn(Düğüm *p, Arena *a)  { return dn_yuru(a, p, 0); }
+static int gecis_licm(Düğüm *p, Arena *a) { return dn_yuru(a, p, 1); }
 
-    /* Sabit katlama */
-    sabit_katla(d);
+/* ---- Geçiş Yöneticisi ---- */
 
-    /* Güç azaltma (sabit katlama'dan sonra, kalan çarpımlar için) */
-    guc_azalt(d);
+typedef int (*DugumGecisFn)(Düğüm *d);
 
-    /* Ölü kod eleme */
-    olu_kod_ele(d);
+/* Alt-yukarı yürüyüş: önce çocuklar, sonra düğümün kendisi */
+static int dugum_gecis_uygula(Düğüm *d, DugumGecisFn fn) {
+    if (!d) return 0;
+    int degisti = 0;
+    for (int i = 0; i < d->çocuk_sayısı; i++) {
+        degisti |= dugum_gecis_uygula(d->çocuklar[i], fn);
+    }
+    degisti |= fn(d);
+    return degisti;
 }
 
-void optimize_et(Düğüm *program) {
+static int gecis_sabit_katla(Düğüm *p, Arena *a) { (void)a; return dugum_gecis_uygula(p, sabit_katla); }
+static int gecis_sabit_yayil(Düğüm *p, Arena *a) { (void)a; return gecis_sabit_yay(p); }
+static int gecis_dal_buda(Düğüm *p, Arena *a)    { (void)a; return dugum_gecis_uygula(p, dal_buda); }
+static int gecis_olu_kod(Düğüm *p, Arena *a)     { (void)a; return dugum_gecis_uygula(p, olu_kod_ele); }
+
+typedef struct {
+    const char *isim;
+    int (*calistir)(Düğüm *program, Arena *arena);
+} OptGecis;
+
+/* LICM ve GVN, katlama ve budama ağacı sadeleştirdikten sonra çalışır */
+static const OptGecis gecisler[] = {
+    { "sabit-katlama",  gecis_sabit_katla },
+    { "sabit-yayilim",  gecis_sabit_yayil },
+    { "dal-budama",     gecis_dal_buda },
+    { "olu-kod",        gecis_olu_kod },
+    { "licm",           gecis_licm },
+    { "gvn",            gecis_gvn },
+};
+
+void optimize_et(Düğüm *program, Arena *arena) {
     if (!program) return;
-    optimize_dugum(program);
+    /* Satır içi açma bir kez, katlamadan önce: açılan ifadeler katlanır */
+    gecis_satirici(program, arena);
+    int n = (int)(sizeof(gecisler) / sizeof(gecisler[0]));
+    for (int tur = 0; tur < OPT_MAKS_TUR; tur++) {
+        int degisti = 0;
+        for (int i = 0; i < n; i++) {
+            degisti |= gecisler[i].calistir(program, arena);
+        }
+        if (!degisti) break;
+    }
+    /* Güç azaltma en sonda: x + x biçimi sabit katlamayı engellemesin */
+    dugum_gecis_uygula(program, guc_azalt);
 }
@@ -3,11 +3,19 @@
 
 #include "agac.h"
 
-/* AST optimizasyonları uygula:
- *  - Sabit katlama (constant folding)
- *  - Ölü kod eleme (dead code elimination)
+/* AST optimizasyonları uygula (anlam çözümlemesinden sonra, tüm
+ * backend'lerden önce; geçişler sabit noktaya kadar tekrarlanır):
+ *  - Satır içi açma (inlining): tek ifadelik işlev, metot ve al_ okuyucuları,
+ *    maliyet sınırlı;
+ *    @satıriçi / @satıriçi_değil ile zorlanır / yasaklanır (bir kez, ilk)
+ *  - Sabit katlama (constant folding): aritmetik, bit, karşılaştırma, mantık
+ *  - Sabit yayılımı (constant propagation): tek tanımlı, atanmayan yereller
+ *  - Dal budama: sabit koşullu eğer kolları, hiç çalışmayan iken
+ *  - Ölü kod eleme (dead code elimination): döndür/kır/devam/fırlat sonrası
+ *  - Döngüden çıkarma (LICM) ve değer numaralama (GVN): yan etkisiz tam
+ *    ifadeler işlev içinde yeni bir tam yerelde bir kez hesaplanır
  *  - Güç azaltma (strength reduction)
  */
-void optimize_et(Düğüm *program);
+void optimize_et(Düğüm *program, Arena *arena);
 
 #endif
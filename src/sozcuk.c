@@ -405,6 +405,9 @@ static void tanimlayici_oku(SözcükÇözümleyici *sc) {
             break;
         }
     }
+    /* Özellik okuyucusu için ayrılmış "al", çağrı olarak (paralel modülünün
+     * kanal işlevi) tanımlayıcıdır */
+    if (tur == TOK_AL && sc->kaynak[sc->pos] == '(') tur = TOK_TANIMLAYICI;
 
     Sözcük s;
     s.tur = tur;
@@ -16,9 +16,17 @@ Kapsam *kapsam_oluştur(Arena *a, Kapsam *ust) {
     k->sembol_sayisi = 0;
     k->ust = ust;
     k->yerel_sayac = ust ? ust->yerel_sayac : 0;
+    k->yerel_tepe = ust ? ust->yerel_tepe : NULL;
     return k;
 }
 
+int kapsam_yerel_ayir(Kapsam *k, int n) {
+    int ilk = k->yerel_sayac;
+    k->yerel_sayac += n;
+    if (k->yerel_tepe && *k->yerel_tepe < k->yerel_sayac) *k->yerel_tepe = k->yerel_sayac;
+    return ilk;
+}
+
 Sembol *sembol_ekle(Arena *a, Kapsam *k, const char *isim, TipTürü tip) {
     unsigned int idx = hash(isim) % TABLO_BOYUT;
 
@@ -29,7 +37,7 @@ Sembol *sembol_ekle(Arena *a, Kapsam *k, const char *isim, TipTürü tip) {
             Sembol *s = (Sembol *)arena_ayir(a, sizeof(Sembol));
             s->isim = arena_strdup(a, isim);
             s->tip = tip;
-            s->yerel_indeks = k->yerel_sayac++;
+            s->yerel_indeks = kapsam_yerel_ayir(k, 1);
             s->parametre_mi = 0;
             s->global_mi = 0;  /* tüm değişkenler stack-based */
             k->tablo[pos] = s;
@@ -58,6 +66,22 @@ Sembol *sembol_ara(Kapsam *k, const char *isim) {
     return NULL;
 }
 
+Sembol *sembol_ara_sinirli(Kapsam *k, Kapsam *sinir, const char *isim) {
+    while (k) {
+        unsigned int idx = hash(isim) % TABLO_BOYUT;
+        for (int i = 0; i < TABLO_BOYUT; i++) {
+            int pos = (idx + i) % TABLO_BOYUT;
+            if (k->tablo[pos] == NULL) break;
+            if (strcmp(k->tablo[pos]->isim, isim) == 0) {
+                return k->tablo[pos];
+            }
+        }
+        if (k == sinir) break;
+        k = k->ust;
+    }
+    return NULL;
+}
+
 TipTürü tip_adı_çevir(const char *isim) {
     if (!isim) return TİP_BİLİNMİYOR;
     /* UTF-8 byte karşılaştırması */
@@ -55,6 +55,7 @@ typedef struct {
     char    *isim;
     TipTürü  tip;
     int      yerel_indeks;   /* stack offset */
+    int      yazmac;         /* >0: callee-saved yazmaçta tutulur (1=r13, 2=r14, 3=r15) */
     int      parametre_mi;
     int      global_mi;
     /* İşlev bilgisi */
@@ -76,6 +77,7 @@ typedef struct {
     int     arayuz_metot_sayisi;
     /* Modül runtime bilgisi */
     const char *runtime_isim;    /* "_tr_xxx" — NULL ise kullanıcı fonksiyonu */
+    int     islev_mi;            /* adlı işlev: değer olarak statik kapanışıyla kullanılır */
 
     /* Sonuç/Seçenek tip bilgisi */
     TipTürü ic_tip;              /* İç tip (Sonuç<tam, _> için tam) */
@@ -101,17 +103,24 @@ typedef struct Kapsam {
     int             sembol_sayisi;
     struct Kapsam  *ust;
     int             yerel_sayac;   /* yerel değişken sayacı */
+    int            *yerel_tepe;    /* çerçevedeki en yüksek sayaç (alt kapsamlar üstten devralır) */
 } Kapsam;
 
 /* Kapsam oluştur/yok et */
 Kapsam *kapsam_oluştur(Arena *a, Kapsam *ust);
 
+/* n yerel slot ayır, ilk slotun indeksini döndür */
+int kapsam_yerel_ayir(Kapsam *k, int n);
+
 /* Sembol ekle */
 Sembol *sembol_ekle(Arena *a, Kapsam *k, const char *isim, TipTürü tip);
 
 /* Sembol ara (üst kapsamlara da bakar) */
 Sembol *sembol_ara(Kapsam *k, const char *isim);
 
+/* Sembol ara (k'dan sinir kapsamına kadar, sinir dahil) */
+Sembol *sembol_ara_sinirli(Kapsam *k, Kapsam *sinir, const char *isim);
+
 /* Tip adını TipTürü'na çevir */
 TipTürü tip_adı_çevir(const char *isim);
 
@@ -1,70 +1,195 @@
 /*
  * Tonyukuk Sanal Makinesi (TrSM)
- * Bytecode yorumlayıcı — .trbc dosyalarını çalıştırır
- *
- * Kullanım: trsm program.trbc
+ * Bytecode yorumlayıcı ve gömme API'si (libtrsm.a, bkz. trsm.h)
  */
+#define _DEFAULT_SOURCE
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
 #include <inttypes.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
+#include "trsm.h"
 #include "vm.h"
+#include "trsm_jit.h"
+#include "trsm_profil.h"
 
 /* ═══════════════════════════════════════════════════════════════════
  *  BYTECODE DOSYA OKUMA
  * ═══════════════════════════════════════════════════════════════════ */
 
-static uint8_t *dosya_oku(const char *yol, int *boyut) {
-    FILE *f = fopen(yol, "rb");
-    if (!f) {
+/* Dosyayı salt okunur eşle; v3 dosyaları bu eşlem üzerinde yerinde kullanılır */
+static uint8_t *dosya_esle(const char *yol, size_t *boyut) {
+    int fd = open(yol, O_RDONLY);
+    if (fd < 0) {
         fprintf(stderr, "Hata: '%s' dosyası açılamadı\n", yol);
         return NULL;
     }
-    fseek(f, 0, SEEK_END);
-    long uz = ftell(f);
-    fseek(f, 0, SEEK_SET);
-    uint8_t *veri = malloc(uz);
-    if (!veri) {
-        fclose(f);
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < 8) {
+        fprintf(stderr, "Hata: Dosya çok küçük\n");
+        close(fd);
+        return NULL;
+    }
+    void *veri = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (veri == MAP_FAILED) {
+        fprintf(stderr, "Hata: '%s' dosyası eşlenemedi\n", yol);
         return NULL;
     }
-    fread(veri, 1, uz, f);
-    fclose(f);
-    *boyut = (int)uz;
+    *boyut = (size_t)st.st_size;
     return veri;
 }
 
-/* .trbc dosyasını ayrıştır ve TrSM yapısını doldur */
-static int trbc_yukle(TrSM *sm, const uint8_t *veri, int boyut) {
-    if (boyut < 8) {
-        fprintf(stderr, "Hata: Dosya çok küçük\n");
-        return -1;
+/*
+ * Bytecode'u çalıştırmadan önce bir kez doğrula: her komut bilinen bir
+ * komut, operandları kod içinde, sabit/fonksiyon indeksleri sınırlar içinde
+ * ve atlama hedefleri komut başlangıçlarına denk geliyor. Akış son komuttan
+ * dışarı taşamaz. Böylece çalıştırma döngüsü komut başına sınır denetimi
+ * yapmak zorunda kalmaz.
+ */
+static int trbc_dogrula(TrsmModul *m) {
+    int uz = m->kod_uzunluk;
+    uint8_t *baslangic = calloc(uz + 1, 1);
+    int son_komut = -1;
+
+    for (int i = 0; i < uz; ) {
+        int boy = sm_komut_boyu(m->kod[i]);
+        if (boy == 0) {
+            fprintf(stderr, "Hata: Bilinmeyen komut: %d (PC: %d)\n", m->kod[i], i);
+            free(baslangic);
+            return -1;
+        }
+        if (i + boy > uz) {
+            fprintf(stderr, "Hata: Komut operandı kod sonunu aşıyor (PC: %d)\n", i);
+            free(baslangic);
+            return -1;
+        }
+        baslangic[i] = 1;
+        son_komut = i;
+        i += boy;
     }
 
-    const uint8_t *p = veri;
-
-    /* Başlık kontrolü */
-    uint32_t sihirli = OKU_U32(p); p += 4;
-    if (sihirli != TRBC_SIHIRLI) {
-        fprintf(stderr, "Hata: Geçersiz dosya formatı (sihirli: 0x%08X)\n", sihirli);
+    if (son_komut < 0) {
+        fprintf(stderr, "Hata: Bytecode boş\n");
+        free(baslangic);
         return -1;
     }
-    uint16_t versiyon = OKU_U16(p); p += 2;
-    if (versiyon != TRBC_VERSIYON) {
-        fprintf(stderr, "Hata: Desteklenmeyen versiyon: %d\n", versiyon);
+    uint8_t son = m->kod[son_komut];
+    if (son != SM_DUR && son != SM_ATLA && son != SM_DONDUR && son != SM_DONDUR_DEGER) {
+        fprintf(stderr, "Hata: Bytecode sonlandırıcı komutla bitmiyor\n");
+        free(baslangic);
         return -1;
     }
-    /* uint16_t bayraklar = OKU_U16(p); */
-    p += 2; /* bayraklar */
+
+    /* Globaller koddaki en büyük değişken indeksine göre ayrılır; üst
+     * düzeyde yereller de genellere eşlendiğinden onlar da sayılır */
+    int en_buyuk = 0;
+    for (int i = 0; i < uz; i += sm_komut_boyu(m->kod[i])) {
+        uint8_t k = m->kod[i];
+        const uint8_t *op = m->kod + i + 1;
+        int hata = 0;
+
+        if ((k >= SM_YUKLE_YEREL && k <= SM_KAYDET_GENEL) ||
+            (k >= SM_TOPLA_YEREL && k <= SM_ARTIR_GENEL)) {
+            if (OKU_U16(op) + 1 > en_buyuk) en_buyuk = OKU_U16(op) + 1;
+        } else if (k == SM_SABIT_TAM || k == SM_SABIT_ONDALIK || k == SM_SABIT_METIN) {
+            hata = OKU_U16(op) >= m->sabit_sayisi;
+        } else if (k == SM_CAGRI || k == SM_CAGRI_SABIT) {
+            hata = OKU_U16(op) >= m->fonksiyon_sayisi;
+        } else if (sm_komut_atlama_mi(k)) {
+            int hedef = i + 3 + OKU_I16(op);
+            hata = hedef < 0 || hedef >= uz || !baslangic[hedef];
+        }
+        if (hata) {
+            fprintf(stderr, "Hata: Geçersiz operand (PC: %d)\n", i);
+            free(baslangic);
+            return -1;
+        }
+    }
+
+    for (int i = 0; i < m->fonksiyon_sayisi; i++) {
+        int bas = m->fonksiyonlar[i].kod_baslangic;
+        if (bas < 0 || bas >= uz || !baslangic[bas]) {
+            fprintf(stderr, "Hata: Geçersiz fonksiyon başlangıcı: %d\n", i);
+            free(baslangic);
+            return -1;
+        }
+    }
+
+    m->genel_sayisi = en_buyuk < 1 ? 1 : en_buyuk > GENEL_MAKS ? GENEL_MAKS : en_buyuk;
+    free(baslangic);
+    return 0;
+}
+
+/* 48 bitlik satır içi yüke sığmayan tam sayılar yığında kutulanır */
+static inline int tam_kisa_sigar_mi(int64_t x) {
+    return x >= SM_TAM_KISA_MIN && x <= SM_TAM_KISA_MAKS;
+}
+
+/* Bir sabit nesnesinin blokta kapladığı en büyük yer (8 bayt hizalı) */
+#define SABIT_NESNE_PAYI  (sizeof(SmMetin) + 8)
+
+/*
+ * v1 dosyalarında nesne sayısı başlıkta yok: havuzu bir kez tarayıp
+ * metin ve büyük tam sabitlerini say. Havuz bozuksa -1.
+ */
+static int sabit_havuzu_tara(const uint8_t *p, const uint8_t *son, uint32_t sayi,
+                             uint32_t *nesne_sayisi, uint32_t *metin_bayt) {
+    *nesne_sayisi = 0;
+    *metin_bayt = 0;
+    for (uint32_t i = 0; i < sayi; i++) {
+        if (p + 1 > son) return -1;
+        uint8_t tip = *p++;
+        if (tip == SABIT_TIP_METIN) {
+            if (p + 4 > son) return -1;
+            uint32_t uzunluk = OKU_U32(p);
+            p += 4 + (size_t)uzunluk;
+            (*nesne_sayisi)++;
+            *metin_bayt += uzunluk;
+        } else if (tip == SABIT_TIP_TAM) {
+            if (p + 8 > son) return -1;
+            int64_t deger;
+            memcpy(&deger, p, 8);
+            if (!tam_kisa_sigar_mi(deger)) (*nesne_sayisi)++;
+            p += 8;
+        } else {
+            p += 8;
+        }
+    }
+    return 0;
+}
+
+/* v1/v2: sıralı havuzları ayrıştır; kod, metinler ve isimler kopyalanır */
+static int trbc_akis_yukle(TrsmModul *m, const uint8_t *veri, size_t boyut, uint16_t versiyon) {
+    const uint8_t *p = veri + 8;    /* sihirli, versiyon, bayraklar */
 
     /* Sabit havuzu */
     if (p + 4 > veri + boyut) return -1;
     uint32_t sabit_sayisi = OKU_U32(p); p += 4;
 
-    sm->sabitler = malloc(sabit_sayisi * sizeof(SmDeger));
-    sm->sabit_sayisi = (int)sabit_sayisi;
+    uint32_t nesne_sayisi, metin_bayt;
+    if (versiyon == TRBC_VERSIYON_ESKI) {
+        if (sabit_havuzu_tara(p, veri + boyut, sabit_sayisi, &nesne_sayisi, &metin_bayt) < 0)
+            return -1;
+    } else {
+        if (p + 8 > veri + boyut) return -1;
+        nesne_sayisi = OKU_U32(p); p += 4;
+        metin_bayt = OKU_U32(p); p += 4;
+    }
+
+    /* Sabit nesneleri (metinler, büyük tamlar) tek blokta ve kalıcı */
+    size_t blok_boyu = (size_t)nesne_sayisi * SABIT_NESNE_PAYI + metin_bayt;
+    uint8_t *blok = blok_boyu ? malloc(blok_boyu) : NULL;
+    size_t blok_kullanilan = 0;
+    m->sabit_blok = blok;
+
+    m->sabitler = malloc((sabit_sayisi ? sabit_sayisi : 1) * sizeof(SmDeger));
+    m->sabit_sayisi = (int)sabit_sayisi;
 
     for (uint32_t i = 0; i < sabit_sayisi; i++) {
         if (p + 1 > veri + boyut) return -1;
@@ -76,8 +201,17 @@ static int trbc_yukle(TrSM *sm, const uint8_t *veri, int boyut) {
             int64_t deger;
             memcpy(&deger, p, 8);
             p += 8;
-            sm->sabitler[i].tur = DEGER_TAM;
-            sm->sabitler[i].deger.tam = deger;
+            if (tam_kisa_sigar_mi(deger)) {
+                m->sabitler[i] = sm_tam_kisa(deger);
+                break;
+            }
+            if (blok_kullanilan + sizeof(SmKutuTam) > blok_boyu) goto bozuk_havuz;
+            SmKutuTam *k = (SmKutuTam *)(blok + blok_kullanilan);
+            blok_kullanilan += SABIT_NESNE_PAYI;
+            k->baslik.ref = SM_KALICI;
+            k->baslik.tur = DEGER_TAM;
+            k->deger = deger;
+            m->sabitler[i] = sm_nesne_deger(k);
             break;
         }
         case SABIT_TIP_ONDALIK: {
@@ -85,21 +219,24 @@ static int trbc_yukle(TrSM *sm, const uint8_t *veri, int boyut) {
             double deger;
             memcpy(&deger, p, 8);
             p += 8;
-            sm->sabitler[i].tur = DEGER_ONDALIK;
-            sm->sabitler[i].deger.ondalik = deger;
+            m->sabitler[i] = sm_ondalik(deger);
             break;
         }
         case SABIT_TIP_METIN: {
             if (p + 4 > veri + boyut) return -1;
             uint32_t uzunluk = OKU_U32(p); p += 4;
             if (p + uzunluk > veri + boyut) return -1;
-            char *kopya = malloc(uzunluk + 1);
-            memcpy(kopya, p, uzunluk);
-            kopya[uzunluk] = '\0';
+            size_t pay = (sizeof(SmMetin) + uzunluk + 8) & ~(size_t)7;
+            if (blok_kullanilan + pay > blok_boyu) goto bozuk_havuz;
+            SmMetin *mt = (SmMetin *)(blok + blok_kullanilan);
+            blok_kullanilan += pay;
+            mt->baslik.ref = SM_KALICI;
+            mt->baslik.tur = DEGER_METIN;
+            mt->uzunluk = (int64_t)uzunluk;
+            memcpy(mt->veri, p, uzunluk);
+            mt->veri[uzunluk] = '\0';
             p += uzunluk;
-            sm->sabitler[i].tur = DEGER_METIN;
-            sm->sabitler[i].deger.metin.ptr = kopya;
-            sm->sabitler[i].deger.metin.uzunluk = (int64_t)uzunluk;
+            m->sabitler[i] = sm_nesne_deger(mt);
             break;
         }
         default:
@@ -112,8 +249,8 @@ static int trbc_yukle(TrSM *sm, const uint8_t *veri, int boyut) {
     if (p + 4 > veri + boyut) return -1;
     uint32_t fonk_sayisi = OKU_U32(p); p += 4;
 
-    sm->fonksiyonlar = malloc(fonk_sayisi * sizeof(SmFonksiyon));
-    sm->fonksiyon_sayisi = (int)fonk_sayisi;
+    m->fonksiyonlar = calloc(fonk_sayisi ? fonk_sayisi : 1, sizeof(SmFonksiyon));
+    m->fonksiyon_sayisi = (int)fonk_sayisi;
 
     for (uint32_t i = 0; i < fonk_sayisi; i++) {
         if (p + 2 > veri + boyut) return -1;
@@ -125,16 +262,16 @@ static int trbc_yukle(TrSM *sm, const uint8_t *veri, int boyut) {
             memcpy(isim, p, isim_uz);
             isim[isim_uz] = '\0';
             p += isim_uz;
-            sm->fonksiyonlar[i].isim = isim;
+            m->fonksiyonlar[i].isim = isim;
         } else {
-            sm->fonksiyonlar[i].isim = NULL;
+            m->fonksiyonlar[i].isim = NULL;
         }
 
         if (p + 1 + 2 + 4 + 4 > veri + boyut) return -1;
-        sm->fonksiyonlar[i].param_sayisi = *p++;
-        sm->fonksiyonlar[i].yerel_sayisi = OKU_U16(p); p += 2;
-        sm->fonksiyonlar[i].kod_baslangic = (int)OKU_U32(p); p += 4;
-        sm->fonksiyonlar[i].kod_uzunluk = (int)OKU_U32(p); p += 4;
+        m->fonksiyonlar[i].param_sayisi = *p++;
+        m->fonksiyonlar[i].yerel_sayisi = OKU_U16(p); p += 2;
+        m->fonksiyonlar[i].kod_baslangic = (int)OKU_U32(p); p += 4;
+        m->fonksiyonlar[i].kod_uzunluk = (int)OKU_U32(p); p += 4;
     }
 
     /* Bytecode */
@@ -142,25 +279,243 @@ static int trbc_yukle(TrSM *sm, const uint8_t *veri, int boyut) {
     uint32_t kod_uz = OKU_U32(p); p += 4;
 
     if (p + kod_uz > veri + boyut) return -1;
-    sm->kod = malloc(kod_uz);
-    memcpy(sm->kod, p, kod_uz);
-    sm->kod_uzunluk = (int)kod_uz;
+    m->kod = malloc(kod_uz);
+    memcpy(m->kod, p, kod_uz);
+    m->kod_uzunluk = (int)kod_uz;
+
+    return trbc_dogrula(m);
+
+bozuk_havuz:
+    fprintf(stderr, "Hata: Sabit havuzu başlıkla uyuşmuyor\n");
+    return -1;
+}
 
+static int bolum_gecerli(uint32_t ofset, uint64_t boy, size_t dosya_boyu) {
+    return ofset % TRBC_HIZA == 0 && ofset <= dosya_boyu && boy <= dosya_boyu - ofset;
+}
+
+/* v3 sabiti: satır içi değer ya da nesne bölümündeki kalıcı nesne */
+static int sabit_coz(SmDeger *d, const uint8_t *nesneler, uint32_t nesne_boyu) {
+    SmDeger v = *d;
+    if (!sm_nesne_mi(v)) {
+        return sm_ondalik_mi(v) || sm_tam_kisa_mi(v) || v == SM_BOS_DEGER ||
+               v == sm_mantik(0) || v == sm_mantik(1) ? 0 : -1;
+    }
+    uint64_t ofset = v & SM_YUK_MASKE;
+    if (ofset % TRBC_HIZA != 0 || ofset + 16 > nesne_boyu) return -1;
+    const SmNesne *n = (const SmNesne *)(nesneler + ofset);
+    /* Eşlem salt okunur: sayılan bir nesne ilk dokunuşta çökerdi */
+    if (n->ref != SM_KALICI) return -1;
+    if (n->tur == DEGER_METIN) {
+        const SmMetin *m = (const SmMetin *)n;
+        if (m->uzunluk < 0 || (uint64_t)m->uzunluk >= nesne_boyu - ofset - 16 ||
+            m->veri[m->uzunluk] != '\0')
+            return -1;
+    } else if (n->tur != DEGER_TAM) {
+        return -1;
+    }
+    *d = sm_nesne_deger(n);
     return 0;
 }
 
+/* v3: eşlenmiş dosyayı yerinde kullan; yalnızca tablolar ayrılır */
+static int trbc_yerinde_yukle(TrsmModul *m, const uint8_t *veri, size_t boyut) {
+    TrbcBaslik b;
+    if (boyut < sizeof(b)) {
+        fprintf(stderr, "Hata: Dosya çok küçük\n");
+        return -1;
+    }
+    memcpy(&b, veri, sizeof(b));
+    if (b.dosya_boyu != boyut) {
+        fprintf(stderr, "Hata: Dosya boyu başlıkla uyuşmuyor\n");
+        return -1;
+    }
+    if (!bolum_gecerli(b.sabit_ofset, (uint64_t)b.sabit_sayisi * 8, boyut) ||
+        !bolum_gecerli(b.nesne_ofset, b.nesne_boyu, boyut) ||
+        !bolum_gecerli(b.fonksiyon_ofset, (uint64_t)b.fonksiyon_sayisi * sizeof(TrbcFonksiyon), boyut) ||
+        !bolum_gecerli(b.isim_ofset, b.isim_boyu, boyut) ||
+        !bolum_gecerli(b.kod_ofset, b.kod_uzunluk, boyut) ||
+        b.sabit_sayisi > UINT16_MAX + 1u || b.kod_uzunluk > INT32_MAX) {
+        fprintf(stderr, "Hata: Geçersiz bölüm tablosu\n");
+        return -1;
+    }
+    if ((b.bayraklar & TRBC_BAYRAK_SAGLAMA) &&
+        trbc_saglama(veri + sizeof(b), boyut - sizeof(b)) != b.saglama) {
+        fprintf(stderr, "Hata: Sağlama toplamı tutmuyor (dosya bozuk)\n");
+        return -1;
+    }
+
+    m->eslem = veri;
+    m->eslem_boyu = boyut;
+
+    /* Sabit tablosu: nesne ofsetleri işaretçiye çevrilir */
+    const uint8_t *nesneler = veri + b.nesne_ofset;
+    m->sabitler = malloc((b.sabit_sayisi ? b.sabit_sayisi : 1) * sizeof(SmDeger));
+    m->sabit_sayisi = (int)b.sabit_sayisi;
+    memcpy(m->sabitler, veri + b.sabit_ofset, (size_t)b.sabit_sayisi * 8);
+    for (uint32_t i = 0; i < b.sabit_sayisi; i++) {
+        if (sabit_coz(&m->sabitler[i], nesneler, b.nesne_boyu) < 0) {
+            fprintf(stderr, "Hata: Geçersiz sabit: %u\n", i);
+            return -1;
+        }
+    }
+
+    /* Fonksiyon tablosu: isimler eşlemin içini gösterir */
+    const char *isimler = (const char *)(veri + b.isim_ofset);
+    m->fonksiyonlar = malloc((b.fonksiyon_sayisi ? b.fonksiyon_sayisi : 1) * sizeof(SmFonksiyon));
+    m->fonksiyon_sayisi = (int)b.fonksiyon_sayisi;
+    for (uint32_t i = 0; i < b.fonksiyon_sayisi; i++) {
+        TrbcFonksiyon f;
+        memcpy(&f, veri + b.fonksiyon_ofset + i * sizeof(f), sizeof(f));
+        SmFonksiyon *fn = &m->fonksiyonlar[i];
+        fn->isim = NULL;
+        if (f.isim != TRBC_ISIMSIZ) {
+            if (f.isim >= b.isim_boyu || !memchr(isimler + f.isim, '\0', b.isim_boyu - f.isim)) {
+                fprintf(stderr, "Hata: Geçersiz fonksiyon ismi: %u\n", i);
+                return -1;
+            }
+            fn->isim = (char *)(isimler + f.isim);
+        }
+        fn->param_sayisi = f.param_sayisi;
+        fn->yerel_sayisi = f.yerel_sayisi;
+        fn->kod_baslangic = (int)f.kod_baslangic;
+        fn->kod_uzunluk = (int)f.kod_uzunluk;
+    }
+
+    m->kod = (uint8_t *)(veri + b.kod_ofset);
+    m->kod_uzunluk = (int)b.kod_uzunluk;
+
+    return trbc_dogrula(m);
+}
+
+/* .trbc görüntüsünü ayrıştır ve modülü doldur */
+static int trbc_yukle(TrsmModul *m, const uint8_t *veri, size_t boyut) {
+    if (boyut < 8) {
+        fprintf(stderr, "Hata: Dosya çok küçük\n");
+        return -1;
+    }
+
+    /* Başlık kontrolü */
+    uint32_t sihirli = OKU_U32(veri);
+    if (sihirli != TRBC_SIHIRLI) {
+        fprintf(stderr, "Hata: Geçersiz dosya formatı (sihirli: 0x%08X)\n", sihirli);
+        return -1;
+    }
+    uint16_t versiyon = OKU_U16(veri + 4);
+    if (versiyon == TRBC_VERSIYON)
+        return trbc_yerinde_yukle(m, veri, boyut);
+    if (versiyon != TRBC_VERSIYON_AKIS && versiyon != TRBC_VERSIYON_ESKI) {
+        fprintf(stderr, "Hata: Desteklenmeyen versiyon: %d\n", versiyon);
+        return -1;
+    }
+    return trbc_akis_yukle(m, veri, boyut, versiyon);
+}
+
 /* ═══════════════════════════════════════════════════════════════════
  *  YARDIMCI FONKSİYONLAR
  * ═══════════════════════════════════════════════════════════════════ */
 
+/* Referans sayımı: kalıcı (sabit havuzu) nesneler sayılmaz */
+static inline void deger_tut(SmDeger d) {
+    if (sm_nesne_mi(d)) {
+        SmNesne *n = sm_nesne(d);
+        if (n->ref != SM_KALICI) n->ref++;
+    }
+}
+
+static inline void deger_birak(SmDeger d) {
+    if (sm_nesne_mi(d)) {
+        SmNesne *n = sm_nesne(d);
+        if (n->ref != SM_KALICI && --n->ref == 0) free(n);
+    }
+}
+
+static SmDeger tam_kutula(int64_t x) {
+    SmKutuTam *k = malloc(sizeof(SmKutuTam));
+    k->baslik.ref = 1;
+    k->baslik.tur = DEGER_TAM;
+    k->deger = x;
+    return sm_nesne_deger(k);
+}
+
+static inline SmDeger tam_yap(int64_t x) {
+    return tam_kisa_sigar_mi(x) ? sm_tam_kisa(x) : tam_kutula(x);
+}
+
+/* Yeni metin nesnesi (ref = 1); veri çağıran tarafından doldurulur */
+static SmMetin *metin_ayir(int64_t uzunluk) {
+    SmMetin *m = malloc(sizeof(SmMetin) + uzunluk + 1);
+    m->baslik.ref = 1;
+    m->baslik.tur = DEGER_METIN;
+    m->uzunluk = uzunluk;
+    m->veri[uzunluk] = '\0';
+    return m;
+}
+
+static SmDeger metin_yap(const char *s, int64_t uzunluk) {
+    SmMetin *m = metin_ayir(uzunluk);
+    memcpy(m->veri, s, uzunluk);
+    return sm_nesne_deger(m);
+}
+
+static DegerTuru deger_turu(SmDeger d) {
+    if (sm_ondalik_mi(d)) return DEGER_ONDALIK;
+    switch (d & SM_ETIKET_MASKE) {
+    case SM_ETIKET_TAM:    return DEGER_TAM;
+    case SM_ETIKET_MANTIK: return DEGER_MANTIK;
+    case SM_ETIKET_NESNE:  return (DegerTuru)sm_nesne(d)->tur;
+    default:               return DEGER_BOS;
+    }
+}
+
+/* Metin değilse boş metin görünümü (eski birlikte uzunluk alanı 0'dı) */
+static inline SmMetin *deger_metin(SmDeger d) {
+    if (sm_nesne_mi(d) && sm_nesne(d)->tur == DEGER_METIN)
+        return (SmMetin *)sm_nesne(d);
+    return NULL;
+}
+
+/*
+ * Tam/ondalık görünümleri: tür uyuşmazlığında eski birlik tabanlı gösterimle
+ * aynı sonucu vermek için bitler yeniden yorumlanır.
+ */
+static int64_t deger_tam_yavas(SmDeger d) {
+    switch (deger_turu(d)) {
+    case DEGER_TAM:     return ((SmKutuTam *)sm_nesne(d))->deger;
+    case DEGER_ONDALIK: return (int64_t)d;
+    case DEGER_MANTIK:  return (int64_t)(d & 1);
+    default:            return 0;
+    }
+}
+
+static inline int64_t deger_tam(SmDeger d) {
+    return sm_tam_kisa_mi(d) ? sm_tam_kisa_al(d) : deger_tam_yavas(d);
+}
+
+static double deger_ondalik_yavas(SmDeger d) {
+    int64_t bitler;
+    switch (deger_turu(d)) {
+    case DEGER_TAM:
+    case DEGER_MANTIK: bitler = deger_tam(d); break;
+    default:           return 0.0;
+    }
+    double x;
+    memcpy(&x, &bitler, 8);
+    return x;
+}
+
+static inline double deger_ondalik(SmDeger d) {
+    return sm_ondalik_mi(d) ? sm_ondalik_al(d) : deger_ondalik_yavas(d);
+}
+
 /* Değeri yazdır (satır sonu olmadan) */
-static void deger_yazdir(SmDeger *d) {
-    switch (d->tur) {
+static void deger_yazdir(SmDeger d) {
+    switch (deger_turu(d)) {
     case DEGER_TAM:
-        printf("%" PRId64, d->deger.tam);
+        printf("%" PRId64, deger_tam(d));
         break;
     case DEGER_ONDALIK: {
-        double val = d->deger.ondalik;
+        double val = sm_ondalik_al(d);
         /* Tam sayı gibi görünüyorsa .0 ekle değil, %g formatı kullan */
         if (val == (double)(int64_t)val && val >= -1e15 && val <= 1e15) {
             printf("%.1f", val);
@@ -169,12 +524,13 @@ static void deger_yazdir(SmDeger *d) {
         }
         break;
     }
-    case DEGER_METIN:
-        if (d->deger.metin.ptr)
-            printf("%.*s", (int)d->deger.metin.uzunluk, d->deger.metin.ptr);
+    case DEGER_METIN: {
+        SmMetin *m = deger_metin(d);
+        printf("%.*s", (int)m->uzunluk, m->veri);
         break;
+    }
     case DEGER_MANTIK:
-        printf("%s", d->deger.mantik ? "doğru" : "yanlış");
+        printf("%s", (d & 1) ? "doğru" : "yanlış");
         break;
     case DEGER_BOS:
         printf("boş");
@@ -183,31 +539,24 @@ static void deger_yazdir(SmDeger *d) {
 }
 
 /* Metin birleştirme: iki metin değerini birleştir */
-static SmDeger metin_birlestir(SmDeger *a, SmDeger *b) {
-    int64_t uz_a = a->deger.metin.uzunluk;
-    int64_t uz_b = b->deger.metin.uzunluk;
-    int64_t toplam = uz_a + uz_b;
-    char *yeni = malloc(toplam + 1);
-    if (a->deger.metin.ptr)
-        memcpy(yeni, a->deger.metin.ptr, uz_a);
-    if (b->deger.metin.ptr)
-        memcpy(yeni + uz_a, b->deger.metin.ptr, uz_b);
-    yeni[toplam] = '\0';
-    SmDeger sonuc;
-    sonuc.tur = DEGER_METIN;
-    sonuc.deger.metin.ptr = yeni;
-    sonuc.deger.metin.uzunluk = toplam;
-    return sonuc;
+static SmDeger metin_birlestir(SmDeger a, SmDeger b) {
+    SmMetin *ma = deger_metin(a), *mb = deger_metin(b);
+    int64_t uz_a = ma ? ma->uzunluk : 0;
+    int64_t uz_b = mb ? mb->uzunluk : 0;
+    SmMetin *yeni = metin_ayir(uz_a + uz_b);
+    if (ma) memcpy(yeni->veri, ma->veri, uz_a);
+    if (mb) memcpy(yeni->veri + uz_a, mb->veri, uz_b);
+    return sm_nesne_deger(yeni);
 }
 
 /* Değer doğruluk testi (truthy/falsy) */
-static int deger_dogru_mu(SmDeger *d) {
-    switch (d->tur) {
-    case DEGER_TAM:    return d->deger.tam != 0;
-    case DEGER_ONDALIK: return d->deger.ondalik != 0.0;
-    case DEGER_METIN:  return d->deger.metin.uzunluk > 0;
-    case DEGER_MANTIK: return d->deger.mantik;
-    case DEGER_BOS:    return 0;
+static int deger_dogru_mu(SmDeger d) {
+    switch (deger_turu(d)) {
+    case DEGER_TAM:     return deger_tam(d) != 0;
+    case DEGER_ONDALIK: return sm_ondalik_al(d) != 0.0;
+    case DEGER_METIN:   return deger_metin(d)->uzunluk > 0;
+    case DEGER_MANTIK:  return (int)(d & 1);
+    case DEGER_BOS:     return 0;
     }
     return 0;
 }
@@ -216,703 +565,1098 @@ static int deger_dogru_mu(SmDeger *d) {
 static SmDeger tam_metine(int64_t deger) {
     char buf[64];
     int uzunluk = snprintf(buf, sizeof(buf), "%" PRId64, deger);
-    char *kopya = malloc(uzunluk + 1);
-    memcpy(kopya, buf, uzunluk + 1);
-    SmDeger sonuc;
-    sonuc.tur = DEGER_METIN;
-    sonuc.deger.metin.ptr = kopya;
-    sonuc.deger.metin.uzunluk = uzunluk;
-    return sonuc;
+    return metin_yap(buf, uzunluk);
 }
 
 /* ═══════════════════════════════════════════════════════════════════
  *  ANA ÇALIŞTIRMA DÖNGÜSÜ
  * ═══════════════════════════════════════════════════════════════════ */
 
-static int trsm_calistir(TrSM *sm) {
-    sm->pc = sm->kod;
-    sm->sp = 0;
-    sm->cerceve_sayisi = 0;
+/*
+ * GCC/Clang altında komutlar doğrudan dallanmalı (computed goto) dağıtılır:
+ * her komutun sonunda bir sonraki komutun etiketine atlanır, böylece tek bir
+ * switch noktasında dal tahmini çökmez. Diğer derleyicilerde ya da
+ * -DTRSM_ANAHTAR_DAGITIM ile aynı gövdeler klasik switch döngüsüne açılır.
+ */
+#if defined(__GNUC__) && !defined(TRSM_ANAHTAR_DAGITIM)
+#define TRSM_DOLAYLI_DAGITIM 1
+#define BEKLENMEZ(x) __builtin_expect(!!(x), 0)
+#else
+#define BEKLENMEZ(x) (x)
+#endif
+
+/* Değer yığınını en az `gereken` yuvaya büyüt; sınır aşılırsa -1 */
+static int yigin_ayir(TrSM *sm, int gereken) {
+    if (gereken <= sm->yigin_kapasite) return 0;
+    if (gereken > YIGIN_SINIR) return -1;
+    int yeni = sm->yigin_kapasite ? sm->yigin_kapasite : YIGIN_BASLANGIC;
+    while (yeni < gereken) yeni *= 2;
+    if (yeni > YIGIN_SINIR) yeni = YIGIN_SINIR;
+    SmDeger *y = realloc(sm->yigin, (size_t)yeni * sizeof(SmDeger));
+    if (!y) return -1;
+    sm->yigin = y;
+    sm->yigin_kapasite = yeni;
+    return 0;
+}
 
-    /* Yığın taşma/alttan taşma makroları */
-    #define YIGIN_AT(d) do { \
-        if (sm->sp >= YIGIN_MAKS) { \
-            fprintf(stderr, "Hata: Yığın taşması\n"); return -1; \
-        } \
-        sm->yigin[sm->sp++] = (d); \
-    } while(0)
+/* Eksik işlenenler boş değer sayılır: çerçevenin işlenen tabanına (alt)
+ * BOS ekleyerek tamamla. Yeni sp'yi, taşmada -1 döndürür. */
+static int yigin_tamamla(TrSM *sm, int alt, int sp, int gereken) {
+    int eksik = gereken - (sp - alt);
+    if (yigin_ayir(sm, sp + eksik) < 0) return -1;
+    memmove(sm->yigin + alt + eksik, sm->yigin + alt, (size_t)(sp - alt) * sizeof(SmDeger));
+    for (int i = 0; i < eksik; i++)
+        sm->yigin[alt + i] = SM_BOS_DEGER;
+    return sp + eksik;
+}
 
-    #define YIGIN_AL() (sm->sp > 0 ? sm->yigin[--sm->sp] : \
-        (SmDeger){.tur = DEGER_BOS})
+/* Üst çerçevenin yerellerini idx'i kapsayacak kadar genişlet: işlenenler
+ * yukarı kaydırılır. Yeni sp'yi, taşmada -1 döndürür. */
+static int yerel_genislet(TrSM *sm, int idx, int sp) {
+    CagriCercevesi *cerceve = &sm->cerceveler[sm->cerceve_sayisi - 1];
+    int eklenecek = idx + 1 - cerceve->yerel_sayisi;
+    int ust = cerceve->taban + cerceve->yerel_sayisi;
+    if (yigin_ayir(sm, sp + eklenecek) < 0) return -1;
+    memmove(sm->yigin + ust + eklenecek, sm->yigin + ust, (size_t)(sp - ust) * sizeof(SmDeger));
+    for (int j = 0; j < eklenecek; j++)
+        sm->yigin[ust + j] = SM_BOS_DEGER;
+    cerceve->yerel_sayisi += eklenecek;
+    return sp + eklenecek;
+}
 
-    while (1) {
-        if (sm->pc < sm->kod || sm->pc >= sm->kod + sm->kod_uzunluk) {
-            fprintf(stderr, "Hata: Program sayacı sınır dışı\n");
-            return -1;
-        }
+/*
+ * Satır içi tamın yükü üst 48 bite kaydırılınca (UST) işaretli karşılaştırma
+ * doğrudan yapılır; toplamada da taşma işaret bitinden okunur ve sonuç tek
+ * kaydırmayla yeniden etiketlenir. Taşarsa yavaş yola (kutulama) düşülür.
+ */
+#define KISA_TAM_UST(d) ((int64_t)((d) << 16))
+
+static inline int kisa_tam_topla(SmDeger a, int64_t b_ust, SmDeger *sonuc) {
+    uint64_t a_ust = (uint64_t)KISA_TAM_UST(a);
+    uint64_t x = a_ust + (uint64_t)b_ust;
+    if (BEKLENMEZ((int64_t)((x ^ a_ust) & (x ^ (uint64_t)b_ust)) < 0)) return 0;
+    *sonuc = SM_ETIKET_TAM | (x >> 16);
+    return 1;
+}
 
-        uint8_t komut = *sm->pc++;
+/* İki değer de satır içi tam mı? (etiket alanları TAM ise xor'ları 0) */
+#define IKI_KISA_TAM(a, b) \
+    ((((a) ^ SM_ETIKET_TAM) | ((b) ^ SM_ETIKET_TAM)) >> 48 == 0)
 
-        switch (komut) {
+/* trsm_harici_kaydet ile bağlanan ana program fonksiyonu */
+struct TrsmHarici {
+    TrsmHariciFn fn;
+    void        *veri;
+};
 
-        /* ─── Sabitler ─── */
+/* trsm_cagir'ın dönüş adresi: çağrılan fonksiyon dönünce yürütme durur */
+static uint8_t dur_komutu[1] = { SM_DUR };
 
-        case SM_SABIT_TAM: {
-            uint16_t idx = OKU_U16(sm->pc); sm->pc += 2;
-            if (idx >= (uint16_t)sm->sabit_sayisi) {
-                fprintf(stderr, "Hata: Sabit indeksi sınır dışı: %d\n", idx);
-                return -1;
-            }
-            YIGIN_AT(sm->sabitler[idx]);
-            break;
+/*
+ * Yorumlayıcı: `baslangic_pc`den, mevcut çerçeveler ve `baslangic_sp`
+ * üzerinde SM_DUR'a kadar çalışır. Hata durumunda sm->sp o anki tepeyi
+ * gösterir; kalan değerleri çağıran bırakır.
+ */
+static int trsm_yurut(TrSM *sm, uint8_t *baslangic_pc, int baslangic_sp) {
+    /* Sıcak durum yerel değişkenlerde tutulur; sm yalnızca çıkışta güncellenir */
+    uint8_t *pc = baslangic_pc;
+    SmDeger *sabitler = sm->sabitler;
+    int sp = baslangic_sp;
+
+    SmDeger *yigin;
+    int yigin_kapasite;
+
+    /* Üst çerçevenin yerelleri ve işlenen tabanı; global kapsamda yereller
+     * genellere eşlenir. Yığın yeniden ayrıldığında bunlar tazelenir. */
+    SmDeger *yereller;
+    int yerel_sayisi;
+    int alt;
+
+    SmFonksiyon *fn;
+    int arg_sayisi;
+#ifdef TRSM_JIT
+    void *jit_hedef;
+#endif
+
+    if (yigin_ayir(sm, sp + YIGIN_BASLANGIC) < 0) {
+        fprintf(stderr, "Hata: Yığın ayrılamadı\n");
+        return -1;
+    }
+    if (!sm->cerceveler) {
+        sm->cerceveler = malloc(CERCEVE_BASLANGIC * sizeof(CagriCercevesi));
+        if (!sm->cerceveler) {
+            fprintf(stderr, "Hata: Çağrı yığını ayrılamadı\n");
+            return -1;
         }
+        sm->cerceve_kapasite = CERCEVE_BASLANGIC;
+    }
 
-        case SM_SABIT_ONDALIK: {
-            uint16_t idx = OKU_U16(sm->pc); sm->pc += 2;
-            if (idx >= (uint16_t)sm->sabit_sayisi) {
-                fprintf(stderr, "Hata: Sabit indeksi sınır dışı: %d\n", idx);
-                return -1;
-            }
-            YIGIN_AT(sm->sabitler[idx]);
-            break;
-        }
+    #define CERCEVE_YENILE() do { \
+        yigin = sm->yigin; \
+        yigin_kapasite = sm->yigin_kapasite; \
+        if (sm->cerceve_sayisi > 0) { \
+            CagriCercevesi *c_ = &sm->cerceveler[sm->cerceve_sayisi - 1]; \
+            yereller = yigin + c_->taban; \
+            yerel_sayisi = c_->yerel_sayisi; \
+            alt = c_->taban + c_->yerel_sayisi; \
+        } else { \
+            yereller = sm->geneller; \
+            yerel_sayisi = sm->genel_sayisi; \
+            alt = 0; \
+        } \
+    } while(0)
 
-        case SM_SABIT_METIN: {
-            uint16_t idx = OKU_U16(sm->pc); sm->pc += 2;
-            if (idx >= (uint16_t)sm->sabit_sayisi) {
-                fprintf(stderr, "Hata: Sabit indeksi sınır dışı: %d\n", idx);
-                return -1;
-            }
-            YIGIN_AT(sm->sabitler[idx]);
-            break;
-        }
+    CERCEVE_YENILE();
 
-        case SM_DOGRU: {
-            SmDeger d = {.tur = DEGER_MANTIK, .deger.mantik = 1};
-            YIGIN_AT(d);
-            break;
-        }
+    /* Bir değerlik yer aç; gerekirse yığını büyüt */
+    #define YIGIN_YER_AC() do { \
+        if (BEKLENMEZ(sp >= yigin_kapasite)) { \
+            if (yigin_ayir(sm, sp + 1) < 0) goto yigin_tasmasi; \
+            CERCEVE_YENILE(); \
+        } \
+    } while(0)
 
-        case SM_YANLIS: {
-            SmDeger d = {.tur = DEGER_MANTIK, .deger.mantik = 0};
-            YIGIN_AT(d);
-            break;
-        }
+    #define YIGIN_AT(d) do { \
+        YIGIN_YER_AC(); \
+        yigin[sp++] = (d); \
+    } while(0)
 
-        case SM_BOS: {
-            SmDeger d = {.tur = DEGER_BOS};
-            YIGIN_AT(d);
-            break;
-        }
+    /* Çekilen değerin sahipliği çağırana geçer */
+    #define YIGIN_AL() (sp > alt ? yigin[--sp] : SM_BOS_DEGER)
 
-        /* ─── Yığın işlemleri ─── */
+    #define GEREK(n) do { \
+        if (BEKLENMEZ(sp - alt < (n))) { \
+            sp = yigin_tamamla(sm, alt, sp, (n)); \
+            if (sp < 0) goto yigin_tasmasi; \
+            CERCEVE_YENILE(); \
+        } \
+    } while(0)
 
-        case SM_CIKAR:
-            if (sm->sp > 0) sm->sp--;
-            break;
+    /* b,a → a op b; sonuç a'nın yuvasına yazılır. İki satır içi tam için
+     * kutulama ve referans sayımı atlanır. */
+    #define TAM_ISLEM(op) do { \
+        GEREK(2); sp--; \
+        SmDeger a_ = yigin[sp - 1], b_ = yigin[sp]; \
+        if (IKI_KISA_TAM(a_, b_)) { \
+            yigin[sp - 1] = tam_yap(sm_tam_kisa_al(a_) op sm_tam_kisa_al(b_)); \
+        } else { \
+            yigin[sp - 1] = tam_yap(deger_tam(a_) op deger_tam(b_)); \
+            deger_birak(a_); deger_birak(b_); \
+        } \
+    } while(0)
 
-        case SM_KOPYALA: {
-            if (sm->sp < 1) {
-                fprintf(stderr, "Hata: Yığın boş (KOPYALA)\n");
-                return -1;
-            }
-            SmDeger d = sm->yigin[sm->sp - 1];
-            YIGIN_AT(d);
-            break;
-        }
+    #define OND_ISLEM(op) do { \
+        GEREK(2); sp--; \
+        SmDeger a_ = yigin[sp - 1], b_ = yigin[sp]; \
+        yigin[sp - 1] = sm_ondalik(deger_ondalik(a_) op deger_ondalik(b_)); \
+        deger_birak(a_); deger_birak(b_); \
+    } while(0)
 
-        /* ─── Tam sayı aritmetik ─── */
+    #define KARSILASTIR(gorunum, op) do { \
+        GEREK(2); sp--; \
+        SmDeger a_ = yigin[sp - 1], b_ = yigin[sp]; \
+        yigin[sp - 1] = sm_mantik(gorunum(a_) op gorunum(b_)); \
+        deger_birak(a_); deger_birak(b_); \
+    } while(0)
 
-        case SM_TOPLA: {
-            SmDeger b = YIGIN_AL();
-            SmDeger a = YIGIN_AL();
-            SmDeger sonuc = {.tur = DEGER_TAM, .deger.tam = a.deger.tam + b.deger.tam};
-            YIGIN_AT(sonuc);
-            break;
-        }
+    /* Karşılaştır ve sonuç yanlışsa atla (KUCUK + ATLA_YANLIS birleşimi) */
+    #define KARSILASTIR_ATLA(op) do { \
+        int16_t ofset = OKU_I16(pc); pc += 2; \
+        GEREK(2); sp -= 2; \
+        SmDeger a_ = yigin[sp], b_ = yigin[sp + 1]; \
+        int sonuc_; \
+        if (IKI_KISA_TAM(a_, b_)) { \
+            sonuc_ = KISA_TAM_UST(a_) op KISA_TAM_UST(b_); \
+        } else { \
+            sonuc_ = deger_tam(a_) op deger_tam(b_); \
+            deger_birak(a_); deger_birak(b_); \
+        } \
+        if (!sonuc_) pc += ofset; \
+    } while(0)
 
-        case SM_CIKAR_SAYI: {
-            SmDeger b = YIGIN_AL();
-            SmDeger a = YIGIN_AL();
-            SmDeger sonuc = {.tur = DEGER_TAM, .deger.tam = a.deger.tam - b.deger.tam};
-            YIGIN_AT(sonuc);
-            break;
-        }
+    /* Çerçevenin yerellerini ve işlenenlerini bırak */
+    #define CERCEVE_BIRAK(taban_) do { \
+        for (int i_ = (taban_); i_ < sp; i_++) deger_birak(yigin[i_]); \
+    } while(0)
 
-        case SM_CARP: {
-            SmDeger b = YIGIN_AL();
-            SmDeger a = YIGIN_AL();
-            SmDeger sonuc = {.tur = DEGER_TAM, .deger.tam = a.deger.tam * b.deger.tam};
-            YIGIN_AT(sonuc);
-            break;
-        }
+#ifdef TRSM_DOLAYLI_DAGITIM
+    static void *dagitim[256];
+    static void *profil_dagitim[256];
+    static int dagitim_hazir = 0;
+    if (!dagitim_hazir) {
+        for (int i = 0; i < 256; i++) dagitim[i] = &&e_gecersiz;
+        #define KAYIT(k) dagitim[k] = &&e_##k
+        KAYIT(SM_SABIT_TAM); KAYIT(SM_SABIT_ONDALIK); KAYIT(SM_SABIT_METIN);
+        KAYIT(SM_DOGRU); KAYIT(SM_YANLIS); KAYIT(SM_BOS);
+        KAYIT(SM_CIKAR); KAYIT(SM_KOPYALA);
+        KAYIT(SM_TOPLA); KAYIT(SM_CIKAR_SAYI); KAYIT(SM_CARP);
+        KAYIT(SM_BOL); KAYIT(SM_MOD); KAYIT(SM_EKSI);
+        KAYIT(SM_TOPLA_OND); KAYIT(SM_CIKAR_OND); KAYIT(SM_CARP_OND);
+        KAYIT(SM_BOL_OND); KAYIT(SM_EKSI_OND);
+        KAYIT(SM_ESIT); KAYIT(SM_ESIT_DEGIL); KAYIT(SM_KUCUK);
+        KAYIT(SM_BUYUK); KAYIT(SM_KUCUK_ESIT); KAYIT(SM_BUYUK_ESIT);
+        KAYIT(SM_ESIT_OND); KAYIT(SM_KUCUK_OND); KAYIT(SM_BUYUK_OND);
+        KAYIT(SM_KUCUK_ESIT_OND); KAYIT(SM_BUYUK_ESIT_OND);
+        KAYIT(SM_ESIT_METIN);
+        KAYIT(SM_DEGIL); KAYIT(SM_VE); KAYIT(SM_VEYA);
+        KAYIT(SM_YUKLE_YEREL); KAYIT(SM_KAYDET_YEREL);
+        KAYIT(SM_YUKLE_GENEL); KAYIT(SM_KAYDET_GENEL);
+        KAYIT(SM_ATLA); KAYIT(SM_ATLA_YANLIS); KAYIT(SM_ATLA_DOGRU);
+        KAYIT(SM_CAGRI); KAYIT(SM_DONDUR); KAYIT(SM_DONDUR_DEGER);
+        KAYIT(SM_YAZDIR); KAYIT(SM_YAZDIR_SATIR);
+        KAYIT(SM_METIN_BIRLESTIR);
+        KAYIT(SM_TAM_ONDALIK); KAYIT(SM_ONDALIK_TAM);
+        KAYIT(SM_TAM_METIN); KAYIT(SM_METIN_TAM);
+        KAYIT(SM_DUR);
+        KAYIT(SM_TOPLA_YEREL); KAYIT(SM_TOPLA_GENEL);
+        KAYIT(SM_ARTIR_YEREL); KAYIT(SM_ARTIR_GENEL);
+        KAYIT(SM_ESIT_ATLA_YANLIS); KAYIT(SM_ESIT_DEGIL_ATLA_YANLIS);
+        KAYIT(SM_KUCUK_ATLA_YANLIS); KAYIT(SM_BUYUK_ATLA_YANLIS);
+        KAYIT(SM_KUCUK_ESIT_ATLA_YANLIS); KAYIT(SM_BUYUK_ESIT_ATLA_YANLIS);
+        KAYIT(SM_CAGRI_SABIT);
+        #undef KAYIT
+        for (int i = 0; i < 256; i++) profil_dagitim[i] = &&e_profil;
+        dagitim_hazir = 1;
+    }
+    /* --profil: her komut önce e_profil'den geçer, ardından gerçek gövdeye */
+    void **tablo = sm->profil ? profil_dagitim : dagitim;
+    #define KOMUT(k)       e_##k:
+    #define SONRAKI()      goto *tablo[*pc++]
+    #define DAGITIM_BASLA  SONRAKI(); { \
+        e_profil: \
+            trsm_profil_komut(sm, pc - 1); \
+            goto *dagitim[pc[-1]];
+    #define DAGITIM_SONU   }
+    #define GECERSIZ       e_gecersiz:
+    #define SONRAKI_DIS()  SONRAKI()
+#else
+    #define KOMUT(k)       case k:
+    #define SONRAKI()      continue
+    #define DAGITIM_BASLA  dagit: for (;;) { \
+        if (BEKLENMEZ(sm->profil != NULL)) trsm_profil_komut(sm, pc); \
+        switch (*pc++) {
+    #define DAGITIM_SONU   } }
+    #define GECERSIZ       default:
+    #define SONRAKI_DIS()  goto dagit
+#endif
+
+    DAGITIM_BASLA
+
+    /* ─── Sabitler (indeksler yüklemede doğrulandı; nesneleri kalıcı) ─── */
+
+    KOMUT(SM_SABIT_TAM)
+    KOMUT(SM_SABIT_ONDALIK)
+    KOMUT(SM_SABIT_METIN) {
+        uint16_t idx = OKU_U16(pc); pc += 2;
+        YIGIN_AT(sabitler[idx]);
+        SONRAKI();
+    }
 
-        case SM_BOL: {
-            SmDeger b = YIGIN_AL();
-            SmDeger a = YIGIN_AL();
-            if (b.deger.tam == 0) {
-                fprintf(stderr, "Hata: Sıfıra bölme\n");
-                return -1;
-            }
-            SmDeger sonuc = {.tur = DEGER_TAM, .deger.tam = a.deger.tam / b.deger.tam};
-            YIGIN_AT(sonuc);
-            break;
-        }
+    KOMUT(SM_DOGRU) {
+        YIGIN_AT(sm_mantik(1));
+        SONRAKI();
+    }
 
-        case SM_MOD: {
-            SmDeger b = YIGIN_AL();
-            SmDeger a = YIGIN_AL();
-            if (b.deger.tam == 0) {
-                fprintf(stderr, "Hata: Sıfıra bölme (mod)\n");
-                return -1;
-            }
-            SmDeger sonuc = {.tur = DEGER_TAM, .deger.tam = a.deger.tam % b.deger.tam};
-            YIGIN_AT(sonuc);
-            break;
-        }
+    KOMUT(SM_YANLIS) {
+        YIGIN_AT(sm_mantik(0));
+        SONRAKI();
+    }
 
-        case SM_EKSI: {
-            SmDeger a = YIGIN_AL();
-            SmDeger sonuc = {.tur = DEGER_TAM, .deger.tam = -a.deger.tam};
-            YIGIN_AT(sonuc);
-            break;
-        }
+    KOMUT(SM_BOS) {
+        YIGIN_AT(SM_BOS_DEGER);
+        SONRAKI();
+    }
 
-        /* ─── Ondalık aritmetik ─── */
+    /* ─── Yığın işlemleri ─── */
 
-        case SM_TOPLA_OND: {
-            SmDeger b = YIGIN_AL();
-            SmDeger a = YIGIN_AL();
-            SmDeger sonuc = {.tur = DEGER_ONDALIK,
-                .deger.ondalik = a.deger.ondalik + b.deger.ondalik};
-            YIGIN_AT(sonuc);
-            break;
-        }
+    KOMUT(SM_CIKAR) {
+        if (sp > alt) deger_birak(yigin[--sp]);
+        SONRAKI();
+    }
 
-        case SM_CIKAR_OND: {
-            SmDeger b = YIGIN_AL();
-            SmDeger a = YIGIN_AL();
-            SmDeger sonuc = {.tur = DEGER_ONDALIK,
-                .deger.ondalik = a.deger.ondalik - b.deger.ondalik};
-            YIGIN_AT(sonuc);
-            break;
+    KOMUT(SM_KOPYALA) {
+        if (sp <= alt) {
+            fprintf(stderr, "Hata: Yığın boş (KOPYALA)\n");
+            goto hata;
         }
+        SmDeger d = yigin[sp - 1];
+        deger_tut(d);
+        YIGIN_AT(d);
+        SONRAKI();
+    }
 
-        case SM_CARP_OND: {
-            SmDeger b = YIGIN_AL();
-            SmDeger a = YIGIN_AL();
-            SmDeger sonuc = {.tur = DEGER_ONDALIK,
-                .deger.ondalik = a.deger.ondalik * b.deger.ondalik};
-            YIGIN_AT(sonuc);
-            break;
-        }
+    /* ─── Tam sayı aritmetik ─── */
 
-        case SM_BOL_OND: {
-            SmDeger b = YIGIN_AL();
-            SmDeger a = YIGIN_AL();
-            if (b.deger.ondalik == 0.0) {
-                fprintf(stderr, "Hata: Sıfıra bölme (ondalık)\n");
-                return -1;
-            }
-            SmDeger sonuc = {.tur = DEGER_ONDALIK,
-                .deger.ondalik = a.deger.ondalik / b.deger.ondalik};
-            YIGIN_AT(sonuc);
-            break;
-        }
+    KOMUT(SM_TOPLA)      { TAM_ISLEM(+); SONRAKI(); }
+    KOMUT(SM_CIKAR_SAYI) { TAM_ISLEM(-); SONRAKI(); }
+    KOMUT(SM_CARP)       { TAM_ISLEM(*); SONRAKI(); }
 
-        case SM_EKSI_OND: {
-            SmDeger a = YIGIN_AL();
-            SmDeger sonuc = {.tur = DEGER_ONDALIK,
-                .deger.ondalik = -a.deger.ondalik};
-            YIGIN_AT(sonuc);
-            break;
+    KOMUT(SM_BOL) {
+        GEREK(2);
+        if (deger_tam(yigin[sp - 1]) == 0) {
+            fprintf(stderr, "Hata: Sıfıra bölme\n");
+            goto hata;
         }
+        TAM_ISLEM(/);
+        SONRAKI();
+    }
 
-        /* ─── Tam sayı karşılaştırma ─── */
-
-        case SM_ESIT: {
-            SmDeger b = YIGIN_AL();
-            SmDeger a = YIGIN_AL();
-            SmDeger sonuc = {.tur = DEGER_MANTIK,
-                .deger.mantik = (a.deger.tam == b.deger.tam)};
-            YIGIN_AT(sonuc);
-            break;
+    KOMUT(SM_MOD) {
+        GEREK(2);
+        if (deger_tam(yigin[sp - 1]) == 0) {
+            fprintf(stderr, "Hata: Sıfıra bölme (mod)\n");
+            goto hata;
         }
+        TAM_ISLEM(%);
+        SONRAKI();
+    }
 
-        case SM_ESIT_DEGIL: {
-            SmDeger b = YIGIN_AL();
-            SmDeger a = YIGIN_AL();
-            SmDeger sonuc = {.tur = DEGER_MANTIK,
-                .deger.mantik = (a.deger.tam != b.deger.tam)};
-            YIGIN_AT(sonuc);
-            break;
-        }
+    KOMUT(SM_EKSI) {
+        GEREK(1);
+        SmDeger a = yigin[sp - 1];
+        yigin[sp - 1] = tam_yap(-deger_tam(a));
+        deger_birak(a);
+        SONRAKI();
+    }
 
-        case SM_KUCUK: {
-            SmDeger b = YIGIN_AL();
-            SmDeger a = YIGIN_AL();
-            SmDeger sonuc = {.tur = DEGER_MANTIK,
-                .deger.mantik = (a.deger.tam < b.deger.tam)};
-            YIGIN_AT(sonuc);
-            break;
-        }
+    /* ─── Ondalık aritmetik ─── */
 
-        case SM_BUYUK: {
-            SmDeger b = YIGIN_AL();
-            SmDeger a = YIGIN_AL();
-            SmDeger sonuc = {.tur = DEGER_MANTIK,
-                .deger.mantik = (a.deger.tam > b.deger.tam)};
-            YIGIN_AT(sonuc);
-            break;
-        }
+    KOMUT(SM_TOPLA_OND) { OND_ISLEM(+); SONRAKI(); }
+    KOMUT(SM_CIKAR_OND) { OND_ISLEM(-); SONRAKI(); }
+    KOMUT(SM_CARP_OND)  { OND_ISLEM(*); SONRAKI(); }
 
-        case SM_KUCUK_ESIT: {
-            SmDeger b = YIGIN_AL();
-            SmDeger a = YIGIN_AL();
-            SmDeger sonuc = {.tur = DEGER_MANTIK,
-                .deger.mantik = (a.deger.tam <= b.deger.tam)};
-            YIGIN_AT(sonuc);
-            break;
+    KOMUT(SM_BOL_OND) {
+        GEREK(2);
+        if (deger_ondalik(yigin[sp - 1]) == 0.0) {
+            fprintf(stderr, "Hata: Sıfıra bölme (ondalık)\n");
+            goto hata;
         }
+        OND_ISLEM(/);
+        SONRAKI();
+    }
 
-        case SM_BUYUK_ESIT: {
-            SmDeger b = YIGIN_AL();
-            SmDeger a = YIGIN_AL();
-            SmDeger sonuc = {.tur = DEGER_MANTIK,
-                .deger.mantik = (a.deger.tam >= b.deger.tam)};
-            YIGIN_AT(sonuc);
-            break;
-        }
+    KOMUT(SM_EKSI_OND) {
+        GEREK(1);
+        SmDeger a = yigin[sp - 1];
+        yigin[sp - 1] = sm_ondalik(-deger_ondalik(a));
+        deger_birak(a);
+        SONRAKI();
+    }
 
-        /* ─── Ondalık karşılaştırma ─── */
+    /* ─── Tam sayı karşılaştırma ─── */
+
+    KOMUT(SM_ESIT)        { KARSILASTIR(deger_tam, ==); SONRAKI(); }
+    KOMUT(SM_ESIT_DEGIL)  { KARSILASTIR(deger_tam, !=); SONRAKI(); }
+    KOMUT(SM_KUCUK)       { KARSILASTIR(deger_tam, <);  SONRAKI(); }
+    KOMUT(SM_BUYUK)       { KARSILASTIR(deger_tam, >);  SONRAKI(); }
+    KOMUT(SM_KUCUK_ESIT)  { KARSILASTIR(deger_tam, <=); SONRAKI(); }
+    KOMUT(SM_BUYUK_ESIT)  { KARSILASTIR(deger_tam, >=); SONRAKI(); }
+
+    /* ─── Ondalık karşılaştırma ─── */
+
+    KOMUT(SM_ESIT_OND)       { KARSILASTIR(deger_ondalik, ==); SONRAKI(); }
+    KOMUT(SM_KUCUK_OND)      { KARSILASTIR(deger_ondalik, <);  SONRAKI(); }
+    KOMUT(SM_BUYUK_OND)      { KARSILASTIR(deger_ondalik, >);  SONRAKI(); }
+    KOMUT(SM_KUCUK_ESIT_OND) { KARSILASTIR(deger_ondalik, <=); SONRAKI(); }
+    KOMUT(SM_BUYUK_ESIT_OND) { KARSILASTIR(deger_ondalik, >=); SONRAKI(); }
+
+    /* ─── Metin karşılaştırma ─── */
+
+    KOMUT(SM_ESIT_METIN) {
+        SmDeger b = YIGIN_AL();
+        SmDeger a = YIGIN_AL();
+        SmMetin *ma = deger_metin(a), *mb = deger_metin(b);
+        int64_t uz_a = ma ? ma->uzunluk : 0;
+        int64_t uz_b = mb ? mb->uzunluk : 0;
+        int esit = uz_a == uz_b &&
+                   (uz_a == 0 || memcmp(ma->veri, mb->veri, uz_a) == 0);
+        deger_birak(a);
+        deger_birak(b);
+        YIGIN_AT(sm_mantik(esit));
+        SONRAKI();
+    }
 
-        case SM_ESIT_OND: {
-            SmDeger b = YIGIN_AL();
-            SmDeger a = YIGIN_AL();
-            SmDeger sonuc = {.tur = DEGER_MANTIK,
-                .deger.mantik = (a.deger.ondalik == b.deger.ondalik)};
-            YIGIN_AT(sonuc);
-            break;
-        }
+    /* ─── Mantık ─── */
 
-        case SM_KUCUK_OND: {
-            SmDeger b = YIGIN_AL();
-            SmDeger a = YIGIN_AL();
-            SmDeger sonuc = {.tur = DEGER_MANTIK,
-                .deger.mantik = (a.deger.ondalik < b.deger.ondalik)};
-            YIGIN_AT(sonuc);
-            break;
-        }
+    KOMUT(SM_DEGIL) {
+        GEREK(1);
+        SmDeger a = yigin[sp - 1];
+        yigin[sp - 1] = sm_mantik(!deger_dogru_mu(a));
+        deger_birak(a);
+        SONRAKI();
+    }
 
-        case SM_BUYUK_OND: {
-            SmDeger b = YIGIN_AL();
-            SmDeger a = YIGIN_AL();
-            SmDeger sonuc = {.tur = DEGER_MANTIK,
-                .deger.mantik = (a.deger.ondalik > b.deger.ondalik)};
-            YIGIN_AT(sonuc);
-            break;
-        }
+    KOMUT(SM_VE) {
+        GEREK(2); sp--;
+        SmDeger a = yigin[sp - 1], b = yigin[sp];
+        yigin[sp - 1] = sm_mantik(deger_dogru_mu(a) && deger_dogru_mu(b));
+        deger_birak(a);
+        deger_birak(b);
+        SONRAKI();
+    }
 
-        case SM_KUCUK_ESIT_OND: {
-            SmDeger b = YIGIN_AL();
-            SmDeger a = YIGIN_AL();
-            SmDeger sonuc = {.tur = DEGER_MANTIK,
-                .deger.mantik = (a.deger.ondalik <= b.deger.ondalik)};
-            YIGIN_AT(sonuc);
-            break;
-        }
+    KOMUT(SM_VEYA) {
+        GEREK(2); sp--;
+        SmDeger a = yigin[sp - 1], b = yigin[sp];
+        yigin[sp - 1] = sm_mantik(deger_dogru_mu(a) || deger_dogru_mu(b));
+        deger_birak(a);
+        deger_birak(b);
+        SONRAKI();
+    }
 
-        case SM_BUYUK_ESIT_OND: {
-            SmDeger b = YIGIN_AL();
-            SmDeger a = YIGIN_AL();
-            SmDeger sonuc = {.tur = DEGER_MANTIK,
-                .deger.mantik = (a.deger.ondalik >= b.deger.ondalik)};
-            YIGIN_AT(sonuc);
-            break;
-        }
+    /* ─── Değişkenler ─── */
 
-        /* ─── Metin karşılaştırma ─── */
+    KOMUT(SM_YUKLE_YEREL) {
+        uint16_t idx = OKU_U16(pc); pc += 2;
+        SmDeger d = idx < yerel_sayisi ? yereller[idx] : SM_BOS_DEGER;
+        deger_tut(d);
+        YIGIN_AT(d);
+        SONRAKI();
+    }
 
-        case SM_ESIT_METIN: {
-            SmDeger b = YIGIN_AL();
-            SmDeger a = YIGIN_AL();
-            int esit = 0;
-            if (a.deger.metin.uzunluk == b.deger.metin.uzunluk) {
-                if (a.deger.metin.uzunluk == 0)
-                    esit = 1;
-                else
-                    esit = (memcmp(a.deger.metin.ptr, b.deger.metin.ptr,
-                                   a.deger.metin.uzunluk) == 0);
+    KOMUT(SM_KAYDET_YEREL) {
+        uint16_t idx = OKU_U16(pc); pc += 2;
+        SmDeger deger = YIGIN_AL();
+        if (BEKLENMEZ(idx >= yerel_sayisi)) {
+            /* Global kapsamda sınır dışı yazma yok sayılır */
+            if (sm->cerceve_sayisi == 0) {
+                deger_birak(deger);
+                SONRAKI();
             }
-            SmDeger sonuc = {.tur = DEGER_MANTIK, .deger.mantik = esit};
-            YIGIN_AT(sonuc);
-            break;
+            sp = yerel_genislet(sm, idx, sp);
+            if (sp < 0) goto yigin_tasmasi;
+            CERCEVE_YENILE();
         }
+        deger_birak(yereller[idx]);
+        yereller[idx] = deger;
+        SONRAKI();
+    }
 
-        /* ─── Mantık ─── */
-
-        case SM_DEGIL: {
-            SmDeger a = YIGIN_AL();
-            SmDeger sonuc = {.tur = DEGER_MANTIK,
-                .deger.mantik = !deger_dogru_mu(&a)};
-            YIGIN_AT(sonuc);
-            break;
-        }
+    KOMUT(SM_YUKLE_GENEL) {
+        uint16_t idx = OKU_U16(pc); pc += 2;
+        SmDeger d = idx < sm->genel_sayisi ? sm->geneller[idx] : SM_BOS_DEGER;
+        deger_tut(d);
+        YIGIN_AT(d);
+        SONRAKI();
+    }
 
-        case SM_VE: {
-            SmDeger b = YIGIN_AL();
-            SmDeger a = YIGIN_AL();
-            SmDeger sonuc = {.tur = DEGER_MANTIK,
-                .deger.mantik = (deger_dogru_mu(&a) && deger_dogru_mu(&b))};
-            YIGIN_AT(sonuc);
-            break;
+    KOMUT(SM_KAYDET_GENEL) {
+        uint16_t idx = OKU_U16(pc); pc += 2;
+        SmDeger deger = YIGIN_AL();
+        if (idx < sm->genel_sayisi) {
+            deger_birak(sm->geneller[idx]);
+            sm->geneller[idx] = deger;
+        } else {
+            deger_birak(deger);
         }
+        SONRAKI();
+    }
 
-        case SM_VEYA: {
-            SmDeger b = YIGIN_AL();
-            SmDeger a = YIGIN_AL();
-            SmDeger sonuc = {.tur = DEGER_MANTIK,
-                .deger.mantik = (deger_dogru_mu(&a) || deger_dogru_mu(&b))};
-            YIGIN_AT(sonuc);
-            break;
+    /* ─── Kontrol akışı ─── */
+
+    KOMUT(SM_ATLA) {
+        int16_t ofset = OKU_I16(pc); pc += 2;
+        pc += ofset;
+#ifdef TRSM_JIT
+        /* Fonksiyon içi geri atlama: sıcak döngüye doğal koddan devam (OSR) */
+        if (BEKLENMEZ(ofset < 0 && sm->jit && sm->cerceve_sayisi > 0)) {
+            jit_hedef = trsm_jit_dongu(sm, &sm->cerceveler[sm->cerceve_sayisi - 1],
+                                       pc, sp - alt);
+            if (jit_hedef) goto jit_gir;
         }
+#endif
+        SONRAKI();
+    }
 
-        /* ─── Değişkenler ─── */
-
-        case SM_YUKLE_YEREL: {
-            uint16_t idx = OKU_U16(sm->pc); sm->pc += 2;
-            if (sm->cerceve_sayisi > 0) {
-                CagriCercevesi *cerceve = &sm->cerceveler[sm->cerceve_sayisi - 1];
-                if (idx < (uint16_t)cerceve->yerel_sayisi) {
-                    YIGIN_AT(cerceve->yereller[idx]);
-                } else {
-                    SmDeger bos = {.tur = DEGER_BOS};
-                    YIGIN_AT(bos);
-                }
-            } else {
-                /* Global kapsamda yerel yok — genelden oku */
-                if (idx < GENEL_MAKS) {
-                    YIGIN_AT(sm->geneller[idx]);
-                } else {
-                    SmDeger bos = {.tur = DEGER_BOS};
-                    YIGIN_AT(bos);
-                }
-            }
-            break;
-        }
+    KOMUT(SM_ATLA_YANLIS) {
+        int16_t ofset = OKU_I16(pc); pc += 2;
+        SmDeger d = YIGIN_AL();
+        if (!deger_dogru_mu(d)) pc += ofset;
+        deger_birak(d);
+        SONRAKI();
+    }
 
-        case SM_KAYDET_YEREL: {
-            uint16_t idx = OKU_U16(sm->pc); sm->pc += 2;
-            SmDeger deger = YIGIN_AL();
-            if (sm->cerceve_sayisi > 0) {
-                CagriCercevesi *cerceve = &sm->cerceveler[sm->cerceve_sayisi - 1];
-                /* Yerel diziyi gerekirse genişlet */
-                if (idx >= (uint16_t)cerceve->yerel_sayisi) {
-                    int yeni_boyut = idx + 1;
-                    cerceve->yereller = realloc(cerceve->yereller,
-                        yeni_boyut * sizeof(SmDeger));
-                    /* Yeni alanları sıfırla */
-                    for (int j = cerceve->yerel_sayisi; j < yeni_boyut; j++) {
-                        cerceve->yereller[j] = (SmDeger){.tur = DEGER_BOS};
-                    }
-                    cerceve->yerel_sayisi = yeni_boyut;
-                }
-                cerceve->yereller[idx] = deger;
-            } else {
-                /* Global kapsamda: genellere yaz */
-                if (idx < GENEL_MAKS) {
-                    sm->geneller[idx] = deger;
-                }
-            }
-            break;
-        }
+    KOMUT(SM_ATLA_DOGRU) {
+        int16_t ofset = OKU_I16(pc); pc += 2;
+        SmDeger d = YIGIN_AL();
+        if (deger_dogru_mu(d)) pc += ofset;
+        deger_birak(d);
+        SONRAKI();
+    }
 
-        case SM_YUKLE_GENEL: {
-            uint16_t idx = OKU_U16(sm->pc); sm->pc += 2;
-            if (idx < GENEL_MAKS) {
-                YIGIN_AT(sm->geneller[idx]);
-            } else {
-                SmDeger bos = {.tur = DEGER_BOS};
-                YIGIN_AT(bos);
-            }
-            break;
-        }
+    /* ─── Fonksiyonlar ─── */
 
-        case SM_KAYDET_GENEL: {
-            uint16_t idx = OKU_U16(sm->pc); sm->pc += 2;
-            SmDeger deger = YIGIN_AL();
-            if (idx < GENEL_MAKS) {
-                sm->geneller[idx] = deger;
-            }
-            break;
-        }
+    KOMUT(SM_CAGRI) {
+        fn = &sm->fonksiyonlar[OKU_U16(pc)];
+        arg_sayisi = pc[2];
+        pc += 3;
+        goto cagri_yap;
+    }
 
-        /* ─── Kontrol akışı ─── */
+    KOMUT(SM_CAGRI_SABIT) {
+        fn = &sm->fonksiyonlar[OKU_U16(pc)];
+        arg_sayisi = fn->param_sayisi;
+        pc += 2;
+        goto cagri_yap;
+    }
 
-        case SM_ATLA: {
-            int16_t ofset = OKU_I16(sm->pc); sm->pc += 2;
-            sm->pc += ofset;
-            break;
+    KOMUT(SM_DONDUR) {
+        if (sm->cerceve_sayisi < 1) {
+            fprintf(stderr, "Hata: Çağrı yığını boş (DONDUR)\n");
+            goto hata;
         }
+        CagriCercevesi *cerceve = &sm->cerceveler[--sm->cerceve_sayisi];
+        CERCEVE_BIRAK(cerceve->taban);
+        pc = cerceve->dondur_adresi;
+        sp = cerceve->taban;
+        CERCEVE_YENILE();
+        SONRAKI();
+    }
 
-        case SM_ATLA_YANLIS: {
-            int16_t ofset = OKU_I16(sm->pc); sm->pc += 2;
-            SmDeger d = YIGIN_AL();
-            if (!deger_dogru_mu(&d)) {
-                sm->pc += ofset;
-            }
-            break;
+    KOMUT(SM_DONDUR_DEGER) {
+        if (sm->cerceve_sayisi < 1) {
+            fprintf(stderr, "Hata: Çağrı yığını boş (DONDUR_DEGER)\n");
+            goto hata;
         }
+        SmDeger dondur_degeri = YIGIN_AL();
+        CagriCercevesi *cerceve = &sm->cerceveler[--sm->cerceve_sayisi];
+        CERCEVE_BIRAK(cerceve->taban);
+        pc = cerceve->dondur_adresi;
+        sp = cerceve->taban;
+        CERCEVE_YENILE();
+        YIGIN_AT(dondur_degeri);
+        SONRAKI();
+    }
 
-        case SM_ATLA_DOGRU: {
-            int16_t ofset = OKU_I16(sm->pc); sm->pc += 2;
-            SmDeger d = YIGIN_AL();
-            if (deger_dogru_mu(&d)) {
-                sm->pc += ofset;
-            }
-            break;
-        }
+    /* ─── Yerleşik fonksiyonlar ─── */
 
-        /* ─── Fonksiyonlar ─── */
+    KOMUT(SM_YAZDIR) {
+        SmDeger d = YIGIN_AL();
+        deger_yazdir(d);
+        deger_birak(d);
+        SONRAKI();
+    }
 
-        case SM_CAGRI: {
-            uint16_t fn_idx = OKU_U16(sm->pc); sm->pc += 2;
-            uint8_t arg_sayisi = *sm->pc++;
+    KOMUT(SM_YAZDIR_SATIR) {
+        SmDeger d = YIGIN_AL();
+        deger_yazdir(d);
+        printf("\n");
+        deger_birak(d);
+        SONRAKI();
+    }
 
-            if (fn_idx >= (uint16_t)sm->fonksiyon_sayisi) {
-                fprintf(stderr, "Hata: Fonksiyon indeksi sınır dışı: %d\n", fn_idx);
-                return -1;
-            }
-            if (sm->cerceve_sayisi >= CERCEVE_MAKS) {
-                fprintf(stderr, "Hata: Çağrı yığını taşması\n");
-                return -1;
-            }
+    /* ─── Metin ─── */
 
-            SmFonksiyon *fn = &sm->fonksiyonlar[fn_idx];
-            CagriCercevesi *cerceve = &sm->cerceveler[sm->cerceve_sayisi++];
-            cerceve->fonksiyon = fn;
-            cerceve->dondur_adresi = sm->pc;
-            cerceve->yigin_tabani = sm->sp - arg_sayisi;
-
-            /* Yerel değişkenler için bellek ayır */
-            int yerel_boyut = fn->yerel_sayisi > arg_sayisi ?
-                              fn->yerel_sayisi : arg_sayisi;
-            if (yerel_boyut < 1) yerel_boyut = 1;
-            cerceve->yereller = malloc(yerel_boyut * sizeof(SmDeger));
-            cerceve->yerel_sayisi = yerel_boyut;
-
-            /* Yerel değişkenleri sıfırla */
-            for (int i = 0; i < yerel_boyut; i++) {
-                cerceve->yereller[i] = (SmDeger){.tur = DEGER_BOS};
-            }
+    KOMUT(SM_METIN_BIRLESTIR) {
+        SmDeger b = YIGIN_AL();
+        SmDeger a = YIGIN_AL();
+        SmDeger sonuc = metin_birlestir(a, b);
+        deger_birak(a);
+        deger_birak(b);
+        YIGIN_AT(sonuc);
+        SONRAKI();
+    }
 
-            /* Argümanları yerel değişkenlere kopyala */
-            for (int i = 0; i < arg_sayisi; i++) {
-                int yigin_pos = cerceve->yigin_tabani + i;
-                if (yigin_pos >= 0 && yigin_pos < YIGIN_MAKS) {
-                    cerceve->yereller[i] = sm->yigin[yigin_pos];
-                }
-            }
+    /* ─── Tip dönüşümleri ─── */
 
-            /* Yığın işaretçisini argümanlardan önceye geri al */
-            sm->sp = cerceve->yigin_tabani;
+    KOMUT(SM_TAM_ONDALIK) {
+        GEREK(1);
+        SmDeger a = yigin[sp - 1];
+        yigin[sp - 1] = sm_ondalik((double)deger_tam(a));
+        deger_birak(a);
+        SONRAKI();
+    }
 
-            /* PC'yi fonksiyon gövdesine ayarla */
-            sm->pc = sm->kod + fn->kod_baslangic;
-            break;
-        }
+    KOMUT(SM_ONDALIK_TAM) {
+        GEREK(1);
+        SmDeger a = yigin[sp - 1];
+        yigin[sp - 1] = tam_yap((int64_t)deger_ondalik(a));
+        deger_birak(a);
+        SONRAKI();
+    }
 
-        case SM_DONDUR: {
-            if (sm->cerceve_sayisi < 1) {
-                fprintf(stderr, "Hata: Çağrı yığını boş (DONDUR)\n");
-                return -1;
-            }
-            CagriCercevesi *cerceve = &sm->cerceveler[--sm->cerceve_sayisi];
-            sm->pc = cerceve->dondur_adresi;
-            sm->sp = cerceve->yigin_tabani;
-            free(cerceve->yereller);
+    KOMUT(SM_TAM_METIN) {
+        SmDeger a = YIGIN_AL();
+        SmDeger sonuc;
+        switch (deger_turu(a)) {
+        case DEGER_TAM:
+            sonuc = tam_metine(deger_tam(a));
             break;
-        }
-
-        case SM_DONDUR_DEGER: {
-            if (sm->cerceve_sayisi < 1) {
-                fprintf(stderr, "Hata: Çağrı yığını boş (DONDUR_DEGER)\n");
-                return -1;
-            }
-            SmDeger dondur_degeri = YIGIN_AL();
-            CagriCercevesi *cerceve = &sm->cerceveler[--sm->cerceve_sayisi];
-            sm->pc = cerceve->dondur_adresi;
-            sm->sp = cerceve->yigin_tabani;
-            free(cerceve->yereller);
-            YIGIN_AT(dondur_degeri);
+        case DEGER_ONDALIK: {
+            char buf[64];
+            int uzunluk = snprintf(buf, sizeof(buf), "%g", sm_ondalik_al(a));
+            sonuc = metin_yap(buf, uzunluk);
             break;
         }
-
-        /* ─── Yerleşik fonksiyonlar ─── */
-
-        case SM_YAZDIR: {
-            SmDeger d = YIGIN_AL();
-            deger_yazdir(&d);
+        case DEGER_MANTIK: {
+            const char *m = (a & 1) ? "doğru" : "yanlış";
+            sonuc = metin_yap(m, (int64_t)strlen(m));
             break;
         }
-
-        case SM_YAZDIR_SATIR: {
-            SmDeger d = YIGIN_AL();
-            deger_yazdir(&d);
-            printf("\n");
+        default:
+            sonuc = tam_metine(0);
             break;
         }
+        deger_birak(a);
+        YIGIN_AT(sonuc);
+        SONRAKI();
+    }
 
-        /* ─── Metin ─── */
+    KOMUT(SM_METIN_TAM) {
+        SmDeger a = YIGIN_AL();
+        SmMetin *m = deger_metin(a);
+        int64_t deger = m ? strtoll(m->veri, NULL, 10) : 0;
+        deger_birak(a);
+        YIGIN_AT(tam_yap(deger));
+        SONRAKI();
+    }
 
-        case SM_METIN_BIRLESTIR: {
-            SmDeger b = YIGIN_AL();
-            SmDeger a = YIGIN_AL();
-            SmDeger sonuc = metin_birlestir(&a, &b);
-            YIGIN_AT(sonuc);
-            break;
+    /* ─── Birleşik komutlar ─── */
+
+    KOMUT(SM_TOPLA_YEREL) {
+        uint16_t idx = OKU_U16(pc); pc += 2;
+        GEREK(1);
+        SmDeger a = yigin[sp - 1];
+        SmDeger b = idx < yerel_sayisi ? yereller[idx] : SM_BOS_DEGER;
+        if (!IKI_KISA_TAM(a, b) ||
+            !kisa_tam_topla(a, KISA_TAM_UST(b), &yigin[sp - 1])) {
+            yigin[sp - 1] = tam_yap(deger_tam(a) + deger_tam(b));
+            deger_birak(a);
         }
+        SONRAKI();
+    }
 
-        /* ─── Tip dönüşümleri ─── */
-
-        case SM_TAM_ONDALIK: {
-            SmDeger a = YIGIN_AL();
-            SmDeger sonuc = {.tur = DEGER_ONDALIK,
-                .deger.ondalik = (double)a.deger.tam};
-            YIGIN_AT(sonuc);
-            break;
+    KOMUT(SM_TOPLA_GENEL) {
+        uint16_t idx = OKU_U16(pc); pc += 2;
+        GEREK(1);
+        SmDeger a = yigin[sp - 1];
+        SmDeger b = idx < sm->genel_sayisi ? sm->geneller[idx] : SM_BOS_DEGER;
+        if (!IKI_KISA_TAM(a, b) ||
+            !kisa_tam_topla(a, KISA_TAM_UST(b), &yigin[sp - 1])) {
+            yigin[sp - 1] = tam_yap(deger_tam(a) + deger_tam(b));
+            deger_birak(a);
         }
+        SONRAKI();
+    }
 
-        case SM_ONDALIK_TAM: {
-            SmDeger a = YIGIN_AL();
-            SmDeger sonuc = {.tur = DEGER_TAM,
-                .deger.tam = (int64_t)a.deger.ondalik};
-            YIGIN_AT(sonuc);
-            break;
+    KOMUT(SM_ARTIR_YEREL) {
+        uint16_t idx = OKU_U16(pc);
+        int16_t artis = OKU_I16(pc + 2);
+        pc += 4;
+        if (BEKLENMEZ(idx >= yerel_sayisi)) {
+            /* YUKLE(boş) + KAYDET ile aynı: global kapsamda yok sayılır */
+            if (sm->cerceve_sayisi == 0) SONRAKI();
+            sp = yerel_genislet(sm, idx, sp);
+            if (sp < 0) goto yigin_tasmasi;
+            CERCEVE_YENILE();
+        }
+        SmDeger eski = yereller[idx];
+        if (!sm_tam_kisa_mi(eski) ||
+            !kisa_tam_topla(eski, KISA_TAM_UST((uint64_t)artis), &yereller[idx])) {
+            yereller[idx] = tam_yap(deger_tam(eski) + artis);
+            deger_birak(eski);
         }
+        SONRAKI();
+    }
 
-        case SM_TAM_METIN: {
-            SmDeger a = YIGIN_AL();
-            SmDeger sonuc;
-            if (a.tur == DEGER_TAM) {
-                sonuc = tam_metine(a.deger.tam);
-            } else if (a.tur == DEGER_ONDALIK) {
-                char buf[64];
-                int uzunluk = snprintf(buf, sizeof(buf), "%g", a.deger.ondalik);
-                char *kopya = malloc(uzunluk + 1);
-                memcpy(kopya, buf, uzunluk + 1);
-                sonuc.tur = DEGER_METIN;
-                sonuc.deger.metin.ptr = kopya;
-                sonuc.deger.metin.uzunluk = uzunluk;
-            } else if (a.tur == DEGER_MANTIK) {
-                const char *m = a.deger.mantik ? "doğru" : "yanlış";
-                int uz = (int)strlen(m);
-                char *kopya = malloc(uz + 1);
-                memcpy(kopya, m, uz + 1);
-                sonuc.tur = DEGER_METIN;
-                sonuc.deger.metin.ptr = kopya;
-                sonuc.deger.metin.uzunluk = uz;
-            } else {
-                sonuc = tam_metine(0);
+    KOMUT(SM_ARTIR_GENEL) {
+        uint16_t idx = OKU_U16(pc);
+        int16_t artis = OKU_I16(pc + 2);
+        pc += 4;
+        if (idx < sm->genel_sayisi) {
+            SmDeger eski = sm->geneller[idx];
+            if (!sm_tam_kisa_mi(eski) ||
+                !kisa_tam_topla(eski, KISA_TAM_UST((uint64_t)artis), &sm->geneller[idx])) {
+                sm->geneller[idx] = tam_yap(deger_tam(eski) + artis);
+                deger_birak(eski);
             }
-            YIGIN_AT(sonuc);
-            break;
         }
+        SONRAKI();
+    }
+
+    KOMUT(SM_ESIT_ATLA_YANLIS)       { KARSILASTIR_ATLA(==); SONRAKI(); }
+    KOMUT(SM_ESIT_DEGIL_ATLA_YANLIS) { KARSILASTIR_ATLA(!=); SONRAKI(); }
+    KOMUT(SM_KUCUK_ATLA_YANLIS)      { KARSILASTIR_ATLA(<);  SONRAKI(); }
+    KOMUT(SM_BUYUK_ATLA_YANLIS)      { KARSILASTIR_ATLA(>);  SONRAKI(); }
+    KOMUT(SM_KUCUK_ESIT_ATLA_YANLIS) { KARSILASTIR_ATLA(<=); SONRAKI(); }
+    KOMUT(SM_BUYUK_ESIT_ATLA_YANLIS) { KARSILASTIR_ATLA(>=); SONRAKI(); }
 
-        case SM_METIN_TAM: {
-            SmDeger a = YIGIN_AL();
-            int64_t deger = 0;
-            if (a.tur == DEGER_METIN && a.deger.metin.ptr) {
-                deger = strtoll(a.deger.metin.ptr, NULL, 10);
+    /* ─── Program sonu ─── */
+
+    KOMUT(SM_DUR) {
+        sm->pc = pc;
+        sm->sp = sp;
+        return 0;
+    }
+
+    GECERSIZ {
+        fprintf(stderr, "Hata: Bilinmeyen komut: %d (PC: %ld)\n",
+                pc[-1], (long)(pc - sm->kod - 1));
+        goto hata;
+    }
+
+    DAGITIM_SONU
+
+    /* Çağrı: argümanlar yığının tepesinde kalır ve çerçevenin ilk yerelleri
+     * olur; yalnızca argüman olmayan yereller boşla doldurulur. */
+cagri_yap: {
+        if (BEKLENMEZ(sm_fonksiyon_harici_mi(fn))) goto harici_cagri;
+        GEREK(arg_sayisi);
+        if (BEKLENMEZ(sm->cerceve_sayisi >= sm->cerceve_kapasite)) {
+            int yeni = sm->cerceve_kapasite * 2;
+            CagriCercevesi *c = yeni <= CERCEVE_SINIR ?
+                realloc(sm->cerceveler, yeni * sizeof(CagriCercevesi)) : NULL;
+            if (!c) {
+                fprintf(stderr, "Hata: Çağrı yığını taşması\n");
+                goto hata;
             }
-            SmDeger sonuc = {.tur = DEGER_TAM, .deger.tam = deger};
-            YIGIN_AT(sonuc);
-            break;
+            sm->cerceveler = c;
+            sm->cerceve_kapasite = yeni;
         }
 
-        /* ─── Program sonu ─── */
-
-        case SM_DUR:
-            return 0;
+        int taban = sp - arg_sayisi;
+        int yerel_boyut = fn->yerel_sayisi > arg_sayisi ?
+                          fn->yerel_sayisi : arg_sayisi;
+        if (yerel_boyut < 1) yerel_boyut = 1;
+        if (BEKLENMEZ(taban + yerel_boyut > yigin_kapasite)) {
+            if (yigin_ayir(sm, taban + yerel_boyut) < 0) goto yigin_tasmasi;
+            yigin = sm->yigin;
+            yigin_kapasite = sm->yigin_kapasite;
+        }
+        for (int i = arg_sayisi; i < yerel_boyut; i++)
+            yigin[taban + i] = SM_BOS_DEGER;
+
+        CagriCercevesi *cerceve = &sm->cerceveler[sm->cerceve_sayisi++];
+        cerceve->fonksiyon = fn;
+        cerceve->dondur_adresi = pc;
+        cerceve->taban = taban;
+        cerceve->yerel_sayisi = yerel_boyut;
+
+        pc = sm->kod + fn->kod_baslangic;
+        sp = taban + yerel_boyut;
+        yereller = yigin + taban;
+        yerel_sayisi = yerel_boyut;
+        alt = sp;
+#ifdef TRSM_JIT
+        if (sm->jit && (jit_hedef = trsm_jit_cagri(sm, cerceve)) != NULL)
+            goto jit_gir;
+#endif
+        SONRAKI_DIS();
+    }
 
-        default:
-            fprintf(stderr, "Hata: Bilinmeyen komut: %d (PC: %ld)\n",
-                    komut, (long)(sm->pc - sm->kod - 1));
-            return -1;
+    /* Harici fonksiyon: argümanlar ödünç verilir, sonuç yığına konur.
+     * Bağlanmamış harici fonksiyon 0 döndürür. */
+harici_cagri: {
+        GEREK(arg_sayisi);
+        struct TrsmHarici *h = sm->harici ? &sm->harici[fn - sm->fonksiyonlar] : NULL;
+        SmDeger sonuc = SM_BOS_DEGER;
+        int durum = 0;
+        sm->sp = sp;
+        if (h && h->fn)
+            durum = h->fn(sm, yigin + sp - arg_sayisi, arg_sayisi, &sonuc, h->veri);
+        else
+            sonuc = tam_yap(0);
+        for (int i = 0; i < arg_sayisi; i++) deger_birak(yigin[--sp]);
+        if (durum != 0) {
+            fprintf(stderr, "Hata: Harici fonksiyon başarısız: %s\n", fn->isim);
+            deger_birak(sonuc);
+            goto hata;
         }
+        YIGIN_AT(sonuc);
+        SONRAKI_DIS();
     }
 
+#ifdef TRSM_JIT
+    /* Doğal kod üst çerçeve dönene ya da deopt edene kadar çalışır; ardından
+     * yorumlayıcı dönüş adresinden ya da deopt edilen komuttan sürdürür. */
+jit_gir: {
+        uint8_t *donus = sm->cerceveler[sm->cerceve_sayisi - 1].dondur_adresi;
+        int durum = trsm_jit_gir(sm, yereller, jit_hedef);
+        pc = durum == JIT_DONDU ? donus : sm->jit_pc;
+        sp = (int)(sm->jit_sp - sm->yigin);
+        CERCEVE_YENILE();
+        SONRAKI_DIS();
+    }
+#endif
+
+yigin_tasmasi:
+    fprintf(stderr, "Hata: Yığın taşması\n");
+hata:
+    sm->sp = sp < 0 ? 0 : sp;
+    return -1;
+
+    #undef CERCEVE_YENILE
+    #undef YIGIN_YER_AC
     #undef YIGIN_AT
     #undef YIGIN_AL
+    #undef GEREK
+    #undef TAM_ISLEM
+    #undef OND_ISLEM
+    #undef KARSILASTIR
+    #undef KARSILASTIR_ATLA
+    #undef CERCEVE_BIRAK
+    #undef KOMUT
+    #undef SONRAKI
+    #undef SONRAKI_DIS
+    #undef DAGITIM_BASLA
+    #undef DAGITIM_SONU
+    #undef GECERSIZ
 }
 
 /* ═══════════════════════════════════════════════════════════════════
- *  TEMİZLİK
+ *  MODÜL
  * ═══════════════════════════════════════════════════════════════════ */
 
-static void trsm_temizle(TrSM *sm) {
-    /* Sabit havuzu */
-    if (sm->sabitler) {
-        for (int i = 0; i < sm->sabit_sayisi; i++) {
-            if (sm->sabitler[i].tur == DEGER_METIN && sm->sabitler[i].deger.metin.ptr)
-                free(sm->sabitler[i].deger.metin.ptr);
-        }
-        free(sm->sabitler);
-    }
+static void modul_temizle(TrsmModul *m) {
+    /* Sabit havuzu (nesneleri tek blokta) */
+    free(m->sabitler);
+    free(m->sabit_blok);
 
-    /* Fonksiyon tablosu */
-    if (sm->fonksiyonlar) {
-        for (int i = 0; i < sm->fonksiyon_sayisi; i++) {
-            if (sm->fonksiyonlar[i].isim)
-                free(sm->fonksiyonlar[i].isim);
-        }
-        free(sm->fonksiyonlar);
+    /* Fonksiyon tablosu (v3'te isimler görüntünün içinde) */
+    if (m->fonksiyonlar) {
+        for (int i = 0; i < m->fonksiyon_sayisi && !m->eslem; i++)
+            free(m->fonksiyonlar[i].isim);
+        free(m->fonksiyonlar);
     }
 
     /* Bytecode */
-    if (sm->kod) free(sm->kod);
+    if (m->eslem) {
+        if (m->eslem_kopya) free((void *)m->eslem);
+        else munmap((void *)m->eslem, m->eslem_boyu);
+    } else {
+        free(m->kod);
+    }
+    free(m);
+}
 
-    /* Kalan çağrı çerçevelerini temizle */
-    for (int i = 0; i < sm->cerceve_sayisi; i++) {
-        if (sm->cerceveler[i].yereller)
-            free(sm->cerceveler[i].yereller);
+TrsmModul *trsm_modul_yukle(const char *yol) {
+    size_t boyut;
+    uint8_t *veri = dosya_esle(yol, &boyut);
+    if (!veri) return NULL;
+
+    TrsmModul *m = calloc(1, sizeof(TrsmModul));
+    if (!m) {
+        munmap(veri, boyut);
+        return NULL;
     }
+    int durum = trbc_yukle(m, veri, boyut);
+    /* v1/v2 kopyalanarak yüklendi; v3 eşlemi modülle birlikte bırakılır */
+    if (!m->eslem) munmap(veri, boyut);
+    if (durum != 0) {
+        modul_temizle(m);
+        return NULL;
+    }
+    m->referans = 1;
+    return m;
+}
+
+TrsmModul *trsm_modul_bellekten(const void *veri, size_t boyut) {
+    /* v3 görüntüsü yerinde kullanılacağından hizalı bir kopya alınır */
+    uint8_t *kopya = malloc(boyut ? boyut : 1);
+    TrsmModul *m = calloc(1, sizeof(TrsmModul));
+    if (!kopya || !m) {
+        free(kopya);
+        free(m);
+        return NULL;
+    }
+    memcpy(kopya, veri, boyut);
+    int durum = trbc_yukle(m, kopya, boyut);
+    if (m->eslem) m->eslem_kopya = 1;
+    else free(kopya);
+    if (durum != 0) {
+        modul_temizle(m);
+        return NULL;
+    }
+    m->referans = 1;
+    return m;
+}
+
+void trsm_modul_tut(TrsmModul *m) {
+    __atomic_fetch_add(&m->referans, 1, __ATOMIC_RELAXED);
+}
+
+void trsm_modul_birak(TrsmModul *m) {
+    if (m && __atomic_sub_fetch(&m->referans, 1, __ATOMIC_ACQ_REL) == 0)
+        modul_temizle(m);
 }
 
 /* ═══════════════════════════════════════════════════════════════════
- *  ANA GİRİŞ NOKTASI
+ *  MAKİNE
  * ═══════════════════════════════════════════════════════════════════ */
 
-int main(int argc, char **argv) {
-    if (argc < 2) {
-        fprintf(stderr, "Tonyukuk Sanal Makinesi (TrSM) v%d\n", TRBC_VERSIYON);
-        fprintf(stderr, "Kullanım: trsm <dosya.trbc>\n");
-        return 1;
+TrSM *trsm_olustur(TrsmModul *m) {
+    TrSM *sm = calloc(1, sizeof(TrSM));
+    if (!sm) return NULL;
+    sm->geneller = malloc((size_t)m->genel_sayisi * sizeof(SmDeger));
+    if (!sm->geneller) {
+        free(sm);
+        return NULL;
     }
+    for (int i = 0; i < m->genel_sayisi; i++) sm->geneller[i] = SM_BOS_DEGER;
+    sm->genel_sayisi = m->genel_sayisi;
+
+    trsm_modul_tut(m);
+    sm->modul = m;
+    sm->kod = m->kod;
+    sm->kod_uzunluk = m->kod_uzunluk;
+    sm->sabitler = m->sabitler;
+    sm->sabit_sayisi = m->sabit_sayisi;
+    sm->fonksiyonlar = m->fonksiyonlar;
+    sm->fonksiyon_sayisi = m->fonksiyon_sayisi;
+    return sm;
+}
 
-    const char *dosya_yolu = argv[1];
+/* Yığında kalan değerleri bırak, çağrı yığınını boşalt */
+static void yigin_bosalt(TrSM *sm) {
+    for (int i = 0; i < sm->sp; i++) deger_birak(sm->yigin[i]);
+    sm->sp = 0;
+    sm->cerceve_sayisi = 0;
+}
 
-    /* Dosyayı oku */
-    int boyut;
-    uint8_t *veri = dosya_oku(dosya_yolu, &boyut);
-    if (!veri) return 1;
+void trsm_sifirla(TrSM *sm) {
+    for (int i = 0; i < sm->genel_sayisi; i++) {
+        deger_birak(sm->geneller[i]);
+        sm->geneller[i] = SM_BOS_DEGER;
+    }
+    yigin_bosalt(sm);
+}
 
-    /* VM'i başlat */
-    TrSM sm;
-    memset(&sm, 0, sizeof(sm));
+void trsm_yok_et(TrSM *sm) {
+    if (!sm) return;
+    trsm_sifirla(sm);
+    trsm_jit_kapat(sm);
+    free(sm->geneller);
+    free(sm->yigin);
+    free(sm->cerceveler);
+    free(sm->harici);
+    trsm_modul_birak((TrsmModul *)sm->modul);
+    free(sm);
+}
 
-    if (trbc_yukle(&sm, veri, boyut) != 0) {
-        free(veri);
-        fprintf(stderr, "Hata: Bytecode dosyası yüklenemedi\n");
-        return 1;
+int trsm_calistir(TrSM *sm) {
+    if (sm->calisiyor) {
+        fprintf(stderr, "Hata: Makine zaten çalışıyor\n");
+        return -1;
     }
-    free(veri); /* ham veri artık gerekli değil */
+    yigin_bosalt(sm);
+    sm->calisiyor = 1;
+    int durum = trsm_yurut(sm, sm->kod, 0);
+    sm->calisiyor = 0;
+    if (durum != 0) yigin_bosalt(sm);
+    return durum;
+}
 
-    /* Çalıştır */
-    int sonuc = trsm_calistir(&sm);
+static SmFonksiyon *fonksiyon_bul(TrSM *sm, const char *isim) {
+    for (int i = 0; i < sm->fonksiyon_sayisi; i++) {
+        SmFonksiyon *fn = &sm->fonksiyonlar[i];
+        if (fn->isim && strcmp(fn->isim, isim) == 0) return fn;
+    }
+    return NULL;
+}
 
-    /* Temizle */
-    trsm_temizle(&sm);
+int trsm_cagir(TrSM *sm, const char *isim, const TrsmDeger *argumanlar,
+               int arg_sayisi, TrsmDeger *sonuc) {
+    SmFonksiyon *fn = fonksiyon_bul(sm, isim);
+    if (!fn || sm_fonksiyon_harici_mi(fn)) {
+        fprintf(stderr, "Hata: Fonksiyon bulunamadı: %s\n", isim);
+        return -1;
+    }
+    if (sm->calisiyor) {
+        fprintf(stderr, "Hata: Makine zaten çalışıyor\n");
+        return -1;
+    }
+    if (arg_sayisi < 0) arg_sayisi = 0;
+
+    /* Çerçeveyi cagri_yap gibi kur: argümanlar ilk yereller, dönüş dur_komutu */
+    int taban = sm->sp;
+    int cerceve_taban = sm->cerceve_sayisi;
+    int yerel_boyut = fn->yerel_sayisi > arg_sayisi ? fn->yerel_sayisi : arg_sayisi;
+    if (yerel_boyut < 1) yerel_boyut = 1;
+    if (yigin_ayir(sm, taban + yerel_boyut + YIGIN_BASLANGIC) < 0) {
+        fprintf(stderr, "Hata: Yığın taşması\n");
+        return -1;
+    }
+    if (sm->cerceve_sayisi >= sm->cerceve_kapasite) {
+        int yeni = sm->cerceve_kapasite ? sm->cerceve_kapasite * 2 : CERCEVE_BASLANGIC;
+        CagriCercevesi *c = realloc(sm->cerceveler, yeni * sizeof(CagriCercevesi));
+        if (!c) {
+            fprintf(stderr, "Hata: Çağrı yığını taşması\n");
+            return -1;
+        }
+        sm->cerceveler = c;
+        sm->cerceve_kapasite = yeni;
+    }
+    for (int i = 0; i < arg_sayisi; i++) {
+        deger_tut(argumanlar[i]);
+        sm->yigin[taban + i] = argumanlar[i];
+    }
+    for (int i = arg_sayisi; i < yerel_boyut; i++)
+        sm->yigin[taban + i] = SM_BOS_DEGER;
+
+    CagriCercevesi *cerceve = &sm->cerceveler[sm->cerceve_sayisi++];
+    cerceve->fonksiyon = fn;
+    cerceve->dondur_adresi = dur_komutu;
+    cerceve->taban = taban;
+    cerceve->yerel_sayisi = yerel_boyut;
+
+    sm->calisiyor = 1;
+    int durum = trsm_yurut(sm, sm->kod + fn->kod_baslangic, taban + yerel_boyut);
+    sm->calisiyor = 0;
+
+    /* Dönüş değeri (varsa) tabanın üstündedir; kalanlar bırakılır */
+    SmDeger d = SM_BOS_DEGER;
+    if (durum == 0 && sm->sp > taban) {
+        d = sm->yigin[--sm->sp];
+    }
+    while (sm->sp > taban) deger_birak(sm->yigin[--sm->sp]);
+    sm->cerceve_sayisi = cerceve_taban;
+
+    if (sonuc) *sonuc = d;
+    else deger_birak(d);
+    return durum;
+}
+
+int trsm_harici_kaydet(TrSM *sm, const char *isim, TrsmHariciFn fn, void *veri) {
+    SmFonksiyon *f = fonksiyon_bul(sm, isim);
+    if (!f || !sm_fonksiyon_harici_mi(f)) return -1;
+    if (!sm->harici) {
+        sm->harici = calloc(sm->fonksiyon_sayisi, sizeof(struct TrsmHarici));
+        if (!sm->harici) return -1;
+    }
+    sm->harici[f - sm->fonksiyonlar].fn = fn;
+    sm->harici[f - sm->fonksiyonlar].veri = veri;
+    return 0;
+}
+
+/* ═══════════════════════════════════════════════════════════════════
+ *  DEĞERLER
+ * ═══════════════════════════════════════════════════════════════════ */
 
-    return sonuc;
+_Static_assert(sizeof(TrsmDeger) == sizeof(SmDeger), "TrsmDeger SmDeger ile aynı boyda olmalı");
+_Static_assert((int)TRSM_TUR_BOS == (int)DEGER_BOS && (int)TRSM_TUR_TAM == (int)DEGER_TAM &&
+               (int)TRSM_TUR_ONDALIK == (int)DEGER_ONDALIK &&
+               (int)TRSM_TUR_METIN == (int)DEGER_METIN &&
+               (int)TRSM_TUR_MANTIK == (int)DEGER_MANTIK, "trsm.h türleri DegerTuru ile uyuşmalı");
+
+TrsmDeger trsm_bos(void)              { return SM_BOS_DEGER; }
+TrsmDeger trsm_tam(int64_t x)         { return tam_yap(x); }
+TrsmDeger trsm_ondalik(double x)      { return sm_ondalik(x); }
+TrsmDeger trsm_mantik(int x)          { return sm_mantik(x != 0); }
+
+TrsmDeger trsm_metin(const char *s, size_t uzunluk) {
+    return metin_yap(s, (int64_t)uzunluk);
+}
+
+int     trsm_tur(TrsmDeger d)         { return (int)deger_turu(d); }
+int64_t trsm_tam_al(TrsmDeger d)      { return deger_tam(d); }
+double  trsm_ondalik_al(TrsmDeger d)  { return deger_ondalik(d); }
+
+const char *trsm_metin_al(TrsmDeger d, size_t *uzunluk) {
+    if (deger_turu(d) != DEGER_METIN) return NULL;
+    SmMetin *m = deger_metin(d);
+    if (uzunluk) *uzunluk = (size_t)m->uzunluk;
+    return m->veri;
 }
+
+void trsm_tut(TrsmDeger d)            { deger_tut(d); }
+void trsm_birak(TrsmDeger d)          { deger_birak(d); }
@@ -0,0 +1,104 @@
+/*
+ * Tonyukuk Sanal Makinesi — Gömme API'si (libtrsm.a)
+ *
+ * Bir .trbc bir kez modül olarak yüklenir ve istenen sayıda makine (TrSM)
+ * tarafından paylaşılır: kod, sabitler ve fonksiyon tablosu modülde tek
+ * kopyadır. Makine başına yalnızca globaller ile küçük başlayıp gerektikçe
+ * büyüyen değer ve çağrı yığınları ayrılır.
+ *
+ *     TrsmModul *m = trsm_modul_yukle("betik.trbc");
+ *     TrSM *sm = trsm_olustur(m);
+ *     trsm_harici_kaydet(sm, "kiraci_adi", kiraci_adi, kiraci);
+ *     trsm_calistir(sm);                  // üst düzey kod, globalleri kurar
+ *     TrsmDeger arg = trsm_tam(42), sonuc;
+ *     if (trsm_cagir(sm, "isle", &arg, 1, &sonuc) == 0) trsm_birak(sonuc);
+ *     trsm_sifirla(sm);                   // sonraki çalıştırmadan önce
+ *     trsm_yok_et(sm);
+ *     trsm_modul_birak(m);
+ *
+ * Bir makine aynı anda tek iş parçacığından kullanılır; aynı modülü
+ * paylaşan farklı makineler farklı iş parçacıklarında çalışabilir. Metin
+ * değerleri onları yaratan makineye aittir, makineler arasında taşınmaz.
+ * Hatalar stderr'e yazılır ve -1 / NULL ile bildirilir.
+ */
+#ifndef TRSM_H
+#define TRSM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct TrsmModul TrsmModul;
+typedef struct TrSM TrSM;
+
+/* NaN kutulu değer (vm.h'deki SmDeger) */
+typedef uint64_t TrsmDeger;
+
+/* trsm_tur sonuçları (vm.h DegerTuru ile aynı sıra) */
+enum {
+    TRSM_TUR_BOS,
+    TRSM_TUR_TAM,
+    TRSM_TUR_ONDALIK,
+    TRSM_TUR_METIN,
+    TRSM_TUR_MANTIK,
+};
+
+/* ─── Modül ─── */
+
+/* .trbc dosyasını yükle (v3 yerinde eşlenir); referans sayısı 1 */
+TrsmModul *trsm_modul_yukle(const char *yol);
+
+/* Bellekteki .trbc görüntüsünden yükle; veri kopyalanır */
+TrsmModul *trsm_modul_bellekten(const void *veri, size_t boyut);
+
+void trsm_modul_tut(TrsmModul *m);
+void trsm_modul_birak(TrsmModul *m);
+
+/* ─── Makine ─── */
+
+/* Modüle bir referans alır; yığınlar ilk çalıştırmada ayrılır */
+TrSM *trsm_olustur(TrsmModul *m);
+void  trsm_yok_et(TrSM *sm);
+
+/* Globalleri boşalt, yığınları sıfırla (ayrılmış bellek korunur) */
+void  trsm_sifirla(TrSM *sm);
+
+/* Modülün üst düzey kodunu baştan çalıştır */
+int   trsm_calistir(TrSM *sm);
+
+/*
+ * İsimle fonksiyon çağır. Argümanlar ödünç alınır; *sonuc (NULL değilse)
+ * çağırana aittir ve trsm_birak ile bırakılır. Hata ya da bulunamayan
+ * fonksiyonda -1.
+ */
+int   trsm_cagir(TrSM *sm, const char *isim, const TrsmDeger *argumanlar,
+                 int arg_sayisi, TrsmDeger *sonuc);
+
+/*
+ * Harici (ana program) fonksiyonu: betikte gövdesiz `@harici işlev` olarak
+ * bildirilir; bağlanmamışsa 0 döner. Argümanlar ödünçtür, *sonuc
+ * (başlangıçta boş) makineye devredilir. Sıfırdan farklı dönüş çalıştırmayı
+ * hatayla bitirir. Harici fonksiyon içinden aynı makine çağrılamaz.
+ */
+typedef int (*TrsmHariciFn)(TrSM *sm, const TrsmDeger *argumanlar, int arg_sayisi,
+                            TrsmDeger *sonuc, void *veri);
+
+/* Modülde bu isimde harici fonksiyon yoksa -1 */
+int   trsm_harici_kaydet(TrSM *sm, const char *isim, TrsmHariciFn fn, void *veri);
+
+/* ─── Değerler ─── */
+
+TrsmDeger trsm_bos(void);
+TrsmDeger trsm_tam(int64_t x);
+TrsmDeger trsm_ondalik(double x);
+TrsmDeger trsm_mantik(int x);
+TrsmDeger trsm_metin(const char *s, size_t uzunluk);   /* kopyalanır */
+
+int         trsm_tur(TrsmDeger d);
+int64_t     trsm_tam_al(TrsmDeger d);
+double      trsm_ondalik_al(TrsmDeger d);
+const char *trsm_metin_al(TrsmDeger d, size_t *uzunluk);   /* metin değilse NULL */
+
+void trsm_tut(TrsmDeger d);
+void trsm_birak(TrsmDeger d);
+
+#endif /* TRSM_H */
@@ -0,0 +1,68 @@
+/*
+ * Tonyukuk Sanal Makinesi (TrSM)
+ * Komut satırı: .trbc dosyalarını çalıştırır
+ *
+ * Kullanım: trsm [--jit] [--profil[=rapor.json]] program.trbc
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include "trsm.h"
+#include "vm.h"
+#include "trsm_jit.h"
+#include "trsm_profil.h"
+
+int main(int argc, char **argv) {
+    const char *dosya_yolu = NULL;
+    int jit_iste = 0;
+    int profil_iste = 0;
+    const char *profil_json = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--jit") == 0) jit_iste = 1;
+        else if (strcmp(argv[i], "--profil") == 0) profil_iste = 1;
+        else if (strncmp(argv[i], "--profil=", 9) == 0) {
+            profil_iste = 1;
+            profil_json = argv[i] + 9;
+        }
+        else dosya_yolu = argv[i];
+    }
+
+    if (!dosya_yolu) {
+        fprintf(stderr, "Tonyukuk Sanal Makinesi (TrSM) v%d\n", TRBC_VERSIYON);
+        fprintf(stderr, "Kullanım: trsm [--jit] [--profil[=rapor.json]] <dosya.trbc>\n");
+        return 1;
+    }
+
+    TrsmModul *modul = trsm_modul_yukle(dosya_yolu);
+    if (!modul) {
+        fprintf(stderr, "Hata: Bytecode dosyası yüklenemedi\n");
+        return 1;
+    }
+    TrSM *sm = trsm_olustur(modul);
+    if (!sm) {
+        fprintf(stderr, "Hata: Sanal makine oluşturulamadı\n");
+        trsm_modul_birak(modul);
+        return 1;
+    }
+
+    /* Profil yalnızca yorumlanan komutları görür; JIT ile birlikte açılmaz */
+    if (profil_iste) {
+        if (jit_iste) {
+            fprintf(stderr, "Uyarı: --profil ile JIT kapatıldı\n");
+            jit_iste = 0;
+        }
+        if (trsm_profil_baslat(sm) != 0)
+            fprintf(stderr, "Uyarı: Profil başlatılamadı\n");
+    }
+
+    if (jit_iste && trsm_jit_baslat(sm) != 0)
+        fprintf(stderr, "Uyarı: JIT bu platformda kullanılamıyor, yorumlayıcı kullanılıyor\n");
+
+    int sonuc = trsm_calistir(sm);
+
+    trsm_profil_bitir(sm, profil_json);
+    trsm_yok_et(sm);
+    trsm_modul_birak(modul);
+
+    return sonuc;
+}
@@ -0,0 +1,953 @@
+/*
+ * Tonyukuk Sanal Makinesi — Şablon JIT
+ *
+ * Sıcak fonksiyonlar (yorumlanan çağrı ve geri atlama sayaçlarıyla bulunur)
+ * komut komut x86-64 şablonlarına çevrilir. Doğal kod yorumlayıcıyla aynı
+ * bellek durumunu kullanır: yereller ve işlenenler TrSM değer yığınında,
+ * çerçeveler sm->cerceveler içinde. İşlenen derinliği her komutta statik
+ * olarak bilindiğinden yığın yuvaları r12'ye göre sabit ofsetlerle
+ * adreslenir; çalışma anında sp tutulmaz.
+ *
+ * Hızlı yol satır içi tamları, mantıkları ve ondalıkları işler. Başka bir
+ * durum görülürse (nesne, taşma, sıfıra bölme, desteklenmeyen komut) hiçbir
+ * şey değiştirilmeden deopt edilir: jit_pc/jit_sp yazılır ve yorumlayıcı
+ * aynı komuttan devam eder. Doğal kod referans sayımına hiç dokunmaz;
+ * nesne taşıyan her yol yorumlayıcıya bırakılır. Doğal çağrılar çerçeveyi
+ * yorumlayıcıyla aynı biçimde kurduğundan deopt zincir boyunca geri döner
+ * ve bekleyen çağıranlar yorumlanarak tamamlanır.
+ *
+ * Yazmaçlar: r12 yereller, r13 SM_ETIKET_TAM, r14 TrSM*, r15 geneller.
+ */
+#define _DEFAULT_SOURCE         /* MAP_ANONYMOUS */
+#include "trsm_jit.h"
+
+#ifdef TRSM_JIT
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <sys/mman.h>
+
+#include "x86_kodlayici.h"
+
+/* ═══════════════════════════════════════════════════════════════════
+ *  DURUM
+ * ═══════════════════════════════════════════════════════════════════ */
+
+enum { JIT_BEKLIYOR, JIT_DERLENDI, JIT_BASARISIZ };
+
+typedef struct {
+    int       durum;
+    int       cagri_sayac;
+    int       dongu_sayac;
+    int       yerel_boyut;      /* max(yerel_sayisi, param_sayisi, 1) */
+    int       maks_derinlik;
+    int       donus;            /* -2 hesaplanmadı, -1 karışık, 0 DONDUR, 1 DONDUR_DEGER */
+    int      *derinlik;         /* bytecode ofseti → işlenen derinliği, -1 ulaşılamaz */
+    uint8_t **adres;            /* bytecode ofseti → doğal adres */
+} JitFonksiyon;
+
+typedef int (*JitGecit)(TrSM *sm, SmDeger *yereller, void *hedef);
+
+struct TrsmJit {
+    uint8_t      *alan;         /* mmap'lenmiş kod alanı (yazarken RW, sonra RX) */
+    size_t        kullanilan;
+    JitGecit      gecit;        /* C → doğal kod geçidi, alanın başında */
+    JitFonksiyon *fonksiyonlar;
+};
+
+/* ═══════════════════════════════════════════════════════════════════
+ *  ANALİZ
+ * ═══════════════════════════════════════════════════════════════════ */
+
+/* Fonksiyonun ulaşılabilir dönüş komutları: yalnızca akış grafiğinden */
+static int jit_donus_turu(TrSM *sm, int fi) {
+    JitFonksiyon *jf = &sm->jit->fonksiyonlar[fi];
+    if (jf->donus != -2) return jf->donus;
+
+    SmFonksiyon *fn = &sm->fonksiyonlar[fi];
+    int bas = fn->kod_baslangic, uz = fn->kod_uzunluk;
+    jf->donus = -1;
+    if (uz <= 0 || bas + uz > sm->kod_uzunluk) return -1;
+
+    uint8_t *gorulen = calloc(uz, 1);
+    int *liste = malloc(uz * sizeof(int));
+    int n = 0, degerli = 0, degersiz = 0;
+    liste[n++] = bas;
+    gorulen[0] = 1;
+    while (n > 0) {
+        int i = liste[--n];
+        uint8_t k = sm->kod[i];
+        int ardil[2], ardil_sayisi = 0;
+        if (k == SM_DONDUR) { degersiz = 1; continue; }
+        if (k == SM_DONDUR_DEGER) { degerli = 1; continue; }
+        if (k == SM_DUR) continue;
+        if (k != SM_ATLA) ardil[ardil_sayisi++] = i + sm_komut_boyu(k);
+        if (sm_komut_atlama_mi(k)) ardil[ardil_sayisi++] = i + 3 + OKU_I16(sm->kod + i + 1);
+        for (int a = 0; a < ardil_sayisi; a++) {
+            int j = ardil[a];
+            if (j < bas || j >= bas + uz) { degerli = degersiz = 1; continue; }
+            if (!gorulen[j - bas]) { gorulen[j - bas] = 1; liste[n++] = j; }
+        }
+    }
+    free(gorulen);
+    free(liste);
+
+    if (degerli != degersiz) jf->donus = degerli;
+    return jf->donus;
+}
+
+/*
+ * Komutun yığın etkisi: `al` işlenen tüketir, `ver` üretir. Sonraki komuta
+ * düşmüyorsa *devam = 0; atlıyorsa *hedef bytecode ofseti.
+ */
+static void jit_komut_etkisi(TrSM *sm, int i, int *al, int *ver, int *devam, int *hedef) {
+    uint8_t k = sm->kod[i];
+    const uint8_t *op = sm->kod + i + 1;
+    *al = 0; *ver = 0; *devam = 1; *hedef = -1;
+    if (sm_komut_atlama_mi(k)) *hedef = i + 3 + OKU_I16(op);
+
+    switch (k) {
+    case SM_SABIT_TAM: case SM_SABIT_ONDALIK: case SM_SABIT_METIN:
+    case SM_DOGRU: case SM_YANLIS: case SM_BOS:
+    case SM_YUKLE_YEREL: case SM_YUKLE_GENEL:
+        *ver = 1; break;
+    case SM_CIKAR: case SM_KAYDET_YEREL: case SM_KAYDET_GENEL:
+    case SM_YAZDIR: case SM_YAZDIR_SATIR:
+    case SM_ATLA_YANLIS: case SM_ATLA_DOGRU:
+        *al = 1; break;
+    case SM_KOPYALA:
+        *al = 1; *ver = 2; break;
+    case SM_EKSI: case SM_EKSI_OND: case SM_DEGIL:
+    case SM_TAM_ONDALIK: case SM_ONDALIK_TAM: case SM_TAM_METIN: case SM_METIN_TAM:
+    case SM_TOPLA_YEREL: case SM_TOPLA_GENEL:
+        *al = 1; *ver = 1; break;
+    case SM_ESIT_ATLA_YANLIS: case SM_ESIT_DEGIL_ATLA_YANLIS:
+    case SM_KUCUK_ATLA_YANLIS: case SM_BUYUK_ATLA_YANLIS:
+    case SM_KUCUK_ESIT_ATLA_YANLIS: case SM_BUYUK_ESIT_ATLA_YANLIS:
+        *al = 2; break;
+    case SM_ARTIR_YEREL: case SM_ARTIR_GENEL:
+        break;
+    case SM_ATLA:
+        *devam = 0; break;
+    case SM_DONDUR: case SM_DUR:
+        *devam = 0; break;
+    case SM_DONDUR_DEGER:
+        *al = 1; *devam = 0; break;
+    case SM_CAGRI:
+    case SM_CAGRI_SABIT: {
+        int fi = OKU_U16(op);
+        *al = k == SM_CAGRI ? op[2] : sm->fonksiyonlar[fi].param_sayisi;
+        int donus = jit_donus_turu(sm, fi);
+        /* Dönüş türü karışıksa çağrıdan sonraki derinlik bilinemez */
+        if (donus < 0) *devam = 0;
+        else *ver = donus;
+        break;
+    }
+    default:
+        /* İkili işlemler ve karşılaştırmalar */
+        *al = 2; *ver = 1; break;
+    }
+}
+
+/* Her komutun girişteki işlenen derinliğini bul; tutarsızlıkta -1 */
+static int jit_analiz(TrSM *sm, int fi, JitFonksiyon *jf) {
+    SmFonksiyon *fn = &sm->fonksiyonlar[fi];
+    int bas = fn->kod_baslangic, uz = fn->kod_uzunluk;
+    if (uz <= 0 || bas < 0 || bas + uz > sm->kod_uzunluk) return -1;
+
+    jf->derinlik = malloc(uz * sizeof(int));
+    for (int i = 0; i < uz; i++) jf->derinlik[i] = -1;
+    int *liste = malloc(uz * sizeof(int));
+    int n = 0, maks = 0;
+    jf->derinlik[0] = 0;
+    liste[n++] = bas;
+
+    while (n > 0) {
+        int i = liste[--n];
+        int d = jf->derinlik[i - bas];
+        int al, ver, devam, hedef;
+        jit_komut_etkisi(sm, i, &al, &ver, &devam, &hedef);
+        if (d < al) goto basarisiz;     /* yorumlayıcı boşla tamamlardı */
+        int yeni = d - al + ver;
+        if (yeni > maks) maks = yeni;
+        if (d > maks) maks = d;
+
+        int ardil[2], ardil_sayisi = 0;
+        if (devam) ardil[ardil_sayisi++] = i + sm_komut_boyu(sm->kod[i]);
+        if (hedef >= 0) ardil[ardil_sayisi++] = hedef;
+        for (int a = 0; a < ardil_sayisi; a++) {
+            int j = ardil[a];
+            if (j < bas || j >= bas + uz) goto basarisiz;
+            if (jf->derinlik[j - bas] < 0) {
+                jf->derinlik[j - bas] = yeni;
+                liste[n++] = j;
+            } else if (jf->derinlik[j - bas] != yeni) {
+                goto basarisiz;
+            }
+        }
+    }
+    free(liste);
+
+    int yb = fn->yerel_sayisi > fn->param_sayisi ? fn->yerel_sayisi : fn->param_sayisi;
+    jf->yerel_boyut = yb < 1 ? 1 : yb;
+    jf->maks_derinlik = maks;
+    return 0;
+
+basarisiz:
+    free(liste);
+    free(jf->derinlik);
+    jf->derinlik = NULL;
+    return -1;
+}
+
+/* ═══════════════════════════════════════════════════════════════════
+ *  KOD ÜRETİMİ
+ * ═══════════════════════════════════════════════════════════════════ */
+
+enum { YAMA_ETIKET, YAMA_DEOPT };
+
+typedef struct {
+    int yama;       /* rel32 alanının ofseti */
+    int hedef;      /* bytecode ofseti */
+    int tur;
+} JitYama;
+
+typedef struct {
+    TrSM         *sm;
+    JitFonksiyon *jf;
+    int           bas;
+    İkilKod       ik;
+    JitYama      *yamalar;
+    int           yama_sayisi;
+    int           yama_kapasite;
+} JitDerleyici;
+
+#define YUVA(j, d)  (8 * ((j)->jf->yerel_boyut + (d)))
+#define YEREL(i)    (8 * (i))
+#define TRSM_OFS(alan) ((int32_t)offsetof(TrSM, alan))
+
+static void yama_ekle(JitDerleyici *j, int yama, int hedef, int tur) {
+    if (j->yama_sayisi >= j->yama_kapasite) {
+        j->yama_kapasite = j->yama_kapasite ? j->yama_kapasite * 2 : 64;
+        j->yamalar = realloc(j->yamalar, j->yama_kapasite * sizeof(JitYama));
+    }
+    j->yamalar[j->yama_sayisi++] = (JitYama){yama, hedef, tur};
+}
+
+/* Verilen komutun başına deopt et (yama sonradan deopt koduna bağlanır) */
+#define DEOPT(j, yama, off)   yama_ekle((j), (yama), (off), YAMA_DEOPT)
+#define ETIKET(j, yama, off)  yama_ekle((j), (yama), (off), YAMA_ETIKET)
+
+/* rcx ← r; satır içi tam değilse deopt */
+static void tam_denetle(JitDerleyici *j, YazmaçNo r, int off) {
+    x86_taşı_yazmaç_yazmaç(&j->ik, YAZ_RCX, r);
+    x86_özel_veya_yazmaç_yazmaç(&j->ik, YAZ_RCX, YAZ_R13);
+    x86_sağa_kaydır_sabit(&j->ik, YAZ_RCX, 48);
+    DEOPT(j, x86_atla_eşit_değilse(&j->ik), off);
+}
+
+static void iki_tam_denetle(JitDerleyici *j, int off) {
+    x86_taşı_yazmaç_yazmaç(&j->ik, YAZ_RCX, YAZ_RAX);
+    x86_özel_veya_yazmaç_yazmaç(&j->ik, YAZ_RCX, YAZ_R13);
+    x86_taşı_yazmaç_yazmaç(&j->ik, YAZ_RDX, YAZ_RSI);
+    x86_özel_veya_yazmaç_yazmaç(&j->ik, YAZ_RDX, YAZ_R13);
+    x86_veya_yazmaç_yazmaç(&j->ik, YAZ_RCX, YAZ_RDX);
+    x86_sağa_kaydır_sabit(&j->ik, YAZ_RCX, 48);
+    DEOPT(j, x86_atla_eşit_değilse(&j->ik), off);
+}
+
+/* Nesne ise deopt (referans sayımı yorumlayıcıda) */
+static void nesne_degil(JitDerleyici *j, YazmaçNo r, int off) {
+    x86_taşı_yazmaç_yazmaç(&j->ik, YAZ_RCX, r);
+    x86_sağa_kaydır_sabit(&j->ik, YAZ_RCX, 48);
+    x86_karşılaştır_yazmaç_sabit32(&j->ik, YAZ_RCX, (int32_t)(SM_ETIKET_NESNE >> 48));
+    DEOPT(j, x86_atla_eşitse(&j->ik), off);
+}
+
+static void ondalik_denetle(JitDerleyici *j, YazmaçNo r, int off) {
+    x86_taşı_yazmaç_yazmaç(&j->ik, YAZ_RCX, r);
+    x86_sağa_kaydır_sabit(&j->ik, YAZ_RCX, 48);
+    x86_karşılaştır_yazmaç_sabit32(&j->ik, YAZ_RCX, (int32_t)(SM_NAN_TABANI >> 48));
+    DEOPT(j, x86_atla_üstündeyse(&j->ik), off);
+}
+
+/* r mantık değilse deopt; r ← 0/1 */
+static void mantik_ac(JitDerleyici *j, YazmaçNo r, int off) {
+    x86_taşı_yazmaç_sabit64(&j->ik, YAZ_RDX, (int64_t)SM_ETIKET_MANTIK);
+    x86_özel_veya_yazmaç_yazmaç(&j->ik, r, YAZ_RDX);
+    x86_karşılaştır_yazmaç_sabit32(&j->ik, r, 1);
+    DEOPT(j, x86_atla_üstündeyse(&j->ik), off);
+}
+
+/* rax (yükü üst 48 bitte) → etiketli tam */
+static void tam_etiketle(JitDerleyici *j) {
+    x86_sağa_kaydır_sabit(&j->ik, YAZ_RAX, 16);
+    x86_veya_yazmaç_yazmaç(&j->ik, YAZ_RAX, YAZ_R13);
+}
+
+/* rax (0/1) → etiketli mantık */
+static void mantik_etiketle(JitDerleyici *j) {
+    x86_sıfır_genişlet_byte(&j->ik, YAZ_RAX, YAZ_RAX);
+    x86_taşı_yazmaç_sabit64(&j->ik, YAZ_RCX, (int64_t)SM_ETIKET_MANTIK);
+    x86_veya_yazmaç_yazmaç(&j->ik, YAZ_RAX, YAZ_RCX);
+}
+
+/* rax ← doğruluk (0/1): mantık ve satır içi tam hızlı yolda */
+static void dogruluk(JitDerleyici *j, int off) {
+    İkilKod *ik = &j->ik;
+    x86_taşı_yazmaç_sabit64(ik, YAZ_RCX, (int64_t)SM_ETIKET_MANTIK);
+    x86_taşı_yazmaç_yazmaç(ik, YAZ_RDX, YAZ_RAX);
+    x86_özel_veya_yazmaç_yazmaç(ik, YAZ_RDX, YAZ_RCX);
+    x86_karşılaştır_yazmaç_sabit32(ik, YAZ_RDX, 1);
+    int tam_mi = x86_atla_üstündeyse(ik);
+    x86_taşı_yazmaç_yazmaç(ik, YAZ_RAX, YAZ_RDX);
+    int bitti = x86_atla(ik);
+    x86_atlama_yamala(ik, tam_mi, ik->uzunluk);
+    tam_denetle(j, YAZ_RAX, off);
+    x86_sola_kaydır_sabit(ik, YAZ_RAX, 16);
+    x86_sına_yazmaç_yazmaç(ik, YAZ_RAX, YAZ_RAX);
+    x86_koşul_eşit_değil(ik, YAZ_RAX);
+    x86_sıfır_genişlet_byte(ik, YAZ_RAX, YAZ_RAX);
+    x86_atlama_yamala(ik, bitti, ik->uzunluk);
+}
+
+/* [taban, taban+adet) yuvalarından biri nesne ise deopt */
+static void yuvalar_nesnesiz(JitDerleyici *j, int adet, int off) {
+    for (int i = 0; i < adet; i++) {
+        x86_taşı_yazmaç_bellek(&j->ik, YAZ_RAX, YAZ_R12, YEREL(i));
+        x86_sağa_kaydır_sabit(&j->ik, YAZ_RAX, 48);
+        x86_karşılaştır_yazmaç_sabit32(&j->ik, YAZ_RAX, (int32_t)(SM_ETIKET_NESNE >> 48));
+        DEOPT(j, x86_atla_eşitse(&j->ik), off);
+    }
+}
+
+/* Çerçeveyi düşür ve JIT_DONDU ile çık */
+static void cerceve_dus(JitDerleyici *j) {
+    İkilKod *ik = &j->ik;
+    x86_taşı_yazmaç_bellek32(ik, YAZ_RAX, YAZ_R14, TRSM_OFS(cerceve_sayisi));
+    x86_çıkar_yazmaç_sabit32(ik, YAZ_RAX, 1);
+    x86_taşı_bellek_yazmaç32(ik, YAZ_R14, TRSM_OFS(cerceve_sayisi), YAZ_RAX);
+    x86_özel_veya_yazmaç_yazmaç(ik, YAZ_RAX, YAZ_RAX);
+    x86_dön(ik);
+}
+
+/*
+ * Doğal çağrı girişi: rdi = yeni yereller (argümanlar yerinde), rsi = dönüş
+ * PC'si. Yer yoksa JIT_REDDET döner ve çağıran çağrı komutunda deopt eder.
+ */
+static void giris_uret(JitDerleyici *j, int fi, int *reddet_yama) {
+    İkilKod *ik = &j->ik;
+    SmFonksiyon *fn = &j->sm->fonksiyonlar[fi];
+    int yb = j->jf->yerel_boyut;
+
+    x86_adres_yükle(ik, YAZ_RAX, YAZ_RDI, 8 * (yb + j->jf->maks_derinlik));
+    x86_taşı_yazmaç_bellek(ik, YAZ_RCX, YAZ_R14, TRSM_OFS(jit_yigin_son));
+    x86_karşılaştır_yazmaç_yazmaç(ik, YAZ_RAX, YAZ_RCX);
+    reddet_yama[0] = x86_atla_üstündeyse(ik);
+    x86_taşı_yazmaç_bellek32(ik, YAZ_RAX, YAZ_R14, TRSM_OFS(cerceve_sayisi));
+    x86_taşı_yazmaç_bellek32(ik, YAZ_RCX, YAZ_R14, TRSM_OFS(jit_cerceve_siniri));
+    x86_karşılaştır_yazmaç_yazmaç(ik, YAZ_RAX, YAZ_RCX);
+    reddet_yama[1] = x86_atla_büyük_eşitse(ik);
+
+    /* cerceveler[cerceve_sayisi++] = {fn, rsi, taban, yb} */
+    x86_adres_yükle(ik, YAZ_RDX, YAZ_RAX, 1);
+    x86_taşı_bellek_yazmaç32(ik, YAZ_R14, TRSM_OFS(cerceve_sayisi), YAZ_RDX);
+    x86_çarp_yazmaç_sabit32(ik, YAZ_RAX, YAZ_RAX, (int32_t)sizeof(CagriCercevesi));
+    x86_taşı_yazmaç_bellek(ik, YAZ_RCX, YAZ_R14, TRSM_OFS(cerceveler));
+    x86_topla_yazmaç_yazmaç(ik, YAZ_RAX, YAZ_RCX);
+    x86_taşı_yazmaç_sabit64(ik, YAZ_RCX, (int64_t)(uintptr_t)fn);
+    x86_taşı_bellek_yazmaç(ik, YAZ_RAX, (int32_t)offsetof(CagriCercevesi, fonksiyon), YAZ_RCX);
+    x86_taşı_bellek_yazmaç(ik, YAZ_RAX, (int32_t)offsetof(CagriCercevesi, dondur_adresi), YAZ_RSI);
+    x86_taşı_yazmaç_yazmaç(ik, YAZ_RCX, YAZ_RDI);
+    x86_taşı_yazmaç_bellek(ik, YAZ_RDX, YAZ_R14, TRSM_OFS(yigin));
+    x86_çıkar_yazmaç_yazmaç(ik, YAZ_RCX, YAZ_RDX);
+    x86_sağa_kaydır_sabit(ik, YAZ_RCX, 3);
+    x86_taşı_bellek_yazmaç32(ik, YAZ_RAX, (int32_t)offsetof(CagriCercevesi, taban), YAZ_RCX);
+    x86_taşı_yazmaç_sabit32(ik, YAZ_RCX, yb);
+    x86_taşı_bellek_yazmaç32(ik, YAZ_RAX, (int32_t)offsetof(CagriCercevesi, yerel_sayisi), YAZ_RCX);
+
+    /* Argüman olmayan yereller boş */
+    if (yb > fn->param_sayisi) {
+        x86_taşı_yazmaç_sabit64(ik, YAZ_RCX, (int64_t)SM_BOS_DEGER);
+        for (int i = fn->param_sayisi; i < yb; i++)
+            x86_taşı_bellek_yazmaç(ik, YAZ_RDI, YEREL(i), YAZ_RCX);
+    }
+    x86_taşı_yazmaç_yazmaç(ik, YAZ_R12, YAZ_RDI);
+}
+
+/* İki satır içi tam: rax ← S(d-2), rsi ← S(d-1) */
+static void iki_yukle(JitDerleyici *j, int d) {
+    x86_taşı_yazmaç_bellek(&j->ik, YAZ_RAX, YAZ_R12, YUVA(j, d - 2));
+    x86_taşı_yazmaç_bellek(&j->ik, YAZ_RSI, YAZ_R12, YUVA(j, d - 1));
+}
+
+/* rax ← rax + rsi (ikisi de etiketli tam), taşmada deopt */
+static void tam_topla_uret(JitDerleyici *j, int off) {
+    İkilKod *ik = &j->ik;
+    iki_tam_denetle(j, off);
+    x86_sola_kaydır_sabit(ik, YAZ_RAX, 16);
+    x86_sola_kaydır_sabit(ik, YAZ_RSI, 16);
+    x86_topla_yazmaç_yazmaç(ik, YAZ_RAX, YAZ_RSI);
+    DEOPT(j, x86_atla_taşarsa(ik), off);
+    tam_etiketle(j);
+}
+
+/* Karşılaştırma sonucunu al'e yazan SETcc (işaretli) */
+static void tam_kosul(İkilKod *ik, uint8_t k) {
+    switch (k) {
+    case SM_ESIT:       x86_koşul_eşit(ik, YAZ_RAX); break;
+    case SM_ESIT_DEGIL: x86_koşul_eşit_değil(ik, YAZ_RAX); break;
+    case SM_KUCUK:      x86_koşul_küçük(ik, YAZ_RAX); break;
+    case SM_BUYUK:      x86_koşul_büyük(ik, YAZ_RAX); break;
+    case SM_KUCUK_ESIT: x86_koşul_küçük_eşit(ik, YAZ_RAX); break;
+    default:            x86_koşul_büyük_eşit(ik, YAZ_RAX); break;
+    }
+}
+
+/* Birleşik karşılaştır-atla: koşul YANLIŞ ise atlayan Jcc */
+static int tam_ters_atla(İkilKod *ik, uint8_t k) {
+    switch (k) {
+    case SM_ESIT_ATLA_YANLIS:       return x86_atla_eşit_değilse(ik);
+    case SM_ESIT_DEGIL_ATLA_YANLIS: return x86_atla_eşitse(ik);
+    case SM_KUCUK_ATLA_YANLIS:      return x86_atla_büyük_eşitse(ik);
+    case SM_BUYUK_ATLA_YANLIS:      return x86_atla_küçük_eşitse(ik);
+    case SM_KUCUK_ESIT_ATLA_YANLIS: return x86_atla_büyükse(ik);
+    default:                        return x86_atla_küçükse(ik);
+    }
+}
+
+static void komut_uret(JitDerleyici *j, int off, int d) {
+    TrSM *sm = j->sm;
+    İkilKod *ik = &j->ik;
+    uint8_t k = sm->kod[off];
+    const uint8_t *op = sm->kod + off + 1;
+    int yb = j->jf->yerel_boyut;
+
+    switch (k) {
+    case SM_SABIT_TAM: case SM_SABIT_ONDALIK: case SM_SABIT_METIN:
+    case SM_DOGRU: case SM_YANLIS: case SM_BOS: {
+        /* Sabit havuzu nesneleri kalıcı: sayım gerekmez */
+        SmDeger v = k == SM_DOGRU ? sm_mantik(1) :
+                    k == SM_YANLIS ? sm_mantik(0) :
+                    k == SM_BOS ? SM_BOS_DEGER : sm->sabitler[OKU_U16(op)];
+        x86_taşı_yazmaç_sabit64(ik, YAZ_RAX, (int64_t)v);
+        x86_taşı_bellek_yazmaç(ik, YAZ_R12, YUVA(j, d), YAZ_RAX);
+        return;
+    }
+
+    case SM_CIKAR:
+        x86_taşı_yazmaç_bellek(ik, YAZ_RAX, YAZ_R12, YUVA(j, d - 1));
+        nesne_degil(j, YAZ_RAX, off);
+        return;
+
+    case SM_KOPYALA:
+        x86_taşı_yazmaç_bellek(ik, YAZ_RAX, YAZ_R12, YUVA(j, d - 1));
+        nesne_degil(j, YAZ_RAX, off);
+        x86_taşı_bellek_yazmaç(ik, YAZ_R12, YUVA(j, d), YAZ_RAX);
+        return;
+
+    /* ─── Tam sayı ─── */
+
+    case SM_TOPLA:
+    case SM_CIKAR_SAYI:
+        iki_yukle(j, d);
+        if (k == SM_TOPLA) {
+            tam_topla_uret(j, off);
+        } else {
+            iki_tam_denetle(j, off);
+            x86_sola_kaydır_sabit(ik, YAZ_RAX, 16);
+            x86_sola_kaydır_sabit(ik, YAZ_RSI, 16);
+            x86_çıkar_yazmaç_yazmaç(ik, YAZ_RAX, YAZ_RSI);
+            DEOPT(j, x86_atla_taşarsa(ik), off);
+            tam_etiketle(j);
+        }
+        x86_taşı_bellek_yazmaç(ik, YAZ_R12, YUVA(j, d - 2), YAZ_RAX);
+        return;
+
+    case SM_CARP:
+        iki_yukle(j, d);
+        iki_tam_denetle(j, off);
+        x86_sola_kaydır_sabit(ik, YAZ_RAX, 16);
+        x86_sola_kaydır_sabit(ik, YAZ_RSI, 16);
+        x86_aritmetik_sağa_kaydır_sabit(ik, YAZ_RSI, 16);
+        x86_çarp_yazmaç_yazmaç(ik, YAZ_RAX, YAZ_RSI);
+        DEOPT(j, x86_atla_taşarsa(ik), off);
+        tam_etiketle(j);
+        x86_taşı_bellek_yazmaç(ik, YAZ_R12, YUVA(j, d - 2), YAZ_RAX);
+        return;
+
+    case SM_BOL:
+    case SM_MOD:
+        iki_yukle(j, d);
+        iki_tam_denetle(j, off);
+        x86_sola_kaydır_sabit(ik, YAZ_RAX, 16);
+        x86_aritmetik_sağa_kaydır_sabit(ik, YAZ_RAX, 16);
+        x86_sola_kaydır_sabit(ik, YAZ_RSI, 16);
+        x86_aritmetik_sağa_kaydır_sabit(ik, YAZ_RSI, 16);
+        x86_sına_yazmaç_yazmaç(ik, YAZ_RSI, YAZ_RSI);
+        DEOPT(j, x86_atla_eşitse(ik), off);      /* sıfıra bölme hatası yorumlayıcıda */
+        x86_işaret_genişlet(ik);
+        x86_böl_yazmaç(ik, YAZ_RSI);
+        if (k == SM_MOD) x86_taşı_yazmaç_yazmaç(ik, YAZ_RAX, YAZ_RDX);
+        /* -2^47 / -1 yüke sığmaz */
+        x86_taşı_yazmaç_yazmaç(ik, YAZ_RCX, YAZ_RAX);
+        x86_sola_kaydır_sabit(ik, YAZ_RCX, 16);
+        x86_aritmetik_sağa_kaydır_sabit(ik, YAZ_RCX, 16);
+        x86_karşılaştır_yazmaç_yazmaç(ik, YAZ_RCX, YAZ_RAX);
+        DEOPT(j, x86_atla_eşit_değilse(ik), off);
+        x86_sola_kaydır_sabit(ik, YAZ_RAX, 16);
+        tam_etiketle(j);
+        x86_taşı_bellek_yazmaç(ik, YAZ_R12, YUVA(j, d - 2), YAZ_RAX);
+        return;
+
+    case SM_EKSI:
+        x86_taşı_yazmaç_bellek(ik, YAZ_RAX, YAZ_R12, YUVA(j, d - 1));
+        tam_denetle(j, YAZ_RAX, off);
+        x86_sola_kaydır_sabit(ik, YAZ_RAX, 16);
+        x86_olumsuzla(ik, YAZ_RAX);
+        DEOPT(j, x86_atla_taşarsa(ik), off);
+        tam_etiketle(j);
+        x86_taşı_bellek_yazmaç(ik, YAZ_R12, YUVA(j, d - 1), YAZ_RAX);
+        return;
+
+    case SM_ESIT: case SM_ESIT_DEGIL: case SM_KUCUK:
+    case SM_BUYUK: case SM_KUCUK_ESIT: case SM_BUYUK_ESIT:
+        iki_yukle(j, d);
+        iki_tam_denetle(j, off);
+        x86_sola_kaydır_sabit(ik, YAZ_RAX, 16);
+        x86_sola_kaydır_sabit(ik, YAZ_RSI, 16);
+        x86_karşılaştır_yazmaç_yazmaç(ik, YAZ_RAX, YAZ_RSI);
+        tam_kosul(ik, k);
+        mantik_etiketle(j);
+        x86_taşı_bellek_yazmaç(ik, YAZ_R12, YUVA(j, d - 2), YAZ_RAX);
+        return;
+
+    case SM_ESIT_ATLA_YANLIS: case SM_ESIT_DEGIL_ATLA_YANLIS:
+    case SM_KUCUK_ATLA_YANLIS: case SM_BUYUK_ATLA_YANLIS:
+    case SM_KUCUK_ESIT_ATLA_YANLIS: case SM_BUYUK_ESIT_ATLA_YANLIS:
+        iki_yukle(j, d);
+        iki_tam_denetle(j, off);
+        x86_sola_kaydır_sabit(ik, YAZ_RAX, 16);
+        x86_sola_kaydır_sabit(ik, YAZ_RSI, 16);
+        x86_karşılaştır_yazmaç_yazmaç(ik, YAZ_RAX, YAZ_RSI);
+        ETIKET(j, tam_ters_atla(ik, k), off + 3 + OKU_I16(op));
+        return;
+
+    /* ─── Ondalık ─── */
+
+    case SM_TOPLA_OND: case SM_CIKAR_OND: case SM_CARP_OND: case SM_BOL_OND:
+    case SM_ESIT_OND: case SM_KUCUK_OND: case SM_BUYUK_OND:
+    case SM_KUCUK_ESIT_OND: case SM_BUYUK_ESIT_OND:
+        iki_yukle(j, d);
+        ondalik_denetle(j, YAZ_RAX, off);
+        ondalik_denetle(j, YAZ_RSI, off);
+        x86_ondalık_taşı_yazmaç_bellek(ik, YAZ_XMM0, YAZ_R12, YUVA(j, d - 2));
+        x86_ondalık_taşı_yazmaç_bellek(ik, YAZ_XMM1, YAZ_R12, YUVA(j, d - 1));
+        switch (k) {
+        case SM_TOPLA_OND: x86_ondalık_topla(ik, YAZ_XMM0, YAZ_XMM1); break;
+        case SM_CIKAR_OND: x86_ondalık_çıkar(ik, YAZ_XMM0, YAZ_XMM1); break;
+        case SM_CARP_OND:  x86_ondalık_çarp(ik, YAZ_XMM0, YAZ_XMM1); break;
+        case SM_BOL_OND:
+            /* 0.0 (ve NaN) bölen: hata/yol yorumlayıcıda */
+            x86_ondalık_sıfırla(ik, YAZ_XMM2);
+            x86_ondalık_karşılaştır(ik, YAZ_XMM1, YAZ_XMM2);
+            DEOPT(j, x86_atla_eşitse(ik), off);
+            x86_ondalık_böl(ik, YAZ_XMM0, YAZ_XMM1);
+            break;
+        default:
+            /* UCOMISD sırasızda CF=ZF=PF=1: a<b yerine b>a sorulur */
+            if (k == SM_ESIT_OND) {
+                x86_ondalık_karşılaştır(ik, YAZ_XMM0, YAZ_XMM1);
+                x86_koşul_eşit(ik, YAZ_RAX);
+                x86_koşul_eşlik_yok(ik, YAZ_RCX);
+                x86_sıfır_genişlet_byte(ik, YAZ_RAX, YAZ_RAX);
+                x86_sıfır_genişlet_byte(ik, YAZ_RCX, YAZ_RCX);
+                x86_ve_yazmaç_yazmaç(ik, YAZ_RAX, YAZ_RCX);
+            } else if (k == SM_KUCUK_OND || k == SM_KUCUK_ESIT_OND) {
+                x86_ondalık_karşılaştır(ik, YAZ_XMM1, YAZ_XMM0);
+                if (k == SM_KUCUK_OND) x86_koşul_üstünde(ik, YAZ_RAX);
+                else x86_koşul_üstünde_eşit(ik, YAZ_RAX);
+            } else {
+                x86_ondalık_karşılaştır(ik, YAZ_XMM0, YAZ_XMM1);
+                if (k == SM_BUYUK_OND) x86_koşul_üstünde(ik, YAZ_RAX);
+                else x86_koşul_üstünde_eşit(ik, YAZ_RAX);
+            }
+            mantik_etiketle(j);
+            x86_taşı_bellek_yazmaç(ik, YAZ_R12, YUVA(j, d - 2), YAZ_RAX);
+            return;
+        }
+        x86_ondalık_taşı_bellek_yazmaç(ik, YAZ_R12, YUVA(j, d - 2), YAZ_XMM0);
+        return;
+
+    case SM_EKSI_OND:
+        x86_taşı_yazmaç_bellek(ik, YAZ_RAX, YAZ_R12, YUVA(j, d - 1));
+        ondalik_denetle(j, YAZ_RAX, off);
+        x86_taşı_yazmaç_sabit64(ik, YAZ_RCX, INT64_MIN);
+        x86_özel_veya_yazmaç_yazmaç(ik, YAZ_RAX, YAZ_RCX);
+        x86_taşı_bellek_yazmaç(ik, YAZ_R12, YUVA(j, d - 1), YAZ_RAX);
+        return;
+
+    case SM_TAM_ONDALIK:
+        x86_taşı_yazmaç_bellek(ik, YAZ_RAX, YAZ_R12, YUVA(j, d - 1));
+        tam_denetle(j, YAZ_RAX, off);
+        x86_sola_kaydır_sabit(ik, YAZ_RAX, 16);
+        x86_aritmetik_sağa_kaydır_sabit(ik, YAZ_RAX, 16);
+        x86_tam_ondalığa_çevir(ik, YAZ_XMM0, YAZ_RAX);
+        x86_ondalık_taşı_bellek_yazmaç(ik, YAZ_R12, YUVA(j, d - 1), YAZ_XMM0);
+        return;
+
+    case SM_ONDALIK_TAM:
+        x86_taşı_yazmaç_bellek(ik, YAZ_RAX, YAZ_R12, YUVA(j, d - 1));
+        ondalik_denetle(j, YAZ_RAX, off);
+        x86_ondalık_taşı_yazmaç_bellek(ik, YAZ_XMM0, YAZ_R12, YUVA(j, d - 1));
+        x86_ondalık_tama_çevir(ik, YAZ_RAX, YAZ_XMM0);
+        x86_taşı_yazmaç_yazmaç(ik, YAZ_RCX, YAZ_RAX);
+        x86_sola_kaydır_sabit(ik, YAZ_RCX, 16);
+        x86_aritmetik_sağa_kaydır_sabit(ik, YAZ_RCX, 16);
+        x86_karşılaştır_yazmaç_yazmaç(ik, YAZ_RCX, YAZ_RAX);
+        DEOPT(j, x86_atla_eşit_değilse(ik), off);
+        x86_sola_kaydır_sabit(ik, YAZ_RAX, 16);
+        tam_etiketle(j);
+        x86_taşı_bellek_yazmaç(ik, YAZ_R12, YUVA(j, d - 1), YAZ_RAX);
+        return;
+
+    /* ─── Mantık ─── */
+
+    case SM_DEGIL:
+        x86_taşı_yazmaç_bellek(ik, YAZ_RAX, YAZ_R12, YUVA(j, d - 1));
+        dogruluk(j, off);
+        x86_taşı_yazmaç_sabit64(ik, YAZ_RCX, (int64_t)sm_mantik(1));
+        x86_özel_veya_yazmaç_yazmaç(ik, YAZ_RAX, YAZ_RCX);
+        x86_taşı_bellek_yazmaç(ik, YAZ_R12, YUVA(j, d - 1), YAZ_RAX);
+        return;
+
+    case SM_VE:
+    case SM_VEYA:
+        iki_yukle(j, d);
+        mantik_ac(j, YAZ_RAX, off);
+        mantik_ac(j, YAZ_RSI, off);
+        if (k == SM_VE) x86_ve_yazmaç_yazmaç(ik, YAZ_RAX, YAZ_RSI);
+        else x86_veya_yazmaç_yazmaç(ik, YAZ_RAX, YAZ_RSI);
+        x86_veya_yazmaç_yazmaç(ik, YAZ_RAX, YAZ_RDX);    /* rdx = MANTIK etiketi */
+        x86_taşı_bellek_yazmaç(ik, YAZ_R12, YUVA(j, d - 2), YAZ_RAX);
+        return;
+
+    /* ─── Değişkenler ─── */
+
+    case SM_YUKLE_YEREL:
+    case SM_YUKLE_GENEL: {
+        int idx = OKU_U16(op);
+        int sinir = k == SM_YUKLE_YEREL ? yb : j->sm->genel_sayisi;
+        if (idx < sinir) {
+            x86_taşı_yazmaç_bellek(ik, YAZ_RAX, k == SM_YUKLE_YEREL ? YAZ_R12 : YAZ_R15, YEREL(idx));
+            nesne_degil(j, YAZ_RAX, off);
+        } else {
+            x86_taşı_yazmaç_sabit64(ik, YAZ_RAX, (int64_t)SM_BOS_DEGER);
+        }
+        x86_taşı_bellek_yazmaç(ik, YAZ_R12, YUVA(j, d), YAZ_RAX);
+        return;
+    }
+
+    case SM_KAYDET_YEREL:
+    case SM_KAYDET_GENEL: {
+        int idx = OKU_U16(op);
+        int sinir = k == SM_KAYDET_YEREL ? yb : j->sm->genel_sayisi;
+        YazmaçNo taban = k == SM_KAYDET_YEREL ? YAZ_R12 : YAZ_R15;
+        if (idx >= sinir) break;          /* çerçeve genişletme yorumlayıcıda */
+        x86_taşı_yazmaç_bellek(ik, YAZ_RAX, taban, YEREL(idx));
+        nesne_degil(j, YAZ_RAX, off);     /* eski değer bırakılmalı */
+        x86_taşı_yazmaç_bellek(ik, YAZ_RAX, YAZ_R12, YUVA(j, d - 1));
+        x86_taşı_bellek_yazmaç(ik, taban, YEREL(idx), YAZ_RAX);
+        return;
+    }
+
+    case SM_TOPLA_YEREL:
+    case SM_TOPLA_GENEL: {
+        int idx = OKU_U16(op);
+        int sinir = k == SM_TOPLA_YEREL ? yb : j->sm->genel_sayisi;
+        if (idx >= sinir) break;
+        x86_taşı_yazmaç_bellek(ik, YAZ_RAX, YAZ_R12, YUVA(j, d - 1));
+        x86_taşı_yazmaç_bellek(ik, YAZ_RSI, k == SM_TOPLA_YEREL ? YAZ_R12 : YAZ_R15, YEREL(idx));
+        tam_topla_uret(j, off);
+        x86_taşı_bellek_yazmaç(ik, YAZ_R12, YUVA(j, d - 1), YAZ_RAX);
+        return;
+    }
+
+    case SM_ARTIR_YEREL:
+    case SM_ARTIR_GENEL: {
+        int idx = OKU_U16(op);
+        int16_t artis = OKU_I16(op + 2);
+        int sinir = k == SM_ARTIR_YEREL ? yb : j->sm->genel_sayisi;
+        YazmaçNo taban = k == SM_ARTIR_YEREL ? YAZ_R12 : YAZ_R15;
+        if (idx >= sinir) break;
+        x86_taşı_yazmaç_bellek(ik, YAZ_RAX, taban, YEREL(idx));
+        tam_denetle(j, YAZ_RAX, off);
+        x86_sola_kaydır_sabit(ik, YAZ_RAX, 16);
+        x86_topla_yazmaç_sabit32(ik, YAZ_RAX, (int32_t)((uint32_t)(int32_t)artis << 16));
+        DEOPT(j, x86_atla_taşarsa(ik), off);
+        tam_etiketle(j);
+        x86_taşı_bellek_yazmaç(ik, taban, YEREL(idx), YAZ_RAX);
+        return;
+    }
+
+    /* ─── Kontrol akışı ─── */
+
+    case SM_ATLA:
+        ETIKET(j, x86_atla(ik), off + 3 + OKU_I16(op));
+        return;
+
+    case SM_ATLA_YANLIS:
+    case SM_ATLA_DOGRU:
+        x86_taşı_yazmaç_bellek(ik, YAZ_RAX, YAZ_R12, YUVA(j, d - 1));
+        dogruluk(j, off);
+        x86_sına_yazmaç_yazmaç(ik, YAZ_RAX, YAZ_RAX);
+        ETIKET(j, k == SM_ATLA_YANLIS ? x86_atla_eşitse(ik) : x86_atla_eşit_değilse(ik),
+               off + 3 + OKU_I16(op));
+        return;
+
+    case SM_CAGRI:
+    case SM_CAGRI_SABIT: {
+        int fi = OKU_U16(op);
+        SmFonksiyon *hedef_fn = &sm->fonksiyonlar[fi];
+        int arg = k == SM_CAGRI ? op[2] : hedef_fn->param_sayisi;
+        if (arg != hedef_fn->param_sayisi || jit_donus_turu(sm, fi) < 0) break;
+
+        /* Çağrılan henüz derlenmediyse yorumlayıcı çağırır */
+        x86_taşı_yazmaç_sabit64(ik, YAZ_RAX, (int64_t)(uintptr_t)&sm->jit_giris[fi]);
+        x86_taşı_yazmaç_bellek(ik, YAZ_RAX, YAZ_RAX, 0);
+        x86_sına_yazmaç_yazmaç(ik, YAZ_RAX, YAZ_RAX);
+        DEOPT(j, x86_atla_eşitse(ik), off);
+
+        x86_adres_yükle(ik, YAZ_RDI, YAZ_R12, YUVA(j, d - arg));
+        x86_taşı_yazmaç_sabit64(ik, YAZ_RSI,
+                                (int64_t)(uintptr_t)(sm->kod + off + sm_komut_boyu(k)));
+        x86_yığına_it(ik, YAZ_R12);
+        x86_çağır_dolaylı(ik, YAZ_RAX);
+        x86_yığından_çek(ik, YAZ_R12);
+        x86_sına_yazmaç_yazmaç(ik, YAZ_RAX, YAZ_RAX);
+        int dondu = x86_atla_eşitse(ik);
+        /* JIT_REDDET: hiçbir şey değişmedi, çağrıyı yorumlayıcı yapar;
+         * JIT_DEOPT: çağrılan yorumlayıcıya geçti, zincir boyunca dön */
+        x86_karşılaştır_yazmaç_sabit32(ik, YAZ_RAX, JIT_REDDET);
+        DEOPT(j, x86_atla_eşitse(ik), off);
+        x86_dön(ik);
+        x86_atlama_yamala(ik, dondu, ik->uzunluk);
+        return;
+    }
+
+    case SM_DONDUR:
+        yuvalar_nesnesiz(j, yb + d, off);
+        x86_taşı_bellek_yazmaç(ik, YAZ_R14, TRSM_OFS(jit_sp), YAZ_R12);
+        cerceve_dus(j);
+        return;
+
+    case SM_DONDUR_DEGER:
+        yuvalar_nesnesiz(j, yb + d - 1, off);
+        x86_taşı_yazmaç_bellek(ik, YAZ_RAX, YAZ_R12, YUVA(j, d - 1));
+        x86_taşı_bellek_yazmaç(ik, YAZ_R12, 0, YAZ_RAX);
+        x86_adres_yükle(ik, YAZ_RAX, YAZ_R12, 8);
+        x86_taşı_bellek_yazmaç(ik, YAZ_R14, TRSM_OFS(jit_sp), YAZ_RAX);
+        cerceve_dus(j);
+        return;
+
+    default:
+        /* Metin, yazdırma, DUR: yorumlayıcı */
+        break;
+    }
+
+    DEOPT(j, x86_atla(ik), off);
+}
+
+/* Deopt çıkışı: yorumlayıcı `off` komutundan, derinlik d ile devam eder */
+static void deopt_uret(JitDerleyici *j, int off) {
+    İkilKod *ik = &j->ik;
+    int d = j->jf->derinlik[off - j->bas];
+    x86_adres_yükle(ik, YAZ_RAX, YAZ_R12, YUVA(j, d));
+    x86_taşı_bellek_yazmaç(ik, YAZ_R14, TRSM_OFS(jit_sp), YAZ_RAX);
+    x86_taşı_yazmaç_sabit64(ik, YAZ_RAX, (int64_t)(uintptr_t)(j->sm->kod + off));
+    x86_taşı_bellek_yazmaç(ik, YAZ_R14, TRSM_OFS(jit_pc), YAZ_RAX);
+    x86_taşı_yazmaç_sabit32(ik, YAZ_RAX, JIT_DEOPT);
+    x86_dön(ik);
+}
+
+/* Üretilen kodu alana kopyala ve çalıştırılabilir yap */
+static uint8_t *alana_yaz(struct TrsmJit *jit, const İkilKod *ik) {
+    size_t bas = (jit->kullanilan + 15) & ~(size_t)15;
+    if (bas + (size_t)ik->uzunluk > JIT_ALAN_BOYUTU) return NULL;
+    if (mprotect(jit->alan, JIT_ALAN_BOYUTU, PROT_READ | PROT_WRITE) != 0) return NULL;
+    memcpy(jit->alan + bas, ik->veri, ik->uzunluk);
+    jit->kullanilan = bas + ik->uzunluk;
+    if (mprotect(jit->alan, JIT_ALAN_BOYUTU, PROT_READ | PROT_EXEC) != 0) return NULL;
+    return jit->alan + bas;
+}
+
+static void jit_derle(TrSM *sm, int fi) {
+    JitFonksiyon *jf = &sm->jit->fonksiyonlar[fi];
+    jf->durum = JIT_BASARISIZ;
+    if (jit_analiz(sm, fi, jf) != 0) return;
+
+    SmFonksiyon *fn = &sm->fonksiyonlar[fi];
+    int uz = fn->kod_uzunluk;
+    JitDerleyici j = { .sm = sm, .jf = jf, .bas = fn->kod_baslangic };
+    ikil_başlat(&j.ik);
+
+    int reddet[2];
+    giris_uret(&j, fi, reddet);
+
+    int *yerel_adres = malloc(uz * sizeof(int));
+    for (int i = 0; i < uz; i++) yerel_adres[i] = -1;
+    for (int off = j.bas; off < j.bas + uz; off += sm_komut_boyu(sm->kod[off])) {
+        int d = jf->derinlik[off - j.bas];
+        if (d < 0) continue;
+        yerel_adres[off - j.bas] = j.ik.uzunluk;
+        komut_uret(&j, off, d);
+    }
+
+    /* Soğuk yollar: reddetme ve deopt çıkışları */
+    x86_atlama_yamala(&j.ik, reddet[0], j.ik.uzunluk);
+    x86_atlama_yamala(&j.ik, reddet[1], j.ik.uzunluk);
+    x86_taşı_yazmaç_sabit32(&j.ik, YAZ_RAX, JIT_REDDET);
+    x86_dön(&j.ik);
+
+    int *deopt_adres = malloc(uz * sizeof(int));
+    for (int i = 0; i < uz; i++) deopt_adres[i] = -1;
+    for (int y = 0; y < j.yama_sayisi; y++) {
+        JitYama *ym = &j.yamalar[y];
+        int yerel = ym->hedef - j.bas;
+        int hedef;
+        if (ym->tur == YAMA_ETIKET) {
+            hedef = yerel_adres[yerel];
+        } else {
+            if (deopt_adres[yerel] < 0) {
+                deopt_adres[yerel] = j.ik.uzunluk;
+                deopt_uret(&j, ym->hedef);
+            }
+            hedef = deopt_adres[yerel];
+        }
+        x86_atlama_yamala(&j.ik, ym->yama, hedef);
+    }
+
+    uint8_t *kod = alana_yaz(sm->jit, &j.ik);
+    if (kod) {
+        jf->adres = calloc(uz, sizeof(uint8_t *));
+        for (int i = 0; i < uz; i++)
+            if (yerel_adres[i] >= 0) jf->adres[i] = kod + yerel_adres[i];
+        jf->durum = JIT_DERLENDI;
+        sm->jit_giris[fi] = kod;
+    }
+
+    free(deopt_adres);
+    free(yerel_adres);
+    free(j.yamalar);
+    ikil_serbest(&j.ik);
+}
+
+/* ═══════════════════════════════════════════════════════════════════
+ *  GEÇİT VE KANCALAR
+ * ═══════════════════════════════════════════════════════════════════ */
+
+/* int gecit(TrSM *sm, SmDeger *yereller, void *hedef) */
+static void gecit_uret(İkilKod *ik) {
+    static const YazmaçNo korunan[] = { YAZ_RBX, YAZ_RBP, YAZ_R12, YAZ_R13, YAZ_R14, YAZ_R15 };
+    for (int i = 0; i < 6; i++) x86_yığına_it(ik, korunan[i]);
+    x86_çıkar_yazmaç_sabit32(ik, YAZ_RSP, 8);            /* 16 bayt hizası */
+    x86_taşı_yazmaç_yazmaç(ik, YAZ_R14, YAZ_RDI);
+    x86_taşı_yazmaç_yazmaç(ik, YAZ_R12, YAZ_RSI);
+    x86_taşı_yazmaç_sabit64(ik, YAZ_R13, (int64_t)SM_ETIKET_TAM);
+    x86_taşı_yazmaç_bellek(ik, YAZ_R15, YAZ_RDI, TRSM_OFS(geneller));
+    x86_çağır_dolaylı(ik, YAZ_RDX);
+    x86_topla_yazmaç_sabit32(ik, YAZ_RSP, 8);
+    for (int i = 5; i >= 0; i--) x86_yığından_çek(ik, korunan[i]);
+    x86_dön(ik);
+}
+
+int trsm_jit_baslat(TrSM *sm) {
+    struct TrsmJit *jit = calloc(1, sizeof(*jit));
+    jit->alan = mmap(NULL, JIT_ALAN_BOYUTU, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (jit->alan == MAP_FAILED) {
+        free(jit);
+        return -1;
+    }
+    int n = sm->fonksiyon_sayisi > 0 ? sm->fonksiyon_sayisi : 1;
+    jit->fonksiyonlar = calloc(n, sizeof(JitFonksiyon));
+    for (int i = 0; i < n; i++) jit->fonksiyonlar[i].donus = -2;
+    sm->jit_giris = calloc(n, sizeof(void *));
+    sm->jit = jit;
+
+    İkilKod ik;
+    ikil_başlat(&ik);
+    gecit_uret(&ik);
+    uint8_t *gecit = alana_yaz(jit, &ik);
+    ikil_serbest(&ik);
+    if (!gecit) {
+        trsm_jit_kapat(sm);
+        return -1;
+    }
+    memcpy(&jit->gecit, &gecit, sizeof(gecit));
+    return 0;
+}
+
+void trsm_jit_kapat(TrSM *sm) {
+    struct TrsmJit *jit = sm->jit;
+    if (!jit) return;
+    for (int i = 0; i < sm->fonksiyon_sayisi; i++) {
+        free(jit->fonksiyonlar[i].derinlik);
+        free(jit->fonksiyonlar[i].adres);
+    }
+    free(jit->fonksiyonlar);
+    munmap(jit->alan, JIT_ALAN_BOYUTU);
+    free(jit);
+    free(sm->jit_giris);
+    sm->jit = NULL;
+    sm->jit_giris = NULL;
+}
+
+/* Çerçeve derlenmiş koda bu noktada girilebiliyor mu? */
+static void *giris_adresi(TrSM *sm, const CagriCercevesi *c, JitFonksiyon *jf,
+                          int off, int derinlik) {
+    int bas = c->fonksiyon->kod_baslangic;
+    if (off < bas || off >= bas + c->fonksiyon->kod_uzunluk) return NULL;
+    if (c->yerel_sayisi != jf->yerel_boyut) return NULL;
+    if (jf->derinlik[off - bas] != derinlik) return NULL;
+    if (c->taban + jf->yerel_boyut + jf->maks_derinlik > sm->yigin_kapasite) return NULL;
+    return jf->adres[off - bas];
+}
+
+void *trsm_jit_cagri(TrSM *sm, const CagriCercevesi *c) {
+    JitFonksiyon *jf = &sm->jit->fonksiyonlar[c->fonksiyon - sm->fonksiyonlar];
+    if (jf->durum == JIT_BEKLIYOR && ++jf->cagri_sayac >= JIT_CAGRI_ESIGI)
+        jit_derle(sm, (int)(c->fonksiyon - sm->fonksiyonlar));
+    if (jf->durum != JIT_DERLENDI) return NULL;
+    return giris_adresi(sm, c, jf, c->fonksiyon->kod_baslangic, 0);
+}
+
+void *trsm_jit_dongu(TrSM *sm, const CagriCercevesi *c, const uint8_t *pc, int derinlik) {
+    JitFonksiyon *jf = &sm->jit->fonksiyonlar[c->fonksiyon - sm->fonksiyonlar];
+    if (jf->durum == JIT_BEKLIYOR && ++jf->dongu_sayac >= JIT_DONGU_ESIGI)
+        jit_derle(sm, (int)(c->fonksiyon - sm->fonksiyonlar));
+    if (jf->durum != JIT_DERLENDI) return NULL;
+    return giris_adresi(sm, c, jf, (int)(pc - sm->kod), derinlik);
+}
+
+int trsm_jit_gir(TrSM *sm, SmDeger *yereller, void *hedef) {
+    sm->jit_yigin_son = sm->yigin + sm->yigin_kapasite;
+    int sinir = sm->cerceve_sayisi + JIT_IC_ICE_SINIR;
+    sm->jit_cerceve_siniri = sinir < sm->cerceve_kapasite ? sinir : sm->cerceve_kapasite;
+    return sm->jit->gecit(sm, yereller, hedef);
+}
+
+#else /* !TRSM_JIT */
+
+int trsm_jit_baslat(TrSM *sm) {
+    (void)sm;
+    return -1;
+}
+
+void trsm_jit_kapat(TrSM *sm) {
+    (void)sm;
+}
+
+#endif /* TRSM_JIT */
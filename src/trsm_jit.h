@@ -0,0 +1,40 @@
+/*
+ * Tonyukuk Sanal Makinesi — Şablon JIT
+ * Sıcak SmFonksiyon gövdelerini x86_kodlayici ile doğal koda çevirir.
+ */
+#ifndef TRSM_JIT_H
+#define TRSM_JIT_H
+
+#include "vm.h"
+
+/* Yalnızca x86-64 POSIX hedeflerinde derlenir; -DTRSM_JIT_YOK ile kapatılır */
+#if defined(__x86_64__) && (defined(__linux__) || defined(__APPLE__)) && !defined(TRSM_JIT_YOK)
+#define TRSM_JIT 1
+#endif
+
+#define JIT_CAGRI_ESIGI    200      /* bu kadar yorumlanan çağrıdan sonra derle */
+#define JIT_DONGU_ESIGI    1000     /* bu kadar geri atlamadan sonra derle */
+#define JIT_IC_ICE_SINIR   20000    /* doğal çağrı derinliği (makine yığını) */
+#define JIT_ALAN_BOYUTU    (4 << 20)
+
+/* Doğal kodun dönüş durumları */
+#define JIT_DONDU   0   /* çerçeve döndü; sm->jit_sp yeni tepe */
+#define JIT_DEOPT   1   /* sm->jit_pc / sm->jit_sp'den yorumlayıcı devam eder */
+#define JIT_REDDET  2   /* çağrı girişi yapılmadı (yalnızca doğal → doğal) */
+
+/* JIT'i hazırla; desteklenmiyorsa ya da bellek ayrılamazsa -1 */
+int  trsm_jit_baslat(TrSM *sm);
+void trsm_jit_kapat(TrSM *sm);
+
+/*
+ * Yorumlayıcı kancaları. Üst çerçeve `c` için sayaçları artırır, eşik
+ * aşılırsa fonksiyonu derler ve girilebiliyorsa doğal adres döndürür:
+ * çağrıda fonksiyon başı, geri atlamada döngü başı (OSR). NULL: yorumla.
+ */
+void *trsm_jit_cagri(TrSM *sm, const CagriCercevesi *c);
+void *trsm_jit_dongu(TrSM *sm, const CagriCercevesi *c, const uint8_t *pc, int derinlik);
+
+/* Doğal koda gir; JIT_DONDU ya da JIT_DEOPT döner */
+int  trsm_jit_gir(TrSM *sm, SmDeger *yereller, void *hedef);
+
+#endif /* TRSM_JIT_H */
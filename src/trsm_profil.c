@@ -0,0 +1,397 @@
+/*
+ * Tonyukuk Sanal Makinesi — Profil
+ *
+ * --profil ile yorumlayıcı ayrı bir dağıtım tablosuna geçer: her komut
+ * çalışmadan önce trsm_profil_komut çağrılır, profilsiz yol hiç değişmez.
+ *
+ * Kanca komut ve ardışık komut çifti sayar, alınan geri atlamaları (döngü
+ * tekrarlarını) atlama komutunun ofsetine göre toplar. Zaman ölçümü yalnızca
+ * çerçeve derinliği değiştiğinde yapılır: profil kendi çerçeve yığınını
+ * sm->cerceveler ile eşitler, giren fonksiyona çağrı yazar, çıkanın
+ * kapsayan süresini üst çerçevenin çocuk süresine ekler. Özel süre =
+ * kapsayan - çocuklar. Özyinelemede kapsayan süre yalnızca en dıştaki
+ * çağrıda sayılır.
+ *
+ * Süre x86'da TSC döngüsüdür; çalıştırma boyunca duvar saatiyle ölçülen
+ * frekansla nanosaniyeye çevrilir. Diğer mimarilerde doğrudan ns kullanılır.
+ */
+#define _POSIX_C_SOURCE 199309L /* clock_gettime */
+#include "trsm_profil.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PROFIL_TSC 1
+#endif
+
+/* ═══════════════════════════════════════════════════════════════════
+ *  DURUM
+ * ═══════════════════════════════════════════════════════════════════ */
+
+typedef struct {
+    uint64_t cagri;
+    uint64_t kapsayan;      /* döngü (TSC) ya da ns */
+    uint64_t ozel;
+    int      aktif;         /* yığında kaç kez açık (özyineleme) */
+} ProfilFonksiyon;
+
+typedef struct {
+    int      fonksiyon;     /* fonksiyon indeksi; ana program fonksiyon_sayisi */
+    uint64_t giris;
+    uint64_t cocuk;         /* çağrılanların kapsayan süreleri */
+} ProfilCerceve;
+
+struct TrsmProfil {
+    uint64_t komut[SM_KOMUT_SAYISI];
+    uint64_t cift[SM_KOMUT_SAYISI][SM_KOMUT_SAYISI];
+    uint64_t toplam;
+    int      onceki_op;
+    const uint8_t *onceki_pc;
+
+    ProfilFonksiyon *fonksiyonlar;  /* fonksiyon_sayisi + 1 (ana) */
+    ProfilCerceve   *yigin;         /* [0] her zaman ana program */
+    int      derinlik;
+    int      kapasite;
+
+    uint64_t *geri_atlama;          /* atlama komutunun ofsetine göre */
+
+    uint64_t baslangic_sayac;
+    struct timespec baslangic_saat;
+};
+
+typedef struct TrsmProfil TrsmProfil;
+
+static uint64_t profil_sayac(void) {
+#ifdef PROFIL_TSC
+    return __rdtsc();
+#else
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000u + (uint64_t)t.tv_nsec;
+#endif
+}
+
+static const char *komut_adi(int op) {
+    static const char *const adlar[SM_KOMUT_SAYISI] = {
+        [SM_SABIT_TAM] = "SABIT_TAM", [SM_SABIT_ONDALIK] = "SABIT_ONDALIK",
+        [SM_SABIT_METIN] = "SABIT_METIN", [SM_DOGRU] = "DOGRU",
+        [SM_YANLIS] = "YANLIS", [SM_BOS] = "BOS",
+        [SM_CIKAR] = "CIKAR", [SM_KOPYALA] = "KOPYALA",
+        [SM_TOPLA] = "TOPLA", [SM_CIKAR_SAYI] = "CIKAR_SAYI", [SM_CARP] = "CARP",
+        [SM_BOL] = "BOL", [SM_MOD] = "MOD", [SM_EKSI] = "EKSI",
+        [SM_TOPLA_OND] = "TOPLA_OND", [SM_CIKAR_OND] = "CIKAR_OND",
+        [SM_CARP_OND] = "CARP_OND", [SM_BOL_OND] = "BOL_OND", [SM_EKSI_OND] = "EKSI_OND",
+        [SM_ESIT] = "ESIT", [SM_ESIT_DEGIL] = "ESIT_DEGIL", [SM_KUCUK] = "KUCUK",
+        [SM_BUYUK] = "BUYUK", [SM_KUCUK_ESIT] = "KUCUK_ESIT", [SM_BUYUK_ESIT] = "BUYUK_ESIT",
+        [SM_ESIT_OND] = "ESIT_OND", [SM_KUCUK_OND] = "KUCUK_OND",
+        [SM_BUYUK_OND] = "BUYUK_OND", [SM_KUCUK_ESIT_OND] = "KUCUK_ESIT_OND",
+        [SM_BUYUK_ESIT_OND] = "BUYUK_ESIT_OND", [SM_ESIT_METIN] = "ESIT_METIN",
+        [SM_DEGIL] = "DEGIL", [SM_VE] = "VE", [SM_VEYA] = "VEYA",
+        [SM_YUKLE_YEREL] = "YUKLE_YEREL", [SM_KAYDET_YEREL] = "KAYDET_YEREL",
+        [SM_YUKLE_GENEL] = "YUKLE_GENEL", [SM_KAYDET_GENEL] = "KAYDET_GENEL",
+        [SM_ATLA] = "ATLA", [SM_ATLA_YANLIS] = "ATLA_YANLIS", [SM_ATLA_DOGRU] = "ATLA_DOGRU",
+        [SM_CAGRI] = "CAGRI", [SM_DONDUR] = "DONDUR", [SM_DONDUR_DEGER] = "DONDUR_DEGER",
+        [SM_YAZDIR] = "YAZDIR", [SM_YAZDIR_SATIR] = "YAZDIR_SATIR",
+        [SM_METIN_BIRLESTIR] = "METIN_BIRLESTIR",
+        [SM_TAM_ONDALIK] = "TAM_ONDALIK", [SM_ONDALIK_TAM] = "ONDALIK_TAM",
+        [SM_TAM_METIN] = "TAM_METIN", [SM_METIN_TAM] = "METIN_TAM",
+        [SM_DUR] = "DUR",
+        [SM_TOPLA_YEREL] = "TOPLA_YEREL", [SM_TOPLA_GENEL] = "TOPLA_GENEL",
+        [SM_ARTIR_YEREL] = "ARTIR_YEREL", [SM_ARTIR_GENEL] = "ARTIR_GENEL",
+        [SM_ESIT_ATLA_YANLIS] = "ESIT_ATLA_YANLIS",
+        [SM_ESIT_DEGIL_ATLA_YANLIS] = "ESIT_DEGIL_ATLA_YANLIS",
+        [SM_KUCUK_ATLA_YANLIS] = "KUCUK_ATLA_YANLIS",
+        [SM_BUYUK_ATLA_YANLIS] = "BUYUK_ATLA_YANLIS",
+        [SM_KUCUK_ESIT_ATLA_YANLIS] = "KUCUK_ESIT_ATLA_YANLIS",
+        [SM_BUYUK_ESIT_ATLA_YANLIS] = "BUYUK_ESIT_ATLA_YANLIS",
+        [SM_CAGRI_SABIT] = "CAGRI_SABIT",
+    };
+    return op >= 0 && op < SM_KOMUT_SAYISI && adlar[op] ? adlar[op] : "?";
+}
+
+/* ═══════════════════════════════════════════════════════════════════
+ *  ÇERÇEVE EŞİTLEME
+ * ═══════════════════════════════════════════════════════════════════ */
+
+static void profil_cik(TrsmProfil *p, uint64_t simdi) {
+    ProfilCerceve *c = &p->yigin[--p->derinlik];
+    ProfilFonksiyon *f = &p->fonksiyonlar[c->fonksiyon];
+    uint64_t kapsayan = simdi - c->giris;
+    f->ozel += kapsayan - c->cocuk;
+    if (--f->aktif == 0) f->kapsayan += kapsayan;
+    if (p->derinlik > 0) p->yigin[p->derinlik - 1].cocuk += kapsayan;
+}
+
+static int profil_gir(TrsmProfil *p, int fonksiyon, uint64_t simdi) {
+    if (p->derinlik >= p->kapasite) {
+        int yeni = p->kapasite * 2;
+        ProfilCerceve *y = realloc(p->yigin, yeni * sizeof(ProfilCerceve));
+        if (!y) return -1;
+        p->yigin = y;
+        p->kapasite = yeni;
+    }
+    ProfilCerceve *c = &p->yigin[p->derinlik++];
+    c->fonksiyon = fonksiyon;
+    c->giris = simdi;
+    c->cocuk = 0;
+    p->fonksiyonlar[fonksiyon].cagri++;
+    p->fonksiyonlar[fonksiyon].aktif++;
+    return 0;
+}
+
+/* Her komutta bir önceki komuttan bu yana en fazla bir çerçeve girilir ya
+ * da çıkılır; yine de genel durum (birden çok seviye) işlenir. */
+static void profil_esitle(TrSM *sm, TrsmProfil *p) {
+    uint64_t simdi = profil_sayac();
+    int hedef = sm->cerceve_sayisi + 1;
+    while (p->derinlik > hedef) profil_cik(p, simdi);
+    if (p->derinlik == hedef && hedef > 1 &&
+        p->yigin[hedef - 1].fonksiyon !=
+        (int)(sm->cerceveler[hedef - 2].fonksiyon - sm->fonksiyonlar))
+        profil_cik(p, simdi);
+    while (p->derinlik < hedef) {
+        int f = (int)(sm->cerceveler[p->derinlik - 1].fonksiyon - sm->fonksiyonlar);
+        if (profil_gir(p, f, simdi) != 0) return;
+    }
+}
+
+/* ═══════════════════════════════════════════════════════════════════
+ *  KANCALAR
+ * ═══════════════════════════════════════════════════════════════════ */
+
+int trsm_profil_baslat(TrSM *sm) {
+    TrsmProfil *p = calloc(1, sizeof(TrsmProfil));
+    if (!p) return -1;
+    p->fonksiyonlar = calloc(sm->fonksiyon_sayisi + 1, sizeof(ProfilFonksiyon));
+    p->geri_atlama = calloc(sm->kod_uzunluk + 1, sizeof(uint64_t));
+    p->kapasite = CERCEVE_BASLANGIC;
+    p->yigin = malloc(p->kapasite * sizeof(ProfilCerceve));
+    if (!p->fonksiyonlar || !p->geri_atlama || !p->yigin) {
+        free(p->fonksiyonlar);
+        free(p->geri_atlama);
+        free(p->yigin);
+        free(p);
+        return -1;
+    }
+    p->onceki_op = -1;
+    clock_gettime(CLOCK_MONOTONIC, &p->baslangic_saat);
+    p->baslangic_sayac = profil_sayac();
+    profil_gir(p, sm->fonksiyon_sayisi, p->baslangic_sayac);
+    sm->profil = p;
+    return 0;
+}
+
+void trsm_profil_komut(TrSM *sm, const uint8_t *pc) {
+    TrsmProfil *p = sm->profil;
+    int op = *pc;
+
+    p->toplam++;
+    p->komut[op]++;
+    if (p->onceki_op >= 0) p->cift[p->onceki_op][op]++;
+    p->onceki_op = op;
+
+    /* Önceki komut geriye atladıysa döngü tekrarıdır */
+    const uint8_t *o = p->onceki_pc;
+    if (o && sm_komut_atlama_mi(*o) && OKU_I16(o + 1) < 0 && pc == o + 3 + OKU_I16(o + 1))
+        p->geri_atlama[o - sm->kod]++;
+    p->onceki_pc = pc;
+
+    if (sm->cerceve_sayisi + 1 != p->derinlik ||
+        (p->derinlik > 1 && p->yigin[p->derinlik - 1].fonksiyon !=
+         (int)(sm->cerceveler[sm->cerceve_sayisi - 1].fonksiyon - sm->fonksiyonlar)))
+        profil_esitle(sm, p);
+}
+
+/* ═══════════════════════════════════════════════════════════════════
+ *  RAPOR
+ * ═══════════════════════════════════════════════════════════════════ */
+
+typedef struct {
+    uint64_t sayi;
+    int      a, b;
+} ProfilSira;
+
+static int sira_karsilastir(const void *x, const void *y) {
+    uint64_t a = ((const ProfilSira *)x)->sayi, b = ((const ProfilSira *)y)->sayi;
+    return a < b ? 1 : a > b ? -1 : 0;
+}
+
+static const char *fonksiyon_adi(TrSM *sm, int f) {
+    if (f >= sm->fonksiyon_sayisi) return "<ana>";
+    return sm->fonksiyonlar[f].isim ? sm->fonksiyonlar[f].isim : "?";
+}
+
+/* Ofseti içeren en dar fonksiyon (iç içe tanımlar için); yoksa ana */
+static int ofset_fonksiyonu(TrSM *sm, int ofset) {
+    int en_iyi = sm->fonksiyon_sayisi, en_dar = sm->kod_uzunluk + 1;
+    for (int i = 0; i < sm->fonksiyon_sayisi; i++) {
+        SmFonksiyon *f = &sm->fonksiyonlar[i];
+        if (ofset >= f->kod_baslangic && ofset < f->kod_baslangic + f->kod_uzunluk &&
+            f->kod_uzunluk < en_dar) {
+            en_iyi = i;
+            en_dar = f->kod_uzunluk;
+        }
+    }
+    return en_iyi;
+}
+
+static void json_metin(FILE *f, const char *s) {
+    fputc('"', f);
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') fprintf(f, "\\%c", c);
+        else if (c < 0x20) fprintf(f, "\\u%04x", c);
+        else fputc(c, f);
+    }
+    fputc('"', f);
+}
+
+void trsm_profil_bitir(TrSM *sm, const char *json_yolu) {
+    TrsmProfil *p = sm->profil;
+    if (!p) return;
+
+    uint64_t bitis = profil_sayac();
+    struct timespec saat;
+    clock_gettime(CLOCK_MONOTONIC, &saat);
+    while (p->derinlik > 0) profil_cik(p, bitis);
+
+    /* Sayaç birimi → ns */
+    double ns = (double)(saat.tv_sec - p->baslangic_saat.tv_sec) * 1e9 +
+                (double)(saat.tv_nsec - p->baslangic_saat.tv_nsec);
+    uint64_t sayac_toplam = bitis - p->baslangic_sayac;
+    double ns_carpan = sayac_toplam > 0 ? ns / (double)sayac_toplam : 1.0;
+#ifdef PROFIL_TSC
+    const char *birim = "döngü";
+#else
+    const char *birim = "ns";
+#endif
+
+    /* Sıralamalar */
+    ProfilSira komutlar[SM_KOMUT_SAYISI];
+    int komut_n = 0;
+    for (int i = 0; i < SM_KOMUT_SAYISI; i++)
+        if (p->komut[i]) komutlar[komut_n++] = (ProfilSira){ p->komut[i], i, 0 };
+    qsort(komutlar, komut_n, sizeof(ProfilSira), sira_karsilastir);
+
+    ProfilSira *ciftler = malloc(SM_KOMUT_SAYISI * SM_KOMUT_SAYISI * sizeof(ProfilSira));
+    int cift_n = 0;
+    for (int i = 0; i < SM_KOMUT_SAYISI; i++)
+        for (int j = 0; j < SM_KOMUT_SAYISI; j++)
+            if (p->cift[i][j]) ciftler[cift_n++] = (ProfilSira){ p->cift[i][j], i, j };
+    qsort(ciftler, cift_n, sizeof(ProfilSira), sira_karsilastir);
+
+    ProfilSira *fonksiyonlar = malloc((sm->fonksiyon_sayisi + 1) * sizeof(ProfilSira));
+    int fonksiyon_n = 0;
+    for (int i = 0; i <= sm->fonksiyon_sayisi; i++)
+        if (p->fonksiyonlar[i].cagri)
+            fonksiyonlar[fonksiyon_n++] = (ProfilSira){ p->fonksiyonlar[i].ozel, i, 0 };
+    qsort(fonksiyonlar, fonksiyon_n, sizeof(ProfilSira), sira_karsilastir);
+
+    int dongu_n = 0;
+    for (int i = 0; i < sm->kod_uzunluk; i++) dongu_n += p->geri_atlama[i] != 0;
+    ProfilSira *donguler = malloc((dongu_n + 1) * sizeof(ProfilSira));
+    dongu_n = 0;
+    for (int i = 0; i < sm->kod_uzunluk; i++)
+        if (p->geri_atlama[i])
+            donguler[dongu_n++] = (ProfilSira){ p->geri_atlama[i], i,
+                                                i + 3 + OKU_I16(sm->kod + i + 1) };
+    qsort(donguler, dongu_n, sizeof(ProfilSira), sira_karsilastir);
+
+    /* Tablo (programın tamponlanmış çıktısı önce gitsin) */
+    fflush(stdout);
+    fprintf(stderr, "\n=== TrSM Profil Raporu ===\n");
+    fprintf(stderr, "Süre: %.3f ms, %" PRIu64 " %s, %" PRIu64 " komut\n",
+            ns / 1e6, sayac_toplam, birim, p->toplam);
+
+    fprintf(stderr, "\n%-26s %14s %8s\n", "Komut", "Sayı", "%");
+    for (int i = 0; i < komut_n && i < PROFIL_KOMUT_SATIR; i++)
+        fprintf(stderr, "%-26s %14" PRIu64 " %7.2f%%\n", komut_adi(komutlar[i].a),
+                komutlar[i].sayi, 100.0 * komutlar[i].sayi / p->toplam);
+
+    fprintf(stderr, "\n%-26s %12s %14s %12s %14s %8s\n",
+            "Fonksiyon", "Çağrı", "Kapsayan(ms)", "Özel(ms)", "Özel/çağrı(µs)", "Özel%");
+    for (int i = 0; i < fonksiyon_n; i++) {
+        ProfilFonksiyon *f = &p->fonksiyonlar[fonksiyonlar[i].a];
+        fprintf(stderr, "%-26s %12" PRIu64 " %14.3f %12.3f %14.3f %7.2f%%\n",
+                fonksiyon_adi(sm, fonksiyonlar[i].a), f->cagri,
+                f->kapsayan * ns_carpan / 1e6, f->ozel * ns_carpan / 1e6,
+                f->ozel * ns_carpan / 1e3 / f->cagri,
+                sayac_toplam ? 100.0 * f->ozel / sayac_toplam : 0.0);
+    }
+
+    if (dongu_n > 0) {
+        fprintf(stderr, "\n%-26s %10s %10s %14s\n", "Döngü (fonksiyon)", "Atlama", "Hedef", "Tekrar");
+        for (int i = 0; i < dongu_n && i < PROFIL_DONGU_SATIR; i++)
+            fprintf(stderr, "%-26s %10d %10d %14" PRIu64 "\n",
+                    fonksiyon_adi(sm, ofset_fonksiyonu(sm, donguler[i].a)),
+                    donguler[i].a, donguler[i].b, donguler[i].sayi);
+    }
+
+    fprintf(stderr, "\n%-44s %14s %8s\n", "Ardışık komut çifti", "Sayı", "%");
+    for (int i = 0; i < cift_n && i < PROFIL_CIFT_SATIR; i++) {
+        char ad[64];
+        snprintf(ad, sizeof(ad), "%s → %s", komut_adi(ciftler[i].a), komut_adi(ciftler[i].b));
+        fprintf(stderr, "%-46s %14" PRIu64 " %7.2f%%\n", ad, ciftler[i].sayi,
+                100.0 * ciftler[i].sayi / p->toplam);
+    }
+    fprintf(stderr, "==========================\n");
+
+    /* JSON */
+    FILE *f = json_yolu ? fopen(json_yolu, "w") : NULL;
+    if (json_yolu && !f)
+        fprintf(stderr, "Uyarı: Profil dosyası yazılamadı: %s\n", json_yolu);
+    if (f) {
+        fprintf(f, "{\n  \"sure_ns\": %.0f,\n  \"sayac\": %" PRIu64 ",\n"
+                   "  \"sayac_birimi\": \"%s\",\n  \"toplam_komut\": %" PRIu64 ",\n",
+                ns, sayac_toplam, birim[0] == 'n' ? "ns" : "tsc", p->toplam);
+
+        fprintf(f, "  \"komutlar\": {");
+        for (int i = 0; i < komut_n; i++)
+            fprintf(f, "%s\n    \"%s\": %" PRIu64, i ? "," : "",
+                    komut_adi(komutlar[i].a), komutlar[i].sayi);
+        fprintf(f, "\n  },\n");
+
+        fprintf(f, "  \"komut_ciftleri\": [");
+        for (int i = 0; i < cift_n && i < PROFIL_JSON_CIFT; i++)
+            fprintf(f, "%s\n    {\"ilk\": \"%s\", \"ikinci\": \"%s\", \"sayi\": %" PRIu64 "}",
+                    i ? "," : "", komut_adi(ciftler[i].a), komut_adi(ciftler[i].b),
+                    ciftler[i].sayi);
+        fprintf(f, "\n  ],\n");
+
+        fprintf(f, "  \"fonksiyonlar\": [");
+        for (int i = 0; i < fonksiyon_n; i++) {
+            ProfilFonksiyon *pf = &p->fonksiyonlar[fonksiyonlar[i].a];
+            fprintf(f, "%s\n    {\"isim\": ", i ? "," : "");
+            json_metin(f, fonksiyon_adi(sm, fonksiyonlar[i].a));
+            fprintf(f, ", \"cagri\": %" PRIu64 ", \"kapsayan_sayac\": %" PRIu64
+                       ", \"ozel_sayac\": %" PRIu64 ", \"kapsayan_ns\": %.0f, \"ozel_ns\": %.0f}",
+                    pf->cagri, pf->kapsayan, pf->ozel,
+                    pf->kapsayan * ns_carpan, pf->ozel * ns_carpan);
+        }
+        fprintf(f, "\n  ],\n");
+
+        fprintf(f, "  \"donguler\": [");
+        for (int i = 0; i < dongu_n; i++) {
+            fprintf(f, "%s\n    {\"fonksiyon\": ", i ? "," : "");
+            json_metin(f, fonksiyon_adi(sm, ofset_fonksiyonu(sm, donguler[i].a)));
+            fprintf(f, ", \"atlama\": %d, \"hedef\": %d, \"tekrar\": %" PRIu64 "}",
+                    donguler[i].a, donguler[i].b, donguler[i].sayi);
+        }
+        fprintf(f, "\n  ]\n}\n");
+        fclose(f);
+    }
+
+    free(ciftler);
+    free(fonksiyonlar);
+    free(donguler);
+    free(p->fonksiyonlar);
+    free(p->geri_atlama);
+    free(p->yigin);
+    free(p);
+    sm->profil = NULL;
+}
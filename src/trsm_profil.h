@@ -0,0 +1,28 @@
+/*
+ * Tonyukuk Sanal Makinesi — Profil
+ * Komut sayıları, fonksiyon süreleri ve sıcak döngüler (trsm --profil).
+ */
+#ifndef TRSM_PROFIL_H
+#define TRSM_PROFIL_H
+
+#include "vm.h"
+
+#define PROFIL_KOMUT_SATIR   20     /* tabloda gösterilen en sık komut */
+#define PROFIL_CIFT_SATIR    15     /* ... ardışık komut çifti */
+#define PROFIL_DONGU_SATIR   10     /* ... geri atlama */
+#define PROFIL_JSON_CIFT     64     /* JSON'a yazılan komut çifti */
+
+/* Profili kur; sm yüklenmiş olmalı. Bellek yetmezse -1 */
+int  trsm_profil_baslat(TrSM *sm);
+
+/*
+ * Yorumlayıcı kancası: `pc`deki komut çalıştırılmadan hemen önce çağrılır.
+ * Çerçeve derinliği değişmişse fonksiyon giriş/çıkışları burada işlenir.
+ */
+void trsm_profil_komut(TrSM *sm, const uint8_t *pc);
+
+/* Açık çerçeveleri kapat, tabloyu stderr'e ve (json_yolu verilmişse)
+ * JSON'u dosyaya yaz, profili bırak */
+void trsm_profil_bitir(TrSM *sm, const char *json_yolu);
+
+#endif /* TRSM_PROFIL_H */
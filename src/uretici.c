@@ -54,6 +54,8 @@ static void bildirim_uret(Üretici *u, Düğüm *d);
 static void blok_uret(Üretici *u, Düğüm *blok);
 static void hata_bolme_sifir_uret(Üretici *u);
 static void hata_dizi_sinir_uret(Üretici *u);
+static int dizi_erisim_guvenli(Üretici *u, Düğüm *dizi, Düğüm *indeks);
+static void dizi_sinir_denetle(Üretici *u, const char *indeks, const char *uzunluk);
 static void hata_bellek_uret(Üretici *u);
 static void islev_uret(Üretici *u, Düğüm *d);
 
@@ -135,10 +137,249 @@ static void mantik_uret(Üretici *u, Düğüm *d) {
     yaz(u, "    movq    $%d, %%rax", d->veri.mantık_değer);
 }
 
+/* ---- Yazmaç tahsisi ----
+ * Sıcak tam/mantık yereller (döngü sayaçları, birikimciler, parametreler)
+ * yığın yerine callee-saved r13-r15'te tutulur. Adaylar işlev gövdesi (ve
+ * main için üst düzey kod) üretilmeden önce, kullanım sayısı döngü
+ * derinliğiyle ağırlıklandırılarak seçilir. Kapanış yakalaması (yığından kopyalar), dene/yakala (longjmp
+ * yazmaçları geri sarar) ve iç içe işlev içeren işlevler aday üretmez. */
+
+static const char *yazmac_adlari[URETICI_YAZMAC_SAYISI] = {"r13", "r14", "r15"};
+
+typedef struct {
+    const char *isim;
+    long        agirlik;
+    int         tanimli;   /* tam/mantık olarak tanımlanıyor mu? */
+} YazmacAday;
+
+#define YAZMAC_ADAY_MAKS 64
+
+static int yazmac_engel_var(Düğüm *d) {
+    if (!d) return 0;
+    switch (d->tur) {
+    case DÜĞÜM_LAMBDA:
+    case DÜĞÜM_İŞLEV:
+    case DÜĞÜM_SINIF:
+    case DÜĞÜM_DENE_YAKALA:
+    case DÜĞÜM_ÜRET:
+    case DÜĞÜM_BEKLE:
+        return 1;
+    default:
+        break;
+    }
+    for (int i = 0; i < d->çocuk_sayısı; i++) {
+        if (yazmac_engel_var(d->çocuklar[i])) return 1;
+    }
+    return 0;
+}
+
+static YazmacAday *yazmac_aday_bul(YazmacAday *a, int *n, const char *isim) {
+    for (int i = 0; i < *n; i++) {
+        if (strcmp(a[i].isim, isim) == 0) return &a[i];
+    }
+    if (*n >= YAZMAC_ADAY_MAKS) return NULL;
+    a[*n].isim = isim;
+    a[*n].agirlik = 0;
+    a[*n].tanimli = 0;
+    return &a[(*n)++];
+}
+
+static void yazmac_say(Düğüm *d, int derinlik, YazmacAday *a, int *n) {
+    if (!d) return;
+    YazmacAday *y = NULL;
+    switch (d->tur) {
+    case DÜĞÜM_DEĞİŞKEN: {
+        TipTürü t = tip_adı_çevir(d->veri.değişken.tip);
+        if (!d->veri.değişken.genel && d->veri.değişken.isim &&
+            (t == TİP_TAM || t == TİP_MANTIK)) {
+            y = yazmac_aday_bul(a, n, d->veri.değişken.isim);
+            if (y) y->tanimli = 1;
+        }
+        break;
+    }
+    case DÜĞÜM_DÖNGÜ:
+        if (d->veri.dongu.isim) {
+            y = yazmac_aday_bul(a, n, d->veri.dongu.isim);
+            if (y) { y->tanimli = 1; y->agirlik += 8L << (3 * (derinlik < 6 ? derinlik : 6)); }
+        }
+        break;
+    case DÜĞÜM_TANIMLAYICI:
+    case DÜĞÜM_ATAMA:
+    case DÜĞÜM_WALRUS:
+        if (d->veri.tanimlayici.isim) {
+            y = yazmac_aday_bul(a, n, d->veri.tanimlayici.isim);
+            if (y) y->agirlik += 1L << (3 * (derinlik < 6 ? derinlik : 6));
+        }
+        break;
+    default:
+        break;
+    }
+    int ic = (d->tur == DÜĞÜM_DÖNGÜ || d->tur == DÜĞÜM_İKEN ||
+              d->tur == DÜĞÜM_HER_İÇİN) ? derinlik + 1 : derinlik;
+    for (int i = 0; i < d->çocuk_sayısı; i++) {
+        yazmac_say(d->çocuklar[i], ic, a, n);
+    }
+}
+
+static int yazmac_en_agirlari_sec(Üretici *u, YazmacAday *adaylar, int n);
+
+/* İşlev için yazmaç adaylarını seç; seçilen sayıyı döndürür */
+static int yazmac_adaylari_sec(Üretici *u, Düğüm *d) {
+    u->yazmac_aday_sayisi = 0;
+    if (d->veri.islev.eszamansiz) return 0;
+    for (int i = 0; i < d->çocuk_sayısı; i++) {
+        if (yazmac_engel_var(d->çocuklar[i])) return 0;
+    }
+
+    YazmacAday adaylar[YAZMAC_ADAY_MAKS];
+    int n = 0;
+    if (d->çocuk_sayısı > 0) {
+        Düğüm *params = d->çocuklar[0];
+        for (int i = 0; i < params->çocuk_sayısı && i < 6; i++) {
+            Düğüm *p = params->çocuklar[i];
+            TipTürü t = tip_adı_çevir(p->veri.değişken.tip);
+            if (p->veri.değişken.isim && (t == TİP_TAM || t == TİP_MANTIK)) {
+                YazmacAday *y = yazmac_aday_bul(adaylar, &n, p->veri.değişken.isim);
+                if (y) y->tanimli = 1;
+            }
+        }
+    }
+    if (d->çocuk_sayısı > 1) yazmac_say(d->çocuklar[1], 0, adaylar, &n);
+    return yazmac_en_agirlari_sec(u, adaylar, n);
+}
+
+/* main için adaylar: işlev/sınıf/test tanımları ayrı çerçevede üretilir */
+static int ana_yazmac_adaylari_sec(Üretici *u, Düğüm *program) {
+    u->yazmac_aday_sayisi = 0;
+    YazmacAday adaylar[YAZMAC_ADAY_MAKS];
+    int n = 0;
+    for (int i = 0; i < program->çocuk_sayısı; i++) {
+        Düğüm *c = program->çocuklar[i];
+        if (c->tur == DÜĞÜM_İŞLEV || c->tur == DÜĞÜM_SINIF || c->tur == DÜĞÜM_TEST) continue;
+        if (yazmac_engel_var(c)) return 0;
+        yazmac_say(c, 0, adaylar, &n);
+    }
+    return yazmac_en_agirlari_sec(u, adaylar, n);
+}
+
+/* En ağır adayları seç (tek kullanımlık değişken kaydet/yükle maliyetine değmez) */
+static int yazmac_en_agirlari_sec(Üretici *u, YazmacAday *adaylar, int n) {
+    while (u->yazmac_aday_sayisi < URETICI_YAZMAC_SAYISI) {
+        YazmacAday *en = NULL;
+        for (int i = 0; i < n; i++) {
+            if (!adaylar[i].tanimli || adaylar[i].agirlik < 4) continue;
+            if (!en || adaylar[i].agirlik > en->agirlik) en = &adaylar[i];
+        }
+        if (!en) break;
+        u->yazmac_adaylari[u->yazmac_aday_sayisi++] = (char *)en->isim;
+        en->tanimli = 0;
+    }
+    return u->yazmac_aday_sayisi;
+}
+
+/* Yeni tanımlanan sembole aday yazmacını ata. onceki: tanımdan önce aynı
+ * isimle görünen sembol; yazmacı tutuyorsa (gölgeleme) yığında kalınır. */
+static void yazmac_ata(Üretici *u, Sembol *s, Sembol *onceki) {
+    if (!s || s->yazmac || s->global_mi) return;
+    if (s->tip != TİP_TAM && s->tip != TİP_MANTIK) return;
+    for (int i = 0; i < u->yazmac_aday_sayisi; i++) {
+        if (strcmp(u->yazmac_adaylari[i], s->isim) != 0) continue;
+        if (onceki && onceki != s && onceki->yazmac == i + 1) return;
+        s->yazmac = i + 1;
+        return;
+    }
+}
+
+/* Skaler yerelin operandı: "%r13" veya "-N(%rbp)" */
+static const char *yerel_yer(Sembol *s) {
+    static char tampon[4][32];
+    static int sira = 0;
+    char *b = tampon[sira++ & 3];
+    if (s->yazmac > 0) {
+        snprintf(b, 32, "%%%s", yazmac_adlari[s->yazmac - 1]);
+    } else {
+        snprintf(b, 32, "-%d(%%rbp)", (s->yerel_indeks + 1) * 8);
+    }
+    return b;
+}
+
+/* İşlev çıkışı öncesi callee-saved yazmaçları geri yükle (leave'den önce) */
+static void yazmac_geri_yukle(Üretici *u) {
+    for (int i = 0; i < u->yazmac_aday_sayisi; i++) {
+        yaz(u, "    movq    -%d(%%rbp), %%%s", (i + 1) * 8, yazmac_adlari[i]);
+    }
+}
+
+/* ---- Kuyruk çağrıları ----
+ * `döndür f(...)` çağrıyı işlevin son işi yapar: öz çağrıda çerçeve yeniden
+ * kullanılır (argümanlar parametre yerlerine yazılıp gövde başına atlanır),
+ * başka bir kullanıcı işlevine çerçeve bırakılıp atlanır. Ortak koşullar
+ * burada, backend'e özgü olanlar (dene, ABI) üreticilerde. */
+
+const char *kuyruk_cagri_engeli(Düğüm *islev, Düğüm *cagri, int *oz) {
+    *oz = 0;
+    if (cagri->veri.tanimlayici.tip) return "metot çağrısı";
+    if (cagri->veri.tanimlayici.cagri_tip_parametre) return "generic çağrı";
+    if (!islev) return "işlev dışında";
+    if (islev->veri.islev.eszamansiz) return "eşzamansız işlev";
+    /* Dekoratörlü işlevin kendi adı sarmalayıcıyı gösterir */
+    const char *dek = islev->veri.islev.dekorator;
+    *oz = (!dek || satirici_ipucu(dek)) && islev->veri.islev.isim &&
+          strcmp(islev->veri.islev.isim, cagri->veri.tanimlayici.isim) == 0;
+    return NULL;
+}
+
+void kuyruk_rapor(Üretici *u, Düğüm *cagri, const char *engel) {
+    if (!u->kuyruk_rapor || !engel) return;
+    fprintf(stderr, "not: %s:%d:%d: '%s' kuyruk çağrısına çevrilmedi: %s\n",
+            u->kaynak_dosya ? u->kaynak_dosya : "?", cagri->satir, cagri->sutun,
+            cagri->veri.tanimlayici.isim, engel);
+}
+
+/* Adlı işlev ya da yakalamasız lambda için .rodata'da [kod, 0] kapanışı
+ * (isim başına bir kez) */
+static void statik_kapanis_uret(Üretici *u, const char *isim) {
+    for (int i = 0; i < u->statik_kapanis_sayisi; i++) {
+        if (strcmp(u->statik_kapanislar[i], isim) == 0) return;
+    }
+    if (u->statik_kapanis_sayisi >= u->statik_kapanis_kapasite) {
+        int yeni_kapasite = u->statik_kapanis_kapasite ? u->statik_kapanis_kapasite * 2 : 16;
+        char **yeni = (char **)arena_ayir(u->arena, yeni_kapasite * sizeof(char *));
+        if (u->statik_kapanis_sayisi > 0)
+            memcpy(yeni, u->statik_kapanislar, u->statik_kapanis_sayisi * sizeof(char *));
+        u->statik_kapanislar = yeni;
+        u->statik_kapanis_kapasite = yeni_kapasite;
+    }
+    u->statik_kapanislar[u->statik_kapanis_sayisi++] = arena_strdup(u->arena, isim);
+    veri_yaz(u, "    .p2align 3");
+    veri_yaz(u, "_tr_kp_%s:", isim);
+    veri_yaz(u, "    .quad   %s, 0", isim);
+}
+
+/* İşlev değerini (kapanış işaretçisi) rax'a yükle. Lambda ve kapanış
+ * tutan değişkenler değerleriyle, işlev adları statik kapanışlarıyla gelir. */
+static void kapanis_deger_uret(Üretici *u, Düğüm *d) {
+    if (d->tur == DÜĞÜM_TANIMLAYICI) {
+        Sembol *s = sembol_ara(u->kapsam, d->veri.tanimlayici.isim);
+        if (!s || s->islev_mi) {
+            statik_kapanis_uret(u, d->veri.tanimlayici.isim);
+            yaz(u, "    leaq    _tr_kp_%s(%%rip), %%rax", d->veri.tanimlayici.isim);
+            return;
+        }
+    }
+    ifade_üret(u, d);
+}
+
 static void tanimlayici_uret(Üretici *u, Düğüm *d) {
     Sembol *s = sembol_ara(u->kapsam, d->veri.tanimlayici.isim);
     if (!s) return;
 
+    if (s->islev_mi) {
+        statik_kapanis_uret(u, d->veri.tanimlayici.isim);
+        yaz(u, "    leaq    _tr_kp_%s(%%rip), %%rax", d->veri.tanimlayici.isim);
+        return;
+    }
+
     if (s->global_mi) {
         /* Global değişken: RIP-relative erişim */
         if (s->tip == TİP_METİN || s->tip == TİP_DİZİ) {
@@ -160,7 +401,7 @@ static void tanimlayici_uret(Üretici *u, Düğüm *d) {
         yaz(u, "    movsd   -%d(%%rbp), %%xmm0", offset);
     } else {
         /* TİP_TAM, TİP_MANTIK, TİP_SINIF (pointer) */
-        yaz(u, "    movq    -%d(%%rbp), %%rax", offset);
+        yaz(u, "    movq    %s, %%rax", yerel_yer(s));
     }
 }
 
@@ -211,6 +452,8 @@ static void kapanis_yakala_topla(Düğüm *d, Kapsam *lambda_kapsam,
     }
 }
 
+/* Adıyla değer olarak kullanılan işlevin salt okunur kapanışı: [kod, 0].
+ * İşlev başına bir kez üretilir. */
 static char *sinif_adi_bul(Üretici *u, Düğüm *nesne) {
     if (nesne->tur == DÜĞÜM_TANIMLAYICI) {
         Sembol *s = sembol_ara(u->kapsam, nesne->veri.tanimlayici.isim);
@@ -219,6 +462,32 @@ static char *sinif_adi_bul(Üretici *u, Düğüm *nesne) {
     return NULL;
 }
 
+/* Sağ operand tek bir movq ile okunabiliyorsa (32-bit sabit ya da skaler
+ * tam/mantık değişken) operand metnini yazar ve 1 döndürür. */
+static int basit_tam_operand(Üretici *u, Düğüm *d, char *buf, size_t boyut) {
+    if (d->tur == DÜĞÜM_TAM_SAYI) {
+        long long v = d->veri.tam_deger;
+        if (v < -2147483648LL || v > 2147483647LL) return 0;
+        snprintf(buf, boyut, "$%lld", v);
+        return 1;
+    }
+    if (d->tur == DÜĞÜM_MANTIK_DEĞERİ) {
+        snprintf(buf, boyut, "$%d", d->veri.mantık_değer);
+        return 1;
+    }
+    if (d->tur == DÜĞÜM_TANIMLAYICI) {
+        Sembol *s = sembol_ara(u->kapsam, d->veri.tanimlayici.isim);
+        if (!s || (s->tip != TİP_TAM && s->tip != TİP_MANTIK)) return 0;
+        if (s->global_mi) {
+            snprintf(buf, boyut, "_genel_%s(%%rip)", d->veri.tanimlayici.isim);
+        } else {
+            snprintf(buf, boyut, "%s", yerel_yer(s));
+        }
+        return 1;
+    }
+    return 0;
+}
+
 static void ikili_islem_uret(Üretici *u, Düğüm *d) {
     /* Operatör yükleme: sol taraf sınıf ise metot çağrısı yap */
     if (d->çocuklar[0]->sonuç_tipi == TİP_SINIF) {
@@ -363,14 +632,21 @@ static void ikili_islem_uret(Üretici *u, Düğüm *d) {
     }
 
     /* Tam sayı aritmetik */
-    /* Sol tarafı hesapla, stack'e at */
-    ifade_üret(u, d->çocuklar[0]);
-    yaz(u, "    pushq   %%rax");
+    char sag_yer[64];
+    if (basit_tam_operand(u, d->çocuklar[1], sag_yer, sizeof(sag_yer))) {
+        /* Sağ taraf yan etkisiz sabit/değişken: yığın turu olmadan rcx'e yükle */
+        ifade_üret(u, d->çocuklar[0]);
+        yaz(u, "    movq    %s, %%rcx", sag_yer);
+    } else {
+        /* Sol tarafı hesapla, stack'e at */
+        ifade_üret(u, d->çocuklar[0]);
+        yaz(u, "    pushq   %%rax");
 
-    /* Sağ tarafı hesapla */
-    ifade_üret(u, d->çocuklar[1]);
-    yaz(u, "    movq    %%rax, %%rcx");  /* sağ -> rcx */
-    yaz(u, "    popq    %%rax");          /* sol -> rax */
+        /* Sağ tarafı hesapla */
+        ifade_üret(u, d->çocuklar[1]);
+        yaz(u, "    movq    %%rax, %%rcx");  /* sağ -> rcx */
+        yaz(u, "    popq    %%rax");          /* sol -> rax */
+    }
 
     switch (d->veri.islem.islem) {
     case TOK_ARTI:
@@ -783,18 +1059,247 @@ static void yazdir_ondalik_uret_fn(Üretici *u) {
     yardimci_yaz(u, "    ret");
 }
 
-/* ---- Runtime hata yardımcıları ---- */
+/* ---- Tablo tabanlı istisna: CFI ve LSDA ----
+ * dene gövdeleri çalışma zamanında hiçbir şey kaydetmez; her işlevin
+ * .eh_frame kaydı (.cfi_*) yığın çözücüye çerçeveyi, .gcc_except_table
+ * (LSDA) de hangi kod aralığının hangi iniş pistine gittiğini anlatır.
+ * Kişilik işlevi _tr_kisilik'tir (calismazamani.c). */
+
+static void islev_giris_yaz(Üretici *u) {
+    if (!u->dene.islev_bas) u->dene.islev_bas = yeni_etiket(u);
+    yaz(u, ".L%d:", u->dene.islev_bas);
+    yaz(u, "    .cfi_startproc");
+    yaz(u, "    pushq   %%rbp");
+    yaz(u, "    .cfi_def_cfa_offset 16");
+    yaz(u, "    .cfi_offset %%rbp, -16");
+    yaz(u, "    movq    %%rsp, %%rbp");
+    yaz(u, "    .cfi_def_cfa_register %%rbp");
+}
+
+/* Açık dene aralığını etikette kapat: [acik_bas, etiket) en içteki piste gider */
+static void dene_aralik_kapat(Üretici *u, int etiket) {
+    DeneTablosu *t = &u->dene;
+    if (t->derinlik == 0) return;
+    if (t->sayi >= t->kapasite) {
+        int yeni_kap = t->kapasite ? t->kapasite * 2 : 16;
+        int *yeni = (int *)arena_ayir(u->arena, (size_t)yeni_kap * 3 * sizeof(int));
+        if (t->sayi) memcpy(yeni, t->araliklar, (size_t)t->sayi * 3 * sizeof(int));
+        t->araliklar = yeni;
+        t->kapasite = yeni_kap;
+    }
+    int *a = &t->araliklar[t->sayi++ * 3];
+    a[0] = t->acik_bas;
+    a[1] = etiket;
+    a[2] = t->pistler[t->derinlik - 1];
+}
+
+/* Pistlerin yığın işaretçisi slotları işlev kapsamında gövdeden önce
+ * ayrılır; böylece çerçeve boyutuna girerler */
+static int dene_say(Düğüm *d) {
+    if (!d) return 0;
+    if (d->tur == DÜĞÜM_LAMBDA || d->tur == DÜĞÜM_İŞLEV ||
+        d->tur == DÜĞÜM_SINIF || d->tur == DÜĞÜM_TEST) return 0;
+    int n = d->tur == DÜĞÜM_DENE_YAKALA;
+    for (int i = 0; i < d->çocuk_sayısı; i++) n += dene_say(d->çocuklar[i]);
+    return n;
+}
+
+static void dene_slotlari_ayir(Üretici *u, Düğüm *govde) {
+    u->dene.yigin_slot = kapsam_yerel_ayir(u->kapsam, dene_say(govde));
+}
+
+/* İşlev sonu: dene aralıkları varsa kişilik + LSDA, ardından FDE kapanışı */
+static void islev_bitis_yaz(Üretici *u) {
+    DeneTablosu *t = &u->dene;
+    int n = -1;
+    if (t->sayi > 0) {
+        n = u->lsda_sayac++;
+        yaz(u, "    .cfi_personality 0x3, _tr_kisilik");
+        yaz(u, "    .cfi_lsda 0x3, .LLSDA%d", n);
+    }
+    yaz(u, "    .cfi_endproc");
+    if (n >= 0) {
+        yaz(u, "    .pushsection .gcc_except_table, \"a\", @progbits");
+        yaz(u, "    .p2align 2");
+        yaz(u, ".LLSDA%d:", n);
+        yaz(u, "    .byte   0xff");    /* iniş pisti tabanı: işlev başı */
+        yaz(u, "    .byte   0xff");    /* tip tablosu yok, tip seçimi pistte */
+        yaz(u, "    .byte   0x1");     /* çağrı noktası kodlaması: uleb128 */
+        yaz(u, "    .uleb128 .LLSDACSE%d-.LLSDACSB%d", n, n);
+        yaz(u, ".LLSDACSB%d:", n);
+        for (int i = 0; i < t->sayi; i++) {
+            int *a = &t->araliklar[i * 3];
+            if (a[0] == a[1]) continue;
+            yaz(u, "    .uleb128 .L%d-.L%d", a[0], t->islev_bas);
+            yaz(u, "    .uleb128 .L%d-.L%d", a[1], a[0]);
+            yaz(u, "    .uleb128 .L%d-.L%d", a[2], t->islev_bas);
+            yaz(u, "    .uleb128 0x1");    /* eylem: yakala */
+        }
+        yaz(u, ".LLSDACSE%d:", n);
+        yaz(u, "    .popsection");
+    }
+    memset(t, 0, sizeof(*t));
+}
+
+/* ---- Referans yazımları ----
+ * Nesne (sınıf, dizi, sözlük, küme) değerlerinin alan ve dizi elemanı
+ * yazımları _tr_ref_yaz'dan geçer: çalışma zamanı sayaçları günceller ve
+ * döngü toplayıcının gezeceği yuvaları işaretler. Diğer yazımlar hedef
+ * nesnenin tip alanındaki NESNE_BAYRAK_REFLI'ye bakar; nesnede işaretli
+ * yuva yoksa doğrudan yazılır, varsa eski değerin sayacı için yine
+ * _tr_ref_yaz çağrılır. Yuvada zaten aynı değer varsa çağrı atlanır. */
+
+static int referans_degeri_mi(TipTürü t) {
+    return t == TİP_SINIF || t == TİP_DİZİ || t == TİP_SÖZLÜK || t == TİP_KÜME;
+}
+
+/* İfade ortasından çalışma zamanı çağrısı: yığın hizası bilinmediğinden
+ * rsp 16'ya hizalanır, dönüşte geri yüklenir */
+static void hizali_cagri(Üretici *u, const char *islev) {
+    yaz(u, "    pushq   %%rsp");
+    yaz(u, "    pushq   (%%rsp)");
+    yaz(u, "    andq    $-16, %%rsp");
+    yaz(u, "    call    %s", islev);
+    yaz(u, "    movq    8(%%rsp), %%rsp");
+}
+
+/* Kullanıcı işlevi argüman yerleşimi: tam/metin/dizi rdi..r9'a (metin ve
+ * dizi iki yazmaç), ondalık xmm0..7'ye sırayla dağıtılır. Sığmayan ilk
+ * argüman ve sonrakiler yığında, 16(%rbp)'den başlayarak argüman sırasıyla
+ * durur. yigin[i] = argümanın yığın kelime indisi (yazmaçtaysa -1); dönüş
+ * yığın kelime sayısı. Çağıran, prolog ve öz kuyruk çağrısı bunu paylaşır. */
+static int arguman_yerlesimi(const TipTürü *tipler, int n, int *yigin) {
+    int tam = 0, xmm = 0, kelime = 0;
+    for (int i = 0; i < n; i++) {
+        TipTürü t = tipler[i];
+        int cift = t == TİP_METİN || t == TİP_DİZİ;
+        int sigar = t == TİP_ONDALIK ? xmm < 8 : tam + cift < 6;
+        if (kelime == 0 && sigar) {
+            if (t == TİP_ONDALIK) xmm++;
+            else tam += 1 + cift;
+            yigin[i] = -1;
+        } else {
+            yigin[i] = kelime;
+            kelime += 1 + cift;
+        }
+    }
+    return kelime;
+}
+
+/* rax = nesne, indeks = kelime indisi ("$n" ya da yazmaç), deger = yazılacak
+ * kelime (rdi/rsi dışında bir yazmaç). taze: nesne yeni ayrıldı, işaretli
+ * yuvası olamaz. */
+static void referans_yaz_uret(Üretici *u, const char *indeks, const char *deger,
+                              int referans, int taze) {
+    int yavas = -1, son = -1;
+    char hedef[64];
+    if (indeks[0] == '$') snprintf(hedef, sizeof(hedef), "%lld(%%rax)", atoll(indeks + 1) * 8);
+    else snprintf(hedef, sizeof(hedef), "(%%rax, %s, 8)", indeks);
+    if (referans && !taze) {
+        /* Yuvadaki değerin aynısı yazılıyorsa sayaçlar değişmez */
+        son = yeni_etiket(u);
+        yaz(u, "    cmpq    %s, %s", deger, hedef);
+        yaz(u, "    je      .L%d", son);
+    }
+    if (!referans) {
+        if (taze) {
+            yaz(u, "    movq    %s, %s", deger, hedef);
+            return;
+        }
+        yavas = yeni_etiket(u);
+        son = yeni_etiket(u);
+        yaz(u, "    testq   $0x1000, -16(%%rax)");   /* tip: NESNE_BAYRAK_REFLI */
+        yaz(u, "    jnz     .L%d", yavas);
+        yaz(u, "    movq    %s, %s", deger, hedef);
+        yaz(u, "    jmp     .L%d", son);
+        yaz(u, ".L%d:", yavas);
+    }
+    if (strcmp(deger, "%rdx") != 0) yaz(u, "    movq    %s, %%rdx", deger);
+    yaz(u, "    movq    %%rax, %%rdi");
+    yaz(u, "    movq    %s, %%rsi", indeks);
+    hizali_cagri(u, "_tr_ref_yaz");
+    if (son >= 0) yaz(u, ".L%d:", son);
+}
+
+/* ---- Dizi eklemeleri ----
+ * ekle/birleştir/zincir yeni dizi döndürür. `d = ekle(d, x)` biçiminde eski
+ * görünüm atamayla kaybolduğundan runtime'ın _yerinde sürümü çağrılır ve
+ * dizi sonuna sahipse yerinde büyür. Parametre ve yakalanan dizilerde bu
+ * yapılmaz (çağıran aynı tamponu görür); bir dizi değişkeni başka bir
+ * değişkene ya da alana atanınca ya da bir kapanışa yakalanınca tampon
+ * NESNE_BAYRAK_ORTAK alır ve artık yerinde büyütülmez. */
+
+static const char *yerinde_ekleme_isim(const char *rt) {
+    if (!rt) return NULL;
+    if (strcmp(rt, "_tr_ekle") == 0) return "_tr_ekle_yerinde";
+    if (strcmp(rt, "_tr_birlestir_dizi") == 0 || strcmp(rt, "_tr_zincir") == 0)
+        return "_tr_birlestir_yerinde";
+    return NULL;
+}
+
+/* Çağrının runtime ismi: `d = ekle(d, x)` ise _yerinde sürümü */
+static const char *runtime_cagri_isim(Üretici *u, Düğüm *d, const char *rt) {
+    const char *yerinde = d == u->yerinde_cagri ? yerinde_ekleme_isim(rt) : NULL;
+    return yerinde ? yerinde : rt;
+}
+
+/* s = f(s, ...) ve f yerinde büyüyebilen bir ekleme mi */
+static int dizi_devralma_mi(Üretici *u, Düğüm *d, Sembol *s) {
+    Düğüm *deger = d->çocuklar[0];
+    if (!s || s->tip != TİP_DİZİ || s->parametre_mi || s->islev_mi) return 0;
+    if (deger->tur != DÜĞÜM_ÇAĞRI || deger->çocuk_sayısı < 1 ||
+        deger->çocuklar[0]->tur != DÜĞÜM_TANIMLAYICI ||
+        strcmp(deger->çocuklar[0]->veri.tanimlayici.isim, d->veri.tanimlayici.isim) != 0)
+        return 0;
+    const char *rt = NULL;
+    Sembol *fn = sembol_ara(u->kapsam, deger->veri.tanimlayici.isim);
+    if (fn) {
+        rt = fn->runtime_isim;
+    } else {
+        const ModülFonksiyon *mf = modul_fonksiyon_bul(deger->veri.tanimlayici.isim);
+        if (mf) rt = mf->runtime_isim;
+    }
+    return yerinde_ekleme_isim(rt) != NULL;
+}
+
+/* Dizi değeri (rax = elemanlar, rbx = sayı) üret; bir dizi değişkeniyse
+ * tamponu artık iki yerden görüldüğü için ortak işaretle */
+static void dizi_deger_uret(Üretici *u, Düğüm *d) {
+    ifade_üret(u, d);
+    if (d->tur != DÜĞÜM_TANIMLAYICI || d->sonuç_tipi != TİP_DİZİ) return;
+    int son = yeni_etiket(u);
+    yaz(u, "    testq   %%rax, %%rax");
+    yaz(u, "    jz      .L%d", son);
+    yaz(u, "    pushq   %%rax");
+    yaz(u, "    movq    %%rax, %%rdi");
+    hizali_cagri(u, "_tr_dizi_ortakla");
+    yaz(u, "    popq    %%rax");
+    yaz(u, ".L%d:", son);
+}
+
+/* ---- Runtime hata yardımcıları ----
+ * Tipli istisna fırlatır; yakalayan yoksa çalışma zamanı mesajı stderr'e
+ * yazıp 1 ile çıkar. Çağrı ifade ortasından gelebilir, yığın hizalanır. */
+
+static void hata_firlat_yaz(Üretici *u, int idx, int tip_kodu) {
+    yardimci_yaz(u, "    .cfi_startproc");
+    yardimci_yaz(u, "    pushq   %%rbp");
+    yardimci_yaz(u, "    .cfi_def_cfa_offset 16");
+    yardimci_yaz(u, "    .cfi_offset %%rbp, -16");
+    yardimci_yaz(u, "    movq    %%rsp, %%rbp");
+    yardimci_yaz(u, "    .cfi_def_cfa_register %%rbp");
+    yardimci_yaz(u, "    andq    $-16, %%rsp");
+    yardimci_yaz(u, "    leaq    .LC%d(%%rip), %%rdi", idx);
+    yardimci_yaz(u, "    movq    $.LC%d_len, %%rsi", idx);
+    yardimci_yaz(u, "    movq    $%d, %%rdx", tip_kodu);
+    yardimci_yaz(u, "    call    _tr_firlat_tipli");
+    yardimci_yaz(u, "    .cfi_endproc");
+}
 
 static void hata_bolme_sifir_uret(Üretici *u) {
     if (u->hata_bolme_sifir_uretildi) return;
     u->hata_bolme_sifir_uretildi = 1;
 
-    /* İstisna çerçevesi BSS'i gerekiyor (aktif handler kontrolü için) */
-    if (!u->istisna_bss_uretildi) {
-        bss_yaz(u, "    .comm   _istisna_cerceve, 56, 8");
-        u->istisna_bss_uretildi = 1;
-    }
-
     int idx = u->metin_sayac++;
     veri_yaz(u, ".LC%d:", idx);
     veri_yaz(u, "    .byte 72,97,116,97,58,32,115,105,102,105,114,97,32,98,111,108,109,101,10");
@@ -803,40 +1308,13 @@ static void hata_bolme_sifir_uret(Üretici *u) {
     yardimci_yaz(u, "");
     yardimci_yaz(u, "# runtime hata: sifira bolme");
     yardimci_yaz(u, "_hata_bolme_sifir:");
-    /* Aktif istisna çerçevesi var mı kontrol et */
-    yardimci_yaz(u, "    cmpq    $0, _istisna_cerceve+24(%%rip)");
-    yardimci_yaz(u, "    je      .Lbolme_exit_%d", idx);
-    /* Aktif handler var: istisna fırlat */
-    yardimci_yaz(u, "    leaq    .LC%d(%%rip), %%rax", idx);
-    yardimci_yaz(u, "    movq    $.LC%d_len, %%rbx", idx);
-    yardimci_yaz(u, "    movq    %%rax, _istisna_cerceve+32(%%rip)");
-    yardimci_yaz(u, "    movq    %%rbx, _istisna_cerceve+40(%%rip)");
-    yardimci_yaz(u, "    movq    $5, _istisna_cerceve+48(%%rip)");  /* BolmeHatasi=5 */
-    yardimci_yaz(u, "    movq    _istisna_cerceve(%%rip), %%rbp");
-    yardimci_yaz(u, "    movq    _istisna_cerceve+8(%%rip), %%rsp");
-    yardimci_yaz(u, "    jmpq    *_istisna_cerceve+16(%%rip)");
-    /* Handler yok: stderr'e yaz ve çık */
-    yardimci_yaz(u, ".Lbolme_exit_%d:", idx);
-    yardimci_yaz(u, "    movq    $1, %%rax");
-    yardimci_yaz(u, "    movq    $2, %%rdi");           /* stderr */
-    yardimci_yaz(u, "    leaq    .LC%d(%%rip), %%rsi", idx);
-    yardimci_yaz(u, "    movq    $.LC%d_len, %%rdx", idx);
-    yardimci_yaz(u, "    syscall");
-    yardimci_yaz(u, "    movq    $60, %%rax");
-    yardimci_yaz(u, "    movq    $1, %%rdi");
-    yardimci_yaz(u, "    syscall");
+    hata_firlat_yaz(u, idx, 5);     /* BolmeHatasi=5 */
 }
 
 static void hata_dizi_sinir_uret(Üretici *u) {
     if (u->hata_dizi_sinir_uretildi) return;
     u->hata_dizi_sinir_uretildi = 1;
 
-    /* İstisna çerçevesi BSS'i gerekiyor (aktif handler kontrolü için) */
-    if (!u->istisna_bss_uretildi) {
-        bss_yaz(u, "    .comm   _istisna_cerceve, 56, 8");
-        u->istisna_bss_uretildi = 1;
-    }
-
     int idx = u->metin_sayac++;
     veri_yaz(u, ".LC%d:", idx);
     /* "Hata: dizi sinir asimi\n" */
@@ -846,28 +1324,7 @@ static void hata_dizi_sinir_uret(Üretici *u) {
     yardimci_yaz(u, "");
     yardimci_yaz(u, "# runtime hata: dizi sinir asimi");
     yardimci_yaz(u, "_hata_dizi_sinir:");
-    /* Aktif istisna çerçevesi var mı kontrol et */
-    yardimci_yaz(u, "    cmpq    $0, _istisna_cerceve+24(%%rip)");
-    yardimci_yaz(u, "    je      .Ldizi_exit_%d", idx);
-    /* Aktif handler var: istisna fırlat */
-    yardimci_yaz(u, "    leaq    .LC%d(%%rip), %%rax", idx);
-    yardimci_yaz(u, "    movq    $.LC%d_len, %%rbx", idx);
-    yardimci_yaz(u, "    movq    %%rax, _istisna_cerceve+32(%%rip)");
-    yardimci_yaz(u, "    movq    %%rbx, _istisna_cerceve+40(%%rip)");
-    yardimci_yaz(u, "    movq    $3, _istisna_cerceve+48(%%rip)");  /* DizinHatasi=3 */
-    yardimci_yaz(u, "    movq    _istisna_cerceve(%%rip), %%rbp");
-    yardimci_yaz(u, "    movq    _istisna_cerceve+8(%%rip), %%rsp");
-    yardimci_yaz(u, "    jmpq    *_istisna_cerceve+16(%%rip)");
-    /* Handler yok: stderr'e yaz ve çık */
-    yardimci_yaz(u, ".Ldizi_exit_%d:", idx);
-    yardimci_yaz(u, "    movq    $1, %%rax");
-    yardimci_yaz(u, "    movq    $2, %%rdi");           /* stderr */
-    yardimci_yaz(u, "    leaq    .LC%d(%%rip), %%rsi", idx);
-    yardimci_yaz(u, "    movq    $.LC%d_len, %%rdx", idx);
-    yardimci_yaz(u, "    syscall");
-    yardimci_yaz(u, "    movq    $60, %%rax");
-    yardimci_yaz(u, "    movq    $1, %%rdi");
-    yardimci_yaz(u, "    syscall");
+    hata_firlat_yaz(u, idx, 3);     /* DizinHatasi=3 */
 }
 
 static void hata_bellek_uret(Üretici *u) {
@@ -1209,7 +1666,7 @@ static void stdlib_cagri_uret(Üretici *u, Düğüm *d, const ModülFonksiyon *f
 
     /* 3. Fonksiyonu çağır */
     yaz(u, "    xorq    %%rax, %%rax");
-    yaz(u, "    call    %s", fn->runtime_isim);
+    yaz(u, "    call    %s", runtime_cagri_isim(u, d, fn->runtime_isim));
 
     /* 4. Return fixup: C TrDizi/TrMetin → {rax, rdx} → {rax, rbx} */
     if (fn->dönüş_tipi == TİP_DİZİ || fn->dönüş_tipi == TİP_METİN) {
@@ -1219,6 +1676,9 @@ static void stdlib_cagri_uret(Üretici *u, Düğüm *d, const ModülFonksiyon *f
 
 static void cagri_uret(Üretici *u, Düğüm *d) {
     if (!d->veri.tanimlayici.isim) return;
+    /* Kuyruk atlaması yalnızca bu çağrıya; argümanlardaki çağrılar normal */
+    int kuyruk = u->kuyruk_atla;
+    u->kuyruk_atla = 0;
 
     /* yazdır özel durumu */
     if (strcmp(d->veri.tanimlayici.isim, "yazdır") == 0) {
@@ -1548,13 +2008,9 @@ static void cagri_uret(Üretici *u, Düğüm *d) {
         ifade_üret(u, d->çocuklar[0]);
         yaz(u, "    pushq   %%rbx");  /* count */
         yaz(u, "    pushq   %%rax");  /* ptr */
-        /* arg1: fonksiyon adresi */
-        if (d->çocuklar[1]->tur == DÜĞÜM_TANIMLAYICI) {
-            yaz(u, "    leaq    %s(%%rip), %%rdx", d->çocuklar[1]->veri.tanimlayici.isim);
-        } else {
-            ifade_üret(u, d->çocuklar[1]);
-            yaz(u, "    movq    %%rax, %%rdx");
-        }
+        /* arg1: kapanış */
+        kapanis_deger_uret(u, d->çocuklar[1]);
+        yaz(u, "    movq    %%rax, %%rdx");
         yaz(u, "    popq    %%rdi");   /* ptr */
         yaz(u, "    popq    %%rsi");   /* count */
         yaz(u, "    call    _tr_esle");
@@ -1569,13 +2025,9 @@ static void cagri_uret(Üretici *u, Düğüm *d) {
         ifade_üret(u, d->çocuklar[0]);
         yaz(u, "    pushq   %%rbx");  /* count */
         yaz(u, "    pushq   %%rax");  /* ptr */
-        /* arg1: fonksiyon adresi */
-        if (d->çocuklar[1]->tur == DÜĞÜM_TANIMLAYICI) {
-            yaz(u, "    leaq    %s(%%rip), %%rdx", d->çocuklar[1]->veri.tanimlayici.isim);
-        } else {
-            ifade_üret(u, d->çocuklar[1]);
-            yaz(u, "    movq    %%rax, %%rdx");
-        }
+        /* arg1: kapanış */
+        kapanis_deger_uret(u, d->çocuklar[1]);
+        yaz(u, "    movq    %%rax, %%rdx");
         yaz(u, "    popq    %%rdi");   /* ptr */
         yaz(u, "    popq    %%rsi");   /* count */
         yaz(u, "    call    _tr_filtre");
@@ -1593,13 +2045,9 @@ static void cagri_uret(Üretici *u, Düğüm *d) {
         /* arg1: başlangıç deger */
         ifade_üret(u, d->çocuklar[1]);
         yaz(u, "    pushq   %%rax");  /* başlangıç */
-        /* arg2: fonksiyon adresi */
-        if (d->çocuklar[2]->tur == DÜĞÜM_TANIMLAYICI) {
-            yaz(u, "    leaq    %s(%%rip), %%rcx", d->çocuklar[2]->veri.tanimlayici.isim);
-        } else {
-            ifade_üret(u, d->çocuklar[2]);
-            yaz(u, "    movq    %%rax, %%rcx");
-        }
+        /* arg2: kapanış */
+        kapanis_deger_uret(u, d->çocuklar[2]);
+        yaz(u, "    movq    %%rax, %%rcx");
         yaz(u, "    popq    %%rdx");   /* başlangıç */
         yaz(u, "    popq    %%rdi");   /* ptr */
         yaz(u, "    popq    %%rsi");   /* count */
@@ -1613,13 +2061,9 @@ static void cagri_uret(Üretici *u, Düğüm *d) {
         ifade_üret(u, d->çocuklar[0]);
         yaz(u, "    pushq   %%rbx");  /* count */
         yaz(u, "    pushq   %%rax");  /* ptr */
-        /* arg1: fonksiyon adresi */
-        if (d->çocuklar[1]->tur == DÜĞÜM_TANIMLAYICI) {
-            yaz(u, "    leaq    %s(%%rip), %%rdx", d->çocuklar[1]->veri.tanimlayici.isim);
-        } else {
-            ifade_üret(u, d->çocuklar[1]);
-            yaz(u, "    movq    %%rax, %%rdx");
-        }
+        /* arg1: kapanış */
+        kapanis_deger_uret(u, d->çocuklar[1]);
+        yaz(u, "    movq    %%rax, %%rdx");
         yaz(u, "    popq    %%rdi");   /* ptr */
         yaz(u, "    popq    %%rsi");   /* count */
         yaz(u, "    call    _tr_her_biri");
@@ -1635,12 +2079,8 @@ static void cagri_uret(Üretici *u, Düğüm *d) {
 
     /* iş_oluştur(fonk_ptr: tam) -> tam */
     if (strcmp(d->veri.tanimlayici.isim, "i\xc5\x9f_olu\xc5\x9ftur") == 0) {
-        if (d->çocuklar[0]->tur == DÜĞÜM_TANIMLAYICI) {
-            yaz(u, "    leaq    %s(%%rip), %%rdi", d->çocuklar[0]->veri.tanimlayici.isim);
-        } else {
-            ifade_üret(u, d->çocuklar[0]);
-            yaz(u, "    movq    %%rax, %%rdi");
-        }
+        kapanis_deger_uret(u, d->çocuklar[0]);
+        yaz(u, "    movq    %%rax, %%rdi");
         yaz(u, "    call    _tr_is_olustur");
         return;
     }
@@ -1671,20 +2111,23 @@ static void cagri_uret(Üretici *u, Düğüm *d) {
         int arg_sayisi = d->çocuk_sayısı;
         for (int i = 0; i < arg_sayisi && i < sb->alan_sayisi; i++) {
             yaz(u, "    pushq   (%%rsp)");  /* nesne pointer'ını koru */
-            ifade_üret(u, d->çocuklar[i]);
+            dizi_deger_uret(u, d->çocuklar[i]);
             int offset = sb->alanlar[i].offset;
             TipTürü alan_tipi = sb->alanlar[i].tip;
+            char kelime[16];
+            snprintf(kelime, sizeof(kelime), "$%d", offset / 8);
+            int ref = referans_degeri_mi(d->çocuklar[i]->sonuç_tipi);
             if (alan_tipi == TİP_METİN || alan_tipi == TİP_DİZİ) {
                 /* metin/dizi: hem ptr hem len sakla */
                 yaz(u, "    movq    %%rax, %%rcx");  /* ptr */
                 yaz(u, "    movq    %%rbx, %%r8");   /* len */
                 yaz(u, "    popq    %%rax");          /* nesne pointer */
-                yaz(u, "    movq    %%rcx, %d(%%rax)", offset);      /* ptr */
                 yaz(u, "    movq    %%r8, %d(%%rax)", offset + 8);   /* len */
+                referans_yaz_uret(u, kelime, "%rcx", ref, 1);       /* ptr */
             } else {
                 yaz(u, "    movq    %%rax, %%rcx");  /* değer */
                 yaz(u, "    popq    %%rax");          /* nesne pointer */
-                yaz(u, "    movq    %%rcx, %d(%%rax)", offset);
+                referans_yaz_uret(u, kelime, "%rcx", ref, 1);
             }
         }
 
@@ -1902,8 +2345,8 @@ static void cagri_uret(Üretici *u, Düğüm *d) {
             /* Tüm argümanları stack'e at (ters sırada) */
             for (int i = d->çocuk_sayısı - 1; i >= 0; i--) {
                 ifade_üret(u, d->çocuklar[i]);
-                if (arg_tipleri[i] == TİP_METİN) {
-                    yaz(u, "    pushq   %%rbx");  /* length */
+                if (arg_tipleri[i] == TİP_METİN || arg_tipleri[i] == TİP_DİZİ) {
+                    yaz(u, "    pushq   %%rbx");  /* length/count */
                     yaz(u, "    pushq   %%rax");  /* pointer */
                 } else {
                     yaz(u, "    pushq   %%rax");
@@ -1913,7 +2356,7 @@ static void cagri_uret(Üretici *u, Düğüm *d) {
             const char *int_regs[] = {"rdi", "rsi", "rdx", "rcx", "r8", "r9"};
             int reg_idx = 0;
             for (int i = 0; i < d->çocuk_sayısı && reg_idx < 6; i++) {
-                if (arg_tipleri[i] == TİP_METİN && reg_idx + 1 < 6) {
+                if ((arg_tipleri[i] == TİP_METİN || arg_tipleri[i] == TİP_DİZİ) && reg_idx + 1 < 6) {
                     yaz(u, "    popq    %%%s", int_regs[reg_idx]);  /* pointer */
                     reg_idx++;
                     yaz(u, "    popq    %%%s", int_regs[reg_idx]);  /* length */
@@ -1965,6 +2408,13 @@ static void cagri_uret(Üretici *u, Düğüm *d) {
         }
     }
 
+    /* Yazmaçlara sığmayanlar çağrı boyunca yığında kalır; tek sayıda
+     * kelimeyse hiza için önce dolgu */
+    int yigin_konum[32];
+    int yigin_kelime = arguman_yerlesimi(arg_tipleri, arg_sayisi < 32 ? arg_sayisi : 32, yigin_konum);
+    int yigin_dolgu = yigin_kelime & 1;
+    if (yigin_dolgu) yaz(u, "    subq    $8, %%rsp");
+
     /* Tüm argümanları hesapla ve stack'e at (ters sırada) */
     for (int i = arg_sayisi - 1; i >= 0; i--) {
         if (i < verilen_arg) {
@@ -1989,44 +2439,49 @@ static void cagri_uret(Üretici *u, Düğüm *d) {
     /* Stack'ten doğru registerlara taşı */
     int int_reg_idx = 0;
     int xmm_reg_idx = 0;
-    for (int i = 0; i < arg_sayisi; i++) {
+    for (int i = 0; i < arg_sayisi && i < 32 && yigin_konum[i] < 0; i++) {
         if (arg_tipleri[i] == TİP_ONDALIK) {
-            if (xmm_reg_idx < 8) {
-                yaz(u, "    movsd   (%%rsp), %%xmm%d", xmm_reg_idx);
-                yaz(u, "    addq    $8, %%rsp");
-                xmm_reg_idx++;
-            }
+            yaz(u, "    movsd   (%%rsp), %%xmm%d", xmm_reg_idx);
+            yaz(u, "    addq    $8, %%rsp");
+            xmm_reg_idx++;
         } else if (arg_tipleri[i] == TİP_METİN || arg_tipleri[i] == TİP_DİZİ) {
-            if (int_reg_idx + 1 < 6) {
-                yaz(u, "    popq    %%%s", int_regs[int_reg_idx]);
-                int_reg_idx++;
-                yaz(u, "    popq    %%%s", int_regs[int_reg_idx]);
-                int_reg_idx++;
-            }
+            yaz(u, "    popq    %%%s", int_regs[int_reg_idx]);
+            int_reg_idx++;
+            yaz(u, "    popq    %%%s", int_regs[int_reg_idx]);
+            int_reg_idx++;
         } else {
-            if (int_reg_idx < 6) {
-                yaz(u, "    popq    %%%s", int_regs[int_reg_idx]);
-                int_reg_idx++;
-            }
+            yaz(u, "    popq    %%%s", int_regs[int_reg_idx]);
+            int_reg_idx++;
         }
     }
 
     yaz(u, "    xorq    %%rax, %%rax");  /* varargs için AL = 0 */
     /* Modül fonksiyonları için runtime ismini kullan */
     if (fn && fn->runtime_isim) {
-        yaz(u, "    call    %s", fn->runtime_isim);
+        yaz(u, "    call    %s", runtime_cagri_isim(u, d, fn->runtime_isim));
         /* C ABI fixup: TrMetin/TrDizi {rax,rdx} → {rax,rbx} dönüşümü */
         if (fn->dönüş_tipi == TİP_METİN || fn->dönüş_tipi == TİP_DİZİ) {
             yaz(u, "    movq    %%rdx, %%rbx");
         }
     } else if (fn && fn->tip == TİP_İŞLEV && !fn->runtime_isim) {
-        /* Dolaylı çağrı: fonksiyon pointer'ı değişkenden yükle */
-        int fn_off = (fn->yerel_indeks + 1) * 8;
-        yaz(u, "    movq    -%d(%%rbp), %%r11", fn_off);
-        yaz(u, "    call    *%%r11");
+        /* Dolaylı çağrı: kapanış r10'da (statik zincir) geçer, kod ilk
+         * kelimesindedir; argüman yazmaçlarına dokunmaz */
+        if (fn->global_mi)
+            yaz(u, "    movq    _genel_%s(%%rip), %%r10", fn->isim);
+        else
+            yaz(u, "    movq    %s, %%r10", yerel_yer(fn));
+        yaz(u, "    call    *(%%r10)");
+    } else if (kuyruk) {
+        yazmac_geri_yukle(u);
+        yaz(u, "    leave");
+        yaz(u, "    jmp     %s", d->veri.tanimlayici.isim);
+        u->kuyruk_atla = 2;
+        return;
     } else {
         yaz(u, "    call    %s", d->veri.tanimlayici.isim);
     }
+    if (yigin_kelime + yigin_dolgu > 0)
+        yaz(u, "    addq    $%d, %%rsp", (yigin_kelime + yigin_dolgu) * 8);
 }
 
 static void ifade_üret(Üretici *u, Düğüm *d) {
@@ -2072,13 +2527,13 @@ static void ifade_üret(Üretici *u, Düğüm *d) {
             /* Fonksiyon pointer olabilir mi kontrol et */
             Sembol *boru_s = sembol_ara(u->kapsam, d->çocuklar[1]->veri.tanimlayici.isim);
             if (boru_s && boru_s->tip == TİP_İŞLEV) {
-                /* Fonksiyon pointer: indirect call */
+                /* Kapanış: r10'da, kod ilk kelimesinde */
                 yaz(u, "    pushq   %%rdi");
                 tanimlayici_uret(u, d->çocuklar[1]);
-                yaz(u, "    movq    %%rax, %%r11");
+                yaz(u, "    movq    %%rax, %%r10");
                 yaz(u, "    popq    %%rdi");
                 yaz(u, "    xorq    %%rax, %%rax");
-                yaz(u, "    call    *%%r11");
+                yaz(u, "    call    *(%%r10)");
             } else {
                 yaz(u, "    call    %s", d->çocuklar[1]->veri.tanimlayici.isim);
             }
@@ -2092,8 +2547,9 @@ static void ifade_üret(Üretici *u, Düğüm *d) {
         int eleman_sayisi = d->çocuk_sayısı;
         int boyut = eleman_sayisi * 8;
 
-        /* _tr_nesne_olustur: bellek ayır */
-        yaz(u, "    movq    $%d, %%rdi", 1);        /* NESNE_TIP_DIZI */
+        /* _tr_nesne_olustur: bellek ayır (tip üst bitleri: kullanılan uzunluk + 1) */
+        yaz(u, "    movq    $%lld, %%rdi",
+            1LL | ((long long)(eleman_sayisi + 1) << 24));  /* NESNE_TIP_DIZI */
         yaz(u, "    movq    $%d, %%rsi", boyut > 0 ? boyut : 8);  /* boyut */
         yaz(u, "    call    _tr_nesne_olustur");
         hata_bellek_uret(u);
@@ -2172,7 +2628,7 @@ static void ifade_üret(Üretici *u, Düğüm *d) {
         Kapsam *onceki_kapsam = u->kapsam;
         u->kapsam = kapsam_oluştur(u->arena, onceki_kapsam);
         Sembol *elem = sembol_ekle(u->arena, u->kapsam, d->veri.dongu.isim, TİP_TAM);
-        elem->yerel_indeks = u->kapsam->yerel_sayac++;
+        elem->yerel_indeks = kapsam_yerel_ayir(u->kapsam, 1);
 
         yaz(u, ".L%d:", basla);
         /* index < count? */
@@ -2211,6 +2667,11 @@ static void ifade_üret(Üretici *u, Düğüm *d) {
         yaz(u, "    popq    %%rbx");   /* sonuç count */
         yaz(u, "    popq    %%rax");   /* sonuç ptr */
         yaz(u, "    addq    $16, %%rsp");  /* kaynak count + ptr temizle */
+        /* Header tip alanına kullanılan uzunluğu yaz: sonraki ekle() yerinde büyür */
+        yaz(u, "    leaq    1(%%rbx), %%rcx");
+        yaz(u, "    shlq    $24, %%rcx");
+        yaz(u, "    orq     $1, %%rcx");       /* NESNE_TIP_DIZI */
+        yaz(u, "    movq    %%rcx, -16(%%rax)");
 
         u->kapsam = onceki_kapsam;
         break;
@@ -2262,7 +2723,7 @@ static void ifade_üret(Üretici *u, Düğüm *d) {
         Kapsam *onceki_kapsam = u->kapsam;
         u->kapsam = kapsam_oluştur(u->arena, onceki_kapsam);
         Sembol *elem = sembol_ekle(u->arena, u->kapsam, d->veri.dongu.isim, TİP_TAM);
-        elem->yerel_indeks = u->kapsam->yerel_sayac++;
+        elem->yerel_indeks = kapsam_yerel_ayir(u->kapsam, 1);
 
         yaz(u, ".L%d:", basla);
         /* Stack: [kaynak_count(24)] [kaynak_ptr(16)] [sozluk_ptr(8)] [index(0)] */
@@ -2358,16 +2819,9 @@ static void ifade_üret(Üretici *u, Düğüm *d) {
         yaz(u, "    popq    %%rdx");          /* uzunluk */
         yaz(u, "    popq    %%rcx");          /* indeks */
 
-        /* Sınır kontrolü: 0 <= rcx < rdx */
-        hata_dizi_sinir_uret(u);
-        int lbl = yeni_etiket(u);
-        yaz(u, "    cmpq    $0, %%rcx");
-        yaz(u, "    jl      .Ldsn%d", lbl);
-        yaz(u, "    cmpq    %%rdx, %%rcx");
-        yaz(u, "    jl      .Ldok%d", lbl);
-        yaz(u, ".Ldsn%d:", lbl);
-        yaz(u, "    call    _hata_dizi_sinir");
-        yaz(u, ".Ldok%d:", lbl);
+        /* Sınır kontrolü: 0 <= rcx < rdx (döngü aralığıyla kanıtlanmadıysa) */
+        if (!dizi_erisim_guvenli(u, d->çocuklar[0], d->çocuklar[1]))
+            dizi_sinir_denetle(u, "%rcx", "%rdx");
 
         /* Elemanı yükle: *(rax + rcx*8) */
         yaz(u, "    movq    (%%rax, %%rcx, 8), %%rax");
@@ -2500,31 +2954,34 @@ static void ifade_üret(Üretici *u, Düğüm *d) {
         u->cikti = onceki;
 
         if (yak_sayisi > 0) {
-            /* Kapanış oluştur: ortam dizisi ayır */
+            /* Kapanış: [kod, yakalanan_sayisi, yakalanan...] */
             yaz(u, "    movq    $5, %%rdi");  /* NESNE_TIP_KAPANIS */
             yaz(u, "    movq    $%d, %%rsi", (yak_sayisi + 2) * 8);
             yaz(u, "    call    _tr_nesne_olustur");
-            yaz(u, "    pushq   %%rax");
-            /* [0] = fn_ptr */
             yaz(u, "    leaq    %s(%%rip), %%rcx", lambda_isim);
             yaz(u, "    movq    %%rcx, 0(%%rax)");
-            /* [1] = count */
             yaz(u, "    movq    $%d, 8(%%rax)", yak_sayisi);
-            /* [2..] = yakalanan değerler */
+            yaz(u, "    pushq   %%rax");
             for (int ci = 0; ci < yak_sayisi; ci++) {
-                int src_offset = (yak_indeksler[ci] + 1) * 8;
-                yaz(u, "    movq    -%d(%%rbp), %%rcx", src_offset);
+                Sembol *ys = sembol_ara(u->kapsam, yak_isimler[ci]);
+                if (ys && ys->tip == TİP_DİZİ) {
+                    /* Kapanış tamponu görür: dış değişkende yerinde büyütülmez */
+                    yaz(u, "    movq    %s, %%rdi", yerel_yer(ys));
+                    hizali_cagri(u, "_tr_dizi_ortakla");
+                }
+                if (ys) yaz(u, "    movq    %s, %%rcx", yerel_yer(ys));
+                else yaz(u, "    movq    -%d(%%rbp), %%rcx", (yak_indeksler[ci] + 1) * 8);
                 yaz(u, "    movq    (%%rsp), %%rax");
-                yaz(u, "    movq    %%rcx, %d(%%rax)", (ci + 2) * 8);
+                /* Nesne yakalamaları sayılır: toplayıcı kapanışı da gezer */
+                char yuva[16];
+                snprintf(yuva, sizeof(yuva), "$%d", ci + 2);
+                referans_yaz_uret(u, yuva, "%rcx", ys && referans_degeri_mi(ys->tip), 1);
             }
-            yaz(u, "    popq    %%rax");  /* kapanış ptr */
-            /* Ortam pointer'ını global'e kaydet */
-            yaz(u, "    movq    %%rax, _tr_kapanis_ortam(%%rip)");
-            /* Lambda adresini döndür (bare fn_ptr — uyumlu) */
-            yaz(u, "    movq    0(%%rax), %%rax");
+            yaz(u, "    popq    %%rax");
         } else {
-            /* Yakalama yok: sadece fonksiyon adresi */
-            yaz(u, "    leaq    %s(%%rip), %%rax", lambda_isim);
+            /* Yakalama yok: salt okunur kapanış */
+            statik_kapanis_uret(u, lambda_isim);
+            yaz(u, "    leaq    _tr_kp_%s(%%rip), %%rax", lambda_isim);
         }
         break;
     }
@@ -2646,10 +3103,9 @@ static void ifade_üret(Üretici *u, Düğüm *d) {
             if (!ws) {
                 ws = sembol_ekle(u->arena, u->kapsam, d->veri.tanimlayici.isim,
                                  d->sonuç_tipi);
-                ws->yerel_indeks = u->kapsam->yerel_sayac++;
+                ws->yerel_indeks = kapsam_yerel_ayir(u->kapsam, 1);
             }
-            int walrus_off = (ws->yerel_indeks + 1) * 8;
-            yaz(u, "    movq    %%rax, -%d(%%rbp)", walrus_off);
+            yaz(u, "    movq    %%rax, %s", yerel_yer(ws));
         }
         break;
     }
@@ -2708,6 +3164,7 @@ static void ifade_üret(Üretici *u, Düğüm *d) {
 
         /* Hata durumu: fonksiyondan dön (rax=tag, rbx=data olarak) */
         yaz(u, "    # ? operatörü: Hata/Hiç durumu - işlevden dön");
+        yazmac_geri_yukle(u);
         yaz(u, "    leave");
         yaz(u, "    ret");
 
@@ -2753,7 +3210,7 @@ static void degisken_uret(Üretici *u, Düğüm *d) {
         if (tip == TİP_SINIF) s->sınıf_adı = d->veri.değişken.tip;
 
         if (d->çocuk_sayısı > 0) {
-            ifade_üret(u, d->çocuklar[0]);
+            dizi_deger_uret(u, d->çocuklar[0]);
             if (tip == TİP_METİN || tip == TİP_DİZİ) {
                 yaz(u, "    movq    %%rax, _genel_%s(%%rip)", d->veri.değişken.isim);
                 yaz(u, "    movq    %%rbx, _genel_%s+8(%%rip)", d->veri.değişken.isim);
@@ -2781,10 +3238,10 @@ static void degisken_uret(Üretici *u, Düğüm *d) {
     if (tip == TİP_METİN || tip == TİP_DİZİ) {
         Sembol *s = sembol_ekle(u->arena, u->kapsam, d->veri.değişken.isim, tip);
         /* İkinci slot için sayacı bir artır */
-        u->kapsam->yerel_sayac++;
+        kapsam_yerel_ayir(u->kapsam, 1);
 
         if (d->çocuk_sayısı > 0) {
-            ifade_üret(u, d->çocuklar[0]);
+            dizi_deger_uret(u, d->çocuklar[0]);
             int offset = (s->yerel_indeks + 1) * 8;
             yaz(u, "    movq    %%rax, -%d(%%rbp)", offset);       /* pointer */
             yaz(u, "    movq    %%rbx, -%d(%%rbp)", offset + 8);   /* length/count */
@@ -2797,27 +3254,40 @@ static void degisken_uret(Üretici *u, Düğüm *d) {
             yaz(u, "    movsd   %%xmm0, -%d(%%rbp)", offset);
         }
     } else {
+        Sembol *onceki = sembol_ara(u->kapsam, d->veri.değişken.isim);
         Sembol *s = sembol_ekle(u->arena, u->kapsam, d->veri.değişken.isim, tip);
+        yazmac_ata(u, s, onceki);
         /* Lambda başlatıcı: tipi TİP_İŞLEV'e yükselt */
         if (d->çocuk_sayısı > 0 && d->çocuklar[0]->tur == DÜĞÜM_LAMBDA) {
             s->tip = TİP_İŞLEV;
             Düğüm *lambda = d->çocuklar[0];
-            if (lambda->çocuk_sayısı > 0)
-                s->param_sayisi = lambda->çocuklar[0]->çocuk_sayısı;
+            if (lambda->çocuk_sayısı > 0) {
+                /* Çağıran argümanları gövdenin beklediği yazmaçlara koysun */
+                Düğüm *params = lambda->çocuklar[0];
+                s->param_sayisi = params->çocuk_sayısı;
+                for (int i = 0; i < params->çocuk_sayısı && i < 32; i++)
+                    s->param_tipleri[i] = tip_adı_çevir(params->çocuklar[i]->veri.değişken.tip);
+            }
         }
         if (d->çocuk_sayısı > 0) {
             ifade_üret(u, d->çocuklar[0]);
-            int offset = (s->yerel_indeks + 1) * 8;
-            yaz(u, "    movq    %%rax, -%d(%%rbp)", offset);
+            yaz(u, "    movq    %%rax, %s", yerel_yer(s));
         }
     }
 }
 
 static void atama_uret(Üretici *u, Düğüm *d) {
     if (d->çocuk_sayısı > 0) {
-        ifade_üret(u, d->çocuklar[0]);
-
         Sembol *s = sembol_ara(u->kapsam, d->veri.tanimlayici.isim);
+        if (dizi_devralma_mi(u, d, s)) {
+            void *onceki = u->yerinde_cagri;
+            u->yerinde_cagri = d->çocuklar[0];
+            ifade_üret(u, d->çocuklar[0]);
+            u->yerinde_cagri = onceki;
+        } else {
+            dizi_deger_uret(u, d->çocuklar[0]);
+        }
+
         if (s) {
             if (s->global_mi) {
                 /* Global değişken ataması: RIP-relative */
@@ -2835,7 +3305,7 @@ static void atama_uret(Üretici *u, Düğüm *d) {
                     yaz(u, "    movq    %%rax, -%d(%%rbp)", offset);
                     yaz(u, "    movq    %%rbx, -%d(%%rbp)", offset + 8);
                 } else {
-                    yaz(u, "    movq    %%rax, -%d(%%rbp)", offset);
+                    yaz(u, "    movq    %%rax, %s", yerel_yer(s));
                 }
             }
         }
@@ -2883,85 +3353,770 @@ static void eger_uret(Üretici *u, Düğüm *d) {
     yaz(u, ".L%d:", son_etiket);
 }
 
-static void dongu_uret(Üretici *u, Düğüm *d) {
-    int başlangıç = yeni_etiket(u);
-    int bitis = yeni_etiket(u);
+/* Derleme zamanında bilinen tam sayı (literal veya eksi literal) */
+static int tam_sabit_mi(Düğüm *d, int64_t *deger) {
+    if (!d) return 0;
+    if (d->tur == DÜĞÜM_TAM_SAYI) {
+        *deger = d->veri.tam_deger;
+        return 1;
+    }
+    if (d->tur == DÜĞÜM_TEKLİ_İŞLEM && d->veri.islem.islem == TOK_EKSI &&
+        d->çocuk_sayısı == 1 && d->çocuklar[0]->tur == DÜĞÜM_TAM_SAYI) {
+        *deger = -d->çocuklar[0]->veri.tam_deger;
+        return 1;
+    }
+    return 0;
+}
 
-    int onceki_baslangic = u->dongu_baslangic_etiket;
-    int onceki_bitis = u->dongu_bitis_etiket;
-    u->dongu_baslangic_etiket = başlangıç;
-    u->dongu_bitis_etiket = bitis;
+static int imm32_mi(int64_t v) {
+    return v >= INT32_MIN && v <= INT32_MAX;
+}
 
-    /* Etiketli kır/devam için yığına it */
-    int onceki_derinlik = u->dongu_derinligi;
-    if (d->veri.dongu.isim && u->dongu_derinligi < URETICI_MAKS_DONGU) {
-        u->dongu_yigini[u->dongu_derinligi].isim = d->veri.dongu.isim;
-        u->dongu_yigini[u->dongu_derinligi].bitis_etiket = bitis;
-        u->dongu_yigini[u->dongu_derinligi].baslangic_etiket = başlangıç;
-        u->dongu_derinligi++;
+/* Sayaç sınırda mı (adım >= 0: sayac <= bitiş, değilse sayac >= bitiş):
+ * sınır "$N" veya yığındaki "(%rsp)"; bellekteki sayaç rax'a yüklenir */
+static void dongu_sinir_karsilastir(Üretici *u, Sembol *sayac, const char *sinir) {
+    if (sayac->yazmac > 0) {
+        yaz(u, "    cmpq    %s, %s", sinir, yerel_yer(sayac));
+    } else {
+        yaz(u, "    movq    %s, %%rax", yerel_yer(sayac));
+        yaz(u, "    cmpq    %s, %%rax", sinir);
     }
+}
 
-    /* Döngü değişkeni */
+/* ---- Sınır denetimi eleme ----
+ * döngü i = a, uzunluk(d) - k (adım ve a sabit) gövdesinde i atanmıyor ve d
+ * yalnızca eleman erişimi/ataması ya da uzunluk(d) olarak geçiyorsa, her
+ * turda a <= i <= uzunluk(d) - k'dir: d[i + c] için a + c >= 0 ve c < k
+ * olduğunda denetim gerekmez. Eksi adımda sınırların yeri değişir. */
+
+/* uzunluk(d) / d.uzunluk() çağrısının dizi tanımlayıcısı */
+static Düğüm *uzunluk_argumani(Düğüm *d) {
+    if (!d || d->tur != DÜĞÜM_ÇAĞRI || !d->veri.tanimlayici.isim ||
+        d->veri.tanimlayici.cagri_tip_parametre || d->çocuk_sayısı != 1 ||
+        strcmp(d->veri.tanimlayici.isim, "uzunluk") != 0) return NULL;
+    return d->çocuklar[0]->tur == DÜĞÜM_TANIMLAYICI ? d->çocuklar[0] : NULL;
+}
+
+/* Gövde sayacı atayabilir ya da dizinin uzunluğunu değiştirebilir mi */
+static int sinir_bozucu_var(Düğüm *d, const char *sayac, const char *dizi) {
+    if (!d) return 0;
+    const char *isim = NULL;
+    switch (d->tur) {
+    case DÜĞÜM_ATAMA:
+    case DÜĞÜM_WALRUS:
+        isim = d->veri.tanimlayici.isim;
+        if (isim && (strcmp(isim, sayac) == 0 || strcmp(isim, dizi) == 0)) return 1;
+        break;
+    case DÜĞÜM_DEĞİŞKEN:
+        isim = d->veri.değişken.isim;
+        if (isim && (strcmp(isim, sayac) == 0 || strcmp(isim, dizi) == 0)) return 1;
+        break;
+    case DÜĞÜM_DÖNGÜ:
+    case DÜĞÜM_HER_İÇİN:
+        isim = d->veri.dongu.isim;
+        if (isim && (strcmp(isim, sayac) == 0 || strcmp(isim, dizi) == 0)) return 1;
+        break;
+    case DÜĞÜM_TANIMLAYICI:
+        /* Dizinin başka her kullanımı (argüman, atama kaynağı) şüpheli */
+        return d->veri.tanimlayici.isim && strcmp(d->veri.tanimlayici.isim, dizi) == 0;
+    case DÜĞÜM_DİZİ_ERİŞİM:
+    case DÜĞÜM_DİZİ_ATAMA:
+        /* Eleman okuma/yazma uzunluğu değiştirmez */
+        for (int i = d->çocuklar[0]->tur == DÜĞÜM_TANIMLAYICI ? 1 : 0; i < d->çocuk_sayısı; i++) {
+            if (sinir_bozucu_var(d->çocuklar[i], sayac, dizi)) return 1;
+        }
+        return 0;
+    case DÜĞÜM_ÇAĞRI:
+        if (uzunluk_argumani(d)) return 0;
+        break;
+    case DÜĞÜM_PAKET_AÇ:
+    case DÜĞÜM_İLE_İSE:
+    case DÜĞÜM_LAMBDA:
+    case DÜĞÜM_İŞLEV:
+    case DÜĞÜM_ÜRET:
+    case DÜĞÜM_BEKLE:
+        return 1;
+    default:
+        break;
+    }
+    for (int i = 0; i < d->çocuk_sayısı; i++) {
+        if (sinir_bozucu_var(d->çocuklar[i], sayac, dizi)) return 1;
+    }
+    return 0;
+}
+
+/* Sabit adımlı döngünün sayaç aralığını kaydet; eklendiyse 1 */
+static int dongu_sinir_bilgisi_ekle(Üretici *u, Düğüm *d, Sembol *sayac,
+                                    int64_t adim, int govde_idx) {
+    if (u->sinir_sayisi >= URETICI_MAKS_DONGU || d->çocuk_sayısı <= govde_idx) return 0;
+    Düğüm *alt_d = adim >= 0 ? d->çocuklar[0] : d->çocuklar[1];
+    Düğüm *ust_d = adim >= 0 ? d->çocuklar[1] : d->çocuklar[0];
+    int64_t alt = 0, pay = 0;
+    if (!tam_sabit_mi(alt_d, &alt) || !imm32_mi(alt)) return 0;
+    if (ust_d->tur == DÜĞÜM_İKİLİ_İŞLEM && ust_d->veri.islem.islem == TOK_EKSI &&
+        ust_d->çocuk_sayısı == 2 && tam_sabit_mi(ust_d->çocuklar[1], &pay)) {
+        if (!imm32_mi(pay)) return 0;
+        ust_d = ust_d->çocuklar[0];
+    }
+    Düğüm *dizi_d = uzunluk_argumani(ust_d);
+    if (!dizi_d) return 0;
+    Sembol *ds = sembol_ara(u->kapsam, dizi_d->veri.tanimlayici.isim);
+    if (!ds || ds->tip != TİP_DİZİ || ds->global_mi) return 0;
+    if (sinir_bozucu_var(d->çocuklar[govde_idx], d->veri.dongu.isim, ds->isim)) return 0;
+
+    int n = u->sinir_sayisi++;
+    u->sinir_bilgileri[n].sayac = sayac;
+    u->sinir_bilgileri[n].dizi = ds;
+    u->sinir_bilgileri[n].alt = alt;
+    u->sinir_bilgileri[n].pay = pay;
+    return 1;
+}
+
+/* dizi[indeks] döngü aralığıyla kanıtlanmış mı (indeks: i, i + c, c + i, i - c) */
+static int dizi_erisim_guvenli(Üretici *u, Düğüm *dizi, Düğüm *indeks) {
+    if (u->sinir_sayisi == 0 || dizi->tur != DÜĞÜM_TANIMLAYICI) return 0;
+    int64_t c = 0;
+    if (indeks->tur == DÜĞÜM_İKİLİ_İŞLEM && indeks->çocuk_sayısı == 2) {
+        SözcükTürü op = indeks->veri.islem.islem;
+        if ((op == TOK_ARTI || op == TOK_EKSI) && tam_sabit_mi(indeks->çocuklar[1], &c)) {
+            if (op == TOK_EKSI) c = -c;
+            indeks = indeks->çocuklar[0];
+        } else if (op == TOK_ARTI && tam_sabit_mi(indeks->çocuklar[0], &c)) {
+            indeks = indeks->çocuklar[1];
+        } else {
+            return 0;
+        }
+        if (!imm32_mi(c)) return 0;
+    }
+    if (indeks->tur != DÜĞÜM_TANIMLAYICI) return 0;
+    Sembol *ds = sembol_ara(u->kapsam, dizi->veri.tanimlayici.isim);
+    Sembol *ss = sembol_ara(u->kapsam, indeks->veri.tanimlayici.isim);
+    for (int i = u->sinir_sayisi - 1; i >= 0; i--) {
+        if (u->sinir_bilgileri[i].dizi == ds && u->sinir_bilgileri[i].sayac == ss &&
+            u->sinir_bilgileri[i].alt + c >= 0 && c < u->sinir_bilgileri[i].pay)
+            return 1;
+    }
+    return 0;
+}
+
+/* 0 <= indeks < uzunluk: işaretsiz tek karşılaştırma (eksi indeks çok büyük olur) */
+static void dizi_sinir_denetle(Üretici *u, const char *indeks, const char *uzunluk) {
+    hata_dizi_sinir_uret(u);
+    int lbl = yeni_etiket(u);
+    yaz(u, "    cmpq    %s, %s", uzunluk, indeks);
+    yaz(u, "    jb      .Ldok%d", lbl);
+    yaz(u, "    call    _hata_dizi_sinir");
+    yaz(u, ".Ldok%d:", lbl);
+}
+
+/* ---- Vektörleştirme ----
+ * Adımı 1 olan döngü gövdesi yalnızca A[i] = ifade ve t = t op ifade
+ * (op: + - & | ^) deyimlerinden oluşuyorsa, gövde turları SSE2 (2 eleman)
+ * ya da AVX2 (4 eleman) ile işlenir; kalan turları skaler döngü yapar.
+ * İfadeler i ile indislenen dizi elemanları, gövdede değişmeyen tam
+ * değerler ve + - * & | ^, sabit << >>, tekli - ~ ile kurulur. Bütün
+ * erişimler aynı i indisinde olduğundan diziler birbirinin aynısı olsa da
+ * eleman sırası korunur. Tam sayılar taştığında sarar, skalerle aynı sonuç
+ * çıkar. Başlangıç ve bitiş bütün dizilerin sınırları içinde değilse
+ * vektör döngüsü atlanır, hatayı skaler döngü verir. */
+
+#define VEKTOR_MAKS_DIZI 6
+#define VEKTOR_MAKS_DEGISMEZ 8
+#define VEKTOR_MAKS_INDIRGEME 8
+
+static const char *vektor_taban[VEKTOR_MAKS_DIZI] = {"rsi", "rdi", "r8", "r9", "r10", "r11"};
+
+typedef struct {
+    Sembol *sayac;
+    Sembol *diziler[VEKTOR_MAKS_DIZI];
+    Düğüm  *dizi_dugumleri[VEKTOR_MAKS_DIZI];   /* taban yüklemesi için */
+    int     yazilan[VEKTOR_MAKS_DIZI];          /* gövdede elemanı atanıyor */
+    int     dizi_sayisi;
+    char    degismezler[VEKTOR_MAKS_DEGISMEZ][64];   /* movq kaynağı */
+    int     degismez_sayisi;
+    struct {
+        Sembol     *s;
+        char        yer[64];
+        SözcükTürü  op;
+        Düğüm      *ifade;
+    } indirgemeler[VEKTOR_MAKS_INDIRGEME];
+    int     indirgeme_sayisi;
+    int     avx;                  /* 1: ymm/VEX, 0: xmm/SSE2 */
+} VektorDongu;
+
+static int vektor_dizi_no(VektorDongu *v, Sembol *s, Düğüm *dizi) {
+    for (int i = 0; i < v->dizi_sayisi; i++) {
+        if (v->diziler[i] == s) return i;
+    }
+    if (v->dizi_sayisi >= VEKTOR_MAKS_DIZI) return -1;
+    v->diziler[v->dizi_sayisi] = s;
+    v->dizi_dugumleri[v->dizi_sayisi] = dizi;
+    return v->dizi_sayisi++;
+}
+
+static int vektor_degismez_no(VektorDongu *v, const char *kaynak) {
+    for (int i = 0; i < v->degismez_sayisi; i++) {
+        if (strcmp(v->degismezler[i], kaynak) == 0) return i;
+    }
+    if (v->degismez_sayisi >= VEKTOR_MAKS_DEGISMEZ) return -1;
+    snprintf(v->degismezler[v->degismez_sayisi], 64, "%s", kaynak);
+    return v->degismez_sayisi++;
+}
+
+/* Ayrılmış yazmaçlar: değişmezler 15'ten aşağı, ardından biriktiriciler */
+static int vektor_degismez_yazmaci(int no) { return 15 - no; }
+static int vektor_biriktirici(VektorDongu *v, int no) { return 15 - v->degismez_sayisi - no; }
+
+/* dizi[i] (i döngü sayacı) ise dizinin sembolü */
+static Sembol *vektor_eleman(Üretici *u, VektorDongu *v, Düğüm *dizi, Düğüm *indeks) {
+    if (dizi->tur != DÜĞÜM_TANIMLAYICI || indeks->tur != DÜĞÜM_TANIMLAYICI) return NULL;
+    if (sembol_ara(u->kapsam, indeks->veri.tanimlayici.isim) != v->sayac) return NULL;
+    Sembol *ds = sembol_ara(u->kapsam, dizi->veri.tanimlayici.isim);
+    return ds && ds->tip == TİP_DİZİ ? ds : NULL;
+}
+
+static int vektor_sabit_kaydirma(Düğüm *d, int64_t *n) {
+    return tam_sabit_mi(d, n) && *n >= 0 && *n < 64;
+}
+
+static int vektor_islem_uygun(SözcükTürü op) {
+    return op == TOK_ARTI || op == TOK_EKSI || op == TOK_ÇARPIM ||
+           op == TOK_BİT_VE || op == TOK_BİT_VEYA || op == TOK_BİT_XOR;
+}
+
+/* Gövdede değişmeyen tam değer ise movq kaynağını yaz */
+static int vektor_degismez_mi(Üretici *u, VektorDongu *v, Düğüm *d, char *buf, size_t boyut) {
+    int64_t c;
+    if (tam_sabit_mi(d, &c)) {
+        if (!imm32_mi(c)) return 0;
+        snprintf(buf, boyut, "$%lld", (long long)c);
+        return 1;
+    }
+    if (d->tur != DÜĞÜM_TANIMLAYICI) return 0;
+    Sembol *s = sembol_ara(u->kapsam, d->veri.tanimlayici.isim);
+    if (!s || s == v->sayac) return 0;
+    for (int i = 0; i < v->indirgeme_sayisi; i++) {
+        if (v->indirgemeler[i].s == s) return 0;
+    }
+    return basit_tam_operand(u, d, buf, boyut);
+}
+
+/* İfade vektörde hesaplanabilir mi; *gerek: hedeften itibaren geçici yazmaç sayısı */
+static int vektor_ifade_uygun(Üretici *u, VektorDongu *v, Düğüm *d, int *gerek) {
+    char kaynak[64];
+    int64_t n;
+    if (vektor_degismez_mi(u, v, d, kaynak, sizeof(kaynak))) {
+        *gerek = 0;
+        return vektor_degismez_no(v, kaynak) >= 0;
+    }
+    if (d->sonuç_tipi != TİP_TAM) return 0;
+    if (d->tur == DÜĞÜM_DİZİ_ERİŞİM && d->çocuk_sayısı == 2) {
+        Sembol *ds = vektor_eleman(u, v, d->çocuklar[0], d->çocuklar[1]);
+        *gerek = 1;
+        return ds && vektor_dizi_no(v, ds, d->çocuklar[0]) >= 0;
+    }
+    if (d->tur == DÜĞÜM_TEKLİ_İŞLEM && d->çocuk_sayısı == 1 &&
+        (d->veri.islem.islem == TOK_EKSI || d->veri.islem.islem == TOK_BİT_DEĞİL)) {
+        if (!vektor_ifade_uygun(u, v, d->çocuklar[0], gerek)) return 0;
+        if (*gerek < 2) *gerek = 2;
+        return 1;
+    }
+    if (d->tur != DÜĞÜM_İKİLİ_İŞLEM || d->çocuk_sayısı != 2) return 0;
+    SözcükTürü op = d->veri.islem.islem;
+    int sol = 0, sag = 0;
+    if ((op == TOK_SOL_KAYDIR || op == TOK_SAĞ_KAYDIR) &&
+        vektor_sabit_kaydirma(d->çocuklar[1], &n)) {
+        if (!vektor_ifade_uygun(u, v, d->çocuklar[0], &sol)) return 0;
+        *gerek = sol > 1 ? sol : 1;
+        return 1;
+    }
+    if (!vektor_islem_uygun(op)) return 0;
+    if (!vektor_ifade_uygun(u, v, d->çocuklar[0], &sol) ||
+        !vektor_ifade_uygun(u, v, d->çocuklar[1], &sag)) return 0;
+    *gerek = sol > sag + 1 ? sol : sag + 1;
+    if (op == TOK_ÇARPIM && *gerek < 4) *gerek = 4;
+    return 1;
+}
+
+/* Adı gövdede geçiyor mu */
+/* İfade bildirimi sarmalını aç */
+static Düğüm *vektor_deyim(Düğüm *b) {
+    if (b->tur == DÜĞÜM_İFADE_BİLDİRİMİ && b->çocuk_sayısı == 1) return b->çocuklar[0];
+    return b;
+}
+
+static int vektor_isim_geciyor(Düğüm *d, const char *isim) {
+    if (!d) return 0;
+    if (d->tur == DÜĞÜM_TANIMLAYICI && d->veri.tanimlayici.isim &&
+        strcmp(d->veri.tanimlayici.isim, isim) == 0) return 1;
+    for (int i = 0; i < d->çocuk_sayısı; i++) {
+        if (vektor_isim_geciyor(d->çocuklar[i], isim)) return 1;
+    }
+    return 0;
+}
+
+/* t = t op ifade (ya da değişmeli op için ifade op t) */
+static const char *vektor_indirgeme_ekle(Üretici *u, VektorDongu *v, Düğüm *deyim, Düğüm *govde) {
+    Sembol *s = sembol_ara(u->kapsam, deyim->veri.tanimlayici.isim);
+    if (!s || s->tip != TİP_TAM || s == v->sayac) return "atanan değişken tam değil";
+    Düğüm *d = deyim->çocuklar[0];
+    if (d->tur != DÜĞÜM_İKİLİ_İŞLEM || d->çocuk_sayısı != 2) return "atama indirgeme değil";
+    SözcükTürü op = d->veri.islem.islem;
+    if (op != TOK_ARTI && op != TOK_EKSI && op != TOK_BİT_VE &&
+        op != TOK_BİT_VEYA && op != TOK_BİT_XOR) return "indirgeme işlemi desteklenmiyor";
+    Düğüm *t = d->çocuklar[0], *ifade = d->çocuklar[1];
+    if (!(t->tur == DÜĞÜM_TANIMLAYICI && sembol_ara(u->kapsam, t->veri.tanimlayici.isim) == s)) {
+        if (op == TOK_EKSI) return "atama indirgeme değil";
+        t = d->çocuklar[1];
+        ifade = d->çocuklar[0];
+        if (!(t->tur == DÜĞÜM_TANIMLAYICI && sembol_ara(u->kapsam, t->veri.tanimlayici.isim) == s))
+            return "atama indirgeme değil";
+    }
+    /* Biriktirici başka hiçbir yerde okunmamalı */
+    for (int i = 0; i < govde->çocuk_sayısı; i++) {
+        Düğüm *b = vektor_deyim(govde->çocuklar[i]);
+        if (b == deyim) {
+            if (vektor_isim_geciyor(ifade, s->isim)) return "indirgeme değişkeni ifadede okunuyor";
+        } else if (vektor_isim_geciyor(b, s->isim) ||
+                   (b->tur == DÜĞÜM_ATAMA && strcmp(b->veri.tanimlayici.isim, s->isim) == 0)) {
+            return "indirgeme değişkeni başka deyimde kullanılıyor";
+        }
+    }
+    if (v->indirgeme_sayisi >= VEKTOR_MAKS_INDIRGEME) return "çok fazla indirgeme";
+    int n = v->indirgeme_sayisi++;
+    v->indirgemeler[n].s = s;
+    v->indirgemeler[n].op = op;
+    v->indirgemeler[n].ifade = ifade;
+    if (!basit_tam_operand(u, t, v->indirgemeler[n].yer, sizeof(v->indirgemeler[n].yer)))
+        return "atanan değişken tam değil";
+    return NULL;
+}
+
+/* Gövde vektörleştirilebiliyorsa NULL, değilse nedeni */
+static const char *vektor_engeli(Üretici *u, VektorDongu *v, Düğüm *govde) {
+    if (!govde || govde->tur != DÜĞÜM_BLOK || govde->çocuk_sayısı == 0) return "gövde boş";
+    /* İndirgemeler önce: değişmez sayılmamaları için */
+    for (int i = 0; i < govde->çocuk_sayısı; i++) {
+        Düğüm *b = vektor_deyim(govde->çocuklar[i]);
+        if (b->tur == DÜĞÜM_ATAMA && b->çocuk_sayısı == 1) {
+            const char *engel = vektor_indirgeme_ekle(u, v, b, govde);
+            if (engel) return engel;
+        } else if (b->tur != DÜĞÜM_DİZİ_ATAMA) {
+            return "gövdede eleman ataması ya da indirgeme dışında deyim var";
+        }
+    }
+    int en_cok = 0;
+    for (int i = 0; i < govde->çocuk_sayısı; i++) {
+        Düğüm *b = vektor_deyim(govde->çocuklar[i]);
+        Düğüm *ifade;
+        if (b->tur == DÜĞÜM_DİZİ_ATAMA) {
+            if (b->çocuk_sayısı != 3) return "eleman ataması biçimi";
+            Sembol *ds = vektor_eleman(u, v, b->çocuklar[0], b->çocuklar[1]);
+            if (!ds) return "atama indisi döngü sayacı değil";
+            int no = vektor_dizi_no(v, ds, b->çocuklar[0]);
+            if (no < 0) return "çok fazla dizi";
+            v->yazilan[no] = 1;
+            ifade = b->çocuklar[2];
+        } else {
+            int k;
+            for (k = 0; k < v->indirgeme_sayisi; k++) {
+                if (sembol_ara(u->kapsam, b->veri.tanimlayici.isim) == v->indirgemeler[k].s) break;
+            }
+            ifade = v->indirgemeler[k].ifade;
+        }
+        int gerek = 0;
+        if (!vektor_ifade_uygun(u, v, ifade, &gerek)) return "ifade vektörde hesaplanamıyor";
+        if (gerek > en_cok) en_cok = gerek;
+    }
+    if (en_cok + v->degismez_sayisi + v->indirgeme_sayisi > 16) return "vektör yazmacı yetmiyor";
+    return NULL;
+}
+
+static void vektor_rapor(Üretici *u, Düğüm *d, const char *engel) {
+    if (!u->vektor_rapor) return;
+    if (engel) {
+        fprintf(stderr, "not: %s:%d:%d: döngü vektörleştirilmedi: %s\n",
+                u->kaynak_dosya ? u->kaynak_dosya : "?", d->satir, d->sutun, engel);
+    } else {
+        fprintf(stderr, "not: %s:%d:%d: döngü vektörleştirildi (SSE2/AVX2)\n",
+                u->kaynak_dosya ? u->kaynak_dosya : "?", d->satir, d->sutun);
+    }
+}
+
+static const char *vektor_yazmac(VektorDongu *v, int r) {
+    static char tampon[4][16];
+    static int sira = 0;
+    char *b = tampon[sira++ & 3];
+    snprintf(b, 16, "%%%s%d", v->avx ? "ymm" : "xmm", r);
+    return b;
+}
+
+/* d = a op b; SSE2'de iki işlenenli biçim için önce a kopyalanır */
+static void vektor_islem(Üretici *u, VektorDongu *v, const char *komut, int a, int b, int d) {
+    if (v->avx) {
+        yaz(u, "    v%-7s %s, %s, %s", komut, vektor_yazmac(v, b), vektor_yazmac(v, a), vektor_yazmac(v, d));
+        return;
+    }
+    if (a != d) yaz(u, "    movdqa  %s, %s", vektor_yazmac(v, a), vektor_yazmac(v, d));
+    yaz(u, "    %-7s %s, %s", komut, vektor_yazmac(v, b), vektor_yazmac(v, d));
+}
+
+static void vektor_kaydir(Üretici *u, VektorDongu *v, const char *komut, int n, int a, int d) {
+    if (v->avx) {
+        yaz(u, "    v%-7s $%d, %s, %s", komut, n, vektor_yazmac(v, a), vektor_yazmac(v, d));
+        return;
+    }
+    if (a != d) yaz(u, "    movdqa  %s, %s", vektor_yazmac(v, a), vektor_yazmac(v, d));
+    yaz(u, "    %-7s $%d, %s", komut, n, vektor_yazmac(v, d));
+}
+
+static const char *vektor_komut(SözcükTürü op) {
+    switch (op) {
+    case TOK_ARTI:     return "paddq";
+    case TOK_EKSI:     return "psubq";
+    case TOK_BİT_VE:   return "pand";
+    case TOK_BİT_VEYA: return "por";
+    default:           return "pxor";
+    }
+}
+
+/* İfadeyi hedef yazmacında hesapla; değişmezse kendi yazmacını döndürür */
+static int vektor_ifade_uret(Üretici *u, VektorDongu *v, Düğüm *d, int hedef) {
+    char kaynak[64];
+    int64_t n;
+    if (vektor_degismez_mi(u, v, d, kaynak, sizeof(kaynak)))
+        return vektor_degismez_yazmaci(vektor_degismez_no(v, kaynak));
+    if (d->tur == DÜĞÜM_DİZİ_ERİŞİM) {
+        Sembol *ds = vektor_eleman(u, v, d->çocuklar[0], d->çocuklar[1]);
+        yaz(u, "    %s (%%%s, %%rcx, 8), %s", v->avx ? "vmovdqu" : "movdqu ",
+            vektor_taban[vektor_dizi_no(v, ds, d->çocuklar[0])], vektor_yazmac(v, hedef));
+        return hedef;
+    }
+    if (d->tur == DÜĞÜM_TEKLİ_İŞLEM) {
+        int a = vektor_ifade_uret(u, v, d->çocuklar[0], hedef);
+        if (d->veri.islem.islem == TOK_EKSI) {
+            /* 0 - a: a hedefte olabilir, fark önce hedef + 1'de */
+            vektor_islem(u, v, "pxor", hedef + 1, hedef + 1, hedef + 1);
+            vektor_islem(u, v, "psubq", hedef + 1, a, hedef + 1);
+            yaz(u, "    %s %s, %s", v->avx ? "vmovdqa" : "movdqa ",
+                vektor_yazmac(v, hedef + 1), vektor_yazmac(v, hedef));
+        } else {
+            vektor_islem(u, v, "pcmpeqd", hedef + 1, hedef + 1, hedef + 1);
+            vektor_islem(u, v, "pxor", a, hedef + 1, hedef);
+        }
+        return hedef;
+    }
+    SözcükTürü op = d->veri.islem.islem;
+    if ((op == TOK_SOL_KAYDIR || op == TOK_SAĞ_KAYDIR) &&
+        vektor_sabit_kaydirma(d->çocuklar[1], &n)) {
+        int a = vektor_ifade_uret(u, v, d->çocuklar[0], hedef);
+        vektor_kaydir(u, v, op == TOK_SOL_KAYDIR ? "psllq" : "psrlq", (int)n, a, hedef);
+        return hedef;
+    }
+    int a = vektor_ifade_uret(u, v, d->çocuklar[0], hedef);
+    int b = vektor_ifade_uret(u, v, d->çocuklar[1], hedef + 1);
+    if (op != TOK_ÇARPIM) {
+        vektor_islem(u, v, vektor_komut(op), a, b, hedef);
+        return hedef;
+    }
+    /* 64-bit çarpım (düşük yarı): lo(a)*lo(b) + ((hi(a)*lo(b) + lo(a)*hi(b)) << 32) */
+    int t1 = hedef + 2, t2 = hedef + 3;
+    vektor_kaydir(u, v, "psrlq", 32, a, t1);
+    vektor_islem(u, v, "pmuludq", t1, b, t1);
+    vektor_kaydir(u, v, "psrlq", 32, b, t2);
+    vektor_islem(u, v, "pmuludq", t2, a, t2);
+    vektor_islem(u, v, "paddq", t1, t2, t1);
+    vektor_kaydir(u, v, "psllq", 32, t1, t1);
+    vektor_islem(u, v, "pmuludq", a, b, hedef);
+    vektor_islem(u, v, "paddq", hedef, t1, hedef);
+    return hedef;
+}
+
+/* _tr_simd_duzeyi: 0 bilinmiyor, 1 SSE2, 2 AVX2 (işletim sistemi ymm durumunu saklıyorsa).
+ * rax, rcx, rdx dışındaki yazmaçları korur. */
+static void simd_belirle_uret(Üretici *u) {
+    if (u->simd_belirle_uretildi) return;
+    u->simd_belirle_uretildi = 1;
+    bss_yaz(u, "    .comm   _tr_simd_duzeyi, 4, 4");
+    yardimci_yaz(u, "");
+    yardimci_yaz(u, "# SIMD düzeyi: cpuid ile bir kez belirlenir");
+    yardimci_yaz(u, "_tr_simd_belirle:");
+    yardimci_yaz(u, "    pushq   %%rbx");
+    yardimci_yaz(u, "    movl    $1, _tr_simd_duzeyi(%%rip)");
+    yardimci_yaz(u, "    xorl    %%eax, %%eax");
+    yardimci_yaz(u, "    cpuid");
+    yardimci_yaz(u, "    cmpl    $7, %%eax");
+    yardimci_yaz(u, "    jb      .Lsimd_son");
+    yardimci_yaz(u, "    movl    $1, %%eax");
+    yardimci_yaz(u, "    cpuid");
+    yardimci_yaz(u, "    andl    $0x18000000, %%ecx");     /* OSXSAVE | AVX */
+    yardimci_yaz(u, "    cmpl    $0x18000000, %%ecx");
+    yardimci_yaz(u, "    jne     .Lsimd_son");
+    yardimci_yaz(u, "    xorl    %%ecx, %%ecx");
+    yardimci_yaz(u, "    xgetbv");
+    yardimci_yaz(u, "    andl    $6, %%eax");              /* XMM | YMM durumu */
+    yardimci_yaz(u, "    cmpl    $6, %%eax");
+    yardimci_yaz(u, "    jne     .Lsimd_son");
+    yardimci_yaz(u, "    movl    $7, %%eax");
+    yardimci_yaz(u, "    xorl    %%ecx, %%ecx");
+    yardimci_yaz(u, "    cpuid");
+    yardimci_yaz(u, "    testl   $0x20, %%ebx");           /* AVX2 */
+    yardimci_yaz(u, "    jz      .Lsimd_son");
+    yardimci_yaz(u, "    movl    $2, _tr_simd_duzeyi(%%rip)");
+    yardimci_yaz(u, ".Lsimd_son:");
+    yardimci_yaz(u, "    popq    %%rbx");
+    yardimci_yaz(u, "    ret");
+}
+
+/* Tek genişlik için vektör döngüsü; taban yazmaçları yüklü, sayaç bellekte */
+static void vektor_dongu_yaz(Üretici *u, VektorDongu *v, Düğüm *govde, const char *sinir, int skalar) {
+    int genislik = v->avx ? 4 : 2;
+    int dongu = yeni_etiket(u);
+    yaz(u, "    movq    %s, %%rcx", yerel_yer(v->sayac));
+    yaz(u, "    movq    %s, %%rdx", sinir);
+    yaz(u, "    subq    $%d, %%rdx", genislik - 1);
+    yaz(u, "    cmpq    %%rdx, %%rcx");
+    yaz(u, "    jg      .L%d", skalar);
+
+    for (int i = 0; i < v->degismez_sayisi; i++) {
+        int r = vektor_degismez_yazmaci(i);
+        yaz(u, "    movq    %s, %%rax", v->degismezler[i]);
+        if (v->avx) {
+            yaz(u, "    vmovq   %%rax, %%xmm%d", r);
+            yaz(u, "    vpbroadcastq %%xmm%d, %%ymm%d", r, r);
+        } else {
+            yaz(u, "    movq    %%rax, %%xmm%d", r);
+            yaz(u, "    punpcklqdq %%xmm%d, %%xmm%d", r, r);
+        }
+    }
+    for (int i = 0; i < v->indirgeme_sayisi; i++) {
+        int r = vektor_biriktirici(v, i);
+        vektor_islem(u, v, v->indirgemeler[i].op == TOK_BİT_VE ? "pcmpeqd" : "pxor", r, r, r);
+    }
+
+    yaz(u, ".L%d:", dongu);
+    for (int i = 0; i < govde->çocuk_sayısı; i++) {
+        Düğüm *b = vektor_deyim(govde->çocuklar[i]);
+        if (b->tur == DÜĞÜM_DİZİ_ATAMA) {
+            Sembol *ds = vektor_eleman(u, v, b->çocuklar[0], b->çocuklar[1]);
+            int r = vektor_ifade_uret(u, v, b->çocuklar[2], 0);
+            yaz(u, "    %s %s, (%%%s, %%rcx, 8)", v->avx ? "vmovdqu" : "movdqu ",
+                vektor_yazmac(v, r), vektor_taban[vektor_dizi_no(v, ds, b->çocuklar[0])]);
+        } else {
+            Sembol *s = sembol_ara(u->kapsam, b->veri.tanimlayici.isim);
+            for (int k = 0; k < v->indirgeme_sayisi; k++) {
+                if (v->indirgemeler[k].s != s) continue;
+                int r = vektor_ifade_uret(u, v, v->indirgemeler[k].ifade, 0);
+                int acc = vektor_biriktirici(v, k);
+                vektor_islem(u, v, vektor_komut(v->indirgemeler[k].op), acc, r, acc);
+            }
+        }
+    }
+    yaz(u, "    addq    $%d, %%rcx", genislik);
+    yaz(u, "    cmpq    %%rdx, %%rcx");
+    yaz(u, "    jle     .L%d", dongu);
+    yaz(u, "    movq    %%rcx, %s", yerel_yer(v->sayac));
+
+    /* Biriktiricileri şeritler boyunca topla, değişkene kat (fark: şeritler eksi birikir) */
+    for (int i = 0; i < v->indirgeme_sayisi; i++) {
+        int r = vektor_biriktirici(v, i);
+        SözcükTürü op = v->indirgemeler[i].op;
+        const char *komut = vektor_komut(op == TOK_EKSI ? TOK_ARTI : op);
+        if (v->avx) {
+            yaz(u, "    vextracti128 $1, %%ymm%d, %%xmm0", r);
+            yaz(u, "    v%-7s %%xmm0, %%xmm%d, %%xmm%d", komut, r, r);
+            yaz(u, "    vpshufd $0x4e, %%xmm%d, %%xmm0", r);
+            yaz(u, "    v%-7s %%xmm0, %%xmm%d, %%xmm%d", komut, r, r);
+            yaz(u, "    vmovq   %%xmm%d, %%rax", r);
+        } else {
+            yaz(u, "    pshufd  $0x4e, %%xmm%d, %%xmm0", r);
+            yaz(u, "    %-7s %%xmm0, %%xmm%d", komut, r);
+            yaz(u, "    movq    %%xmm%d, %%rax", r);
+        }
+        const char *skaler = op == TOK_BİT_VE ? "andq" : op == TOK_BİT_VEYA ? "orq" :
+                             op == TOK_BİT_XOR ? "xorq" : "addq";
+        yaz(u, "    %-7s %%rax, %s", skaler, v->indirgemeler[i].yer);
+    }
+    if (v->avx) yaz(u, "    vzeroupper");
+}
+
+/* Skaler döngüden önce vektör döngüsünü yaz; yazıldıysa 1 (giriş sınaması atlanamaz) */
+static int vektor_dongu_uret(Üretici *u, Düğüm *d, Sembol *sayac, int64_t adim,
+                             int govde_idx, const char *sinir) {
+    if (adim != 1 || d->çocuk_sayısı <= govde_idx) return 0;
+    VektorDongu v;
+    memset(&v, 0, sizeof(v));
+    v.sayac = sayac;
+    const char *engel = vektor_engeli(u, &v, d->çocuklar[govde_idx]);
+    vektor_rapor(u, d, engel);
+    if (engel) return 0;
+
+    Düğüm *govde = d->çocuklar[govde_idx];
+    int skalar = yeni_etiket(u);
+    int sse = yeni_etiket(u);
+    simd_belirle_uret(u);
+
+    /* Başlangıç ve bitiş her dizinin sınırı içinde mi (işaretsiz) */
+    for (int i = 0; i < v.dizi_sayisi; i++) {
+        ifade_üret(u, v.dizi_dugumleri[i]);   /* rax = elemanlar, rbx = sayı */
+        yaz(u, "    cmpq    %%rbx, %s", yerel_yer(sayac));
+        yaz(u, "    jae     .L%d", skalar);
+        yaz(u, "    cmpq    %s, %%rbx", sinir);
+        yaz(u, "    jbe     .L%d", skalar);
+        if (v.yazilan[i]) {
+            /* Referans haritalı dizide yazımlar _tr_ref_yaz'dan geçmeli */
+            yaz(u, "    testq   $0x1000, -16(%%rax)");   /* tip: NESNE_BAYRAK_REFLI */
+            yaz(u, "    jnz     .L%d", skalar);
+        }
+        yaz(u, "    movq    %%rax, %%%s", vektor_taban[i]);
+    }
+    int hazir = yeni_etiket(u);
+    yaz(u, "    cmpl    $0, _tr_simd_duzeyi(%%rip)");
+    yaz(u, "    jne     .L%d", hazir);
+    yaz(u, "    call    _tr_simd_belirle");
+    yaz(u, ".L%d:", hazir);
+    yaz(u, "    cmpl    $2, _tr_simd_duzeyi(%%rip)");
+    yaz(u, "    jne     .L%d", sse);
+    v.avx = 1;
+    vektor_dongu_yaz(u, &v, govde, sinir, skalar);
+    yaz(u, "    jmp     .L%d", skalar);
+    yaz(u, ".L%d:", sse);
+    v.avx = 0;
+    vektor_dongu_yaz(u, &v, govde, sinir, skalar);
+    yaz(u, ".L%d:", skalar);
+    return 1;
+}
+
+static void dongu_uret(Üretici *u, Düğüm *d) {
+    int başlangıç = yeni_etiket(u);
+    int artir = yeni_etiket(u);
+    int bitis = yeni_etiket(u);
+
+    /* devam artırmaya gider */
+    int onceki_baslangic = u->dongu_baslangic_etiket;
+    int onceki_bitis = u->dongu_bitis_etiket;
+    int onceki_temizlik = u->her_icin_temizlik;
+    u->dongu_baslangic_etiket = artir;
+    u->dongu_bitis_etiket = bitis;
+    u->her_icin_temizlik = 0;
+
+    /* Etiketli kır/devam için yığına it */
+    int onceki_derinlik = u->dongu_derinligi;
+    if (d->veri.dongu.isim && u->dongu_derinligi < URETICI_MAKS_DONGU) {
+        u->dongu_yigini[u->dongu_derinligi].isim = d->veri.dongu.isim;
+        u->dongu_yigini[u->dongu_derinligi].bitis_etiket = bitis;
+        u->dongu_yigini[u->dongu_derinligi].baslangic_etiket = artir;
+        u->dongu_derinligi++;
+    }
+
+    /* Döngü değişkeni */
     Kapsam *onceki_kapsam = u->kapsam;
+    Sembol *dis_sayac = sembol_ara(onceki_kapsam, d->veri.dongu.isim);
     u->kapsam = kapsam_oluştur(u->arena, onceki_kapsam);
     Sembol *sayac = sembol_ekle(u->arena, u->kapsam, d->veri.dongu.isim, TİP_TAM);
     sayac->global_mi = 0;
+    yazmac_ata(u, sayac, dis_sayac);
 
     /* Adım değeri varsa: 4 çocuk (başlangıç, bitiş, adım, gövde)
      * Yoksa: 3 çocuk (başlangıç, bitiş, gövde) */
     int adim_var = (d->çocuk_sayısı > 3);
     int govde_idx = adim_var ? 3 : 2;
+    int64_t adim = 1;
+    int adim_sabit = (!adim_var || tam_sabit_mi(d->çocuklar[2], &adim)) && imm32_mi(adim);
 
     /* Başlangıç değeri */
     ifade_üret(u, d->çocuklar[0]);
-    int sayac_offset = (sayac->yerel_indeks + 1) * 8;
-    yaz(u, "    movq    %%rax, -%d(%%rbp)", sayac_offset);
+    yaz(u, "    movq    %%rax, %s", yerel_yer(sayac));
+
+    if (adim_sabit) {
+        /* Sabit adım: yön derlemede belli, döngü alttan sınanır.
+         * Bitiş bir kez hesaplanır; sabitse doğrudan komutta kalır. */
+        int64_t son = 0, bas = 0;
+        int son_sabit = tam_sabit_mi(d->çocuklar[1], &son) && imm32_mi(son);
+        char sinir[32];
+        if (son_sabit) {
+            snprintf(sinir, sizeof(sinir), "$%lld", (long long)son);
+        } else {
+            ifade_üret(u, d->çocuklar[1]);
+            yaz(u, "    subq    $16, %%rsp");  /* hizalı tut */
+            yaz(u, "    movq    %%rax, (%%rsp)");
+            snprintf(sinir, sizeof(sinir), "(%%rsp)");
+        }
+        const char *cik = adim >= 0 ? "jg" : "jl";
+        const char *don = adim >= 0 ? "jle" : "jge";
 
-    /* Bitiş değerini hesapla ve sakla */
-    ifade_üret(u, d->çocuklar[1]);
-    yaz(u, "    pushq   %%rax");  /* bitiş değeri stack'te */
+        /* Vektör döngüsü ilerlettiyse kalan turlar için giriş sınaması gerekir */
+        int vektor = vektor_dongu_uret(u, d, sayac, adim, govde_idx, sinir);
 
-    /* Adım değerini hesapla ve sakla */
-    if (adim_var) {
-        ifade_üret(u, d->çocuklar[2]);
+        /* Giriş sınaması: sabit aralık en az bir tur dönüyorsa gerekmez */
+        if (vektor || !(son_sabit && tam_sabit_mi(d->çocuklar[0], &bas) &&
+              (adim >= 0 ? bas <= son : bas >= son))) {
+            dongu_sinir_karsilastir(u, sayac, sinir);
+            yaz(u, "    %-7s .L%d", cik, bitis);
+        }
+
+        yaz(u, ".L%d:", başlangıç);
+        int sinir_eklendi = dongu_sinir_bilgisi_ekle(u, d, sayac, adim, govde_idx);
+        if (d->çocuk_sayısı > govde_idx) blok_uret(u, d->çocuklar[govde_idx]);
+        if (sinir_eklendi) u->sinir_sayisi--;
+
+        yaz(u, ".L%d:", artir);
+        if (sayac->yazmac > 0) {
+            yaz(u, "    addq    $%lld, %s", (long long)adim, yerel_yer(sayac));
+            yaz(u, "    cmpq    %s, %s", sinir, yerel_yer(sayac));
+        } else {
+            yaz(u, "    movq    %s, %%rax", yerel_yer(sayac));
+            yaz(u, "    addq    $%lld, %%rax", (long long)adim);
+            yaz(u, "    movq    %%rax, %s", yerel_yer(sayac));
+            yaz(u, "    cmpq    %s, %%rax", sinir);
+        }
+        yaz(u, "    %-7s .L%d", don, başlangıç);
+
+        yaz(u, ".L%d:", bitis);
+        if (!son_sabit) yaz(u, "    addq    $16, %%rsp");
     } else {
-        yaz(u, "    movq    $1, %%rax");
-    }
-    yaz(u, "    pushq   %%rax");  /* adım değeri stack'te */
+        /* Çalışma zamanı adımı: yön her turda adımın işaretine göre seçilir */
+        ifade_üret(u, d->çocuklar[1]);
+        yaz(u, "    pushq   %%rax");  /* bitiş değeri stack'te */
+        ifade_üret(u, d->çocuklar[2]);
+        yaz(u, "    pushq   %%rax");  /* adım değeri stack'te */
 
-    yaz(u, ".L%d:", başlangıç);
-    /* Sayacı yükle ve karşılaştır */
-    yaz(u, "    movq    -%d(%%rbp), %%rax", sayac_offset);
-    /* Adım pozitif mi kontrol et */
-    yaz(u, "    cmpq    $0, (%%rsp)");
-    int ileri_etiketi = yeni_etiket(u);
-    yaz(u, "    jge     .L%d", ileri_etiketi);
-    /* Negatif adım: sayac >= bitis mi? */
-    yaz(u, "    cmpq    8(%%rsp), %%rax");
-    yaz(u, "    jl      .L%d", bitis);
-    int govde_etiketi = yeni_etiket(u);
-    yaz(u, "    jmp     .L%d", govde_etiketi);
-    /* Pozitif adım: sayac <= bitis mi? */
-    yaz(u, ".L%d:", ileri_etiketi);
-    yaz(u, "    cmpq    8(%%rsp), %%rax");
-    yaz(u, "    jg      .L%d", bitis);
-    yaz(u, ".L%d:", govde_etiketi);
-
-    /* Gövde */
-    if (d->çocuk_sayısı > govde_idx) blok_uret(u, d->çocuklar[govde_idx]);
-
-    /* Sayacı adım kadar artır */
-    yaz(u, "    movq    (%%rsp), %%rax");
-    yaz(u, "    addq    %%rax, -%d(%%rbp)", sayac_offset);
-    yaz(u, "    jmp     .L%d", başlangıç);
+        yaz(u, ".L%d:", başlangıç);
+        /* Sayacı yükle ve karşılaştır */
+        yaz(u, "    movq    %s, %%rax", yerel_yer(sayac));
+        /* Adım pozitif mi kontrol et */
+        yaz(u, "    cmpq    $0, (%%rsp)");
+        int ileri_etiketi = yeni_etiket(u);
+        yaz(u, "    jge     .L%d", ileri_etiketi);
+        /* Negatif adım: sayac >= bitis mi? */
+        yaz(u, "    cmpq    8(%%rsp), %%rax");
+        yaz(u, "    jl      .L%d", bitis);
+        int govde_etiketi = yeni_etiket(u);
+        yaz(u, "    jmp     .L%d", govde_etiketi);
+        /* Pozitif adım: sayac <= bitis mi? */
+        yaz(u, ".L%d:", ileri_etiketi);
+        yaz(u, "    cmpq    8(%%rsp), %%rax");
+        yaz(u, "    jg      .L%d", bitis);
+        yaz(u, ".L%d:", govde_etiketi);
 
-    yaz(u, ".L%d:", bitis);
-    yaz(u, "    addq    $16, %%rsp");  /* bitiş + adım değerlerini temizle */
+        /* Gövde */
+        if (d->çocuk_sayısı > govde_idx) blok_uret(u, d->çocuklar[govde_idx]);
+
+        /* Sayacı adım kadar artır */
+        yaz(u, ".L%d:", artir);
+        yaz(u, "    movq    (%%rsp), %%rax");
+        yaz(u, "    addq    %%rax, %s", yerel_yer(sayac));
+        yaz(u, "    jmp     .L%d", başlangıç);
+
+        yaz(u, ".L%d:", bitis);
+        yaz(u, "    addq    $16, %%rsp");  /* bitiş + adım değerlerini temizle */
+    }
 
     u->kapsam = onceki_kapsam;
     u->dongu_derinligi = onceki_derinlik;
     u->dongu_baslangic_etiket = onceki_baslangic;
     u->dongu_bitis_etiket = onceki_bitis;
+    u->her_icin_temizlik = onceki_temizlik;
 }
 
 static void iken_uret(Üretici *u, Düğüm *d) {
@@ -3001,13 +4156,124 @@ static void iken_uret(Üretici *u, Düğüm *d) {
     u->dongu_yoksa_etiket = onceki_yoksa;
 }
 
+/* Öz kuyruk çağrısında parametre yerine doğrudan yazılabilir tipler
+ * (dizi argümanı çağrıda iki yazmaç, prologda bir slot alır: atlamaya kalır) */
+static int kuyruk_param_uygun(TipTürü t) {
+    return t == TİP_TAM || t == TİP_MANTIK || t == TİP_ONDALIK ||
+           t == TİP_METİN || t == TİP_SINIF;
+}
+
+/* döndür f(...) kuyruk çağrısı olarak üretildiyse 1 */
+static int kuyruk_cagri_uret(Üretici *u, Düğüm *cagri) {
+    int oz;
+    const char *engel = kuyruk_cagri_engeli(u->kuyruk.islev, cagri, &oz);
+    Sembol *fn = NULL;
+    if (!engel && u->dene.derinlik > 0) engel = "dene bloğu içinde";
+    if (!engel && u->profil_modu) engel = "profil modu";
+    if (!engel) {
+        fn = sembol_ara(u->kapsam, cagri->veri.tanimlayici.isim);
+        if (!fn || !fn->islev_mi || fn->runtime_isim) engel = "kullanıcı işlevi değil";
+        else if (fn->tip == TİP_İŞLEV) engel = "dolaylı çağrı";
+    }
+    Düğüm *params = NULL;
+    int n = 0;
+    if (!engel) {
+        params = u->kuyruk.islev->çocuklar[0];
+        n = params->çocuk_sayısı;
+        if (oz && cagri->çocuk_sayısı == n) {
+            for (int i = 0; i < n && oz; i++) {
+                oz = kuyruk_param_uygun(fn->param_tipleri[i]);
+            }
+        } else {
+            oz = 0;
+        }
+    }
+    if (!engel && !oz) {
+        /* Başka işleve atlarken yığın argümanları bırakılan çerçeveyle
+         * gider: hepsi yazmaçta olmalı (öz çağrı gelen yuvalara yazar) */
+        int m = cagri->çocuk_sayısı > fn->param_sayisi ? cagri->çocuk_sayısı : fn->param_sayisi;
+        TipTürü tipler[32];
+        int yigin[32];
+        if (m > 32) m = 32;
+        for (int i = 0; i < m; i++) {
+            tipler[i] = i < fn->param_sayisi ? fn->param_tipleri[i] : (TipTürü)cagri->çocuklar[i]->sonuç_tipi;
+        }
+        if (arguman_yerlesimi(tipler, m, yigin) > 0) engel = "argümanlar yazmaçlara sığmıyor";
+    }
+    if (engel) {
+        kuyruk_rapor(u, cagri, engel);
+        return 0;
+    }
+
+    if (!oz) {
+        /* Çerçeveyi bırak, argümanlar yazmaçtayken hedefe atla */
+        u->kuyruk_atla = 1;
+        cagri_uret(u, cagri);
+        if (u->kuyruk_atla != 2) {
+            /* Yerleşik adla gölgelenen işlev: çağrı yapıldı, normal dönüş */
+            kuyruk_rapor(u, cagri, "yerleşik işlev adı");
+            yazmac_geri_yukle(u);
+            yaz(u, "    leave");
+            yaz(u, "    ret");
+        }
+        u->kuyruk_atla = 0;
+        return 1;
+    }
+
+    /* Öz çağrı: tüm argümanlar hesaplanmadan parametreye yazılmaz */
+    for (int i = n - 1; i >= 0; i--) {
+        ifade_üret(u, cagri->çocuklar[i]);
+        TipTürü t = fn->param_tipleri[i];
+        if (t == TİP_ONDALIK) {
+            yaz(u, "    subq    $8, %%rsp");
+            yaz(u, "    movsd   %%xmm0, (%%rsp)");
+        } else if (t == TİP_METİN) {
+            yaz(u, "    pushq   %%rbx");
+            yaz(u, "    pushq   %%rax");
+        } else {
+            yaz(u, "    pushq   %%rax");
+        }
+    }
+    int yigin[32];
+    arguman_yerlesimi(fn->param_tipleri, n < 32 ? n : 32, yigin);
+    for (int i = 0; i < n; i++) {
+        Sembol *s = sembol_ara_sinirli(u->kuyruk.kapsam, u->kuyruk.kapsam,
+                                       params->çocuklar[i]->veri.değişken.isim);
+        int offset = (s->yerel_indeks + 1) * 8;
+        TipTürü t = fn->param_tipleri[i];
+        if (i < 32 && yigin[i] >= 0) {
+            /* Yığın argümanı: çağıranın yuvasına yerinde yaz, prolog
+             * gövde etiketinden sonra yeniden kopyalar */
+            int gelen = 16 + yigin[i] * 8;
+            yaz(u, "    popq    %d(%%rbp)", gelen);
+            if (t == TİP_METİN) yaz(u, "    popq    %d(%%rbp)", gelen + 8);
+        } else if (t == TİP_ONDALIK) {
+            yaz(u, "    movsd   (%%rsp), %%xmm0");
+            yaz(u, "    addq    $8, %%rsp");
+            yaz(u, "    movsd   %%xmm0, -%d(%%rbp)", offset);
+        } else if (t == TİP_METİN) {
+            yaz(u, "    popq    %%rax");
+            yaz(u, "    movq    %%rax, -%d(%%rbp)", offset);
+            yaz(u, "    popq    %%rax");
+            yaz(u, "    movq    %%rax, -%d(%%rbp)", offset + 8);
+        } else {
+            yaz(u, "    popq    %%rax");
+            yaz(u, "    movq    %%rax, %s", yerel_yer(s));
+        }
+    }
+    /* Döngü/her...için geçicileri gövde başındaki yığın tepesine döner */
+    yaz(u, "    leaq    -.LF%d(%%rbp), %%rsp", u->kuyruk.cerceve);
+    yaz(u, "    jmp     .L%d", u->kuyruk.etiket);
+    return 1;
+}
+
 /* Özelleştirilmiş generic fonksiyon üretimi için yardımcı */
 static void islev_uret_ozel(Üretici *u, Düğüm *d, const char *ozel_isim,
                             const char *tip_parametre, const char *somut_tip);
 
 static void islev_uret(Üretici *u, Düğüm *d) {
     char *isim = d->veri.islev.isim;
-    char *dekorator = d->veri.islev.dekorator;
+    char *dekorator = satirici_ipucu(d->veri.islev.dekorator) ? NULL : d->veri.islev.dekorator;
     TipTürü donus = d->veri.islev.dönüş_tipi ?
         tip_adı_çevir(d->veri.islev.dönüş_tipi) : TİP_BOŞLUK;
 
@@ -3027,6 +4293,7 @@ static void islev_uret(Üretici *u, Düğüm *d) {
     /* Fonksiyon sembolünü üst kapsamda kaydet (param bilgisi ile) */
     Sembol *fn_sem = sembol_ekle(u->arena, u->kapsam, isim, donus);
     fn_sem->dönüş_tipi = donus;
+    fn_sem->islev_mi = 1;
 
     /* Parametre tiplerini topla */
     int param_sayisi = 0;
@@ -3045,16 +4312,28 @@ static void islev_uret(Üretici *u, Düğüm *d) {
     TipTürü onceki_donus = u->mevcut_islev_donus_tipi;
     u->mevcut_islev_donus_tipi = donus;
 
+    /* Yazmaç adayları (lambda gövdeleri iç içe üretilir: dış durumu sakla) */
+    char *onceki_adaylar[URETICI_YAZMAC_SAYISI];
+    int onceki_aday_sayisi = u->yazmac_aday_sayisi;
+    memcpy(onceki_adaylar, u->yazmac_adaylari, sizeof(onceki_adaylar));
+    int yazmac_sayisi = yazmac_adaylari_sec(u, d);
+    DeneTablosu onceki_dene = u->dene;
+    memset(&u->dene, 0, sizeof(u->dene));
+    KuyrukDurumu onceki_kuyruk = u->kuyruk;
+    int onceki_sinir = u->sinir_sayisi;
+    u->sinir_sayisi = 0;
+
     yaz(u, "");
     yaz(u, "    .globl  %s", gercek_isim);
     yaz(u, "%s:", gercek_isim);
-    yaz(u, "    pushq   %%rbp");
-    yaz(u, "    movq    %%rsp, %%rbp");
+    islev_giris_yaz(u);
 
-    /* Yeni kapsam */
+    /* Yeni kapsam; ilk slotlar callee-saved yazmaçların kayıt alanı */
     Kapsam *onceki = u->kapsam;
     u->kapsam = kapsam_oluştur(u->arena, onceki);
-    u->kapsam->yerel_sayac = 0;
+    u->kapsam->yerel_sayac = yazmac_sayisi;
+    int yerel_tepe = yazmac_sayisi;
+    u->kapsam->yerel_tepe = &yerel_tepe;
 
     /* Sınıf metotu ise "bu" parametresini ekle */
     if (u->mevcut_sinif) {
@@ -3079,22 +4358,28 @@ static void islev_uret(Üretici *u, Düğüm *d) {
             Sembol *s = sembol_ekle(u->arena, u->kapsam, p->veri.değişken.isim, p_tip);
             s->parametre_mi = 1;
             s->global_mi = 0;
+            if (i < 6) yazmac_ata(u, s, NULL);
             /* Sınıf parametresi: sınıf_adı ayarla */
             if (p_tip == TİP_SINIF && p->veri.değişken.tip) {
                 s->sınıf_adı = p->veri.değişken.tip;
             }
-            /* Metin parametreler 2 slot kullanır */
-            if (p_tip == TİP_METİN) {
-                u->kapsam->yerel_sayac++;
+            /* Metin ve dizi parametreler 2 slot kullanır */
+            if (p_tip == TİP_METİN || p_tip == TİP_DİZİ) {
+                kapsam_yerel_ayir(u->kapsam, 1);
             }
         }
     }
 
-    /* Yeterli stack alanı ayır (en az 64 byte) */
-    int stack_boyut = (u->kapsam->yerel_sayac + 8) * 8;
-    /* 16-byte hizala */
-    stack_boyut = (stack_boyut + 15) & ~15;
-    yaz(u, "    subq    $%d, %%rsp", stack_boyut);
+    if (d->çocuk_sayısı > 1) dene_slotlari_ayir(u, d->çocuklar[1]);
+
+    /* Çerçeve boyutu gövdedeki alt kapsamlar da sayılınca belli olur:
+     * .LF<n> sembolü işlev sonunda tanımlanır (en az 64 byte) */
+    int cerceve = yeni_etiket(u);
+    yaz(u, "    subq    $.LF%d, %%rsp", cerceve);
+    for (int i = 0; i < yazmac_sayisi; i++) {
+        yaz(u, "    movq    %%%s, -%d(%%rbp)", yazmac_adlari[i], (i + 1) * 8);
+        yaz(u, "    .cfi_offset %%%s, -%d", yazmac_adlari[i], (i + 3) * 8);
+    }
 
     /* Parametreleri stack'e kopyala - tip bazlı register ataması */
     /* System V ABI: integer args -> rdi,rsi,rdx,rcx,r8,r9; float args -> xmm0-xmm7 */
@@ -3108,34 +4393,59 @@ static void islev_uret(Üretici *u, Düğüm *d) {
         }
     }
 
+    const char *int_regs[] = {"rdi", "rsi", "rdx", "rcx", "r8", "r9"};
+    int int_reg_idx = u->mevcut_sinif ? 1 : 0;  /* metotlarda rdi = bu */
+    /* Yığın argümanları gövde etiketinden sonra kopyalanır: öz kuyruk
+     * çağrısı onları gelen yuvalarının üzerine yazıp atlar. Metot
+     * çağrıları yalnızca yazmaçla geçer. */
+    int yigin_konum[32];
+    for (int i = 0; i < 32; i++) yigin_konum[i] = -1;
+    if (d->çocuk_sayısı > 0 && !u->mevcut_sinif) {
+        int n = d->çocuklar[0]->çocuk_sayısı;
+        arguman_yerlesimi(param_tipleri, n < 32 ? n : 32, yigin_konum);
+    }
     if (d->çocuk_sayısı > 0) {
         Düğüm *params = d->çocuklar[0];
-        const char *int_regs[] = {"rdi", "rsi", "rdx", "rcx", "r8", "r9"};
-        int int_reg_idx = u->mevcut_sinif ? 1 : 0;  /* metotlarda rdi = bu */
         int xmm_reg_idx = 0;
 
         for (int i = 0; i < params->çocuk_sayısı; i++) {
             Sembol *s = sembol_ara(u->kapsam, params->çocuklar[i]->veri.değişken.isim);
             if (!s) continue;
+            if (i < 32 && yigin_konum[i] >= 0) break;
             int offset = (s->yerel_indeks + 1) * 8;
             TipTürü p_tip = param_tipleri[i];
 
             if (p_tip == TİP_ONDALIK) {
                 yaz(u, "    movsd   %%xmm%d, -%d(%%rbp)", xmm_reg_idx, offset);
                 xmm_reg_idx++;
-            } else if (p_tip == TİP_METİN && int_reg_idx + 1 < 6) {
+            } else if ((p_tip == TİP_METİN || p_tip == TİP_DİZİ) && int_reg_idx + 1 < 6) {
                 /* Metin: pointer + length */
                 yaz(u, "    movq    %%%s, -%d(%%rbp)", int_regs[int_reg_idx], offset);
                 int_reg_idx++;
                 yaz(u, "    movq    %%%s, -%d(%%rbp)", int_regs[int_reg_idx], offset + 8);
                 int_reg_idx++;
             } else if (int_reg_idx < 6) {
-                yaz(u, "    movq    %%%s, -%d(%%rbp)", int_regs[int_reg_idx], offset);
+                yaz(u, "    movq    %%%s, %s", int_regs[int_reg_idx], yerel_yer(s));
                 int_reg_idx++;
             }
         }
     }
 
+    /* Kapanış r10'da gelir (buraya kadar yalnızca yığına yazıldı);
+     * yakalanan değerleri yerel slotlara kopyala */
+    if (d->tur == DÜĞÜM_LAMBDA && d->veri.islev.yakalanan_sayisi > 0) {
+        int yak_say = d->veri.islev.yakalanan_sayisi;
+        char **yak_isimleri = d->veri.islev.yakalanan_isimler;
+        yaz(u, "    movq    %%r10, %%r11");
+        for (int ci = 0; ci < yak_say; ci++) {
+            Sembol *cs = sembol_ekle(u->arena, u->kapsam, yak_isimleri[ci], TİP_TAM);
+            cs->yerel_indeks = kapsam_yerel_ayir(u->kapsam, 1);
+            int dst_off = (cs->yerel_indeks + 1) * 8;
+            yaz(u, "    movq    %d(%%r11), %%rax", (ci + 2) * 8);
+            yaz(u, "    movq    %%rax, -%d(%%rbp)", dst_off);
+        }
+    }
+
     /* Profil modu: giriş kaydı */
     int profil_isim_idx = -1;
     if (u->profil_modu) {
@@ -3147,22 +4457,34 @@ static void islev_uret(Üretici *u, Düğüm *d) {
         yaz(u, "    call    _tr_profil_giris");
     }
 
-    /* Kapanış: yakalanan değişkenleri ortamdan yükle */
-    if (d->tur == DÜĞÜM_LAMBDA && d->veri.islev.yakalanan_sayisi > 0) {
-        int yak_say = d->veri.islev.yakalanan_sayisi;
-        char **yak_isimleri = d->veri.islev.yakalanan_isimler;
-        /* _tr_kapanis_ortam global pointer'ından oku */
-        yaz(u, "    movq    _tr_kapanis_ortam(%%rip), %%r12");
-        for (int ci = 0; ci < yak_say; ci++) {
-            Sembol *cs = sembol_ekle(u->arena, u->kapsam, yak_isimleri[ci], TİP_TAM);
-            cs->yerel_indeks = u->kapsam->yerel_sayac++;
-            int dst_off = (cs->yerel_indeks + 1) * 8;
-            yaz(u, "    movq    %d(%%r12), %%rax", (ci + 2) * 8);
-            yaz(u, "    movq    %%rax, -%d(%%rbp)", dst_off);
+    /* Gövde (öz kuyruk çağrıları parametreleri yazıp buraya atlar) */
+    u->kuyruk.islev = u->mevcut_sinif ? NULL : d;
+    u->kuyruk.kapsam = u->kapsam;
+    u->kuyruk.etiket = yeni_etiket(u);
+    u->kuyruk.cerceve = cerceve;
+    yaz(u, ".L%d:", u->kuyruk.etiket);
+    if (d->çocuk_sayısı > 0) {
+        Düğüm *params = d->çocuklar[0];
+        for (int i = 0; i < params->çocuk_sayısı && i < 32; i++) {
+            if (yigin_konum[i] < 0) continue;
+            Sembol *s = sembol_ara(u->kapsam, params->çocuklar[i]->veri.değişken.isim);
+            if (!s) continue;
+            int gelen = 16 + yigin_konum[i] * 8;
+            int offset = (s->yerel_indeks + 1) * 8;
+            if (param_tipleri[i] == TİP_ONDALIK) {
+                yaz(u, "    movsd   %d(%%rbp), %%xmm0", gelen);
+                yaz(u, "    movsd   %%xmm0, -%d(%%rbp)", offset);
+            } else if (param_tipleri[i] == TİP_METİN || param_tipleri[i] == TİP_DİZİ) {
+                yaz(u, "    movq    %d(%%rbp), %%rax", gelen);
+                yaz(u, "    movq    %%rax, -%d(%%rbp)", offset);
+                yaz(u, "    movq    %d(%%rbp), %%rax", gelen + 8);
+                yaz(u, "    movq    %%rax, -%d(%%rbp)", offset + 8);
+            } else {
+                yaz(u, "    movq    %d(%%rbp), %%rax", gelen);
+                yaz(u, "    movq    %%rax, %s", yerel_yer(s));
+            }
         }
     }
-
-    /* Gövde */
     if (d->çocuk_sayısı > 1) {
         blok_uret(u, d->çocuklar[1]);
     }
@@ -3180,8 +4502,13 @@ static void islev_uret(Üretici *u, Düğüm *d) {
     } else {
         yaz(u, "    xorq    %%rax, %%rax");
     }
+    yazmac_geri_yukle(u);
     yaz(u, "    leave");
     yaz(u, "    ret");
+    islev_bitis_yaz(u);
+    /* Kapanış yakalamaları da yerel slot alır; 16-byte hizala */
+    int yakalama_slot = d->tur == DÜĞÜM_LAMBDA ? d->veri.islev.yakalanan_sayisi : 0;
+    yaz(u, "    .set    .LF%d, %d", cerceve, ((yerel_tepe + yakalama_slot + 8) * 8 + 15) & ~15);
 
     if (u->profil_modu) {
         u->profil_mevcut_islev = NULL;
@@ -3189,14 +4516,15 @@ static void islev_uret(Üretici *u, Düğüm *d) {
 
     u->kapsam = onceki;
     u->mevcut_islev_donus_tipi = onceki_donus;
+    memcpy(u->yazmac_adaylari, onceki_adaylar, sizeof(onceki_adaylar));
+    u->yazmac_aday_sayisi = onceki_aday_sayisi;
 
     /* Dekoratör wrapper: <isim> çağrıldığında orijinal + dekoratör çağır */
     if (dekorator) {
         yaz(u, "");
         yaz(u, "    .globl  %s", isim);
         yaz(u, "%s:", isim);
-        yaz(u, "    pushq   %%rbp");
-        yaz(u, "    movq    %%rsp, %%rbp");
+        islev_giris_yaz(u);
         /* Argümanları olduğu gibi aktar (register'lar korunur) */
         yaz(u, "    call    %s", gercek_isim);
         /* Sonucu dekoratör fonksiyonuna geçir: rax -> rdi */
@@ -3204,7 +4532,11 @@ static void islev_uret(Üretici *u, Düğüm *d) {
         yaz(u, "    call    %s", dekorator);
         yaz(u, "    leave");
         yaz(u, "    ret");
+        islev_bitis_yaz(u);
     }
+    u->dene = onceki_dene;
+    u->kuyruk = onceki_kuyruk;
+    u->sinir_sayisi = onceki_sinir;
 }
 
 /* Özelleştirilmiş generic fonksiyon üretimi
@@ -3250,16 +4582,27 @@ static void islev_uret_ozel(Üretici *u, Düğüm *d, const char *ozel_isim,
     TipTürü onceki_donus = u->mevcut_islev_donus_tipi;
     u->mevcut_islev_donus_tipi = donus;
 
+    /* Özelleştirilmiş gövdeler yazmaç tahsisi yapmaz */
+    int onceki_aday_sayisi = u->yazmac_aday_sayisi;
+    u->yazmac_aday_sayisi = 0;
+
     yaz(u, "");
     yaz(u, "    .globl  %s", ozel_isim);
+    DeneTablosu onceki_dene = u->dene;
+    memset(&u->dene, 0, sizeof(u->dene));
+    KuyrukDurumu onceki_kuyruk = u->kuyruk;
+    u->kuyruk.islev = NULL;
+    int onceki_sinir = u->sinir_sayisi;
+    u->sinir_sayisi = 0;
     yaz(u, "%s:", ozel_isim);
-    yaz(u, "    pushq   %%rbp");
-    yaz(u, "    movq    %%rsp, %%rbp");
+    islev_giris_yaz(u);
 
     /* Yeni kapsam */
     Kapsam *onceki = u->kapsam;
     u->kapsam = kapsam_oluştur(u->arena, onceki);
     u->kapsam->yerel_sayac = 0;
+    int yerel_tepe = 0;
+    u->kapsam->yerel_tepe = &yerel_tepe;
 
     /* Parametreleri tanımla - tip parametresini somut tipe çevir */
     if (d->çocuk_sayısı > 0) {
@@ -3277,17 +4620,18 @@ static void islev_uret_ozel(Üretici *u, Düğüm *d, const char *ozel_isim,
             Sembol *s = sembol_ekle(u->arena, u->kapsam, p->veri.değişken.isim, p_tip);
             s->parametre_mi = 1;
             s->global_mi = 0;
-            /* Metin parametreler 2 slot kullanır */
-            if (p_tip == TİP_METİN) {
-                u->kapsam->yerel_sayac++;
+            /* Metin ve dizi parametreler 2 slot kullanır */
+            if (p_tip == TİP_METİN || p_tip == TİP_DİZİ) {
+                kapsam_yerel_ayir(u->kapsam, 1);
             }
         }
     }
 
-    /* Yeterli stack alanı ayır */
-    int stack_boyut = (u->kapsam->yerel_sayac + 8) * 8;
-    stack_boyut = (stack_boyut + 15) & ~15;
-    yaz(u, "    subq    $%d, %%rsp", stack_boyut);
+    if (d->çocuk_sayısı > 1) dene_slotlari_ayir(u, d->çocuklar[1]);
+
+    /* Yeterli stack alanı ayır (boyut gövdeden sonra belli olur) */
+    int cerceve = yeni_etiket(u);
+    yaz(u, "    subq    $.LF%d, %%rsp", cerceve);
 
     /* Parametreleri stack'e kopyala */
     if (d->çocuk_sayısı > 0) {
@@ -3315,7 +4659,7 @@ static void islev_uret_ozel(Üretici *u, Düğüm *d, const char *ozel_isim,
                     yaz(u, "    movsd   %%xmm%d, -%d(%%rbp)", xmm_idx, offset);
                     xmm_idx++;
                 }
-            } else if (p_tip == TİP_METİN) {
+            } else if (p_tip == TİP_METİN || p_tip == TİP_DİZİ) {
                 if (int_idx < 6) {
                     yaz(u, "    movq    %%%s, -%d(%%rbp)", int_regs[int_idx], offset);
                     int_idx++;
@@ -3347,11 +4691,277 @@ static void islev_uret_ozel(Üretici *u, Düğüm *d, const char *ozel_isim,
         yaz(u, "    leave");
         yaz(u, "    ret");
     }
+    islev_bitis_yaz(u);
+    yaz(u, "    .set    .LF%d, %d", cerceve, ((yerel_tepe + 8) * 8 + 15) & ~15);
+    u->dene = onceki_dene;
+    u->kuyruk = onceki_kuyruk;
+    u->sinir_sayisi = onceki_sinir;
 
     u->mevcut_islev_donus_tipi = onceki_donus;
+    u->yazmac_aday_sayisi = onceki_aday_sayisi;
     u->kapsam = onceki;
 }
 
+/* ---- paralel her...için ----
+ * Gövde _tr_paralel_govde_N(ortam, bas, son, kismi) olarak ayrı işleve
+ * çıkarılır ve _tr_paralel_her ile parça parça iş havuzunda çalıştırılır.
+ * ortam: [dizi ptr][yakalanan yerellerin kopyaları...]; kismi: parçanın
+ * indirgeme değerleri. Gövde dış yerellere yazmaz (anlam.c denetler), bu
+ * yüzden yakalamalar değer kopyasıdır. Paylaşılan dizi yazmaları ayrık
+ * değilse parçalar _tr_paralel_her_eleman/_sirali ile sırayla çalışır. */
+
+#define PARALEL_MAKS_YAKALAMA 64
+
+/* Gövdenin paylaşılan dizi yazmalarına göre çalışma zamanı girişi */
+static const char *paralel_her_giris(Düğüm *d) {
+    switch (d->veri.dongu.paylasim) {
+    case PARALEL_PAYLASIM_ELEMAN: return "_tr_paralel_her_eleman";
+    case PARALEL_PAYLASIM_SIRALI: return "_tr_paralel_her_sirali";
+    default:                      return "_tr_paralel_her";
+    }
+}
+
+static int paralel_indirgeme_sira(Düğüm *d, const char *isim) {
+    for (int i = 0; i < d->veri.dongu.indirgeme_sayisi; i++) {
+        if (strcmp(d->veri.dongu.indirgeme_isim[i], isim) == 0) return i;
+    }
+    return -1;
+}
+
+static void paralel_yakala_topla(Düğüm *d, Düğüm *dongu, Kapsam *dis,
+                                 Sembol **liste, int *sayi) {
+    if (!d) return;
+    if (d->tur == DÜĞÜM_TANIMLAYICI && d->veri.tanimlayici.isim) {
+        const char *isim = d->veri.tanimlayici.isim;
+        Sembol *s = sembol_ara(dis, isim);
+        if (s && !s->global_mi && strcmp(isim, dongu->veri.dongu.isim) != 0 &&
+            paralel_indirgeme_sira(dongu, isim) < 0) {
+            int var = 0;
+            for (int i = 0; i < *sayi; i++) {
+                if (liste[i] == s) { var = 1; break; }
+            }
+            if (!var && *sayi < PARALEL_MAKS_YAKALAMA) liste[(*sayi)++] = s;
+        }
+    }
+    for (int i = 0; i < d->çocuk_sayısı; i++) {
+        paralel_yakala_topla(d->çocuklar[i], dongu, dis, liste, sayi);
+    }
+}
+
+static int paralel_slot_sayisi(Sembol *s) {
+    return (s->tip == TİP_METİN || s->tip == TİP_DİZİ) ? 2 : 1;
+}
+
+static void paralel_her_uret(Üretici *u, Düğüm *d) {
+    int ind_sayisi = d->veri.dongu.indirgeme_sayisi;
+    Sembol *yakalanan[PARALEL_MAKS_YAKALAMA];
+    int yak_sayisi = 0;
+    if (d->çocuk_sayısı > 1) {
+        paralel_yakala_topla(d->çocuklar[1], d, u->kapsam, yakalanan, &yak_sayisi);
+    }
+    int yak_slot = 0;
+    for (int i = 0; i < yak_sayisi; i++) yak_slot += paralel_slot_sayisi(yakalanan[i]);
+
+    /* Gövde işlevi: [rbx][r12][ortam][idx][son][kismi] sonra yereller */
+    char govde_isim[64];
+    snprintf(govde_isim, sizeof(govde_isim), "_tr_paralel_govde_%d", yeni_etiket(u));
+
+    Metin onceki_cikti = u->cikti;
+    metin_baslat(&u->cikti);
+    Kapsam *onceki_kapsam = u->kapsam;
+    char *onceki_adaylar[URETICI_YAZMAC_SAYISI];
+    int onceki_aday_sayisi = u->yazmac_aday_sayisi;
+    memcpy(onceki_adaylar, u->yazmac_adaylari, sizeof(onceki_adaylar));
+    int onceki_baslangic = u->dongu_baslangic_etiket;
+    int onceki_bitis = u->dongu_bitis_etiket;
+    int onceki_yoksa = u->dongu_yoksa_etiket;
+    int onceki_temizlik = u->her_icin_temizlik;
+    DeneTablosu onceki_dene = u->dene;
+    memset(&u->dene, 0, sizeof(u->dene));
+    KuyrukDurumu onceki_kuyruk = u->kuyruk;
+    u->kuyruk.islev = NULL;
+    int onceki_sinir = u->sinir_sayisi;
+    u->sinir_sayisi = 0;
+    int govde_bas = yeni_etiket(u);     /* prolog gövdeden sonra yazılır */
+    u->dene.islev_bas = govde_bas;
+    u->yazmac_aday_sayisi = 0;
+    u->her_icin_temizlik = 0;
+
+    u->kapsam = kapsam_oluştur(u->arena, onceki_kapsam);
+    u->kapsam->yerel_sayac = 6;
+    int yerel_tepe = 6;
+    u->kapsam->yerel_tepe = &yerel_tepe;
+    yaz(u, "    movq    %%rbx, -8(%%rbp)");
+    yaz(u, "    .cfi_offset %%rbx, -24");
+    yaz(u, "    movq    %%r12, -16(%%rbp)");
+    yaz(u, "    .cfi_offset %%r12, -32");
+    yaz(u, "    movq    %%rdi, -24(%%rbp)");
+    yaz(u, "    movq    %%rsi, -32(%%rbp)");
+    yaz(u, "    movq    %%rdx, -40(%%rbp)");
+    yaz(u, "    movq    %%rcx, -48(%%rbp)");
+
+    /* İndirgeme yerelleri parçanın kısmi değerinden başlar */
+    Sembol *ind_yerel[4];
+    for (int i = 0; i < ind_sayisi; i++) {
+        ind_yerel[i] = sembol_ekle(u->arena, u->kapsam, d->veri.dongu.indirgeme_isim[i], TİP_TAM);
+        yaz(u, "    movq    -48(%%rbp), %%rcx");
+        yaz(u, "    movq    %d(%%rcx), %%rax", i * 8);
+        yaz(u, "    movq    %%rax, %s", yerel_yer(ind_yerel[i]));
+    }
+
+    /* Yakalanan yerelleri ortamdan kopyala */
+    yaz(u, "    movq    -24(%%rbp), %%rcx");
+    int ortam_ofset = 8;
+    for (int i = 0; i < yak_sayisi; i++) {
+        Sembol *dis = yakalanan[i];
+        Sembol *ic = sembol_ekle(u->arena, u->kapsam, dis->isim, dis->tip);
+        int indeks = ic->yerel_indeks;
+        *ic = *dis;
+        ic->yerel_indeks = indeks;
+        ic->yazmac = 0;
+        ic->parametre_mi = 1;   /* dışarıyla paylaşılır: dizisi yerinde büyütülmez */
+        int slot = paralel_slot_sayisi(dis);
+        if (slot == 2) kapsam_yerel_ayir(u->kapsam, 1);
+        for (int k = 0; k < slot; k++) {
+            yaz(u, "    movq    %d(%%rcx), %%rax", ortam_ofset);
+            yaz(u, "    movq    %%rax, -%d(%%rbp)", (indeks + 1 + k) * 8);
+            ortam_ofset += 8;
+        }
+    }
+
+    Sembol *elem = sembol_ekle(u->arena, u->kapsam, d->veri.dongu.isim, TİP_TAM);
+    if (d->çocuk_sayısı > 1) dene_slotlari_ayir(u, d->çocuklar[1]);
+
+    int baslangic = yeni_etiket(u);
+    int artir = yeni_etiket(u);
+    int bitis = yeni_etiket(u);
+    u->dongu_baslangic_etiket = artir;
+    u->dongu_bitis_etiket = bitis;
+    u->dongu_yoksa_etiket = 0;
+
+    yaz(u, ".L%d:", baslangic);
+    yaz(u, "    movq    -32(%%rbp), %%rcx");
+    yaz(u, "    cmpq    -40(%%rbp), %%rcx");
+    yaz(u, "    jge     .L%d", bitis);
+    yaz(u, "    movq    -24(%%rbp), %%rdx");
+    yaz(u, "    movq    (%%rdx), %%rdx");
+    yaz(u, "    movq    (%%rdx,%%rcx,8), %%rax");
+    yaz(u, "    movq    %%rax, -%d(%%rbp)", (elem->yerel_indeks + 1) * 8);
+    if (d->çocuk_sayısı > 1) blok_uret(u, d->çocuklar[1]);
+    yaz(u, ".L%d:", artir);
+    yaz(u, "    incq    -32(%%rbp)");
+    yaz(u, "    jmp     .L%d", baslangic);
+    yaz(u, ".L%d:", bitis);
+
+    /* Kısmi indirgemeleri geri yaz */
+    for (int i = 0; i < ind_sayisi; i++) {
+        yaz(u, "    movq    -48(%%rbp), %%rcx");
+        yaz(u, "    movq    %s, %%rax", yerel_yer(ind_yerel[i]));
+        yaz(u, "    movq    %%rax, %d(%%rcx)", i * 8);
+    }
+    yaz(u, "    movq    -8(%%rbp), %%rbx");
+    yaz(u, "    movq    -16(%%rbp), %%r12");
+    yaz(u, "    xorq    %%rax, %%rax");
+    yaz(u, "    leave");
+    yaz(u, "    ret");
+    islev_bitis_yaz(u);
+
+    /* Çerçeve boyutu gövdeden sonra belli olur (ana işlevdeki gibi) */
+    int stack_boyut = (yerel_tepe + 8) * 8;
+    stack_boyut = (stack_boyut + 15) & ~15;
+    if (stack_boyut < 256) stack_boyut = 256;
+    Metin govde = u->cikti;
+    metin_baslat(&u->cikti);
+    yaz(u, "");
+    yaz(u, "%s:", govde_isim);
+    u->dene.islev_bas = govde_bas;
+    islev_giris_yaz(u);
+    yaz(u, "    subq    $%d, %%rsp", stack_boyut);
+    metin_ekle(&u->cikti, govde.veri);
+    metin_serbest(&govde);
+    metin_ekle(&u->yardimcilar, u->cikti.veri);
+    metin_serbest(&u->cikti);
+
+    u->cikti = onceki_cikti;
+    u->kapsam = onceki_kapsam;
+    memcpy(u->yazmac_adaylari, onceki_adaylar, sizeof(onceki_adaylar));
+    u->yazmac_aday_sayisi = onceki_aday_sayisi;
+    u->dongu_baslangic_etiket = onceki_baslangic;
+    u->dongu_bitis_etiket = onceki_bitis;
+    u->dongu_yoksa_etiket = onceki_yoksa;
+    u->her_icin_temizlik = onceki_temizlik;
+    u->dene = onceki_dene;
+    u->kuyruk = onceki_kuyruk;
+    u->sinir_sayisi = onceki_sinir;
+
+    /* Çağrı: rax=ptr, rbx=count. Blok [ortam][indirgeme][işlemler] canlı
+     * yerellerin altına kurulur (yerel slotlar rsp'nin altına taşabilir). */
+    ifade_üret(u, d->çocuklar[0]);
+    int blok_boyut = ((1 + yak_slot + 2 * ind_sayisi) * 8 + 15) & ~15;
+    int ind_ofset = (1 + yak_slot) * 8;
+    int islem_ofset = ind_ofset + ind_sayisi * 8;
+    yaz(u, "    movq    %%rsp, %%rcx");
+    yaz(u, "    leaq    -%d(%%rbp), %%rdx", (u->kapsam->yerel_sayac + 1) * 8);
+    yaz(u, "    cmpq    %%rdx, %%rsp");
+    yaz(u, "    cmovaq  %%rdx, %%rsp");
+    yaz(u, "    subq    $16, %%rsp");
+    yaz(u, "    andq    $-16, %%rsp");
+    yaz(u, "    movq    %%rcx, (%%rsp)");
+    yaz(u, "    movq    %%r12, 8(%%rsp)");
+    yaz(u, "    movq    %%rsp, %%r12");
+    yaz(u, "    subq    $%d, %%rsp", blok_boyut);
+    yaz(u, "    movq    %%rax, (%%rsp)");
+    int ofset = 8;
+    for (int i = 0; i < yak_sayisi; i++) {
+        Sembol *ys = yakalanan[i];
+        if (paralel_slot_sayisi(ys) == 2) {
+            int yer = (ys->yerel_indeks + 1) * 8;
+            yaz(u, "    movq    -%d(%%rbp), %%rcx", yer);
+            yaz(u, "    movq    %%rcx, %d(%%rsp)", ofset);
+            yaz(u, "    movq    -%d(%%rbp), %%rcx", yer + 8);
+            yaz(u, "    movq    %%rcx, %d(%%rsp)", ofset + 8);
+            ofset += 16;
+        } else {
+            yaz(u, "    movq    %s, %%rcx", yerel_yer(ys));
+            yaz(u, "    movq    %%rcx, %d(%%rsp)", ofset);
+            ofset += 8;
+        }
+    }
+    Sembol *ind_dis[4];
+    for (int i = 0; i < ind_sayisi; i++) {
+        ind_dis[i] = sembol_ara(u->kapsam, d->veri.dongu.indirgeme_isim[i]);
+        if (!ind_dis[i]) {
+            yaz(u, "    movq    $0, %d(%%rsp)", ind_ofset + i * 8);
+        } else if (ind_dis[i]->global_mi) {
+            yaz(u, "    movq    _genel_%s(%%rip), %%rcx", ind_dis[i]->isim);
+            yaz(u, "    movq    %%rcx, %d(%%rsp)", ind_ofset + i * 8);
+        } else {
+            yaz(u, "    movq    %s, %%rcx", yerel_yer(ind_dis[i]));
+            yaz(u, "    movq    %%rcx, %d(%%rsp)", ind_ofset + i * 8);
+        }
+        yaz(u, "    movq    $%d, %d(%%rsp)", d->veri.dongu.indirgeme_islem[i], islem_ofset + i * 8);
+    }
+    yaz(u, "    leaq    %s(%%rip), %%rdi", govde_isim);
+    yaz(u, "    movq    %%rsp, %%rsi");
+    yaz(u, "    movq    %%rbx, %%rdx");
+    yaz(u, "    leaq    %d(%%rsp), %%rcx", ind_ofset);
+    yaz(u, "    leaq    %d(%%rsp), %%r8", islem_ofset);
+    yaz(u, "    movq    $%d, %%r9", ind_sayisi);
+    yaz(u, "    call    %s", paralel_her_giris(d));
+    for (int i = 0; i < ind_sayisi; i++) {
+        if (!ind_dis[i]) continue;
+        yaz(u, "    movq    %d(%%rsp), %%rax", ind_ofset + i * 8);
+        if (ind_dis[i]->global_mi) {
+            yaz(u, "    movq    %%rax, _genel_%s(%%rip)", ind_dis[i]->isim);
+        } else {
+            yaz(u, "    movq    %%rax, %s", yerel_yer(ind_dis[i]));
+        }
+    }
+    yaz(u, "    movq    (%%r12), %%rcx");
+    yaz(u, "    movq    8(%%r12), %%r12");
+    yaz(u, "    movq    %%rcx, %%rsp");
+}
+
 static void blok_uret(Üretici *u, Düğüm *blok) {
     if (!blok) return;
     for (int i = 0; i < blok->çocuk_sayısı; i++) {
@@ -3439,6 +5049,10 @@ static void bildirim_uret(Üretici *u, Düğüm *d) {
         iken_uret(u, d);
         break;
     case DÜĞÜM_DÖNDÜR:
+        if (d->çocuk_sayısı == 1 && d->çocuklar[0]->tur == DÜĞÜM_ÇAĞRI &&
+            d->çocuklar[0]->veri.tanimlayici.isim && kuyruk_cagri_uret(u, d->çocuklar[0])) {
+            break;
+        }
         if (d->çocuk_sayısı == 1) {
             ifade_üret(u, d->çocuklar[0]);
         } else if (d->çocuk_sayısı >= 2) {
@@ -3457,6 +5071,7 @@ static void bildirim_uret(Üretici *u, Düğüm *d) {
             yaz(u, "    call    _tr_profil_cikis");
             yaz(u, "    popq    %%rax");
         }
+        yazmac_geri_yukle(u);
         yaz(u, "    leave");
         yaz(u, "    ret");
         break;
@@ -3511,12 +5126,12 @@ static void bildirim_uret(Üretici *u, Düğüm *d) {
                     Sembol *s = sembol_ara(u->kapsam, hedef->veri.tanimlayici.isim);
                     if (!s) {
                         s = sembol_ekle(u->arena, u->kapsam, hedef->veri.tanimlayici.isim, TİP_TAM);
-                        s->yerel_indeks = u->kapsam->yerel_sayac++;
+                        s->yerel_indeks = kapsam_yerel_ayir(u->kapsam, 1);
                     }
                     if (i == 0) {
-                        yaz(u, "    movq    %%rax, -%d(%%rbp)", (s->yerel_indeks + 1) * 8);
+                        yaz(u, "    movq    %%rax, %s", yerel_yer(s));
                     } else {
-                        yaz(u, "    movq    %%rdx, -%d(%%rbp)", (s->yerel_indeks + 1) * 8);
+                        yaz(u, "    movq    %%rdx, %s", yerel_yer(s));
                     }
                 }
             }
@@ -3542,8 +5157,7 @@ static void bildirim_uret(Üretici *u, Düğüm *d) {
                     Sembol *rs = sembol_ara(u->kapsam, rest_isim);
                     if (!rs) {
                         rs = sembol_ekle(u->arena, u->kapsam, rest_isim, TİP_DİZİ);
-                        rs->yerel_indeks = u->kapsam->yerel_sayac;
-                        u->kapsam->yerel_sayac += 2;  /* ptr + count */
+                        rs->yerel_indeks = kapsam_yerel_ayir(u->kapsam, 2);  /* ptr + count */
                     }
                     int rs_off = (rs->yerel_indeks + 1) * 8;
 
@@ -3590,14 +5204,14 @@ static void bildirim_uret(Üretici *u, Düğüm *d) {
                             Sembol *ss = sembol_ara(u->kapsam, sonraki->veri.tanimlayici.isim);
                             if (!ss) {
                                 ss = sembol_ekle(u->arena, u->kapsam, sonraki->veri.tanimlayici.isim, TİP_TAM);
-                                ss->yerel_indeks = u->kapsam->yerel_sayac++;
+                                ss->yerel_indeks = kapsam_yerel_ayir(u->kapsam, 1);
                             }
                             /* kaynak[total_count - sonra + j] */
                             yaz(u, "    movq    8(%%rsp), %%rcx");  /* count */
                             yaz(u, "    subq    $%d, %%rcx", sonra - j);
                             yaz(u, "    movq    (%%rsp), %%rdx");   /* ptr */
                             yaz(u, "    movq    (%%rdx,%%rcx,8), %%rax");
-                            yaz(u, "    movq    %%rax, -%d(%%rbp)", (ss->yerel_indeks + 1) * 8);
+                            yaz(u, "    movq    %%rax, %s", yerel_yer(ss));
                         }
                     }
                     i = hedef_sayisi;  /* döngüden çık (sonrakileri zaten işledik) */
@@ -3605,12 +5219,12 @@ static void bildirim_uret(Üretici *u, Düğüm *d) {
                     Sembol *s = sembol_ara(u->kapsam, hedef->veri.tanimlayici.isim);
                     if (!s) {
                         s = sembol_ekle(u->arena, u->kapsam, hedef->veri.tanimlayici.isim, TİP_TAM);
-                        s->yerel_indeks = u->kapsam->yerel_sayac++;
+                        s->yerel_indeks = kapsam_yerel_ayir(u->kapsam, 1);
                     }
                     /* dizi[i] → değişken */
                     yaz(u, "    movq    (%%rsp), %%rax");  /* ptr */
                     yaz(u, "    movq    %d(%%rax), %%rax", i * 8);
-                    yaz(u, "    movq    %%rax, -%d(%%rbp)", (s->yerel_indeks + 1) * 8);
+                    yaz(u, "    movq    %%rax, %s", yerel_yer(s));
                 }
             }
         }
@@ -3656,17 +5270,11 @@ static void bildirim_uret(Üretici *u, Düğüm *d) {
         yaz(u, "    popq    %%rcx");  /* indeks */
         yaz(u, "    popq    %%rdx");  /* değer */
 
-        hata_dizi_sinir_uret(u);
-        int lbl = yeni_etiket(u);
-        yaz(u, "    cmpq    $0, %%rcx");
-        yaz(u, "    jl      .Ldsn%d", lbl);
-        yaz(u, "    cmpq    %%rbx, %%rcx");
-        yaz(u, "    jl      .Ldok%d", lbl);
-        yaz(u, ".Ldsn%d:", lbl);
-        yaz(u, "    call    _hata_dizi_sinir");
-        yaz(u, ".Ldok%d:", lbl);
-
-        yaz(u, "    movq    %%rdx, (%%rax, %%rcx, 8)");
+        if (!dizi_erisim_guvenli(u, d->çocuklar[0], d->çocuklar[1]))
+            dizi_sinir_denetle(u, "%rcx", "%rbx");
+
+        referans_yaz_uret(u, "%rcx", "%rdx",
+                          referans_degeri_mi(d->çocuklar[2]->sonuç_tipi), 0);
         break;
     }
     case DÜĞÜM_ERİŞİM_ATAMA: {
@@ -3695,7 +5303,7 @@ static void bildirim_uret(Üretici *u, Düğüm *d) {
             }
 
             /* Değeri hesapla */
-            ifade_üret(u, d->çocuklar[1]);
+            dizi_deger_uret(u, d->çocuklar[1]);
             if (hedef_tip == TİP_METİN || hedef_tip == TİP_DİZİ) {
                 yaz(u, "    pushq   %%rbx");  /* len */
                 yaz(u, "    pushq   %%rax");  /* ptr */
@@ -3735,14 +5343,17 @@ static void bildirim_uret(Üretici *u, Düğüm *d) {
                                 }
                             } else {
                                 int offset = sb->alanlar[i].offset;
+                                char kelime[16];
+                                snprintf(kelime, sizeof(kelime), "$%d", offset / 8);
+                                int ref = referans_degeri_mi(d->çocuklar[1]->sonuç_tipi);
                                 if (alan_tipi == TİP_METİN || alan_tipi == TİP_DİZİ) {
                                     yaz(u, "    popq    %%rcx");   /* ptr */
                                     yaz(u, "    popq    %%r8");    /* len */
-                                    yaz(u, "    movq    %%rcx, %d(%%rax)", offset);       /* ptr */
                                     yaz(u, "    movq    %%r8, %d(%%rax)", offset + 8);    /* len */
+                                    referans_yaz_uret(u, kelime, "%rcx", ref, 0);        /* ptr */
                                 } else {
                                     yaz(u, "    popq    %%rcx");  /* değer */
-                                    yaz(u, "    movq    %%rcx, %d(%%rax)", offset);
+                                    referans_yaz_uret(u, kelime, "%rcx", ref, 0);
                                 }
                             }
                             bulundu = 1;
@@ -3876,7 +5487,7 @@ static void bildirim_uret(Üretici *u, Düğüm *d) {
         /* Değişken varsa ata */
         if (d->veri.tanimlayici.isim) {
             Sembol *s = sembol_ekle(u->arena, u->kapsam, d->veri.tanimlayici.isim, TİP_TAM);
-            s->yerel_indeks = u->kapsam->yerel_sayac++;
+            s->yerel_indeks = kapsam_yerel_ayir(u->kapsam, 1);
             yaz(u, "    movq    %%rax, -%d(%%rbp)", (s->yerel_indeks + 1) * 8);
         }
 
@@ -3889,6 +5500,10 @@ static void bildirim_uret(Üretici *u, Düğüm *d) {
 
     case DÜĞÜM_HER_İÇİN: {
         /* her eleman için dizi ise ... [yoksa ...] son */
+        if (d->veri.dongu.paralel) {
+            paralel_her_uret(u, d);
+            break;
+        }
         /* Dizi ifadesini hesapla: rax=ptr, rbx=count */
         ifade_üret(u, d->çocuklar[0]);
 
@@ -3926,7 +5541,7 @@ static void bildirim_uret(Üretici *u, Düğüm *d) {
         Kapsam *onceki_kapsam = u->kapsam;
         u->kapsam = kapsam_oluştur(u->arena, onceki_kapsam);
         Sembol *elem = sembol_ekle(u->arena, u->kapsam, d->veri.dongu.isim, TİP_TAM);
-        elem->yerel_indeks = u->kapsam->yerel_sayac++;
+        elem->yerel_indeks = kapsam_yerel_ayir(u->kapsam, 1);
 
         yaz(u, "    movq    %%rax, -%d(%%rbp)", (elem->yerel_indeks + 1) * 8);
 
@@ -3959,11 +5574,10 @@ static void bildirim_uret(Üretici *u, Düğüm *d) {
     }
     case DÜĞÜM_DENE_YAKALA: {
         /* dene ... yakala [TipAdi] [hata] ... [sonunda ...] son */
-        /* İstisna çerçevesi: 56 byte [rbp, rsp, catch_label, aktif, deger_ptr, deger_len, tip_kodu] */
-        if (!u->istisna_bss_uretildi) {
-            bss_yaz(u, "    .comm   _istisna_cerceve, 56, 8");
-            u->istisna_bss_uretildi = 1;
-        }
+        /* Tablo tabanlı: gövde LSDA'da bir aralıktır, normal yolda yalnız
+         * rsp kaydedilir. Yığın çözücü iniş pistine rax = istisna nesnesi
+         * ve bu işlevin rbp'si ile gelir. İç içe dene'ler aralığı kesintisiz
+         * parçalara böler; her parça en içteki açık piste gider. */
         int yakala_etiket = yeni_etiket(u);
         int son_etiket = yeni_etiket(u);
 
@@ -3972,56 +5586,49 @@ static void bildirim_uret(Üretici *u, Düğüm *d) {
         int yakala_son = sonunda_var ? d->çocuk_sayısı - 1 : d->çocuk_sayısı;
         int sonunda_idx = sonunda_var ? d->çocuk_sayısı - 1 : -1;
 
-        /* Önceki çerçeveyi stack'e kaydet (7 qword) */
-        yaz(u, "    pushq   _istisna_cerceve(%%rip)");
-        yaz(u, "    pushq   _istisna_cerceve+8(%%rip)");
-        yaz(u, "    pushq   _istisna_cerceve+16(%%rip)");
-        yaz(u, "    pushq   _istisna_cerceve+24(%%rip)");
-        yaz(u, "    pushq   _istisna_cerceve+32(%%rip)");
-        yaz(u, "    pushq   _istisna_cerceve+40(%%rip)");
-        yaz(u, "    pushq   _istisna_cerceve+48(%%rip)");
-
-        /* Yeni çerçeveyi kur */
-        yaz(u, "    movq    %%rbp, _istisna_cerceve(%%rip)");
-        yaz(u, "    movq    %%rsp, _istisna_cerceve+8(%%rip)");
-        yaz(u, "    leaq    .L%d(%%rip), %%rax", yakala_etiket);
-        yaz(u, "    movq    %%rax, _istisna_cerceve+16(%%rip)");
-        yaz(u, "    movq    $1, _istisna_cerceve+24(%%rip)");  /* aktif flag */
-        yaz(u, "    movq    $0, _istisna_cerceve+48(%%rip)");  /* tip kodu sıfırla */
+        /* Pist, dene girişindeki rsp'ye döner (her...için yığın düzeni) */
+        int rsp_offset = (u->dene.yigin_slot++ + 1) * 8;
+        yaz(u, "    movq    %%rsp, -%d(%%rbp)", rsp_offset);
+
+        int tablolu = u->dene.derinlik < DENE_MAKS_DERINLIK;
+        int aralik_bas = yeni_etiket(u);
+        yaz(u, ".L%d:", aralik_bas);
+        if (tablolu) {
+            dene_aralik_kapat(u, aralik_bas);
+            u->dene.pistler[u->dene.derinlik++] = yakala_etiket;
+            u->dene.acik_bas = aralik_bas;
+        }
 
         /* Dene bloğu */
         if (d->çocuk_sayısı > 0) blok_uret(u, d->çocuklar[0]);
 
-        /* Normal çıkış: çerçeveyi geri yükle, yakala bloğunu atla */
-        yaz(u, "    popq    _istisna_cerceve+48(%%rip)");
-        yaz(u, "    popq    _istisna_cerceve+40(%%rip)");
-        yaz(u, "    popq    _istisna_cerceve+32(%%rip)");
-        yaz(u, "    popq    _istisna_cerceve+24(%%rip)");
-        yaz(u, "    popq    _istisna_cerceve+16(%%rip)");
-        yaz(u, "    popq    _istisna_cerceve+8(%%rip)");
-        yaz(u, "    popq    _istisna_cerceve(%%rip)");
-        /* sonunda bloğu (normal çıkış yolu) */
+        int aralik_bitis = yeni_etiket(u);
+        yaz(u, ".L%d:", aralik_bitis);
+        if (tablolu) {
+            dene_aralik_kapat(u, aralik_bitis);
+            u->dene.derinlik--;
+            u->dene.acik_bas = aralik_bitis;
+        }
+
+        /* Normal çıkış: sonunda bloğu, yakala bloğunu atla */
         if (sonunda_idx >= 0) blok_uret(u, d->çocuklar[sonunda_idx]);
         yaz(u, "    jmp     .L%d", son_etiket);
 
-        /* Yakala giriş noktası */
+        /* İniş pisti: rax = istisna nesnesi */
         yaz(u, ".L%d:", yakala_etiket);
-        /* İstisna değerini al: rax=ptr, rbx=len, rcx=tip_kodu */
-        yaz(u, "    movq    _istisna_cerceve+32(%%rip), %%rax");
-        yaz(u, "    movq    _istisna_cerceve+40(%%rip), %%rbx");
-        yaz(u, "    movq    _istisna_cerceve+48(%%rip), %%rcx");
-        /* Önceki çerçeveyi geri yükle (stack'ten) */
-        yaz(u, "    popq    _istisna_cerceve+48(%%rip)");
-        yaz(u, "    popq    _istisna_cerceve+40(%%rip)");
-        yaz(u, "    popq    _istisna_cerceve+32(%%rip)");
-        yaz(u, "    popq    _istisna_cerceve+24(%%rip)");
-        yaz(u, "    popq    _istisna_cerceve+16(%%rip)");
-        yaz(u, "    popq    _istisna_cerceve+8(%%rip)");
-        yaz(u, "    popq    _istisna_cerceve(%%rip)");
-
-        /* rax=hata_ptr, rbx=hata_len, rcx=tip_kodu — stack'e kaydet */
+        yaz(u, "    movq    -%d(%%rbp), %%rsp", rsp_offset);
+        yaz(u, "    movq    %%rax, %%rdi");
+        yaz(u, "    call    _tr_istisna_yakala");
+        /* İstisna değerini al: rax=ptr, rdx=len, rcx=tip_kodu (rbx
+         * çağırana ait olabilir: görev işlevleri C'den çağrılır) */
+        yaz(u, "    movq    16(%%rax), %%rcx");
+        yaz(u, "    movq    8(%%rax), %%rdx");
+        yaz(u, "    movq    (%%rax), %%rax");
+
+        /* rax=hata_ptr, rdx=hata_len, rcx=tip_kodu — stack'e kaydet */
+        yaz(u, "    subq    $8, %%rsp");  /* hizalama */
         yaz(u, "    pushq   %%rcx");  /* tip kodu */
-        yaz(u, "    pushq   %%rbx");  /* hata len */
+        yaz(u, "    pushq   %%rdx");  /* hata len */
         yaz(u, "    pushq   %%rax");  /* hata ptr */
 
         /* Çoklu yakala dispatch */
@@ -4055,13 +5662,12 @@ static void bildirim_uret(Üretici *u, Düğüm *d) {
                 Kapsam *onceki_kapsam = u->kapsam;
                 u->kapsam = kapsam_oluştur(u->arena, onceki_kapsam);
                 Sembol *hata_s = sembol_ekle(u->arena, u->kapsam, hata_isim, TİP_METİN);
-                hata_s->yerel_indeks = u->kapsam->yerel_sayac;
-                u->kapsam->yerel_sayac += 2;  /* ptr + len */
+                hata_s->yerel_indeks = kapsam_yerel_ayir(u->kapsam, 2);  /* ptr + len */
                 int offset = (hata_s->yerel_indeks + 1) * 8;
                 yaz(u, "    movq    (%%rsp), %%rax");
-                yaz(u, "    movq    8(%%rsp), %%rbx");
+                yaz(u, "    movq    8(%%rsp), %%rdx");
                 yaz(u, "    movq    %%rax, -%d(%%rbp)", offset);
-                yaz(u, "    movq    %%rbx, -%d(%%rbp)", offset + 8);
+                yaz(u, "    movq    %%rdx, -%d(%%rbp)", offset + 8);
 
                 blok_uret(u, yb);
                 u->kapsam = onceki_kapsam;
@@ -4069,7 +5675,7 @@ static void bildirim_uret(Üretici *u, Düğüm *d) {
                 blok_uret(u, yb);
             }
             /* Stack temizle ve sonunda'ya git */
-            yaz(u, "    addq    $24, %%rsp");
+            yaz(u, "    addq    $32, %%rsp");
             if (sonunda_idx >= 0) blok_uret(u, d->çocuklar[sonunda_idx]);
             yaz(u, "    jmp     .L%d", son_etiket);
 
@@ -4077,7 +5683,7 @@ static void bildirim_uret(Üretici *u, Düğüm *d) {
         }
 
         /* Hiçbir yakala eşleşmezse: stack temizle, sonunda çalıştır */
-        yaz(u, "    addq    $24, %%rsp");
+        yaz(u, "    addq    $32, %%rsp");
         if (sonunda_idx >= 0) blok_uret(u, d->çocuklar[sonunda_idx]);
 
         yaz(u, ".L%d:", son_etiket);
@@ -4086,22 +5692,16 @@ static void bildirim_uret(Üretici *u, Düğüm *d) {
 
     case DÜĞÜM_FIRLAT: {
         /* fırlat ifade */
-        if (!u->istisna_bss_uretildi) {
-            bss_yaz(u, "    .comm   _istisna_cerceve, 56, 8");
-            u->istisna_bss_uretildi = 1;
-        }
         if (d->çocuk_sayısı > 0) {
             ifade_üret(u, d->çocuklar[0]);
         }
-        /* rax = fırlatılan değer (ptr), rbx = len (metin ise) */
-        /* İstisna değerini çerçeveye kaydet */
-        yaz(u, "    movq    %%rax, _istisna_cerceve+32(%%rip)");
-        yaz(u, "    movq    %%rbx, _istisna_cerceve+40(%%rip)");
-        yaz(u, "    movq    $0, _istisna_cerceve+48(%%rip)");  /* tip: genel Hata */
-        /* Çerçeveden rbp/rsp'yi geri yükle, catch label'a zıpla */
-        yaz(u, "    movq    _istisna_cerceve(%%rip), %%rbp");
-        yaz(u, "    movq    _istisna_cerceve+8(%%rip), %%rsp");
-        yaz(u, "    jmpq    *_istisna_cerceve+16(%%rip)");
+        /* rax = fırlatılan değer (ptr), rbx = len (metin ise); dönüş yok,
+         * rsp çözücü için hizalanabilir (CFA rbp tabanlı) */
+        yaz(u, "    movq    %%rax, %%rdi");
+        yaz(u, "    movq    %%rbx, %%rsi");
+        yaz(u, "    xorl    %%edx, %%edx");  /* tip: genel Hata */
+        yaz(u, "    andq    $-16, %%rsp");
+        yaz(u, "    call    _tr_firlat_tipli");
         break;
     }
 
@@ -4136,6 +5736,7 @@ static void bildirim_uret(Üretici *u, Düğüm *d) {
             ifade_üret(u, d->çocuklar[0]);
         }
         /* Değeri döndür (basit üreteç simülasyonu) */
+        yazmac_geri_yukle(u);
         yaz(u, "    leave");
         yaz(u, "    ret");
         break;
@@ -4162,7 +5763,12 @@ void kod_üret(Üretici *u, Düğüm *program, Arena *arena) {
     u->hata_bolme_sifir_uretildi = 0;
     u->hata_dizi_sinir_uretildi = 0;
     u->hata_bellek_uretildi = 0;
-    u->istisna_bss_uretildi = 0;
+    memset(&u->dene, 0, sizeof(u->dene));
+    memset(&u->kuyruk, 0, sizeof(u->kuyruk));
+    u->lsda_sayac = 0;
+    u->statik_kapanislar = NULL;
+    u->statik_kapanis_sayisi = 0;
+    u->statik_kapanis_kapasite = 0;
     /* NOT: generic_ozellestirilmisler ve generic_ozellestirme_sayisi
      * ana.c'de ayarlanıyor, burada sıfırlamıyoruz */
     metin_baslat(&u->cikti);
@@ -4188,8 +5794,7 @@ void kod_üret(Üretici *u, Düğüm *program, Arena *arena) {
 
     yaz(u, "    .globl  main");
     yaz(u, "main:");
-    yaz(u, "    pushq   %%rbp");
-    yaz(u, "    movq    %%rsp, %%rbp");
+    islev_giris_yaz(u);
 
     /* argc/argv'yi global değişkenlere kaydet (argüman modülü için) */
     yaz(u, "    movl    %%edi, _tr_argc(%%rip)");
@@ -4200,6 +5805,12 @@ void kod_üret(Üretici *u, Düğüm *program, Arena *arena) {
     metin_baslat(&_govde_buf);
     Metin _ana_cikti = u->cikti;
     u->cikti = _govde_buf;
+    /* İlk slotlar callee-saved yazmaçların kayıt alanı (main de korur) */
+    int ana_yazmac_sayisi = ana_yazmac_adaylari_sec(u, program);
+    u->kapsam->yerel_sayac = ana_yazmac_sayisi;
+    int ana_yerel_tepe = ana_yazmac_sayisi;
+    u->kapsam->yerel_tepe = &ana_yerel_tepe;
+    dene_slotlari_ayir(u, program);
 
     /* Profil modu: atexit ile rapor fonksiyonunu kaydet */
     if (u->profil_modu) {
@@ -4421,20 +6032,28 @@ void kod_üret(Üretici *u, Düğüm *program, Arena *arena) {
 
     /* Çıkış: return 0 */
     yaz(u, "    xorq    %%rax, %%rax");
+    yazmac_geri_yukle(u);
     yaz(u, "    leave");
     yaz(u, "    ret");
+    islev_bitis_yaz(u);
 
     /* Gövde tamamlandı: gerçek stack boyutunu hesapla ve birleştir */
     {
         Metin _govde_tamamlandi = u->cikti;
         u->cikti = _ana_cikti;
-        int stack_boyut = (u->kapsam->yerel_sayac + 8) * 8;
+        int stack_boyut = (ana_yerel_tepe + 8) * 8;
         stack_boyut = (stack_boyut + 15) & ~15;
         if (stack_boyut < 256) stack_boyut = 256;
         yaz(u, "    subq    $%d, %%rsp", stack_boyut);
+        for (int i = 0; i < ana_yazmac_sayisi; i++) {
+            yaz(u, "    movq    %%%s, -%d(%%rbp)", yazmac_adlari[i], (i + 1) * 8);
+            yaz(u, "    .cfi_offset %%%s, -%d", yazmac_adlari[i], (i + 3) * 8);
+        }
         if (_govde_tamamlandi.veri) metin_ekle(&u->cikti, _govde_tamamlandi.veri);
         metin_serbest(&_govde_tamamlandi);
     }
+    /* Test işlevleri main'in yazmaçlarını kullanmaz */
+    u->yazmac_aday_sayisi = 0;
 
     /* Test fonksiyonlarını üret */
     if (u->test_modu && test_toplam > 0) {
@@ -4466,8 +6085,7 @@ void kod_üret(Üretici *u, Düğüm *program, Arena *arena) {
 
             yaz(u, "    .globl  _test_%d", t);
             yaz(u, "_test_%d:", t);
-            yaz(u, "    pushq   %%rbp");
-            yaz(u, "    movq    %%rsp, %%rbp");
+            islev_giris_yaz(u);
 
             /* Stack boyutu test gövdesi üretildikten sonra belirlenecek */
             Metin _test_prolog = u->cikti;
@@ -4482,6 +6100,7 @@ void kod_üret(Üretici *u, Düğüm *program, Arena *arena) {
             Kapsam *onceki_kapsam2 = u->kapsam;
             u->kapsam = kapsam_oluştur(u->arena, onceki_kapsam2);
             if (td->çocuk_sayısı > 0) {
+                dene_slotlari_ayir(u, td->çocuklar[0]);
                 blok_uret(u, td->çocuklar[0]);
             }
             int _test_yerel = u->kapsam->yerel_sayac;
@@ -4489,6 +6108,7 @@ void kod_üret(Üretici *u, Düğüm *program, Arena *arena) {
 
             yaz(u, "    leave");
             yaz(u, "    ret");
+            islev_bitis_yaz(u);
 
             /* Stack boyutunu hesapla ve prolog ile birleştir */
             {
@@ -6,6 +6,27 @@
 #include "metin.h"
 #include "bellek.h"
 
+/* İşlevin dene aralıkları: LSDA çağrı noktası tablosu (.gcc_except_table) */
+#define DENE_MAKS_DERINLIK 64
+typedef struct {
+    int    *araliklar;       /* [başlangıç, bitiş, iniş pisti] etiket üçlüleri */
+    int     sayi;
+    int     kapasite;
+    int     pistler[DENE_MAKS_DERINLIK];  /* açık dene bloklarının pistleri */
+    int     derinlik;
+    int     acik_bas;        /* açık aralığın başlangıç etiketi */
+    int     islev_bas;       /* işlev başı etiketi (LSDA göreli adresleri) */
+    int     yigin_slot;      /* sıradaki dene'nin rsp kayıt slotu */
+} DeneTablosu;
+
+/* Kuyruk çağrısı durumu: mevcut işlev ve öz çağrının atladığı gövde başı */
+typedef struct {
+    Düğüm  *islev;           /* NULL: işlev dışında (ana, test, paralel gövde) */
+    Kapsam *kapsam;          /* parametrelerin kapsamı */
+    int     etiket;          /* gövde başı */
+    int     cerceve;         /* gövde başında çerçeve boyutu: .LF<cerceve> */
+} KuyrukDurumu;
+
 typedef struct {
     Metin   cikti;           /* assembly çıktısı */
     Metin   veri_bolumu;     /* .data / .rodata bölümü */
@@ -36,9 +57,24 @@ typedef struct {
     } dongu_yigini[URETICI_MAKS_DONGU];
     int     dongu_derinligi;
 
+    /* Sınır denetimi eleme: sabit adımlı döngü gövdesinde sayacın aralığı
+     * alt <= sayac <= uzunluk(dizi) - pay; dizi uzunluğu gövdede değişmez */
+    struct {
+        Sembol *sayac;
+        Sembol *dizi;
+        int64_t alt;
+        int64_t pay;
+    } sinir_bilgileri[URETICI_MAKS_DONGU];
+    int     sinir_sayisi;
+
     /* Mevcut işlev bilgisi */
     TipTürü mevcut_islev_donus_tipi;
 
+    /* Yazmaç tahsisi: işlevin sıcak skaler yerelleri r13-r15'te tutulur */
+    #define URETICI_YAZMAC_SAYISI 3
+    char   *yazmac_adaylari[URETICI_YAZMAC_SAYISI];
+    int     yazmac_aday_sayisi;
+
     /* Sınıf metot üretimi */
     char   *mevcut_sinif;          /* metot üretilirken sınıf adı */
 
@@ -62,16 +98,37 @@ typedef struct {
     int     hata_dizi_sinir_uretildi;
     int     hata_bellek_uretildi;
 
-    /* Exception handling (dene/yakala) */
-    int     istisna_bss_uretildi;   /* _istisna_cerceve BSS üretildi mi */
+    /* Vektörleştirme: cpuid ile SIMD düzeyi belirleyici */
+    int     simd_belirle_uretildi;
+
+    /* Exception handling (dene/yakala): mevcut işlevin aralıkları */
+    DeneTablosu dene;
+    int     lsda_sayac;
 
     /* her...icin dongu stack temizligi */
     int     her_icin_temizlik;
 
+    /* Kuyruk çağrıları (döndür f(...)) */
+    KuyrukDurumu kuyruk;
+    int     kuyruk_atla;       /* 1: cagri_uret call yerine çerçeveyi bırakıp atlar; 2: atladı */
+    int     kuyruk_rapor;      /* --kuyruk-rapor */
+    int     vektor_rapor;      /* --vektor-rapor */
+
+    /* `d = ekle(d, x)`: runtime'ın _yerinde sürümüyle üretilecek çağrı */
+    void   *yerinde_cagri;        /* Düğüm* */
+
+    /* Adıyla değer olarak kullanılan işlevlerin .rodata kapanışları */
+    char  **statik_kapanislar;
+    int     statik_kapanis_sayisi;
+    int     statik_kapanis_kapasite;
+
     /* Debug modu (DWARF bilgisi) */
     int     debug_modu;
     const char *kaynak_dosya;
 
+    /* --backend=vm: bytecode optimizasyon istatistiklerini yazdır */
+    int     vm_opt_rapor;
+
     /* Profil modu (-profil bayrağı) */
     int     profil_modu;
     char   *profil_mevcut_islev;  /* profil modu: mevcut işlev adı */
@@ -91,6 +148,14 @@ typedef struct {
     int     generic_ozellestirme_sayisi;
 } Üretici;
 
+/* Kuyruk çağrısı (döndür f(...)) için backend'lerden bağımsız koşullar:
+ * uygunsa NULL, değilse nedeni döner; *oz çağrının mevcut işlevin kendisine
+ * (çerçeve yeniden kullanılabilir) olup olmadığını bildirir. */
+const char *kuyruk_cagri_engeli(Düğüm *islev, Düğüm *cagri, int *oz);
+
+/* --kuyruk-rapor açıksa çevrilemeyen çağrıyı nedeniyle stderr'e yaz */
+void kuyruk_rapor(Üretici *u, Düğüm *cagri, const char *engel);
+
 /* AST'den x86_64 assembly üret */
 void kod_üret(Üretici *u, Düğüm *program, Arena *arena);
 
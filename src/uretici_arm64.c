@@ -68,6 +68,7 @@ static void ifade_üret(Üretici *u, Düğüm *d);
 static void bildirim_uret(Üretici *u, Düğüm *d);
 static void blok_uret(Üretici *u, Düğüm *blok);
 static void islev_uret(Üretici *u, Düğüm *d);
+static void argumanlari_yukle(Üretici *u, Düğüm *d, Sembol *fn);
 
 /* ---- String literal ---- */
 
@@ -371,7 +372,12 @@ static void cagri_uret(Üretici *u, Düğüm *d) {
     }
 
     /* Genel fonksiyon cagrisi — AArch64 ABI: x0-x7 arg, bl cagri */
-    Sembol *fn = sembol_ara(u->kapsam, d->veri.tanimlayici.isim);
+    argumanlari_yukle(u, d, sembol_ara(u->kapsam, d->veri.tanimlayici.isim));
+    yaz(u, "    bl      %s", d->veri.tanimlayici.isim);
+}
+
+/* Argumanlari (eksikse varsayilanlarla) hesaplayip x0-x7'ye yukle */
+static void argumanlari_yukle(Üretici *u, Düğüm *d, Sembol *fn) {
     int verilen_arg = d->çocuk_sayısı;
     int arg_sayisi = verilen_arg;
     if (fn && verilen_arg < fn->param_sayisi && fn->varsayilan_sayisi > 0) {
@@ -394,8 +400,37 @@ static void cagri_uret(Üretici *u, Düğüm *d) {
     for (int i = 0; i < arg_sayisi && i < 8; i++) {
         yaz(u, "    ldr     x%d, [sp], #16", i);  /* pop -> xi */
     }
+}
 
-    yaz(u, "    bl      %s", d->veri.tanimlayici.isim);
+/* döndür f(...): öz çağrıda argumanlar yuklenip cerceve kurulduktan sonraki
+ * etikete, baska islevde cerceve birakilip dogrudan f'ye atlanir.
+ * Uretildiyse 1. */
+static int kuyruk_cagri_uret(Üretici *u, Düğüm *d) {
+    int oz;
+    const char *engel = kuyruk_cagri_engeli(u->kuyruk.islev, d, &oz);
+    Sembol *fn = NULL;
+    if (!engel) {
+        fn = sembol_ara(u->kapsam, d->veri.tanimlayici.isim);
+        if (strcmp(d->veri.tanimlayici.isim, "yazd\xc4\xb1r") == 0 ||
+            strcmp(d->veri.tanimlayici.isim, "uzunluk") == 0 || !fn)
+            engel = "kullanıcı işlevi değil";
+        else if (d->çocuk_sayısı > 8 || fn->param_sayisi > 8)
+            engel = "argümanlar yazmaçlara sığmıyor";
+    }
+    if (engel) {
+        kuyruk_rapor(u, d, engel);
+        return 0;
+    }
+
+    argumanlari_yukle(u, d, fn);
+    yaz(u, "    mov     sp, x29");
+    if (oz) {
+        yaz(u, "    b       .L%d", u->kuyruk.etiket);
+    } else {
+        yaz(u, "    ldp     x29, x30, [sp], #%d", u->kuyruk.cerceve);
+        yaz(u, "    b       %s", d->veri.tanimlayici.isim);
+    }
+    return 1;
 }
 
 /* ---- Ifade üretici ana dispatch ---- */
@@ -698,6 +733,14 @@ static void islev_uret(Üretici *u, Düğüm *d) {
     yaz(u, "    stp     x29, x30, [sp, #-%d]!", frame_boyut);
     yaz(u, "    mov     x29, sp");
 
+    /* Öz kuyruk çağrısı x0-x7 yüklü olarak buraya atlar */
+    KuyrukDurumu onceki_kuyruk = u->kuyruk;
+    u->kuyruk.islev = u->mevcut_sinif ? NULL : d;
+    u->kuyruk.kapsam = u->kapsam;
+    u->kuyruk.etiket = yeni_etiket(u);
+    u->kuyruk.cerceve = frame_boyut;
+    yaz(u, ".L%d:", u->kuyruk.etiket);
+
     /* Parametreleri stack'e kopyala: x0-x7 */
     if (d->çocuk_sayısı > 0) {
         Düğüm *params = d->çocuklar[0];
@@ -783,6 +826,7 @@ static void islev_uret(Üretici *u, Düğüm *d) {
 
     u->kapsam = onceki;
     u->mevcut_islev_donus_tipi = onceki_donus;
+    u->kuyruk = onceki_kuyruk;
 }
 
 /* ---- Blok ve bildirim ---- */
@@ -821,12 +865,20 @@ static void bildirim_uret(Üretici *u, Düğüm *d) {
         iken_uret(u, d);
         break;
     case DÜĞÜM_DÖNDÜR:
+        if (d->çocuk_sayısı == 1 && d->çocuklar[0]->tur == DÜĞÜM_ÇAĞRI &&
+            d->çocuklar[0]->veri.tanimlayici.isim && kuyruk_cagri_uret(u, d->çocuklar[0])) {
+            break;
+        }
         if (d->çocuk_sayısı == 1) {
             ifade_üret(u, d->çocuklar[0]);
         }
-        /* Fonksiyon epilogu caller tarafindan eklenmeli.
-           Burada basit ret kullan. */
-        yaz(u, "    ldp     x29, x30, [sp], #0");  /* placeholder */
+        if (u->kuyruk.cerceve > 0) {
+            /* İşlev içinde: çerçeveyi bırak */
+            yaz(u, "    mov     sp, x29");
+            yaz(u, "    ldp     x29, x30, [sp], #%d", u->kuyruk.cerceve);
+        } else {
+            yaz(u, "    ldp     x29, x30, [sp], #0");  /* placeholder */
+        }
         yaz(u, "    ret");
         break;
     case DÜĞÜM_KIR:
@@ -863,7 +915,8 @@ void kod_uret_arm64(Üretici *u, Düğüm *program, Arena *arena) {
     u->hata_bolme_sifir_uretildi = 0;
     u->hata_dizi_sinir_uretildi = 0;
     u->hata_bellek_uretildi = 0;
-    u->istisna_bss_uretildi = 0;
+    memset(&u->dene, 0, sizeof(u->dene));
+    memset(&u->kuyruk, 0, sizeof(u->kuyruk));
     metin_baslat(&u->cikti);
     metin_baslat(&u->veri_bolumu);
     metin_baslat(&u->bss_bolumu);
@@ -41,7 +41,7 @@ typedef struct {
     int       kod_kapasite;
 
     /* Sabit havuzu */
-    SmDeger  *sabitler;
+    SmSabit  *sabitler;
     int       sabit_sayisi;
     int       sabit_kapasite;
 
@@ -61,6 +61,8 @@ typedef struct {
 
     /* Fonksiyon derleme durumu */
     int       fonksiyon_icinde;
+    Düğüm    *mevcut_islev;      /* öz kuyruk çağrısı tespiti */
+    int       mevcut_fn;
 
     /* Döngü break/continue hedefleri */
     int       dongu_kir_yamalari[64];
@@ -70,6 +72,8 @@ typedef struct {
     /* Çıktı dosya adı */
     const char *cikti_dosya;
 
+    Üretici  *u;                 /* --kuyruk-rapor */
+
     Arena    *arena;
 } VmUretici;
 
@@ -115,7 +119,7 @@ static int vm_sabit_tam(VmUretici *v, int64_t deger) {
     }
     if (v->sabit_sayisi >= v->sabit_kapasite) {
         v->sabit_kapasite *= 2;
-        v->sabitler = realloc(v->sabitler, v->sabit_kapasite * sizeof(SmDeger));
+        v->sabitler = realloc(v->sabitler, v->sabit_kapasite * sizeof(SmSabit));
     }
     int idx = v->sabit_sayisi++;
     v->sabitler[idx].tur = DEGER_TAM;
@@ -131,7 +135,7 @@ static int vm_sabit_ondalik(VmUretici *v, double deger) {
     }
     if (v->sabit_sayisi >= v->sabit_kapasite) {
         v->sabit_kapasite *= 2;
-        v->sabitler = realloc(v->sabitler, v->sabit_kapasite * sizeof(SmDeger));
+        v->sabitler = realloc(v->sabitler, v->sabit_kapasite * sizeof(SmSabit));
     }
     int idx = v->sabit_sayisi++;
     v->sabitler[idx].tur = DEGER_ONDALIK;
@@ -149,7 +153,7 @@ static int vm_sabit_metin(VmUretici *v, const char *ptr, int64_t uzunluk) {
     }
     if (v->sabit_sayisi >= v->sabit_kapasite) {
         v->sabit_kapasite *= 2;
-        v->sabitler = realloc(v->sabitler, v->sabit_kapasite * sizeof(SmDeger));
+        v->sabitler = realloc(v->sabitler, v->sabit_kapasite * sizeof(SmSabit));
     }
     int idx = v->sabit_sayisi++;
     v->sabitler[idx].tur = DEGER_METIN;
@@ -213,6 +217,53 @@ static void vm_atla_yamala(VmUretici *v, int ofset, int16_t hedef) {
     YAZ_U16(v->kod + ofset, (uint16_t)hedef);
 }
 
+/* ═══════════════════════════════════════════════════════════════════
+ *  BİRLEŞİK KOMUT YARDIMCILARI
+ * ═══════════════════════════════════════════════════════════════════ */
+
+/* İkili işlemin her iki işleneni de tam sayı gibi mi işleniyor? */
+static int vm_tam_islem_mi(Düğüm *d) {
+    for (int i = 0; i < 2; i++) {
+        if (d->çocuklar[i]->sonuç_tipi == TİP_ONDALIK ||
+            d->çocuklar[i]->sonuç_tipi == TİP_METİN)
+            return 0;
+    }
+    return 1;
+}
+
+/* İfade çağrı içermiyorsa değişken yazamaz; sıralaması değiştirilebilir */
+static int vm_yan_etkisiz(Düğüm *d) {
+    if (!d) return 1;
+    if (d->tur == DÜĞÜM_ÇAĞRI) return 0;
+    for (int i = 0; i < d->çocuk_sayısı; i++) {
+        if (!vm_yan_etkisiz(d->çocuklar[i])) return 0;
+    }
+    return 1;
+}
+
+/* Tanımlayıcıyı çöz: yerel ise SM_*_YEREL, genel ise SM_*_GENEL kullanılır */
+static int vm_degisken_coz(VmUretici *v, Düğüm *d, int *genel_mi) {
+    if (!d || d->tur != DÜĞÜM_TANIMLAYICI || !d->veri.tanimlayici.isim) return -1;
+    int idx = vm_yerel_bul(v, d->veri.tanimlayici.isim);
+    if (idx >= 0) { *genel_mi = 0; return idx; }
+    idx = vm_genel_bul(v, d->veri.tanimlayici.isim);
+    if (idx >= 0) { *genel_mi = 1; return idx; }
+    return -1;
+}
+
+/* Karşılaştırma sözcüğüne karşılık gelen "karşılaştır ve yanlışsa atla" komutu */
+static int vm_karsilastir_atla_komutu(SözcükTürü op) {
+    switch (op) {
+    case TOK_EŞİT_EŞİT:  return SM_ESIT_ATLA_YANLIS;
+    case TOK_EŞİT_DEĞİL: return SM_ESIT_DEGIL_ATLA_YANLIS;
+    case TOK_KÜÇÜK:      return SM_KUCUK_ATLA_YANLIS;
+    case TOK_BÜYÜK:      return SM_BUYUK_ATLA_YANLIS;
+    case TOK_KÜÇÜK_EŞİT: return SM_KUCUK_ESIT_ATLA_YANLIS;
+    case TOK_BÜYÜK_EŞİT: return SM_BUYUK_ESIT_ATLA_YANLIS;
+    default:             return -1;
+    }
+}
+
 /* ═══════════════════════════════════════════════════════════════════
  *  İLERİ BİLDİRİMLER
  * ═══════════════════════════════════════════════════════════════════ */
@@ -220,6 +271,7 @@ static void vm_atla_yamala(VmUretici *v, int ofset, int16_t hedef) {
 static void vm_ifade_uret(VmUretici *v, Düğüm *d);
 static void vm_bildirim_uret(VmUretici *v, Düğüm *d);
 static void vm_blok_uret(VmUretici *v, Düğüm *blok);
+static int vm_kosul_atla_uret(VmUretici *v, Düğüm *kosul);
 
 /* ═══════════════════════════════════════════════════════════════════
  *  ESCAPE SEQUENCE İŞLEME
@@ -405,6 +457,23 @@ static void vm_ifade_uret(VmUretici *v, Düğüm *d) {
             break;
         }
 
+        /* Tam toplamada işlenenlerden biri değişkense SM_TOPLA_YEREL/GENEL.
+         * Sol değişken ancak sağ taraf yan etkisizse sona bırakılabilir. */
+        if (op == TOK_ARTI && vm_tam_islem_mi(d)) {
+            int genel_mi = 0;
+            int idx = vm_degisken_coz(v, d->çocuklar[1], &genel_mi);
+            Düğüm *diger = d->çocuklar[0];
+            if (idx < 0 && vm_yan_etkisiz(d->çocuklar[1])) {
+                idx = vm_degisken_coz(v, d->çocuklar[0], &genel_mi);
+                diger = d->çocuklar[1];
+            }
+            if (idx >= 0) {
+                vm_ifade_uret(v, diger);
+                vm_komut_u16(v, genel_mi ? SM_TOPLA_GENEL : SM_TOPLA_YEREL, (uint16_t)idx);
+                break;
+            }
+        }
+
         /* Normal ikili işlem */
         vm_ifade_uret(v, d->çocuklar[0]);
         vm_ifade_uret(v, d->çocuklar[1]);
@@ -520,8 +589,12 @@ static void vm_ifade_uret(VmUretici *v, Düğüm *d) {
             for (int i = 0; i < d->çocuk_sayısı; i++) {
                 vm_ifade_uret(v, d->çocuklar[i]);
             }
-            vm_komut_u16(v, SM_CAGRI, (uint16_t)fn_idx);
-            vm_bayt_yaz(v, (uint8_t)arg_sayisi);
+            if (arg_sayisi == v->fonksiyonlar[fn_idx].param_sayisi) {
+                vm_komut_u16(v, SM_CAGRI_SABIT, (uint16_t)fn_idx);
+            } else {
+                vm_komut_u16(v, SM_CAGRI, (uint16_t)fn_idx);
+                vm_bayt_yaz(v, (uint8_t)arg_sayisi);
+            }
             break;
         }
 
@@ -540,6 +613,34 @@ static void vm_ifade_uret(VmUretici *v, Düğüm *d) {
  *  BİLDİRİM ÜRETİMİ
  * ═══════════════════════════════════════════════════════════════════ */
 
+/* döndür f(...) öz çağrısı: argümanlar parametre yerellerine yazılıp
+ * işlev başına atlanır, çağrı çerçevesi açılmaz. Başka işleve atlama için
+ * çerçeve değiştiren bir komut gerekir (.trbc biçimi değişmesin diye yok);
+ * o çağrılar normal kalır. Üretildiyse 1. */
+static int vm_kuyruk_cagri_uret(VmUretici *v, Düğüm *d) {
+    int oz;
+    const char *engel = kuyruk_cagri_engeli(v->mevcut_islev, d, &oz);
+    if (!engel && !oz) engel = "VM'de yalnızca öz çağrı atlamaya çevrilir";
+    if (!engel && d->çocuk_sayısı != v->fonksiyonlar[v->mevcut_fn].param_sayisi)
+        engel = "eksik argüman (varsayılan değer)";
+    if (engel) {
+        kuyruk_rapor(v->u, d, engel);
+        return 0;
+    }
+
+    /* Tüm argümanlar hesaplandıktan sonra parametrelere yaz */
+    for (int i = 0; i < d->çocuk_sayısı; i++) {
+        vm_ifade_uret(v, d->çocuklar[i]);
+    }
+    for (int i = d->çocuk_sayısı - 1; i >= 0; i--) {
+        vm_komut_u16(v, SM_KAYDET_YEREL, (uint16_t)i);
+    }
+    vm_komut(v, SM_ATLA);
+    int16_t ofset = (int16_t)(v->fonksiyonlar[v->mevcut_fn].kod_baslangic - v->kod_uzunluk - 2);
+    vm_i16_yaz(v, ofset);
+    return 1;
+}
+
 static void vm_bildirim_uret(VmUretici *v, Düğüm *d) {
     if (!d) return;
 
@@ -573,6 +674,26 @@ static void vm_bildirim_uret(VmUretici *v, Düğüm *d) {
         const char *isim = d->veri.tanimlayici.isim;
         if (!isim || d->çocuk_sayısı < 1) break;
 
+        /* x = x + k / x = x - k (k küçük tam sabit) → SM_ARTIR_YEREL/GENEL */
+        Düğüm *deger = d->çocuklar[0];
+        if (deger->tur == DÜĞÜM_İKİLİ_İŞLEM && deger->çocuk_sayısı == 2 &&
+            (deger->veri.islem.islem == TOK_ARTI || deger->veri.islem.islem == TOK_EKSI) &&
+            vm_tam_islem_mi(deger) &&
+            deger->çocuklar[0]->tur == DÜĞÜM_TANIMLAYICI &&
+            deger->çocuklar[0]->veri.tanimlayici.isim &&
+            strcmp(deger->çocuklar[0]->veri.tanimlayici.isim, isim) == 0 &&
+            deger->çocuklar[1]->tur == DÜĞÜM_TAM_SAYI) {
+            int64_t artis = deger->çocuklar[1]->veri.tam_deger;
+            if (deger->veri.islem.islem == TOK_EKSI) artis = -artis;
+            int genel_mi = 0;
+            int idx = vm_degisken_coz(v, deger->çocuklar[0], &genel_mi);
+            if (idx >= 0 && artis >= INT16_MIN && artis <= INT16_MAX) {
+                vm_komut_u16(v, genel_mi ? SM_ARTIR_GENEL : SM_ARTIR_YEREL, (uint16_t)idx);
+                vm_i16_yaz(v, (int16_t)artis);
+                break;
+            }
+        }
+
         vm_ifade_uret(v, d->çocuklar[0]);
 
         int yerel = vm_yerel_bul(v, isim);
@@ -617,10 +738,7 @@ static void vm_bildirim_uret(VmUretici *v, Düğüm *d) {
         /* çocuklar[0]=koşul, çocuklar[1]=doğru blok, çocuklar[2]=yanlış blok (opsiyonel) */
         if (d->çocuk_sayısı < 2) break;
 
-        vm_ifade_uret(v, d->çocuklar[0]);
-        vm_komut(v, SM_ATLA_YANLIS);
-        int yanlis_yamala = v->kod_uzunluk;
-        vm_i16_yaz(v, 0);
+        int yanlis_yamala = vm_kosul_atla_uret(v, d->çocuklar[0]);
 
         /* Doğru bloğu */
         vm_blok_uret(v, d->çocuklar[1]);
@@ -657,10 +775,7 @@ static void vm_bildirim_uret(VmUretici *v, Düğüm *d) {
         int dongu_bas = v->kod_uzunluk;
         v->dongu_devam_hedefi = dongu_bas;
 
-        vm_ifade_uret(v, d->çocuklar[0]);
-        vm_komut(v, SM_ATLA_YANLIS);
-        int cikis_yamala = v->kod_uzunluk;
-        vm_i16_yaz(v, 0);
+        int cikis_yamala = vm_kosul_atla_uret(v, d->çocuklar[0]);
 
         vm_blok_uret(v, d->çocuklar[1]);
 
@@ -701,6 +816,10 @@ static void vm_bildirim_uret(VmUretici *v, Düğüm *d) {
     }
 
     case DÜĞÜM_DÖNDÜR: {
+        if (d->çocuk_sayısı == 1 && d->çocuklar[0]->tur == DÜĞÜM_ÇAĞRI &&
+            d->çocuklar[0]->veri.tanimlayici.isim && vm_kuyruk_cagri_uret(v, d->çocuklar[0])) {
+            break;
+        }
         if (d->çocuk_sayısı > 0) {
             vm_ifade_uret(v, d->çocuklar[0]);
             vm_komut(v, SM_DONDUR_DEGER);
@@ -737,6 +856,15 @@ static void vm_bildirim_uret(VmUretici *v, Düğüm *d) {
         }
         v->fonksiyonlar[fn_idx].param_sayisi = param_sayisi;
 
+        /* @harici: gövdesiz giriş; gömülü kullanımda ana program bağlar
+         * (trsm_harici_kaydet), bağlanmamışsa çağrı 0 döndürür */
+        if (d->veri.islev.dekorator && strcmp(d->veri.islev.dekorator, "harici") == 0) {
+            v->fonksiyonlar[fn_idx].yerel_sayisi = 0;
+            v->fonksiyonlar[fn_idx].kod_baslangic = 0;
+            v->fonksiyonlar[fn_idx].kod_uzunluk = 0;
+            break;
+        }
+
         /* Ana bytecode akışına atlama: fonksiyon gövdesi inline derlenecek */
         vm_komut(v, SM_ATLA);
         int atla_yamala = v->kod_uzunluk;
@@ -748,8 +876,12 @@ static void vm_bildirim_uret(VmUretici *v, Düğüm *d) {
         /* Yerel durum kaydet */
         int onceki_yerel_sayisi = v->yerel_sayisi;
         int onceki_fonksiyon_icinde = v->fonksiyon_icinde;
+        Düğüm *onceki_islev = v->mevcut_islev;
+        int onceki_fn = v->mevcut_fn;
         v->yerel_sayisi = 0;
         v->fonksiyon_icinde = 1;
+        v->mevcut_islev = d;
+        v->mevcut_fn = fn_idx;
 
         /* Parametreleri yerel olarak kaydet */
         for (int i = 0; i < param_sayisi; i++) {
@@ -772,6 +904,8 @@ static void vm_bildirim_uret(VmUretici *v, Düğüm *d) {
         /* Yerel durum geri yükle */
         v->yerel_sayisi = onceki_yerel_sayisi;
         v->fonksiyon_icinde = onceki_fonksiyon_icinde;
+        v->mevcut_islev = onceki_islev;
+        v->mevcut_fn = onceki_fn;
 
         /* Atlama hedefini düzelt */
         int16_t atla_ofset = (int16_t)(v->kod_uzunluk - atla_yamala - 2);
@@ -792,6 +926,28 @@ static void vm_bildirim_uret(VmUretici *v, Düğüm *d) {
     }
 }
 
+/* Koşulu üret ve yanlışsa atla; yamalanacak ofsetin konumunu döndürür.
+ * Tam karşılaştırmalar tek bir birleşik komuta indirilir. */
+static int vm_kosul_atla_uret(VmUretici *v, Düğüm *kosul) {
+    int komut = -1;
+    if (kosul->tur == DÜĞÜM_İKİLİ_İŞLEM && kosul->çocuk_sayısı == 2 &&
+        vm_tam_islem_mi(kosul)) {
+        komut = vm_karsilastir_atla_komutu(kosul->veri.islem.islem);
+    }
+
+    if (komut >= 0) {
+        vm_ifade_uret(v, kosul->çocuklar[0]);
+        vm_ifade_uret(v, kosul->çocuklar[1]);
+        vm_komut(v, (uint8_t)komut);
+    } else {
+        vm_ifade_uret(v, kosul);
+        vm_komut(v, SM_ATLA_YANLIS);
+    }
+    int yamala = v->kod_uzunluk;
+    vm_i16_yaz(v, 0); /* sonra düzelt */
+    return yamala;
+}
+
 /* Blok üretimi */
 static void vm_blok_uret(VmUretici *v, Düğüm *blok) {
     if (!blok) return;
@@ -800,84 +956,800 @@ static void vm_blok_uret(VmUretici *v, Düğüm *blok) {
     }
 }
 
+/* ═══════════════════════════════════════════════════════════════════
+ *  BYTECODE OPTİMİZASYONU
+ * ═══════════════════════════════════════════════════════════════════ */
+
+/*
+ * Dosyaya yazmadan önce bytecode komut listesine açılır ve sabit noktaya
+ * kadar sadeleştirilir: atlama zincirleri, gözetleme deliği kalıpları,
+ * sabit katlama, ölü kayıtlar ve ulaşılamayan kod. Dönüşümlerin hepsi
+ * kodu kısaltır ya da aynı boyda bırakır; bu yüzden özgün ofsetlerle
+ * i16'ya sığan bir atlama yeniden kodlamadan sonra da sığar.
+ */
+
+#define VM_SILINDI      SM_KOMUT_SAYISI
+#define VM_ZINCIR_SINIR 16
+
+typedef struct {
+    uint8_t  op;
+    uint16_t a;         /* sabit / değişken / fonksiyon indeksi */
+    int16_t  b;         /* SM_ARTIR_*: artış, SM_CAGRI: argüman sayısı */
+    int      hedef;     /* atlamalarda hedef komutun indeksi */
+    int      ofset;     /* özgün bayt ofseti (i16 sınırı için) */
+} VmKomut;
+
+typedef struct {
+    VmKomut *k;
+    int      sayi;
+    uint8_t *hedef_mi;  /* atlama hedefi ya da giriş noktası */
+    int     *fn_bas;    /* fonksiyon aralıkları, komut indeksi (son hariç) */
+    int     *fn_son;
+
+    /* --vm-opt-rapor */
+    int      zincir;
+    int      gozetleme;
+    int      katlama;
+    int      olu_kayit;
+    int      olu_kod;
+} VmOptimize;
+
+static int vm_opt_sonraki(VmOptimize *o, int i) {
+    for (i++; i < o->sayi && o->k[i].op == VM_SILINDI; i++) {}
+    return i;
+}
+
+/* i ya da ondan sonraki ilk canlı komut */
+static int vm_opt_canli(VmOptimize *o, int i) {
+    while (i < o->sayi && o->k[i].op == VM_SILINDI) i++;
+    return i;
+}
+
+/* `i` konumundaki 3 baytlık atlama `h`ye özgün ofsetlerle i16 içinde mi? */
+static int vm_opt_sigar(VmOptimize *o, int i, int h) {
+    int h_ofset = h < o->sayi ? o->k[h].ofset : o->k[o->sayi - 1].ofset + 1;
+    int fark = h_ofset - (o->k[i].ofset + 3);
+    return fark >= INT16_MIN && fark <= INT16_MAX;
+}
+
+static void vm_opt_atlama_yap(VmOptimize *o, int i, uint8_t op, int hedef) {
+    o->k[i].op = op;
+    o->k[i].hedef = hedef;
+}
+
+static void vm_opt_hedefleri_isaretle(VmOptimize *o, VmUretici *v) {
+    memset(o->hedef_mi, 0, o->sayi + 1);
+    o->hedef_mi[0] = 1;
+    for (int f = 0; f < v->fonksiyon_sayisi; f++)
+        if (o->fn_son[f] > o->fn_bas[f]) o->hedef_mi[o->fn_bas[f]] = 1;
+    for (int i = 0; i < o->sayi; i++)
+        if (o->k[i].op != VM_SILINDI && sm_komut_atlama_mi(o->k[i].op))
+            o->hedef_mi[vm_opt_canli(o, o->k[i].hedef)] = 1;
+}
+
+static int vm_opt_coz(VmOptimize *o, VmUretici *v) {
+    int *indeks = malloc((v->kod_uzunluk + 1) * sizeof(int));
+    o->k = malloc((v->kod_uzunluk + 1) * sizeof(VmKomut));
+    o->sayi = 0;
+    for (int p = 0; p < v->kod_uzunluk; ) {
+        uint8_t op = v->kod[p];
+        int boy = sm_komut_boyu(op);
+        if (boy == 0 || p + boy > v->kod_uzunluk) {
+            free(indeks);
+            return -1;
+        }
+        VmKomut *k = &o->k[o->sayi];
+        memset(k, 0, sizeof(*k));
+        k->op = op;
+        k->ofset = p;
+        k->hedef = -1;
+        if (boy >= 3) k->a = OKU_U16(v->kod + p + 1);
+        if (op == SM_CAGRI) k->b = v->kod[p + 3];
+        if (op == SM_ARTIR_YEREL || op == SM_ARTIR_GENEL) k->b = OKU_I16(v->kod + p + 3);
+        indeks[p] = o->sayi++;
+        for (int j = 1; j < boy; j++) indeks[p + j] = -1;
+        p += boy;
+    }
+    indeks[v->kod_uzunluk] = o->sayi;
+
+    for (int i = 0; i < o->sayi; i++) {
+        VmKomut *k = &o->k[i];
+        if (!sm_komut_atlama_mi(k->op)) continue;
+        int hedef = k->ofset + 3 + (int16_t)k->a;
+        if (hedef < 0 || hedef >= v->kod_uzunluk || indeks[hedef] < 0) {
+            free(indeks);
+            return -1;
+        }
+        k->hedef = indeks[hedef];
+    }
+
+    o->fn_bas = malloc((v->fonksiyon_sayisi + 1) * sizeof(int));
+    o->fn_son = malloc((v->fonksiyon_sayisi + 1) * sizeof(int));
+    for (int f = 0; f < v->fonksiyon_sayisi; f++) {
+        SmFonksiyon *fn = &v->fonksiyonlar[f];
+        int bas = fn->kod_baslangic, son = bas + fn->kod_uzunluk;
+        if (fn->kod_uzunluk <= 0) {
+            o->fn_bas[f] = o->fn_son[f] = 0;
+        } else if (son > v->kod_uzunluk || indeks[bas] < 0 || indeks[son] < 0) {
+            free(indeks);
+            return -1;
+        } else {
+            o->fn_bas[f] = indeks[bas];
+            o->fn_son[f] = indeks[son];
+        }
+    }
+    free(indeks);
+    o->hedef_mi = malloc(o->sayi + 1);
+    return 0;
+}
+
+/* Atlama zincirleri: atlamanın atlamaya gitmesi, sonraki komuta atlama,
+ * dönüşe atlama */
+static int vm_opt_zincir(VmOptimize *o) {
+    int degisti = 0;
+    for (int i = 0; i < o->sayi; i++) {
+        VmKomut *k = &o->k[i];
+        if (k->op == VM_SILINDI || !sm_komut_atlama_mi(k->op)) continue;
+
+        int h = vm_opt_canli(o, k->hedef);
+        for (int adim = 0; adim < VM_ZINCIR_SINIR && h < o->sayi &&
+             o->k[h].op == SM_ATLA && h != i; adim++) {
+            int sonraki = vm_opt_canli(o, o->k[h].hedef);
+            if (!vm_opt_sigar(o, i, sonraki)) break;
+            h = sonraki;
+        }
+        if (h != k->hedef) {
+            if (h != vm_opt_canli(o, k->hedef)) { o->zincir++; degisti = 1; }
+            k->hedef = h;
+        }
+
+        if (k->op != SM_ATLA || h >= o->sayi) continue;
+        if (h == vm_opt_sonraki(o, i)) {
+            k->op = VM_SILINDI;
+            o->zincir++;
+            degisti = 1;
+        } else if (o->k[h].op == SM_DONDUR || o->k[h].op == SM_DONDUR_DEGER ||
+                   o->k[h].op == SM_DUR) {
+            k->op = o->k[h].op;
+            o->zincir++;
+            degisti = 1;
+        }
+    }
+    return degisti;
+}
+
+/* Sabitin doğruluğu; sabit değilse -1 */
+static int vm_opt_sabit_dogruluk(VmUretici *v, const VmKomut *k) {
+    switch (k->op) {
+    case SM_DOGRU:         return 1;
+    case SM_YANLIS:        return 0;
+    case SM_BOS:           return 0;
+    case SM_SABIT_TAM:     return v->sabitler[k->a].deger.tam != 0;
+    case SM_SABIT_ONDALIK: return v->sabitler[k->a].deger.ondalik != 0.0;
+    case SM_SABIT_METIN:   return v->sabitler[k->a].deger.metin.uzunluk > 0;
+    default:               return -1;
+    }
+}
+
+static int vm_opt_saf_yukleme_mi(uint8_t op) {
+    return op == SM_SABIT_TAM || op == SM_SABIT_ONDALIK || op == SM_SABIT_METIN ||
+           op == SM_DOGRU || op == SM_YANLIS || op == SM_BOS ||
+           op == SM_YUKLE_YEREL || op == SM_YUKLE_GENEL || op == SM_KOPYALA;
+}
+
+/* Hata veremeyen işlemler: sonucu atılıyorsa işlenenler de atılabilir */
+static int vm_opt_saf_tekli_mi(uint8_t op) {
+    return op == SM_EKSI || op == SM_EKSI_OND || op == SM_DEGIL ||
+           op == SM_TAM_ONDALIK || op == SM_ONDALIK_TAM || op == SM_TAM_METIN ||
+           op == SM_TOPLA_YEREL || op == SM_TOPLA_GENEL;
+}
+
+static int vm_opt_saf_ikili_mi(uint8_t op) {
+    return (op >= SM_TOPLA && op <= SM_CARP) ||
+           (op >= SM_TOPLA_OND && op <= SM_CARP_OND) ||
+           (op >= SM_ESIT && op <= SM_BUYUK_ESIT_OND) ||
+           op == SM_VE || op == SM_VEYA;
+}
+
+/* Tam karşılaştırma + ATLA_YANLIS/DOGRU → birleşik karşılaştır-atla */
+static uint8_t vm_opt_birlesik_atlama(uint8_t karsilastirma, uint8_t atlama) {
+    static const uint8_t ters[] = {
+        SM_ESIT_DEGIL, SM_ESIT, SM_BUYUK_ESIT, SM_KUCUK_ESIT, SM_BUYUK, SM_KUCUK,
+    };
+    if (atlama == SM_ATLA_DOGRU) karsilastirma = ters[karsilastirma - SM_ESIT];
+    return (uint8_t)(SM_ESIT_ATLA_YANLIS + (karsilastirma - SM_ESIT));
+}
+
+/* Gözetleme deliği: yan yana komut kalıpları (ara komutlar hedef değilse) */
+static int vm_opt_gozetleme(VmOptimize *o, VmUretici *v) {
+    int degisti = 0;
+    vm_opt_hedefleri_isaretle(o, v);
+    for (int i = 0; i < o->sayi; i++) {
+        VmKomut *a = &o->k[i];
+        if (a->op == VM_SILINDI) continue;
+        int j = vm_opt_sonraki(o, i);
+        if (j >= o->sayi || o->hedef_mi[j]) continue;
+        VmKomut *b = &o->k[j];
+        int l = vm_opt_sonraki(o, j);
+        VmKomut *c = l < o->sayi && !o->hedef_mi[l] ? &o->k[l] : NULL;
+
+        /* itme; CIKAR → (yok) */
+        if (vm_opt_saf_yukleme_mi(a->op) && b->op == SM_CIKAR) {
+            a->op = b->op = VM_SILINDI;
+            goto degisti;
+        }
+
+        /* Sonucu atılan saf işlem: işlenenleri atılır */
+        if (vm_opt_saf_tekli_mi(a->op) && b->op == SM_CIKAR) {
+            a->op = VM_SILINDI;
+            goto degisti;
+        }
+        if (vm_opt_saf_ikili_mi(a->op) && b->op == SM_CIKAR) {
+            a->op = SM_CIKAR;
+            goto degisti;
+        }
+
+        /* Tam karşılaştırma; ATLA_YANLIS/DOGRU → birleşik komut */
+        if (a->op >= SM_ESIT && a->op <= SM_BUYUK_ESIT &&
+            (b->op == SM_ATLA_YANLIS || b->op == SM_ATLA_DOGRU) &&
+            vm_opt_sigar(o, i, b->hedef)) {
+            vm_opt_atlama_yap(o, i, vm_opt_birlesik_atlama(a->op, b->op), b->hedef);
+            b->op = VM_SILINDI;
+            goto degisti;
+        }
+
+        /* YUKLE x; KAYDET x → (yok) */
+        if (((a->op == SM_YUKLE_YEREL && b->op == SM_KAYDET_YEREL) ||
+             (a->op == SM_YUKLE_GENEL && b->op == SM_KAYDET_GENEL)) && a->a == b->a) {
+            a->op = b->op = VM_SILINDI;
+            goto degisti;
+        }
+
+        /* DEGIL; ATLA_YANLIS/DOGRU → ters atlama */
+        if (a->op == SM_DEGIL && (b->op == SM_ATLA_YANLIS || b->op == SM_ATLA_DOGRU) &&
+            vm_opt_sigar(o, i, b->hedef)) {
+            vm_opt_atlama_yap(o, i, b->op == SM_ATLA_YANLIS ? SM_ATLA_DOGRU : SM_ATLA_YANLIS,
+                              b->hedef);
+            b->op = VM_SILINDI;
+            goto degisti;
+        }
+
+        /* sabit; ATLA_YANLIS/DOGRU → ATLA ya da (yok) */
+        int dogru = vm_opt_sabit_dogruluk(v, a);
+        if (dogru >= 0 && (b->op == SM_ATLA_YANLIS || b->op == SM_ATLA_DOGRU)) {
+            int atlar = (b->op == SM_ATLA_DOGRU) == dogru;
+            if (!atlar) {
+                a->op = b->op = VM_SILINDI;
+                goto degisti;
+            }
+            if (vm_opt_sigar(o, i, b->hedef)) {
+                vm_opt_atlama_yap(o, i, SM_ATLA, b->hedef);
+                b->op = VM_SILINDI;
+                goto degisti;
+            }
+        }
+
+        /* Kısa devre: KOPYALA; ATLA_x L; CIKAR, L'de değeri yeniden sınayan
+         * atlama varsa sonucu zaten bilinir → tek atlama */
+        if (a->op == SM_KOPYALA && (b->op == SM_ATLA_YANLIS || b->op == SM_ATLA_DOGRU) &&
+            c && c->op == SM_CIKAR) {
+            int t = vm_opt_canli(o, b->hedef);
+            int yeni = -1;
+            if (t < o->sayi && (o->k[t].op == SM_ATLA_YANLIS || o->k[t].op == SM_ATLA_DOGRU))
+                yeni = o->k[t].op == b->op ? vm_opt_canli(o, o->k[t].hedef)
+                                           : vm_opt_sonraki(o, t);
+            if (yeni >= 0 && vm_opt_sigar(o, i, yeni)) {
+                vm_opt_atlama_yap(o, i, b->op, yeni);
+                b->op = c->op = VM_SILINDI;
+                goto degisti;
+            }
+        }
+
+        /* SABIT k; TOPLA_YEREL x; KAYDET_YEREL x → ARTIR_YEREL x, k */
+        if (a->op == SM_SABIT_TAM && c &&
+            ((b->op == SM_TOPLA_YEREL && c->op == SM_KAYDET_YEREL) ||
+             (b->op == SM_TOPLA_GENEL && c->op == SM_KAYDET_GENEL)) &&
+            b->a == c->a) {
+            int64_t artis = v->sabitler[a->a].deger.tam;
+            if (artis >= INT16_MIN && artis <= INT16_MAX) {
+                a->op = b->op == SM_TOPLA_YEREL ? SM_ARTIR_YEREL : SM_ARTIR_GENEL;
+                a->a = b->a;
+                a->b = (int16_t)artis;
+                b->op = c->op = VM_SILINDI;
+                goto degisti;
+            }
+        }
+        continue;
+
+    degisti:
+        o->gozetleme++;
+        degisti = 1;
+    }
+    return degisti;
+}
+
+/* İki tam sabit üzerinde işlem; katlanamıyorsa 0 */
+static int vm_opt_tam_katla(uint8_t op, int64_t x, int64_t y, int64_t *sonuc) {
+    switch (op) {
+    case SM_TOPLA:      return !__builtin_add_overflow(x, y, sonuc);
+    case SM_CIKAR_SAYI: return !__builtin_sub_overflow(x, y, sonuc);
+    case SM_CARP:       return !__builtin_mul_overflow(x, y, sonuc);
+    case SM_BOL:
+        if (y == 0 || (x == INT64_MIN && y == -1)) return 0;
+        *sonuc = x / y;
+        return 1;
+    case SM_MOD:
+        if (y == 0 || (x == INT64_MIN && y == -1)) return 0;
+        *sonuc = x % y;
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+/* Karşılaştırma (düz ya da birleşik atlama biçimi); değilse -1 */
+static int vm_opt_karsilastir(uint8_t op, double x, double y) {
+    switch (op) {
+    case SM_ESIT: case SM_ESIT_OND: case SM_ESIT_ATLA_YANLIS:           return x == y;
+    case SM_ESIT_DEGIL: case SM_ESIT_DEGIL_ATLA_YANLIS:                 return x != y;
+    case SM_KUCUK: case SM_KUCUK_OND: case SM_KUCUK_ATLA_YANLIS:        return x < y;
+    case SM_BUYUK: case SM_BUYUK_OND: case SM_BUYUK_ATLA_YANLIS:        return x > y;
+    case SM_KUCUK_ESIT: case SM_KUCUK_ESIT_OND:
+    case SM_KUCUK_ESIT_ATLA_YANLIS:                                     return x <= y;
+    case SM_BUYUK_ESIT: case SM_BUYUK_ESIT_OND:
+    case SM_BUYUK_ESIT_ATLA_YANLIS:                                     return x >= y;
+    default:                                                            return -1;
+    }
+}
+
+static int vm_opt_tam_karsilastir(uint8_t op, int64_t x, int64_t y) {
+    switch (op) {
+    case SM_ESIT: case SM_ESIT_ATLA_YANLIS:                 return x == y;
+    case SM_ESIT_DEGIL: case SM_ESIT_DEGIL_ATLA_YANLIS:     return x != y;
+    case SM_KUCUK: case SM_KUCUK_ATLA_YANLIS:               return x < y;
+    case SM_BUYUK: case SM_BUYUK_ATLA_YANLIS:               return x > y;
+    case SM_KUCUK_ESIT: case SM_KUCUK_ESIT_ATLA_YANLIS:     return x <= y;
+    case SM_BUYUK_ESIT: case SM_BUYUK_ESIT_ATLA_YANLIS:     return x >= y;
+    default:                                                return -1;
+    }
+}
+
+/* Sabit katlama: işlenenleri sabit olan tekli ve ikili işlemler */
+static int vm_opt_katla(VmOptimize *o, VmUretici *v) {
+    int degisti = 0;
+    vm_opt_hedefleri_isaretle(o, v);
+    for (int i = 0; i < o->sayi; i++) {
+        VmKomut *a = &o->k[i];
+        if (a->op == VM_SILINDI) continue;
+        int j = vm_opt_sonraki(o, i);
+        if (j >= o->sayi || o->hedef_mi[j]) continue;
+        VmKomut *b = &o->k[j];
+
+        /* Tekli */
+        if (a->op == SM_SABIT_TAM && b->op == SM_EKSI &&
+            v->sabitler[a->a].deger.tam != INT64_MIN) {
+            a->a = (uint16_t)vm_sabit_tam(v, -v->sabitler[a->a].deger.tam);
+            b->op = VM_SILINDI;
+            goto degisti;
+        }
+        if (a->op == SM_SABIT_ONDALIK && b->op == SM_EKSI_OND) {
+            a->a = (uint16_t)vm_sabit_ondalik(v, -v->sabitler[a->a].deger.ondalik);
+            b->op = VM_SILINDI;
+            goto degisti;
+        }
+        if (a->op == SM_SABIT_TAM && b->op == SM_TAM_ONDALIK) {
+            a->op = SM_SABIT_ONDALIK;
+            a->a = (uint16_t)vm_sabit_ondalik(v, (double)v->sabitler[a->a].deger.tam);
+            b->op = VM_SILINDI;
+            goto degisti;
+        }
+        if ((a->op == SM_DOGRU || a->op == SM_YANLIS) && b->op == SM_DEGIL) {
+            a->op = a->op == SM_DOGRU ? SM_YANLIS : SM_DOGRU;
+            b->op = VM_SILINDI;
+            goto degisti;
+        }
+
+        /* İkili: sabit; sabit; işlem */
+        int l = vm_opt_sonraki(o, j);
+        if (l >= o->sayi || o->hedef_mi[l]) continue;
+        VmKomut *c = &o->k[l];
+
+        if (a->op == SM_SABIT_TAM && b->op == SM_SABIT_TAM) {
+            int64_t x = v->sabitler[a->a].deger.tam, y = v->sabitler[b->a].deger.tam;
+            int64_t r;
+            int kars = vm_opt_tam_karsilastir(c->op, x, y);
+            if (vm_opt_tam_katla(c->op, x, y, &r)) {
+                a->a = (uint16_t)vm_sabit_tam(v, r);
+            } else if (kars >= 0 && !sm_komut_atlama_mi(c->op)) {
+                a->op = kars ? SM_DOGRU : SM_YANLIS;
+            } else if (kars >= 0) {
+                /* Birleşik karşılaştır-atla: koşul yanlışsa atlar */
+                if (kars) {
+                    a->op = VM_SILINDI;
+                } else if (vm_opt_sigar(o, i, c->hedef)) {
+                    vm_opt_atlama_yap(o, i, SM_ATLA, c->hedef);
+                } else {
+                    continue;
+                }
+            } else {
+                continue;
+            }
+            b->op = c->op = VM_SILINDI;
+            goto degisti;
+        }
+
+        if (a->op == SM_SABIT_ONDALIK && b->op == SM_SABIT_ONDALIK) {
+            double x = v->sabitler[a->a].deger.ondalik, y = v->sabitler[b->a].deger.ondalik;
+            int kars = vm_opt_karsilastir(c->op, x, y);
+            double r;
+            switch (c->op) {
+            case SM_TOPLA_OND: r = x + y; break;
+            case SM_CIKAR_OND: r = x - y; break;
+            case SM_CARP_OND:  r = x * y; break;
+            case SM_BOL_OND:
+                if (y == 0.0) continue;     /* çalışma anı hatası korunur */
+                r = x / y;
+                break;
+            default:
+                if (kars < 0 || c->op < SM_ESIT_OND || c->op > SM_BUYUK_ESIT_OND) continue;
+                a->op = kars ? SM_DOGRU : SM_YANLIS;
+                b->op = c->op = VM_SILINDI;
+                goto degisti;
+            }
+            a->a = (uint16_t)vm_sabit_ondalik(v, r);
+            b->op = c->op = VM_SILINDI;
+            goto degisti;
+        }
+
+        if (a->op == SM_SABIT_METIN && b->op == SM_SABIT_METIN && c->op == SM_METIN_BIRLESTIR) {
+            SmSabit *x = &v->sabitler[a->a], *y = &v->sabitler[b->a];
+            int64_t uz = x->deger.metin.uzunluk + y->deger.metin.uzunluk;
+            char *birlesik = malloc(uz + 1);
+            memcpy(birlesik, x->deger.metin.ptr, x->deger.metin.uzunluk);
+            memcpy(birlesik + x->deger.metin.uzunluk, y->deger.metin.ptr, y->deger.metin.uzunluk);
+            a->a = (uint16_t)vm_sabit_metin(v, birlesik, uz);
+            free(birlesik);
+            b->op = c->op = VM_SILINDI;
+            goto degisti;
+        }
+        continue;
+
+    degisti:
+        o->katlama++;
+        degisti = 1;
+    }
+    return degisti;
+}
+
+/* Hiç okunmayan değişkene kayıt: değer yalnızca yığından atılır */
+static int vm_opt_olu_kayit(VmOptimize *o, VmUretici *v) {
+    int degisti = 0;
+    uint8_t *okunan = calloc(65536, 1);
+    uint8_t *ust_duzey = malloc(o->sayi + 1);
+    memset(ust_duzey, 1, o->sayi + 1);
+    for (int f = 0; f < v->fonksiyon_sayisi; f++)
+        for (int i = o->fn_bas[f]; i < o->fn_son[f]; i++) ust_duzey[i] = 0;
+
+    /* Globaller: tüm programda okuma (üst düzeyde yereller globaldir) */
+    for (int i = 0; i < o->sayi; i++) {
+        uint8_t op = o->k[i].op;
+        if (op == SM_YUKLE_GENEL || op == SM_TOPLA_GENEL || op == SM_ARTIR_GENEL ||
+            (ust_duzey[i] && (op == SM_YUKLE_YEREL || op == SM_TOPLA_YEREL ||
+                              op == SM_ARTIR_YEREL)))
+            okunan[o->k[i].a] = 1;
+    }
+    for (int i = 0; i < o->sayi; i++) {
+        if (o->k[i].op == SM_KAYDET_GENEL && !okunan[o->k[i].a]) {
+            o->k[i].op = SM_CIKAR;
+            o->olu_kayit++;
+            degisti = 1;
+        }
+    }
+
+    /* Yereller: fonksiyon aralığında okuma (iç içe fonksiyonlar dahil,
+     * bu yalnızca daha fazla kaydı korur) */
+    for (int f = 0; f < v->fonksiyon_sayisi; f++) {
+        memset(okunan, 0, VM_YEREL_KAP);
+        for (int i = o->fn_bas[f]; i < o->fn_son[f]; i++) {
+            uint8_t op = o->k[i].op;
+            if (op == SM_YUKLE_YEREL || op == SM_TOPLA_YEREL || op == SM_ARTIR_YEREL)
+                okunan[o->k[i].a < VM_YEREL_KAP ? o->k[i].a : 0] = 1;
+        }
+        for (int i = o->fn_bas[f]; i < o->fn_son[f]; i++) {
+            VmKomut *k = &o->k[i];
+            if (k->op == SM_KAYDET_YEREL && k->a < VM_YEREL_KAP && !okunan[k->a]) {
+                k->op = SM_CIKAR;
+                o->olu_kayit++;
+                degisti = 1;
+            }
+        }
+    }
+
+    free(ust_duzey);
+    free(okunan);
+    return degisti;
+}
+
+/* Program başından ve fonksiyon girişlerinden ulaşılamayan komutları sil */
+static int vm_opt_olu_kod(VmOptimize *o, VmUretici *v) {
+    uint8_t *ulasilan = calloc(o->sayi + 1, 1);
+    int *liste = malloc((o->sayi + v->fonksiyon_sayisi + 1) * sizeof(int));
+    int n = 0;
+    liste[n++] = vm_opt_canli(o, 0);
+    for (int f = 0; f < v->fonksiyon_sayisi; f++)
+        if (o->fn_son[f] > o->fn_bas[f]) liste[n++] = vm_opt_canli(o, o->fn_bas[f]);
+
+    while (n > 0) {
+        int i = liste[--n];
+        if (i >= o->sayi || ulasilan[i]) continue;
+        ulasilan[i] = 1;
+        uint8_t op = o->k[i].op;
+        if (sm_komut_atlama_mi(op)) liste[n++] = vm_opt_canli(o, o->k[i].hedef);
+        if (op != SM_ATLA && op != SM_DONDUR && op != SM_DONDUR_DEGER && op != SM_DUR)
+            liste[n++] = vm_opt_sonraki(o, i);
+    }
+
+    int degisti = 0;
+    for (int i = 0; i < o->sayi; i++) {
+        if (o->k[i].op != VM_SILINDI && !ulasilan[i]) {
+            o->k[i].op = VM_SILINDI;
+            o->olu_kod++;
+            degisti = 1;
+        }
+    }
+    free(liste);
+    free(ulasilan);
+    return degisti;
+}
+
+/* Komut listesini yeniden kodla; atlamaları ve fonksiyon aralıklarını yamala */
+static int vm_opt_kodla(VmOptimize *o, VmUretici *v) {
+    int *yeni = malloc((o->sayi + 1) * sizeof(int));
+    int uz = 0;
+    for (int i = 0; i < o->sayi; i++) {
+        yeni[i] = uz;
+        if (o->k[i].op != VM_SILINDI) uz += sm_komut_boyu(o->k[i].op);
+    }
+    yeni[o->sayi] = uz;
+    /* Silinen komutun ofseti, ardından gelen ilk canlı komutunkidir */
+    for (int i = o->sayi - 1; i >= 0; i--)
+        if (o->k[i].op == VM_SILINDI) yeni[i] = yeni[i + 1];
+
+    uint8_t *kod = malloc(uz > 0 ? uz : 1);
+    for (int i = 0; i < o->sayi; i++) {
+        VmKomut *k = &o->k[i];
+        if (k->op == VM_SILINDI) continue;
+        uint8_t *p = kod + yeni[i];
+        int boy = sm_komut_boyu(k->op);
+        p[0] = k->op;
+        if (sm_komut_atlama_mi(k->op)) {
+            int fark = yeni[k->hedef] - (yeni[i] + 3);
+            if (fark < INT16_MIN || fark > INT16_MAX) {
+                free(kod);
+                free(yeni);
+                return -1;
+            }
+            YAZ_U16(p + 1, (uint16_t)(int16_t)fark);
+        } else if (boy >= 3) {
+            YAZ_U16(p + 1, k->a);
+        }
+        if (k->op == SM_CAGRI) p[3] = (uint8_t)k->b;
+        if (k->op == SM_ARTIR_YEREL || k->op == SM_ARTIR_GENEL) YAZ_U16(p + 3, (uint16_t)k->b);
+    }
+
+    for (int f = 0; f < v->fonksiyon_sayisi; f++) {
+        if (o->fn_son[f] <= o->fn_bas[f]) continue;
+        v->fonksiyonlar[f].kod_baslangic = yeni[o->fn_bas[f]];
+        v->fonksiyonlar[f].kod_uzunluk = yeni[o->fn_son[f]] - yeni[o->fn_bas[f]];
+    }
+
+    free(v->kod);
+    v->kod = kod;
+    v->kod_uzunluk = uz;
+    v->kod_kapasite = uz > 0 ? uz : 1;
+    free(yeni);
+    return 0;
+}
+
+/* Artık kullanılmayan sabitleri havuzdan at ve indeksleri yenile */
+static void vm_opt_sabitleri_sikistir(VmUretici *v) {
+    int *yeni = malloc((v->sabit_sayisi + 1) * sizeof(int));
+    for (int i = 0; i < v->sabit_sayisi; i++) yeni[i] = -1;
+    for (int p = 0; p < v->kod_uzunluk; p += sm_komut_boyu(v->kod[p])) {
+        uint8_t op = v->kod[p];
+        if (op == SM_SABIT_TAM || op == SM_SABIT_ONDALIK || op == SM_SABIT_METIN)
+            yeni[OKU_U16(v->kod + p + 1)] = 0;
+    }
+    int n = 0;
+    for (int i = 0; i < v->sabit_sayisi; i++) {
+        if (yeni[i] < 0) {
+            if (v->sabitler[i].tur == DEGER_METIN) free(v->sabitler[i].deger.metin.ptr);
+            continue;
+        }
+        yeni[i] = n;
+        v->sabitler[n++] = v->sabitler[i];
+    }
+    v->sabit_sayisi = n;
+    for (int p = 0; p < v->kod_uzunluk; p += sm_komut_boyu(v->kod[p])) {
+        uint8_t op = v->kod[p];
+        if (op == SM_SABIT_TAM || op == SM_SABIT_ONDALIK || op == SM_SABIT_METIN) {
+            uint16_t idx = (uint16_t)yeni[OKU_U16(v->kod + p + 1)];
+            YAZ_U16(v->kod + p + 1, idx);
+        }
+    }
+    free(yeni);
+}
+
+static void vm_optimize_et(VmUretici *v, int rapor) {
+    VmOptimize o;
+    memset(&o, 0, sizeof(o));
+    int eski_uzunluk = v->kod_uzunluk;
+    if (vm_opt_coz(&o, v) != 0) goto bitti;     /* çözülemeyen kod olduğu gibi kalır */
+
+    int eski_sayi = o.sayi;
+    for (int tur = 0; tur < 8; tur++) {
+        int degisti = 0;
+        degisti |= vm_opt_zincir(&o);
+        degisti |= vm_opt_gozetleme(&o, v);
+        degisti |= vm_opt_katla(&o, v);
+        degisti |= vm_opt_olu_kayit(&o, v);
+        degisti |= vm_opt_olu_kod(&o, v);
+        if (!degisti) break;
+    }
+
+    int canli = 0;
+    for (int i = 0; i < o.sayi; i++) canli += o.k[i].op != VM_SILINDI;
+    if (vm_opt_kodla(&o, v) != 0) goto bitti;
+    vm_opt_sabitleri_sikistir(v);
+
+    if (rapor) {
+        fprintf(stderr, "vm-opt: %d komut -> %d komut (%%%.1f azalma), %d -> %d bayt\n",
+                eski_sayi, canli,
+                eski_sayi ? 100.0 * (eski_sayi - canli) / eski_sayi : 0.0,
+                eski_uzunluk, v->kod_uzunluk);
+        fprintf(stderr, "  atlama zinciri    %d\n", o.zincir);
+        fprintf(stderr, "  gözetleme deliği  %d\n", o.gozetleme);
+        fprintf(stderr, "  sabit katlama     %d\n", o.katlama);
+        fprintf(stderr, "  ölü kayıt         %d\n", o.olu_kayit);
+        fprintf(stderr, "  ulaşılamaz kod    %d\n", o.olu_kod);
+    }
+
+bitti:
+    free(o.k);
+    free(o.hedef_mi);
+    free(o.fn_bas);
+    free(o.fn_son);
+}
+
 /* ═══════════════════════════════════════════════════════════════════
  *  BYTECODE DOSYA YAZMA
  * ═══════════════════════════════════════════════════════════════════ */
 
-static int vm_dosya_yaz(VmUretici *v, const char *dosya_adi) {
-    FILE *f = fopen(dosya_adi, "wb");
-    if (!f) {
-        fprintf(stderr, "Hata: '%s' dosyası açılamadı\n", dosya_adi);
-        return -1;
+/* Dosya görüntüsü bellekte kurulur; bölüm ofsetleri ve sağlama için */
+typedef struct {
+    uint8_t *veri;
+    size_t   uzunluk;
+    size_t   kapasite;
+} TrbcTampon;
+
+static void tampon_ekle(TrbcTampon *t, const void *veri, size_t boy) {
+    if (t->uzunluk + boy > t->kapasite) {
+        size_t yeni = t->kapasite ? t->kapasite : 4096;
+        while (yeni < t->uzunluk + boy) yeni *= 2;
+        t->veri = realloc(t->veri, yeni);
+        t->kapasite = yeni;
     }
+    memcpy(t->veri + t->uzunluk, veri, boy);
+    t->uzunluk += boy;
+}
 
-    /* Başlık */
-    uint32_t sihirli = TRBC_SIHIRLI;
-    fwrite(&sihirli, 4, 1, f);
-    uint16_t versiyon = TRBC_VERSIYON;
-    fwrite(&versiyon, 2, 1, f);
-    uint16_t bayraklar = 0;
-    fwrite(&bayraklar, 2, 1, f);
+/* Sıfırlarla TRBC_HIZA katına tamamla; bölüm başlangıcını döndür */
+static uint32_t tampon_hizala(TrbcTampon *t) {
+    static const uint8_t sifir[TRBC_HIZA] = {0};
+    size_t eksik = (TRBC_HIZA - t->uzunluk % TRBC_HIZA) % TRBC_HIZA;
+    tampon_ekle(t, sifir, eksik);
+    return (uint32_t)t->uzunluk;
+}
 
-    /* Sabit havuzu */
-    uint32_t sabit_sayisi = (uint32_t)v->sabit_sayisi;
-    fwrite(&sabit_sayisi, 4, 1, f);
+static int vm_dosya_yaz(VmUretici *v, const char *dosya_adi) {
+    TrbcTampon t = {0};
+    TrbcBaslik b;
+    memset(&b, 0, sizeof(b));
+    tampon_ekle(&t, &b, sizeof(b));    /* sonda doldurulur */
+
+    /* Nesne bölümü: metinler ve 48 bite sığmayan tamlar, kalıcı görüntüler */
+    SmDeger *sabitler = malloc((v->sabit_sayisi ? v->sabit_sayisi : 1) * sizeof(SmDeger));
+    b.nesne_ofset = tampon_hizala(&t);
     for (int i = 0; i < v->sabit_sayisi; i++) {
-        SmDeger *s = &v->sabitler[i];
+        SmSabit *s = &v->sabitler[i];
+        uint64_t ofset = t.uzunluk - b.nesne_ofset;
         switch (s->tur) {
-        case DEGER_TAM: {
-            uint8_t tip = SABIT_TIP_TAM;
-            fwrite(&tip, 1, 1, f);
-            fwrite(&s->deger.tam, 8, 1, f);
+        case DEGER_TAM:
+            if (s->deger.tam >= SM_TAM_KISA_MIN && s->deger.tam <= SM_TAM_KISA_MAKS) {
+                sabitler[i] = sm_tam_kisa(s->deger.tam);
+            } else {
+                SmKutuTam k = { { SM_KALICI, DEGER_TAM }, s->deger.tam };
+                tampon_ekle(&t, &k, sizeof(k));
+                sabitler[i] = SM_ETIKET_NESNE | ofset;
+            }
             break;
-        }
-        case DEGER_ONDALIK: {
-            uint8_t tip = SABIT_TIP_ONDALIK;
-            fwrite(&tip, 1, 1, f);
-            fwrite(&s->deger.ondalik, 8, 1, f);
+        case DEGER_ONDALIK:
+            sabitler[i] = sm_ondalik(s->deger.ondalik);
             break;
-        }
         case DEGER_METIN: {
-            uint8_t tip = SABIT_TIP_METIN;
-            fwrite(&tip, 1, 1, f);
-            uint32_t uzunluk = (uint32_t)s->deger.metin.uzunluk;
-            fwrite(&uzunluk, 4, 1, f);
-            fwrite(s->deger.metin.ptr, 1, uzunluk, f);
+            SmMetin m = { { SM_KALICI, DEGER_METIN }, s->deger.metin.uzunluk };
+            tampon_ekle(&t, &m, sizeof(m));
+            tampon_ekle(&t, s->deger.metin.ptr, (size_t)s->deger.metin.uzunluk);
+            tampon_ekle(&t, "", 1);
+            tampon_hizala(&t);
+            sabitler[i] = SM_ETIKET_NESNE | ofset;
             break;
         }
+        case DEGER_MANTIK:
+            sabitler[i] = sm_mantik(s->deger.mantik);
+            break;
         default:
+            sabitler[i] = SM_BOS_DEGER;
             break;
         }
     }
+    b.nesne_boyu = (uint32_t)(t.uzunluk - b.nesne_ofset);
+
+    b.sabit_sayisi = (uint32_t)v->sabit_sayisi;
+    b.sabit_ofset = tampon_hizala(&t);
+    tampon_ekle(&t, sabitler, (size_t)v->sabit_sayisi * sizeof(SmDeger));
+    free(sabitler);
+
+    /* İsimler */
+    uint32_t *isim_ofsetleri = malloc((v->fonksiyon_sayisi ? v->fonksiyon_sayisi : 1) * sizeof(uint32_t));
+    b.isim_ofset = tampon_hizala(&t);
+    for (int i = 0; i < v->fonksiyon_sayisi; i++) {
+        const char *isim = v->fonksiyonlar[i].isim;
+        isim_ofsetleri[i] = isim ? (uint32_t)(t.uzunluk - b.isim_ofset) : TRBC_ISIMSIZ;
+        if (isim) tampon_ekle(&t, isim, strlen(isim) + 1);
+    }
+    b.isim_boyu = (uint32_t)(t.uzunluk - b.isim_ofset);
 
     /* Fonksiyon tablosu */
-    uint32_t fonk_sayisi = (uint32_t)v->fonksiyon_sayisi;
-    fwrite(&fonk_sayisi, 4, 1, f);
+    b.fonksiyon_sayisi = (uint32_t)v->fonksiyon_sayisi;
+    b.fonksiyon_ofset = tampon_hizala(&t);
     for (int i = 0; i < v->fonksiyon_sayisi; i++) {
         SmFonksiyon *fn = &v->fonksiyonlar[i];
-        /* İsim uzunluğu + isim */
-        uint16_t isim_uz = fn->isim ? (uint16_t)strlen(fn->isim) : 0;
-        fwrite(&isim_uz, 2, 1, f);
-        if (isim_uz > 0) fwrite(fn->isim, 1, isim_uz, f);
-        /* Parametreler ve yerel sayısı */
-        uint8_t param = (uint8_t)fn->param_sayisi;
-        fwrite(&param, 1, 1, f);
-        uint16_t yerel = (uint16_t)fn->yerel_sayisi;
-        fwrite(&yerel, 2, 1, f);
-        /* Bytecode konum ve uzunluk */
-        uint32_t bas = (uint32_t)fn->kod_baslangic;
-        fwrite(&bas, 4, 1, f);
-        uint32_t uz = (uint32_t)fn->kod_uzunluk;
-        fwrite(&uz, 4, 1, f);
+        TrbcFonksiyon f = {
+            .isim = isim_ofsetleri[i],
+            .yerel_sayisi = (uint16_t)fn->yerel_sayisi,
+            .param_sayisi = (uint8_t)fn->param_sayisi,
+            .kod_baslangic = (uint32_t)fn->kod_baslangic,
+            .kod_uzunluk = (uint32_t)fn->kod_uzunluk,
+        };
+        tampon_ekle(&t, &f, sizeof(f));
     }
+    free(isim_ofsetleri);
 
     /* Bytecode */
-    uint32_t kod_uz = (uint32_t)v->kod_uzunluk;
-    fwrite(&kod_uz, 4, 1, f);
-    fwrite(v->kod, 1, v->kod_uzunluk, f);
+    b.kod_ofset = tampon_hizala(&t);
+    b.kod_uzunluk = (uint32_t)v->kod_uzunluk;
+    tampon_ekle(&t, v->kod, (size_t)v->kod_uzunluk);
+    tampon_hizala(&t);
 
+    /* Başlık */
+    b.sihirli = TRBC_SIHIRLI;
+    b.versiyon = TRBC_VERSIYON;
+    b.bayraklar = TRBC_BAYRAK_SAGLAMA;
+    b.dosya_boyu = (uint32_t)t.uzunluk;
+    b.saglama = trbc_saglama(t.veri + sizeof(b), t.uzunluk - sizeof(b));
+    memcpy(t.veri, &b, sizeof(b));
+
+    FILE *f = fopen(dosya_adi, "wb");
+    if (!f) {
+        fprintf(stderr, "Hata: '%s' dosyası açılamadı\n", dosya_adi);
+        free(t.veri);
+        return -1;
+    }
+    size_t yazilan = fwrite(t.veri, 1, t.uzunluk, f);
     fclose(f);
-    return 0;
+    free(t.veri);
+    return yazilan == t.uzunluk ? 0 : -1;
 }
 
 /* ═══════════════════════════════════════════════════════════════════
@@ -890,12 +1762,13 @@ void kod_uret_vm(Üretici *u, Düğüm *program, Arena *arena) {
     VmUretici v;
     memset(&v, 0, sizeof(v));
     v.arena = arena;
+    v.u = u;
 
     /* Tamponları ayır */
     v.kod_kapasite = VM_KOD_KAP;
     v.kod = malloc(v.kod_kapasite);
     v.sabit_kapasite = VM_SABIT_KAP;
-    v.sabitler = malloc(v.sabit_kapasite * sizeof(SmDeger));
+    v.sabitler = malloc(v.sabit_kapasite * sizeof(SmSabit));
     v.fonksiyon_kapasite = VM_FONK_KAP;
     v.fonksiyonlar = malloc(v.fonksiyon_kapasite * sizeof(SmFonksiyon));
 
@@ -907,7 +1780,10 @@ void kod_uret_vm(Üretici *u, Düğüm *program, Arena *arena) {
             if (v.fonksiyon_sayisi < v.fonksiyon_kapasite) {
                 int idx = v.fonksiyon_sayisi++;
                 v.fonksiyonlar[idx].isim = (char *)d->veri.islev.isim;
-                v.fonksiyonlar[idx].param_sayisi = 0;
+                /* Parametre sayısı önceden bilinirse çağrılar SM_CAGRI_SABIT olur */
+                v.fonksiyonlar[idx].param_sayisi =
+                    (d->çocuk_sayısı >= 2 && d->çocuklar[0]->tur == DÜĞÜM_BLOK) ?
+                    d->çocuklar[0]->çocuk_sayısı : 0;
                 v.fonksiyonlar[idx].yerel_sayisi = 0;
                 v.fonksiyonlar[idx].kod_baslangic = 0;
                 v.fonksiyonlar[idx].kod_uzunluk = 0;
@@ -923,6 +1799,9 @@ void kod_uret_vm(Üretici *u, Düğüm *program, Arena *arena) {
     /* Program sonu */
     vm_komut(&v, SM_DUR);
 
+    /* Bytecode düzeyi sadeleştirme */
+    vm_optimize_et(&v, u->vm_opt_rapor);
+
     /* Çıktı dosya adı — Üretici'nin cikti alanından al */
     const char *cikti = u->cikti.veri;
     if (!cikti || strlen(cikti) == 0) cikti = "a.trbc";
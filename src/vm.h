@@ -5,7 +5,9 @@
 #ifndef VM_H
 #define VM_H
 
+#include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 /* ═══════════════════════════════════════════════════════════════════
  *  BYTECODE KOMUT SETİ
@@ -93,8 +95,51 @@ typedef enum {
 
     /* Program sonu */
     SM_DUR,                 /* programı bitir */
+
+    /* Birleşik komutlar — eski .trbc dosyaları geçerli kalsın diye sona eklenir */
+    SM_TOPLA_YEREL,         /* u16 idx: a → a+yereller[idx] */
+    SM_TOPLA_GENEL,         /* u16 idx: a → a+geneller[idx] */
+    SM_ARTIR_YEREL,         /* u16 idx, i16 k: yereller[idx] += k */
+    SM_ARTIR_GENEL,         /* u16 idx, i16 k: geneller[idx] += k */
+    SM_ESIT_ATLA_YANLIS,    /* i16 ofset: b,a → a==b değilse atla */
+    SM_ESIT_DEGIL_ATLA_YANLIS,
+    SM_KUCUK_ATLA_YANLIS,
+    SM_BUYUK_ATLA_YANLIS,
+    SM_KUCUK_ESIT_ATLA_YANLIS,
+    SM_BUYUK_ESIT_ATLA_YANLIS,
+    SM_CAGRI_SABIT,         /* u16 fonksiyon_idx; arg_sayısı = param_sayisi */
+
+    SM_KOMUT_SAYISI
 } SmKomut;
 
+/* Komutun operandlarıyla birlikte bayt uzunluğu (bilinmeyen komut: 0) */
+static inline int sm_komut_boyu(uint8_t komut) {
+    switch (komut) {
+    case SM_SABIT_TAM: case SM_SABIT_ONDALIK: case SM_SABIT_METIN:
+    case SM_YUKLE_YEREL: case SM_KAYDET_YEREL:
+    case SM_YUKLE_GENEL: case SM_KAYDET_GENEL:
+    case SM_ATLA: case SM_ATLA_YANLIS: case SM_ATLA_DOGRU:
+    case SM_TOPLA_YEREL: case SM_TOPLA_GENEL:
+    case SM_ESIT_ATLA_YANLIS: case SM_ESIT_DEGIL_ATLA_YANLIS:
+    case SM_KUCUK_ATLA_YANLIS: case SM_BUYUK_ATLA_YANLIS:
+    case SM_KUCUK_ESIT_ATLA_YANLIS: case SM_BUYUK_ESIT_ATLA_YANLIS:
+    case SM_CAGRI_SABIT:
+        return 3;
+    case SM_CAGRI:
+        return 4;
+    case SM_ARTIR_YEREL: case SM_ARTIR_GENEL:
+        return 5;
+    default:
+        return komut < SM_KOMUT_SAYISI ? 1 : 0;
+    }
+}
+
+/* Komutun ilk operandı i16 göreceli atlama ofseti mi? */
+static inline int sm_komut_atlama_mi(uint8_t komut) {
+    return komut == SM_ATLA || komut == SM_ATLA_YANLIS || komut == SM_ATLA_DOGRU ||
+           (komut >= SM_ESIT_ATLA_YANLIS && komut <= SM_BUYUK_ESIT_ATLA_YANLIS);
+}
+
 /* ═══════════════════════════════════════════════════════════════════
  *  DEĞER TEMSİLİ
  * ═══════════════════════════════════════════════════════════════════ */
@@ -107,6 +152,7 @@ typedef enum {
     DEGER_MANTIK,
 } DegerTuru;
 
+/* Derleyici ve .trbc sabit havuzu tarafındaki etiketli sabit */
 typedef struct {
     DegerTuru tur;
     union {
@@ -118,12 +164,109 @@ typedef struct {
         } metin;
         int       mantik;
     } deger;
-} SmDeger;
+} SmSabit;
+
+/*
+ * Çalışma zamanı değeri: 8 baytlık NaN kutusu.
+ *
+ * Etiket alanı 0xFFF8'den büyük olan sessiz NaN'lar değer taşır; geri
+ * kalan tüm bit desenleri (donanımın ürettiği 0xFFF8... NaN dahil)
+ * ondalık sayıdır. Yük 48 bittir:
+ *
+ *   0xFFF9 | 0          boş
+ *   0xFFFA | 0/1        mantık
+ *   0xFFFB | int48      tam (48 bite sığmayan tamlar yığında kutulanır)
+ *   0xFFFC | işaretçi   SmNesne* (metin, büyük tam)
+ */
+typedef uint64_t SmDeger;
+
+#define SM_NAN_TABANI      0xFFF8000000000000ULL
+#define SM_ETIKET_MASKE    0xFFFF000000000000ULL
+#define SM_YUK_MASKE       0x0000FFFFFFFFFFFFULL
+#define SM_ETIKET_BOS      0xFFF9000000000000ULL
+#define SM_ETIKET_MANTIK   0xFFFA000000000000ULL
+#define SM_ETIKET_TAM      0xFFFB000000000000ULL
+#define SM_ETIKET_NESNE    0xFFFC000000000000ULL
+#define SM_KANONIK_NAN     0x7FF8000000000000ULL
+
+#define SM_BOS_DEGER       SM_ETIKET_BOS
+#define SM_TAM_KISA_MIN    (-((int64_t)1 << 47))
+#define SM_TAM_KISA_MAKS   (((int64_t)1 << 47) - 1)
+
+/* Referans sayımlı yığın nesnesi başlığı */
+#define SM_KALICI  UINT32_MAX   /* sabit havuzu nesneleri: sayılmaz, serbest bırakılmaz */
+
+typedef struct {
+    uint32_t ref;
+    uint8_t  tur;               /* DEGER_METIN veya DEGER_TAM */
+} SmNesne;
+
+typedef struct {
+    SmNesne  baslik;
+    int64_t  uzunluk;
+    char     veri[];            /* uzunluk + 1 bayt, '\0' ile biter */
+} SmMetin;
+
+typedef struct {
+    SmNesne  baslik;
+    int64_t  deger;
+} SmKutuTam;
+
+static inline int sm_etiket_mi(SmDeger d, uint64_t etiket) {
+    return (d & SM_ETIKET_MASKE) == etiket;
+}
+
+static inline int sm_tam_kisa_mi(SmDeger d)  { return sm_etiket_mi(d, SM_ETIKET_TAM); }
+static inline int sm_nesne_mi(SmDeger d)     { return sm_etiket_mi(d, SM_ETIKET_NESNE); }
+
+static inline int sm_ondalik_mi(SmDeger d) {
+    return (d >> 48) <= (SM_NAN_TABANI >> 48);
+}
+
+static inline SmDeger sm_mantik(int x) {
+    return SM_ETIKET_MANTIK | (x ? 1u : 0u);
+}
+
+static inline SmDeger sm_tam_kisa(int64_t x) {
+    return SM_ETIKET_TAM | ((uint64_t)x & SM_YUK_MASKE);
+}
+
+static inline int64_t sm_tam_kisa_al(SmDeger d) {
+    return (int64_t)(d << 16) >> 16;
+}
+
+static inline SmNesne *sm_nesne(SmDeger d) {
+    return (SmNesne *)(uintptr_t)(d & SM_YUK_MASKE);
+}
+
+static inline SmDeger sm_nesne_deger(const void *n) {
+    return SM_ETIKET_NESNE | ((uint64_t)(uintptr_t)n & SM_YUK_MASKE);
+}
+
+static inline SmDeger sm_ondalik(double x) {
+    SmDeger d;
+    memcpy(&d, &x, 8);
+    /* Etiket alanına düşen NaN yükleri tek bir NaN'a indirgenir */
+    if ((d & SM_NAN_TABANI) == SM_NAN_TABANI && d != SM_NAN_TABANI)
+        d = SM_KANONIK_NAN;
+    return d;
+}
+
+static inline double sm_ondalik_al(SmDeger d) {
+    double x;
+    memcpy(&x, &d, 8);
+    return x;
+}
 
 /* ═══════════════════════════════════════════════════════════════════
  *  FONKSİYON TABLOSU
  * ═══════════════════════════════════════════════════════════════════ */
 
+/*
+ * Gövdesi olmayan (kod_uzunluk 0) fonksiyon harici fonksiyondur: betikte
+ * `@harici` ile bildirilir ve gömülü kullanımda ana program tarafından
+ * trsm_harici_kaydet ile bağlanır (bkz. trsm.h).
+ */
 typedef struct {
     char   *isim;
     int     param_sayisi;
@@ -132,27 +275,114 @@ typedef struct {
     int     kod_uzunluk;
 } SmFonksiyon;
 
+static inline int sm_fonksiyon_harici_mi(const SmFonksiyon *fn) {
+    return fn->kod_uzunluk == 0;
+}
+
 /* ═══════════════════════════════════════════════════════════════════
  *  BYTECODE DOSYA FORMATI (.trbc)
  * ═══════════════════════════════════════════════════════════════════ */
 
 #define TRBC_SIHIRLI     0x43425254   /* "TRBC" (little-endian) */
-#define TRBC_VERSIYON    1
+#define TRBC_VERSIYON    3
+#define TRBC_VERSIYON_AKIS 2          /* sıralı biçim, kopyalanarak yüklenir */
+#define TRBC_VERSIYON_ESKI 1          /* hâlâ yüklenebilir */
+
+/*
+ * v1/v2 sıralı (akış) biçimlerdir: sabitler tip etiketiyle art arda,
+ * fonksiyon isimleri uzunluk önekli. v2, sabit sayısının hemen ardından
+ * yığın nesnesi gerektiren sabitlerin sayısını ve metinlerin toplam bayt
+ * uzunluğunu (u32, u32) yazar; v1'de bu bilgi havuz taranarak çıkarılır.
+ */
 
-/* Sabit havuzu tip etiketleri */
+/* Sabit havuzu tip etiketleri (v1/v2) */
 #define SABIT_TIP_TAM     1
 #define SABIT_TIP_ONDALIK 2
 #define SABIT_TIP_METIN   3
 
+/*
+ * v3: dosya salt okunur eşlenip (mmap) yerinde kullanılır. Tüm bölümler
+ * 8 bayt hizalı ve başlıktaki ofsetlerle bulunur:
+ *
+ *   sabit     u64 × sabit_sayisi: hazır SmDeger; nesnelerde yük, nesne
+ *             bölümündeki ofsettir (yükleyici işaretçiye çevirir)
+ *   nesne     SmMetin / SmKutuTam görüntüleri, ref = SM_KALICI
+ *   fonksiyon TrbcFonksiyon × fonksiyon_sayisi
+ *   isim      '\0' ile biten fonksiyon isimleri
+ *   kod       bytecode
+ *
+ * Yükleyici yalnızca sabit ve fonksiyon tablolarını kurar; metinler, isimler
+ * ve kod kopyalanmaz. TRBC_BAYRAK_SAGLAMA varsa saglama, başlıktan sonraki
+ * baytların trbc_saglama() özetidir.
+ */
+#define TRBC_BAYRAK_SAGLAMA  0x0001
+#define TRBC_HIZA            8
+#define TRBC_ISIMSIZ         UINT32_MAX
+
+typedef struct {
+    uint32_t sihirli;
+    uint16_t versiyon;
+    uint16_t bayraklar;
+    uint32_t dosya_boyu;
+    uint32_t saglama;
+    uint32_t sabit_sayisi;
+    uint32_t sabit_ofset;
+    uint32_t nesne_ofset;
+    uint32_t nesne_boyu;
+    uint32_t fonksiyon_sayisi;
+    uint32_t fonksiyon_ofset;
+    uint32_t isim_ofset;
+    uint32_t isim_boyu;
+    uint32_t kod_ofset;
+    uint32_t kod_uzunluk;
+    uint32_t ayrilmis[2];
+} TrbcBaslik;
+
+typedef struct {
+    uint32_t isim;              /* isim bölümünde ofset ya da TRBC_ISIMSIZ */
+    uint16_t yerel_sayisi;
+    uint8_t  param_sayisi;
+    uint8_t  ayrilmis;
+    uint32_t kod_baslangic;
+    uint32_t kod_uzunluk;
+} TrbcFonksiyon;
+
+/* Nesne görüntüleri dosyada bu yerleşimle durur */
+_Static_assert(sizeof(TrbcBaslik) == 64, "TrbcBaslik boyutu");
+_Static_assert(sizeof(TrbcFonksiyon) == 16, "TrbcFonksiyon boyutu");
+_Static_assert(sizeof(SmMetin) == 16 && offsetof(SmMetin, veri) == 16, "SmMetin yerleşimi");
+_Static_assert(sizeof(SmKutuTam) == 16, "SmKutuTam yerleşimi");
+
+/* 8 baytlık sözcükler üzerinde FNV-1a; boyut TRBC_HIZA katı olmalı */
+static inline uint32_t trbc_saglama(const uint8_t *p, size_t boyut) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i + 8 <= boyut; i += 8) {
+        uint64_t w;
+        memcpy(&w, p + i, 8);
+        h = (h ^ w) * 0x100000001b3ULL;
+        h ^= h >> 29;
+    }
+    return (uint32_t)(h ^ (h >> 32));
+}
+
 /* ═══════════════════════════════════════════════════════════════════
  *  ÇAĞRI ÇERÇEVESİ
  * ═══════════════════════════════════════════════════════════════════ */
 
+/*
+ * Yereller ayrı bir diziye kopyalanmaz: çağıranın yığına attığı argümanlar
+ * yerinde ilk yereller olur, kalan yereller hemen üstüne açılır ve işlenen
+ * yığını onların üstünden devam eder.
+ *
+ *   yigin: [... | arg0 arg1 | yerel2 .. | işlenenler ...]
+ *                 ^taban                  ^taban + yerel_sayisi
+ *
+ * Yığın büyüyünce yeniden ayrıldığı için çerçeve işaretçi değil indeks tutar.
+ */
 typedef struct {
     SmFonksiyon *fonksiyon;
     uint8_t     *dondur_adresi;     /* geri dönüş PC */
-    int          yigin_tabani;      /* bu çerçevenin yığın tabanı */
-    SmDeger     *yereller;          /* yerel değişken dizisi */
+    int          taban;             /* yereller[0]'ın yığındaki indeksi */
     int          yerel_sayisi;
 } CagriCercevesi;
 
@@ -160,34 +390,85 @@ typedef struct {
  *  SANAL MAKİNE
  * ═══════════════════════════════════════════════════════════════════ */
 
-#define YIGIN_MAKS    4096
-#define CERCEVE_MAKS  256
-#define GENEL_MAKS    1024
+#define YIGIN_BASLANGIC    256         /* değer yığını başlangıç kapasitesi */
+#define YIGIN_SINIR        (1 << 24)   /* bunun üstü "yığın taşması" sayılır */
+#define CERCEVE_BASLANGIC  32
+#define CERCEVE_SINIR      (1 << 20)
+#define GENEL_MAKS         1024
 
-typedef struct {
-    /* Bytecode */
+/*
+ * Yüklenmiş program: yüklemeden sonra değişmez, istenen sayıda TrSM
+ * tarafından paylaşılır. Sabit nesneleri SM_KALICI olduğundan farklı
+ * iş parçacıklarındaki makineler aynı modülü kilitsiz kullanabilir.
+ */
+typedef struct TrsmModul {
+    uint8_t *kod;
+    int      kod_uzunluk;
+
+    /* v3 görüntüsü: kod, sabit nesneleri ve isimler içini gösterir.
+     * Dosyadan eşlenmişse munmap, bellekten kopyalanmışsa free edilir. */
+    const uint8_t *eslem;
+    size_t   eslem_boyu;
+    int      eslem_kopya;
+
+    /* Sabit havuzu (metin/büyük tam nesneleri sabit_blok içinde, kalıcı) */
+    SmDeger *sabitler;
+    int      sabit_sayisi;
+    void    *sabit_blok;
+
+    SmFonksiyon *fonksiyonlar;
+    int      fonksiyon_sayisi;
+
+    int      genel_sayisi;      /* koddaki en büyük değişken indeksi + 1 */
+    int      referans;          /* atomik; 0'a inince modül bırakılır */
+} TrsmModul;
+
+struct TrsmHarici;
+
+typedef struct TrSM {
+    const TrsmModul *modul;
+
+    /* Bytecode (modülün; salt okunur) */
     uint8_t *kod;
     int      kod_uzunluk;
     uint8_t *pc;
 
-    /* Değer yığını */
-    SmDeger  yigin[YIGIN_MAKS];
+    /* Değer yığını (yereller + işlenenler, gerektikçe büyür) */
+    SmDeger *yigin;
     int      sp;
+    int      yigin_kapasite;
 
-    /* Çağrı yığını */
-    CagriCercevesi cerceveler[CERCEVE_MAKS];
+    /* Çağrı yığını (gerektikçe büyür) */
+    CagriCercevesi *cerceveler;
     int      cerceve_sayisi;
+    int      cerceve_kapasite;
 
-    /* Global değişkenler */
-    SmDeger  geneller[GENEL_MAKS];
+    /* Global değişkenler (modul->genel_sayisi kadar) */
+    SmDeger *geneller;
+    int      genel_sayisi;
 
-    /* Sabit havuzu */
+    /* Modülün sabit ve fonksiyon tabloları (sıcak yolda dolaylamasız) */
     SmDeger *sabitler;
     int      sabit_sayisi;
-
-    /* Fonksiyon tablosu */
     SmFonksiyon *fonksiyonlar;
     int      fonksiyon_sayisi;
+
+    /* Harici fonksiyon bağları, fonksiyon indeksine göre; ilk kayıtta ayrılır */
+    struct TrsmHarici *harici;
+    int      calisiyor;         /* yeniden girişi engeller */
+
+    /* Şablon JIT (trsm_jit.c); jit NULL ise yalnızca yorumlayıcı çalışır.
+     * jit_* alanları doğal koddan sabit ofsetlerle okunup yazılır. */
+    struct TrsmJit *jit;
+    void   **jit_giris;          /* fonksiyon → doğal çağrı girişi, derlenmemişse NULL */
+    SmDeger *jit_sp;             /* çıkışta işlenen yığını tepesi */
+    uint8_t *jit_pc;             /* deopt: yorumlayıcının devam edeceği komut */
+    SmDeger *jit_yigin_son;      /* yigin + yigin_kapasite (girişte tazelenir) */
+    int      jit_cerceve_siniri; /* doğal iç içe çağrı sınırı */
+
+    /* --profil (trsm_profil.c); NULL değilse yorumlayıcı profil
+     * dağıtım tablosuyla çalışır */
+    struct TrsmProfil *profil;
 } TrSM;
 
 /* ═══════════════════════════════════════════════════════════════════
@@ -194,6 +194,20 @@ void x86_taşı_bellek_yazmaç_byte(İkilKod *ik, YazmaçNo taban, int32_t ofset
     bellek_kodla(ik, kaynak, taban, ofset);
 }
 
+/* MOV r32, [taban+ofset] (8B /r, REX.W yok) */
+void x86_taşı_yazmaç_bellek32(İkilKod *ik, YazmaçNo hedef, YazmaçNo taban, int32_t ofset) {
+    if (hedef >= 8 || taban >= 8) ikil_byte_ekle(ik, rex_hesapla(0, hedef, taban));
+    ikil_byte_ekle(ik, 0x8B);
+    bellek_kodla(ik, hedef, taban, ofset);
+}
+
+/* MOV [taban+ofset], r32 (89 /r, REX.W yok) */
+void x86_taşı_bellek_yazmaç32(İkilKod *ik, YazmaçNo taban, int32_t ofset, YazmaçNo kaynak) {
+    if (kaynak >= 8 || taban >= 8) ikil_byte_ekle(ik, rex_hesapla(0, kaynak, taban));
+    ikil_byte_ekle(ik, 0x89);
+    bellek_kodla(ik, kaynak, taban, ofset);
+}
+
 /* ═══════════════════════════════════════════════════════════════════════════
  *                     ARİTMETİK KOMUTLARI
  * ═══════════════════════════════════════════════════════════════════════════ */
@@ -223,6 +237,14 @@ void x86_çarp_yazmaç_yazmaç(İkilKod *ik, YazmaçNo hedef, YazmaçNo kaynak)
     ikil_byte_ekle(ik, modrm_hesapla(3, hedef & 7, kaynak & 7));
 }
 
+/* IMUL hedef, kaynak, imm32 (REX.W + 69 /r + imm32) */
+void x86_çarp_yazmaç_sabit32(İkilKod *ik, YazmaçNo hedef, YazmaçNo kaynak, int32_t değer) {
+    ikil_byte_ekle(ik, rex_hesapla(1, hedef, kaynak));
+    ikil_byte_ekle(ik, 0x69);
+    ikil_byte_ekle(ik, modrm_hesapla(3, hedef & 7, kaynak & 7));
+    ikil_dword_ekle(ik, (uint32_t)değer);
+}
+
 /* IDIV bölen — rdx:rax / bölen → rax=bölüm, rdx=kalan */
 void x86_böl_yazmaç(İkilKod *ik, YazmaçNo bölen) {
     ikil_byte_ekle(ik, rex_hesapla(1, 0, bölen));
@@ -323,6 +345,9 @@ void x86_koşul_küçük(İkilKod *ik, YazmaçNo yaz)         { setcc_kodla(ik,
 void x86_koşul_büyük(İkilKod *ik, YazmaçNo yaz)         { setcc_kodla(ik, 0x0F, yaz); } /* SETG: cc=F */
 void x86_koşul_küçük_eşit(İkilKod *ik, YazmaçNo yaz)   { setcc_kodla(ik, 0x0E, yaz); } /* SETLE: cc=E */
 void x86_koşul_büyük_eşit(İkilKod *ik, YazmaçNo yaz)   { setcc_kodla(ik, 0x0D, yaz); } /* SETGE: cc=D */
+void x86_koşul_üstünde(İkilKod *ik, YazmaçNo yaz)       { setcc_kodla(ik, 0x07, yaz); } /* SETA: cc=7 */
+void x86_koşul_üstünde_eşit(İkilKod *ik, YazmaçNo yaz) { setcc_kodla(ik, 0x03, yaz); } /* SETAE: cc=3 */
+void x86_koşul_eşlik_yok(İkilKod *ik, YazmaçNo yaz)     { setcc_kodla(ik, 0x0B, yaz); } /* SETNP: cc=B */
 
 /* MOVZX r64, r8 — sıfır genişlet (REX.W + 0F B6 /r) */
 void x86_sıfır_genişlet_byte(İkilKod *ik, YazmaçNo hedef, YazmaçNo kaynak) {
@@ -359,6 +384,8 @@ int x86_atla_küçükse(İkilKod *ik)          { return jcc_kodla(ik, 0x0C); } /
 int x86_atla_büyükse(İkilKod *ik)          { return jcc_kodla(ik, 0x0F); } /* JG */
 int x86_atla_küçük_eşitse(İkilKod *ik)    { return jcc_kodla(ik, 0x0E); } /* JLE */
 int x86_atla_büyük_eşitse(İkilKod *ik)    { return jcc_kodla(ik, 0x0D); } /* JGE */
+int x86_atla_taşarsa(İkilKod *ik)          { return jcc_kodla(ik, 0x00); } /* JO */
+int x86_atla_üstündeyse(İkilKod *ik)       { return jcc_kodla(ik, 0x07); } /* JA */
 
 /* Atlama yaması: rel32 = hedef - (yama_ofseti + 4) */
 void x86_atlama_yamala(İkilKod *ik, int yama_ofseti, int hedef_ofseti) {
@@ -508,6 +535,18 @@ void x86_sağa_kaydır_cl(İkilKod *ik, YazmaçNo hedef) {
     ikil_byte_ekle(ik, modrm_hesapla(3, 5, hedef & 7));
 }
 
+/* Sabit kaydırma yardımcısı: REX.W + C1 /n + imm8 */
+static void kaydır_sabit(İkilKod *ik, int alt_kod, YazmaçNo hedef, uint8_t adet) {
+    ikil_byte_ekle(ik, rex_hesapla(1, 0, hedef));
+    ikil_byte_ekle(ik, 0xC1);
+    ikil_byte_ekle(ik, modrm_hesapla(3, alt_kod, hedef & 7));
+    ikil_byte_ekle(ik, adet);
+}
+
+void x86_sola_kaydır_sabit(İkilKod *ik, YazmaçNo hedef, uint8_t adet)           { kaydır_sabit(ik, 4, hedef, adet); }
+void x86_sağa_kaydır_sabit(İkilKod *ik, YazmaçNo hedef, uint8_t adet)           { kaydır_sabit(ik, 5, hedef, adet); }
+void x86_aritmetik_sağa_kaydır_sabit(İkilKod *ik, YazmaçNo hedef, uint8_t adet) { kaydır_sabit(ik, 7, hedef, adet); }
+
 /* ═══════════════════════════════════════════════════════════════════════════
  *                     SSE2 ONDALIK (double) KOMUTLARI
  * ═══════════════════════════════════════════════════════════════════════════ */
@@ -74,6 +74,10 @@ void x86_taşı_bellek_yazmaç(İkilKod *ik, YazmaçNo taban, int32_t ofset, Yaz
 /* MOV byte [taban+ofset], kaynak_low8 (88 /r + ModRM + disp) — tek byte yaz */
 void x86_taşı_bellek_yazmaç_byte(İkilKod *ik, YazmaçNo taban, int32_t ofset, YazmaçNo kaynak);
 
+/* 32-bit MOV: yazmaç ← [taban+ofset] (üst yarı sıfırlanır) / [taban+ofset] ← yazmaç */
+void x86_taşı_yazmaç_bellek32(İkilKod *ik, YazmaçNo hedef, YazmaçNo taban, int32_t ofset);
+void x86_taşı_bellek_yazmaç32(İkilKod *ik, YazmaçNo taban, int32_t ofset, YazmaçNo kaynak);
+
 /* ═══════════════════════════════════════════════════════════════════════════
  *                      ARİTMETİK KOMUTLARI
  * ═══════════════════════════════════════════════════════════════════════════ */
@@ -81,6 +85,7 @@ void x86_taşı_bellek_yazmaç_byte(İkilKod *ik, YazmaçNo taban, int32_t ofset
 void x86_topla_yazmaç_yazmaç(İkilKod *ik, YazmaçNo hedef, YazmaçNo kaynak);
 void x86_çıkar_yazmaç_yazmaç(İkilKod *ik, YazmaçNo hedef, YazmaçNo kaynak);
 void x86_çarp_yazmaç_yazmaç(İkilKod *ik, YazmaçNo hedef, YazmaçNo kaynak);
+void x86_çarp_yazmaç_sabit32(İkilKod *ik, YazmaçNo hedef, YazmaçNo kaynak, int32_t değer); /* IMUL r, r/m, imm32 */
 void x86_böl_yazmaç(İkilKod *ik, YazmaçNo bölen);     /* IDIV: rdx:rax / bölen */
 void x86_işaret_genişlet(İkilKod *ik);                  /* CQO: rax → rdx:rax */
 
@@ -105,6 +110,9 @@ void x86_koşul_küçük(İkilKod *ik, YazmaçNo yaz);           /* SETL */
 void x86_koşul_büyük(İkilKod *ik, YazmaçNo yaz);           /* SETG */
 void x86_koşul_küçük_eşit(İkilKod *ik, YazmaçNo yaz);     /* SETLE */
 void x86_koşul_büyük_eşit(İkilKod *ik, YazmaçNo yaz);     /* SETGE */
+void x86_koşul_üstünde(İkilKod *ik, YazmaçNo yaz);         /* SETA  (işaretsiz / UCOMISD) */
+void x86_koşul_üstünde_eşit(İkilKod *ik, YazmaçNo yaz);   /* SETAE (işaretsiz / UCOMISD) */
+void x86_koşul_eşlik_yok(İkilKod *ik, YazmaçNo yaz);       /* SETNP (UCOMISD: sıralı) */
 
 /* MOVZX — byte'ı qword'e sıfır genişlet */
 void x86_sıfır_genişlet_byte(İkilKod *ik, YazmaçNo hedef, YazmaçNo kaynak);
@@ -124,6 +132,8 @@ int x86_atla_küçükse(İkilKod *ik);             /* JL rel32 */
 int x86_atla_büyükse(İkilKod *ik);             /* JG rel32 */
 int x86_atla_küçük_eşitse(İkilKod *ik);        /* JLE rel32 */
 int x86_atla_büyük_eşitse(İkilKod *ik);        /* JGE rel32 */
+int x86_atla_taşarsa(İkilKod *ik);             /* JO rel32 */
+int x86_atla_üstündeyse(İkilKod *ik);          /* JA rel32 (işaretsiz) */
 
 /* Atlama hedefini yamala: rel32 = hedef_ofset - (yama_ofset + 4) */
 void x86_atlama_yamala(İkilKod *ik, int yama_ofseti, int hedef_ofseti);
@@ -179,6 +189,9 @@ void x86_ve_yazmaç_sabit32(İkilKod *ik, YazmaçNo hedef, int32_t değer);
 
 void x86_sola_kaydır_cl(İkilKod *ik, YazmaçNo hedef);
 void x86_sağa_kaydır_cl(İkilKod *ik, YazmaçNo hedef);
+void x86_sola_kaydır_sabit(İkilKod *ik, YazmaçNo hedef, uint8_t adet);             /* SHL r, imm8 */
+void x86_sağa_kaydır_sabit(İkilKod *ik, YazmaçNo hedef, uint8_t adet);             /* SHR r, imm8 */
+void x86_aritmetik_sağa_kaydır_sabit(İkilKod *ik, YazmaçNo hedef, uint8_t adet);   /* SAR r, imm8 */
 
 /* ═══════════════════════════════════════════════════════════════════════════
  *                      SSE2 ONDALIK (double) KOMUTLARI
@@ -15,6 +15,8 @@ static int _tr_karsilastir(const void *a, const void *b) {
 /* sırala(dizi) -> dizi (küçükten büyüğe, in-place) */
 TrDizi _tr_sirala(long long *ptr, long long count) {
     if (count > 1) {
+        /* İşaretli yuvalar elemanlarla birlikte yer değiştiremez */
+        if (NESNE_BASLIK(ptr)->tip & NESNE_BAYRAK_REFLI) _tr_ref_izleme_birak(ptr);
         qsort(ptr, (size_t)count, sizeof(long long), _tr_karsilastir);
     }
     TrDizi sonuç;
@@ -23,24 +25,72 @@ TrDizi _tr_sirala(long long *ptr, long long count) {
     return sonuç;
 }
 
-/* ekle(dizi, eleman) -> dizi (yeni dizi, sona eleman ekle) */
-TrDizi _tr_ekle(long long *ptr, long long count, long long eleman) {
-    long long yeni_boyut = (count + 1) * sizeof(long long);
-    long long *yeni = (long long *)_tr_nesne_olustur(NESNE_TIP_DIZI, yeni_boyut);
+/* ---- Büyüyebilir dizi desteği ----
+ * Kapasite header'daki ayrılan boyuttan, kullanılan uzunluk tip alanından
+ * okunur (bkz. runtime.h). ekle ve birleştir her zaman yeni, geometrik
+ * büyüyen bir tampon döndürür: eski görünüm ve aynı tamponu gösteren diğer
+ * görünümler değişmez. _yerinde sürümlerini derleyici yalnızca eski
+ * görünümün atamayla kaybolduğu `d = ekle(d, x)` biçiminde çağırır; görünüm
+ * dizinin sonuna sahipse, tampon başka değişkenle ortak değilse ve yer
+ * varsa ekleme yerinde, amortize O(1) yapılır. */
+
+static inline void _dizi_uzunluk_ata(long long *ptr, long long n) {
+    NesneBaslik *b = NESNE_BASLIK(ptr);
+    long long alt = b->tip & ((1LL << NESNE_DIZI_UZUNLUK_KAYMA) - 1);
+    b->tip = alt | ((n + 1) << NESNE_DIZI_UZUNLUK_KAYMA);
+}
+
+/* Görünüm (ptr, count) dizinin sonuna sahip mi ve yerinde yazılabilir mi? */
+static inline int _dizi_sona_sahip(long long *ptr, long long count) {
+    if (!ptr) return 0;
+    NesneBaslik *b = NESNE_BASLIK(ptr);
+    return (b->tip & NESNE_TIP_MASKE) == NESNE_TIP_DIZI &&
+           !(b->tip & (NESNE_BAYRAK_PAYLASILMIS | NESNE_BAYRAK_ORTAK)) &&
+           NESNE_DIZI_UZUNLUK(ptr) == count;
+}
+
+/* En az 'gereken' eleman alabilen, ilk 'count' elemanı ptr'den gelen bir
+ * dizi döndür. yerinde ise ve mümkünse ptr'nin kendisi, değilse yeni tampon. */
+static long long *_dizi_yer_ac(long long *ptr, long long count, long long gereken,
+                               int yerinde) {
+    long long kap = count * 2;
+    if (kap < gereken) kap = gereken;
+    if (yerinde && _dizi_sona_sahip(ptr, count)) {
+        if (gereken <= NESNE_DIZI_KAPASITE(ptr)) return ptr;
+        if (_tr_nesne_yerinde_buyut(ptr, kap * (long long)sizeof(long long))) return ptr;
+    }
+    if (kap < 4) kap = 4;
+    long long *yeni = (long long *)_tr_nesne_olustur(NESNE_TIP_DIZI,
+                                                     kap * (long long)sizeof(long long));
+    if (!yeni) return NULL;
+    if (count > 0) memcpy(yeni, ptr, (size_t)count * sizeof(long long));
+    return yeni;
+}
+
+static TrDizi _dizi_ekle(long long *ptr, long long count, long long eleman, int yerinde) {
+    long long *yeni = _dizi_yer_ac(ptr, count, count + 1, yerinde);
     if (!yeni) {
         TrDizi sonuç = {ptr, count};
         return sonuç;
     }
-    for (long long i = 0; i < count; i++) {
-        yeni[i] = ptr[i];
-    }
     yeni[count] = eleman;
+    _dizi_uzunluk_ata(yeni, count + 1);
     TrDizi sonuç;
     sonuç.ptr = yeni;
     sonuç.count = count + 1;
     return sonuç;
 }
 
+/* ekle(dizi, eleman) -> dizi (sona eleman eklenmiş yeni dizi) */
+TrDizi _tr_ekle(long long *ptr, long long count, long long eleman) {
+    return _dizi_ekle(ptr, count, eleman, 0);
+}
+
+/* d = ekle(d, eleman): eski görünüm kaybolur, amortize O(1) */
+TrDizi _tr_ekle_yerinde(long long *ptr, long long count, long long eleman) {
+    return _dizi_ekle(ptr, count, eleman, 1);
+}
+
 /* çıkar(dizi) -> dizi (son elemanı çıkar, aslında count-1 döner) */
 TrDizi _tr_cikar(long long *ptr, long long count) {
     TrDizi sonuç;
@@ -49,31 +99,38 @@ TrDizi _tr_cikar(long long *ptr, long long count) {
     return sonuç;
 }
 
-/* birleştir(dizi1, dizi2) -> dizi (iki diziyi birleştir) */
-TrDizi _tr_birlestir_dizi(long long *ptr1, long long count1,
-                           long long *ptr2, long long count2) {
+static TrDizi _dizi_birlestir(long long *ptr1, long long count1,
+                              long long *ptr2, long long count2, int yerinde) {
     long long toplam = count1 + count2;
-    long long boyut = toplam * sizeof(long long);
-    long long *yeni = (long long *)_tr_nesne_olustur(NESNE_TIP_DIZI, boyut);
+    long long *yeni = _dizi_yer_ac(ptr1, count1, toplam, yerinde);
     if (!yeni) {
         TrDizi sonuç = {ptr1, count1};
         return sonuç;
     }
-    for (long long i = 0; i < count1; i++) {
-        yeni[i] = ptr1[i];
-    }
-    for (long long i = 0; i < count2; i++) {
-        yeni[count1 + i] = ptr2[i];
-    }
+    /* ptr2 == ptr1 olabilir: kaynak yerinde büyütmede değişmez */
+    if (count2 > 0) memmove(yeni + count1, ptr2, (size_t)count2 * sizeof(long long));
+    _dizi_uzunluk_ata(yeni, toplam);
     TrDizi sonuç;
     sonuç.ptr = yeni;
     sonuç.count = toplam;
     return sonuç;
 }
+
+/* birleştir(dizi1, dizi2) -> dizi (dizi2'yi dizi1'in sonuna ekle) */
+TrDizi _tr_birlestir_dizi(long long *ptr1, long long count1,
+                           long long *ptr2, long long count2) {
+    return _dizi_birlestir(ptr1, count1, ptr2, count2, 0);
+}
+
+/* d = birleştir(d, d2) ve d = zincir(d, d2) */
+TrDizi _tr_birlestir_yerinde(long long *ptr1, long long count1,
+                             long long *ptr2, long long count2) {
+    return _dizi_birlestir(ptr1, count1, ptr2, count2, 1);
+}
 /* === Tekrarlayıcı genişletme === */
 
 /* al_iken(fn, dizi) -> dizi (takewhile) */
-TrDizi _tr_al_iken(long long fn_ptr, long long *dizi_ptr, long long dizi_count) {
+TrDizi _tr_al_iken(const long long *kapanis, long long *dizi_ptr, long long dizi_count) {
     TrDizi sonuç = {NULL, 0};
     if (!dizi_ptr || dizi_count <= 0) return sonuç;
 
@@ -82,9 +139,7 @@ TrDizi _tr_al_iken(long long fn_ptr, long long *dizi_ptr, long long dizi_count)
 
     long long idx = 0;
     for (long long i = 0; i < dizi_count; i++) {
-        /* fn'yi çağır: fn(dizi[i]) -> sonuç */
-        long long (*fn)(long long) = (long long (*)(long long))fn_ptr;
-        long long r = fn(dizi_ptr[i]);
+        long long r = TR_KAPANIS_CAGIR1(kapanis, dizi_ptr[i]);
         if (!r) break;  /* koşul sağlanmıyor, dur */
         yeni[idx++] = dizi_ptr[i];
     }
@@ -94,13 +149,12 @@ TrDizi _tr_al_iken(long long fn_ptr, long long *dizi_ptr, long long dizi_count)
 }
 
 /* at_iken(fn, dizi) -> dizi (dropwhile) */
-TrDizi _tr_at_iken(long long fn_ptr, long long *dizi_ptr, long long dizi_count) {
+TrDizi _tr_at_iken(const long long *kapanis, long long *dizi_ptr, long long dizi_count) {
     TrDizi sonuç = {NULL, 0};
     if (!dizi_ptr || dizi_count <= 0) return sonuç;
 
     long long bas = 0;
-    long long (*fn)(long long) = (long long (*)(long long))fn_ptr;
-    while (bas < dizi_count && fn(dizi_ptr[bas])) bas++;
+    while (bas < dizi_count && TR_KAPANIS_CAGIR1(kapanis, dizi_ptr[bas])) bas++;
 
     long long kalan = dizi_count - bas;
     long long *yeni = (long long *)_tr_nesne_olustur(1, kalan * sizeof(long long));
@@ -114,23 +168,23 @@ TrDizi _tr_at_iken(long long fn_ptr, long long *dizi_ptr, long long dizi_count)
 
 /* === Birinci Sinif Fonksiyon Destegi (map/filter/reduce) === */
 
-/* esle(dizi, fonk_ptr) -> dizi: her elemana fonksiyonu uygula */
-TrDizi _tr_esle(long long *ptr, long long count, long long (*fn)(long long)) {
+/* esle(dizi, kapanış) -> dizi: her elemana fonksiyonu uygula */
+TrDizi _tr_esle(long long *ptr, long long count, const long long *kapanis) {
     TrDizi sonuç = {NULL, 0};
     if (count <= 0) return sonuç;
     long long boyut = count * sizeof(long long);
     long long *yeni = (long long *)_tr_nesne_olustur(NESNE_TIP_DIZI, boyut);
     if (!yeni) return sonuç;
     for (long long i = 0; i < count; i++) {
-        yeni[i] = fn(ptr[i]);
+        yeni[i] = TR_KAPANIS_CAGIR1(kapanis, ptr[i]);
     }
     sonuç.ptr = yeni;
     sonuç.count = count;
     return sonuç;
 }
 
-/* filtre(dizi, fonk_ptr) -> dizi: fonksiyon sifir-olmayan dondurenleri tut */
-TrDizi _tr_filtre(long long *ptr, long long count, long long (*fn)(long long)) {
+/* filtre(dizi, kapanış) -> dizi: fonksiyon sifir-olmayan dondurenleri tut */
+TrDizi _tr_filtre(long long *ptr, long long count, const long long *kapanis) {
     TrDizi sonuç = {NULL, 0};
     if (count <= 0) return sonuç;
     long long boyut = count * sizeof(long long);
@@ -138,7 +192,7 @@ TrDizi _tr_filtre(long long *ptr, long long count, long long (*fn)(long long)) {
     if (!yeni) return sonuç;
     long long j = 0;
     for (long long i = 0; i < count; i++) {
-        if (fn(ptr[i])) {
+        if (TR_KAPANIS_CAGIR1(kapanis, ptr[i])) {
             yeni[j++] = ptr[i];
         }
     }
@@ -147,45 +201,24 @@ TrDizi _tr_filtre(long long *ptr, long long count, long long (*fn)(long long)) {
     return sonuç;
 }
 
-/* indirge(dizi, başlangıç, fonk_ptr) -> tam: sola katlama */
+/* indirge(dizi, başlangıç, kapanış) -> tam: sola katlama */
 long long _tr_indirge(long long *ptr, long long count, long long başlangıç,
-                       long long (*fn)(long long, long long)) {
+                       const long long *kapanis) {
     long long acc = başlangıç;
     for (long long i = 0; i < count; i++) {
-        acc = fn(acc, ptr[i]);
+        acc = TR_KAPANIS_CAGIR2(kapanis, acc, ptr[i]);
     }
     return acc;
 }
 
-/* her_biri(dizi, fonk_ptr) -> tam: her eleman için fonksiyonu çağır (forEach) */
-long long _tr_her_biri(long long *ptr, long long count, long long (*fn)(long long)) {
+/* her_biri(dizi, kapanış) -> tam: her eleman için fonksiyonu çağır (forEach) */
+long long _tr_her_biri(long long *ptr, long long count, const long long *kapanis) {
     for (long long i = 0; i < count; i++) {
-        fn(ptr[i]);
+        TR_KAPANIS_CAGIR1(kapanis, ptr[i]);
     }
     return 0;
 }
 
-/* Sozluk sil: bir anahtari kaldir */
-long long _tr_sozluk_sil(long long sozluk_ptr,
-                           const char *anahtar_ptr, long long anahtar_len) {
-    long long *blok = (long long *)sozluk_ptr;
-    long long say = blok[1];
-    for (long long i = 0; i < say; i++) {
-        char *k = (char *)blok[2 + i * 3];
-        long long kl = blok[2 + i * 3 + 1];
-        if (kl == anahtar_len && memcmp(k, anahtar_ptr, anahtar_len) == 0) {
-            /* Son elemanla degistir */
-            if (i < say - 1) {
-                blok[2 + i * 3] = blok[2 + (say-1) * 3];
-                blok[2 + i * 3 + 1] = blok[2 + (say-1) * 3 + 1];
-                blok[2 + i * 3 + 2] = blok[2 + (say-1) * 3 + 2];
-            }
-            blok[1] = say - 1;
-            return 1;
-        }
-    }
-    return 0;
-}
 /* ========== Dilim (Slice) İşlemleri ========== */
 
 /* Dizi dilimi: dizi[baş:son] -> yeni dizi */
@@ -8,11 +8,20 @@
 
 typedef struct {
     long long *anahtarlar;
-    long long *durumlar;    /* 0=bos, 1=dolu, 2=silinmis */
+    long long *durumlar;    /* 0=bos, 1=dolu, 2=silinmis, 3=dolu ve sayilmis referans */
     long long kapasite;
     long long sayi;
 } TrKume;
 
+#define KUME_BOS      0
+#define KUME_DOLU     1
+#define KUME_SILINMIS 2
+#define KUME_REF      3
+
+static inline int _kume_dolu(long long durum) {
+    return durum == KUME_DOLU || durum == KUME_REF;
+}
+
 static unsigned long long _kume_hash(long long deger) {
     unsigned long long h = 14695981039346656037ULL;
     unsigned char *p = (unsigned char *)&deger;
@@ -29,11 +38,11 @@ static void _kume_genislet(TrKume *k) {
     long long *yeni_d = (long long *)calloc(yeni_kap, sizeof(long long));
     if (!yeni_a || !yeni_d) return;
     for (long long i = 0; i < k->kapasite; i++) {
-        if (k->durumlar[i] == 1) {
+        if (_kume_dolu(k->durumlar[i])) {
             unsigned long long h = _kume_hash(k->anahtarlar[i]) % (unsigned long long)yeni_kap;
-            while (yeni_d[h] == 1) h = (h + 1) % (unsigned long long)yeni_kap;
+            while (_kume_dolu(yeni_d[h])) h = (h + 1) % (unsigned long long)yeni_kap;
             yeni_a[h] = k->anahtarlar[i];
-            yeni_d[h] = 1;
+            yeni_d[h] = k->durumlar[i];
         }
     }
     free(k->anahtarlar);
@@ -43,6 +52,30 @@ static void _kume_genislet(TrKume *k) {
     k->kapasite = yeni_kap;
 }
 
+/* Döngü toplayıcı için sayılmış değerleri gez */
+static void _kume_gez(void *nesne, NesneZiyaretFn ziyaret, void *bag) {
+    TrKume *k = (TrKume *)nesne;
+    if (!k->durumlar) return;
+    for (long long i = 0; i < k->kapasite; i++) {
+        if (k->durumlar[i] == KUME_REF) ziyaret(k->anahtarlar[i], bag);
+    }
+}
+
+/* Küme bırakılırken tablolarını serbest bırak */
+static void _kume_sonlandir(void *nesne) {
+    TrKume *k = (TrKume *)nesne;
+    free(k->anahtarlar);
+    free(k->durumlar);
+    k->anahtarlar = NULL;
+    k->durumlar = NULL;
+    k->kapasite = 0;
+}
+
+__attribute__((constructor))
+static void _kume_tip_kaydet(void) {
+    _tr_nesne_tip_kaydet(NESNE_TIP_KUME, _kume_gez, _kume_sonlandir);
+}
+
 long long _tr_kume_yeni(void) {
     TrKume *k = (TrKume *)_tr_nesne_olustur(NESNE_TIP_KUME, (long long)sizeof(TrKume));
     if (!k) return 0;
@@ -58,12 +91,12 @@ void _tr_kume_ekle(long long kume_ptr, long long deger) {
     if (!k) return;
     if (k->sayi * 4 >= k->kapasite * 3) _kume_genislet(k);
     unsigned long long h = _kume_hash(deger) % (unsigned long long)k->kapasite;
-    while (k->durumlar[h] == 1) {
+    while (_kume_dolu(k->durumlar[h])) {
         if (k->anahtarlar[h] == deger) return;  /* zaten var */
         h = (h + 1) % (unsigned long long)k->kapasite;
     }
     k->anahtarlar[h] = deger;
-    k->durumlar[h] = 1;
+    k->durumlar[h] = _tr_ref_tut(k, deger) ? KUME_REF : KUME_DOLU;
     k->sayi++;
 }
 
@@ -73,10 +106,12 @@ void _tr_kume_sil(long long kume_ptr, long long deger) {
     unsigned long long h = _kume_hash(deger) % (unsigned long long)k->kapasite;
     for (long long i = 0; i < k->kapasite; i++) {
         unsigned long long idx = (h + (unsigned long long)i) % (unsigned long long)k->kapasite;
-        if (k->durumlar[idx] == 0) return;  /* bulunamadi */
-        if (k->durumlar[idx] == 1 && k->anahtarlar[idx] == deger) {
-            k->durumlar[idx] = 2;  /* silinmis olarak isaretle */
+        if (k->durumlar[idx] == KUME_BOS) return;  /* bulunamadi */
+        if (_kume_dolu(k->durumlar[idx]) && k->anahtarlar[idx] == deger) {
+            int ref = k->durumlar[idx] == KUME_REF;
+            k->durumlar[idx] = KUME_SILINMIS;
             k->sayi--;
+            if (ref) _tr_ref_azalt((void *)deger);
             return;
         }
     }
@@ -88,8 +123,8 @@ long long _tr_kume_var_mi(long long kume_ptr, long long deger) {
     unsigned long long h = _kume_hash(deger) % (unsigned long long)k->kapasite;
     for (long long i = 0; i < k->kapasite; i++) {
         unsigned long long idx = (h + (unsigned long long)i) % (unsigned long long)k->kapasite;
-        if (k->durumlar[idx] == 0) return 0;
-        if (k->durumlar[idx] == 1 && k->anahtarlar[idx] == deger) return 1;
+        if (k->durumlar[idx] == KUME_BOS) return 0;
+        if (_kume_dolu(k->durumlar[idx]) && k->anahtarlar[idx] == deger) return 1;
     }
     return 0;
 }
@@ -104,9 +139,9 @@ long long _tr_kume_birlesim(long long a_ptr, long long b_ptr) {
     TrKume *a = (TrKume *)a_ptr;
     TrKume *b = (TrKume *)b_ptr;
     if (a) for (long long i = 0; i < a->kapasite; i++)
-        if (a->durumlar[i] == 1) _tr_kume_ekle(yeni, a->anahtarlar[i]);
+        if (_kume_dolu(a->durumlar[i])) _tr_kume_ekle(yeni, a->anahtarlar[i]);
     if (b) for (long long i = 0; i < b->kapasite; i++)
-        if (b->durumlar[i] == 1) _tr_kume_ekle(yeni, b->anahtarlar[i]);
+        if (_kume_dolu(b->durumlar[i])) _tr_kume_ekle(yeni, b->anahtarlar[i]);
     return yeni;
 }
 
@@ -114,7 +149,7 @@ long long _tr_kume_kesisim(long long a_ptr, long long b_ptr) {
     long long yeni = _tr_kume_yeni();
     TrKume *a = (TrKume *)a_ptr;
     if (a) for (long long i = 0; i < a->kapasite; i++)
-        if (a->durumlar[i] == 1 && _tr_kume_var_mi(b_ptr, a->anahtarlar[i]))
+        if (_kume_dolu(a->durumlar[i]) && _tr_kume_var_mi(b_ptr, a->anahtarlar[i]))
             _tr_kume_ekle(yeni, a->anahtarlar[i]);
     return yeni;
 }
@@ -123,7 +158,7 @@ long long _tr_kume_fark(long long a_ptr, long long b_ptr) {
     long long yeni = _tr_kume_yeni();
     TrKume *a = (TrKume *)a_ptr;
     if (a) for (long long i = 0; i < a->kapasite; i++)
-        if (a->durumlar[i] == 1 && !_tr_kume_var_mi(b_ptr, a->anahtarlar[i]))
+        if (_kume_dolu(a->durumlar[i]) && !_tr_kume_var_mi(b_ptr, a->anahtarlar[i]))
             _tr_kume_ekle(yeni, a->anahtarlar[i]);
     return yeni;
 }
@@ -134,7 +169,7 @@ void _tr_kume_yazdir(long long kume_ptr) {
     printf("{");
     int ilk = 1;
     for (long long i = 0; i < k->kapasite; i++) {
-        if (k->durumlar[i] == 1) {
+        if (_kume_dolu(k->durumlar[i])) {
             if (!ilk) printf(", ");
             printf("%lld", k->anahtarlar[i]);
             ilk = 0;
@@ -1,127 +1,584 @@
 /* Paralel modülü — çalışma zamanı implementasyonu */
 #define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE
 #include <stdlib.h>
+#include <limits.h>
 #include <string.h>
 #include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
 #include "runtime.h"
 
 /* ========== MODUL 5: Paralel (pthreads) ========== */
 
-typedef struct {
-    long long (*fn)(void);
-    long long sonuç;
-} _TrIsVeri;
+/*
+ * İş havuzu: iş_oluştur / bekle ile başlatılan görevler her seferinde yeni
+ * iş parçacığı açmak yerine çekirdek başına bir işçiden oluşan, ilk görevde
+ * kurulan havuzda çalışır. Her işçinin kendi Chase-Lev kuyruğu vardır: işçi
+ * kendi ucundan kilitsiz ekler/alır, boşta kalan işçiler diğerlerinin öbür
+ * ucundan çalar. İşçi olmayan iş parçacıklarının görevleri kilitli ortak
+ * kuyruğa girer. İşçi sayısı TR_IS_SAYISI ile ayarlanır.
+ *
+ * Görev kanal ya da kilit beklerken işçisi de bekler; kuyruktaki görevler
+ * (ör. beklenen değeri gönderecek olan) aç kalmasın diye engellenen her
+ * havuz iş parçacığı için bir yedek işçi açılır. Yedekler, engel kalktıkça
+ * kendiliğinden sonlanır.
+ */
 
-/* Parametreli async için genişletilmiş yapı */
-typedef struct {
+#define HAVUZ_MAKS_ISCI     256
+#define KUYRUK_BASLANGIC    256
+
+/* Görev tek ayırımdır; tutamaç görevin kendisidir. Kuyruktaki görevi
+ * bekleyen de çalıştırabileceğinden çalıştıran alindi'yi ilk çeviren olur;
+ * kuyruk girdisi ve tutamaç ayrı birer referanstır, sonuncusu bırakır. */
+typedef struct _TrGorev {
     void *fn_ptr;
-    long long args[8];  /* max 8 parametre */
+    long long args[4];
     int arg_count;
+    int bitti;                  /* atomik: sonuç yazıldı */
+    int alindi;                 /* atomik: biri çalıştırmaya başladı */
+    int ref;                    /* atomik */
     long long sonuç;
-} _TrAsyncVeri;
+    struct _TrGorev *sonraki;   /* ortak kuyruk bağı */
+} _TrGorev;
+
+/* Chase-Lev kuyruğu. Büyütülen eski diziler, hâlâ okuyan hırsız
+ * olabileceğinden serbest bırakılmaz (boyut her seferinde ikiye katlanır). */
+typedef struct {
+    long long boyut;
+    _TrGorev *yuva[];
+} _TrKuyrukDizi;
+
+typedef struct {
+    long long ust;              /* hırsızlar buradan alır */
+    char _dolgu1[56];
+    long long alt;              /* sahibi buraya ekler/buradan alır */
+    _TrKuyrukDizi *dizi;
+    char _dolgu2[48];
+} _TrKuyruk;
+
+static struct {
+    int isci_sayisi;
+    _TrKuyruk *kuyruklar;
+
+    /* Ortak kuyruk ve uyuyan işçiler/bekleyenler */
+    pthread_mutex_t kilit;
+    pthread_cond_t is_var;
+    pthread_cond_t gorev_bitti;
+    _TrGorev *ortak_bas, *ortak_son;
+    int ortak_sayi;             /* atomik okunur */
+    int uyuyan;                 /* atomik */
+    int bekleyen;               /* atomik */
+    int engelli;                /* atomik: kanal/kilit bekleyen havuz iş parçacığı */
+    int yedek;                  /* atomik: canlı yedek işçi */
+} havuz;
+
+static pthread_once_t havuz_kuruldu = PTHREAD_ONCE_INIT;
+static _Thread_local int isci_no = -1;
+static _Thread_local unsigned int calma_tohum = 0;
+static _Thread_local int havuz_iscisi = 0;     /* işçi ya da yedek */
+
+static _TrKuyrukDizi *kuyruk_dizi_ayir(long long boyut) {
+    _TrKuyrukDizi *d = malloc(sizeof(_TrKuyrukDizi) + boyut * sizeof(_TrGorev *));
+    if (d) d->boyut = boyut;
+    return d;
+}
+
+/* Sahibi: alt uca ekle */
+static int kuyruk_ekle(_TrKuyruk *q, _TrGorev *g) {
+    long long b = __atomic_load_n(&q->alt, __ATOMIC_RELAXED);
+    long long t = __atomic_load_n(&q->ust, __ATOMIC_ACQUIRE);
+    _TrKuyrukDizi *d = __atomic_load_n(&q->dizi, __ATOMIC_RELAXED);
+    if (b - t > d->boyut - 1) {
+        _TrKuyrukDizi *yeni = kuyruk_dizi_ayir(d->boyut * 2);
+        if (!yeni) return -1;
+        for (long long i = t; i < b; i++)
+            yeni->yuva[i & (yeni->boyut - 1)] = d->yuva[i & (d->boyut - 1)];
+        __atomic_store_n(&q->dizi, yeni, __ATOMIC_RELEASE);
+        d = yeni;
+    }
+    __atomic_store_n(&d->yuva[b & (d->boyut - 1)], g, __ATOMIC_RELAXED);
+    __atomic_store_n(&q->alt, b + 1, __ATOMIC_RELEASE);
+    return 0;
+}
+
+/* Sahibi: alt uçtan al (son eklenen) */
+static _TrGorev *kuyruk_al(_TrKuyruk *q) {
+    long long b = __atomic_load_n(&q->alt, __ATOMIC_RELAXED) - 1;
+    _TrKuyrukDizi *d = __atomic_load_n(&q->dizi, __ATOMIC_RELAXED);
+    __atomic_store_n(&q->alt, b, __ATOMIC_SEQ_CST);
+    long long t = __atomic_load_n(&q->ust, __ATOMIC_SEQ_CST);
+    _TrGorev *g = NULL;
+    if (t <= b) {
+        g = __atomic_load_n(&d->yuva[b & (d->boyut - 1)], __ATOMIC_RELAXED);
+        if (t == b) {
+            /* Son eleman: hırsızlarla yarış */
+            if (!__atomic_compare_exchange_n(&q->ust, &t, t + 1, 0,
+                                             __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+                g = NULL;
+            __atomic_store_n(&q->alt, b + 1, __ATOMIC_RELAXED);
+        }
+    } else {
+        __atomic_store_n(&q->alt, b + 1, __ATOMIC_RELAXED);
+    }
+    return g;
+}
+
+/* Hırsız: üst uçtan al (en eski) */
+static _TrGorev *kuyruk_cal(_TrKuyruk *q) {
+    long long t = __atomic_load_n(&q->ust, __ATOMIC_SEQ_CST);
+    long long b = __atomic_load_n(&q->alt, __ATOMIC_SEQ_CST);
+    if (t >= b) return NULL;
+    _TrKuyrukDizi *d = __atomic_load_n(&q->dizi, __ATOMIC_ACQUIRE);
+    _TrGorev *g = __atomic_load_n(&d->yuva[t & (d->boyut - 1)], __ATOMIC_RELAXED);
+    if (!__atomic_compare_exchange_n(&q->ust, &t, t + 1, 0,
+                                     __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+        return NULL;
+    return g;
+}
+
+static _TrGorev *ortak_al(void) {
+    if (__atomic_load_n(&havuz.ortak_sayi, __ATOMIC_SEQ_CST) == 0) return NULL;
+    pthread_mutex_lock(&havuz.kilit);
+    _TrGorev *g = havuz.ortak_bas;
+    if (g) {
+        havuz.ortak_bas = g->sonraki;
+        if (!havuz.ortak_bas) havuz.ortak_son = NULL;
+        __atomic_sub_fetch(&havuz.ortak_sayi, 1, __ATOMIC_SEQ_CST);
+    }
+    pthread_mutex_unlock(&havuz.kilit);
+    return g;
+}
+
+/* Çalıştırılacak bir görev bul: kendi kuyruğu, ortak kuyruk, sonra çalma */
+static _TrGorev *gorev_bul(void) {
+    _TrGorev *g;
+    if (isci_no >= 0 && (g = kuyruk_al(&havuz.kuyruklar[isci_no])) != NULL) return g;
+    if ((g = ortak_al()) != NULL) return g;
+    int n = havuz.isci_sayisi;
+    unsigned int r = calma_tohum;
+    r ^= r << 13; r ^= r >> 17; r ^= r << 5;
+    calma_tohum = r;
+    for (int i = 0; i < n; i++) {
+        int kurban = (int)((r + (unsigned int)i) % (unsigned int)n);
+        if (kurban == isci_no) continue;
+        if ((g = kuyruk_cal(&havuz.kuyruklar[kurban])) != NULL) return g;
+    }
+    return NULL;
+}
+
+/* Kuyruklarda görünür iş var mı (uyumadan önce yeniden bakmak için) */
+static int is_var_mi(void) {
+    if (__atomic_load_n(&havuz.ortak_sayi, __ATOMIC_SEQ_CST) > 0) return 1;
+    for (int i = 0; i < havuz.isci_sayisi; i++) {
+        _TrKuyruk *q = &havuz.kuyruklar[i];
+        if (__atomic_load_n(&q->alt, __ATOMIC_SEQ_CST) >
+            __atomic_load_n(&q->ust, __ATOMIC_SEQ_CST))
+            return 1;
+    }
+    return 0;
+}
+
+static void gorev_calistir(_TrGorev *g) {
+    void *f = g->fn_ptr;
+    long long *a = g->args;
+    long long sonuç;
+    switch (g->arg_count) {
+        case 0: sonuç = ((long long (*)(void))f)(); break;
+        case 1: sonuç = ((long long (*)(long long))f)(a[0]); break;
+        case 2: sonuç = ((long long (*)(long long, long long))f)(a[0], a[1]); break;
+        case 3: sonuç = ((long long (*)(long long, long long, long long))f)(a[0], a[1], a[2]); break;
+        case 4: sonuç = ((long long (*)(long long, long long, long long, long long))f)(a[0], a[1], a[2], a[3]); break;
+        default: sonuç = 0; break;
+    }
+    g->sonuç = sonuç;
+    __atomic_store_n(&g->bitti, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&havuz.bekleyen, __ATOMIC_SEQ_CST) > 0) {
+        pthread_mutex_lock(&havuz.kilit);
+        pthread_cond_broadcast(&havuz.gorev_bitti);
+        pthread_mutex_unlock(&havuz.kilit);
+    }
+}
+
+static void gorev_birak(_TrGorev *g) {
+    if (__atomic_sub_fetch(&g->ref, 1, __ATOMIC_ACQ_REL) == 0) free(g);
+}
+
+static int gorev_sahiplen(_TrGorev *g) {
+    return !__atomic_exchange_n(&g->alindi, 1, __ATOMIC_ACQ_REL);
+}
+
+/* Kuyruktan çıkan görevi, bekleyeni henüz almadıysa çalıştır */
+static void kuyruktan_calistir(_TrGorev *g) {
+    if (gorev_sahiplen(g)) gorev_calistir(g);
+    gorev_birak(g);
+}
 
-static void *_tr_is_fonksiyonu(void *arg) {
-    _TrIsVeri *veri = (_TrIsVeri *)arg;
-    veri->sonuç = veri->fn();
+static void *isci_dongusu(void *arg) {
+    isci_no = (int)(long)arg;
+    havuz_iscisi = 1;
+    calma_tohum = 2463534242u + (unsigned int)isci_no * 2654435761u;
+    for (;;) {
+        _TrGorev *g = gorev_bul();
+        if (g) {
+            kuyruktan_calistir(g);
+            continue;
+        }
+        pthread_mutex_lock(&havuz.kilit);
+        __atomic_add_fetch(&havuz.uyuyan, 1, __ATOMIC_SEQ_CST);
+        if (!is_var_mi()) pthread_cond_wait(&havuz.is_var, &havuz.kilit);
+        __atomic_sub_fetch(&havuz.uyuyan, 1, __ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&havuz.kilit);
+    }
     return NULL;
 }
 
-/* Parametreli async thread fonksiyonu */
-static void *_tr_async_fonksiyonu(void *arg) {
-    _TrAsyncVeri *veri = (_TrAsyncVeri *)arg;
-    long long (*fn0)(void) = (long long (*)(void))veri->fn_ptr;
-    long long (*fn1)(long long) = (long long (*)(long long))veri->fn_ptr;
-    long long (*fn2)(long long, long long) = (long long (*)(long long, long long))veri->fn_ptr;
-    long long (*fn3)(long long, long long, long long) = (long long (*)(long long, long long, long long))veri->fn_ptr;
+/* Yedek işçi: kendi kuyruğu yoktur, ortak kuyruktan ve çalarak çalışır.
+ * Engelli sayısı yedek sayısının altında kaldığı sürece bir süre boşta
+ * bekler (sık engellenen kanallarda sürekli iş parçacığı açılmasın), sonra
+ * sonlanır. */
+#define YEDEK_BEKLEME_MS    50
 
-    switch (veri->arg_count) {
-        case 0: veri->sonuç = fn0(); break;
-        case 1: veri->sonuç = fn1(veri->args[0]); break;
-        case 2: veri->sonuç = fn2(veri->args[0], veri->args[1]); break;
-        case 3: veri->sonuç = fn3(veri->args[0], veri->args[1], veri->args[2]); break;
-        default: veri->sonuç = 0; break;
+static void *yedek_dongusu(void *arg) {
+    (void)arg;
+    havuz_iscisi = 1;
+    calma_tohum = 2654435761u ^ (unsigned int)(unsigned long)&arg;
+    for (;;) {
+        _TrGorev *g = gorev_bul();
+        if (g) {
+            kuyruktan_calistir(g);
+            continue;
+        }
+        pthread_mutex_lock(&havuz.kilit);
+        int cik = 0;
+        __atomic_add_fetch(&havuz.uyuyan, 1, __ATOMIC_SEQ_CST);
+        if (!is_var_mi()) {
+            if (__atomic_load_n(&havuz.engelli, __ATOMIC_SEQ_CST) >=
+                __atomic_load_n(&havuz.yedek, __ATOMIC_SEQ_CST)) {
+                pthread_cond_wait(&havuz.is_var, &havuz.kilit);
+            } else {
+                struct timespec son;
+                clock_gettime(CLOCK_REALTIME, &son);
+                son.tv_nsec += YEDEK_BEKLEME_MS * 1000000L;
+                if (son.tv_nsec >= 1000000000L) {
+                    son.tv_sec++;
+                    son.tv_nsec -= 1000000000L;
+                }
+                if (pthread_cond_timedwait(&havuz.is_var, &havuz.kilit, &son) != 0 &&
+                    !is_var_mi()) {
+                    int y = __atomic_load_n(&havuz.yedek, __ATOMIC_SEQ_CST);
+                    cik = __atomic_load_n(&havuz.engelli, __ATOMIC_SEQ_CST) < y &&
+                          __atomic_compare_exchange_n(&havuz.yedek, &y, y - 1, 0,
+                                                      __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+                }
+            }
+        }
+        __atomic_sub_fetch(&havuz.uyuyan, 1, __ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&havuz.kilit);
+        if (cik) break;
     }
     return NULL;
 }
 
-/* is_olustur(fonk_ptr) -> tam (thread id / handle) */
-long long _tr_is_olustur(long long fn_ptr) {
-    _TrIsVeri *veri = (_TrIsVeri *)malloc(sizeof(_TrIsVeri));
-    if (!veri) return 0;
-    veri->fn = (long long (*)(void))fn_ptr;
-    veri->sonuç = 0;
+/* Üretilen kod çalışma zamanı işlevlerini yığın 16'ya hizalı olmadan da
+ * çağırabilir; pthread_create (TLS ayırımı) hizalı yığın ister */
+#if defined(__x86_64__) || defined(__i386__)
+#define YIGIN_HIZALA __attribute__((noinline, force_align_arg_pointer))
+#else
+#define YIGIN_HIZALA __attribute__((noinline))
+#endif
+
+static YIGIN_HIZALA void yedek_ac(void) {
+    __atomic_add_fetch(&havuz.yedek, 1, __ATOMIC_SEQ_CST);
+    pthread_attr_t ozellik;
+    pthread_t tid;
+    pthread_attr_init(&ozellik);
+    pthread_attr_setdetachstate(&ozellik, PTHREAD_CREATE_DETACHED);
+    if (pthread_create(&tid, &ozellik, yedek_dongusu, NULL) != 0)
+        __atomic_sub_fetch(&havuz.yedek, 1, __ATOMIC_SEQ_CST);
+    pthread_attr_destroy(&ozellik);
+}
+
+/* Havuz iş parçacığı kanal/kilit beklemeye giriyor: gerekirse yedek aç */
+static void engel_basla(void) {
+    if (!havuz_iscisi) return;
+    int e = __atomic_add_fetch(&havuz.engelli, 1, __ATOMIC_SEQ_CST);
+    if (e > __atomic_load_n(&havuz.yedek, __ATOMIC_SEQ_CST)) yedek_ac();
+}
+
+static void engel_bitir(void) {
+    if (havuz_iscisi) __atomic_sub_fetch(&havuz.engelli, 1, __ATOMIC_SEQ_CST);
+}
+
+static void havuz_kur(void) {
+    int n = 0;
+    const char *e = getenv("TR_IS_SAYISI");
+    if (e) n = atoi(e);
+    if (n <= 0) n = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (n <= 0) n = 1;
+    if (n > HAVUZ_MAKS_ISCI) n = HAVUZ_MAKS_ISCI;
 
-    pthread_t *tid = (pthread_t *)malloc(sizeof(pthread_t));
-    if (!tid) { free(veri); return 0; }
+    pthread_mutex_init(&havuz.kilit, NULL);
+    pthread_cond_init(&havuz.is_var, NULL);
+    pthread_cond_init(&havuz.gorev_bitti, NULL);
+    havuz.kuyruklar = calloc(n, sizeof(_TrKuyruk));
+    if (!havuz.kuyruklar) return;
+    for (int i = 0; i < n; i++) {
+        havuz.kuyruklar[i].dizi = kuyruk_dizi_ayir(KUYRUK_BASLANGIC);
+        if (!havuz.kuyruklar[i].dizi) return;
+    }
 
-    if (pthread_create(tid, NULL, _tr_is_fonksiyonu, veri) != 0) {
-        free(veri); free(tid);
-        return 0;
+    /* İşçiler başlamadan önce görünmeli; başlatılamayanların kuyrukları
+     * yalnızca boş kalır */
+    havuz.isci_sayisi = n;
+    pthread_attr_t ozellik;
+    pthread_attr_init(&ozellik);
+    pthread_attr_setdetachstate(&ozellik, PTHREAD_CREATE_DETACHED);
+    int baslayan = 0;
+    for (int i = 0; i < n; i++) {
+        pthread_t tid;
+        if (pthread_create(&tid, &ozellik, isci_dongusu, (void *)(long)i) == 0) baslayan++;
     }
+    pthread_attr_destroy(&ozellik);
+    if (baslayan == 0) havuz.isci_sayisi = 0;
+}
 
-    /* tid ve veri'yi bir struct'ta paketleyelim */
-    /* Basitlik icin: 16 byte = [pthread_t, veri_ptr] */
-    long long *handle = (long long *)malloc(2 * sizeof(long long));
-    if (!handle) return 0;
-    handle[0] = (long long)*tid;
-    handle[1] = (long long)veri;
-    return (long long)handle;
+/* Görevi havuza gönder; havuz kurulamadıysa çağıran iş parçacığında çalıştır */
+static long long gorev_gonder(_TrGorev *g) {
+    pthread_once(&havuz_kuruldu, havuz_kur);
+    if (havuz.isci_sayisi == 0) {
+        g->alindi = 1;
+        g->ref = 1;
+        gorev_calistir(g);
+        return (long long)g;
+    }
+    g->alindi = 0;
+    g->ref = 2;
+    if (isci_no < 0 || kuyruk_ekle(&havuz.kuyruklar[isci_no], g) != 0) {
+        g->sonraki = NULL;
+        pthread_mutex_lock(&havuz.kilit);
+        if (havuz.ortak_son) havuz.ortak_son->sonraki = g;
+        else havuz.ortak_bas = g;
+        havuz.ortak_son = g;
+        __atomic_add_fetch(&havuz.ortak_sayi, 1, __ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&havuz.kilit);
+    }
+    if (__atomic_load_n(&havuz.uyuyan, __ATOMIC_SEQ_CST) > 0) {
+        pthread_mutex_lock(&havuz.kilit);
+        pthread_cond_signal(&havuz.is_var);
+        pthread_mutex_unlock(&havuz.kilit);
+    }
+    return (long long)g;
+}
+
+/* Görev bitene kadar bekle. Henüz kimse başlamadıysa görev (ve içinden
+ * beklenen alt görevleri) burada çalışır; kuyruktaki ilgisiz görevler
+ * alınmaz, çünkü bekleyen onların isteyeceği bir kilidi tutuyor olabilir. */
+static void gorev_bitmesini_bekle(_TrGorev *g) {
+    /* İşçi az önce eklediği görevi beklerken girdiyi de kuyruktan çıkarır;
+     * alttaki başka bir görevse geri konur (yer açıldığından büyütmez) */
+    if (isci_no >= 0) {
+        _TrKuyruk *q = &havuz.kuyruklar[isci_no];
+        _TrGorev *alt = kuyruk_al(q);
+        if (alt == g) kuyruktan_calistir(g);
+        else if (alt) kuyruk_ekle(q, alt);
+    }
+    if (gorev_sahiplen(g)) {
+        gorev_calistir(g);
+        return;
+    }
+    while (!__atomic_load_n(&g->bitti, __ATOMIC_ACQUIRE)) {
+        pthread_mutex_lock(&havuz.kilit);
+        __atomic_add_fetch(&havuz.bekleyen, 1, __ATOMIC_SEQ_CST);
+        if (!__atomic_load_n(&g->bitti, __ATOMIC_SEQ_CST))
+            pthread_cond_wait(&havuz.gorev_bitti, &havuz.kilit);
+        __atomic_sub_fetch(&havuz.bekleyen, 1, __ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&havuz.kilit);
+    }
+}
+
+/* Bekle, sonucu döndür ve tutamacı bırak */
+static long long gorev_bekle(_TrGorev *g) {
+    gorev_bitmesini_bekle(g);
+    long long sonuç = g->sonuç;
+    gorev_birak(g);
+    return sonuç;
+}
+
+/* is_olustur(kapanış) -> tam (görev tutamacı); kapanış köprü üzerinden
+ * çağrılır */
+long long _tr_is_olustur(const long long *kapanis) {
+    _TrGorev *g = (_TrGorev *)calloc(1, sizeof(_TrGorev));
+    if (!g) return 0;
+    g->fn_ptr = (void *)_tr_kapanis_cagir0;
+    g->arg_count = 1;
+    g->args[0] = (long long)kapanis;
+    return gorev_gonder(g);
 }
 
 /* is_bekle(is: tam) -> tam (sonuç) */
 long long _tr_is_bekle(long long handle_ptr) {
     if (handle_ptr == 0) return 0;
-    long long *handle = (long long *)handle_ptr;
-    pthread_t tid = (pthread_t)handle[0];
-    _TrIsVeri *veri = (_TrIsVeri *)handle[1];
-
-    pthread_join(tid, NULL);
-    long long sonuç = veri->sonuç;
-    free(veri);
-    free(handle);
-    return sonuç;
+    return gorev_bekle((_TrGorev *)handle_ptr);
 }
 
 /* Parametreli async oluştur: _tr_async_olustur(fn_ptr, arg_count, arg0, arg1, ...) */
 long long _tr_async_olustur(long long fn_ptr, long long arg_count,
                             long long a0, long long a1, long long a2, long long a3) {
-    _TrAsyncVeri *veri = (_TrAsyncVeri *)malloc(sizeof(_TrAsyncVeri));
-    if (!veri) return 0;
-    veri->fn_ptr = (void *)fn_ptr;
-    veri->arg_count = (int)arg_count;
-    veri->args[0] = a0;
-    veri->args[1] = a1;
-    veri->args[2] = a2;
-    veri->args[3] = a3;
-    veri->sonuç = 0;
+    _TrGorev *g = (_TrGorev *)calloc(1, sizeof(_TrGorev));
+    if (!g) return 0;
+    g->fn_ptr = (void *)fn_ptr;
+    g->arg_count = (int)arg_count;
+    g->args[0] = a0;
+    g->args[1] = a1;
+    g->args[2] = a2;
+    g->args[3] = a3;
+    return gorev_gonder(g);
+}
+
+/* Parametreli async bekle */
+long long _tr_async_bekle(long long handle_ptr) {
+    if (handle_ptr == 0) return 0;
+    return gorev_bekle((_TrGorev *)handle_ptr);
+}
+
+/*
+ * paralel her...için: [0, sayi) aralığı parçalara bölünür, her parça
+ * govde(ortam, bas, son, kismi) olarak havuzda çalışır (ilk parça çağıran
+ * iş parçacığında). kismi[] parçanın indirgeme değerleridir; birim
+ * değerle başlar, sonunda sırayla indirgeme[]'ye katılır. İşlem kodları:
+ * 0 topla, 1 en küçük, 2 en büyük.
+ */
+#define PARALEL_PARCA_ISCI_BASINA  4
+#define PARALEL_MAKS_INDIRGEME     4
+
+static long long indirgeme_birimi(long long islem) {
+    if (islem == 1) return LLONG_MAX;
+    if (islem == 2) return LLONG_MIN;
+    return 0;
+}
+
+static long long indirgeme_kat(long long islem, long long a, long long b) {
+    if (islem == 1) return b < a ? b : a;
+    if (islem == 2) return b > a ? b : a;
+    return (long long)((unsigned long long)a + (unsigned long long)b);
+}
+
+/* Gövdeyi [0, sayi) için tek parça olarak bu iş parçacığında çalıştır */
+static void paralel_tek_parca(long long govde, long long ortam, long long sayi,
+                              long long *indirgeme, const long long *islemler,
+                              long long indirgeme_sayisi) {
+    long long tek[PARALEL_MAKS_INDIRGEME];
+    for (long long k = 0; k < indirgeme_sayisi; k++) tek[k] = indirgeme_birimi(islemler[k]);
+    ((long long (*)(long long, long long, long long, long long))govde)(
+        ortam, 0, sayi, (long long)tek);
+    for (long long k = 0; k < indirgeme_sayisi; k++)
+        indirgeme[k] = indirgeme_kat(islemler[k], indirgeme[k], tek[k]);
+}
+
+void _tr_paralel_her(long long govde, long long ortam, long long sayi,
+                     long long *indirgeme, const long long *islemler,
+                     long long indirgeme_sayisi) {
+    if (sayi <= 0) return;
+    if (indirgeme_sayisi > PARALEL_MAKS_INDIRGEME) indirgeme_sayisi = PARALEL_MAKS_INDIRGEME;
+    pthread_once(&havuz_kuruldu, havuz_kur);
 
-    pthread_t *tid = (pthread_t *)malloc(sizeof(pthread_t));
-    if (!tid) { free(veri); return 0; }
+    long long parca = (long long)havuz.isci_sayisi * PARALEL_PARCA_ISCI_BASINA;
+    if (parca < 1) parca = 1;
+    if (parca > sayi) parca = sayi;
 
-    if (pthread_create(tid, NULL, _tr_async_fonksiyonu, veri) != 0) {
-        free(veri); free(tid);
-        return 0;
+    /* Parçalar ayrı ayrı ayrılır: burada çalıştırılan parçanın kuyruk
+     * girdisi bu işlev döndükten sonra da çıkarılabilir */
+    _TrGorev **gorevler = calloc((size_t)parca, sizeof(_TrGorev *));
+    long long *kismi = malloc((size_t)(parca * PARALEL_MAKS_INDIRGEME) * sizeof(long long));
+    int tamam = gorevler && kismi;
+    for (long long p = 0; tamam && p < parca; p++)
+        tamam = (gorevler[p] = calloc(1, sizeof(_TrGorev))) != NULL;
+    if (!tamam) {
+        /* Bellek yoksa tek parça olarak burada çalıştır */
+        for (long long p = 0; gorevler && p < parca; p++) free(gorevler[p]);
+        free(gorevler);
+        free(kismi);
+        paralel_tek_parca(govde, ortam, sayi, indirgeme, islemler, indirgeme_sayisi);
+        return;
+    }
+
+    for (long long p = 0; p < parca; p++) {
+        long long *pk = kismi + p * PARALEL_MAKS_INDIRGEME;
+        for (long long k = 0; k < indirgeme_sayisi; k++) pk[k] = indirgeme_birimi(islemler[k]);
+        _TrGorev *g = gorevler[p];
+        g->fn_ptr = (void *)govde;
+        g->arg_count = 4;
+        g->args[0] = ortam;
+        g->args[1] = sayi * p / parca;
+        g->args[2] = sayi * (p + 1) / parca;
+        g->args[3] = (long long)pk;
+    }
+    for (long long p = parca - 1; p >= 1; p--) gorev_gonder(gorevler[p]);
+    gorev_calistir(gorevler[0]);
+    free(gorevler[0]);
+    for (long long p = 1; p < parca; p++) {
+        gorev_bitmesini_bekle(gorevler[p]);
+        gorev_birak(gorevler[p]);
     }
 
-    /* Handle: [pthread_t, veri_ptr] */
-    long long *handle = (long long *)malloc(2 * sizeof(long long));
-    if (!handle) return 0;
-    handle[0] = (long long)*tid;
-    handle[1] = (long long)veri;
-    return (long long)handle;
+    for (long long p = 0; p < parca; p++) {
+        for (long long k = 0; k < indirgeme_sayisi; k++)
+            indirgeme[k] = indirgeme_kat(islemler[k], indirgeme[k],
+                                         kismi[p * PARALEL_MAKS_INDIRGEME + k]);
+    }
+    free(kismi);
+    free(gorevler);
 }
 
-/* Parametreli async bekle */
-long long _tr_async_bekle(long long handle_ptr) {
-    if (handle_ptr == 0) return 0;
-    long long *handle = (long long *)handle_ptr;
-    pthread_t tid = (pthread_t)handle[0];
-    _TrAsyncVeri *veri = (_TrAsyncVeri *)handle[1];
-
-    pthread_join(tid, NULL);
-    long long sonuç = veri->sonuç;
-    free(veri);
-    free(handle);
+/* Gövde paylaşılan dizilere döngü elemanıyla (d[x] = ...) yazıyor: ortam[0]
+ * yinelenen dizidir. Elemanlar kesin artan ya da kesin azalansa her
+ * yineleme ayrı bir yuvaya yazar ve parçalar paralel çalışabilir; değilse
+ * iki yineleme aynı yuvada yarışabilir, döngü sırayla çalışır. */
+void _tr_paralel_her_eleman(long long govde, long long ortam, long long sayi,
+                            long long *indirgeme, const long long *islemler,
+                            long long indirgeme_sayisi) {
+    if (sayi <= 0) return;
+    if (indirgeme_sayisi > PARALEL_MAKS_INDIRGEME) indirgeme_sayisi = PARALEL_MAKS_INDIRGEME;
+    const long long *e = *(const long long **)ortam;
+    int artan = 1, azalan = 1;
+    for (long long i = 1; i < sayi && (artan || azalan); i++) {
+        if (e[i] <= e[i - 1]) artan = 0;
+        if (e[i] >= e[i - 1]) azalan = 0;
+    }
+    if (artan || azalan) {
+        _tr_paralel_her(govde, ortam, sayi, indirgeme, islemler, indirgeme_sayisi);
+    } else {
+        paralel_tek_parca(govde, ortam, sayi, indirgeme, islemler, indirgeme_sayisi);
+    }
+}
+
+/* Yinelemeler arasında ayrıklığı kanıtlanamayan paylaşılan yazma var
+ * (anlam.c): gövde tek parça olarak sırayla çalışır */
+void _tr_paralel_her_sirali(long long govde, long long ortam, long long sayi,
+                            long long *indirgeme, const long long *islemler,
+                            long long indirgeme_sayisi) {
+    if (sayi <= 0) return;
+    if (indirgeme_sayisi > PARALEL_MAKS_INDIRGEME) indirgeme_sayisi = PARALEL_MAKS_INDIRGEME;
+    paralel_tek_parca(govde, ortam, sayi, indirgeme, islemler, indirgeme_sayisi);
+}
+
+/* paylaş(nesne: tam) -> tam
+ * Nesneyi başka iş parçacığına devretmeden önce işaretler; bundan sonra
+ * referans sayacı atomik güncellenir. Aynı handle'ı döndürür; yönetilen
+ * nesne olmayan değerler (düz tam sayılar) olduğu gibi geçer. */
+long long _tr_paylas(long long nesne) {
+    _tr_nesne_paylas((void *)nesne);
+    return nesne;
+}
+
+/* dizi_paylaş(d: dizi) -> dizi */
+TrDizi _tr_dizi_paylas(long long *ptr, long long count) {
+    _tr_nesne_paylas(ptr);
+    TrDizi sonuç = {ptr, count};
     return sonuç;
 }
 
@@ -136,7 +593,11 @@ long long _tr_kilit_olustur(void) {
 /* kilitle(kilit: tam) */
 void _tr_kilitle(long long kilit_ptr) {
     if (kilit_ptr == 0) return;
-    pthread_mutex_lock((pthread_mutex_t *)kilit_ptr);
+    pthread_mutex_t *mtx = (pthread_mutex_t *)kilit_ptr;
+    if (pthread_mutex_trylock(mtx) == 0) return;
+    engel_basla();
+    pthread_mutex_lock(mtx);
+    engel_bitir();
 }
 
 /* kilit_birak(kilit: tam) */
@@ -144,3 +605,404 @@ void _tr_kilit_birak(long long kilit_ptr) {
     if (kilit_ptr == 0) return;
     pthread_mutex_unlock((pthread_mutex_t *)kilit_ptr);
 }
+
+/*
+ * Kanallar: iş parçacıkları arasında tam değer taşıyan çok üreticili /
+ * çok tüketicili kuyruklar. Sınırlı kanal sabit boyutlu halka üzerinde
+ * (her hücrede sıra numarası), sınırsız kanal 31 yuvalık bloklardan oluşan
+ * bağlı liste üzerinde çalışır; her iki uçta da kilit yoktur. Boş kanaldan
+ * alan ya da dolu kanala gönderen iş parçacığı kısa bir dönmeden sonra
+ * futex üzerinde uyur; karşı uç yalnızca uyuyan varsa sistem çağrısı yapar.
+ */
+
+#define KANAL_DONME         32      /* uyumadan önce deneme sayısı */
+#define KANAL_BLOK_YUVA     31      /* sınırsız kanalda blok başına yuva */
+#define KANAL_BLOK_ARALIK   32      /* sıra numarasında blok adımı */
+#define KANAL_KAYDIR        1       /* sıra numarasının alt biti bayraktır */
+#define KANAL_SONRAKI_VAR   1       /* alıcı ucu: sonraki blok kuruldu */
+
+enum { YUVA_YAZILDI = 1, YUVA_OKUNDU = 2, YUVA_SIL = 4 };
+
+typedef struct {
+    long long deger;
+    int durum;                  /* atomik: YUVA_* bitleri */
+} _TrKanalYuva;
+
+typedef struct _TrKanalBlok {
+    struct _TrKanalBlok *sonraki;
+    _TrKanalYuva yuvalar[KANAL_BLOK_YUVA];
+} _TrKanalBlok;
+
+/* Sınırlı kanal hücresi: sira == 2*konum ise boş, 2*konum+1 ise dolu */
+typedef struct {
+    long long sira;
+    long long deger;
+} _TrKanalHucre;
+
+typedef struct {
+    long long bas;              /* alıcı konumu */
+    _TrKanalBlok *bas_blok;
+    char _dolgu1[48];
+    long long son;              /* gönderici konumu */
+    _TrKanalBlok *son_blok;
+    char _dolgu2[48];
+    long long kapasite;         /* 0: sınırsız */
+    _TrKanalHucre *hucreler;
+    int kapali;                 /* atomik */
+    int gonderen;               /* atomik: kapalı denetimini geçip yazmakta */
+    unsigned int veri_olayi;    /* futex: değer eklendi / kapandı */
+    unsigned int yer_olayi;     /* futex: yer açıldı / kapandı */
+    int bekleyen_alici;         /* atomik */
+    int bekleyen_gonderici;     /* atomik */
+} _TrKanal;
+
+/* Karşı ucun yarım kalan işini bekle: önce işlemciyi bırakmadan dön,
+ * uzarsa (ör. karşı taraf kesildiyse) zaman dilimini ver */
+static void kanal_don(int *tur) {
+    if (++*tur < 16) {
+#if defined(__x86_64__) || defined(__i386__)
+        __asm__ __volatile__("pause");
+#elif defined(__aarch64__)
+        __asm__ __volatile__("yield");
+#endif
+    } else {
+        sched_yield();
+    }
+}
+
+static void kanal_uyu(unsigned int *olay, unsigned int beklenen) {
+    engel_basla();
+    syscall(SYS_futex, olay, FUTEX_WAIT_PRIVATE, beklenen, NULL, NULL, 0);
+    engel_bitir();
+}
+
+static void kanal_uyandir(unsigned int *olay, int *bekleyen, int hepsi) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(bekleyen, __ATOMIC_SEQ_CST) == 0) return;
+    __atomic_add_fetch(olay, 1, __ATOMIC_SEQ_CST);
+    syscall(SYS_futex, olay, FUTEX_WAKE_PRIVATE, hepsi ? INT_MAX : 1, NULL, NULL, 0);
+}
+
+/* ---- Sınırlı kanal ---- */
+
+static int sinirli_gonder(_TrKanal *k, long long deger) {
+    long long konum = __atomic_load_n(&k->son, __ATOMIC_RELAXED);
+    for (;;) {
+        _TrKanalHucre *h = &k->hucreler[konum % k->kapasite];
+        long long sira = __atomic_load_n(&h->sira, __ATOMIC_ACQUIRE);
+        long long fark = sira - 2 * konum;
+        if (fark == 0) {
+            if (__atomic_compare_exchange_n(&k->son, &konum, konum + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                h->deger = deger;
+                __atomic_store_n(&h->sira, 2 * konum + 1, __ATOMIC_RELEASE);
+                return 1;
+            }
+        } else if (fark < 0) {
+            return 0;           /* dolu */
+        } else {
+            konum = __atomic_load_n(&k->son, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static int sinirli_al(_TrKanal *k, long long *deger) {
+    long long konum = __atomic_load_n(&k->bas, __ATOMIC_RELAXED);
+    for (;;) {
+        _TrKanalHucre *h = &k->hucreler[konum % k->kapasite];
+        long long sira = __atomic_load_n(&h->sira, __ATOMIC_ACQUIRE);
+        long long fark = sira - (2 * konum + 1);
+        if (fark == 0) {
+            if (__atomic_compare_exchange_n(&k->bas, &konum, konum + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                *deger = h->deger;
+                __atomic_store_n(&h->sira, 2 * (konum + k->kapasite), __ATOMIC_RELEASE);
+                return 1;
+            }
+        } else if (fark < 0) {
+            return 0;           /* boş */
+        } else {
+            konum = __atomic_load_n(&k->bas, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/* ---- Sınırsız kanal ---- */
+
+static _TrKanalBlok *kanal_sonraki_blok(_TrKanalBlok *b) {
+    _TrKanalBlok *s;
+    int tur = 0;
+    while (!(s = __atomic_load_n(&b->sonraki, __ATOMIC_ACQUIRE))) kanal_don(&tur);
+    return s;
+}
+
+/* Bloğun son okuyucusu bırakır: baştan itibaren okunmamış yuva kalmışsa o
+ * yuvanın okuyucusu işi devralır */
+static void kanal_blok_birak(_TrKanalBlok *b, int bas) {
+    for (int i = bas; i < KANAL_BLOK_YUVA - 1; i++) {
+        _TrKanalYuva *y = &b->yuvalar[i];
+        if (!(__atomic_load_n(&y->durum, __ATOMIC_ACQUIRE) & YUVA_OKUNDU) &&
+            !(__atomic_fetch_or(&y->durum, YUVA_SIL, __ATOMIC_ACQ_REL) & YUVA_OKUNDU))
+            return;
+    }
+    free(b);
+}
+
+static int sinirsiz_gonder(_TrKanal *k, long long deger) {
+    long long son = __atomic_load_n(&k->son, __ATOMIC_ACQUIRE);
+    _TrKanalBlok *blok = __atomic_load_n(&k->son_blok, __ATOMIC_ACQUIRE);
+    _TrKanalBlok *yeni_blok = NULL;
+    int tur = 0;
+    for (;;) {
+        int yer = (int)((son >> KANAL_KAYDIR) % KANAL_BLOK_ARALIK);
+        /* Blok sonuna gelindi: başka gönderici sonraki bloğu kuruyor */
+        if (yer == KANAL_BLOK_YUVA) {
+            kanal_don(&tur);
+            son = __atomic_load_n(&k->son, __ATOMIC_ACQUIRE);
+            blok = __atomic_load_n(&k->son_blok, __ATOMIC_ACQUIRE);
+            continue;
+        }
+        if (yer + 1 == KANAL_BLOK_YUVA && !yeni_blok) {
+            yeni_blok = calloc(1, sizeof(_TrKanalBlok));
+            if (!yeni_blok) return 0;
+        }
+        /* İlk gönderim ilk bloğu kurar */
+        if (!blok) {
+            _TrKanalBlok *ilk = calloc(1, sizeof(_TrKanalBlok));
+            if (!ilk) {
+                free(yeni_blok);
+                return 0;
+            }
+            _TrKanalBlok *bos = NULL;
+            if (__atomic_compare_exchange_n(&k->son_blok, &bos, ilk, 0,
+                                            __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+                __atomic_store_n(&k->bas_blok, ilk, __ATOMIC_RELEASE);
+                blok = ilk;
+            } else {
+                free(ilk);
+                son = __atomic_load_n(&k->son, __ATOMIC_ACQUIRE);
+                blok = __atomic_load_n(&k->son_blok, __ATOMIC_ACQUIRE);
+                continue;
+            }
+        }
+        long long yeni_son = son + (1 << KANAL_KAYDIR);
+        if (__atomic_compare_exchange_n(&k->son, &son, yeni_son, 0,
+                                        __ATOMIC_SEQ_CST, __ATOMIC_ACQUIRE)) {
+            if (yer + 1 == KANAL_BLOK_YUVA) {
+                __atomic_store_n(&k->son_blok, yeni_blok, __ATOMIC_RELEASE);
+                __atomic_add_fetch(&k->son, 1 << KANAL_KAYDIR, __ATOMIC_RELEASE);
+                __atomic_store_n(&blok->sonraki, yeni_blok, __ATOMIC_RELEASE);
+                yeni_blok = NULL;
+            }
+            _TrKanalYuva *y = &blok->yuvalar[yer];
+            y->deger = deger;
+            __atomic_fetch_or(&y->durum, YUVA_YAZILDI, __ATOMIC_RELEASE);
+            free(yeni_blok);
+            return 1;
+        }
+        blok = __atomic_load_n(&k->son_blok, __ATOMIC_ACQUIRE);
+    }
+}
+
+static int sinirsiz_al(_TrKanal *k, long long *deger) {
+    long long bas = __atomic_load_n(&k->bas, __ATOMIC_ACQUIRE);
+    _TrKanalBlok *blok = __atomic_load_n(&k->bas_blok, __ATOMIC_ACQUIRE);
+    int tur = 0;
+    for (;;) {
+        int yer = (int)((bas >> KANAL_KAYDIR) % KANAL_BLOK_ARALIK);
+        if (yer == KANAL_BLOK_YUVA) {
+            kanal_don(&tur);
+            bas = __atomic_load_n(&k->bas, __ATOMIC_ACQUIRE);
+            blok = __atomic_load_n(&k->bas_blok, __ATOMIC_ACQUIRE);
+            continue;
+        }
+        long long yeni_bas = bas + (1 << KANAL_KAYDIR);
+        if (!(yeni_bas & KANAL_SONRAKI_VAR)) {
+            __atomic_thread_fence(__ATOMIC_SEQ_CST);
+            long long son = __atomic_load_n(&k->son, __ATOMIC_RELAXED);
+            if ((bas >> KANAL_KAYDIR) == (son >> KANAL_KAYDIR)) return 0;   /* boş */
+            if ((bas >> KANAL_KAYDIR) / KANAL_BLOK_ARALIK !=
+                (son >> KANAL_KAYDIR) / KANAL_BLOK_ARALIK)
+                yeni_bas |= KANAL_SONRAKI_VAR;
+        }
+        /* İlk blok henüz bağlanmadı */
+        if (!blok) {
+            kanal_don(&tur);
+            bas = __atomic_load_n(&k->bas, __ATOMIC_ACQUIRE);
+            blok = __atomic_load_n(&k->bas_blok, __ATOMIC_ACQUIRE);
+            continue;
+        }
+        if (__atomic_compare_exchange_n(&k->bas, &bas, yeni_bas, 0,
+                                        __ATOMIC_SEQ_CST, __ATOMIC_ACQUIRE)) {
+            if (yer + 1 == KANAL_BLOK_YUVA) {
+                _TrKanalBlok *sonraki = kanal_sonraki_blok(blok);
+                long long sonraki_bas = (yeni_bas & ~(long long)KANAL_SONRAKI_VAR) +
+                                        (1 << KANAL_KAYDIR);
+                if (__atomic_load_n(&sonraki->sonraki, __ATOMIC_RELAXED))
+                    sonraki_bas |= KANAL_SONRAKI_VAR;
+                __atomic_store_n(&k->bas_blok, sonraki, __ATOMIC_RELEASE);
+                __atomic_store_n(&k->bas, sonraki_bas, __ATOMIC_RELEASE);
+            }
+            _TrKanalYuva *y = &blok->yuvalar[yer];
+            while (!(__atomic_load_n(&y->durum, __ATOMIC_ACQUIRE) & YUVA_YAZILDI))
+                kanal_don(&tur);
+            *deger = y->deger;
+            if (yer + 1 == KANAL_BLOK_YUVA)
+                kanal_blok_birak(blok, 0);
+            else if (__atomic_fetch_or(&y->durum, YUVA_OKUNDU, __ATOMIC_ACQ_REL) & YUVA_SIL)
+                kanal_blok_birak(blok, yer + 1);
+            return 1;
+        }
+        blok = __atomic_load_n(&k->bas_blok, __ATOMIC_ACQUIRE);
+    }
+}
+
+static int kanal_dene_gonder(_TrKanal *k, long long deger) {
+    int tamam = k->kapasite ? sinirli_gonder(k, deger) : sinirsiz_gonder(k, deger);
+    if (tamam) kanal_uyandir(&k->veri_olayi, &k->bekleyen_alici, 0);
+    return tamam;
+}
+
+/* Kapalı değilse göndermeyi dene: 1 gönderildi, 0 yer yok, -1 kapalı.
+ * Denetimi geçen gönderim bitene kadar gonderen sayılır; alıcı kapalı
+ * kanalı ancak gonderen sıfırken boş sayar, yoksa yazılmakta olan değer
+ * kaybolurdu. */
+static int kanal_acikken_gonder(_TrKanal *k, long long deger) {
+    __atomic_add_fetch(&k->gonderen, 1, __ATOMIC_SEQ_CST);
+    int sonuç = __atomic_load_n(&k->kapali, __ATOMIC_SEQ_CST) ? -1 : kanal_dene_gonder(k, deger);
+    __atomic_sub_fetch(&k->gonderen, 1, __ATOMIC_SEQ_CST);
+    return sonuç;
+}
+
+static int kanal_dene_al(_TrKanal *k, long long *deger) {
+    int tamam = k->kapasite ? sinirli_al(k, deger) : sinirsiz_al(k, deger);
+    if (tamam && k->kapasite) kanal_uyandir(&k->yer_olayi, &k->bekleyen_gonderici, 0);
+    return tamam;
+}
+
+/* kanal_yeni(kapasite: tam) -> tam (kapasite <= 0: sınırsız) */
+long long _tr_kanal_yeni(long long kapasite) {
+    _TrKanal *k = (_TrKanal *)calloc(1, sizeof(_TrKanal));
+    if (!k) return 0;
+    if (kapasite > 0) {
+        k->hucreler = (_TrKanalHucre *)malloc(kapasite * sizeof(_TrKanalHucre));
+        if (!k->hucreler) {
+            free(k);
+            return 0;
+        }
+        for (long long i = 0; i < kapasite; i++) k->hucreler[i].sira = 2 * i;
+        k->kapasite = kapasite;
+    }
+    return (long long)k;
+}
+
+/* gönder(kanal: tam, değer: tam) -> mantık
+ * Sınırlı kanal doluysa yer açılana kadar bekler; kapalı kanala gönderim
+ * yanlış döner. */
+long long _tr_kanal_gonder(long long kanal_ptr, long long deger) {
+    _TrKanal *k = (_TrKanal *)kanal_ptr;
+    if (!k) return 0;
+    int tur = 0;
+    for (int deneme = 0;; deneme++) {
+        int durum = kanal_acikken_gonder(k, deger);
+        if (durum) return durum > 0;
+        if (!k->kapasite) return 0;     /* bellek yetmedi */
+        if (deneme < KANAL_DONME) {
+            kanal_don(&tur);
+            continue;
+        }
+        unsigned int olay = __atomic_load_n(&k->yer_olayi, __ATOMIC_SEQ_CST);
+        __atomic_add_fetch(&k->bekleyen_gonderici, 1, __ATOMIC_SEQ_CST);
+        durum = kanal_acikken_gonder(k, deger);
+        if (durum) {
+            __atomic_sub_fetch(&k->bekleyen_gonderici, 1, __ATOMIC_SEQ_CST);
+            return durum > 0;
+        }
+        kanal_uyu(&k->yer_olayi, olay);
+        __atomic_sub_fetch(&k->bekleyen_gonderici, 1, __ATOMIC_SEQ_CST);
+    }
+}
+
+/* al(kanal: tam) -> tam
+ * Değer gelene kadar bekler; kanal kapanıp boşaldıysa 0 döner. */
+long long _tr_kanal_al(long long kanal_ptr) {
+    _TrKanal *k = (_TrKanal *)kanal_ptr;
+    if (!k) return 0;
+    long long deger;
+    int tur = 0;
+    for (int deneme = 0;; deneme++) {
+        if (kanal_dene_al(k, &deger)) return deger;
+        /* Kapanmadan önce gönderilenler hâlâ alınabilir; yazılmakta olan
+         * gönderim varsa bitmesi beklenir */
+        if (__atomic_load_n(&k->kapali, __ATOMIC_SEQ_CST)) {
+            if (__atomic_load_n(&k->gonderen, __ATOMIC_SEQ_CST) == 0)
+                return kanal_dene_al(k, &deger) ? deger : 0;
+            kanal_don(&tur);
+            continue;
+        }
+        if (deneme < KANAL_DONME) {
+            kanal_don(&tur);
+            continue;
+        }
+        unsigned int olay = __atomic_load_n(&k->veri_olayi, __ATOMIC_SEQ_CST);
+        __atomic_add_fetch(&k->bekleyen_alici, 1, __ATOMIC_SEQ_CST);
+        if (kanal_dene_al(k, &deger)) {
+            __atomic_sub_fetch(&k->bekleyen_alici, 1, __ATOMIC_SEQ_CST);
+            return deger;
+        }
+        if (!__atomic_load_n(&k->kapali, __ATOMIC_SEQ_CST))
+            kanal_uyu(&k->veri_olayi, olay);
+        __atomic_sub_fetch(&k->bekleyen_alici, 1, __ATOMIC_SEQ_CST);
+    }
+}
+
+/* dene_al(kanal: tam, varsayılan: tam) -> tam
+ * Beklemeden al; kanal boşsa varsayılanı döndürür. */
+long long _tr_kanal_dene_al(long long kanal_ptr, long long varsayilan) {
+    _TrKanal *k = (_TrKanal *)kanal_ptr;
+    long long deger;
+    if (!k || !kanal_dene_al(k, &deger)) return varsayilan;
+    return deger;
+}
+
+/* kanal_kapat(kanal: tam)
+ * Yeni gönderimleri reddeder, bekleyen herkesi uyandırır. */
+void _tr_kanal_kapat(long long kanal_ptr) {
+    _TrKanal *k = (_TrKanal *)kanal_ptr;
+    if (!k) return;
+    __atomic_store_n(&k->kapali, 1, __ATOMIC_SEQ_CST);
+    kanal_uyandir(&k->veri_olayi, &k->bekleyen_alici, 1);
+    kanal_uyandir(&k->yer_olayi, &k->bekleyen_gonderici, 1);
+}
+
+/* kanal_bitti_mi(kanal: tam) -> mantık
+ * Kanal kapalı ve alınacak değer kalmamışsa doğru. */
+long long _tr_kanal_bitti_mi(long long kanal_ptr) {
+    _TrKanal *k = (_TrKanal *)kanal_ptr;
+    if (!k) return 1;
+    if (!__atomic_load_n(&k->kapali, __ATOMIC_SEQ_CST)) return 0;
+    if (__atomic_load_n(&k->gonderen, __ATOMIC_SEQ_CST)) return 0;
+    long long bas = __atomic_load_n(&k->bas, __ATOMIC_ACQUIRE);
+    long long son = __atomic_load_n(&k->son, __ATOMIC_ACQUIRE);
+    if (!k->kapasite) return (bas >> KANAL_KAYDIR) == (son >> KANAL_KAYDIR);
+    return bas == son;
+}
+
+/* kanal_bırak(kanal: tam)
+ * Kanalı ve alınmamış değerlerini serbest bırakır. Kanalı kullanan başka
+ * iş parçacığı kalmamış olmalıdır. */
+void _tr_kanal_birak(long long kanal_ptr) {
+    _TrKanal *k = (_TrKanal *)kanal_ptr;
+    if (!k) return;
+    if (k->kapasite) {
+        free(k->hucreler);
+    } else {
+        _TrKanalBlok *b = k->bas_blok;
+        while (b) {
+            _TrKanalBlok *sonraki = b->sonraki;
+            free(b);
+            b = sonraki;
+        }
+    }
+    free(k);
+}
@@ -8,6 +8,12 @@ static const ModülFonksiyon paralel_fonksiyonlar[] = {
     /* iş_bekle(handle: tam) -> tam */
     {"i\xc5\x9f_bekle", "is_bekle", "_tr_is_bekle", {TİP_TAM}, 1, TİP_TAM},
 
+    /* paylaş(nesne: tam) -> tam */
+    {"payla\xc5\x9f", "paylas", "_tr_paylas", {TİP_TAM}, 1, TİP_TAM},
+
+    /* dizi_paylaş(d: dizi) -> dizi */
+    {"dizi_payla\xc5\x9f", "dizi_paylas", "_tr_dizi_paylas", {TİP_DİZİ}, 1, TİP_DİZİ},
+
     /* kilit_oluştur() -> tam */
     {"kilit_olu\xc5\x9ftur", "kilit_olustur", "_tr_kilit_olustur", {0}, 0, TİP_TAM},
 
@@ -16,6 +22,27 @@ static const ModülFonksiyon paralel_fonksiyonlar[] = {
 
     /* kilit_bırak(kilit: tam) -> boşluk */
     {"kilit_b\xc4\xb1rak", "kilit_birak", "_tr_kilit_birak", {TİP_TAM}, 1, TİP_BOŞLUK},
+
+    /* kanal_yeni(kapasite: tam) -> tam  (kapasite <= 0: sınırsız) */
+    {"kanal_yeni", NULL, "_tr_kanal_yeni", {TİP_TAM}, 1, TİP_TAM},
+
+    /* gönder(kanal: tam, değer: tam) -> mantık */
+    {"g\xc3\xb6nder", "gonder", "_tr_kanal_gonder", {TİP_TAM, TİP_TAM}, 2, TİP_MANTIK},
+
+    /* al(kanal: tam) -> tam */
+    {"al", NULL, "_tr_kanal_al", {TİP_TAM}, 1, TİP_TAM},
+
+    /* dene_al(kanal: tam, varsayılan: tam) -> tam */
+    {"dene_al", NULL, "_tr_kanal_dene_al", {TİP_TAM, TİP_TAM}, 2, TİP_TAM},
+
+    /* kanal_kapat(kanal: tam) -> boşluk */
+    {"kanal_kapat", NULL, "_tr_kanal_kapat", {TİP_TAM}, 1, TİP_BOŞLUK},
+
+    /* kanal_bitti_mi(kanal: tam) -> mantık */
+    {"kanal_bitti_mi", NULL, "_tr_kanal_bitti_mi", {TİP_TAM}, 1, TİP_MANTIK},
+
+    /* kanal_bırak(kanal: tam) -> boşluk */
+    {"kanal_b\xc4\xb1rak", "kanal_birak", "_tr_kanal_birak", {TİP_TAM}, 1, TİP_BOŞLUK},
 };
 
 const ModülTanım paralel_modul = {
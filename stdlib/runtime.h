@@ -14,7 +14,7 @@ typedef struct { long long *ptr; long long count; } TrDizi;
 typedef struct {
     long long ref_sayisi;
     long long tip;
-    long long boyut;
+    long long boyut;       /* header dahil gerçek ayrılan boyut (slab sınıfına yuvarlanmış) */
 } NesneBaslik;
 
 #define NESNE_BASLIK_BOYUT 24
@@ -28,9 +28,52 @@ typedef struct {
 #define NESNE_TIP_KUME    4
 #define NESNE_TIP_KAPANIS 5
 
+/* tip alanı: [0..7] tip, [8..15] bayraklar, [24..63] dizi kullanılan uzunluğu + 1 */
+#define NESNE_TIP_MASKE           0xffLL
+#define NESNE_BAYRAK_PAYLASILMIS  (1LL << 8)   /* başka iş parçacığına yayınlandı */
+#define NESNE_BAYRAK_REFLI        (1LL << 12)  /* sayılmış referans tutar (bkz. _tr_ref_yaz, _tr_ref_tut) */
+#define NESNE_BAYRAK_ORTAK        (1LL << 13)  /* dizi birden çok değişkende (bkz. _tr_dizi_ortakla) */
+#define NESNE_TIP(ptr) (NESNE_BASLIK(ptr)->tip & NESNE_TIP_MASKE)
+
+/* Dizi nesneleri kullanılan eleman sayısı + 1'i tip alanının üst bitlerinde
+ * tutar (0 = bilinmiyor); kapasite ayrılan boyuttan türetilir. Bir TrDizi
+ * görünümü ancak sayısı kullanılan uzunluğa eşitse (dizinin sonuna sahipse)
+ * yerinde büyütülebilir. */
+#define NESNE_DIZI_UZUNLUK_KAYMA  24
+#define NESNE_DIZI_UZUNLUK(ptr) \
+    ((long long)((unsigned long long)NESNE_BASLIK(ptr)->tip >> NESNE_DIZI_UZUNLUK_KAYMA) - 1)
+#define NESNE_DIZI_KAPASITE(ptr) \
+    ((NESNE_BASLIK(ptr)->boyut - NESNE_BASLIK_BOYUT) / (long long)sizeof(long long))
+
+/* Kapanış: [kod, yakalanan sayısı, yakalananlar...]. İşlev değerleri bu
+ * nesneye işaretçidir (adlı işlevler için .rodata'da [kod, 0]); kapanış
+ * r10'da (statik zincir) geçirilir. C'den çağrı _tr_kapanis_cagirN
+ * köprüleriyle yapılır; köprüler kapanışı bildirilen argümanlardan sonraki
+ * tamsayı argümanı olarak da geçirir (LLVM arka ucu oradan okur). */
+extern long long _tr_kapanis_cagir0(const long long *k);
+extern long long _tr_kapanis_cagir1(const long long *k, long long a);
+extern long long _tr_kapanis_cagir2(const long long *k, long long a, long long b);
+#define TR_KAPANIS_CAGIR1(k, a) _tr_kapanis_cagir1((k), (a))
+#define TR_KAPANIS_CAGIR2(k, a, b) _tr_kapanis_cagir2((k), (a), (b))
+
 /* Core runtime fonksiyonları (calismazamani.c'de tanımlı) */
 extern void *_tr_nesne_olustur(long long tip, long long boyut);
 extern void  _tr_ref_artir(void *ptr);
 extern void  _tr_ref_azalt(void *ptr);
+extern void  _tr_ref_yaz(void *nesne, long long indeks, long long deger);
+extern void  _tr_ref_izleme_birak(void *nesne);
+extern void  _tr_nesne_paylas(void *ptr);
+extern int   _tr_nesne_yerinde_buyut(void *ptr, long long yeni_boyut);
+
+/* Tip tanımlayıcısı: gezici döngü toplayıcı için nesnenin tuttuğu sayılmış
+ * referansları gezer, sonlandırıcı nesne bırakılırken dış tablolarını
+ * serbest bırakır (ikisi de NULL olabilir). Nesne dışında tablo tutan
+ * modüller (sözlük, küme) değerleri _tr_ref_tut ile sayar ve gezicide
+ * yalnızca onları ziyaret eder. */
+typedef void (*NesneZiyaretFn)(long long deger, void *bag);
+typedef void (*NesneGezFn)(void *nesne, NesneZiyaretFn ziyaret, void *bag);
+typedef void (*NesneSonlandirFn)(void *nesne);
+extern void  _tr_nesne_tip_kaydet(long long tip, NesneGezFn gez, NesneSonlandirFn sonlandir);
+extern int   _tr_ref_tut(void *kap, long long deger);
 
 #endif /* TR_RUNTIME_H */
@@ -17,6 +17,18 @@ static const ModülFonksiyon sistem_fonksiyonlar[] = {
 
     /* metin_ondalık(m: metin) -> ondalık */
     {"metin_ondal\xc4\xb1k", "metin_ondalik", "_tr_metin_ondalik", {TİP_METİN}, 1, TİP_ONDALIK},
+
+    /* çöp_topla() -> tam (toplanan nesne sayısı) */
+    {"\xc3\xa7\xc3\xb6p_topla", "cop_topla", "_tr_cop_topla", {0}, 0, TİP_TAM},
+
+    /* çöp_ayarla(etkin: tam, eşik: tam) -> boşluk */
+    {"\xc3\xa7\xc3\xb6p_ayarla", "cop_ayarla", "_tr_cop_ayarla", {TİP_TAM, TİP_TAM}, 2, TİP_BOŞLUK},
+
+    /* nesne_bırak(nesne) -> boşluk (yerel sahipliği bırak) */
+    {"nesne_b\xc4\xb1rak", "nesne_birak", "_tr_nesne_birak", {TİP_TAM}, 1, TİP_BOŞLUK},
+
+    /* çöp_rapor() -> boşluk */
+    {"\xc3\xa7\xc3\xb6p_rapor", "cop_rapor", "_tr_cop_rapor", {0}, 0, TİP_BOŞLUK},
 };
 
 const ModülTanım sistem_modul = {
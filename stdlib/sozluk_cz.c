@@ -3,103 +3,313 @@
 #include <string.h>
 #include "runtime.h"
 
-/* Sozluk: basit hash map implementasyonu
-   Her sozluk heap'te bir blok: [kapasite, eleman_sayisi, girdi_ptr]
-   Her girdi: [anahtar_ptr, anahtar_len, deger (long long)]
-   Basitlik icin: lineer arama, max 256 anahtar */
+/* Sozluk: Robin Hood acik adresli hash tablosu
+ *
+ * Yonetilen nesne sabit boyutlu bir TrSozlukTablo'dur; tablolar malloc ile
+ * ayrilir ve sinirsiz buyur.
+ *   girdiler: ekleme sirasinda yogun dizi [anahtar_ptr, anahtar_len, deger, hash, ref].
+ *             Silinen girdi anahtar_len = -1 ile isaretlenir (sira korunur),
+ *             yeniden kurulumda sikistirilir.
+ *   yuvalar:  2^k yuva, her biri [hash, girdi_indeksi] (-1 = bos). Robin Hood
+ *             yerlestirme ve geri kaydirmali silme ile sonda zincirleri kisa
+ *             kalir; hash onbellekte oldugu icin cogu karsilastirma memcmp'siz.
+ */
+
+#define SOZLUK_SIHIR       0x534f5a4c554b3031LL  /* "SOZLUK01" */
+#define SOZLUK_ILK_YUVA    8
+#define SOZLUK_SILINDI     (-1LL)
+
+typedef struct {
+    char *anahtar_ptr;
+    long long anahtar_len;      /* SOZLUK_SILINDI ise girdi silinmis */
+    long long deger;
+    unsigned long long hash;
+    long long ref;              /* deger _tr_ref_tut ile sayildi */
+} SozlukGirdi;
 
 typedef struct {
-    long long *veri;     /* heap blogu: [kap, say, anahtar_ptr, anahtar_len, deger, ...] */
-    long long kapasite;
-} TrSozluk;
+    unsigned long long hash;
+    long long girdi;            /* -1 = bos */
+} SozlukYuva;
+
+typedef struct {
+    long long sihir;            /* JSON nesneleri de NESNE_TIP_SOZLUK kullanir */
+    long long sayi;             /* canli anahtar sayisi */
+    long long girdi_sayi;       /* girdiler'de kullanilan (silinenler dahil) */
+    long long girdi_kap;
+    SozlukGirdi *girdiler;
+    SozlukYuva *yuvalar;
+    long long yuva_maske;
+} TrSozlukTablo;
+
+static unsigned long long _sozluk_hash(const char *p, long long n) {
+    unsigned long long h = 14695981039346656037ULL;
+    for (long long i = 0; i < n; i++) {
+        h ^= (unsigned char)p[i];
+        h *= 1099511628211ULL;
+    }
+    return h ^ (h >> 32);
+}
+
+static inline long long _sozluk_uzaklik(const TrSozlukTablo *t,
+                                         unsigned long long hash, long long yuva) {
+    return (yuva - (long long)(hash & (unsigned long long)t->yuva_maske)) & t->yuva_maske;
+}
+
+/* Girdiyi yuva tablosuna Robin Hood ile yerlestir */
+static void _sozluk_yuva_ekle(TrSozlukTablo *t, unsigned long long hash, long long girdi) {
+    long long i = (long long)(hash & (unsigned long long)t->yuva_maske);
+    long long uzak = 0;
+    for (;;) {
+        SozlukYuva *y = &t->yuvalar[i];
+        if (y->girdi < 0) {
+            y->hash = hash;
+            y->girdi = girdi;
+            return;
+        }
+        long long mevcut = _sozluk_uzaklik(t, y->hash, i);
+        if (mevcut < uzak) {
+            /* Zengin olandan al: daha yakindaki yerlesiği ileri it */
+            unsigned long long th = y->hash;
+            long long tg = y->girdi;
+            y->hash = hash;
+            y->girdi = girdi;
+            hash = th;
+            girdi = tg;
+            uzak = mevcut;
+        }
+        i = (i + 1) & t->yuva_maske;
+        uzak++;
+    }
+}
+
+/* Anahtarin yuva indeksini bul, yoksa -1 */
+static long long _sozluk_yuva_bul(const TrSozlukTablo *t, const char *anahtar,
+                                   long long len, unsigned long long hash) {
+    long long i = (long long)(hash & (unsigned long long)t->yuva_maske);
+    long long uzak = 0;
+    for (;;) {
+        const SozlukYuva *y = &t->yuvalar[i];
+        if (y->girdi < 0) return -1;
+        if (_sozluk_uzaklik(t, y->hash, i) < uzak) return -1;
+        if (y->hash == hash) {
+            const SozlukGirdi *g = &t->girdiler[y->girdi];
+            if (g->anahtar_len == len && memcmp(g->anahtar_ptr, anahtar, (size_t)len) == 0) {
+                return i;
+            }
+        }
+        i = (i + 1) & t->yuva_maske;
+        uzak++;
+    }
+}
+
+/* Silinenleri sikistir ve yuva tablosunu verilen kapasiteyle yeniden kur */
+static int _sozluk_yeniden_kur(TrSozlukTablo *t, long long yuva_kap) {
+    SozlukYuva *yeni = (SozlukYuva *)malloc((size_t)yuva_kap * sizeof(SozlukYuva));
+    if (!yeni) return 0;
+    for (long long i = 0; i < yuva_kap; i++) yeni[i].girdi = -1;
+    free(t->yuvalar);
+    t->yuvalar = yeni;
+    t->yuva_maske = yuva_kap - 1;
+
+    long long j = 0;
+    for (long long i = 0; i < t->girdi_sayi; i++) {
+        if (t->girdiler[i].anahtar_len == SOZLUK_SILINDI) continue;
+        t->girdiler[j] = t->girdiler[i];
+        _sozluk_yuva_ekle(t, t->girdiler[j].hash, j);
+        j++;
+    }
+    t->girdi_sayi = j;
+    return 1;
+}
+
+/* Bir girdi daha eklenebilmesi icin yer ac */
+static int _sozluk_yer_ac(TrSozlukTablo *t) {
+    long long yuva_kap = t->yuva_maske + 1;
+    /* Yuk orani 0.8'i asmasin */
+    if ((t->sayi + 1) * 5 > yuva_kap * 4) {
+        if (!_sozluk_yeniden_kur(t, yuva_kap * 2)) return 0;
+    }
+    if (t->girdi_sayi >= t->girdi_kap) {
+        if (t->girdi_sayi - t->sayi > t->girdi_sayi / 2) {
+            /* Cok sayida silinmis girdi: yerinde sikistir */
+            return _sozluk_yeniden_kur(t, t->yuva_maske + 1);
+        }
+        long long kap = t->girdi_kap * 2;
+        SozlukGirdi *g = (SozlukGirdi *)realloc(t->girdiler, (size_t)kap * sizeof(SozlukGirdi));
+        if (!g) return 0;
+        t->girdiler = g;
+        t->girdi_kap = kap;
+    }
+    return 1;
+}
+
+static inline TrSozlukTablo *_sozluk_al(long long sozluk_ptr) {
+    TrSozlukTablo *t = (TrSozlukTablo *)sozluk_ptr;
+    return (t && t->sihir == SOZLUK_SIHIR) ? t : NULL;
+}
+
+/* Döngü toplayıcı için sayılmış değerleri gez (JSON nesneleri atlanır) */
+static void _sozluk_gez(void *nesne, NesneZiyaretFn ziyaret, void *bag) {
+    TrSozlukTablo *t = _sozluk_al((long long)nesne);
+    if (!t) return;
+    for (long long i = 0; i < t->girdi_sayi; i++) {
+        const SozlukGirdi *g = &t->girdiler[i];
+        if (g->anahtar_len != SOZLUK_SILINDI && g->ref) ziyaret(g->deger, bag);
+    }
+}
+
+/* Sözlük bırakılırken tablolarını ve anahtar kopyalarını serbest bırak */
+static void _sozluk_sonlandir(void *nesne) {
+    TrSozlukTablo *t = _sozluk_al((long long)nesne);
+    if (!t) return;
+    for (long long i = 0; i < t->girdi_sayi; i++) free(t->girdiler[i].anahtar_ptr);
+    free(t->girdiler);
+    free(t->yuvalar);
+    t->girdiler = NULL;
+    t->yuvalar = NULL;
+    t->sihir = 0;
+}
+
+__attribute__((constructor))
+static void _sozluk_tip_kaydet(void) {
+    _tr_nesne_tip_kaydet(NESNE_TIP_SOZLUK, _sozluk_gez, _sozluk_sonlandir);
+}
+
 long long _tr_sozluk_yeni(void) {
-    /* 2 meta + 256 * 3 (anahtar_ptr, anahtar_len, deger) = 770 long long */
-    long long boyut = 770 * sizeof(long long);
-    long long *blok = (long long *)_tr_nesne_olustur(NESNE_TIP_SOZLUK, boyut);
-    if (!blok) return 0;
-    blok[0] = 256;  /* kapasite */
-    blok[1] = 0;    /* eleman sayisi */
-    return (long long)blok;
+    TrSozlukTablo *t = (TrSozlukTablo *)_tr_nesne_olustur(NESNE_TIP_SOZLUK,
+                                                          (long long)sizeof(TrSozlukTablo));
+    if (!t) return 0;
+    long long girdi_kap = SOZLUK_ILK_YUVA * 4 / 5;
+    t->girdiler = (SozlukGirdi *)malloc((size_t)girdi_kap * sizeof(SozlukGirdi));
+    t->yuvalar = (SozlukYuva *)malloc(SOZLUK_ILK_YUVA * sizeof(SozlukYuva));
+    if (!t->girdiler || !t->yuvalar) {
+        free(t->girdiler);
+        free(t->yuvalar);
+        return 0;
+    }
+    for (long long i = 0; i < SOZLUK_ILK_YUVA; i++) t->yuvalar[i].girdi = -1;
+    t->yuva_maske = SOZLUK_ILK_YUVA - 1;
+    t->girdi_kap = girdi_kap;
+    t->girdi_sayi = 0;
+    t->sayi = 0;
+    t->sihir = SOZLUK_SIHIR;
+    return (long long)t;
 }
 
 /* Sozluk'e deger ekle/guncelle: sozluk_ptr, anahtar_ptr, anahtar_len, deger */
 long long _tr_sozluk_ekle(long long sozluk_ptr,
                             const char *anahtar_ptr, long long anahtar_len,
                             long long deger) {
-    long long *blok = (long long *)sozluk_ptr;
-    long long say = blok[1];
-    /* Mevcut anahtari ara */
-    for (long long i = 0; i < say; i++) {
-        char *k = (char *)blok[2 + i * 3];
-        long long kl = blok[2 + i * 3 + 1];
-        if (kl == anahtar_len && memcmp(k, anahtar_ptr, anahtar_len) == 0) {
-            blok[2 + i * 3 + 2] = deger;  /* guncelle */
-            return sozluk_ptr;
-        }
+    TrSozlukTablo *t = _sozluk_al(sozluk_ptr);
+    if (!t) return sozluk_ptr;
+    unsigned long long h = _sozluk_hash(anahtar_ptr, anahtar_len);
+    long long y = _sozluk_yuva_bul(t, anahtar_ptr, anahtar_len, h);
+    if (y >= 0) {
+        /* guncelle: yeni deger sayildiktan sonra eskisi birakilir */
+        SozlukGirdi *g = &t->girdiler[t->yuvalar[y].girdi];
+        long long eski = g->deger, eski_ref = g->ref;
+        g->ref = _tr_ref_tut(t, deger);
+        g->deger = deger;
+        if (eski_ref) _tr_ref_azalt((void *)eski);
+        return sozluk_ptr;
     }
     /* Yeni anahtar ekle */
-    if (say >= blok[0]) return sozluk_ptr;  /* dolu */
-    char *kopyala = (char *)malloc(anahtar_len);
-    if (kopyala) memcpy(kopyala, anahtar_ptr, anahtar_len);
-    blok[2 + say * 3] = (long long)kopyala;
-    blok[2 + say * 3 + 1] = anahtar_len;
-    blok[2 + say * 3 + 2] = deger;
-    blok[1] = say + 1;
+    if (!_sozluk_yer_ac(t)) return sozluk_ptr;
+    char *kopyala = (char *)malloc(anahtar_len > 0 ? (size_t)anahtar_len : 1);
+    if (!kopyala) return sozluk_ptr;
+    if (anahtar_len > 0) memcpy(kopyala, anahtar_ptr, (size_t)anahtar_len);
+    long long gi = t->girdi_sayi++;
+    t->girdiler[gi].anahtar_ptr = kopyala;
+    t->girdiler[gi].anahtar_len = anahtar_len;
+    t->girdiler[gi].deger = deger;
+    t->girdiler[gi].hash = h;
+    t->girdiler[gi].ref = _tr_ref_tut(t, deger);
+    _sozluk_yuva_ekle(t, h, gi);
+    t->sayi++;
     return sozluk_ptr;
 }
 
 /* Sozluk'ten deger oku */
 long long _tr_sozluk_oku(long long sozluk_ptr,
                            const char *anahtar_ptr, long long anahtar_len) {
-    long long *blok = (long long *)sozluk_ptr;
-    long long say = blok[1];
-    for (long long i = 0; i < say; i++) {
-        char *k = (char *)blok[2 + i * 3];
-        long long kl = blok[2 + i * 3 + 1];
-        if (kl == anahtar_len && memcmp(k, anahtar_ptr, anahtar_len) == 0) {
-            return blok[2 + i * 3 + 2];
-        }
-    }
-    return 0;  /* bulunamadi */
+    TrSozlukTablo *t = _sozluk_al(sozluk_ptr);
+    if (!t) return 0;
+    unsigned long long h = _sozluk_hash(anahtar_ptr, anahtar_len);
+    long long y = _sozluk_yuva_bul(t, anahtar_ptr, anahtar_len, h);
+    if (y < 0) return 0;  /* bulunamadi */
+    return t->girdiler[t->yuvalar[y].girdi].deger;
 }
 
 /* Sozluk eleman sayisi */
 long long _tr_sozluk_uzunluk(long long sozluk_ptr) {
-    long long *blok = (long long *)sozluk_ptr;
-    return blok[1];
+    TrSozlukTablo *t = _sozluk_al(sozluk_ptr);
+    return t ? t->sayi : 0;
 }
 
 /* Sozluk anahtar var mi? */
 long long _tr_sozluk_var_mi(long long sozluk_ptr,
                               const char *anahtar_ptr, long long anahtar_len) {
-    long long *blok = (long long *)sozluk_ptr;
-    long long say = blok[1];
-    for (long long i = 0; i < say; i++) {
-        char *k = (char *)blok[2 + i * 3];
-        long long kl = blok[2 + i * 3 + 1];
-        if (kl == anahtar_len && memcmp(k, anahtar_ptr, anahtar_len) == 0) {
-            return 1;
-        }
+    TrSozlukTablo *t = _sozluk_al(sozluk_ptr);
+    if (!t) return 0;
+    unsigned long long h = _sozluk_hash(anahtar_ptr, anahtar_len);
+    return _sozluk_yuva_bul(t, anahtar_ptr, anahtar_len, h) >= 0;
+}
+
+/* Sozluk sil: bir anahtari kaldir (kalanlarin ekleme sirasi korunur) */
+long long _tr_sozluk_sil(long long sozluk_ptr,
+                           const char *anahtar_ptr, long long anahtar_len) {
+    TrSozlukTablo *t = _sozluk_al(sozluk_ptr);
+    if (!t) return 0;
+    unsigned long long h = _sozluk_hash(anahtar_ptr, anahtar_len);
+    long long y = _sozluk_yuva_bul(t, anahtar_ptr, anahtar_len, h);
+    if (y < 0) return 0;
+
+    SozlukGirdi *g = &t->girdiler[t->yuvalar[y].girdi];
+    long long eski = g->deger, eski_ref = g->ref;
+    free(g->anahtar_ptr);
+    g->anahtar_ptr = NULL;
+    g->anahtar_len = SOZLUK_SILINDI;
+    g->deger = 0;
+    g->ref = 0;
+    t->sayi--;
+
+    /* Geri kaydirmali silme: mezar tasi birakmadan zinciri kapat */
+    long long sonraki = (y + 1) & t->yuva_maske;
+    while (t->yuvalar[sonraki].girdi >= 0 &&
+           _sozluk_uzaklik(t, t->yuvalar[sonraki].hash, sonraki) > 0) {
+        t->yuvalar[y] = t->yuvalar[sonraki];
+        y = sonraki;
+        sonraki = (sonraki + 1) & t->yuva_maske;
     }
-    return 0;
+    t->yuvalar[y].girdi = -1;
+    if (eski_ref) _tr_ref_azalt((void *)eski);
+    return 1;
 }
 
-/* Sozluk anahtarlari dizi olarak dondur */
+/* Sozluk anahtarlari dizi olarak dondur (ekleme sirasiyla). Anahtarlar
+ * kopyalanir: sozluk birakilinca kendi kopyalari serbest kalir. */
 TrDizi _tr_sozluk_anahtarlar(long long sozluk_ptr) {
-    long long *blok = (long long *)sozluk_ptr;
-    long long say = blok[1];
+    TrSozlukTablo *t = _sozluk_al(sozluk_ptr);
     TrDizi d = {NULL, 0};
-    if (say == 0) return d;
+    if (!t || t->sayi == 0) return d;
 
-    long long boyut = say * 2 * sizeof(long long);
+    long long boyut = t->sayi * 2 * sizeof(long long);
     long long *sonuç = (long long *)_tr_nesne_olustur(NESNE_TIP_DIZI, boyut);
     if (!sonuç) return d;
 
-    for (long long i = 0; i < say; i++) {
-        sonuç[i * 2] = blok[2 + i * 3];       /* anahtar ptr */
-        sonuç[i * 2 + 1] = blok[2 + i * 3 + 1]; /* anahtar len */
+    long long j = 0;
+    for (long long i = 0; i < t->girdi_sayi; i++) {
+        const SozlukGirdi *g = &t->girdiler[i];
+        if (g->anahtar_len == SOZLUK_SILINDI) continue;
+        char *kopya = (char *)malloc(g->anahtar_len > 0 ? (size_t)g->anahtar_len : 1);
+        if (!kopya) break;
+        if (g->anahtar_len > 0) memcpy(kopya, g->anahtar_ptr, (size_t)g->anahtar_len);
+        sonuç[j * 2] = (long long)kopya;                /* anahtar ptr */
+        sonuç[j * 2 + 1] = g->anahtar_len;              /* anahtar len */
+        j++;
     }
     d.ptr = sonuç;
-    d.count = say;
+    d.count = j;
     return d;
 }
@@ -18,6 +18,9 @@ static const ModülFonksiyon sozluk_fonksiyonlar[] = {
     /* var_mı(sozluk: tam, anahtar: metin) -> tam */
     {"var_m\xc4\xb1", "var_mi", "_tr_sozluk_var_mi", {TİP_TAM, TİP_METİN}, 2, TİP_TAM},
 
+    /* sil(sozluk: tam, anahtar: metin) -> tam */
+    {"sil", NULL, "_tr_sozluk_sil", {TİP_TAM, TİP_METİN}, 2, TİP_TAM},
+
     /* anahtarlar(sozluk: tam) -> dizi */
     {"anahtarlar", NULL, "_tr_sozluk_anahtarlar", {TİP_TAM}, 1, TİP_DİZİ},
 };
@@ -3,16 +3,14 @@
 #include <string.h>
 #include "runtime.h"
 
+extern TrDizi _tr_birlestir_dizi(long long *ptr1, long long count1,
+                                 long long *ptr2, long long count2);
+
 /* === Tekrarlayıcı Araçları (kullan tekrarlayıcı) === */
 
+/* zincir(d1, d2): birleştir ile aynı */
 TrDizi _tr_zincir(long long *ptr1, long long c1, long long *ptr2, long long c2) {
-    long long toplam = c1 + c2;
-    long long *yeni = (long long *)_tr_nesne_olustur(NESNE_TIP_DIZI, toplam * sizeof(long long));
-    if (!yeni) { TrDizi d = {NULL, 0}; return d; }
-    for (long long i = 0; i < c1; i++) yeni[i] = ptr1[i];
-    for (long long i = 0; i < c2; i++) yeni[c1 + i] = ptr2[i];
-    TrDizi d = {yeni, toplam};
-    return d;
+    return _tr_birlestir_dizi(ptr1, c1, ptr2, c2);
 }
 
 TrDizi _tr_tekrarla_dizi(long long *ptr, long long count, long long kez) {
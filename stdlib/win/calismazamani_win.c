@@ -42,8 +42,9 @@ typedef struct {
 #define NESNE_TIP_KUME    4
 #define NESNE_TIP_KAPANIS 5
 
-/* Kapanış ortam işaretçisi */
-long long *_tr_kapanis_ortam = NULL;
+/* tip alanı: [0..7] tip, [8..15] bayraklar, [24..63] dizi kullanılan uzunluğu + 1 */
+#define NESNE_TIP_MASKE           0xffLL
+#define NESNE_BAYRAK_ORTAK        (1LL << 13)  /* dizi birden çok değişkende */
 
 /* Yönetilen nesne oluştur: VirtualAlloc kullanır */
 void *_tr_nesne_olustur(long long tip, long long boyut) {
@@ -74,6 +75,65 @@ void _tr_ref_azalt(void *ptr) {
     }
 }
 
+/* Referans yuvasına yaz: bu çalışma zamanında döngü toplayıcı ve adres
+ * kaydı yok, yuvalar izlenmez */
+void _tr_ref_yaz(void *nesne, long long indeks, long long deger) {
+    ((long long *)nesne)[indeks] = deger;
+}
+
+void _tr_ref_izleme_birak(void *nesne) {
+    (void)nesne;
+}
+
+/* Tip tanımlayıcıları kaydedilir ama kullanılmaz: nesneler bırakılırken
+ * sonlandırıcı çağrılmaz, modül tabloları değer saymaz */
+typedef void (*NesneZiyaretFn)(long long deger, void *bag);
+typedef void (*NesneGezFn)(void *nesne, NesneZiyaretFn ziyaret, void *bag);
+typedef void (*NesneSonlandirFn)(void *nesne);
+
+void _tr_nesne_tip_kaydet(long long tip, NesneGezFn gez, NesneSonlandirFn sonlandir) {
+    (void)tip;
+    (void)gez;
+    (void)sonlandir;
+}
+
+int _tr_ref_tut(void *kap, long long deger) {
+    (void)kap;
+    (void)deger;
+    return 0;
+}
+
+/* nesne_bırak(x): değerin yönetilen nesne olduğu doğrulanamadığından
+ * bellek süreç sonuna kadar tutulur */
+void _tr_nesne_birak(long long deger) {
+    (void)deger;
+}
+
+/* Taşımadan büyütme yok: yalnızca ayrılan boyut zaten yetiyorsa 1 */
+int _tr_nesne_yerinde_buyut(void *ptr, long long yeni_boyut) {
+    if (!ptr) return 0;
+    return yeni_boyut + NESNE_BASLIK_BOYUT <= NESNE_BASLIK(ptr)->boyut;
+}
+
+/* Dizi başka bir değişkene atandı: yerinde büyütmeyi kapat */
+void _tr_dizi_ortakla(void *ptr) {
+    if (ptr && (NESNE_BASLIK(ptr)->tip & NESNE_TIP_MASKE) == NESNE_TIP_DIZI)
+        NESNE_BASLIK(ptr)->tip |= NESNE_BAYRAK_ORTAK;
+}
+
+/* Kapanış köprüleri: kapanış bildirilen argümanlardan sonra geçer */
+long long _tr_kapanis_cagir0(const long long *k) {
+    return ((long long (*)(const long long *))k[0])(k);
+}
+
+long long _tr_kapanis_cagir1(const long long *k, long long a) {
+    return ((long long (*)(long long, const long long *))k[0])(a, k);
+}
+
+long long _tr_kapanis_cagir2(const long long *k, long long a, long long b) {
+    return ((long long (*)(long long, long long, const long long *))k[0])(a, b, k);
+}
+
 /* ---- I/O ---- */
 
 /* Satırdan oku */
@@ -204,6 +204,78 @@ for test_dosya in "$TEST_DIR"/*.tr; do
     fi
 done
 
+# VM farki: test_vm_* dosyalari --backend=vm ile derlenip trsm ile
+# (yorumlayici, --jit ve --profil) calistirilir; cikti yerel derlemenin
+# beklenen dosyasiyla ayni olmali
+TRSM="$SCRIPT_DIR/trsm"
+if [ "$BACKEND" == "native" ]; then
+    echo ""
+    echo "VM farki (trsm):"
+    for test_dosya in "$TEST_DIR"/test_vm_*.tr; do
+        temel=$(basename "$test_dosya" .tr)
+        BEKLENEN_DOSYA="$BEKLENEN_DIR/${temel}.beklenen"
+        [ -f "$BEKLENEN_DOSYA" ] || continue
+        for kip in "" "--jit" "--profil"; do
+            isim="$temel.trbc${kip:+ $kip}"
+            ((TOPLAM++))
+            if [ ! -x "$TRSM" ]; then
+                ((ATLANDI++))
+                continue
+            fi
+            BYTECODE="/tmp/tonyukuk_test_${temel}.trbc"
+            if ! "$COMPILER" --backend=vm "$test_dosya" -o "$BYTECODE" > /dev/null 2>&1; then
+                echo -e "  ${KIRMIZI}KALDI${SIFIRLA} $isim (derleme hatasi)"
+                BASARISIZ_TESTLER+=("$isim: DERLEME HATASI")
+                ((KALDI++))
+                continue
+            fi
+            # Profil raporu stderr'e yazilir; yalnizca stdout karsilastirilir
+            GERCEK_CIKTI=$(cd "$TEST_DIR" && timeout ${TIMEOUT_SEC}s "$TRSM" $kip "$BYTECODE" 2>/dev/null)
+            CALISMA_KODU=$?
+            rm -f "$BYTECODE"
+            FARK=$(diff <(echo "$GERCEK_CIKTI") "$BEKLENEN_DOSYA" 2>&1)
+            if [ $CALISMA_KODU -eq 0 ] && [ -z "$FARK" ]; then
+                echo -e "  ${YESIL}GECTI${SIFIRLA} $isim (cikti dogrulandi)"
+                ((GECTI++))
+            else
+                echo -e "  ${KIRMIZI}KALDI${SIFIRLA} $isim (cikis kodu: $CALISMA_KODU)"
+                echo "$FARK" | head -20 | sed 's/^/    /'
+                BASARISIZ_TESTLER+=("$isim: VM CIKTISI UYUSMUYOR")
+                ((KALDI++))
+            fi
+        done
+    done
+
+    # libtrsm gomme testi: testler/gomme/trsm_gomme.c kutuphaneye baglanir,
+    # ayni betigi paylasan makineleri ve harici fonksiyonlari dener
+    GOMME_DIR="$TEST_DIR/gomme"
+    isim="gomme/trsm_gomme"
+    ((TOPLAM++))
+    if [ ! -f "$SCRIPT_DIR/libtrsm.a" ]; then
+        ((ATLANDI++))
+    elif ! "$COMPILER" --backend=vm "$GOMME_DIR/trsm_gomme.tr" -o /tmp/tonyukuk_test_gomme.trbc > /dev/null 2>&1 || \
+         ! ${CC:-gcc} -Wall -Wextra -O2 -I"$SCRIPT_DIR/src" -o /tmp/tonyukuk_test_gomme \
+             "$GOMME_DIR/trsm_gomme.c" "$SCRIPT_DIR/libtrsm.a" -lpthread -lm 2>&1; then
+        echo -e "  ${KIRMIZI}KALDI${SIFIRLA} $isim (derleme hatasi)"
+        BASARISIZ_TESTLER+=("$isim: DERLEME HATASI")
+        ((KALDI++))
+    else
+        GERCEK_CIKTI=$(timeout ${TIMEOUT_SEC}s /tmp/tonyukuk_test_gomme /tmp/tonyukuk_test_gomme.trbc 2>/dev/null)
+        CALISMA_KODU=$?
+        FARK=$(diff <(echo "$GERCEK_CIKTI") "$BEKLENEN_DIR/trsm_gomme.beklenen" 2>&1)
+        if [ $CALISMA_KODU -eq 0 ] && [ -z "$FARK" ]; then
+            echo -e "  ${YESIL}GECTI${SIFIRLA} $isim (cikti dogrulandi)"
+            ((GECTI++))
+        else
+            echo -e "  ${KIRMIZI}KALDI${SIFIRLA} $isim (cikis kodu: $CALISMA_KODU)"
+            echo "$FARK" | head -20 | sed 's/^/    /'
+            BASARISIZ_TESTLER+=("$isim: CIKTI UYUSMUYOR")
+            ((KALDI++))
+        fi
+    fi
+    rm -f /tmp/tonyukuk_test_gomme /tmp/tonyukuk_test_gomme.trbc
+fi
+
 echo ""
 echo "=========================================="
 echo "Sonuclar ($BACKEND backend)"
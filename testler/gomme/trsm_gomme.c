@@ -0,0 +1,125 @@
+/*
+ * libtrsm gömme testi: tek modülü paylaşan makineler, harici fonksiyon
+ * bağlama, isimle çağrı, sıfırlama ve bellekten yükleme.
+ *
+ * Kullanım: trsm_gomme betik.trbc   (çıktı beklenen/trsm_gomme.beklenen)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "trsm.h"
+
+#define IS_SAYISI 4
+#define TUR_SAYISI 500
+
+static TrsmModul *modul;
+
+/* Betikteki @harici kiraci_topla: a + b + kiracı numarası */
+static int kiraci_topla(TrSM *sm, const TrsmDeger *argumanlar, int arg_sayisi,
+                        TrsmDeger *sonuc, void *veri) {
+    (void)sm;
+    if (arg_sayisi != 2) return 1;
+    *sonuc = trsm_tam(trsm_tam_al(argumanlar[0]) + trsm_tam_al(argumanlar[1]) +
+                      *(int *)veri);
+    return 0;
+}
+
+/* Her iş parçacığı kendi makinesini kurar; globaller makineler arasında
+ * paylaşılmadığından her turda aynı sonuç beklenir */
+static void *kiraci_isi(void *arg) {
+    int kiraci = (int)(intptr_t)arg;
+    TrSM *sm = trsm_olustur(modul);
+    if (!sm || trsm_harici_kaydet(sm, "kiraci_topla", kiraci_topla, &kiraci) != 0)
+        return (void *)(intptr_t)-1;
+    int64_t toplam = 0;
+    for (int t = 0; t < TUR_SAYISI; t++) {
+        trsm_sifirla(sm);
+        TrsmDeger args[2] = { trsm_tam(t), trsm_tam(1) }, sonuc;
+        if (trsm_cagir(sm, "kare", args, 1, &sonuc) != 0) return (void *)(intptr_t)-1;
+        toplam += trsm_tam_al(sonuc);
+        if (trsm_cagir(sm, "topla_harici", args, 2, &sonuc) != 0) return (void *)(intptr_t)-1;
+        toplam += trsm_tam_al(sonuc);
+    }
+    trsm_yok_et(sm);
+    return (void *)(intptr_t)toplam;
+}
+
+static TrsmModul *bellekten_yukle(const char *yol) {
+    FILE *f = fopen(yol, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long boyut = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *veri = malloc(boyut > 0 ? (size_t)boyut : 1);
+    size_t okunan = veri ? fread(veri, 1, (size_t)boyut, f) : 0;
+    fclose(f);
+    TrsmModul *m = okunan == (size_t)boyut ? trsm_modul_bellekten(veri, okunan) : NULL;
+    free(veri);
+    return m;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "Kullanım: trsm_gomme <betik.trbc>\n");
+        return 1;
+    }
+    modul = trsm_modul_yukle(argv[1]);
+    if (!modul) return 1;
+
+    /* Üst düzey kod ve isimle çağrılar */
+    TrSM *sm = trsm_olustur(modul);
+    printf("calistir: %d\n", trsm_calistir(sm));
+    fflush(stdout);
+
+    TrsmDeger ad = trsm_metin("Dünya", strlen("Dünya")), sonuc;
+    if (trsm_cagir(sm, "selamla", &ad, 1, &sonuc) == 0) {
+        size_t uzunluk;
+        const char *s = trsm_metin_al(sonuc, &uzunluk);
+        printf("selamla: %s (%zu, metin=%d)\n", s, uzunluk, trsm_tur(sonuc) == TRSM_TUR_METIN);
+        trsm_birak(sonuc);
+    }
+    trsm_birak(ad);
+
+    /* Bağlanmamış harici 0 döndürür; global sayac çağrılar arasında korunur */
+    TrsmDeger args[2] = { trsm_tam(1), trsm_tam(2) };
+    trsm_cagir(sm, "topla_harici", args, 2, &sonuc);
+    printf("bagsiz: %lld\n", (long long)trsm_tam_al(sonuc));
+    int kiraci = 100;
+    trsm_harici_kaydet(sm, "kiraci_topla", kiraci_topla, &kiraci);
+    trsm_cagir(sm, "topla_harici", args, 2, &sonuc);
+    printf("bagli: %lld\n", (long long)trsm_tam_al(sonuc));
+    trsm_sifirla(sm);
+    trsm_calistir(sm);
+    fflush(stdout);
+    trsm_cagir(sm, "topla_harici", args, 2, &sonuc);
+    printf("sifirlama sonrasi: %lld\n", (long long)trsm_tam_al(sonuc));
+
+    /* Hatalar -1 ile bildirilir */
+    printf("olmayan fonksiyon: %d\n", trsm_cagir(sm, "yok", NULL, 0, &sonuc));
+    printf("harici olmayan kayit: %d\n", trsm_harici_kaydet(sm, "kare", kiraci_topla, NULL));
+    trsm_yok_et(sm);
+
+    /* Aynı modülü paylaşan makineler ayrı iş parçacıklarında */
+    pthread_t isler[IS_SAYISI];
+    for (int i = 0; i < IS_SAYISI; i++)
+        pthread_create(&isler[i], NULL, kiraci_isi, (void *)(intptr_t)i);
+    for (int i = 0; i < IS_SAYISI; i++) {
+        void *r;
+        pthread_join(isler[i], &r);
+        printf("kiraci %d: %lld\n", i, (long long)(intptr_t)r);
+    }
+    trsm_modul_birak(modul);
+
+    /* Bellekteki görüntüden yükleme */
+    TrsmModul *m2 = bellekten_yukle(argv[1]);
+    if (!m2) return 1;
+    sm = trsm_olustur(m2);
+    TrsmDeger x = trsm_tam(12);
+    trsm_cagir(sm, "kare", &x, 1, &sonuc);
+    printf("bellekten: %lld\n", (long long)trsm_tam_al(sonuc));
+    trsm_yok_et(sm);
+    trsm_modul_birak(m2);
+    return 0;
+}